@@ -0,0 +1,37 @@
+#===============================================================================
+# Copyright 2020 FUJITSU LIMITED
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#===============================================================================
+
+# Manage threadpool-related compiler flags
+#===============================================================================
+
+if(Threadpool_cmake_included)
+    return()
+endif()
+set(Threadpool_cmake_included true)
+include("cmake/Threading.cmake")
+
+if(NOT MKLDNN_THREADING STREQUAL "THREADPOOL")
+    return()
+endif()
+
+set(THREADS_PREFER_PTHREAD_FLAG ON)
+find_package(Threads REQUIRED)
+
+set_threading("THREADPOOL")
+list(APPEND EXTRA_SHARED_LIBS ${CMAKE_THREAD_LIBS_INIT})
+
+message(STATUS "Threadpool: built-in work-stealing pool, user pools "
+    "can be set with mkldnn::set_threadpool()")
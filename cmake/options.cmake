@@ -55,7 +55,8 @@ set(MKLDNN_INSTALL_MODE "DEFAULT" CACHE STRING
     The BUNDLE option requires MKLDNN_USE_MKL be set to FULL:STATIC.")
 
 set(MKLDNN_THREADING "OMP" CACHE STRING
-    "specifies threading type; supports OMP (default), OMP:COMP, OMP:INTEL, or TBB.
+    "specifies threading type; supports OMP (default), OMP:COMP, OMP:INTEL, TBB,
+    or THREADPOOL.
 
     When OpenMP is used a user can choose what runtime to use:
     - native OpenMP runtime that comes with the compiler (OMP:COMP), or
@@ -69,7 +70,13 @@ set(MKLDNN_THREADING "OMP" CACHE STRING
 
     To use Intel(R) Threading Building Blocks (Intel(R) TBB) one should also
     set TBBROOT (either environment variable or CMake option) to the library
-    location")
+    location.
+
+    THREADPOOL runs parallel regions on a threadpool set by the application
+    with mkldnn::set_threadpool() (see mkldnn_threadpool_iface.hpp). Until
+    one is set the library uses its built-in work-stealing pool, sized by
+    the MKLDNN_NUM_THREADS environment variable or the number of hardware
+    threads.")
 
 set(MKLDNN_USE_MKL "NONE" CACHE STRING
     "specifies what Intel MKL library to use.
@@ -297,6 +297,22 @@ mkldnn_status_t MKLDNN_API mkldnn_primitive_attr_get_int_output_round_mode(
 mkldnn_status_t MKLDNN_API mkldnn_primitive_attr_set_int_output_round_mode(
         mkldnn_primitive_attr_t attr, mkldnn_round_mode_t round_mode);
 
+/** Returns the scratchpad @p mode for a given @p attr, previously set by
+ * mkldnn_primitive_attr_set_scratchpad_mode. */
+mkldnn_status_t MKLDNN_API mkldnn_primitive_attr_get_scratchpad_mode(
+        const_mkldnn_primitive_attr_t attr, mkldnn_scratchpad_mode_t *mode);
+
+/** Sets the scratchpad @p mode for a given @p attr.
+ *
+ * With #mkldnn_scratchpad_mode_user the primitive does not own a scratchpad,
+ * it uses the scratchpad of the stream it is executed in. The size required
+ * is returned by the #mkldnn_query_memory_consumption_s64 query.
+ *
+ * The default value is #mkldnn_scratchpad_mode_library.
+ */
+mkldnn_status_t MKLDNN_API mkldnn_primitive_attr_set_scratchpad_mode(
+        mkldnn_primitive_attr_t attr, mkldnn_scratchpad_mode_t mode);
+
 /** Returns @p count, correspondence scale @p mask, and a pointer to a constant
  * floating point array of output @p scales for given @p attr, previously set
  * by mkldnn_primitive_attr_set_output_scales.
@@ -1736,6 +1752,234 @@ mkldnn_status_t MKLDNN_API mkldnn_stream_rerun(mkldnn_stream_t stream,
 /** Destroys an execution @p stream. */
 mkldnn_status_t MKLDNN_API mkldnn_stream_destroy(mkldnn_stream_t stream);
 
+/** Sets the scratchpad of the @p stream to the user memory @p scratchpad of
+ * @p size bytes. The scratchpad is shared by all the primitives executed in
+ * the @p stream that were created with #mkldnn_scratchpad_mode_user, so it
+ * must be at least the size returned by mkldnn_stream_get_scratchpad_size()
+ * and must not be used by another stream executed concurrently.
+ *
+ * If @p scratchpad is @c NULL (and @p size is 0) the @p stream allocates the
+ * scratchpad itself, growing it on demand; this also releases the memory
+ * held by the @p stream. That memory is released with the @p stream too. */
+mkldnn_status_t MKLDNN_API mkldnn_stream_set_scratchpad(mkldnn_stream_t stream,
+        void *scratchpad, size_t size);
+
+/** Returns the @p size of the scratchpad required by the primitives
+ * submitted to the @p stream, i.e. the largest
+ * #mkldnn_query_memory_consumption_s64 of the ones created with
+ * #mkldnn_scratchpad_mode_user. */
+mkldnn_status_t MKLDNN_API mkldnn_stream_get_scratchpad_size(
+        const_mkldnn_stream_t stream, size_t *size);
+
+/** Returns the number of primitives @p fused away and the number of
+ * @p levels of the execution plan of a lazy @p stream, as built by its last
+ * wait(). The primitives of a level may execute concurrently. Both are 0
+ * for an eager stream or before the plan is built. Either pointer may be
+ * @c NULL. */
+mkldnn_status_t MKLDNN_API mkldnn_stream_get_plan_stats(
+        const_mkldnn_stream_t stream, int *fused, int *levels);
+
+/** Pins the threads executing the @p stream to the CPUs of the NUMA
+ * @p node, one CPU per thread, so that the stream only uses the memory
+ * bandwidth of that node, e.g. one CMG on A64FX. With OpenMP the stream
+ * executes on at most as many threads as the node has CPUs. -1 (the
+ * default) runs the stream with the affinity the process started with.
+ *
+ * The threads are shared by all the streams: the affinity is set when a
+ * stream executes and stays in effect until a stream with another node, or
+ * with -1, executes. Primitives that fixed their number of threads at
+ * creation keep it, so create them with at most as many threads as the
+ * node has CPUs. */
+mkldnn_status_t MKLDNN_API mkldnn_stream_set_numa_node(mkldnn_stream_t stream,
+        int node);
+
+/** Returns the number of NUMA nodes of the machine in @p count. */
+mkldnn_status_t MKLDNN_API mkldnn_get_numa_node_count(int *count);
+
+/** Runs the @p stream on the @p instance: its primitives execute on the
+ * thread team of the @p instance and share its scratchpad, and the streams
+ * bound to one instance execute one at a time. Streams bound to different
+ * instances, submitted from different threads, execute concurrently. A
+ * @p instance of @c NULL (the default) runs the stream on the threads of
+ * the library. The @p instance must outlive the binding.
+ *
+ * Primitives keep the number of threads they were created for, so the
+ * primitives created by a thread that is not attached to the @p instance
+ * may run more threads than the @p instance has cores. Create them on a
+ * thread attached to the @p instance. */
+mkldnn_status_t MKLDNN_API mkldnn_stream_set_instance(mkldnn_stream_t stream,
+        mkldnn_instance_t instance);
+
+/** @} */
+
+/** @addtogroup c_api_instance Instance
+ * An execution instance: a team of threads on a subset of the cores, with
+ * its own scratchpad, to serve many small requests concurrently without
+ * oversubscription. Typically each serving thread creates an instance of
+ * (number of cores / number of instances) threads on its own cores,
+ * attaches to it, creates its primitives and runs its streams.
+ * @{ */
+
+/** Creates an @p instance of @p nthreads threads. If @p first_cpu is not -1
+ * the threads are pinned to the CPUs [@p first_cpu, @p first_cpu +
+ * @p nthreads) when the instance is first used. */
+mkldnn_status_t MKLDNN_API mkldnn_instance_create(
+        mkldnn_instance_t *instance, int nthreads, int first_cpu);
+
+/** Attaches the calling thread to the @p instance: the primitive
+ * descriptors created by the thread are tuned for the number of threads of
+ * the @p instance, and the primitives executed by the thread run on its
+ * threads.
+ *
+ * Returns #mkldnn_unimplemented with TBB, whose task arenas can only be
+ * used through mkldnn_stream_set_instance(). */
+mkldnn_status_t MKLDNN_API mkldnn_instance_attach(mkldnn_instance_t instance);
+
+/** Detaches the calling thread from its instance. If the instance pinned
+ * its threads, the calling thread and the threads of the instance get back
+ * the affinity they had when it attached. */
+mkldnn_status_t MKLDNN_API mkldnn_instance_detach();
+
+/** Destroys the @p instance. */
+mkldnn_status_t MKLDNN_API mkldnn_instance_destroy(mkldnn_instance_t instance);
+
+/** Returns the number of threads the primitives executed by the calling
+ * thread run on: those of its instance if it is attached to one, all the
+ * threads of the library otherwise. */
+int MKLDNN_API mkldnn_instance_get_max_threads();
+
+/** @} */
+
+/** @addtogroup c_api_packed_weights Packed weights
+ * Weights reordered once into the format a primitive expects.
+ *
+ * The packed data is read-only: it can be bound to any number of memory
+ * primitives (see mkldnn_packed_weights_create_memory()) used as the weights
+ * of primitives executed concurrently, but must not be written to. Packed
+ * weights created with a @p key are kept in a process-wide cache, so that
+ * packing the same weights again, e.g. for another model replica, returns
+ * the same data instead of a copy.
+ * @{ */
+
+/** Packs the @p weights memory primitive into the format of the @p index-th
+ * weights of the primitive descriptor @p pd (#mkldnn_query_weights_pd), e.g.
+ * @c OIhw16i16o for a convolution or #mkldnn_rnn_packed for an RNN.
+ *
+ * If @p key is not @c NULL, the packed weights are looked up in the cache
+ * under @p key and the packed memory descriptor first and, on a miss, added
+ * to it. The caller must make sure that a key identifies the weights
+ * values. */
+mkldnn_status_t MKLDNN_API mkldnn_packed_weights_create(
+        mkldnn_packed_weights_t *packed_weights,
+        const_mkldnn_primitive_desc_t pd, int index,
+        const_mkldnn_primitive_t weights, const char *key);
+
+/** Loads packed weights saved with mkldnn_packed_weights_save() from the
+ * file @p path for the @p engine. The file is mapped read-only rather than
+ * read, so replicas loading the same file share the page cache. If @p key is
+ * not @c NULL, the cache is used as in mkldnn_packed_weights_create().
+ *
+ * Returns #mkldnn_invalid_arguments if the file was not saved by this
+ * version of the library. */
+mkldnn_status_t MKLDNN_API mkldnn_packed_weights_load(
+        mkldnn_packed_weights_t *packed_weights, mkldnn_engine_t engine,
+        const char *path, const char *key);
+
+/** Saves @p packed_weights to the file @p path. */
+mkldnn_status_t MKLDNN_API mkldnn_packed_weights_save(
+        const_mkldnn_packed_weights_t packed_weights, const char *path);
+
+/** Returns the memory primitive descriptor @p memory_pd of the packed
+ * weights. The descriptor is owned by @p packed_weights. */
+mkldnn_status_t MKLDNN_API mkldnn_packed_weights_get_primitive_desc(
+        const_mkldnn_packed_weights_t packed_weights,
+        const_mkldnn_primitive_desc_t *memory_pd);
+
+/** Returns the packed data @p handle and its @p size in bytes. Either
+ * pointer may be @c NULL. */
+mkldnn_status_t MKLDNN_API mkldnn_packed_weights_get_data_handle(
+        const_mkldnn_packed_weights_t packed_weights, const void **handle,
+        size_t *size);
+
+/** Creates a @p memory primitive bound to the packed data, to be passed as
+ * the weights input of the primitives. The @p memory primitive borrows the
+ * data: @p packed_weights must not be destroyed before it. */
+mkldnn_status_t MKLDNN_API mkldnn_packed_weights_create_memory(
+        mkldnn_primitive_t *memory,
+        const_mkldnn_packed_weights_t packed_weights);
+
+/** Destroys the @p packed_weights handle. The packed data is released once
+ * no handle and no cache entry refers to it. */
+mkldnn_status_t MKLDNN_API mkldnn_packed_weights_destroy(
+        mkldnn_packed_weights_t packed_weights);
+
+/** Drops all the packed weights cache entries. Data still referred to by a
+ * handle stays valid. */
+mkldnn_status_t MKLDNN_API mkldnn_clear_packed_weights_cache();
+
+/** Returns the packed weights cache statistics: number of @p hits and
+ * @p misses of mkldnn_packed_weights_create() and mkldnn_packed_weights_load()
+ * with a key, and the @p bytes of packed data held by the cache. Any of the
+ * pointers may be @c NULL. */
+mkldnn_status_t MKLDNN_API mkldnn_get_packed_weights_cache_stats(
+        size_t *hits, size_t *misses, size_t *bytes);
+
+/** @} */
+
+/** @addtogroup c_api_weights_file Weights file
+ * A file of named tensors stored in the memory format the primitives consume
+ * them in, e.g. @c OIhw16i16o or #mkldnn_rnn_packed, and used in place.
+ *
+ * Opening a weights file maps it read-only instead of reading it, and the
+ * memory primitives created for its tensors point into the mapping: no
+ * data is read, copied or reordered at startup, and processes opening the
+ * same file share the page cache. The tensor data must not be written to.
+ * @{ */
+
+/** Writes the @p n memory primitives @p memories with the names @p names to
+ * the file @p path, in their current format. Names must be unique and
+ * shorter than #MKLDNN_WEIGHTS_FILE_NAME_LEN. Typically the memories are the
+ * user weights reordered to the weights format of the primitive descriptors,
+ * e.g. created by mkldnn_packed_weights_create_memory(). */
+mkldnn_status_t MKLDNN_API mkldnn_weights_file_write(const char *path, int n,
+        const char *const *names, const const_mkldnn_primitive_t *memories);
+
+/** Maps the weights file @p path for the @p engine. @p flags is a
+ * combination of #mkldnn_weights_file_flags_t.
+ *
+ * Returns #mkldnn_invalid_arguments if the file was not written by this
+ * version of the library. */
+mkldnn_status_t MKLDNN_API mkldnn_weights_file_open(
+        mkldnn_weights_file_t *file, mkldnn_engine_t engine,
+        const char *path, unsigned flags);
+
+/** Returns the number of tensors in the weights @p file. */
+mkldnn_status_t MKLDNN_API mkldnn_weights_file_get_count(
+        const_mkldnn_weights_file_t file, int *count);
+
+/** Returns the @p name and the memory primitive descriptor @p memory_pd of
+ * the @p index-th tensor of the weights @p file. Both are owned by @p file,
+ * and either pointer may be @c NULL. */
+mkldnn_status_t MKLDNN_API mkldnn_weights_file_query(
+        const_mkldnn_weights_file_t file, int index, const char **name,
+        const_mkldnn_primitive_desc_t *memory_pd);
+
+/** Returns the @p index of the tensor @p name in the weights @p file, or
+ * #mkldnn_invalid_arguments if there is no such tensor. */
+mkldnn_status_t MKLDNN_API mkldnn_weights_file_find(
+        const_mkldnn_weights_file_t file, const char *name, int *index);
+
+/** Creates a @p memory primitive bound to the @p index-th tensor of the
+ * weights @p file. The @p memory primitive borrows the mapping: @p file
+ * must not be closed before it is destroyed. */
+mkldnn_status_t MKLDNN_API mkldnn_weights_file_create_memory(
+        mkldnn_primitive_t *memory, const_mkldnn_weights_file_t file,
+        int index);
+
+/** Unmaps the weights @p file. */
+mkldnn_status_t MKLDNN_API mkldnn_weights_file_close(
+        mkldnn_weights_file_t file);
+
 /** @} */
 
 /** @addtogroup c_api_service Service functions
@@ -1761,6 +2005,87 @@ mkldnn_status_t MKLDNN_API mkldnn_set_verbose(int level);
  *     This setting overrides the MKLDNN_JIT_DUMP environment variable. */
 mkldnn_status_t MKLDNN_API mkldnn_set_jit_dump(int dump);
 
+/** Sets the number of primitives kept in the primitive cache.
+ *
+ * A destroyed primitive is kept in the cache and reused, with new inputs and
+ * outputs, by the next mkldnn_primitive_create() for an equivalent primitive
+ * descriptor. This saves the creation cost (e.g. JIT code generation) when
+ * primitives are re-created for each input shape. When the cache is full,
+ * the least recently used primitives are destroyed. A @p capacity of 0
+ * (default) disables the cache.
+ *
+ * @note
+ *     This setting overrides the MKLDNN_PRIMITIVE_CACHE_CAPACITY environment
+ *     variable. */
+mkldnn_status_t MKLDNN_API mkldnn_set_primitive_cache_capacity(int capacity);
+
+/** Returns the primitive cache @p capacity. */
+mkldnn_status_t MKLDNN_API mkldnn_get_primitive_cache_capacity(int *capacity);
+
+/** Returns the primitive cache statistics: number of @p hits and @p misses
+ * of mkldnn_primitive_create() and the current number of cached primitives
+ * in @p size. Any of the pointers may be @c NULL. */
+mkldnn_status_t MKLDNN_API mkldnn_get_primitive_cache_stats(size_t *hits,
+        size_t *misses, int *size);
+
+/** Returns the JIT kernel registry statistics. Primitives with identical
+ * kernel configurations share one generated kernel: @p generated is the
+ * number of kernels generated, @p deduplicated the number of times an
+ * existing kernel was shared instead, and @p bytes_saved the code size
+ * those shares did not allocate. Any of the pointers may be @c NULL. */
+mkldnn_status_t MKLDNN_API mkldnn_get_jit_kernel_registry_stats(
+        size_t *generated, size_t *deduplicated, size_t *bytes_saved);
+
+/** Returns the statistics of the arena the scratchpads are allocated from
+ * in @p stats.
+ *
+ * Scratchpads of 256 KiB and more are carved from blocks of a few size
+ * classes, mapped with huge pages where available and recycled across
+ * primitives. The MKLDNN_HUGEPAGES environment variable selects the huge
+ * pages: 0 -- none, 1 -- transparent huge pages (default), 2 -- explicit
+ * huge pages (e.g. 2 MiB, or 512 MiB with 64 KiB base pages) with a
+ * fallback to transparent ones. MKLDNN_SCRATCHPAD_ARENA=0 disables the
+ * arena. */
+mkldnn_status_t MKLDNN_API mkldnn_get_scratchpad_arena_stats(
+        mkldnn_arena_stats_t *stats);
+
+/** Returns the cached blocks of the scratchpad arena to the system. */
+mkldnn_status_t MKLDNN_API mkldnn_trim_scratchpad_arena();
+
+/** Sets the capacity of the profiling ring buffer to @p capacity records.
+ *
+ * When enabled, the library records the creation and the execution time of
+ * each primitive together with its implementation name, shapes, number of
+ * threads and scratchpad size (see #mkldnn_profiling_record_t). When the
+ * buffer is full the oldest records are overwritten. Setting the capacity
+ * discards the records. A @p capacity of 0 (default) disables profiling.
+ *
+ * @note
+ *     This setting overrides the MKLDNN_PROFILING environment variable. If
+ *     the MKLDNN_PROFILING_TRACE environment variable is set, the records
+ *     are written to the file it names at exit, as with
+ *     mkldnn_dump_profiling_trace(). */
+mkldnn_status_t MKLDNN_API mkldnn_set_profiling_capacity(int capacity);
+
+/** Returns the profiling ring buffer @p capacity. */
+mkldnn_status_t MKLDNN_API mkldnn_get_profiling_capacity(int *capacity);
+
+/** Copies the profiling records, oldest first, to @p records, which has
+ * room for @p count records; on return @p count is the number of records
+ * copied. If there are more records, the most recent ones are copied. If
+ * @p records is @c NULL, @p count returns the number of records available.
+ * Records that are being overwritten are skipped. */
+mkldnn_status_t MKLDNN_API mkldnn_get_profiling_records(
+        mkldnn_profiling_record_t *records, int *count);
+
+/** Discards all the profiling records. */
+mkldnn_status_t MKLDNN_API mkldnn_reset_profiling();
+
+/** Writes the profiling records to the file @p path in the Chrome trace
+ * event format (JSON), which can be loaded in chrome://tracing or
+ * Perfetto. */
+mkldnn_status_t MKLDNN_API mkldnn_dump_profiling_trace(const char *path);
+
 /** Gets library version information.
  * Version information includes:
  *  - major -- major version number
@@ -229,6 +229,15 @@ inline mkldnn_round_mode_t convert_to_c(round_mode mode) {
     return static_cast<mkldnn_round_mode_t>(mode);
 }
 
+enum class scratchpad_mode {
+    library = mkldnn_scratchpad_mode_library,
+    user = mkldnn_scratchpad_mode_user,
+};
+
+inline mkldnn_scratchpad_mode_t convert_to_c(scratchpad_mode mode) {
+    return static_cast<mkldnn_scratchpad_mode_t>(mode);
+}
+
 enum padding_kind {
     zero = mkldnn_padding_zero
 };
@@ -438,6 +447,19 @@ struct primitive_attr: public handle<mkldnn_primitive_attr_t> {
                 "could not set int output round mode");
     }
 
+    scratchpad_mode get_scratchpad_mode() const {
+        mkldnn_scratchpad_mode_t result;
+        error::wrap_c_api(mkldnn_primitive_attr_get_scratchpad_mode(
+                    get(), &result), "could not get scratchpad mode");
+        return scratchpad_mode(result);
+    }
+
+    void set_scratchpad_mode(scratchpad_mode mode) {
+        error::wrap_c_api(mkldnn_primitive_attr_set_scratchpad_mode(
+                    get(), mkldnn::convert_to_c(mode)),
+                "could not set scratchpad mode");
+    }
+
     void get_output_scales(int &mask, std::vector<float> &scales) const
     {
         int count, c_mask;
@@ -3293,6 +3315,52 @@ struct shuffle_backward : public primitive {
 
 /// @} Primitives
 
+/// @addtogroup cpp_api_instance Instance
+/// A thread team on a subset of the cores with its own scratchpad.
+///
+/// @sa @ref c_api_instance in @ref c_api
+/// @{
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+template <> struct handle_traits<mkldnn_instance_t> {
+    static constexpr auto destructor = &mkldnn_instance_destroy;
+};
+#endif
+
+struct instance: public handle<mkldnn_instance_t> {
+    using handle::handle;
+
+    /// Constructs an instance of @p nthreads threads, pinned to the CPUs
+    /// starting at @p first_cpu unless it is -1.
+    instance(int nthreads, int first_cpu = -1) {
+        mkldnn_instance_t result;
+        error::wrap_c_api(mkldnn_instance_create(&result, nthreads,
+                    first_cpu),
+                "could not create an instance");
+        reset(result);
+    }
+
+    /// Attaches the calling thread to the instance.
+    void attach() {
+        error::wrap_c_api(mkldnn_instance_attach(get()),
+                "could not attach to an instance");
+    }
+
+    /// Detaches the calling thread from its instance.
+    static void detach() {
+        error::wrap_c_api(mkldnn_instance_detach(),
+                "could not detach from an instance");
+    }
+
+    /// Returns the number of threads the primitives executed by the calling
+    /// thread run on.
+    static int get_max_threads() {
+        return mkldnn_instance_get_max_threads();
+    }
+};
+
+/// @}
+
 /// @addtogroup cpp_api_stream Stream
 /// Execution stream operations.
 ///
@@ -3373,12 +3441,229 @@ struct stream: public handle<mkldnn_stream_t> {
                 "could not rerun a stream", &c_api_error_primitive);
         return *this;
     }
+
+    /// Sets the scratchpad shared by the primitives created with
+    /// scratchpad_mode::user. @c nullptr lets the stream allocate it.
+    stream &set_scratchpad(void *scratchpad, size_t size) {
+        error::wrap_c_api(
+                mkldnn_stream_set_scratchpad(get(), scratchpad, size),
+                "could not set a stream scratchpad");
+        return *this;
+    }
+
+    /// Returns the scratchpad size required by the submitted primitives.
+    size_t get_scratchpad_size() const {
+        size_t size;
+        error::wrap_c_api(mkldnn_stream_get_scratchpad_size(get(), &size),
+                "could not get a stream scratchpad size");
+        return size;
+    }
+
+    /// Returns the number of primitives fused away and the number of
+    /// levels of the execution plan of a lazy stream.
+    void get_plan_stats(int &fused, int &levels) const {
+        error::wrap_c_api(mkldnn_stream_get_plan_stats(get(), &fused,
+                    &levels), "could not get stream plan stats");
+    }
+
+    /// Pins the threads executing the stream to the NUMA @p node; -1
+    /// restores the affinity the process started with.
+    stream &set_numa_node(int node) {
+        error::wrap_c_api(mkldnn_stream_set_numa_node(get(), node),
+                "could not set a stream NUMA node");
+        return *this;
+    }
+
+    /// Runs the stream on the @p ainstance.
+    stream &set_instance(const instance &ainstance) {
+        error::wrap_c_api(mkldnn_stream_set_instance(get(), ainstance.get()),
+                "could not set a stream instance");
+        return *this;
+    }
 };
 
 #undef REG_QUERY_MPD
 
 /// @}
 
+/// @addtogroup cpp_api_packed_weights Packed weights
+/// Weights reordered once into the format a primitive expects.
+///
+/// @sa @ref c_api_packed_weights in @ref c_api
+/// @{
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+template <> struct handle_traits<mkldnn_packed_weights_t> {
+    static constexpr auto destructor = &mkldnn_packed_weights_destroy;
+};
+#endif
+
+struct packed_weights: public handle<mkldnn_packed_weights_t> {
+    using handle::handle;
+
+    /// Packs @p weights into the format of the @p index-th weights of the
+    /// primitive descriptor @p pd. A non-null @p key enables the cache.
+    template <typename prim_desc>
+    packed_weights(const prim_desc &pd, int index, const memory &weights,
+            const char *key = nullptr) {
+        mkldnn_packed_weights_t result;
+        error::wrap_c_api(mkldnn_packed_weights_create(&result, pd.get(),
+                    index, weights.get(), key),
+                "could not create packed weights");
+        reset(result);
+    }
+
+    /// Loads packed weights saved with save() from the file @p path.
+    packed_weights(const engine &aengine, const char *path,
+            const char *key = nullptr) {
+        mkldnn_packed_weights_t result;
+        error::wrap_c_api(mkldnn_packed_weights_load(&result, aengine.get(),
+                    path, key),
+                "could not load packed weights");
+        reset(result);
+    }
+
+    /// Saves the packed weights to the file @p path.
+    void save(const char *path) const {
+        error::wrap_c_api(mkldnn_packed_weights_save(get(), path),
+                "could not save packed weights");
+    }
+
+    memory::primitive_desc get_primitive_desc() const {
+        const_mkldnn_primitive_desc_t const_cdesc;
+        error::wrap_c_api(mkldnn_packed_weights_get_primitive_desc(get(),
+                    &const_cdesc),
+                "could not get packed weights primitive descriptor");
+        mkldnn_primitive_desc_t cdesc;
+        error::wrap_c_api(mkldnn_primitive_desc_clone(&cdesc, const_cdesc),
+                "could not clone a memory primitive descriptor");
+        memory::primitive_desc ret;
+        ret.reset(cdesc);
+        return ret;
+    }
+
+    const void *get_data_handle() const {
+        const void *handle;
+        error::wrap_c_api(mkldnn_packed_weights_get_data_handle(get(),
+                    &handle, nullptr),
+                "could not get packed weights data handle");
+        return handle;
+    }
+
+    /// Returns a memory primitive bound to the packed data. The packed
+    /// weights must outlive it.
+    memory create_memory() const {
+        return memory(get_primitive_desc(),
+                const_cast<void *>(get_data_handle()));
+    }
+};
+
+/// @}
+
+/// @addtogroup cpp_api_weights_file Weights file
+/// A mapped file of tensors stored in the format the primitives consume.
+///
+/// @sa @ref c_api_weights_file in @ref c_api
+/// @{
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+template <> struct handle_traits<mkldnn_weights_file_t> {
+    static constexpr auto destructor = &mkldnn_weights_file_close;
+};
+#endif
+
+struct weights_file: public handle<mkldnn_weights_file_t> {
+    using handle::handle;
+
+    enum flags {
+        default_flags = mkldnn_weights_file_default,
+        populate = mkldnn_weights_file_populate,
+        hugepages = mkldnn_weights_file_hugepages,
+        numa_interleave = mkldnn_weights_file_numa_interleave,
+    };
+
+    /// Writes the @p memories with the names @p names to the file @p path.
+    static void write(const char *path, const std::vector<std::string> &names,
+            const std::vector<memory> &memories) {
+        if (names.size() != memories.size())
+            throw error(mkldnn_invalid_arguments,
+                    "names and memories differ in size");
+        std::vector<const char *> c_names;
+        std::vector<const_mkldnn_primitive_t> c_memories;
+        for (size_t i = 0; i < names.size(); ++i) {
+            c_names.push_back(names[i].c_str());
+            c_memories.push_back(memories[i].get());
+        }
+        error::wrap_c_api(mkldnn_weights_file_write(path, (int)names.size(),
+                    c_names.data(), c_memories.data()),
+                "could not write a weights file");
+    }
+
+    /// Maps the weights file @p path. @p aflags is a combination of
+    /// #flags.
+    weights_file(const engine &aengine, const char *path,
+            unsigned aflags = default_flags) {
+        mkldnn_weights_file_t result;
+        error::wrap_c_api(mkldnn_weights_file_open(&result, aengine.get(),
+                    path, aflags),
+                "could not open a weights file");
+        reset(result);
+    }
+
+    int get_count() const {
+        int count;
+        error::wrap_c_api(mkldnn_weights_file_get_count(get(), &count),
+                "could not get the number of tensors in a weights file");
+        return count;
+    }
+
+    const char *get_name(int index) const {
+        const char *name;
+        error::wrap_c_api(mkldnn_weights_file_query(get(), index, &name,
+                    nullptr),
+                "could not query a weights file");
+        return name;
+    }
+
+    int find(const char *name) const {
+        int index;
+        error::wrap_c_api(mkldnn_weights_file_find(get(), name, &index),
+                "could not find a tensor in a weights file");
+        return index;
+    }
+
+    memory::primitive_desc get_primitive_desc(int index) const {
+        const_mkldnn_primitive_desc_t const_cdesc;
+        error::wrap_c_api(mkldnn_weights_file_query(get(), index, nullptr,
+                    &const_cdesc),
+                "could not query a weights file");
+        mkldnn_primitive_desc_t cdesc;
+        error::wrap_c_api(mkldnn_primitive_desc_clone(&cdesc, const_cdesc),
+                "could not clone a memory primitive descriptor");
+        memory::primitive_desc ret;
+        ret.reset(cdesc);
+        return ret;
+    }
+
+    /// Returns a memory primitive bound to the @p index-th tensor. The
+    /// weights file must outlive it.
+    memory create_memory(int index) const {
+        mkldnn_primitive_t result;
+        error::wrap_c_api(mkldnn_weights_file_create_memory(&result, get(),
+                    index),
+                "could not create a weights file memory primitive");
+        memory ret(get_primitive_desc(index), nullptr);
+        ret.reset(result);
+        return ret;
+    }
+
+    memory create_memory(const char *name) const {
+        return create_memory(find(name));
+    }
+};
+
+/// @}
+
 /// @} C++ API
 
 } // namespace mkldnn
@@ -0,0 +1,78 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef MKLDNN_THREADPOOL_IFACE_HPP
+#define MKLDNN_THREADPOOL_IFACE_HPP
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+#include <functional>
+
+#include "mkldnn.h"
+#endif
+
+namespace mkldnn {
+
+/// @addtogroup cpp_api C++ API
+/// @{
+
+/// @addtogroup cpp_api_threadpool Threadpool
+/// Parallel regions of the library built with `MKLDNN_THREADING=THREADPOOL`
+/// run on a threadpool provided by the application.
+/// @{
+
+/// Abstract threadpool interface.
+///
+/// The library splits a parallel region into @p n tasks and calls
+/// parallel_for(). Tasks may run in any order and on any number of threads,
+/// so the library never synchronizes tasks of the same region with each
+/// other: algorithms that need a barrier are not used with this threading.
+struct threadpool_iface {
+    /// Returns the number of worker threads, i.e. the largest number of
+    /// tasks the library will submit at once.
+    virtual int get_num_threads() const = 0;
+
+    /// Returns true if the calling thread is a worker of this threadpool.
+    virtual bool get_in_parallel() const = 0;
+
+    /// Calls @p fn(i, n) for each i in [0, n) and returns once all the calls
+    /// have completed.
+    virtual void parallel_for(int n,
+            const std::function<void(int, int)> &fn) = 0;
+
+    virtual ~threadpool_iface() {}
+};
+
+/// Sets the @p threadpool used by all the subsequent primitive executions.
+/// Passing @c nullptr restores the built-in work-stealing threadpool. The
+/// threadpool is not owned by the library and must outlive its use.
+///
+/// Must not be called while primitives are executing.
+///
+/// @returns #mkldnn_unimplemented if the library was built with another
+/// threading runtime.
+mkldnn_status_t MKLDNN_API set_threadpool(threadpool_iface *threadpool);
+
+/// Returns the threadpool currently used by the library, or @c nullptr if
+/// the library was built with another threading runtime.
+threadpool_iface MKLDNN_API *get_threadpool();
+
+/// @}
+
+/// @}
+
+} // namespace mkldnn
+
+#endif
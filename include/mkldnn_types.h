@@ -94,6 +94,15 @@ typedef enum {
     mkldnn_round_down = 2,
 } mkldnn_round_mode_t;
 
+/** Scratchpad mode */
+typedef enum {
+    /** The library manages the scratchpad of the primitive (default) */
+    mkldnn_scratchpad_mode_library = 0,
+    /** The primitive uses the scratchpad of the stream it is executed in,
+     * see mkldnn_stream_set_scratchpad() */
+    mkldnn_scratchpad_mode_user = 1,
+} mkldnn_scratchpad_mode_t;
+
 /** Memory format specification.
  *
  * Intel MKL-DNN formats describe physical data layout. The physical layout
@@ -1284,7 +1293,10 @@ typedef enum {
     mkldnn_any_stream,
     /** Eager stream. */
     mkldnn_eager,
-    /** Lazy stream. */
+    /** Lazy stream. The primitives are executed on wait(): reorder chains
+     * and eltwise or sum primitives following a convolution may be fused,
+     * leaving the intermediate tensors undefined, and independent primitives
+     * may run concurrently. Set MKLDNN_LAZY_STREAM_OPT=0 to disable this. */
     mkldnn_lazy,
 } mkldnn_stream_kind_t;
 
@@ -1296,6 +1308,141 @@ typedef struct mkldnn_stream *mkldnn_stream_t;
 /** A constant execution stream handle. */
 typedef const struct mkldnn_stream *const_mkldnn_stream_t;
 
+/** @} */
+
+/** @addtogroup c_api_types_instance Instance
+ * @{ */
+
+/** @struct mkldnn_instance
+ * An opaque structure describing an execution instance: a thread team on a
+ * subset of the cores with its own scratchpad. */
+struct mkldnn_instance;
+/** An instance handle. */
+typedef struct mkldnn_instance *mkldnn_instance_t;
+/** A constant instance handle. */
+typedef const struct mkldnn_instance *const_mkldnn_instance_t;
+
+/** @} */
+
+/** @addtogroup c_api_types_packed_weights Packed weights
+ * @{ */
+
+/** @struct mkldnn_packed_weights
+ * An opaque structure holding weights packed once in the format a primitive
+ * descriptor expects. The packed data is read-only and can be shared by
+ * primitives, threads and model replicas. */
+struct mkldnn_packed_weights;
+/** A packed weights handle. */
+typedef struct mkldnn_packed_weights *mkldnn_packed_weights_t;
+/** A constant packed weights handle. */
+typedef const struct mkldnn_packed_weights *const_mkldnn_packed_weights_t;
+
+/** @} */
+
+/** @addtogroup c_api_types_weights_file Weights file
+ * @{ */
+
+/** Maximum length of a tensor name in a weights file, including the
+ * terminating zero. */
+#define MKLDNN_WEIGHTS_FILE_NAME_LEN 128
+
+/** Flags for mkldnn_weights_file_open(). */
+typedef enum {
+    /** Map the file lazily; pages are read on first use. */
+    mkldnn_weights_file_default = 0x0U,
+    /** Read the whole file at open time (@c MAP_POPULATE), so that the
+     * first execution does not pay for page faults. */
+    mkldnn_weights_file_populate = 0x1U,
+    /** Ask for transparent huge pages to back the mapping. Files on a
+     * hugetlbfs mount are always backed by huge pages. */
+    mkldnn_weights_file_hugepages = 0x2U,
+    /** Interleave the pages read at open time across the NUMA nodes
+     * allowed to the process. Implies #mkldnn_weights_file_populate. */
+    mkldnn_weights_file_numa_interleave = 0x4U,
+} mkldnn_weights_file_flags_t;
+
+/** @struct mkldnn_weights_file
+ * An opaque structure describing a mapped weights file: named tensors
+ * stored in the memory format the primitives consume them in. */
+struct mkldnn_weights_file;
+/** A weights file handle. */
+typedef struct mkldnn_weights_file *mkldnn_weights_file_t;
+/** A constant weights file handle. */
+typedef const struct mkldnn_weights_file *const_mkldnn_weights_file_t;
+
+/** @} */
+
+/** @addtogroup c_api_types_profiling Profiling
+ * @{ */
+
+/** Maximum length of the implementation name in a profiling record,
+ * including the terminating zero. */
+#define MKLDNN_PROFILING_NAME_LEN 64
+/** Maximum length of the primitive information in a profiling record,
+ * including the terminating zero. */
+#define MKLDNN_PROFILING_INFO_LEN 512
+
+/** @brief Kinds of profiling events. */
+typedef enum {
+    /** Creation of a primitive, including the primitive cache lookup. */
+    mkldnn_profiling_create = 1,
+    /** Execution of a primitive. */
+    mkldnn_profiling_execute = 2,
+} mkldnn_profiling_event_t;
+
+/** A profiling record. */
+typedef struct {
+    /** The recorded event. */
+    mkldnn_profiling_event_t event;
+    /** The kind of the primitive. */
+    mkldnn_primitive_kind_t primitive_kind;
+    /** The implementation name, e.g. "jit:sve". */
+    char impl_name[MKLDNN_PROFILING_NAME_LEN];
+    /** The primitive information in the #mkldnn_set_verbose() format: kind,
+     * implementation, propagation kind, data formats, auxiliary information
+     * and shapes. Empty if the library is built without verbose support. */
+    char info[MKLDNN_PROFILING_INFO_LEN];
+    /** The start time in microseconds. The time is monotonic and its origin
+     * is arbitrary but the same for all the records. */
+    double start_us;
+    /** The duration in microseconds. */
+    double duration_us;
+    /** The thread that created or executed the primitive, numbered from 0 in
+     * the order the threads are met by the profiler. */
+    int thread_id;
+    /** The maximum number of threads of the library at the time of the
+     * event. */
+    int nthr;
+    /** The scratchpad size of the primitive in bytes. */
+    size_t scratchpad_size;
+} mkldnn_profiling_record_t;
+
+/** @} */
+
+/** @addtogroup c_api_types_arena Scratchpad arena
+ * @{ */
+
+/** Statistics of the arena the library scratchpads are allocated from, see
+ * mkldnn_get_scratchpad_arena_stats(). Sizes are in bytes. */
+typedef struct {
+    /** Memory mapped from the system: blocks in use and cached blocks. */
+    size_t mapped;
+    /** Memory of the blocks in use. */
+    size_t in_use;
+    /** Memory requested for the blocks in use. @c in_use - @c requested is
+     * lost to size class rounding. */
+    size_t requested;
+    /** Peak of @c in_use. */
+    size_t peak_in_use;
+    /** Part of @c mapped backed by huge pages: explicit huge pages, or
+     * transparent huge pages the kernel was advised to use. */
+    size_t hugepage_mapped;
+    /** Number of block requests. */
+    size_t allocations;
+    /** Number of block requests served by a cached block. */
+    size_t reuses;
+} mkldnn_arena_stats_t;
+
 /** @} */
 /** @} */
 /** @} */
@@ -0,0 +1,238 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifndef _WIN32
+#include <sys/mman.h>
+#endif
+
+#include "mkldnn.h"
+
+#include "arena.hpp"
+#include "nstl.hpp"
+#include "utils.hpp"
+
+namespace mkldnn {
+namespace impl {
+
+namespace {
+
+const size_t default_hugepage_size = 2 * 1024 * 1024;
+
+int int_from_env(const char *name, int default_value) {
+    const int len = 12;
+    char val[len] = {0};
+    if (mkldnn_getenv(name, val, len) > 0) return atoi(val);
+    return default_value;
+}
+
+size_t thp_size() {
+    size_t size = 0;
+    FILE *f = fopen("/sys/kernel/mm/transparent_hugepage/hpage_pmd_size",
+            "r");
+    if (f) {
+        if (fscanf(f, "%zu", &size) != 1) size = 0;
+        fclose(f);
+    }
+    return size ? size : default_hugepage_size;
+}
+
+size_t hugetlb_size() {
+    size_t size_kb = 0;
+    FILE *f = fopen("/proc/meminfo", "r");
+    if (f) {
+        char line[128];
+        while (fgets(line, sizeof(line), f))
+            if (sscanf(line, "Hugepagesize: %zu kB", &size_kb) == 1) break;
+        fclose(f);
+    }
+    return size_kb ? size_kb * 1024 : default_hugepage_size;
+}
+
+}
+
+scratchpad_arena_t::scratchpad_arena_t()
+    : enabled_(int_from_env("MKLDNN_SCRATCHPAD_ARENA", 1) != 0)
+    , hugepages_(hugepages_thp), thp_size_(thp_size())
+    , hugetlb_size_(hugetlb_size()) {
+#ifdef _WIN32
+    enabled_ = false;
+#endif
+    const int hp = int_from_env("MKLDNN_HUGEPAGES", 1);
+    hugepages_ = hp <= 0 ? hugepages_none
+        : hp == 1 ? hugepages_thp : hugepages_explicit;
+    memset(&stats_, 0, sizeof(stats_));
+}
+
+size_t scratchpad_arena_t::class_size(size_t size) const {
+    if (size <= min_block) return min_block;
+
+    /* 4 classes per power of two: 5/8, 6/8, 7/8 and 8/8 of it */
+    size_t pow2 = min_block;
+    while (pow2 < size) pow2 <<= 1;
+    size_t cs = utils::rnd_up(size, pow2 / 8);
+
+    if (hugepages_ != hugepages_none && cs >= thp_size_)
+        cs = utils::rnd_up(cs, thp_size_);
+    return cs;
+}
+
+void *scratchpad_arena_t::map(size_t size, bool &huge) const {
+    huge = false;
+#ifdef _WIN32
+    UNUSED(size);
+    return nullptr;
+#else
+    const int prot = PROT_READ | PROT_WRITE;
+    const int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+
+#ifdef MAP_HUGETLB
+    if (hugepages_ == hugepages_explicit && size % hugetlb_size_ == 0) {
+        void *ptr = mmap(nullptr, size, prot, flags | MAP_HUGETLB, -1, 0);
+        if (ptr != MAP_FAILED) {
+            huge = true;
+            return ptr;
+        }
+    }
+#endif
+
+    if (hugepages_ == hugepages_none || size < thp_size_) {
+        void *ptr = mmap(nullptr, size, prot, flags, -1, 0);
+        return ptr == MAP_FAILED ? nullptr : ptr;
+    }
+
+    /* transparent huge pages need a huge page aligned range: over-map and
+     * trim the ends */
+    char *raw = (char *)mmap(nullptr, size + thp_size_, prot, flags, -1, 0);
+    if (raw == (char *)MAP_FAILED) return nullptr;
+    char *ptr = utils::align_ptr(raw, thp_size_);
+    if (ptr != raw) munmap(raw, ptr - raw);
+    munmap(ptr + size, raw + thp_size_ - ptr);
+#ifdef MADV_HUGEPAGE
+    huge = madvise(ptr, size, MADV_HUGEPAGE) == 0;
+#endif
+    return ptr;
+#endif
+}
+
+void scratchpad_arena_t::unmap(void *ptr, const block_t &b) {
+#ifndef _WIN32
+    munmap(ptr, b.size);
+#else
+    UNUSED(ptr);
+#endif
+    stats_.mapped -= b.size;
+    if (b.huge) stats_.hugepage_mapped -= b.size;
+}
+
+void *scratchpad_arena_t::allocate(size_t size, int alignment) {
+    if (!enabled_ || size < min_block) return impl::malloc(size, alignment);
+
+    const size_t cs = class_size(size);
+    void *ptr = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++stats_.allocations;
+        auto &list = free_[cs];
+        if (!list.empty()) {
+            ptr = list.back();
+            list.pop_back();
+            ++stats_.reuses;
+        }
+    }
+
+    bool huge = false;
+    if (ptr == nullptr) {
+        /* not under the lock: mmap() may take a while */
+        ptr = map(cs, huge);
+        if (ptr == nullptr) return impl::malloc(size, alignment);
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = blocks_.find(ptr);
+    if (it == blocks_.end()) {
+        it = blocks_.insert({ ptr, block_t{ cs, 0, huge } }).first;
+        stats_.mapped += cs;
+        if (huge) stats_.hugepage_mapped += cs;
+    }
+    it->second.requested = size;
+    stats_.in_use += cs;
+    stats_.requested += size;
+    stats_.peak_in_use = nstl::max(stats_.peak_in_use, stats_.in_use);
+    return ptr;
+}
+
+void scratchpad_arena_t::deallocate(void *ptr) {
+    if (ptr == nullptr) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = blocks_.find(ptr);
+        if (it != blocks_.end()) {
+            block_t &b = it->second;
+            stats_.in_use -= b.size;
+            stats_.requested -= b.requested;
+            b.requested = 0;
+            free_[b.size].push_back(ptr);
+            return;
+        }
+    }
+    impl::free(ptr);
+}
+
+void scratchpad_arena_t::trim() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto &kv: free_) {
+        for (void *ptr: kv.second) {
+            auto it = blocks_.find(ptr);
+            unmap(ptr, it->second);
+            blocks_.erase(it);
+        }
+        kv.second.clear();
+    }
+}
+
+void scratchpad_arena_t::get_stats(arena_stats_t *stats) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    *stats = stats_;
+}
+
+scratchpad_arena_t &scratchpad_arena() {
+    /* never destroyed: scratchpads may be released by static objects
+     * destroyed after it */
+    static scratchpad_arena_t *arena = new scratchpad_arena_t();
+    return *arena;
+}
+
+}
+}
+
+using namespace mkldnn::impl;
+
+status_t mkldnn_get_scratchpad_arena_stats(arena_stats_t *stats) {
+    if (stats == nullptr) return status::invalid_arguments;
+    scratchpad_arena().get_stats(stats);
+    return status::success;
+}
+
+status_t mkldnn_trim_scratchpad_arena() {
+    scratchpad_arena().trim();
+    return status::success;
+}
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -0,0 +1,100 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+
+#ifndef ARENA_HPP
+#define ARENA_HPP
+
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "c_types_map.hpp"
+
+namespace mkldnn {
+namespace impl {
+
+/* Arena for the scratchpads
+ *
+ * Scratchpads of min_block bytes and more (im2col buffers, RNN spaces,
+ * Winograd transforms...) are carved from blocks mapped directly from the
+ * system. A request is rounded up to a size class, 4 classes per power of
+ * two, and released blocks are kept on a free list per class, so primitives
+ * created one after another recycle the same blocks instead of mapping and
+ * faulting in fresh memory each time.
+ *
+ * Blocks at least as large as a huge page are mapped with huge pages to
+ * reduce TLB pressure, depending on MKLDNN_HUGEPAGES: 0 -- none,
+ * 1 -- transparent huge pages (default), 2 -- explicit huge pages from the
+ * hugetlbfs pool, falling back to transparent ones when the pool is empty.
+ *
+ * Smaller requests, and all requests with MKLDNN_SCRATCHPAD_ARENA=0, are
+ * passed to impl::malloc(). */
+struct scratchpad_arena_t {
+    enum { min_block = 256 * 1024 };
+
+    scratchpad_arena_t();
+
+    /** Returns at least @p size bytes. Requests passed to impl::malloc()
+     * are aligned on @p alignment, arena blocks on the page size (the huge
+     * page size if backed by transparent huge pages). */
+    void *allocate(size_t size, int alignment);
+    /** Releases memory returned by allocate(). */
+    void deallocate(void *ptr);
+
+    /** Unmaps the cached blocks. */
+    void trim();
+
+    void get_stats(arena_stats_t *stats) const;
+
+private:
+    enum hugepages_t { hugepages_none, hugepages_thp, hugepages_explicit };
+
+    struct block_t {
+        size_t size;
+        size_t requested;
+        bool huge;
+    };
+
+    size_t class_size(size_t size) const;
+    void *map(size_t size, bool &huge) const;
+    void unmap(void *ptr, const block_t &b);
+
+    bool enabled_;
+    hugepages_t hugepages_;
+    size_t thp_size_;
+    size_t hugetlb_size_;
+
+    /* blocks in use and cached blocks */
+    std::unordered_map<void *, block_t> blocks_;
+    /* cached blocks per class size */
+    std::unordered_map<size_t, std::vector<void *>> free_;
+
+    arena_stats_t stats_;
+    mutable std::mutex mutex_;
+
+    scratchpad_arena_t(const scratchpad_arena_t &) = delete;
+    scratchpad_arena_t &operator=(const scratchpad_arena_t &) = delete;
+};
+
+scratchpad_arena_t &scratchpad_arena();
+
+}
+}
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
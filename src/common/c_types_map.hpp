@@ -100,6 +100,12 @@ namespace data_type {
     const data_type_t bf16 = mkldnn_bf16;
 }
 
+using scratchpad_mode_t = mkldnn_scratchpad_mode_t;
+namespace scratchpad_mode {
+    const scratchpad_mode_t library = mkldnn_scratchpad_mode_library;
+    const scratchpad_mode_t user = mkldnn_scratchpad_mode_user;
+}
+
 using round_mode_t = mkldnn_round_mode_t;
 namespace round_mode {
     const round_mode_t nearest = mkldnn_round_nearest;
@@ -421,6 +427,27 @@ namespace stream_kind {
     const stream_kind_t lazy = mkldnn_lazy;
 }
 using stream_t = mkldnn_stream;
+using instance_t = mkldnn_instance;
+
+using packed_weights_t = mkldnn_packed_weights;
+
+using weights_file_flags_t = mkldnn_weights_file_flags_t;
+namespace weights_file_flags {
+    const weights_file_flags_t populate = mkldnn_weights_file_populate;
+    const weights_file_flags_t hugepages = mkldnn_weights_file_hugepages;
+    const weights_file_flags_t numa_interleave
+        = mkldnn_weights_file_numa_interleave;
+}
+using weights_file_t = mkldnn_weights_file;
+
+using profiling_event_t = mkldnn_profiling_event_t;
+namespace profiling_event {
+    const profiling_event_t create = mkldnn_profiling_create;
+    const profiling_event_t execute = mkldnn_profiling_execute;
+}
+using profiling_record_t = mkldnn_profiling_record_t;
+
+using arena_stats_t = mkldnn_arena_stats_t;
 
 /* forward declaration of internal primitive_desc types */
 struct memory_pd_t;
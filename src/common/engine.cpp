@@ -17,6 +17,7 @@
 #include "mkldnn.h"
 #include "engine.hpp"
 #include "nstl.hpp"
+#include "primitive_cache.hpp"
 
 #include "c_types_map.hpp"
 #include "../cpu/cpu_engine.hpp"
@@ -92,6 +93,7 @@ status_t mkldnn_engine_get_kind(engine_t *engine, engine_kind_t *kind) {
 
 status_t mkldnn_engine_destroy(engine_t *engine) {
     /* TODO: engine->dec_ref_count(); */
+    primitive_cache().evict(engine);
     delete engine;
     return success;
 }
@@ -0,0 +1,138 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+
+#include "mkldnn.h"
+#include "mkldnn_threadpool_iface.hpp"
+
+#include "c_types_map.hpp"
+#include "instance.hpp"
+#include "mkldnn_thread.hpp"
+#include "numa.hpp"
+#include "type_helpers.hpp"
+#include "utils.hpp"
+
+using namespace mkldnn::impl;
+using namespace mkldnn::impl::status;
+
+namespace {
+
+struct attach_state_t {
+    instance_t *instance;
+    int saved_nthr;
+    mkldnn::threadpool_iface *saved_threadpool;
+    /* the team is pinned to the CPUs of the instance */
+    bool pinned;
+    numa::team_affinity_t saved_affinity;
+};
+
+thread_local attach_state_t attach_state
+    = { nullptr, 0, nullptr, false, numa::team_affinity_t() };
+
+}
+
+mkldnn_instance::mkldnn_instance(int nthr, int first_cpu): nthr_(nthr) {
+    if (first_cpu >= 0)
+        for (int i = 0; i < nthr; ++i)
+            cpus_.push_back(first_cpu + i);
+#if MKLDNN_THR == MKLDNN_THR_THREADPOOL
+    pool_.reset(threadpool_utils::create_threadpool(nthr));
+#elif MKLDNN_THR == MKLDNN_THR_TBB
+    arena_.reset(new tbb::task_arena(nthr));
+#endif
+}
+
+mkldnn_instance::~mkldnn_instance() {
+    if (attached() == this) detach();
+}
+
+status_t mkldnn_instance::attach() {
+    if (attached() == this) return success;
+    if (attached() != nullptr) detach();
+
+#if MKLDNN_THR == MKLDNN_THR_OMP
+    attach_state.saved_nthr = omp_get_max_threads();
+    omp_set_num_threads(nthr_);
+#elif MKLDNN_THR == MKLDNN_THR_THREADPOOL
+    attach_state.saved_threadpool
+        = threadpool_utils::set_thread_threadpool(pool_.get());
+#elif MKLDNN_THR == MKLDNN_THR_TBB
+    return unimplemented;
+#endif
+    attach_state.instance = this;
+
+    if (!cpus_.empty()) {
+        attach_state.saved_affinity.save();
+        attach_state.pinned = true;
+        status_t status = numa::pin_threads(cpus_);
+        if (status != success) {
+            detach();
+            return status;
+        }
+    }
+    return success;
+}
+
+void mkldnn_instance::detach() {
+    if (attach_state.instance == nullptr) return;
+    if (attach_state.pinned) {
+        /* the team is still the one of the instance here */
+        attach_state.saved_affinity.restore();
+        attach_state.pinned = false;
+    }
+#if MKLDNN_THR == MKLDNN_THR_OMP
+    omp_set_num_threads(attach_state.saved_nthr);
+#elif MKLDNN_THR == MKLDNN_THR_THREADPOOL
+    threadpool_utils::set_thread_threadpool(attach_state.saved_threadpool);
+#endif
+    attach_state.instance = nullptr;
+}
+
+mkldnn_instance *mkldnn_instance::attached() {
+    return attach_state.instance;
+}
+
+status_t mkldnn_instance_create(instance_t **instance, int nthreads,
+        int first_cpu) {
+    if (instance == nullptr || nthreads < 1 || first_cpu < -1)
+        return invalid_arguments;
+#if MKLDNN_THR == MKLDNN_THR_SEQ
+    if (nthreads != 1) return invalid_arguments;
+#endif
+    return safe_ptr_assign<instance_t>(*instance,
+            new instance_t(nthreads, first_cpu));
+}
+
+status_t mkldnn_instance_attach(instance_t *instance) {
+    if (instance == nullptr) return invalid_arguments;
+    return instance->attach();
+}
+
+status_t mkldnn_instance_detach() {
+    instance_t::detach();
+    return success;
+}
+
+status_t mkldnn_instance_destroy(instance_t *instance) {
+    delete instance;
+    return success;
+}
+
+int mkldnn_instance_get_max_threads() {
+    return mkldnn_get_max_threads();
+}
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -0,0 +1,110 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+
+#ifndef INSTANCE_HPP
+#define INSTANCE_HPP
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "mkldnn.h"
+
+#include "c_types_map.hpp"
+#include "mkldnn_thread.hpp"
+#include "scratchpad.hpp"
+#include "utils.hpp"
+
+/** An execution instance: a thread team of nthr threads, optionally pinned
+ * to the CPUs [first_cpu, first_cpu + nthr), with its own scratchpad.
+ *
+ * A thread attached to an instance sees mkldnn_get_max_threads() == nthr,
+ * so the primitive descriptors it creates block their work for the
+ * instance, and its parallel regions run on the instance team:
+ *  - OpenMP: the team of the attached thread, sized by the nthreads-var
+ *    ICV of that thread. Each application thread has its own team, so the
+ *    instances used by different threads run concurrently.
+ *  - threadpool: a built-in threadpool owned by the instance.
+ *  - TBB: a task arena owned by the instance; threads cannot be attached,
+ *    only streams bound to the instance use it.
+ *
+ * The streams bound to an instance run one at a time on it.
+ *
+ * Primitives keep the number of threads they were created for: the ones
+ * created on a thread that was not attached, e.g. JIT convolutions with
+ * jcp.nthr set from all the threads, oversubscribe the instance's cores.
+ * Create the primitives of an instance while attached to it.
+ *
+ * A thread pinned with the instance gets its previous affinity back on
+ * detach(), and the team the affinity of the process. */
+struct mkldnn_instance: public mkldnn::impl::c_compatible {
+    mkldnn_instance(int nthr, int first_cpu);
+    ~mkldnn_instance();
+
+    int nthr() const { return nthr_; }
+
+    /** attaches the calling thread to the instance, detaching it from the
+     * one it was attached to if any */
+    mkldnn::impl::status_t attach();
+    /** detaches the calling thread from its instance */
+    static void detach();
+    /** returns the instance the calling thread is attached to, or
+     * nullptr */
+    static mkldnn_instance *attached();
+
+    /** runs @p f on the instance: with the calling thread attached to it,
+     * and not concurrently with other executions on the instance */
+    template <typename F>
+    mkldnn::impl::status_t execute(F f) {
+        using namespace mkldnn::impl;
+        std::lock_guard<std::mutex> lock(mutex_);
+#if MKLDNN_THR == MKLDNN_THR_TBB
+        status_t status = status::success;
+        arena_->execute([&]() { status = f(); });
+        return status;
+#else
+        mkldnn_instance *prev = attached();
+        if (prev == this) return f();
+        status_t status = attach();
+        if (status != status::success) return status;
+        status = f();
+        detach();
+        if (prev) prev->attach();
+        return status;
+#endif
+    }
+
+    mkldnn::impl::stream_scratchpad_t &scratchpad() { return scratchpad_; }
+
+private:
+    int nthr_;
+    std::vector<int> cpus_;
+#if MKLDNN_THR == MKLDNN_THR_THREADPOOL
+    std::unique_ptr<mkldnn::threadpool_iface> pool_;
+#elif MKLDNN_THR == MKLDNN_THR_TBB
+    std::unique_ptr<tbb::task_arena> arena_;
+#endif
+    mkldnn::impl::stream_scratchpad_t scratchpad_;
+    std::mutex mutex_;
+
+    mkldnn_instance(const mkldnn_instance &) = delete;
+    mkldnn_instance &operator=(const mkldnn_instance &) = delete;
+};
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -0,0 +1,133 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+
+#include <string.h>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
+
+#include "mapped_file.hpp"
+
+namespace mkldnn {
+namespace impl {
+
+using namespace mkldnn::impl::status;
+
+namespace {
+
+#if defined(__linux__) && defined(SYS_set_mempolicy)
+/* Makes the page cache pages read while the guard is alive interleaved
+ * across the memory nodes allowed to the process. The raw syscalls avoid a
+ * dependency on libnuma; failures leave the policy unchanged. */
+struct interleave_guard_t {
+    interleave_guard_t(): restore_(false) {
+        const int mpol_interleave = 3;
+        const unsigned long mpol_f_mems_allowed = 1UL << 2;
+        unsigned long allowed[nwords];
+        if (syscall(SYS_get_mempolicy, &old_mode_, old_mask_, max_node + 1,
+                    nullptr, 0UL) != 0)
+            return;
+        if (syscall(SYS_get_mempolicy, nullptr, allowed, max_node + 1,
+                    nullptr, mpol_f_mems_allowed) != 0)
+            return;
+        restore_ = syscall(SYS_set_mempolicy, mpol_interleave, allowed,
+                max_node + 1) == 0;
+    }
+
+    ~interleave_guard_t() {
+        if (restore_)
+            syscall(SYS_set_mempolicy, old_mode_, old_mask_, max_node + 1);
+    }
+
+private:
+    static constexpr unsigned long max_node = 1024;
+    static constexpr size_t nwords = max_node / (8 * sizeof(unsigned long));
+
+    bool restore_;
+    int old_mode_;
+    unsigned long old_mask_[nwords];
+};
+#else
+struct interleave_guard_t {};
+#endif
+
+}
+
+status_t mapped_file_t::map(std::shared_ptr<mapped_file_t> &file,
+        const char *path, unsigned flags) {
+#ifdef _WIN32
+    UNUSED(file); UNUSED(path); UNUSED(flags);
+    return unimplemented;
+#else
+    using namespace weights_file_flags;
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return invalid_arguments;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        close(fd);
+        return invalid_arguments;
+    }
+    const size_t size = (size_t)st.st_size;
+
+    /* MAP_POPULATE would read the file before madvise() and the memory
+     * policy could apply, so in these cases the pages are touched below */
+    const bool touch = (flags & (hugepages | numa_interleave)) != 0;
+    int mmap_flags = MAP_SHARED;
+#ifdef MAP_POPULATE
+    if ((flags & populate) && !touch) mmap_flags |= MAP_POPULATE;
+#endif
+    void *base = mmap(nullptr, size, PROT_READ, mmap_flags, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) return out_of_memory;
+
+#ifdef MADV_HUGEPAGE
+    if (flags & hugepages) madvise(base, size, MADV_HUGEPAGE);
+#endif
+
+    if (touch && (flags & (populate | numa_interleave))) {
+        interleave_guard_t *guard = (flags & numa_interleave)
+            ? new interleave_guard_t() : nullptr;
+        const size_t page_size = (size_t)sysconf(_SC_PAGESIZE);
+        const volatile char *p = (const volatile char *)base;
+        for (size_t off = 0; off < size; off += page_size)
+            (void)p[off];
+        delete guard;
+    }
+
+    file.reset(new mapped_file_t(base, size));
+    return success;
+#endif
+}
+
+mapped_file_t::~mapped_file_t() {
+#ifndef _WIN32
+    munmap(base_, size_);
+#endif
+}
+
+}
+}
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
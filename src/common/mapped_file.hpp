@@ -0,0 +1,55 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+#include <memory>
+
+#include "c_types_map.hpp"
+#include "utils.hpp"
+
+namespace mkldnn {
+namespace impl {
+
+/** A read-only shared mapping of a whole file. */
+struct mapped_file_t {
+    /** Maps the file @p path. @p flags is a combination of
+     * #mkldnn_weights_file_flags_t. */
+    static status_t map(std::shared_ptr<mapped_file_t> &file,
+            const char *path, unsigned flags);
+
+    ~mapped_file_t();
+
+    const char *data() const { return (const char *)base_; }
+    size_t size() const { return size_; }
+
+private:
+    mapped_file_t(void *base, size_t size): base_(base), size_(size) {}
+
+    void *base_;
+    size_t size_;
+
+    mapped_file_t(const mapped_file_t &) = delete;
+    mapped_file_t &operator=(const mapped_file_t &) = delete;
+};
+
+}
+}
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
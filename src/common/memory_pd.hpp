@@ -138,6 +138,8 @@ struct sum_pd_t: public primitive_desc_t {
     { return index == 0 ? dst_pd() : nullptr; }
     virtual int n_inputs() const override { return n_; }
     virtual int n_outputs() const override { return 1; }
+    /** returns the scale of each input, nullptr if unknown */
+    virtual const float *scales() const { return nullptr; }
 protected:
     int n_;
 };
@@ -21,6 +21,7 @@
 #include <unordered_map>
 
 #include "nstl.hpp"
+#include "numa.hpp"
 #include "utils.hpp"
 
 namespace mkldnn {
@@ -156,6 +157,7 @@ enum {
     key_concat_optrs,
     key_conv_adjusted_scales,
     key_conv_bia_reduction,
+    key_conv_compensation,
     key_conv_gemm_col,
     key_conv_gemm_imtr,
     key_conv_int_dat_in_acc_dt,
@@ -173,6 +175,7 @@ enum {
     key_deconv_dst_bf16_convert_wsp,
     key_pool_src_bf16cvt,
     key_pool_dst_bf16cvt,
+    key_pool_reduction,
     key_iprod_dst_bf16_convert_wsp,
     key_iprod_bias_bf16_convert_wsp,
     key_iprod_int_dat_in_acc_dt,
@@ -249,6 +252,13 @@ struct registry_t {
     size_t size() const
     { return size_ > 0 ? size_ + minimal_alignment - 1 : 0; }
 
+    /** places each piece of the scratchpad at @p base_ptr on the nodes of
+     * the threads using it, see numa::first_touch() */
+    void first_touch(void *base_ptr) const {
+        for (const auto &kv: offset_map_)
+            numa::first_touch(get(kv.first, base_ptr), kv.second.size);
+    }
+
     registrar_t registrar();
     grantor_t grantor(void *base_ptr) const;
 
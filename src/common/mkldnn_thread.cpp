@@ -0,0 +1,278 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "mkldnn.h"
+#include "mkldnn_threadpool_iface.hpp"
+
+#include "c_types_map.hpp"
+#include "mkldnn_thread.hpp"
+
+#if MKLDNN_THR == MKLDNN_THR_THREADPOOL
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "utils.hpp"
+
+namespace mkldnn {
+namespace impl {
+namespace threadpool_utils {
+
+namespace {
+
+/* the threadpool of the instance the thread is attached to, or of which the
+ * thread is a worker */
+thread_local threadpool_iface *thread_threadpool = nullptr;
+
+/** Built-in threadpool.
+ *
+ * The tasks of a region are split into contiguous ranges, one per
+ * participant: the workers and the submitting thread. A range is a single
+ * atomic word holding [begin, end), so the owner pops tasks from the front
+ * and idle participants steal from the back of other ranges with a CAS,
+ * without locks. A task can only be taken from the region being run, and
+ * the region does not complete until all its tasks have run, so a
+ * participant woken late never runs a stale task.
+ *
+ * Idle workers spin for a while before sleeping on a condition variable.
+ * A region submitted while another one is running (i.e. from another
+ * application thread) runs on the submitting thread. */
+class work_stealing_pool_t: public threadpool_iface {
+public:
+    explicit work_stealing_pool_t(int nthr)
+        : nthr_(nthr), ranges_(new range_t[nthr]), fn_(nullptr), n_(0)
+        , pending_(0), epoch_(0), stop_(false) {
+        for (int i = 0; i < nthr_; ++i) ranges_[i].r.store(pack(0, 0));
+        /* the submitting thread is the last participant */
+        for (int i = 0; i < nthr_ - 1; ++i)
+            workers_.emplace_back([this, i]() { worker(i); });
+    }
+
+    ~work_stealing_pool_t() {
+        {
+            std::lock_guard<std::mutex> lock(wait_mutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        for (auto &w: workers_) w.join();
+    }
+
+    virtual int get_num_threads() const override { return nthr_; }
+    virtual bool get_in_parallel() const override { return is_worker_; }
+
+    virtual void parallel_for(int n,
+            const std::function<void(int, int)> &fn) override {
+        if (n <= 0) return;
+
+        std::unique_lock<std::mutex> submit(submit_mutex_, std::try_to_lock);
+        if (n == 1 || nthr_ == 1 || !submit.owns_lock() || is_worker_) {
+            for (int i = 0; i < n; ++i) fn(i, n);
+            return;
+        }
+
+        fn_ = &fn;
+        n_ = n;
+        pending_.store(n);
+        for (int p = 0; p < nthr_; ++p) {
+            int start{0}, end{0};
+            balance211(n, nthr_, p, start, end);
+            ranges_[p].r.store(pack(start, end));
+        }
+        {
+            std::lock_guard<std::mutex> lock(wait_mutex_);
+            epoch_.fetch_add(1);
+        }
+        wake_.notify_all();
+
+        run(nthr_ - 1);
+        while (pending_.load() != 0) std::this_thread::yield();
+        fn_ = nullptr;
+    }
+
+private:
+    struct range_t {
+        std::atomic<uint64_t> r;
+        char pad_[64 - sizeof(std::atomic<uint64_t>)];
+    };
+
+    static uint64_t pack(uint32_t begin, uint32_t end)
+    { return ((uint64_t)end << 32) | begin; }
+
+    bool pop(int p, int &task) {
+        uint64_t v = ranges_[p].r.load();
+        for (;;) {
+            const uint32_t begin = (uint32_t)v, end = (uint32_t)(v >> 32);
+            if (begin >= end) return false;
+            if (ranges_[p].r.compare_exchange_weak(v, pack(begin + 1, end))) {
+                task = (int)begin;
+                return true;
+            }
+        }
+    }
+
+    bool steal(int p, int &task) {
+        uint64_t v = ranges_[p].r.load();
+        for (;;) {
+            const uint32_t begin = (uint32_t)v, end = (uint32_t)(v >> 32);
+            if (begin >= end) return false;
+            if (ranges_[p].r.compare_exchange_weak(v, pack(begin, end - 1))) {
+                task = (int)end - 1;
+                return true;
+            }
+        }
+    }
+
+    void run(int self) {
+        int task;
+        for (;;) {
+            bool found = pop(self, task);
+            for (int i = 1; !found && i < nthr_; ++i)
+                found = steal((self + i) % nthr_, task);
+            if (!found) return;
+            /* the region cannot complete before this task, fn_ is valid */
+            (*fn_)(task, n_);
+            pending_.fetch_sub(1);
+        }
+    }
+
+    void worker(int self) {
+        is_worker_ = true;
+        thread_threadpool = this;
+        unsigned seen = 0;
+        for (;;) {
+            for (int spin = 0; spin < spin_count && epoch_.load() == seen
+                    && !stop_.load(); ++spin)
+                std::this_thread::yield();
+            {
+                std::unique_lock<std::mutex> lock(wait_mutex_);
+                wake_.wait(lock, [&]()
+                        { return stop_.load() || epoch_.load() != seen; });
+                if (stop_.load()) return;
+                seen = epoch_.load();
+            }
+            run(self);
+        }
+    }
+
+    static constexpr int spin_count = 1024;
+    static thread_local bool is_worker_;
+
+    const int nthr_;
+    std::vector<std::thread> workers_;
+    std::unique_ptr<range_t[]> ranges_;
+    const std::function<void(int, int)> *fn_;
+    int n_;
+    std::atomic<int> pending_;
+    std::atomic<unsigned> epoch_;
+    std::atomic<bool> stop_;
+    std::mutex submit_mutex_, wait_mutex_;
+    std::condition_variable wake_;
+};
+
+thread_local bool work_stealing_pool_t::is_worker_ = false;
+
+int default_num_threads() {
+    char buf[16];
+    if (mkldnn_getenv("MKLDNN_NUM_THREADS", buf, sizeof(buf)) > 0) {
+        int nthr = atoi(buf);
+        if (nthr > 0) return nthr;
+    }
+    int nthr = (int)std::thread::hardware_concurrency();
+    return nthr > 0 ? nthr : 1;
+}
+
+threadpool_iface *default_threadpool() {
+    static work_stealing_pool_t pool(default_num_threads());
+    return &pool;
+}
+
+std::atomic<threadpool_iface *> user_threadpool(nullptr);
+
+/* position of the calling thread in the innermost region of the library */
+thread_local int thr_ithr = 0;
+thread_local int thr_nthr = 1;
+thread_local bool thr_in_parallel = false;
+
+}
+
+threadpool_iface *get_active_threadpool() {
+    if (thread_threadpool) return thread_threadpool;
+    threadpool_iface *tp = user_threadpool.load();
+    return tp ? tp : default_threadpool();
+}
+
+threadpool_iface *set_thread_threadpool(threadpool_iface *tp) {
+    threadpool_iface *prev = thread_threadpool;
+    thread_threadpool = tp;
+    return prev;
+}
+
+threadpool_iface *create_threadpool(int nthr) {
+    return new work_stealing_pool_t(nthr);
+}
+
+void parallel_for(int n, const std::function<void(int, int)> &f) {
+    get_active_threadpool()->parallel_for(n, [&](int ithr, int nthr) {
+        const int ithr_save = thr_ithr, nthr_save = thr_nthr;
+        const bool in_parallel_save = thr_in_parallel;
+        thr_ithr = ithr;
+        thr_nthr = nthr;
+        thr_in_parallel = true;
+        f(ithr, nthr);
+        thr_ithr = ithr_save;
+        thr_nthr = nthr_save;
+        thr_in_parallel = in_parallel_save;
+    });
+}
+
+int get_thread_num() { return thr_ithr; }
+int get_num_threads() { return thr_nthr; }
+bool in_parallel() { return thr_in_parallel; }
+
+}
+}
+}
+#endif
+
+namespace mkldnn {
+
+mkldnn_status_t set_threadpool(threadpool_iface *threadpool) {
+#if MKLDNN_THR == MKLDNN_THR_THREADPOOL
+    impl::threadpool_utils::user_threadpool.store(threadpool);
+    return mkldnn_success;
+#else
+    UNUSED(threadpool);
+    return mkldnn_unimplemented;
+#endif
+}
+
+threadpool_iface *get_threadpool() {
+#if MKLDNN_THR == MKLDNN_THR_THREADPOOL
+    return impl::threadpool_utils::get_active_threadpool();
+#else
+    return nullptr;
+#endif
+}
+
+}
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -23,6 +23,7 @@
 #define MKLDNN_THR_SEQ 0
 #define MKLDNN_THR_OMP 1
 #define MKLDNN_THR_TBB 2
+#define MKLDNN_THR_THREADPOOL 3
 
 /* Ideally this condition below should never happen (if the library is built
  * using regular cmake). For the 3rd-party projects that build the library
@@ -74,6 +75,49 @@ inline void mkldnn_thr_barrier() { assert(!"no barrier in TBB"); }
 
 #define PRAGMA_OMP(...)
 
+#elif MKLDNN_THR == MKLDNN_THR_THREADPOOL
+#include <functional>
+#include "mkldnn_threadpool_iface.hpp"
+/* Tasks of a parallel region are not guaranteed to run concurrently, so
+ * there is no barrier: mkldnn_thr_syncable() steers the kernels to their
+ * barrier-free paths, exactly as with TBB */
+#define MKLDNN_THR_SYNC 0
+
+namespace mkldnn {
+namespace impl {
+namespace threadpool_utils {
+/* the threadpool of the instance the calling thread is attached to, the
+ * threadpool set by the application or the built-in one */
+mkldnn::threadpool_iface *get_active_threadpool();
+/* makes @p tp the active threadpool of the calling thread (nullptr to
+ * restore the process-wide one), returns the previous one */
+mkldnn::threadpool_iface *set_thread_threadpool(
+        mkldnn::threadpool_iface *tp);
+/* creates a built-in threadpool of @p nthr threads */
+mkldnn::threadpool_iface *create_threadpool(int nthr);
+/* runs f(ithr, nthr) for each ithr on the active threadpool */
+void parallel_for(int nthr, const std::function<void(int, int)> &f);
+int get_thread_num();
+int get_num_threads();
+bool in_parallel();
+}
+}
+}
+
+inline int mkldnn_get_max_threads() {
+    return mkldnn::impl::threadpool_utils::get_active_threadpool()
+        ->get_num_threads();
+}
+inline int mkldnn_get_num_threads()
+{ return mkldnn::impl::threadpool_utils::get_num_threads(); }
+inline int mkldnn_get_thread_num()
+{ return mkldnn::impl::threadpool_utils::get_thread_num(); }
+inline int mkldnn_in_parallel()
+{ return mkldnn::impl::threadpool_utils::in_parallel(); }
+inline void mkldnn_thr_barrier() { assert(!"no barrier in THREADPOOL"); }
+
+#define PRAGMA_OMP(...)
+
 #endif
 
 /* MSVC still supports omp 2.0 only */
@@ -49,6 +49,10 @@ void parallel(int nthr, F f) {
 #elif MKLDNN_THR == MKLDNN_THR_TBB
     if (nthr == 1) { f(0, 1); return; }
     tbb::parallel_for(0, nthr, [&](int ithr) { f(ithr, nthr); });
+#elif MKLDNN_THR == MKLDNN_THR_THREADPOOL
+    /* nested regions run sequentially, as with OpenMP nesting disabled */
+    if (nthr == 1 || mkldnn_in_parallel()) { f(0, 1); return; }
+    threadpool_utils::parallel_for(nthr, f);
 #endif
 }
 
@@ -152,7 +156,7 @@ constexpr size_t get_work_amount(const T &v, Args &&...args)
 
 /* parallel_nd and parallel_nd_in_omp section */
 
-#if MKLDNN_THR != MKLDNN_THR_TBB
+#if MKLDNN_THR != MKLDNN_THR_TBB && MKLDNN_THR != MKLDNN_THR_THREADPOOL
 template <typename ...Args>
 void parallel_nd(Args &&...args) {
 #if MKLDNN_THR == MKLDNN_THR_SEQ
@@ -167,40 +171,42 @@ void parallel_nd(Args &&...args) {
     }
 #endif
 }
-#else // MKLDNN_THR != MKLDNN_THR_TBB
+#else // MKLDNN_THR != MKLDNN_THR_TBB && MKLDNN_THR != MKLDNN_THR_THREADPOOL
 
 // gcc 4.8 has a bug with passing parameter pack to lambdas.
 // So have to explicitly instantiate all the cases.
+// The region may get fewer threads than requested (e.g. when nested), so
+// the work is split among the threads parallel() actually provides.
 
 template <typename T0, typename F>
 void parallel_nd(const T0 &D0, F f) {
     const int nthr = mkldnn_get_max_threads();
-    tbb::parallel_for(0, nthr, [&](int ithr) {
-        for_nd(ithr, nthr, D0, f);
+    parallel(nthr, [&](int ithr, int nthr_) {
+        for_nd(ithr, nthr_, D0, f);
     });
 }
 
 template <typename T0, typename T1, typename F>
 void parallel_nd(const T0 &D0, const T1 &D1, F f) {
     const int nthr = mkldnn_get_max_threads();
-    tbb::parallel_for(0, nthr, [&](int ithr) {
-        for_nd(ithr, nthr, D0, D1, f);
+    parallel(nthr, [&](int ithr, int nthr_) {
+        for_nd(ithr, nthr_, D0, D1, f);
     });
 }
 
 template <typename T0, typename T1, typename T2, typename F>
 void parallel_nd(const T0 &D0, const T1 &D1, const T2 &D2, F f) {
     const int nthr = mkldnn_get_max_threads();
-    tbb::parallel_for(0, nthr, [&](int ithr) {
-        for_nd(ithr, nthr, D0, D1, D2, f);
+    parallel(nthr, [&](int ithr, int nthr_) {
+        for_nd(ithr, nthr_, D0, D1, D2, f);
     });
 }
 
 template <typename T0, typename T1, typename T2, typename T3, typename F>
 void parallel_nd(const T0 &D0, const T1 &D1, const T2 &D2, const T3 &D3, F f) {
     const int nthr = mkldnn_get_max_threads();
-    tbb::parallel_for(0, nthr, [&](int ithr) {
-        for_nd(ithr, nthr, D0, D1, D2, D3, f);
+    parallel(nthr, [&](int ithr, int nthr_) {
+        for_nd(ithr, nthr_, D0, D1, D2, D3, f);
     });
 }
 
@@ -209,8 +215,8 @@ template <typename T0, typename T1, typename T2, typename T3, typename T4,
 void parallel_nd(const T0 &D0, const T1 &D1, const T2 &D2, const T3 &D3,
         const T4 &D4, F f) {
     const int nthr = mkldnn_get_max_threads();
-    tbb::parallel_for(0, nthr, [&](int ithr) {
-        for_nd(ithr, nthr, D0, D1, D2, D3, D4, f);
+    parallel(nthr, [&](int ithr, int nthr_) {
+        for_nd(ithr, nthr_, D0, D1, D2, D3, D4, f);
     });
 }
 
@@ -219,8 +225,8 @@ template <typename T0, typename T1, typename T2, typename T3, typename T4,
 void parallel_nd(const T0 &D0, const T1 &D1, const T2 &D2, const T3 &D3,
         const T4 &D4, const T5 &D5, F f) {
     const int nthr = mkldnn_get_max_threads();
-    tbb::parallel_for(0, nthr, [&](int ithr) {
-        for_nd(ithr, nthr, D0, D1, D2, D3, D4, D5, f);
+    parallel(nthr, [&](int ithr, int nthr_) {
+        for_nd(ithr, nthr_, D0, D1, D2, D3, D4, D5, f);
     });
 }
 #endif
@@ -234,6 +240,9 @@ void parallel_nd_in_omp(Args &&...args) {
             utils::forward<Args>(args)...);
 #elif MKLDNN_THR == MKLDNN_THR_TBB
     assert(!"unsupported parallel_nd_in_omp()");
+#elif MKLDNN_THR == MKLDNN_THR_THREADPOOL
+    for_nd(mkldnn_get_thread_num(), mkldnn_get_num_threads(),
+            utils::forward<Args>(args)...);
 #endif
 }
 
@@ -0,0 +1,262 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <atomic>
+#include <mutex>
+#include <vector>
+#ifdef __linux__
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+#include "mkldnn_thread.hpp"
+#include "numa.hpp"
+#include "utils.hpp"
+
+namespace mkldnn {
+namespace impl {
+namespace numa {
+
+using namespace mkldnn::impl::status;
+
+namespace {
+
+/* parses a sysfs list, e.g. "0-3,8-11", into @p ids */
+bool read_list(const char *path, std::vector<int> &ids) {
+    ids.clear();
+    FILE *f = fopen(path, "r");
+    if (f == nullptr) return false;
+
+    int first, last;
+    char sep = ',';
+    while (sep == ',' && fscanf(f, "%d", &first) == 1) {
+        last = first;
+        if (fscanf(f, "%c", &sep) == 1 && sep == '-') {
+            if (fscanf(f, "%d", &last) != 1) break;
+            if (fscanf(f, "%c", &sep) != 1) sep = '\n';
+        }
+        for (int i = first; i <= last; ++i)
+            ids.push_back(i);
+    }
+    fclose(f);
+    return !ids.empty();
+}
+
+struct topology_t {
+    topology_t(): nnodes(1), has_allowed(false) {
+#ifdef __linux__
+        /* the affinity of the process, not of a pinned thread: the
+         * topology is read at load time, see topology_at_load */
+        CPU_ZERO(&allowed);
+        has_allowed = sched_getaffinity(0, sizeof(allowed), &allowed) == 0;
+
+        std::vector<int> nodes;
+        if (!read_list("/sys/devices/system/node/online", nodes)) return;
+        nnodes = nodes.back() + 1;
+        node_cpus.resize(nnodes);
+
+        for (int node: nodes) {
+            char path[64];
+            snprintf(path, sizeof(path),
+                    "/sys/devices/system/node/node%d/cpulist", node);
+            std::vector<int> cpus;
+            read_list(path, cpus);
+            for (int cpu: cpus)
+                if (cpu < CPU_SETSIZE
+                        && (!has_allowed || CPU_ISSET(cpu, &allowed)))
+                    node_cpus[node].push_back(cpu);
+        }
+#endif
+    }
+
+    int nnodes;
+    std::vector<std::vector<int>> node_cpus;
+    /* the affinity of the process at load time */
+    bool has_allowed;
+#ifdef __linux__
+    cpu_set_t allowed;
+#endif
+};
+
+const topology_t &topology() {
+    static topology_t t;
+    return t;
+}
+
+/* reads the topology before any thread of the process is pinned */
+const topology_t &topology_at_load = topology();
+
+/* the node the library threads are pinned to, -1 if they are not; the
+ * team is shared by all the streams. pin_mutex guards it and the team
+ * affinity; it is recursive as pin_threads(int) saves the affinity and
+ * pins under it. */
+std::atomic<int> pinned_node(-1);
+std::recursive_mutex pin_mutex;
+
+/* the affinity of the team before pin_threads(int) */
+team_affinity_t unpinned_affinity;
+
+size_t page_size() {
+#ifdef __linux__
+    static const size_t size = (size_t)sysconf(_SC_PAGESIZE);
+    return size;
+#else
+    return 4096;
+#endif
+}
+
+}
+
+int num_nodes() { return topology().nnodes; }
+
+int num_cpus(int node) {
+    if (node < 0 || node >= num_nodes()) return 0;
+    if (topology().node_cpus.empty()) return 0;
+    return (int)topology().node_cpus[node].size();
+}
+
+bool enabled() {
+    static const bool enabled = [] {
+        const int len = 4;
+        char val[len] = {0};
+        if (mkldnn_getenv("MKLDNN_NUMA", val, len) > 0 && atoi(val) == 0)
+            return false;
+        return num_nodes() > 1;
+    }();
+    return enabled;
+}
+
+void first_touch(void *ptr, size_t size) {
+    if (ptr == nullptr || size == 0) return;
+    if (!enabled() || mkldnn_in_parallel()) return;
+
+    const size_t page = page_size();
+    const size_t npages = utils::div_up(size, page);
+    volatile char *p = (volatile char *)ptr;
+    parallel(0, [&](const int ithr, const int nthr) {
+        size_t start{0}, end{0};
+        balance211(npages, nthr, ithr, start, end);
+        for (size_t i = start; i < end; ++i)
+            p[i * page] = 0;
+    });
+}
+
+status_t pin_threads(int node) {
+#ifdef __linux__
+    if (node < 0 || node >= num_nodes()) return invalid_arguments;
+    const auto &cpus = topology().node_cpus[node];
+    if (cpus.empty()) return invalid_arguments;
+
+    /* repin only on a change */
+    std::lock_guard<std::recursive_mutex> lock(pin_mutex);
+    if (pinned_node == node) return success;
+
+    if (pinned_node == -1) unpinned_affinity.save();
+    status_t status = pin_threads(cpus);
+    if (status == success) pinned_node = node;
+    return status;
+#else
+    UNUSED(node);
+    return unimplemented;
+#endif
+}
+
+status_t unpin_threads() {
+#ifdef __linux__
+    if (pinned_node == -1) return success;
+    std::lock_guard<std::recursive_mutex> lock(pin_mutex);
+    if (pinned_node == -1) return success;
+
+    return unpinned_affinity.restore();
+#else
+    return success;
+#endif
+}
+
+status_t pin_threads(const std::vector<int> &cpus) {
+#ifdef __linux__
+    if (cpus.empty()) return invalid_arguments;
+    for (int cpu: cpus)
+        if (cpu < 0 || cpu >= CPU_SETSIZE) return invalid_arguments;
+
+    std::lock_guard<std::recursive_mutex> lock(pin_mutex);
+    /* pin_threads(int) records the node after this */
+    pinned_node = -1;
+    std::atomic<bool> ok(true);
+    parallel(0, [&](const int ithr, const int) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpus[ithr % cpus.size()], &set);
+        if (sched_setaffinity(0, sizeof(set), &set) != 0) ok = false;
+    });
+    return ok ? success : runtime_error;
+#else
+    UNUSED(cpus);
+    return unimplemented;
+#endif
+}
+
+void thread_affinity_t::save() {
+#ifdef __linux__
+    CPU_ZERO(&set_);
+    saved_ = sched_getaffinity(0, sizeof(set_), &set_) == 0;
+#endif
+}
+
+bool thread_affinity_t::restore() {
+    const bool saved = saved_;
+#ifdef __linux__
+    if (saved_) sched_setaffinity(0, sizeof(set_), &set_);
+#endif
+    saved_ = false;
+    return saved;
+}
+
+void team_affinity_t::save() {
+    std::lock_guard<std::recursive_mutex> lock(pin_mutex);
+    node_ = pinned_node;
+    caller_.save();
+    threads_.assign(mkldnn_get_max_threads(), thread_affinity_t());
+    parallel(0, [&](const int ithr, const int) {
+        if (ithr < (int)threads_.size()) threads_[ithr].save();
+    });
+}
+
+status_t team_affinity_t::restore() {
+    std::lock_guard<std::recursive_mutex> lock(pin_mutex);
+    std::atomic<bool> ok(true);
+#ifdef __linux__
+    parallel(0, [&](const int ithr, const int) {
+        if (ithr < (int)threads_.size() && threads_[ithr].restore()) return;
+        if (!topology().has_allowed || sched_setaffinity(0,
+                    sizeof(cpu_set_t), &topology().allowed) != 0)
+            ok = false;
+    });
+#endif
+    caller_.restore();
+    threads_.clear();
+    pinned_node = node_;
+    return ok ? success : runtime_error;
+}
+
+}
+}
+}
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -0,0 +1,115 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+
+#ifndef NUMA_HPP
+#define NUMA_HPP
+
+#include <stddef.h>
+#include <vector>
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+#include "c_types_map.hpp"
+
+namespace mkldnn {
+namespace impl {
+namespace numa {
+
+/* NUMA placement of the library buffers
+ *
+ * On A64FX each CMG is a NUMA node, and so is each socket of a multi-socket
+ * host. A page is placed on the node of the thread that touches it first, so
+ * a buffer allocated and zeroed by the master thread ends up on its node and
+ * the threads of the other nodes compete for that node's bandwidth.
+ *
+ * first_touch() touches a fresh buffer from the threads of a parallel region
+ * with the partition the kernels use for per-thread data: thread ithr of
+ * nthr gets the ithr-th of nthr contiguous chunks. Per-thread buffers
+ * (e.g. the rtus space or wei_bia_reduction) booked as nthr slices thus land
+ * on the node of the thread that owns each slice.
+ *
+ * Placement is enabled when the machine has more than one node. Set
+ * MKLDNN_NUMA=0 to disable it. */
+
+/** Returns the number of NUMA nodes; 1 if unknown. */
+int num_nodes();
+
+/** Returns the number of CPUs of the @p node the process may run on; 0 if
+ * unknown. */
+int num_cpus(int node);
+
+/** Returns true if the buffers are placed NUMA-aware. */
+bool enabled();
+
+/** Touches the pages of [@p ptr, @p ptr + @p size) in parallel as described
+ * above. A no-op if placement is disabled or if called from a parallel
+ * region. The content of the buffer is undefined afterwards. */
+void first_touch(void *ptr, size_t size);
+
+/** Pins the threads of the library to the CPUs of the @p node, one CPU per
+ * thread, wrapping around if there are more threads than CPUs; the caller
+ * caps the team at num_cpus(@p node). The affinity persists until
+ * unpin_threads(). */
+status_t pin_threads(int node);
+
+/** Undoes pin_threads(int): gives the threads of the library back the
+ * affinity they had before. A no-op if they are not pinned to a node. */
+status_t unpin_threads();
+
+/** Pins the thread ithr of the library threads to @p cpus[ithr], wrapping
+ * around if there are more threads than CPUs. The caller saves the
+ * affinity of the team beforehand, see team_affinity_t. */
+status_t pin_threads(const std::vector<int> &cpus);
+
+/** The affinity of the calling thread, saved before pinning it and
+ * restored afterwards. */
+struct thread_affinity_t {
+    thread_affinity_t(): saved_(false) {}
+    void save();
+    /** Returns false if nothing was saved. */
+    bool restore();
+
+private:
+    bool saved_;
+#ifdef __linux__
+    cpu_set_t set_;
+#endif
+};
+
+/** The affinity of each thread of the current team and of the calling
+ * thread, and the node the team is pinned to. restore() applies the
+ * affinity of the process at load time to the threads that were not in
+ * the team when save() ran. */
+struct team_affinity_t {
+    team_affinity_t(): node_(-1) {}
+    void save();
+    status_t restore();
+
+private:
+    int node_;
+    thread_affinity_t caller_;
+    std::vector<thread_affinity_t> threads_;
+};
+
+}
+}
+}
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -0,0 +1,355 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "mkldnn.h"
+
+#include "c_types_map.hpp"
+#include "engine.hpp"
+#include "memory_pd.hpp"
+#include "packed_weights.hpp"
+#include "primitive.hpp"
+#include "primitive_desc.hpp"
+#include "type_helpers.hpp"
+#include "utils.hpp"
+
+using namespace mkldnn::impl;
+using namespace mkldnn::impl::status;
+using namespace mkldnn::impl::types;
+using namespace mkldnn::impl::utils;
+
+namespace mkldnn {
+namespace impl {
+
+namespace {
+
+/* File layout: the header, then the packed data at data_offset. The data is
+ * page aligned so that it can be used in place once the file is mapped. */
+const char file_magic[8] = { 'M', 'K', 'L', 'D', 'N', 'N', 'P', 'W' };
+const uint32_t file_format_version = 1;
+const size_t file_data_alignment = 4096;
+
+struct file_header_t {
+    char magic[8];
+    uint32_t format_version;
+    uint32_t md_size;
+    int32_t lib_version[3];
+    uint32_t reserved;
+    uint64_t data_offset;
+    uint64_t data_size;
+    memory_desc_t md;
+};
+
+void init_header(file_header_t &h, const memory_desc_t &md, size_t size) {
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, file_magic, sizeof(file_magic));
+    h.format_version = file_format_version;
+    h.md_size = sizeof(memory_desc_t);
+    h.lib_version[0] = mkldnn_version()->major;
+    h.lib_version[1] = mkldnn_version()->minor;
+    h.lib_version[2] = mkldnn_version()->patch;
+    h.data_offset = rnd_up(sizeof(file_header_t), file_data_alignment);
+    h.data_size = size;
+    h.md = md;
+}
+
+bool header_ok(const file_header_t &h, size_t file_size) {
+    return true
+        && memcmp(h.magic, file_magic, sizeof(file_magic)) == 0
+        && h.format_version == file_format_version
+        && h.md_size == sizeof(memory_desc_t)
+        && h.lib_version[0] == mkldnn_version()->major
+        && h.lib_version[1] == mkldnn_version()->minor
+        && h.lib_version[2] == mkldnn_version()->patch
+        && h.data_offset % file_data_alignment == 0
+        && h.data_offset <= file_size
+        && h.data_size <= file_size - h.data_offset;
+}
+
+/* Reorders the memory primitive @p src into @p dst_pd at @p data. */
+status_t reorder_to(const primitive_t *src, const memory_pd_t *dst_pd,
+        void *data) {
+    primitive_desc_t *rpd = nullptr;
+    primitive_t *dst = nullptr, *reorder = nullptr;
+    stream_t *stream = nullptr;
+
+    status_t status = mkldnn_reorder_primitive_desc_create(&rpd, src->pd(),
+            dst_pd);
+    if (status == success)
+        status = mkldnn_primitive_create(&dst, dst_pd, nullptr, nullptr);
+    if (status == success)
+        status = mkldnn_memory_set_data_handle(dst, data);
+    if (status == success) {
+        primitive_at_t input = mkldnn_primitive_at(src, 0);
+        const_mkldnn_primitive_t outputs[] = { dst };
+        status = mkldnn_primitive_create(&reorder, rpd, &input, outputs);
+    }
+    if (status == success)
+        status = mkldnn_stream_create(&stream, stream_kind::eager);
+    if (status == success)
+        status = mkldnn_stream_submit(stream, 1, &reorder, nullptr);
+    if (status == success)
+        status = mkldnn_stream_wait(stream, 1, nullptr);
+
+    if (stream) mkldnn_stream_destroy(stream);
+    if (reorder) mkldnn_primitive_destroy(reorder);
+    if (dst) mkldnn_primitive_destroy(dst);
+    if (rpd) mkldnn_primitive_desc_destroy(rpd);
+    return status;
+}
+
+status_t create_handle(packed_weights_t **packed_weights,
+        const memory_pd_t *mpd,
+        const std::shared_ptr<packed_storage_t> &storage) {
+    auto pd = static_cast<memory_pd_t *>(mpd->clone());
+    if (pd == nullptr) return out_of_memory;
+    return safe_ptr_assign<packed_weights_t>(*packed_weights,
+            new packed_weights_t(pd, storage));
+}
+
+}
+
+status_t packed_storage_t::allocate(std::shared_ptr<packed_storage_t> &storage,
+        size_t size) {
+    std::shared_ptr<packed_storage_t> s(new packed_storage_t());
+    s->data_ = impl::malloc(nstl::max(size, (size_t)1), 64);
+    if (s->data_ == nullptr) return out_of_memory;
+    memset(s->data_, 0, size);
+    s->size_ = size;
+    storage = s;
+    return success;
+}
+
+status_t packed_storage_t::map(std::shared_ptr<packed_storage_t> &storage,
+        const char *path, memory_desc_t &md) {
+    std::shared_ptr<mapped_file_t> file;
+    status_t status = mapped_file_t::map(file, path,
+            mkldnn_weights_file_default);
+    if (status != success) return status;
+
+    file_header_t h;
+    if (file->size() < sizeof(h)) return invalid_arguments;
+    memcpy(&h, file->data(), sizeof(h));
+    if (!header_ok(h, file->size())) return invalid_arguments;
+
+    std::shared_ptr<packed_storage_t> s(new packed_storage_t());
+    s->data_ = const_cast<char *>(file->data()) + h.data_offset;
+    s->size_ = h.data_size;
+    s->file_ = file;
+    md = h.md;
+    storage = s;
+    return success;
+}
+
+packed_storage_t::~packed_storage_t() {
+    if (!file_) impl::free(data_);
+}
+
+std::vector<packed_weights_cache_t::entry_t>::const_iterator
+packed_weights_cache_t::find(const std::string &key,
+        const memory_desc_t &md) const {
+    for (auto it = entries_.cbegin(); it != entries_.cend(); ++it)
+        if (it->key == key && it->md == md) return it;
+    return entries_.cend();
+}
+
+std::shared_ptr<packed_storage_t> packed_weights_cache_t::get(
+        const std::string &key, const memory_desc_t &md) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = find(key, md);
+    if (it == entries_.cend()) {
+        ++misses_;
+        return nullptr;
+    }
+    ++hits_;
+    return it->storage;
+}
+
+std::shared_ptr<packed_storage_t> packed_weights_cache_t::put(
+        const std::string &key, const memory_desc_t &md,
+        const std::shared_ptr<packed_storage_t> &storage) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = find(key, md);
+    if (it != entries_.cend()) return it->storage;
+    entries_.push_back({ key, md, storage });
+    return storage;
+}
+
+void packed_weights_cache_t::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+}
+
+void packed_weights_cache_t::get_stats(size_t *hits, size_t *misses,
+        size_t *bytes) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (hits) *hits = hits_;
+    if (misses) *misses = misses_;
+    if (bytes) {
+        *bytes = 0;
+        for (const auto &e: entries_)
+            *bytes += e.storage->size();
+    }
+}
+
+packed_weights_cache_t &packed_weights_cache() {
+    static packed_weights_cache_t cache;
+    return cache;
+}
+
+}
+}
+
+status_t mkldnn_packed_weights_create(packed_weights_t **packed_weights,
+        const primitive_desc_t *pd, int index, const primitive_t *weights,
+        const char *key) {
+    if (any_null(packed_weights, pd, weights))
+        return invalid_arguments;
+    if (weights->kind() != primitive_kind::memory)
+        return invalid_arguments;
+
+    const memory_pd_t *mpd = pd->weights_pd(index);
+    if (mpd == nullptr) return invalid_arguments;
+
+    std::shared_ptr<packed_storage_t> storage;
+    if (key) storage = packed_weights_cache().get(key, *mpd->desc());
+
+    if (!storage) {
+        status_t status = packed_storage_t::allocate(storage,
+                mpd->get_size());
+        if (status == success)
+            status = reorder_to(weights, mpd, storage->data());
+        if (status != success) return status;
+        if (key) storage = packed_weights_cache().put(key, *mpd->desc(),
+                storage);
+    }
+
+    return create_handle(packed_weights, mpd, storage);
+}
+
+status_t mkldnn_packed_weights_load(packed_weights_t **packed_weights,
+        engine_t *engine, const char *path, const char *key) {
+    if (any_null(packed_weights, engine, path))
+        return invalid_arguments;
+
+    std::shared_ptr<packed_storage_t> storage;
+    memory_desc_t md;
+    status_t status = packed_storage_t::map(storage, path, md);
+    if (status != success) return status;
+
+    primitive_desc_t *mpd = nullptr;
+    status = mkldnn_memory_primitive_desc_create(&mpd, &md, engine);
+    if (status != success) return status;
+
+    auto mem_pd = static_cast<memory_pd_t *>(mpd);
+    if (mem_pd->get_size() != storage->size()) {
+        delete mpd;
+        return invalid_arguments;
+    }
+
+    /* on a hit the new mapping is dropped in favor of the cached data */
+    if (key) {
+        auto cached = packed_weights_cache().get(key, md);
+        storage = cached ? cached
+            : packed_weights_cache().put(key, md, storage);
+    }
+
+    return safe_ptr_assign<packed_weights_t>(*packed_weights,
+            new packed_weights_t(mem_pd, storage));
+}
+
+status_t mkldnn_packed_weights_save(const packed_weights_t *packed_weights,
+        const char *path) {
+    if (any_null(packed_weights, path))
+        return invalid_arguments;
+
+    const auto storage = packed_weights->storage();
+    file_header_t h;
+    init_header(h, *packed_weights->pd()->desc(), storage->size());
+
+    FILE *f = fopen(path, "wb");
+    if (f == nullptr) return invalid_arguments;
+
+    const size_t pad_size = h.data_offset - sizeof(h);
+    std::vector<char> pad(pad_size, 0);
+    bool ok = true
+        && fwrite(&h, sizeof(h), 1, f) == 1
+        && fwrite(pad.data(), 1, pad_size, f) == pad_size
+        && fwrite(storage->data(), 1, storage->size(), f) == storage->size();
+    ok = fclose(f) == 0 && ok;
+    return ok ? success : runtime_error;
+}
+
+status_t mkldnn_packed_weights_get_primitive_desc(
+        const packed_weights_t *packed_weights,
+        const primitive_desc_t **memory_pd) {
+    if (any_null(packed_weights, memory_pd))
+        return invalid_arguments;
+    *memory_pd = packed_weights->pd();
+    return success;
+}
+
+status_t mkldnn_packed_weights_get_data_handle(
+        const packed_weights_t *packed_weights, const void **handle,
+        size_t *size) {
+    if (packed_weights == nullptr) return invalid_arguments;
+    if (handle) *handle = packed_weights->storage()->data();
+    if (size) *size = packed_weights->storage()->size();
+    return success;
+}
+
+status_t mkldnn_packed_weights_create_memory(primitive_t **memory,
+        const packed_weights_t *packed_weights) {
+    if (any_null(memory, packed_weights))
+        return invalid_arguments;
+
+    primitive_t *mem = nullptr;
+    status_t status = mkldnn_primitive_create(&mem, packed_weights->pd(),
+            nullptr, nullptr);
+    if (status != success) return status;
+
+    /* the storage is shared between handles and may be a read-only
+     * mapping; it is padded already, so it is bound without zeroing */
+    status = mem->set_data_handle(
+            const_cast<void *>(packed_weights->storage()->data()), false);
+    if (status != success) {
+        mkldnn_primitive_destroy(mem);
+        return status;
+    }
+    *memory = mem;
+    return success;
+}
+
+status_t mkldnn_packed_weights_destroy(packed_weights_t *packed_weights) {
+    delete packed_weights;
+    return success;
+}
+
+status_t mkldnn_clear_packed_weights_cache() {
+    packed_weights_cache().clear();
+    return success;
+}
+
+status_t mkldnn_get_packed_weights_cache_stats(size_t *hits, size_t *misses,
+        size_t *bytes) {
+    packed_weights_cache().get_stats(hits, misses, bytes);
+    return success;
+}
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
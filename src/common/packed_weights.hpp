@@ -0,0 +1,126 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef PACKED_WEIGHTS_HPP
+#define PACKED_WEIGHTS_HPP
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "mkldnn.h"
+
+#include "c_types_map.hpp"
+#include "mapped_file.hpp"
+#include "memory_pd.hpp"
+#include "utils.hpp"
+
+namespace mkldnn {
+namespace impl {
+
+/** Read-only packed data: either allocated and filled by a reorder, or a
+ * read-only mapping of a file written by mkldnn_packed_weights_save(). */
+struct packed_storage_t {
+    /** Allocates @p size bytes of zero-filled data. */
+    static status_t allocate(std::shared_ptr<packed_storage_t> &storage,
+            size_t size);
+
+    /** Maps the file @p path and returns the memory descriptor stored in
+     * it in @p md. */
+    static status_t map(std::shared_ptr<packed_storage_t> &storage,
+            const char *path, memory_desc_t &md);
+
+    ~packed_storage_t();
+
+    const void *data() const { return data_; }
+    void *data() { return data_; }
+    size_t size() const { return size_; }
+
+private:
+    packed_storage_t(): data_(nullptr), size_(0) {}
+
+    void *data_;
+    size_t size_;
+    std::shared_ptr<mapped_file_t> file_;
+
+    packed_storage_t(const packed_storage_t &) = delete;
+    packed_storage_t &operator=(const packed_storage_t &) = delete;
+};
+
+/** Process-wide cache of packed data keyed by a user key and the packed
+ * memory descriptor. Entries are kept until
+ * mkldnn_clear_packed_weights_cache(). */
+struct packed_weights_cache_t {
+    packed_weights_cache_t(): hits_(0), misses_(0) {}
+
+    /** Returns the data cached for (@p key, @p md), or nullptr. Counts a
+     * hit or a miss. */
+    std::shared_ptr<packed_storage_t> get(const std::string &key,
+            const memory_desc_t &md);
+
+    /** Caches @p storage for (@p key, @p md) and returns it. If another
+     * thread cached data for the same key meanwhile, that data is returned
+     * instead. */
+    std::shared_ptr<packed_storage_t> put(const std::string &key,
+            const memory_desc_t &md,
+            const std::shared_ptr<packed_storage_t> &storage);
+
+    void clear();
+    void get_stats(size_t *hits, size_t *misses, size_t *bytes) const;
+
+private:
+    struct entry_t {
+        std::string key;
+        memory_desc_t md;
+        std::shared_ptr<packed_storage_t> storage;
+    };
+
+    std::vector<entry_t>::const_iterator find(const std::string &key,
+            const memory_desc_t &md) const;
+
+    std::vector<entry_t> entries_;
+    size_t hits_;
+    size_t misses_;
+    mutable std::mutex mutex_;
+};
+
+packed_weights_cache_t &packed_weights_cache();
+
+}
+}
+
+struct mkldnn_packed_weights: public mkldnn::impl::c_compatible {
+    mkldnn_packed_weights(mkldnn::impl::memory_pd_t *pd,
+            const std::shared_ptr<mkldnn::impl::packed_storage_t> &storage)
+        : pd_(pd), storage_(storage) {}
+    ~mkldnn_packed_weights() { delete pd_; }
+
+    const mkldnn::impl::memory_pd_t *pd() const { return pd_; }
+    const mkldnn::impl::packed_storage_t *storage() const
+    { return storage_.get(); }
+
+private:
+    mkldnn::impl::memory_pd_t *pd_;
+    std::shared_ptr<mkldnn::impl::packed_storage_t> storage_;
+
+    mkldnn_packed_weights(const mkldnn_packed_weights &) = delete;
+    mkldnn_packed_weights &operator=(const mkldnn_packed_weights &) = delete;
+};
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
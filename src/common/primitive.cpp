@@ -15,10 +15,13 @@
 *******************************************************************************/
 
 #include <assert.h>
+#include <stdio.h>
 
 #include "c_types_map.hpp"
 #include "primitive_desc.hpp"
 #include "primitive.hpp"
+#include "primitive_cache.hpp"
+#include "profiler.hpp"
 #include "engine.hpp"
 #include "type_helpers.hpp"
 #include "utils.hpp"
@@ -32,6 +35,40 @@ status_t mkldnn_primitive_desc_destroy(primitive_desc_t *primitive_desc) {
     return success;
 }
 
+namespace {
+status_t create_or_reuse(primitive_t **primitive,
+        const primitive_desc_t *primitive_desc, const primitive_at_t *inputs,
+        const primitive_t **outputs) {
+    primitive_cache_t::key_t key;
+    const bool cacheable = primitive_cache().capacity() > 0
+        && primitive_cache_t::make_key(primitive_desc, key);
+    if (cacheable) {
+        double ms = get_msec();
+        primitive_t *p = primitive_cache().get(key);
+        if (p != nullptr) {
+            p->rebind(primitive_t::input_vector(inputs,
+                        inputs + primitive_desc->n_inputs()),
+                    primitive_t::output_vector(outputs,
+                        outputs + primitive_desc->n_outputs()));
+            *primitive = p;
+            ms = get_msec() - ms;
+            if (mkldnn_verbose()->level >= 2) {
+                printf("mkldnn_verbose,create:cache_hit,%s,%g\n",
+                        p->pd()->info(), ms);
+                fflush(0);
+            }
+            return success;
+        }
+    }
+
+    status_t status = primitive_desc->create_primitive(primitive, inputs,
+            outputs);
+    if (status == success && cacheable)
+        (*primitive)->set_cache_key(key);
+    return status;
+}
+}
+
 status_t mkldnn_primitive_create(primitive_t **primitive,
         const primitive_desc_t *primitive_desc, const primitive_at_t *inputs,
         const primitive_t **outputs) {
@@ -50,7 +87,17 @@ status_t mkldnn_primitive_create(primitive_t **primitive,
     }
     for (int i = 0; i < primitive_desc->n_outputs(); ++i)
         if (outputs[i] == nullptr) return invalid_arguments;
-    return primitive_desc->create_primitive(primitive, inputs, outputs);
+
+    const bool profiled = profiler().enabled()
+        && !utils::one_of(primitive_desc->kind(), memory, view);
+    const double start_ms = profiled ? get_msec() : 0.;
+
+    status_t status = create_or_reuse(primitive, primitive_desc, inputs,
+            outputs);
+    if (status == success && profiled)
+        profiler().record(profiling_event::create, primitive_desc, start_ms,
+                get_msec() - start_ms);
+    return status;
 }
 
 status_t mkldnn_primitive_get_primitive_desc(const primitive_t *primitive,
@@ -80,7 +127,11 @@ status_t mkldnn_primitive_get_output(const primitive_t *primitive,
 }
 
 status_t mkldnn_primitive_destroy(primitive_t *primitive) {
-    if (primitive != nullptr)
+    if (primitive == nullptr)
+        return success;
+    /* cacheable primitives are kept for reuse by mkldnn_primitive_create */
+    if (primitive->cache_key().empty()
+            || !primitive_cache().put(primitive->cache_key(), primitive))
         delete primitive;
     return success;
 }
@@ -18,6 +18,7 @@
 #define PRIMITIVE_HPP
 
 #include <assert.h>
+#include <string>
 
 #include "mkldnn.h"
 
@@ -55,6 +56,7 @@ struct mkldnn_primitive: public mkldnn::impl::c_compatible {
         : pd_(pd->clone())
         , inputs_(inputs)
         , outputs_(outputs)
+        , stream_scratchpad_(nullptr)
     {}
     virtual ~mkldnn_primitive() { delete pd_; }
 
@@ -69,6 +71,37 @@ struct mkldnn_primitive: public mkldnn::impl::c_compatible {
     /** returns primitive's kind */
     mkldnn::impl::primitive_kind_t kind() const { return pd_->kind(); }
 
+    /** returns the primitive cache key, empty if the primitive is not
+     * cacheable */
+    const std::string &cache_key() const { return cache_key_; }
+    void set_cache_key(const std::string &key) { cache_key_ = key; }
+
+    /** binds a primitive taken from the primitive cache to new @p inputs
+     * and @p outputs */
+    void rebind(const input_vector &inputs, const output_vector &outputs) {
+        inputs_ = inputs;
+        outputs_ = outputs;
+    }
+
+    /** returns true if the primitive was created with
+     * mkldnn_scratchpad_mode_user, i.e. it uses the scratchpad of the
+     * stream it is executed in */
+    bool use_stream_scratchpad() const {
+        return pd_->attr()->scratchpad_mode_
+            == mkldnn::impl::scratchpad_mode::user;
+    }
+    /** returns the size of the scratchpad the primitive needs */
+    size_t scratchpad_size() const
+    { return pd_->scratchpad_registry().size(); }
+    /** sets the scratchpad of the stream for the next execution, the
+     * stream guarantees it is at least scratchpad_size() bytes */
+    void set_stream_scratchpad(char *scratchpad)
+    { stream_scratchpad_ = scratchpad; }
+
+    /** returns true if the primitive may be executed concurrently with
+     * other primitives, on any thread */
+    virtual bool concurrent_safe() const { return true; }
+
     /** executes primitive with resulting event @p e
      *
      * @p e (output)
@@ -87,9 +120,13 @@ struct mkldnn_primitive: public mkldnn::impl::c_compatible {
         assert(this->kind() == mkldnn::impl::primitive_kind::memory);
         return mkldnn::impl::status::invalid_arguments;
     }
-    /** sets data handle. Applicable for memory primitives only. */
-    virtual mkldnn::impl::status_t set_data_handle(void *handle) {
-        UNUSED(handle);
+    /** sets data handle. Applicable for memory primitives only.
+     *
+     * @p pads_zeroing is false when the data is known to be padded already,
+     * e.g. read-only or shared weights, which must not be written to */
+    virtual mkldnn::impl::status_t set_data_handle(void *handle,
+            bool pads_zeroing) {
+        UNUSED(handle); UNUSED(pads_zeroing);
         assert(this->kind() == mkldnn::impl::primitive_kind::memory);
         return mkldnn::impl::status::invalid_arguments;
     }
@@ -98,6 +135,8 @@ protected:
     const mkldnn::impl::primitive_desc_t *pd_;
     input_vector inputs_;
     output_vector outputs_;
+    std::string cache_key_;
+    char *stream_scratchpad_;
 
 private:
     mkldnn_primitive() = delete;
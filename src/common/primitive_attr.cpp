@@ -99,6 +99,18 @@ status_t primitive_attr_t::set_round_mode(round_mode_t round_mode) {
     return success;
 }
 
+status_t primitive_attr_t::set_scratchpad_mode(
+        scratchpad_mode_t scratchpad_mode) {
+    using namespace mkldnn::impl::scratchpad_mode;
+
+    const bool ok = one_of(scratchpad_mode, library, user);
+    if (!ok)
+        return invalid_arguments;
+
+    scratchpad_mode_ = scratchpad_mode;
+    return success;
+}
+
 status_t primitive_attr_t::set_post_ops(const post_ops_t &post_ops) {
     this->post_ops_ = post_ops;
     return success;
@@ -148,6 +160,24 @@ status_t mkldnn_primitive_attr_set_int_output_round_mode(
     return attr->set_round_mode(round_mode);
 }
 
+status_t mkldnn_primitive_attr_get_scratchpad_mode(
+        const primitive_attr_t *attr, scratchpad_mode_t *scratchpad_mode) {
+    if (any_null(attr, scratchpad_mode))
+        return invalid_arguments;
+
+    *scratchpad_mode = attr->scratchpad_mode_;
+
+    return success;
+}
+
+status_t mkldnn_primitive_attr_set_scratchpad_mode(
+        primitive_attr_t *attr, scratchpad_mode_t scratchpad_mode) {
+    if (any_null(attr))
+        return invalid_arguments;
+
+    return attr->set_scratchpad_mode(scratchpad_mode);
+}
+
 status_t mkldnn_primitive_attr_get_output_scales(const primitive_attr_t *attr,
         int *count, int *mask, const float **scales) {
     if (any_null(attr, count, mask, scales))
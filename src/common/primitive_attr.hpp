@@ -151,11 +151,25 @@ struct mkldnn_post_ops: public mkldnn::impl::c_compatible {
 
 struct mkldnn_primitive_attr: public mkldnn::impl::c_compatible {
     mkldnn_primitive_attr()
-        : round_mode_(mkldnn::impl::round_mode::nearest) {}
+        : round_mode_(mkldnn::impl::round_mode::nearest)
+        , scratchpad_mode_(mkldnn::impl::scratchpad_mode::library) {}
 
     mkldnn_primitive_attr *clone() const
     { return new mkldnn_primitive_attr(*this); }
 
+    /** returns the attributes for the primitive descriptors an
+     * implementation nests. The nested primitives are executed by the
+     * implementation rather than by a stream, so they always own their
+     * scratchpad. */
+    mkldnn_primitive_attr nested() const {
+        mkldnn_primitive_attr attr(*this);
+        attr.scratchpad_mode_ = mkldnn::impl::scratchpad_mode::library;
+        return attr;
+    }
+
+    /** scratchpad_mode_ does not affect the computations, so it is not
+     * checked here: every implementation supports both modes, the ones
+     * nesting primitive descriptors create them with nested() */
     bool has_default_values() const {
        return true
             && round_mode_ == mkldnn::impl::round_mode::nearest
@@ -169,8 +183,11 @@ struct mkldnn_primitive_attr: public mkldnn::impl::c_compatible {
             mkldnn::impl::round_mode_t round_mode);
     mkldnn::impl::status_t set_post_ops(
             const mkldnn::impl::post_ops_t &post_ops);
+    mkldnn::impl::status_t set_scratchpad_mode(
+            mkldnn::impl::scratchpad_mode_t scratchpad_mode);
 
     mkldnn::impl::round_mode_t round_mode_;
+    mkldnn::impl::scratchpad_mode_t scratchpad_mode_;
     mkldnn::impl::scales_t output_scales_;
     mkldnn::impl::post_ops_t post_ops_;
     mkldnn::impl::rnn_data_qparams_t rnn_data_qparams_;
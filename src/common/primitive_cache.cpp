@@ -0,0 +1,377 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <iterator>
+
+#include "mkldnn.h"
+
+#include "c_types_map.hpp"
+#include "memory_pd.hpp"
+#include "mkldnn_thread.hpp"
+#include "primitive.hpp"
+#include "primitive_cache.hpp"
+#include "primitive_desc.hpp"
+#include "utils.hpp"
+
+using namespace mkldnn::impl;
+using namespace mkldnn::impl::status;
+
+namespace mkldnn {
+namespace impl {
+
+namespace {
+
+/* Serializes descriptors field by field: memory descriptors are not fully
+ * initialized (dims past ndims, unused parts of layout_desc), so their raw
+ * bytes cannot be compared. */
+struct key_builder_t {
+    key_builder_t(std::string &s): s_(s) {}
+
+    template <typename T> void put(const T &v)
+    { s_.append(reinterpret_cast<const char *>(&v), sizeof(T)); }
+
+    template <typename T> void put(const T *a, int n)
+    { s_.append(reinterpret_cast<const char *>(a), sizeof(T) * n); }
+
+    void put_str(const char *str) {
+        s_.append(str ? str : "");
+        s_.push_back('\0');
+    }
+
+    void put_md(const memory_desc_t &md) {
+        using namespace memory_format;
+        put(md.ndims);
+        if (md.ndims <= 0) return;
+        put(md.dims, md.ndims);
+        put(md.data_type);
+        put(md.format);
+
+        switch (md.format) {
+        case undef:
+        case any: break;
+        case wino_fmt: {
+            const wino_data_t &w = md.layout_desc.wino_desc;
+            put(w.wino_format); put(w.r); put(w.alpha); put(w.ic); put(w.oc);
+            put(w.ic_block); put(w.oc_block); put(w.ic2_block);
+            put(w.oc2_block); put(w.adj_scale); put(w.size);
+            break;
+        }
+        case rnn_packed: {
+            const rnn_packed_data_t &r = md.layout_desc.rnn_packed_desc;
+            const int n_parts = nstl::min(nstl::max(r.n_parts, 0),
+                    (int)MKLDNN_RNN_MAX_N_PARTS);
+            put(r.format); put(r.n_parts); put(r.n);
+            put(r.parts, n_parts); put(r.part_pack_size, n_parts);
+            put(r.offset_compensation); put(r.size);
+            break;
+        }
+        default: {
+            const blocking_desc_t &b = md.layout_desc.blocking;
+            put(b.block_dims, md.ndims);
+            put(b.strides[0], md.ndims);
+            put(b.strides[1], md.ndims);
+            put(b.padding_dims, md.ndims);
+            put(b.offset_padding_to_data, md.ndims);
+            put(b.offset_padding);
+            break;
+        }
+        }
+    }
+
+    void put_scales(const scales_t &s) {
+        put(s.count_);
+        put(s.mask_);
+        put(s.scales_, s.count_);
+    }
+
+    void put_attr(const primitive_attr_t &attr) {
+        put(attr.round_mode_);
+        put(attr.scratchpad_mode_);
+        put_scales(attr.output_scales_);
+
+        const post_ops_t &p = attr.post_ops_;
+        put(p.len_);
+        for (int i = 0; i < p.len_; ++i) {
+            const post_ops_t::entry_t &e = p.entry_[i];
+            put(e.kind);
+            if (e.kind == primitive_kind::sum) {
+                put(e.sum.scale);
+            } else if (e.kind == primitive_kind::eltwise) {
+                put(e.eltwise.alg); put(e.eltwise.scale);
+                put(e.eltwise.alpha); put(e.eltwise.beta);
+            }
+        }
+
+        put(attr.rnn_data_qparams_.scale_);
+        put(attr.rnn_data_qparams_.shift_);
+        put_scales(attr.rnn_weights_qparams_);
+    }
+
+    /* Op descriptors are value-initialized by the *_desc_init() functions,
+     * so arrays of dimensions can be serialized as a whole. */
+    bool put_op_desc(primitive_kind_t kind, const op_desc_t *op_desc) {
+        using namespace primitive_kind;
+        put(kind);
+        if (op_desc == nullptr) return true;
+
+        switch (kind) {
+        case convolution: {
+            const convolution_desc_t &d = op_desc->convolution;
+            put(d.prop_kind); put(d.alg_kind);
+            put_md(d.src_desc); put_md(d.diff_src_desc);
+            put_md(d.weights_desc); put_md(d.diff_weights_desc);
+            put_md(d.bias_desc); put_md(d.diff_bias_desc);
+            put_md(d.dst_desc); put_md(d.diff_dst_desc);
+            put(d.strides); put(d.dilates);
+            put(d.padding[0]); put(d.padding[1]);
+            put(d.padding_kind); put(d.accum_data_type);
+            return true;
+        }
+        case shuffle: {
+            const shuffle_desc_t &d = op_desc->shuffle;
+            put(d.prop_kind); put_md(d.data_desc);
+            put(d.axis); put(d.group_size);
+            return true;
+        }
+        case eltwise: {
+            const eltwise_desc_t &d = op_desc->eltwise;
+            put(d.prop_kind); put(d.alg_kind);
+            put_md(d.data_desc); put_md(d.diff_data_desc);
+            put(d.alpha); put(d.beta);
+            return true;
+        }
+        case softmax: {
+            const softmax_desc_t &d = op_desc->softmax;
+            put(d.prop_kind);
+            put_md(d.data_desc); put_md(d.diff_desc);
+            put(d.softmax_axis);
+            return true;
+        }
+        case pooling: {
+            const pooling_desc_t &d = op_desc->pooling;
+            put(d.prop_kind); put(d.alg_kind);
+            put_md(d.src_desc); put_md(d.diff_src_desc);
+            put_md(d.dst_desc); put_md(d.diff_dst_desc);
+            put(d.strides); put(d.kernel);
+            put(d.padding[0]); put(d.padding[1]);
+            put(d.padding_kind); put(d.accum_data_type);
+            return true;
+        }
+        case lrn: {
+            const lrn_desc_t &d = op_desc->lrn;
+            put(d.prop_kind); put(d.alg_kind);
+            put_md(d.data_desc); put_md(d.diff_data_desc);
+            put(d.local_size); put(d.lrn_alpha); put(d.lrn_beta);
+            put(d.lrn_k);
+            return true;
+        }
+        case batch_normalization: {
+            const batch_normalization_desc_t &d
+                = op_desc->batch_normalization;
+            put(d.prop_kind);
+            put_md(d.data_desc); put_md(d.diff_data_desc);
+            put_md(d.data_scaleshift_desc);
+            put_md(d.diff_data_scaleshift_desc);
+            put_md(d.mean_desc); put_md(d.variance_desc);
+            put(d.batch_norm_epsilon); put(d.flags);
+            return true;
+        }
+        case inner_product: {
+            const inner_product_desc_t &d = op_desc->inner_product;
+            put(d.prop_kind);
+            put_md(d.src_desc); put_md(d.diff_src_desc);
+            put_md(d.weights_desc); put_md(d.diff_weights_desc);
+            put_md(d.bias_desc); put_md(d.diff_bias_desc);
+            put_md(d.dst_desc); put_md(d.diff_dst_desc);
+            put(d.accum_data_type);
+            return true;
+        }
+        case rnn: {
+            const rnn_desc_t &d = op_desc->rnn;
+            put(d.prop_kind);
+            put(d.cell_desc.cell_kind); put(d.cell_desc.activation_kind);
+            put(d.cell_desc.flags); put(d.cell_desc.alpha);
+            put(d.cell_desc.clipping);
+            put(d.direction);
+            put_md(d.src_layer_desc); put_md(d.src_iter_desc);
+            put_md(d.weights_layer_desc); put_md(d.weights_iter_desc);
+            put_md(d.bias_desc);
+            put_md(d.dst_layer_desc); put_md(d.dst_iter_desc);
+            put_md(d.diff_src_layer_desc); put_md(d.diff_src_iter_desc);
+            put_md(d.diff_weights_layer_desc);
+            put_md(d.diff_weights_iter_desc);
+            put_md(d.diff_bias_desc);
+            put_md(d.diff_dst_layer_desc); put_md(d.diff_dst_iter_desc);
+            return true;
+        }
+        default: return false;
+        }
+    }
+
+private:
+    std::string &s_;
+};
+
+int capacity_from_env() {
+    const int len = 12;
+    char val[len] = {0};
+    if (mkldnn_getenv("MKLDNN_PRIMITIVE_CACHE_CAPACITY", val, len) > 0)
+        return nstl::max(atoi(val), 0);
+    return 0;
+}
+
+}
+
+primitive_cache_t::primitive_cache_t()
+    : capacity_(capacity_from_env()), hits_(0), misses_(0) {}
+
+primitive_cache_t::~primitive_cache_t() {
+    for (auto &e : lru_)
+        delete e.primitive;
+}
+
+bool primitive_cache_t::make_key(const primitive_desc_t *pd, key_t &key) {
+    using namespace primitive_kind;
+    if (utils::one_of(pd->kind(), memory, view, concat, concat_inplace, sum,
+                deconvolution))
+        return false;
+
+    key.clear();
+    key_builder_t kb(key);
+
+    kb.put(pd->engine());
+    kb.put(mkldnn_get_max_threads());
+    kb.put_str(pd->name());
+    if (!kb.put_op_desc(pd->kind(), pd->op_desc()))
+        return false;
+    kb.put_attr(*pd->attr());
+
+    kb.put(pd->n_inputs());
+    for (int i = 0; i < pd->n_inputs(); ++i) {
+        const memory_pd_t *mpd = pd->input_pd(i);
+        if (mpd == nullptr) return false;
+        kb.put_md(*mpd->desc());
+    }
+    kb.put(pd->n_outputs());
+    for (int i = 0; i < pd->n_outputs(); ++i) {
+        const memory_pd_t *mpd = pd->output_pd(i);
+        if (mpd == nullptr) return false;
+        kb.put_md(*mpd->desc());
+    }
+
+    return true;
+}
+
+status_t primitive_cache_t::set_capacity(int capacity) {
+    if (capacity < 0) return invalid_arguments;
+    std::lock_guard<std::mutex> lock(mutex_);
+    capacity_ = capacity;
+    shrink(capacity_);
+    return success;
+}
+
+primitive_t *primitive_cache_t::get(const key_t &key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (capacity_ == 0) return nullptr;
+
+    auto it = map_.find(key);
+    if (it == map_.end()) {
+        misses_++;
+        return nullptr;
+    }
+
+    primitive_t *p = it->second->primitive;
+    lru_.erase(it->second);
+    map_.erase(it);
+    hits_++;
+    return p;
+}
+
+bool primitive_cache_t::put(const key_t &key, primitive_t *p) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (capacity_ == 0) return false;
+
+    shrink(capacity_ - 1);
+    lru_.push_front({key, p});
+    map_.insert({key, lru_.begin()});
+    return true;
+}
+
+void primitive_cache_t::evict(const engine_t *engine) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto it = lru_.begin(); it != lru_.end();) {
+        auto cur = it++;
+        if (cur->primitive->engine() == engine) erase(cur);
+    }
+}
+
+void primitive_cache_t::get_stats(size_t *hits, size_t *misses,
+        int *size) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (hits) *hits = hits_;
+    if (misses) *misses = misses_;
+    if (size) *size = (int)lru_.size();
+}
+
+void primitive_cache_t::shrink(int capacity) {
+    while ((int)lru_.size() > nstl::max(capacity, 0))
+        erase(std::prev(lru_.end()));
+}
+
+void primitive_cache_t::erase(lru_list_t::iterator it) {
+    auto range = map_.equal_range(it->key);
+    for (auto m = range.first; m != range.second; ++m) {
+        if (m->second == it) {
+            map_.erase(m);
+            break;
+        }
+    }
+    delete it->primitive;
+    lru_.erase(it);
+}
+
+primitive_cache_t &primitive_cache() {
+    /* Never destroyed: cached primitives may outlive other static objects
+     * they depend on (e.g. the global scratchpad). */
+    static primitive_cache_t *cache = new primitive_cache_t();
+    return *cache;
+}
+
+}
+}
+
+status_t mkldnn_set_primitive_cache_capacity(int capacity) {
+    return primitive_cache().set_capacity(capacity);
+}
+
+status_t mkldnn_get_primitive_cache_capacity(int *capacity) {
+    if (capacity == nullptr) return invalid_arguments;
+    *capacity = primitive_cache().capacity();
+    return success;
+}
+
+status_t mkldnn_get_primitive_cache_stats(size_t *hits, size_t *misses,
+        int *size) {
+    if (utils::everyone_is(nullptr, hits, misses, size))
+        return invalid_arguments;
+    primitive_cache().get_stats(hits, misses, size);
+    return success;
+}
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
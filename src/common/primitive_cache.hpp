@@ -0,0 +1,108 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef PRIMITIVE_CACHE_HPP
+#define PRIMITIVE_CACHE_HPP
+
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "c_types_map.hpp"
+
+namespace mkldnn {
+namespace impl {
+
+/** Process-wide LRU cache of primitives that are no longer used.
+ *
+ * In this API primitives are bound to their inputs and outputs at creation,
+ * so a primitive cannot be shared. Instead, mkldnn_primitive_destroy() hands
+ * a cacheable primitive over to the cache, and the next
+ * mkldnn_primitive_create() for an equivalent primitive descriptor takes it
+ * back and rebinds it to the new inputs and outputs. This skips the
+ * primitive constructor, which is where JIT kernels are generated.
+ *
+ * Two primitive descriptors are equivalent if they have the same engine,
+ * implementation, op descriptor, attributes and resolved input/output memory
+ * descriptors, and were created for the same mkldnn_get_max_threads().
+ *
+ * The capacity (number of idle primitives kept) is taken from the
+ * MKLDNN_PRIMITIVE_CACHE_CAPACITY environment variable and can be changed
+ * with mkldnn_set_primitive_cache_capacity(). The default capacity is 0,
+ * i.e. the cache is disabled. */
+struct primitive_cache_t {
+    typedef std::string key_t;
+
+    primitive_cache_t();
+    ~primitive_cache_t();
+
+    int capacity() const { return capacity_; }
+    status_t set_capacity(int capacity);
+
+    /** Builds the cache key of @p pd. Returns false if primitives of @p pd
+     * cannot be cached: memory and view primitives, and primitives that
+     * create nested primitives bound to their inputs (concat, sum,
+     * deconvolution). */
+    static bool make_key(const primitive_desc_t *pd, key_t &key);
+
+    /** Returns an idle primitive for @p key or nullptr. The primitive is
+     * removed from the cache, the caller owns it. */
+    primitive_t *get(const key_t &key);
+
+    /** Passes ownership of @p p to the cache. The least recently used
+     * primitives are destroyed when the capacity is exceeded. Returns false
+     * if the cache is disabled, in which case the caller keeps ownership. */
+    bool put(const key_t &key, primitive_t *p);
+
+    /** Destroys all cached primitives created on @p engine. */
+    void evict(const engine_t *engine);
+
+    void get_stats(size_t *hits, size_t *misses, int *size) const;
+
+private:
+    struct entry_t {
+        key_t key;
+        primitive_t *primitive;
+    };
+    typedef std::list<entry_t> lru_list_t;
+
+    void shrink(int capacity);
+    void erase(lru_list_t::iterator it);
+
+    /* read without the lock on primitive creation */
+    std::atomic<int> capacity_;
+    size_t hits_;
+    size_t misses_;
+
+    /* most recently used first */
+    lru_list_t lru_;
+    std::unordered_multimap<key_t, lru_list_t::iterator> map_;
+    mutable std::mutex mutex_;
+
+    primitive_cache_t(const primitive_cache_t &) = delete;
+    primitive_cache_t &operator=(const primitive_cache_t &) = delete;
+};
+
+primitive_cache_t &primitive_cache();
+
+}
+}
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -0,0 +1,261 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "mkldnn.h"
+#include "mkldnn_debug.h"
+
+#include "c_types_map.hpp"
+#include "mkldnn_thread.hpp"
+#include "primitive_desc.hpp"
+#include "profiler.hpp"
+#include "utils.hpp"
+
+using namespace mkldnn::impl;
+using namespace mkldnn::impl::status;
+
+namespace mkldnn {
+namespace impl {
+
+namespace {
+
+const int trace_path_len = 4096;
+char trace_path[trace_path_len] = {'\0'};
+
+int get_thread_id() {
+    static std::atomic<int> n_threads(0);
+    static thread_local int id = -1;
+    if (id < 0) id = n_threads++;
+    return id;
+}
+
+int get_pid() {
+#ifdef _WIN32
+    return _getpid();
+#else
+    return (int)getpid();
+#endif
+}
+
+/* copies at most @p len - 1 chars of @p src, a longer info is cut */
+void copy_str(char *dst, const char *src, size_t len) {
+    const size_t n = src ? strnlen(src, len - 1) : 0;
+    if (n) memcpy(dst, src, n);
+    dst[n] = '\0';
+}
+
+void fprint_json_str(FILE *f, const char *str) {
+    fputc('"', f);
+    for (const char *c = str; *c; ++c) {
+        if (*c == '"' || *c == '\\') fprintf(f, "\\%c", *c);
+        else if ((unsigned char)*c < 0x20) fprintf(f, "\\u%04x", *c);
+        else fputc(*c, f);
+    }
+    fputc('"', f);
+}
+
+void dump_trace_at_exit() {
+    profiler().dump_trace(trace_path);
+}
+
+}
+
+profiler_t::ring_t::ring_t(int capacity)
+    : capacity(capacity), head(0), first(0) {
+    slots = new slot_t[capacity];
+    for (int i = 0; i < capacity; ++i)
+        slots[i].seq.store(0, std::memory_order_relaxed);
+}
+
+profiler_t::ring_t::~ring_t() { delete[] slots; }
+
+profiler_t::profiler_t(): ring_(nullptr) {
+    const int len = 12;
+    char val[len] = {0};
+    if (mkldnn_getenv("MKLDNN_PROFILING", val, len) > 0)
+        set_capacity(atoi(val));
+    if (mkldnn_getenv("MKLDNN_PROFILING_TRACE", trace_path,
+                trace_path_len) > 0)
+        atexit(dump_trace_at_exit);
+}
+
+profiler_t::~profiler_t() {
+    delete ring_.load();
+    for (auto r: retired_) delete r;
+}
+
+int profiler_t::capacity() const {
+    const ring_t *r = ring_.load(std::memory_order_acquire);
+    return r ? r->capacity : 0;
+}
+
+status_t profiler_t::set_capacity(int capacity) {
+    if (capacity < 0) return invalid_arguments;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    ring_t *r = nullptr;
+    if (capacity > 0) {
+        r = new ring_t(capacity);
+        if (r == nullptr || r->slots == nullptr) {
+            delete r;
+            return out_of_memory;
+        }
+    }
+    ring_t *old = ring_.exchange(r, std::memory_order_acq_rel);
+    if (old) retired_.push_back(old);
+    return success;
+}
+
+void profiler_t::record(profiling_event_t event, const primitive_desc_t *pd,
+        double start_ms, double duration_ms) {
+    ring_t *r = ring_.load(std::memory_order_acquire);
+    if (r == nullptr) return;
+
+    const uint64_t idx = r->head.fetch_add(1, std::memory_order_relaxed);
+    slot_t &s = r->slots[idx % r->capacity];
+    s.seq.store(2 * idx + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    profiling_record_t &rec = s.rec;
+    rec.event = event;
+    rec.primitive_kind = pd->kind();
+    copy_str(rec.impl_name, pd->name(), MKLDNN_PROFILING_NAME_LEN);
+    copy_str(rec.info, pd->info(), MKLDNN_PROFILING_INFO_LEN);
+    rec.start_us = 1e3 * start_ms;
+    rec.duration_us = 1e3 * duration_ms;
+    rec.thread_id = get_thread_id();
+    rec.nthr = mkldnn_get_max_threads();
+    rec.scratchpad_size = pd->scratchpad_registry().size();
+
+    s.seq.store(2 * idx + 2, std::memory_order_release);
+}
+
+void profiler_t::get_records(std::vector<profiling_record_t> &records) const {
+    records.clear();
+    const ring_t *r = ring_.load(std::memory_order_acquire);
+    if (r == nullptr) return;
+
+    const uint64_t head = r->head.load(std::memory_order_acquire);
+    const uint64_t cap = (uint64_t)r->capacity;
+    records.reserve((size_t)nstl::min(head, cap));
+    const uint64_t first = nstl::max(r->first.load(std::memory_order_acquire),
+            head > cap ? head - cap : 0);
+    for (uint64_t idx = first; idx < head; ++idx) {
+        const slot_t &s = r->slots[idx % cap];
+        const uint64_t seq = s.seq.load(std::memory_order_acquire);
+        if (seq != 2 * idx + 2) continue; /* being written or overwritten */
+        profiling_record_t rec = s.rec;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (s.seq.load(std::memory_order_relaxed) != seq) continue;
+        records.push_back(rec);
+    }
+}
+
+void profiler_t::reset() {
+    ring_t *r = ring_.load(std::memory_order_acquire);
+    if (r) r->first.store(r->head.load(std::memory_order_relaxed),
+            std::memory_order_release);
+}
+
+status_t profiler_t::dump_trace(const char *path) const {
+    if (path == nullptr || *path == '\0') return invalid_arguments;
+
+    std::vector<profiling_record_t> records;
+    get_records(records);
+
+    FILE *f = fopen(path, "w");
+    if (f == nullptr) return invalid_arguments;
+
+    const int pid = get_pid();
+    fprintf(f, "{\"traceEvents\":[");
+    for (size_t i = 0; i < records.size(); ++i) {
+        const auto &rec = records[i];
+        fprintf(f, "%s\n{\"name\":", i ? "," : "");
+        fprint_json_str(f, rec.impl_name);
+        fprintf(f, ",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":%d,\"tid\":%d,"
+                "\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"kind\":\"%s\",\"info\":",
+                rec.event == profiling_event::create ? "create" : "execute",
+                pid, rec.thread_id, rec.start_us, rec.duration_us,
+                mkldnn_prim_kind2str(rec.primitive_kind));
+        fprint_json_str(f, rec.info);
+        fprintf(f, ",\"nthr\":%d,\"scratchpad\":%lu}}", rec.nthr,
+                (unsigned long)rec.scratchpad_size);
+    }
+    fprintf(f, "\n],\"displayTimeUnit\":\"ms\"}\n");
+
+    const bool ok = !ferror(f);
+    return fclose(f) == 0 && ok ? success : runtime_error;
+}
+
+profiler_t &profiler() {
+    /* Never destroyed: primitives may be created or executed by the
+     * destructors of other static objects. */
+    static profiler_t *p = new profiler_t();
+    return *p;
+}
+
+}
+}
+
+status_t mkldnn_set_profiling_capacity(int capacity) {
+    return profiler().set_capacity(capacity);
+}
+
+status_t mkldnn_get_profiling_capacity(int *capacity) {
+    if (capacity == nullptr) return invalid_arguments;
+    *capacity = profiler().capacity();
+    return success;
+}
+
+status_t mkldnn_get_profiling_records(profiling_record_t *records,
+        int *count) {
+    if (count == nullptr || (records != nullptr && *count < 0))
+        return invalid_arguments;
+
+    std::vector<profiling_record_t> recs;
+    profiler().get_records(recs);
+    if (records == nullptr) {
+        *count = (int)recs.size();
+        return success;
+    }
+
+    /* keep the most recent ones */
+    const int n = nstl::min(*count, (int)recs.size());
+    const size_t first = recs.size() - n;
+    for (int i = 0; i < n; ++i)
+        records[i] = recs[first + i];
+    *count = n;
+    return success;
+}
+
+status_t mkldnn_reset_profiling() {
+    profiler().reset();
+    return success;
+}
+
+status_t mkldnn_dump_profiling_trace(const char *path) {
+    return profiler().dump_trace(path);
+}
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
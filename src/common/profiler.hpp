@@ -0,0 +1,102 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef PROFILER_HPP
+#define PROFILER_HPP
+
+#include <stdint.h>
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include "mkldnn_types.h"
+
+#include "c_types_map.hpp"
+
+namespace mkldnn {
+namespace impl {
+
+/** Process-wide recorder of primitive creation and execution times.
+ *
+ * The records are kept in a ring buffer of a fixed capacity: when it is full
+ * the oldest records are overwritten. Recording does not take any lock, so
+ * primitives executed concurrently (e.g. by a lazy stream) do not serialize
+ * on the profiler. Each slot carries a sequence number that a writer makes
+ * odd while it fills the slot, so that a reader can skip the records that
+ * are being overwritten.
+ *
+ * Times are taken with get_msec(), which uses a monotonic clock.
+ *
+ * The capacity (number of records) is taken from the MKLDNN_PROFILING
+ * environment variable and can be changed with
+ * mkldnn_set_profiling_capacity(). The default capacity is 0, i.e. the
+ * profiler is disabled. If MKLDNN_PROFILING_TRACE is set, the records are
+ * written to that file in the Chrome trace format at exit. */
+struct profiler_t {
+    profiler_t();
+    ~profiler_t();
+
+    bool enabled() const
+    { return ring_.load(std::memory_order_relaxed) != nullptr; }
+
+    int capacity() const;
+    /** Discards all the records. The ring that is replaced is kept until
+     * exit, as concurrent writers may still hold it. */
+    status_t set_capacity(int capacity);
+
+    /** Records an @p event of @p pd that started at @p start_ms and lasted
+     * @p duration_ms milliseconds */
+    void record(profiling_event_t event, const primitive_desc_t *pd,
+            double start_ms, double duration_ms);
+
+    /** Returns the complete records, oldest first */
+    void get_records(std::vector<profiling_record_t> &records) const;
+    void reset();
+
+    status_t dump_trace(const char *path) const;
+
+private:
+    struct slot_t {
+        std::atomic<uint64_t> seq;
+        profiling_record_t rec;
+    };
+    struct ring_t {
+        ring_t(int capacity);
+        ~ring_t();
+
+        int capacity;
+        std::atomic<uint64_t> head; /* index of the next record */
+        std::atomic<uint64_t> first; /* first record not reset */
+        slot_t *slots;
+    };
+
+    std::atomic<ring_t *> ring_;
+    std::vector<ring_t *> retired_;
+    std::mutex mutex_; /* serializes set_capacity() */
+
+    profiler_t(const profiler_t &) = delete;
+    profiler_t &operator=(const profiler_t &) = delete;
+};
+
+profiler_t &profiler();
+
+}
+}
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -14,7 +14,9 @@
 * limitations under the License.
 *******************************************************************************/
 
+#include "arena.hpp"
 #include "mkldnn_thread.hpp"
+#include "numa.hpp"
 #include "utils.hpp"
 
 #include "scratchpad.hpp"
@@ -32,12 +34,13 @@ const size_t page_size = 2097152;
 struct concurent_scratchpad_t : public scratchpad_t {
     concurent_scratchpad_t(size_t size) {
         size_ = size;
-        scratchpad_ = (char *) malloc(size, page_size);
+        scratchpad_ = (char *) scratchpad_arena().allocate(size, page_size);
         assert(scratchpad_ != nullptr);
+        numa::first_touch(scratchpad_, size);
     }
 
     ~concurent_scratchpad_t() {
-        free(scratchpad_);
+        scratchpad_arena().deallocate(scratchpad_);
     }
 
     virtual char *get() const {
@@ -57,10 +60,13 @@ private:
 struct global_scratchpad_t : public scratchpad_t {
     global_scratchpad_t(size_t size) {
         if (size > size_) {
-            if (scratchpad_ != nullptr) free(scratchpad_);
+            if (scratchpad_ != nullptr)
+                scratchpad_arena().deallocate(scratchpad_);
             size_ = size;
-            scratchpad_ = (char *) malloc(size, page_size);
+            scratchpad_ = (char *) scratchpad_arena().allocate(size,
+                    page_size);
             assert(scratchpad_ != nullptr);
+            numa::first_touch(scratchpad_, size);
         }
         reference_count_++;
     }
@@ -68,7 +74,7 @@ struct global_scratchpad_t : public scratchpad_t {
     ~global_scratchpad_t() {
         reference_count_--;
         if (reference_count_ == 0) {
-            free(scratchpad_);
+            scratchpad_arena().deallocate(scratchpad_);
             scratchpad_ = nullptr;
             size_ = 0;
         }
@@ -89,6 +95,37 @@ thread_local size_t global_scratchpad_t::size_ = 0;
 thread_local unsigned int global_scratchpad_t::reference_count_ = 0;
 
 
+/*
+  Implementation of the scratchpad of a stream
+*/
+status_t stream_scratchpad_t::reserve(size_t size) {
+    if (size <= size_) return status::success;
+    if (!owned_) return status::invalid_arguments;
+
+    release();
+    ptr_ = (char *) scratchpad_arena().allocate(size, page_size);
+    if (ptr_ == nullptr) return status::out_of_memory;
+    numa::first_touch(ptr_, size);
+    size_ = size;
+    return status::success;
+}
+
+status_t stream_scratchpad_t::set(void *ptr, size_t size) {
+    if (ptr == nullptr && size != 0) return status::invalid_arguments;
+
+    release();
+    owned_ = ptr == nullptr;
+    ptr_ = (char *)ptr;
+    size_ = size;
+    return status::success;
+}
+
+void stream_scratchpad_t::release() {
+    if (owned_) scratchpad_arena().deallocate(ptr_);
+    ptr_ = nullptr;
+    size_ = 0;
+}
+
 /*
    Scratchpad creation routine
 */
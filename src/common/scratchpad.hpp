@@ -17,6 +17,7 @@
 #ifndef COMMON_SCRATCHPAD_HPP
 #define COMMON_SCRATCHPAD_HPP
 
+#include "c_types_map.hpp"
 #include "utils.hpp"
 
 namespace mkldnn {
@@ -29,6 +30,36 @@ struct scratchpad_t {
 
 scratchpad_t *create_scratchpad(size_t size);
 
+/** Scratchpad of a stream, shared by all the primitives executed in the
+ * stream with mkldnn_scratchpad_mode_user.
+ *
+ * By default the memory is owned: it grows to the largest request and is
+ * released with the stream or by set(nullptr, 0). Memory provided by the
+ * user with set() is never reallocated, requests exceeding it fail. */
+struct stream_scratchpad_t {
+    stream_scratchpad_t(): ptr_(nullptr), size_(0), owned_(true) {}
+    ~stream_scratchpad_t() { release(); }
+
+    /** makes the scratchpad at least @p size bytes */
+    status_t reserve(size_t size);
+    /** uses the user memory [@p ptr, @p ptr + @p size) from now on, or the
+     * owned memory if @p ptr is nullptr */
+    status_t set(void *ptr, size_t size);
+
+    char *get() const { return ptr_; }
+    size_t size() const { return size_; }
+
+private:
+    void release();
+
+    char *ptr_;
+    size_t size_;
+    bool owned_;
+
+    stream_scratchpad_t(const stream_scratchpad_t &) = delete;
+    stream_scratchpad_t &operator=(const stream_scratchpad_t &) = delete;
+};
+
 }
 }
 #endif
@@ -46,7 +46,9 @@ status_t stream_t::submit(const nstl::vector<primitive_t *> &prims,
 
     const size_t start = stream_.size();
     stream_.insert(stream_.end(), prims.begin(), prims.end());
-    return submit_impl(start, stream_.size(), error_prim);
+    return execute([&]() {
+        return submit_impl(start, stream_.size(), error_prim);
+    });
 }
 
 bool stream_t::closed() const { return true; }
@@ -61,7 +63,7 @@ status_t stream_t::wait(primitive_t **error_prim) {
 
     modifiable_ = false;
     state_ = stream_t::waiting;
-    status_t status = wait_impl(error_prim);
+    status_t status = execute([&]() { return wait_impl(error_prim); });
     state_ = stream_t::stopped;
     return status;
 }
@@ -73,7 +75,7 @@ status_t stream_t::rerun(primitive_t **error_prim) {
     if (error_prim == nullptr) error_prim = &error_primitive_stub;
 
     state_ = stream_t::running;
-    return rerun_impl(error_prim);
+    return execute([&]() { return rerun_impl(error_prim); });
 }
 
 /* API */
@@ -117,6 +119,45 @@ status_t mkldnn_stream_rerun(stream_t *stream, primitive_t **error_primitive) {
     return stream->rerun(error_primitive);
 }
 
+status_t mkldnn_stream_set_scratchpad(stream_t *stream, void *scratchpad,
+        size_t size) {
+    if (stream == nullptr) return invalid_arguments;
+    return stream->set_scratchpad(scratchpad, size);
+}
+
+status_t mkldnn_stream_get_scratchpad_size(const stream_t *stream,
+        size_t *size) {
+    if (utils::any_null(stream, size)) return invalid_arguments;
+    *size = stream->scratchpad_size();
+    return success;
+}
+
+status_t mkldnn_stream_get_plan_stats(const stream_t *stream, int *fused,
+        int *levels) {
+    if (stream == nullptr) return invalid_arguments;
+    int f, l;
+    stream->plan_stats(&f, &l);
+    if (fused) *fused = f;
+    if (levels) *levels = l;
+    return success;
+}
+
+status_t mkldnn_stream_set_numa_node(stream_t *stream, int node) {
+    if (stream == nullptr) return invalid_arguments;
+    return stream->set_numa_node(node);
+}
+
+status_t mkldnn_stream_set_instance(stream_t *stream, instance_t *instance) {
+    if (stream == nullptr) return invalid_arguments;
+    return stream->set_instance(instance);
+}
+
+status_t mkldnn_get_numa_node_count(int *count) {
+    if (count == nullptr) return invalid_arguments;
+    *count = numa::num_nodes();
+    return success;
+}
+
 status_t mkldnn_stream_destroy(stream_t *stream) {
     if (stream) delete stream;
     return success;
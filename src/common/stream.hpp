@@ -23,8 +23,13 @@
 #include "c_types_map.hpp"
 #include "event.hpp"
 #include "engine.hpp"
+#include "instance.hpp"
+#include "mkldnn_thread.hpp"
 #include "nstl.hpp"
+#include "numa.hpp"
 #include "primitive.hpp"
+#include "scratchpad.hpp"
+#include "stream_plan.hpp"
 #include "utils.hpp"
 
 struct mkldnn_stream: public mkldnn::impl::c_compatible {
@@ -72,7 +77,9 @@ struct mkldnn_stream: public mkldnn::impl::c_compatible {
 #endif
     };
 
-    mkldnn_stream(): modifiable_(true), state_(mkldnn_stream::running) {}
+    mkldnn_stream()
+        : modifiable_(true), state_(mkldnn_stream::running), numa_node_(-1)
+        , instance_(nullptr) {}
     virtual ~mkldnn_stream() {}
 
     /** submits vector of primitives @p prims to a stream
@@ -154,21 +161,92 @@ struct mkldnn_stream: public mkldnn::impl::c_compatible {
     virtual mkldnn::impl::status_t rerun_impl(
             mkldnn::impl::primitive_t **error_prim) = 0;
 
+    /** sets the scratchpad shared by the primitives created with
+     * mkldnn_scratchpad_mode_user, see mkldnn_stream_set_scratchpad() */
+    mkldnn::impl::status_t set_scratchpad(void *scratchpad, size_t size) {
+        if (state_ == waiting) return mkldnn::impl::status::invalid_arguments;
+        return scratchpad_.set(scratchpad, size);
+    }
+
+    /** pins the threads executing the stream to the NUMA @p node, or
+     * unpins them for -1, see mkldnn_stream_set_numa_node() */
+    mkldnn::impl::status_t set_numa_node(int node) {
+        if (node < -1 || node >= mkldnn::impl::numa::num_nodes())
+            return mkldnn::impl::status::invalid_arguments;
+        numa_node_ = node;
+        return mkldnn::impl::status::success;
+    }
+
+    /** runs the stream on the @p instance, or on the threads of the
+     * library for nullptr, see mkldnn_stream_set_instance() */
+    mkldnn::impl::status_t set_instance(mkldnn::impl::instance_t *instance) {
+        if (state_ == waiting) return mkldnn::impl::status::invalid_arguments;
+        instance_ = instance;
+        return mkldnn::impl::status::success;
+    }
+
+    /** returns the number of fusions and of levels of the execution plan,
+     * see mkldnn_stream_get_plan_stats() */
+    virtual void plan_stats(int *nfused, int *nlevels) const {
+        *nfused = 0;
+        *nlevels = 0;
+    }
+
+    /** returns the scratchpad size required by the submitted primitives */
+    size_t scratchpad_size() const {
+        size_t size = 0;
+        for (size_t i = 0; i < stream_.size(); ++i)
+            if (stream_[i]->use_stream_scratchpad())
+                size = mkldnn::impl::nstl::max(size,
+                        stream_[i]->scratchpad_size());
+        return size;
+    }
+
 protected:
     bool modifiable_;
     state_t state_;
 
     primitive_vector stream_;
+    mkldnn::impl::stream_scratchpad_t scratchpad_;
+    int numa_node_;
+    mkldnn::impl::instance_t *instance_;
+
+    /** the scratchpad of the instance if any, the own one otherwise */
+    mkldnn::impl::stream_scratchpad_t &scratchpad() {
+        return instance_ ? instance_->scratchpad() : scratchpad_;
+    }
+
+    /** runs the execution @p f on the instance, or on the threads of the
+     * library: pinned to numa_node_, one per CPU of the node, or with the
+     * affinity the process started with for -1 */
+    template <typename F>
+    mkldnn::impl::status_t execute(F f) {
+        using namespace mkldnn::impl;
+        if (instance_) return instance_->execute(f);
+        if (numa_node_ < 0) {
+            status_t status = numa::unpin_threads();
+            if (status != status::success) return status;
+            return f();
+        }
+#if MKLDNN_THR == MKLDNN_THR_OMP
+        const int saved_nthr = omp_get_max_threads();
+        omp_set_num_threads(nstl::min(saved_nthr,
+                    nstl::max(1, numa::num_cpus(numa_node_))));
+#endif
+        status_t status = numa::pin_threads(numa_node_);
+        if (status == status::success) status = f();
+#if MKLDNN_THR == MKLDNN_THR_OMP
+        omp_set_num_threads(saved_nthr);
+#endif
+        return status;
+    }
 };
 
 namespace mkldnn {
 namespace impl {
 
-struct stream_lazy_t;
-
 /** \brief non-lazy stream */
 struct stream_eager_t: public stream_t {
-    friend stream_lazy_t;
 
     virtual status_t submit_impl(size_t begin, size_t end,
             primitive_t **error_prim) {
@@ -189,6 +267,15 @@ struct stream_eager_t: public stream_t {
                 }
             }
 
+            if (p->use_stream_scratchpad()) {
+                status_t status = scratchpad().reserve(p->scratchpad_size());
+                if (status != status::success) {
+                    *error_prim = p;
+                    return status;
+                }
+                p->set_stream_scratchpad(scratchpad().get());
+            }
+
             status_t status = p->engine()->submit(p, &deps_[p], prereq);
             if (status != status::success) {
                 *error_prim = p;
@@ -233,31 +320,46 @@ protected:
 };
 
 /** \brief lazy stream
+ *
+ * Primitives are executed on wait() according to an optimized execution
+ * plan, see stream_plan_t. rerun() replays the plan.
  *
  * @attention
  *     both wait_impl() and rerun_impl() may return pointer to a primitive
- *     which caused an error. Alas this @p error_prim may point to a
- *     not-user-submitted primitive because of possible fusing. It is
- *     guaranteed that the pointer will be valid till the stream is alive
+ *     which caused an error. Because of fusing, it is the submitted primitive
+ *     the failed one was created from.
  */
 struct stream_lazy_t: public stream_t {
+    stream_lazy_t(): status_(status::success), error_prim_(nullptr) {}
+
     virtual status_t wait_impl(primitive_t **error_prim) {
-        stream_eager_.stream_ = stream_;
-#if 0
-        for_each (aengine in stream_) {
-            aengine->optimize(stream_eager_.stream_); /* in-place operation */
+        if (!plan_.built()) {
+            status_ = plan_.build(stream_);
+            if (status_ == status::success)
+                status_ = plan_.execute(scratchpad(), &error_prim_);
         }
-#endif
-        stream_eager_.submit(stream_eager_.stream_, error_prim);
-        return stream_eager_.wait_impl(error_prim);
+        if (status_ != status::success && error_prim_ != nullptr)
+            *error_prim = error_prim_;
+        return status_;
     }
 
     virtual status_t rerun_impl(primitive_t **error_prim) {
-        return stream_eager_.rerun(error_prim);
+        status_ = plan_.execute(scratchpad(), &error_prim_);
+        if (status_ != status::success && error_prim_ != nullptr)
+            *error_prim = error_prim_;
+        return status_;
+    }
+
+    virtual void plan_stats(int *nfused, int *nlevels) const {
+        *nfused = plan_.nfused();
+        *nlevels = plan_.nlevels();
     }
 
 protected:
-    stream_eager_t stream_eager_;
+    stream_plan_t plan_;
+    /* result of the last execution, returned by wait() after rerun() */
+    status_t status_;
+    primitive_t *error_prim_;
 };
 
 }
@@ -0,0 +1,535 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "mkldnn.h"
+
+#include "c_types_map.hpp"
+#include "engine.hpp"
+#include "memory_pd.hpp"
+#include "mkldnn_thread.hpp"
+#include "reorder_pd.hpp"
+#include "type_helpers.hpp"
+#include "utils.hpp"
+#include "verbose.hpp"
+
+#include "stream_plan.hpp"
+
+namespace mkldnn {
+namespace impl {
+
+using namespace mkldnn::impl::status;
+using namespace mkldnn::impl::utils;
+
+namespace {
+
+bool plan_optimization_enabled() {
+    static int enabled = -1;
+    if (enabled == -1) {
+        char buf[2];
+        enabled = mkldnn_getenv("MKLDNN_LAZY_STREAM_OPT", buf, sizeof(buf)) == 1
+            ? buf[0] != '0' : 1;
+    }
+    return enabled;
+}
+
+const memory_pd_t *memory_pd(const primitive_t *mem)
+{ return reinterpret_cast<const memory_pd_t *>(mem->pd()); }
+
+/* the memory primitive holding the data of @p a, nullptr if unknown
+ * (e.g. a view) */
+const primitive_t *resolve(const primitive_at_t &a) {
+    const primitive_t *mem = a.primitive;
+    if (mem->kind() != primitive_kind::memory) {
+        if (a.output_index >= mem->outputs().size()) return nullptr;
+        mem = mem->outputs()[a.output_index];
+    }
+    return mem->kind() == primitive_kind::memory ? mem : nullptr;
+}
+
+/* training keeps the convolution output for the backward pass, so only
+ * inference convolutions take post-ops */
+bool is_inference_conv(const primitive_t *p) {
+    if (p->kind() != primitive_kind::convolution) return false;
+    auto cd = reinterpret_cast<const convolution_desc_t *>(p->pd()->op_desc());
+    return cd->prop_kind == prop_kind::forward_inference
+        && p->pd()->n_outputs() == 1;
+}
+
+/* the implementations of these kinds size their thread team when they are
+ * executed (parallel(0, ...) or parallel_nd()), so they can run on a part
+ * of the threads. The others, e.g. the JIT convolutions, may fix it at
+ * creation and would oversubscribe the cores. */
+bool sizes_team_at_execution(const primitive_t *p) {
+    return one_of(p->kind(), primitive_kind::reorder, primitive_kind::eltwise,
+            primitive_kind::pooling, primitive_kind::sum,
+            primitive_kind::concat);
+}
+
+/* creates a primitive descriptor of the same implementation as @p pd, with
+ * the attributes @p attr */
+status_t recreate_conv_pd(primitive_desc_t **new_pd,
+        const primitive_desc_t *pd, const primitive_attr_t *attr) {
+    /* pin the formats chosen for the original primitive */
+    convolution_desc_t cd
+        = *reinterpret_cast<const convolution_desc_t *>(pd->op_desc());
+    cd.src_desc = *pd->src_pd()->desc();
+    cd.weights_desc = *pd->weights_pd(0)->desc();
+    if (pd->weights_pd(1)) cd.bias_desc = *pd->weights_pd(1)->desc();
+    cd.dst_desc = *pd->dst_pd()->desc();
+
+    engine_t *engine = pd->engine();
+    for (auto f = engine->get_implementation_list(); *f; ++f) {
+        primitive_desc_t *candidate;
+        if ((*f)(&candidate, reinterpret_cast<const op_desc_t *>(&cd), attr,
+                    engine, nullptr) != success)
+            continue;
+        if (strcmp(candidate->name(), pd->name()) == 0) {
+            *new_pd = candidate;
+            return success;
+        }
+        delete candidate;
+    }
+    return unimplemented;
+}
+
+status_t create_reorder_pd(reorder_pd_t **r_pd, const memory_pd_t *i_mpd,
+        const memory_pd_t *o_mpd) {
+    const primitive_attr_t attr;
+    engine_t *engine = o_mpd->engine();
+    for (auto r = engine->get_reorder_implementation_list(); *r; ++r) {
+        if ((*r)(r_pd, i_mpd, o_mpd, &attr) == success) {
+            (*r_pd)->init_info();
+            return success;
+        }
+    }
+    return unimplemented;
+}
+
+}
+
+void stream_plan_t::clear() {
+    for (auto &n: nodes_)
+        if (n.owned) delete n.p;
+    nodes_.clear();
+    levels_.clear();
+    handles_.clear();
+    prims_.clear();
+    nfused_ = 0;
+    built_ = false;
+}
+
+bool stream_plan_t::data_ranges(const primitive_t *p,
+        std::vector<range_t> &in, std::vector<range_t> &out) {
+    auto range = [](const primitive_t *mem, range_t &r) {
+        void *handle;
+        if (mem == nullptr || mem->get_data_handle(&handle) != success)
+            return false;
+        r.begin = (const char *)handle;
+        r.end = r.begin + memory_pd(mem)->get_size();
+        return true;
+    };
+
+    in.clear();
+    out.clear();
+    range_t r;
+    for (size_t k = 0; k < p->inputs().size(); ++k) {
+        if (!range(resolve(p->inputs()[k]), r)) return false;
+        in.push_back(r);
+    }
+    for (size_t k = 0; k < p->outputs().size(); ++k) {
+        if (!range(p->outputs()[k], r)) return false;
+        out.push_back(r);
+    }
+    return true;
+}
+
+bool stream_plan_t::snapshot(std::vector<range_t> &handles) const {
+    handles.clear();
+    std::vector<range_t> in, out;
+    for (size_t k = 0; k < prims_.size(); ++k) {
+        if (!data_ranges(prims_[k], in, out)) return false;
+        handles.insert(handles.end(), in.begin(), in.end());
+        handles.insert(handles.end(), out.begin(), out.end());
+    }
+    return true;
+}
+
+bool stream_plan_t::reads(const node_t &n, const range_t &r) const {
+    for (auto &in: n.in)
+        if (in.overlaps(r)) return true;
+    return false;
+}
+
+bool stream_plan_t::writes(const node_t &n, const range_t &r) const {
+    for (auto &out: n.out)
+        if (out.overlaps(r)) return true;
+    return false;
+}
+
+bool stream_plan_t::touched_by_others(const range_t &r, size_t i,
+        size_t j) const {
+    for (size_t k = 0; k < nodes_.size(); ++k) {
+        if (k == i || k == j || nodes_[k].dead) continue;
+        if (touches(nodes_[k], r)) return true;
+    }
+    return false;
+}
+
+void stream_plan_t::replace(size_t i, primitive_t *p, primitive_t *origin) {
+    node_t &n = nodes_[i];
+    if (n.owned) delete n.p;
+    n.p = p;
+    n.origin = origin;
+    n.owned = true;
+    n.dead = false;
+}
+
+/* r1: A -> B, r2: B -> C  ==>  A -> C */
+bool stream_plan_t::fuse_reorders(size_t j) {
+    node_t &r2 = nodes_[j];
+    if (r2.p->kind() != primitive_kind::reorder
+            || !r2.p->pd()->attr()->has_default_values())
+        return false;
+    const range_t b = r2.in[0], c = r2.out[0];
+
+    size_t i = j;
+    while (i-- > 0)
+        if (!nodes_[i].dead && touches(nodes_[i], b)) break;
+    if (i == (size_t)-1) return false;
+
+    node_t &r1 = nodes_[i];
+    if (r1.p->kind() != primitive_kind::reorder
+            || !r1.p->pd()->attr()->has_default_values()
+            || !(r1.out[0] == b) || reads(r1, b))
+        return false;
+    const range_t a = r1.in[0];
+    if (a.overlaps(c) || touched_by_others(b, i, j)) return false;
+    /* B must hold A exactly, e.g. not a quantized copy */
+    const memory_pd_t *a_mpd = memory_pd(resolve(r1.p->inputs()[0]));
+    if (memory_pd(r1.p->outputs()[0])->desc()->data_type
+            != a_mpd->desc()->data_type)
+        return false;
+    for (size_t k = i + 1; k < j; ++k)
+        if (!nodes_[k].dead && writes(nodes_[k], a)) return false;
+
+    reorder_pd_t *r_pd;
+    if (create_reorder_pd(&r_pd, a_mpd, memory_pd(r2.p->outputs()[0]))
+            != success)
+        return false;
+    primitive_t *p;
+    const primitive_t *outputs[] = { r2.p->outputs()[0] };
+    status_t status = r_pd->create_primitive(&p, &r1.p->inputs()[0],
+            outputs);
+    delete r_pd;
+    if (status != success) return false;
+
+    replace(j, p, r2.origin);
+    r2.in = r1.in;
+    if (r1.owned) delete r1.p;
+    r1.owned = false;
+    r1.dead = true;
+    return true;
+}
+
+/* conv: X -> B, eltwise: B -> D  ==>  conv + eltwise: X -> D */
+bool stream_plan_t::fold_eltwise(size_t j) {
+    node_t &e = nodes_[j];
+    if (e.p->kind() != primitive_kind::eltwise) return false;
+    auto ed = reinterpret_cast<const eltwise_desc_t *>(e.p->pd()->op_desc());
+    if (ed->prop_kind != prop_kind::forward_inference) return false;
+    const range_t b = e.in[0], d = e.out[0];
+    const bool in_place = b == d;
+    if (!in_place && b.overlaps(d)) return false;
+
+    size_t i = j;
+    while (i-- > 0)
+        if (!nodes_[i].dead && touches(nodes_[i], b)) break;
+    if (i == (size_t)-1) return false;
+
+    const node_t &conv = nodes_[i];
+    if (!is_inference_conv(conv.p) || !(conv.out[0] == b)) return false;
+    if (!in_place && touched_by_others(b, i, j)) return false;
+    /* in place, the nodes in between would see B before the eltwise while
+     * the fused convolution writes it after */
+    if (in_place)
+        for (size_t k = i + 1; k < j; ++k)
+            if (!nodes_[k].dead && touches(nodes_[k], b)) return false;
+
+    post_ops_t post_ops = conv.p->pd()->attr()->post_ops_;
+    if (post_ops.append_eltwise(1.f, ed->alg_kind, ed->alpha, ed->beta)
+            != success)
+        return false;
+    return fold_post_op(i, j, d, post_ops, nullptr);
+}
+
+/* conv: X -> B, sum: B + s * Y -> Y  ==>  conv + sum(s): X -> Y */
+bool stream_plan_t::fold_sum(size_t j) {
+    node_t &s = nodes_[j];
+    if (s.p->kind() != primitive_kind::sum || s.in.size() != 2) return false;
+    const float *scales
+        = reinterpret_cast<const sum_pd_t *>(s.p->pd())->scales();
+    if (scales == nullptr) return false;
+
+    for (int k = 0; k < 2; ++k) {
+        const range_t b = s.in[k], y = s.in[1 - k];
+        if (scales[k] != 1.f || !(s.out[0] == y) || b.overlaps(y)) continue;
+
+        size_t i = j;
+        while (i-- > 0)
+            if (!nodes_[i].dead && touches(nodes_[i], b)) break;
+        if (i == (size_t)-1) continue;
+
+        const node_t &conv = nodes_[i];
+        if (!is_inference_conv(conv.p) || !(conv.out[0] == b)
+                || touched_by_others(b, i, j))
+            continue;
+
+        post_ops_t post_ops = conv.p->pd()->attr()->post_ops_;
+        if (post_ops.append_sum(scales[1 - k]) != success) continue;
+        if (fold_post_op(i, j, y, post_ops, &y)) return true;
+    }
+    return false;
+}
+
+/* replaces the convolution nodes_[i] and the primitive nodes_[j] it feeds
+ * with the convolution with @p post_ops writing to @p dst. @p accum, if not
+ * nullptr, is the tensor the post-ops sum accumulates to. */
+bool stream_plan_t::fold_post_op(size_t i, size_t j, const range_t &dst,
+        const post_ops_t &post_ops, const range_t *accum) {
+    node_t &conv = nodes_[i];
+    const primitive_desc_t *pd = conv.p->pd();
+    const primitive_t *dst_mem = nodes_[j].p->outputs()[0];
+    if (memory_desc_wrapper(pd->dst_pd()) != memory_desc_wrapper(
+                memory_pd(dst_mem)))
+        return false;
+    if (reads(conv, dst)) return false;
+
+    /* the fused convolution can run in place of the convolution if nothing
+     * in between uses dst, or in place of nodes_[j] if nothing in between
+     * overwrites the inputs of the convolution */
+    bool at_i = true, at_j = true;
+    for (size_t k = i + 1; k < j; ++k) {
+        const node_t &n = nodes_[k];
+        if (n.dead) continue;
+        if (touches(n, dst)) at_i = false;
+        for (auto &in: conv.in)
+            if (writes(n, in)) at_j = false;
+    }
+    if (!at_i && !at_j) return false;
+
+    primitive_attr_t attr = *pd->attr();
+    if (attr.set_post_ops(post_ops) != success) return false;
+    primitive_desc_t *new_pd;
+    if (recreate_conv_pd(&new_pd, pd, &attr) != success) return false;
+    primitive_t *p;
+    const primitive_t *outputs[] = { dst_mem };
+    status_t status = new_pd->create_primitive(&p, &conv.p->inputs()[0],
+            outputs);
+    delete new_pd;
+    if (status != success) return false;
+
+    std::vector<range_t> in = conv.in;
+    if (accum) in.push_back(*accum);
+    primitive_t *origin = conv.origin;
+    const size_t place = at_j ? j : i, other = at_j ? i : j;
+
+    replace(place, p, origin);
+    nodes_[place].in = in;
+    nodes_[place].out = std::vector<range_t>(1, dst);
+    if (nodes_[other].owned) delete nodes_[other].p;
+    nodes_[other].owned = false;
+    nodes_[other].dead = true;
+    return true;
+}
+
+/* a node goes to the level following the last node it depends on, so the
+ * nodes of a level are independent */
+void stream_plan_t::compute_levels() {
+    levels_.clear();
+    for (size_t k = 0; k < nodes_.size(); ++k) {
+        node_t &n = nodes_[k];
+        if (n.dead) continue;
+        n.level = 0;
+        for (size_t m = 0; m < k; ++m) {
+            const node_t &prev = nodes_[m];
+            if (prev.dead || prev.level < n.level) continue;
+            bool dep = false;
+            for (auto &out: prev.out) dep = dep || touches(n, out);
+            for (auto &in: prev.in) dep = dep || writes(n, in);
+            if (dep) n.level = prev.level + 1;
+        }
+        if ((size_t)n.level >= levels_.size()) levels_.resize(n.level + 1);
+        levels_[n.level].push_back(k);
+    }
+}
+
+status_t stream_plan_t::build(const primitive_vector &prims) {
+    clear();
+    prims_ = prims;
+    for (size_t k = 0; k < prims.size(); ++k) {
+        node_t n;
+        n.p = n.origin = prims[k];
+        n.owned = n.dead = false;
+        n.level = (int)k;
+        nodes_.push_back(n);
+    }
+    built_ = true;
+
+    bool analyzable = snapshot(handles_);
+    for (auto &n: nodes_)
+        analyzable = analyzable && data_ranges(n.p, n.in, n.out);
+    if (!analyzable || !plan_optimization_enabled()) {
+        handles_.clear();
+        levels_.resize(nodes_.size());
+        for (size_t k = 0; k < nodes_.size(); ++k) levels_[k].push_back(k);
+        return success;
+    }
+
+    for (bool changed = true; changed; ) {
+        changed = false;
+        for (size_t j = 0; j < nodes_.size(); ++j) {
+            if (nodes_[j].dead) continue;
+            if (fuse_reorders(j) || fold_eltwise(j) || fold_sum(j)) {
+                changed = true;
+                nfused_++;
+            }
+        }
+    }
+    compute_levels();
+
+    if (mkldnn_verbose()->level) {
+        printf("mkldnn_verbose,plan,primitives:%d,fused:%d,levels:%d\n",
+                (int)prims.size(), nfused_, (int)levels_.size());
+        fflush(0);
+    }
+    return success;
+}
+
+status_t stream_plan_t::execute_node(node_t &n, char *scratchpad) {
+    if (n.p->use_stream_scratchpad()) n.p->set_stream_scratchpad(scratchpad);
+    n.event.reset();
+    engine_t::event_vector prereq;
+    status_t status = n.p->engine()->submit(n.p, &n.event, prereq);
+    if (status == success && n.event.get_state() == event_t::error)
+        status = runtime_error;
+    return status;
+}
+
+status_t stream_plan_t::execute_level(const std::vector<size_t> &level,
+        stream_scratchpad_t &scratchpad, primitive_t **error_prim) {
+    /* the primitives that cannot run on a part of the threads go first, one
+     * after another on all the threads */
+    std::vector<size_t> seq, conc;
+    for (size_t b = 0; b < level.size(); ++b) {
+        const primitive_t *p = nodes_[level[b]].p;
+        const bool ok = p->concurrent_safe() && sizes_team_at_execution(p);
+        (ok ? conc : seq).push_back(level[b]);
+    }
+
+    /* each concurrent primitive gets its own part of the scratchpad */
+    std::vector<size_t> offsets(conc.size(), 0);
+    bool concurrent = conc.size() > 1 && mkldnn_get_max_threads() > 1;
+    size_t total = 0;
+    for (size_t b = 0; b < conc.size(); ++b) {
+        const primitive_t *p = nodes_[conc[b]].p;
+        offsets[b] = total;
+        if (p->use_stream_scratchpad())
+            total += rnd_up(p->scratchpad_size(), (size_t)64);
+    }
+#if MKLDNN_THR != MKLDNN_THR_OMP && MKLDNN_THR != MKLDNN_THR_TBB
+    /* nested parallelism is required to split the threads */
+    concurrent = false;
+#endif
+    if (concurrent && scratchpad.reserve(total) != success)
+        concurrent = false;
+    if (!concurrent) {
+        seq.insert(seq.end(), conc.begin(), conc.end());
+        conc.clear();
+    }
+
+    for (size_t b = 0; b < seq.size(); ++b) {
+        node_t &n = nodes_[seq[b]];
+        status_t status = n.p->use_stream_scratchpad()
+            ? scratchpad.reserve(n.p->scratchpad_size()) : success;
+        if (status == success)
+            status = execute_node(n, scratchpad.get());
+        if (status != success) {
+            *error_prim = n.origin;
+            return status;
+        }
+    }
+    if (conc.empty()) return success;
+
+    std::vector<status_t> statuses(conc.size(), success);
+    auto run = [&](size_t b) {
+        statuses[b] = execute_node(nodes_[conc[b]],
+                scratchpad.get() + offsets[b]);
+    };
+#if MKLDNN_THR == MKLDNN_THR_OMP
+    /* split the threads into a team per branch */
+    const int nthr = mkldnn_get_max_threads();
+    const int nbranches = nstl::min((int)conc.size(), nthr);
+    const int max_active_levels = omp_get_max_active_levels();
+    if (max_active_levels < 2) omp_set_max_active_levels(2);
+#   pragma omp parallel num_threads(nbranches)
+    {
+        const int ithr = omp_get_thread_num();
+        int start{0}, end{0};
+        balance211(nthr, nbranches, ithr, start, end);
+        omp_set_num_threads(end - start);
+        for (size_t b = ithr; b < conc.size(); b += nbranches) run(b);
+    }
+    if (max_active_levels < 2) omp_set_max_active_levels(max_active_levels);
+#elif MKLDNN_THR == MKLDNN_THR_TBB
+    parallel((int)conc.size(), [&](int ithr, int) { run(ithr); });
+#endif
+
+    for (size_t b = 0; b < conc.size(); ++b) {
+        if (statuses[b] != success) {
+            *error_prim = nodes_[conc[b]].origin;
+            return statuses[b];
+        }
+    }
+    return success;
+}
+
+status_t stream_plan_t::execute(stream_scratchpad_t &scratchpad,
+        primitive_t **error_prim) {
+    if (!handles_.empty()) {
+        /* the memory may have been given new data handles since */
+        std::vector<range_t> handles;
+        if (!snapshot(handles) || handles != handles_) {
+            primitive_vector prims = prims_;
+            status_t status = build(prims);
+            if (status != success) return status;
+        }
+    }
+
+    for (auto &level: levels_) {
+        status_t status = execute_level(level, scratchpad, error_prim);
+        if (status != success) return status;
+    }
+    return success;
+}
+
+}
+}
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -0,0 +1,135 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef STREAM_PLAN_HPP
+#define STREAM_PLAN_HPP
+
+#include <vector>
+
+#include "c_types_map.hpp"
+#include "event.hpp"
+#include "nstl.hpp"
+#include "primitive.hpp"
+#include "scratchpad.hpp"
+
+namespace mkldnn {
+namespace impl {
+
+/** Execution plan of a lazy stream.
+ *
+ * The plan is a dependency graph of the submitted primitives, built from the
+ * memory their inputs and outputs point to, so aliasing memory primitives
+ * are handled too. Before execution the graph is optimized:
+ *  - a reorder whose output is only read by another reorder is merged with
+ *    it into a single reorder,
+ *  - an inference eltwise reading the output of an inference convolution,
+ *    or a sum adding that output in place to another tensor, is folded into
+ *    the post-ops of the convolution if the same convolution implementation
+ *    supports them. Training is left alone: the backward pass needs the
+ *    convolution output,
+ *  - primitives that do not depend on each other (e.g. the branches of an
+ *    Inception block) are executed concurrently, each on a part of the
+ *    threads, if they size their thread team at execution. The others run
+ *    one after another on all the threads.
+ *
+ * Fusion skips writing the intermediate tensors, which are therefore
+ * undefined after the execution. A tensor is considered intermediate if no
+ * other primitive in the stream reads or writes it.
+ *
+ * Primitives created by the plan are owned by it. The plan is rebuilt if
+ * the data handles of the memory changed since it was built.
+ *
+ * Setting MKLDNN_LAZY_STREAM_OPT=0 disables the optimizations: the plan then
+ * executes the primitives in the order of submission. */
+struct stream_plan_t {
+    typedef nstl::vector<primitive_t *> primitive_vector;
+
+    stream_plan_t(): nfused_(0), built_(false) {}
+    ~stream_plan_t() { clear(); }
+
+    /** builds the plan for the primitives @p prims, in submission order */
+    status_t build(const primitive_vector &prims);
+    bool built() const { return built_; }
+
+    /** the number of fusions and of levels of the built plan, see
+     * mkldnn_stream_get_plan_stats() */
+    int nfused() const { return nfused_; }
+    int nlevels() const { return (int)levels_.size(); }
+
+    /** executes the plan. Primitives created with mkldnn_scratchpad_mode_user
+     * use @p scratchpad. On an error, @p error_prim is the submitted
+     * primitive responsible for it. */
+    status_t execute(stream_scratchpad_t &scratchpad,
+            primitive_t **error_prim);
+
+private:
+    struct range_t {
+        const char *begin, *end;
+        bool overlaps(const range_t &r) const
+        { return begin < r.end && r.begin < end; }
+        bool operator==(const range_t &r) const
+        { return begin == r.begin && end == r.end; }
+    };
+
+    struct node_t {
+        primitive_t *p;
+        /* submitted primitive reported on errors */
+        primitive_t *origin;
+        bool owned;
+        bool dead;
+        int level;
+        std::vector<range_t> in, out;
+        event_t event;
+    };
+
+    void clear();
+    /* the memory read and written by @p p, false if unknown */
+    static bool data_ranges(const primitive_t *p, std::vector<range_t> &in,
+            std::vector<range_t> &out);
+    bool snapshot(std::vector<range_t> &handles) const;
+    bool reads(const node_t &n, const range_t &r) const;
+    bool writes(const node_t &n, const range_t &r) const;
+    bool touches(const node_t &n, const range_t &r) const
+    { return reads(n, r) || writes(n, r); }
+    bool touched_by_others(const range_t &r, size_t i, size_t j) const;
+    void replace(size_t i, primitive_t *p, primitive_t *origin);
+
+    bool fuse_reorders(size_t j);
+    bool fold_eltwise(size_t j);
+    bool fold_sum(size_t j);
+    bool fold_post_op(size_t i, size_t j, const range_t &dst,
+            const post_ops_t &post_ops, const range_t *accum);
+    void compute_levels();
+
+    status_t execute_node(node_t &n, char *scratchpad);
+    status_t execute_level(const std::vector<size_t> &level,
+            stream_scratchpad_t &scratchpad, primitive_t **error_prim);
+
+    primitive_vector prims_;
+    /* data handles the plan was built for */
+    std::vector<range_t> handles_;
+    std::vector<node_t> nodes_;
+    std::vector<std::vector<size_t>> levels_;
+    int nfused_;
+    bool built_;
+};
+
+}
+}
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
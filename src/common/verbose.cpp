@@ -16,7 +16,7 @@
 
 #include <stdlib.h>
 #ifndef _WIN32
-#include <sys/time.h>
+#include <time.h>
 #endif
 
 #include "mkldnn.h"
@@ -83,9 +83,9 @@ double get_msec() {
     QueryPerformanceCounter(&now);
     return 1e+3 * now.QuadPart / frequency.QuadPart;
 #else
-    struct timeval time;
-    gettimeofday(&time, NULL);
-    return 1e+3 * time.tv_sec + 1e-3 * time.tv_usec;
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return 1e+3 * time.tv_sec + 1e-6 * time.tv_nsec;
 #endif
 }
 
@@ -30,6 +30,7 @@ struct verbose_t {
 };
 
 const verbose_t *mkldnn_verbose();
+/** Returns the time in milliseconds from an arbitrary origin, monotonic */
 double get_msec();
 const char *get_isa_info();
 
@@ -0,0 +1,262 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "mkldnn.h"
+
+#include "c_types_map.hpp"
+#include "engine.hpp"
+#include "memory_pd.hpp"
+#include "primitive.hpp"
+#include "utils.hpp"
+#include "weights_file.hpp"
+
+using namespace mkldnn::impl;
+using namespace mkldnn::impl::status;
+using namespace mkldnn::impl::utils;
+
+namespace {
+
+/* File layout: the header, the table of tensors, then the data of each
+ * tensor at a page aligned offset, so that every tensor is used in place
+ * once the file is mapped. */
+const char file_magic[8] = { 'M', 'K', 'L', 'D', 'N', 'N', 'W', 'F' };
+const uint32_t file_format_version = 1;
+const size_t file_data_alignment = 4096;
+
+struct file_header_t {
+    char magic[8];
+    uint32_t format_version;
+    uint32_t md_size;
+    int32_t lib_version[3];
+    int32_t n_tensors;
+    uint64_t table_offset;
+    uint64_t reserved;
+};
+
+struct file_entry_t {
+    char name[MKLDNN_WEIGHTS_FILE_NAME_LEN];
+    uint64_t data_offset;
+    uint64_t data_size;
+    memory_desc_t md;
+};
+
+bool header_ok(const file_header_t &h, size_t file_size) {
+    return true
+        && memcmp(h.magic, file_magic, sizeof(file_magic)) == 0
+        && h.format_version == file_format_version
+        && h.md_size == sizeof(memory_desc_t)
+        && h.lib_version[0] == mkldnn_version()->major
+        && h.lib_version[1] == mkldnn_version()->minor
+        && h.lib_version[2] == mkldnn_version()->patch
+        && h.n_tensors >= 0
+        && h.table_offset % alignof(file_entry_t) == 0
+        && h.table_offset <= file_size
+        && (file_size - h.table_offset) / sizeof(file_entry_t)
+                >= (size_t)h.n_tensors;
+}
+
+bool entry_ok(const file_entry_t &e, size_t file_size) {
+    return true
+        && memchr(e.name, '\0', sizeof(e.name)) != nullptr
+        && e.data_offset % file_data_alignment == 0
+        && e.data_offset <= file_size
+        && e.data_size <= file_size - e.data_offset;
+}
+
+}
+
+mkldnn_weights_file::~mkldnn_weights_file() {
+    for (auto &t: tensors_)
+        delete t.pd;
+}
+
+status_t mkldnn_weights_file::init() {
+    file_header_t h;
+    if (file_->size() < sizeof(h)) return invalid_arguments;
+    memcpy(&h, file_->data(), sizeof(h));
+    if (!header_ok(h, file_->size())) return invalid_arguments;
+
+    const file_entry_t *table = reinterpret_cast<const file_entry_t *>(
+            file_->data() + h.table_offset);
+    tensors_.reserve(h.n_tensors);
+    for (int i = 0; i < h.n_tensors; ++i) {
+        const file_entry_t &e = table[i];
+        if (!entry_ok(e, file_->size())) return invalid_arguments;
+
+        primitive_desc_t *mpd = nullptr;
+        status_t status = mkldnn_memory_primitive_desc_create(&mpd, &e.md,
+                engine_);
+        if (status != success) return status;
+
+        tensor_t t = { e.name, static_cast<memory_pd_t *>(mpd),
+            file_->data() + e.data_offset };
+        tensors_.push_back(t);
+        if (t.pd->get_size() != e.data_size) return invalid_arguments;
+    }
+
+    return success;
+}
+
+int mkldnn_weights_file::find(const char *name) const {
+    for (int i = 0; i < count(); ++i)
+        if (strcmp(tensors_[i].name, name) == 0) return i;
+    return -1;
+}
+
+status_t mkldnn_weights_file_write(const char *path, int n,
+        const char *const *names, const const_mkldnn_primitive_t *memories) {
+    if (path == nullptr || n < 0) return invalid_arguments;
+    if (n > 0 && any_null(names, memories)) return invalid_arguments;
+
+    file_header_t h;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, file_magic, sizeof(file_magic));
+    h.format_version = file_format_version;
+    h.md_size = sizeof(memory_desc_t);
+    h.lib_version[0] = mkldnn_version()->major;
+    h.lib_version[1] = mkldnn_version()->minor;
+    h.lib_version[2] = mkldnn_version()->patch;
+    h.n_tensors = n;
+    h.table_offset = rnd_up(sizeof(h), alignof(file_entry_t));
+
+    std::vector<file_entry_t> table(n);
+    std::vector<const void *> data(n);
+    size_t offset = h.table_offset + n * sizeof(file_entry_t);
+    for (int i = 0; i < n; ++i) {
+        const primitive_t *m = memories[i];
+        if (any_null(m, names[i])) return invalid_arguments;
+        if (m->kind() != primitive_kind::memory) return invalid_arguments;
+        if (strlen(names[i]) >= MKLDNN_WEIGHTS_FILE_NAME_LEN)
+            return invalid_arguments;
+        for (int j = 0; j < i; ++j)
+            if (strcmp(names[i], names[j]) == 0) return invalid_arguments;
+
+        void *handle = nullptr;
+        status_t status = mkldnn_memory_get_data_handle(m, &handle);
+        if (status != success) return status;
+        if (handle == nullptr) return invalid_arguments;
+
+        auto mpd = static_cast<const memory_pd_t *>(m->pd());
+        file_entry_t &e = table[i];
+        memset(&e, 0, sizeof(e));
+        strncpy(e.name, names[i], sizeof(e.name) - 1);
+        offset = rnd_up(offset, file_data_alignment);
+        e.data_offset = offset;
+        e.data_size = mpd->get_size();
+        e.md = *mpd->desc();
+        data[i] = handle;
+        offset += e.data_size;
+    }
+
+    FILE *f = fopen(path, "wb");
+    if (f == nullptr) return invalid_arguments;
+
+    const std::vector<char> pad(file_data_alignment, 0);
+    bool ok = true
+        && fwrite(&h, sizeof(h), 1, f) == 1
+        && fwrite(pad.data(), 1, h.table_offset - sizeof(h), f)
+                == h.table_offset - sizeof(h)
+        && fwrite(table.data(), sizeof(file_entry_t), n, f) == (size_t)n;
+    offset = h.table_offset + n * sizeof(file_entry_t);
+    for (int i = 0; i < n && ok; ++i) {
+        const size_t pad_size = table[i].data_offset - offset;
+        ok = fwrite(pad.data(), 1, pad_size, f) == pad_size
+            && fwrite(data[i], 1, table[i].data_size, f)
+                    == table[i].data_size;
+        offset = table[i].data_offset + table[i].data_size;
+    }
+    ok = fclose(f) == 0 && ok;
+    return ok ? success : runtime_error;
+}
+
+status_t mkldnn_weights_file_open(weights_file_t **file, engine_t *engine,
+        const char *path, unsigned flags) {
+    using namespace weights_file_flags;
+    if (any_null(file, engine, path)) return invalid_arguments;
+    if (flags & ~(unsigned)(populate | hugepages | numa_interleave))
+        return invalid_arguments;
+
+    std::shared_ptr<mapped_file_t> mapping;
+    status_t status = mapped_file_t::map(mapping, path, flags);
+    if (status != success) return status;
+
+    auto f = new weights_file_t(engine, mapping);
+    if (f == nullptr) return out_of_memory;
+    status = f->init();
+    if (status != success) {
+        delete f;
+        return status;
+    }
+    *file = f;
+    return success;
+}
+
+status_t mkldnn_weights_file_get_count(const weights_file_t *file,
+        int *count) {
+    if (any_null(file, count)) return invalid_arguments;
+    *count = file->count();
+    return success;
+}
+
+status_t mkldnn_weights_file_query(const weights_file_t *file, int index,
+        const char **name, const primitive_desc_t **memory_pd) {
+    if (file == nullptr || index < 0 || index >= file->count())
+        return invalid_arguments;
+    if (name) *name = file->name(index);
+    if (memory_pd) *memory_pd = file->pd(index);
+    return success;
+}
+
+status_t mkldnn_weights_file_find(const weights_file_t *file,
+        const char *name, int *index) {
+    if (any_null(file, name, index)) return invalid_arguments;
+    *index = file->find(name);
+    return *index < 0 ? invalid_arguments : success;
+}
+
+status_t mkldnn_weights_file_create_memory(primitive_t **memory,
+        const weights_file_t *file, int index) {
+    if (any_null(memory, file) || index < 0 || index >= file->count())
+        return invalid_arguments;
+
+    primitive_t *mem = nullptr;
+    status_t status = mkldnn_primitive_create(&mem, file->pd(index),
+            nullptr, nullptr);
+    if (status != success) return status;
+
+    /* the mapping is read-only; the data was written from padded memory, so
+     * it is bound without zeroing */
+    status = mem->set_data_handle(const_cast<void *>(file->data(index)),
+            false);
+    if (status != success) {
+        mkldnn_primitive_destroy(mem);
+        return status;
+    }
+    *memory = mem;
+    return success;
+}
+
+status_t mkldnn_weights_file_close(weights_file_t *file) {
+    delete file;
+    return success;
+}
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -0,0 +1,70 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+
+#ifndef WEIGHTS_FILE_HPP
+#define WEIGHTS_FILE_HPP
+
+#include <memory>
+#include <vector>
+
+#include "mkldnn.h"
+
+#include "c_types_map.hpp"
+#include "mapped_file.hpp"
+#include "memory_pd.hpp"
+#include "utils.hpp"
+
+/** A mapped weights file. Each tensor is described by a memory primitive
+ * descriptor created for the engine the file was opened for, and its data
+ * points straight into the mapping. */
+struct mkldnn_weights_file: public mkldnn::impl::c_compatible {
+    mkldnn_weights_file(mkldnn::impl::engine_t *engine,
+            const std::shared_ptr<mkldnn::impl::mapped_file_t> &file)
+        : engine_(engine), file_(file) {}
+    ~mkldnn_weights_file();
+
+    /** Validates the header and the table of the mapped file and creates
+     * the memory primitive descriptors. */
+    mkldnn::impl::status_t init();
+
+    int count() const { return (int)tensors_.size(); }
+    const char *name(int index) const { return tensors_[index].name; }
+    const mkldnn::impl::memory_pd_t *pd(int index) const
+    { return tensors_[index].pd; }
+    const void *data(int index) const { return tensors_[index].data; }
+
+    /** Returns the index of the tensor @p name, or -1. */
+    int find(const char *name) const;
+
+private:
+    struct tensor_t {
+        const char *name;
+        mkldnn::impl::memory_pd_t *pd;
+        const void *data;
+    };
+
+    mkldnn::impl::engine_t *engine_;
+    std::shared_ptr<mkldnn::impl::mapped_file_t> file_;
+    std::vector<tensor_t> tensors_;
+
+    mkldnn_weights_file(const mkldnn_weights_file &) = delete;
+    mkldnn_weights_file &operator=(const mkldnn_weights_file &) = delete;
+};
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -21,6 +21,7 @@ namespace impl {
 namespace cpu {
 namespace bf16_cvt_utils {
 
+#ifndef __ARM_ARCH
 jit_avx512_core_cvt_ps_to_bf16_t &cvt_one_ps_to_bf16() {
     static jit_avx512_core_cvt_ps_to_bf16_t singleton(1);
     return singleton;
@@ -40,6 +41,7 @@ jit_avx512_core_add_cvt_ps_to_bf16_t &add_cvt_ps_to_bf16_() {
     static jit_avx512_core_add_cvt_ps_to_bf16_t singleton;
     return singleton;
 }
+#endif // #ifndef __ARM_ARCH
 
 }
 }
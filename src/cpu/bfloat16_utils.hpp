@@ -17,6 +17,7 @@
 #ifndef BFLOAT16_UTILS_HPP
 #define BFLOAT16_UTILS_HPP
 
+#include "mkldnn_thread.hpp"
 #include "nstl.hpp"
 #include "jit_avx512_core_bf16cvt.hpp"
 
@@ -27,9 +28,63 @@ namespace bf16_cvt_utils {
 
 union f32_bf16_t {
     float vfloat;
+    uint32_t vraw;
     mkldnn_bfloat16_t vbfloat[2];
 };
 
+#ifdef __ARM_ARCH
+/* AArch64: there are no conversion kernels, the conversions are done in
+ * plain C++. Rounding is to nearest even and NaNs stay quiet NaNs, matching
+ * vcvtneps2bf16. The loops are branch-free so that the array versions are
+ * vectorized for NEON/SVE by the compiler. */
+inline mkldnn_bfloat16_t cvt_float_to_bfloat16(float inp) {
+    f32_bf16_t cvt = {0};
+    cvt.vfloat = inp;
+    const uint32_t u = cvt.vraw;
+    const uint32_t rne = (u + 0x7fffu + ((u >> 16) & 1u)) >> 16;
+    const uint32_t qnan = (u >> 16) | 0x40u;
+    return (mkldnn_bfloat16_t)((u & 0x7fffffffu) > 0x7f800000u ? qnan : rne);
+}
+
+inline void cvt_float_to_bfloat16(mkldnn_bfloat16_t *out, const float *inp) {
+    *out = cvt_float_to_bfloat16(*inp);
+}
+
+inline void cvt_float_to_bfloat16(mkldnn_bfloat16_t *out, const float *inp,
+        size_t size) {
+    PRAGMA_OMP_SIMD()
+    for (size_t i = 0; i < size; i++)
+        out[i] = cvt_float_to_bfloat16(inp[i]);
+}
+
+inline float cvt_bfloat16_to_float(mkldnn_bfloat16_t inp) {
+    f32_bf16_t cvt = {0};
+    cvt.vbfloat[1] = inp;
+    return cvt.vfloat;
+}
+
+inline void cvt_bfloat16_to_float(float *out, const mkldnn_bfloat16_t *inp) {
+    *out = cvt_bfloat16_to_float(*inp);
+}
+
+inline void cvt_bfloat16_to_float(float *out, const mkldnn_bfloat16_t *inp,
+        size_t size) {
+    PRAGMA_OMP_SIMD()
+    for (size_t i = 0; i < size; i++)
+        out[i] = cvt_bfloat16_to_float(inp[i]);
+}
+
+// performs element-by-element sum of inp and add float arrays and stores
+// result to bfloat16 out array with downconversion
+inline void add_floats_and_cvt_to_bfloat16(mkldnn_bfloat16_t *out,
+        const float *inp0,
+        const float *inp1,
+        size_t size) {
+    PRAGMA_OMP_SIMD()
+    for (size_t i = 0; i < size; i++)
+        out[i] = cvt_float_to_bfloat16(inp0[i] + inp1[i]);
+}
+#else
 jit_avx512_core_cvt_ps_to_bf16_t &cvt_one_ps_to_bf16();
 jit_avx512_core_cvt_ps_to_bf16_t &cvt_ps_to_bf16_();
 jit_avx512_core_cvt_bf16_to_ps_t &cvt_bf16_to_ps_();
@@ -102,6 +157,8 @@ inline void add_floats_and_cvt_to_bfloat16(mkldnn_bfloat16_t *out,
     add_cvt_ps_to_bf16_().jit_ker(&p_);
 }
 
+#endif // #ifdef __ARM_ARCH
+
 inline mkldnn_bfloat16_t approx_bfloat16_lowest() {
     /* jit fails to convert FLT_MIN to bfloat16.
      * It converst FLT_MIN to -INF. Truncate FLT_MIN
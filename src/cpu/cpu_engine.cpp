@@ -34,6 +34,7 @@
 
 #include "cpu_engine.hpp"
 #include "cpu_memory.hpp"
+#include "profiler.hpp"
 #include "type_helpers.hpp"
 #include "verbose.hpp"
 
@@ -45,7 +46,12 @@
 #ifdef __ARM_ARCH
 
 #include "cpu/jit_sve_1x1_convolution.hpp"
+#include "cpu/jit_sve_batch_normalization.hpp"
 #include "cpu/jit_sve_convolution.hpp"
+#include "cpu/jit_sve_convolution_winograd.hpp"
+#include "cpu/jit_sve_eltwise.hpp"
+#include "cpu/jit_sve_pooling.hpp"
+#include "cpu/jit_sve_x8s8s32x_convolution.hpp"
 
 #else
 
@@ -169,9 +175,15 @@ static const pd_create_f cpu_impl_list[] = {
     INSTANCE(jit_avx2_convolution_bwd_weights_t),
     INSTANCE(jit_sse42_convolution_fwd_t),
 #else //#ifndef __ARM_ARCH
+    INSTANCE(jit_sve_dw_convolution_fwd_t),
+    INSTANCE(jit_sve_dw_convolution_bwd_data_t),
+    INSTANCE(jit_sve_dw_convolution_bwd_weights_t),
     INSTANCE(jit_sve_1x1_convolution_fwd_f32_t),
     INSTANCE(jit_sve_1x1_convolution_bwd_data_f32_t),
     INSTANCE(jit_sve_1x1_convolution_bwd_weights_t),
+    INSTANCE(jit_sve_convolution_winograd_fwd_t),
+    INSTANCE(jit_sve_convolution_winograd_bwd_data_t),
+    INSTANCE(jit_sve_convolution_winograd_bwd_weights_t),
     INSTANCE(jit_sve_convolution_fwd_t<f32>),
     INSTANCE(jit_sve_convolution_bwd_data_t<f32>),
     INSTANCE(jit_sve_convolution_bwd_weights_t<f32>),
@@ -202,12 +214,14 @@ static const pd_create_f cpu_impl_list[] = {
     INSTANCE(jit_avx512_core_bf16_convolution_bwd_data_t<bf16>),
     INSTANCE(jit_avx512_core_bf16_convolution_bwd_weights_t<bf16>),
     INSTANCE(jit_avx512_core_bf16_convolution_bwd_weights_t<f32>),
+#endif //#ifndef __ARM_ARCH
     INSTANCE(gemm_bf16_convolution_fwd_t<f32>),
     INSTANCE(gemm_bf16_convolution_fwd_t<bf16>),
     INSTANCE(gemm_bf16_convolution_bwd_data_t<f32>),
     INSTANCE(gemm_bf16_convolution_bwd_data_t<bf16>),
     INSTANCE(gemm_bf16_convolution_bwd_weights_t<f32>),
     INSTANCE(gemm_bf16_convolution_bwd_weights_t<bf16>),
+#ifndef __ARM_ARCH
     /* conv (int) */
     INSTANCE(jit_avx512_core_u8s8s32x_wino_convolution_fwd_t<f32>),
     INSTANCE(jit_avx512_core_u8s8s32x_wino_convolution_fwd_t<s32>),
@@ -244,6 +258,24 @@ static const pd_create_f cpu_impl_list[] = {
     INSTANCE(_gemm_u8s8s32x_convolution_bwd_data_t<u8>),
     INSTANCE(_gemm_u8s8s32x_convolution_bwd_data_t<s8>),
     INSTANCE(_gemm_u8s8s32x_convolution_bwd_data_t<f32>),
+#else //#ifndef __ARM_ARCH
+    /* conv (int) */
+    INSTANCE(jit_sve_x8s8s32x_convolution_fwd_t<u8,f32>),
+    INSTANCE(jit_sve_x8s8s32x_convolution_fwd_t<u8,s32>),
+    INSTANCE(jit_sve_x8s8s32x_convolution_fwd_t<u8,u8>),
+    INSTANCE(jit_sve_x8s8s32x_convolution_fwd_t<u8,s8>),
+    INSTANCE(jit_sve_x8s8s32x_convolution_fwd_t<s8,f32>),
+    INSTANCE(jit_sve_x8s8s32x_convolution_fwd_t<s8,s32>),
+    INSTANCE(jit_sve_x8s8s32x_convolution_fwd_t<s8,u8>),
+    INSTANCE(jit_sve_x8s8s32x_convolution_fwd_t<s8,s8>),
+    INSTANCE(_gemm_x8s8s32x_convolution_fwd_t<u8, s32>),
+    INSTANCE(_gemm_x8s8s32x_convolution_fwd_t<u8, u8>),
+    INSTANCE(_gemm_x8s8s32x_convolution_fwd_t<u8, s8>),
+    INSTANCE(_gemm_x8s8s32x_convolution_fwd_t<u8, f32>),
+    INSTANCE(_gemm_x8s8s32x_convolution_fwd_t<s8, s32>),
+    INSTANCE(_gemm_x8s8s32x_convolution_fwd_t<s8, u8>),
+    INSTANCE(_gemm_x8s8s32x_convolution_fwd_t<s8, s8>),
+    INSTANCE(_gemm_x8s8s32x_convolution_fwd_t<s8, f32>),
 #endif //#ifndef __ARM_ARCH
     INSTANCE(ref_convolution_fwd_t<s16, s16, s32, s32>),
     INSTANCE(ref_convolution_fwd_t<u8, s8, f32, s32>),
@@ -283,6 +315,9 @@ static const pd_create_f cpu_impl_list[] = {
     INSTANCE(ref_shuffle_t<2>), /* bf16 */
     INSTANCE(ref_shuffle_t<1>), /* s8 or u8 */
     /* eltwise */
+#ifdef __ARM_ARCH
+    INSTANCE(jit_sve_eltwise_fwd_t),
+#endif //#ifdef __ARM_ARCH
     INSTANCE(jit_uni_eltwise_fwd_t<avx512_common, f32>),
 #ifndef __ARM_ARCH
     INSTANCE(jit_uni_eltwise_fwd_t<avx512_common, bf16>),
@@ -317,23 +352,23 @@ static const pd_create_f cpu_impl_list[] = {
     INSTANCE(jit_uni_pooling_fwd_t<avx512_common, bf16>),
     INSTANCE(jit_uni_pooling_bwd_t<avx512_common, bf16>),
 #endif //#ifndef __ARM_ARCH
+#ifdef __ARM_ARCH
+    INSTANCE(jit_sve_pooling_fwd_t),
+    INSTANCE(jit_sve_pooling_bwd_t),
+#endif //#ifdef __ARM_ARCH
     INSTANCE(jit_uni_pooling_fwd_t<avx512_common, f32>),
     INSTANCE(jit_uni_pooling_bwd_t<avx512_common, f32>),
     INSTANCE(jit_uni_pooling_fwd_t<avx, f32>),
     INSTANCE(jit_uni_pooling_bwd_t<avx, f32>),
     INSTANCE(jit_uni_pooling_fwd_t<sse42, f32>),
     INSTANCE(jit_uni_pooling_bwd_t<sse42, f32>),
-#ifndef __ARM_ARCH
     INSTANCE(nchw_pooling_fwd_t<bf16>),
     INSTANCE(nchw_pooling_bwd_t<bf16>),
-#endif //#ifndef __ARM_ARCH
     INSTANCE(nchw_pooling_fwd_t<f32>),
     INSTANCE(nchw_pooling_bwd_t<f32>),
 
-#ifndef __ARM_ARCH
     INSTANCE(nhwc_pooling_fwd_t<bf16>),
     INSTANCE(nhwc_pooling_bwd_t<bf16>),
-#endif //#ifndef __ARM_ARCH
     INSTANCE(nhwc_pooling_fwd_t<f32>),
     INSTANCE(nhwc_pooling_bwd_t<f32>),
 
@@ -369,6 +404,10 @@ static const pd_create_f cpu_impl_list[] = {
     INSTANCE(ref_lrn_fwd_t<bf16>),
     INSTANCE(ref_lrn_bwd_t<bf16>),
     /* batch normalization */
+#ifdef __ARM_ARCH
+    INSTANCE(jit_sve_batch_normalization_fwd_t),
+    INSTANCE(jit_sve_batch_normalization_bwd_t),
+#endif //#ifdef __ARM_ARCH
     INSTANCE(jit_uni_batch_normalization_fwd_t<avx512_common, f32>),
     INSTANCE(jit_uni_batch_normalization_bwd_t<avx512_common, f32>),
 #ifndef __ARM_ARCH
@@ -381,21 +420,17 @@ static const pd_create_f cpu_impl_list[] = {
     INSTANCE(jit_uni_batch_normalization_bwd_t<sse42, f32>),
     INSTANCE(ncsp_batch_normalization_fwd_t<f32>),
     INSTANCE(ncsp_batch_normalization_bwd_t<f32>),
-#ifndef __ARM_ARCH
     INSTANCE(ncsp_batch_normalization_fwd_t<bf16>),
     INSTANCE(ncsp_batch_normalization_bwd_t<bf16>),
-#endif //#ifndef __ARM_ARCH
     INSTANCE(nspc_batch_normalization_fwd_t<f32>),
     INSTANCE(nspc_batch_normalization_bwd_t<f32>),
-#ifndef __ARM_ARCH
     INSTANCE(nspc_batch_normalization_fwd_t<bf16>),
     INSTANCE(nspc_batch_normalization_bwd_t<bf16>),
-#endif //#ifndef __ARM_ARCH
     INSTANCE(ref_batch_normalization_fwd_t<f32>),
     INSTANCE(ref_batch_normalization_bwd_t<f32>),
-#ifndef __ARM_ARCH
     INSTANCE(ref_batch_normalization_fwd_t<bf16>),
     INSTANCE(ref_batch_normalization_bwd_t<bf16>),
+#ifndef __ARM_ARCH
     /* batch normalization (int) */
     INSTANCE(jit_uni_batch_normalization_s8_fwd_t<avx512_core>),
     INSTANCE(jit_uni_batch_normalization_s8_fwd_t<avx2>),
@@ -408,7 +443,6 @@ static const pd_create_f cpu_impl_list[] = {
     INSTANCE(ref_inner_product_fwd_t<f32>),
     INSTANCE(ref_inner_product_bwd_data_t<f32, f32, f32, f32>),
     INSTANCE(ref_inner_product_bwd_weights_t<f32>),
-#ifndef __ARM_ARCH
     /* inner product (bfloat16) */
     INSTANCE(gemm_bf16_inner_product_fwd_t<f32>),
     INSTANCE(gemm_bf16_inner_product_fwd_t<bf16>),
@@ -425,7 +459,6 @@ static const pd_create_f cpu_impl_list[] = {
     INSTANCE(gemm_x8s8s32x_inner_product_fwd_t<s8, s8>),
     INSTANCE(gemm_x8s8s32x_inner_product_fwd_t<s8, s32>),
     INSTANCE(gemm_x8s8s32x_inner_product_fwd_t<s8, f32>),
-#endif //#ifndef __ARM_ARCH
     INSTANCE(ref_inner_product_fwd_t<u8, s8, u8, s32>),
     INSTANCE(ref_inner_product_fwd_t<u8, s8, s8, s32>),
     INSTANCE(ref_inner_product_fwd_t<u8, s8, s32, s32>),
@@ -472,17 +505,24 @@ status_t cpu_engine_t::submit(primitive_t *p, event_t *e,
         if(param != NULL){
             num_loops = atoi(param) > 0 ? atoi(param) : 1;
         }
-        double ms = get_msec();
+        const double start_ms = get_msec();
         for(int i = 0; i < num_loops; i++){
             p->execute(e);
         }
-        ms = (get_msec() - ms) / num_loops;
+        double ms = (get_msec() - start_ms) / num_loops;
+        if (profiler().enabled())
+            profiler().record(profiling_event::execute, p->pd(), start_ms, ms);
         if(num_loops == 1){
             printf("mkldnn_verbose,exec,%s,%g,\n", p->pd()->info(), ms);
         }else{
             printf("mkldnn_verbose,exec,%s,%g, <- ave. of %d times\n", p->pd()->info(), ms, num_loops);
         }
         fflush(0);
+    } else if (profiler().enabled()) {
+        const double start_ms = get_msec();
+        p->execute(e);
+        profiler().record(profiling_event::execute, p->pd(), start_ms,
+                get_msec() - start_ms);
     } else {
         p->execute(e);
     }
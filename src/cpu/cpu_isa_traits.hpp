@@ -185,6 +185,16 @@ inline bool isa_has_bf16(cpu_isa_t isa) {
     return isa == avx512_core_bf16;
 }
 
+/* bf16 <-> f32 conversions (bf16_cvt_utils) are JIT-ed on avx512_core and
+ * done in portable code on AArch64 */
+inline bool mayiuse_bf16_cvt() {
+#ifdef __ARM_ARCH
+    return true;
+#else
+    return mayiuse(avx512_core);
+#endif
+}
+
 }
 
 /* whatever is required to generate string literals... */
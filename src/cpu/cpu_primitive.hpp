@@ -19,6 +19,7 @@
 
 #include "mkldnn.h"
 
+#include "arena.hpp"
 #include "c_types_map.hpp"
 #include "event.hpp"
 #include "memory_tracking.hpp"
@@ -38,15 +39,20 @@ struct cpu_primitive_t: public primitive_t {
         , global_scratchpad_(nullptr)
     {
         size_t scratchpad_size = this->pd()->scratchpad_registry().size();
+        if (use_stream_scratchpad())
+            return; /* provided by the stream at execution time */
         if (use_global_scratchpad)
             global_scratchpad_ = create_scratchpad(scratchpad_size);
-        else
-            scratchpad_buffer_ = malloc(scratchpad_size, 64);
+        else {
+            scratchpad_buffer_
+                = scratchpad_arena().allocate(scratchpad_size, 64);
+            this->pd()->scratchpad_registry().first_touch(scratchpad_buffer_);
+        }
     }
 
     virtual ~cpu_primitive_t() {
         delete global_scratchpad_;
-        free(scratchpad_buffer_);
+        scratchpad_arena().deallocate(scratchpad_buffer_);
     }
 
     virtual char *memory(size_t output_index = 0) const {
@@ -72,8 +78,15 @@ struct cpu_primitive_t: public primitive_t {
 
     const cpu_memory_t *output_memory_primitive(size_t index = 0) const;
 
+    /* the global scratchpad belongs to the thread that created the
+     * primitive */
+    virtual bool concurrent_safe() const override
+    { return global_scratchpad_ == nullptr; }
+
 protected:
     memory_tracking::grantor_t scratchpad() const {
+        if (use_stream_scratchpad())
+            return pd()->scratchpad_registry().grantor(stream_scratchpad_);
         return pd()->scratchpad_registry().grantor(global_scratchpad_
                 ? global_scratchpad_->get() : scratchpad_buffer_);
     }
@@ -35,9 +35,9 @@ static const spd_create_f cpu_sum_impl_list[] = {
 #ifndef __ARM_ARCH
     INSTANCE(jit_bf16_sum_t<data_type::bf16, data_type::bf16>),
     INSTANCE(jit_bf16_sum_t<data_type::bf16, data_type::f32>),
+#endif //#ifdef __ARM_ARCH
     INSTANCE(simple_sum_t<data_type::bf16, data_type::bf16>),
     INSTANCE(simple_sum_t<data_type::bf16, data_type::f32>),
-#endif //#ifdef __ARM_ARCH
     INSTANCE(simple_sum_t<data_type::f32, data_type::f32>),
     INSTANCE(ref_sum_t),
     nullptr,
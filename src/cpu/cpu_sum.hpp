@@ -76,6 +76,7 @@ struct cpu_sum_pd_t: public sum_pd_t {
     { return index < this->n_ ? &src_pds_[index] : nullptr; }
     virtual const cpu_memory_t::pd_t *dst_pd(int index = 0) const override
     { return index == 0 ? &dst_pd_ : nullptr; }
+    virtual const float *scales() const override { return &scales_[0]; }
 
     nstl::vector<float> scales_;
 protected:
@@ -0,0 +1,243 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <ctype.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#if !defined(_WIN32)
+#include <unistd.h>
+#endif
+
+#include "mkldnn_thread.hpp"
+#include "nstl.hpp"
+#include "utils.hpp"
+
+#include "cpu_isa_traits.hpp"
+#include "cpu_topology.hpp"
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+namespace {
+
+/* Parses "64K", "8M", "1G" or plain bytes. Returns 0 on error. */
+unsigned long long parse_size(const char *str, const char **end) {
+    char *e = nullptr;
+    unsigned long long v = strtoull(str, &e, 10);
+    if (e == str) return 0;
+    switch (toupper(*e)) {
+    case 'K': v <<= 10; e++; break;
+    case 'M': v <<= 20; e++; break;
+    case 'G': v <<= 30; e++; break;
+    default: break;
+    }
+    if (end) *end = e;
+    return v;
+}
+
+/* Counts cpus in a list such as "0-11,24-35" or "0,48". */
+int count_cpu_list(const char *str) {
+    int count = 0;
+    const char *p = str;
+    while (*p && *p != '\n') {
+        char *e = nullptr;
+        long first = strtol(p, &e, 10);
+        if (e == p) break;
+        long last = first;
+        p = e;
+        if (*p == '-') {
+            last = strtol(p + 1, &e, 10);
+            p = e;
+        }
+        count += (int)(last - first + 1);
+        if (*p == ',') p++;
+    }
+    return count;
+}
+
+bool init_from_env(cpu_topology_t &t) {
+    const int len = 128;
+    char env[len] = {0};
+    if (mkldnn_getenv("MKLDNN_CPU_CACHES", env, len) <= 0)
+        return false;
+
+    int levels = 0;
+    const char *p = env;
+    while (*p && levels < cpu_topology_t::max_cache_levels) {
+        const char *e = p;
+        unsigned long long size = parse_size(p, &e);
+        if (size == 0 || size > UINT_MAX) return false;
+        int sharing = 1;
+        if (*e == ':') {
+            sharing = atoi(e + 1);
+            if (sharing <= 0) return false;
+            e++;
+            while (isdigit(*e)) e++;
+        }
+        t.cache[levels].size = (unsigned int)size;
+        t.cache[levels].sharing = sharing;
+        levels++;
+        if (*e != ',') break;
+        p = e + 1;
+    }
+    t.ncache_levels = levels;
+    t.source = "env";
+    return levels > 0;
+}
+
+#if defined(__linux__)
+bool read_sysfs(const char *path, char *buf, int len) {
+    FILE *f = fopen(path, "r");
+    if (!f) return false;
+    bool ok = fgets(buf, len, f) != nullptr;
+    fclose(f);
+    return ok;
+}
+
+bool init_from_sysfs(cpu_topology_t &t) {
+    const int len = 256;
+    char path[len], buf[len];
+
+    int levels = 0;
+    for (int idx = 0; idx < 16; idx++) {
+        const char *base = "/sys/devices/system/cpu/cpu0/cache/index";
+        snprintf(path, len, "%s%d/type", base, idx);
+        if (!read_sysfs(path, buf, len)) break;
+        if (strncmp(buf, "Instruction", 11) == 0) continue;
+
+        snprintf(path, len, "%s%d/level", base, idx);
+        if (!read_sysfs(path, buf, len)) continue;
+        int level = atoi(buf);
+        if (level < 1 || level > cpu_topology_t::max_cache_levels) continue;
+
+        snprintf(path, len, "%s%d/size", base, idx);
+        if (!read_sysfs(path, buf, len)) continue;
+        unsigned long long size = parse_size(buf, nullptr);
+        if (size == 0 || size > UINT_MAX) continue;
+
+        int sharing = 1;
+        snprintf(path, len, "%s%d/shared_cpu_list", base, idx);
+        if (read_sysfs(path, buf, len))
+            sharing = nstl::max(1, count_cpu_list(buf));
+
+        t.cache[level - 1].size = (unsigned int)size;
+        t.cache[level - 1].sharing = sharing;
+        levels = nstl::max(levels, level);
+    }
+
+    // Levels are reported as a contiguous prefix only.
+    for (int l = 0; l < levels; l++)
+        if (t.cache[l].size == 0) { levels = l; break; }
+
+    t.ncache_levels = levels;
+    t.source = "sysfs";
+    return levels > 0;
+}
+
+int numa_nodes_from_sysfs() {
+    const int len = 256;
+    char buf[len];
+    if (!read_sysfs("/sys/devices/system/node/online", buf, len))
+        return 1;
+    return nstl::max(1, count_cpu_list(buf));
+}
+#endif
+
+bool init_from_cpuid(cpu_topology_t &t) {
+    int levels = nstl::min((int)cpu.getDataCacheLevels(),
+            (int)cpu_topology_t::max_cache_levels);
+    for (int l = 0; l < levels; l++) {
+        t.cache[l].size = cpu.getDataCacheSize(l);
+        t.cache[l].sharing = nstl::max(1, (int)cpu.getCoresSharingDataCache(l));
+    }
+    t.ncache_levels = levels;
+    t.source = "cpuid";
+    return levels > 0;
+}
+
+void init_default(cpu_topology_t &t) {
+#ifdef __ARM_ARCH
+    // A64FX: 64KiB of L1 per core, 8MiB of L2 per CMG of 12 cores.
+    t.ncache_levels = 2;
+    t.cache[0] = {65536, 1};
+    t.cache[1] = {8388608, 12};
+#else
+    // 32KB of L1, 512KB of L2 and 1MB of L3 per core.
+    t.ncache_levels = 3;
+    t.cache[0] = {32000, 1};
+    t.cache[1] = {512000, 1};
+    t.cache[2] = {1024000, 1};
+#endif
+    t.source = "default";
+}
+
+cpu_topology_t detect_topology() {
+    cpu_topology_t t;
+    t.ncores = 1;
+    t.ncache_levels = 0;
+    for (int l = 0; l < cpu_topology_t::max_cache_levels; l++)
+        t.cache[l] = {0, 1};
+    t.nnuma_nodes = 1;
+    t.source = "default";
+
+#if !defined(_WIN32)
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    if (n > 0) t.ncores = (int)n;
+#endif
+    t.ncores = nstl::max(t.ncores, mkldnn_get_max_threads());
+
+    bool ok = init_from_env(t);
+#if defined(__linux__)
+    if (!ok) ok = init_from_sysfs(t);
+    t.nnuma_nodes = numa_nodes_from_sysfs();
+#endif
+    if (!ok) ok = init_from_cpuid(t);
+    if (!ok) init_default(t);
+
+    for (int l = 0; l < t.ncache_levels; l++)
+        t.cache[l].sharing = nstl::min(t.cache[l].sharing, t.ncores);
+
+    return t;
+}
+
+}
+
+const cpu_topology_t &get_cpu_topology() {
+    static const cpu_topology_t topology = detect_topology();
+    return topology;
+}
+
+unsigned int get_data_cache_size(int level, bool per_core, int nthreads) {
+    const cpu_topology_t &t = get_cpu_topology();
+    if (level < 1 || level > t.ncache_levels) return 0;
+
+    const cpu_topology_t::cache_t &c = t.cache[level - 1];
+
+    if (per_core) return c.size / c.sharing;
+
+    const int ninstances = utils::div_up(t.ncores, c.sharing);
+    const int nused = utils::div_up(nstl::max(nthreads, 1), c.sharing);
+    const unsigned long long size
+            = (unsigned long long)c.size * nstl::min(nused, ninstances);
+    return (unsigned int)nstl::min(size, (unsigned long long)UINT_MAX);
+}
+
+}
+}
+}
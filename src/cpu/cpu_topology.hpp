@@ -0,0 +1,65 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_TOPOLOGY_HPP
+#define CPU_TOPOLOGY_HPP
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+/** Data cache hierarchy and core grouping of the host.
+ *
+ * The topology is detected once per process. Sources, by priority:
+ *  - MKLDNN_CPU_CACHES environment variable: a comma separated list of
+ *    <size>[:<cores sharing>] entries, one per data cache level starting
+ *    from L1. Sizes accept K, M and G suffixes, e.g. "64K:1,8M:12" describes
+ *    A64FX (64KiB private L1, 8MiB L2 shared by the 12 cores of a CMG);
+ *  - Linux sysfs (/sys/devices/system/cpu/cpu0/cache, /sys/devices/system/node);
+ *  - cpuid, through Xbyak;
+ *  - built-in defaults. */
+struct cpu_topology_t {
+    enum { max_cache_levels = 4 };
+
+    struct cache_t {
+        unsigned int size; // bytes in one cache instance
+        int sharing; // logical cores sharing the instance
+    };
+
+    int ncores;
+    int ncache_levels;
+    cache_t cache[max_cache_levels]; // data or unified caches, L1 first
+    int nnuma_nodes;
+    const char *source; // "env", "sysfs", "cpuid" or "default"
+};
+
+const cpu_topology_t &get_cpu_topology();
+
+/** Returns the size in bytes of the data cache at @p level (1-based), 0 if
+ * there is no such level (e.g. L3 on A64FX).
+ *
+ * With @p per_core the share of a single core is returned. Otherwise the
+ * capacity available to @p nthreads cores is returned: each instance is
+ * counted once per group of cores sharing it, e.g. 2 x 8MiB for 13 to 24
+ * threads on A64FX. With the default of one thread that is the size of a
+ * single instance. */
+unsigned int get_data_cache_size(int level, bool per_core, int nthreads = 1);
+
+}
+}
+}
+
+#endif
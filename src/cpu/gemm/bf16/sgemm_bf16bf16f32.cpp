@@ -0,0 +1,106 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "sgemm_bf16bf16f32.hpp"
+
+#include "bfloat16_utils.hpp"
+#include "gemm.hpp"
+#include "jit_generator.hpp"
+#include "mkldnn_thread.hpp"
+#include "nstl.hpp"
+#include "utils.hpp"
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+namespace {
+
+/* Bounds the f32 copies of A and B to (M + N) * blk_k floats. */
+const int blk_k = 1024;
+
+/* Widens a rows x cols column-major bf16 matrix to a dense f32 one. */
+void cvt_slice(float *out, const mkldnn_bfloat16_t *in, int rows, int cols,
+        int ld) {
+    parallel(mkldnn_in_parallel() ? 1 : 0, [&](int ithr, int nthr) {
+        int start = 0, end = 0;
+        balance211(cols, nthr, ithr, start, end);
+        for (int j = start; j < end; j++)
+            bf16_cvt_utils::cvt_bfloat16_to_float(out + (size_t)j * rows,
+                    in + (size_t)j * ld, rows);
+    });
+}
+
+}
+
+mkldnn_status_t sgemm_bf16bf16f32(const char *transa, const char *transb,
+        const int *M, const int *N, const int *K, const float *alpha,
+        const mkldnn_bfloat16_t *A, const int *lda,
+        const mkldnn_bfloat16_t *B, const int *ldb, const float *beta,
+        float *C, const int *ldc) {
+    const bool tr_a = utils::one_of(*transa, 'T', 't');
+    const bool tr_b = utils::one_of(*transb, 'T', 't');
+    const int m = *M, n = *N, k = *K;
+
+    if (m == 0 || n == 0)
+        return mkldnn_success;
+    if (k == 0) {
+        parallel_nd(n, [&](int j) {
+            float *c = C + (size_t)j * *ldc;
+            for (int i = 0; i < m; i++)
+                c[i] = *beta == 0.f ? 0.f : *beta * c[i];
+        });
+        return mkldnn_success;
+    }
+
+    const int kb_max = nstl::min(k, blk_k);
+    float *a = (float *)malloc(sizeof(float) * m * kb_max, PAGE_4K);
+    float *b = (float *)malloc(sizeof(float) * n * kb_max, PAGE_4K);
+    if (utils::any_null(a, b)) {
+        free(a);
+        free(b);
+        return mkldnn_out_of_memory;
+    }
+
+    mkldnn_status_t status = mkldnn_success;
+    for (int k0 = 0; k0 < k && status == mkldnn_success; k0 += blk_k) {
+        const int kb = nstl::min(k - k0, blk_k);
+        const float beta_k = k0 == 0 ? *beta : 1.f;
+
+        // A is m x k (or k x m if transposed), B is k x n (or n x k)
+        if (tr_a)
+            cvt_slice(a, A + k0, kb, m, *lda);
+        else
+            cvt_slice(a, A + (size_t)k0 * *lda, m, kb, *lda);
+        if (tr_b)
+            cvt_slice(b, B + (size_t)k0 * *ldb, n, kb, *ldb);
+        else
+            cvt_slice(b, B + k0, kb, n, *ldb);
+
+        const int lda_f32 = tr_a ? kb : m;
+        const int ldb_f32 = tr_b ? n : kb;
+        status = extended_sgemm(transa, transb, M, N, &kb, alpha, a, &lda_f32,
+                b, &ldb_f32, &beta_k, C, ldc);
+    }
+
+    free(a);
+    free(b);
+    return status;
+}
+
+}
+}
+}
@@ -0,0 +1,41 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef SGEMM_BF16BF16F32_HPP
+#define SGEMM_BF16BF16F32_HPP
+
+#include "mkldnn_types.h"
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+/* gemm_bf16bf16f32 on top of extended_sgemm.
+ *
+ * A and B are widened to f32 slices of at most blk_k columns of the common
+ * dimension and multiplied with the f32 gemm (the SVE sgemm on AArch64), so
+ * the accumulation is done in f32 just as with the avx512_core kernels. */
+mkldnn_status_t sgemm_bf16bf16f32(const char *transa, const char *transb,
+        const int *M, const int *N, const int *K, const float *alpha,
+        const mkldnn_bfloat16_t *A, const int *lda,
+        const mkldnn_bfloat16_t *B, const int *ldb, const float *beta,
+        float *C, const int *ldc);
+
+}
+}
+}
+
+#endif // SGEMM_BF16BF16F32_HPP
@@ -19,6 +19,8 @@
 
 #include "jit_generator.hpp"
 
+#include "../gemm_info.hpp"
+
 #ifdef DNNL_INDIRECT_JIT_AARCH64
 #define F32_COPY_KERNEL_CODE_SIZE          (4096L * 10 * 100)
 #else
@@ -85,6 +87,27 @@ class jit_avx2_f32_copy_bt_kern : public jit_generator {
         jit_avx2_f32_copy_bt_kern();
 };
 
+#ifdef __ARM_ARCH
+/* Packing routines for the SVE sgemm micro-kernel. They share the signature
+ * of the generated copy kernels so the driver can call them through
+ * gemm_info_t::copyA / copyB. See jit_sve_kernel_sgemm_kern.hpp for the
+ * packed layouts. */
+namespace sve_f32_copy {
+void copy_an(const dim_t *k, const dim_t *m, const float *a,
+        const dim_t *lda, const float *alpha, float *dst,
+        const dim_t *dummy1, const dim_t *dummy2, float *dummy3);
+void copy_at(const dim_t *k, const dim_t *m, const float *a,
+        const dim_t *lda, const float *alpha, float *dst,
+        const dim_t *dummy1, const dim_t *dummy2, float *dummy3);
+void copy_bn(const dim_t *k, const dim_t *n, const float *b,
+        const dim_t *ldb, const float *alpha, float *dst,
+        const dim_t *dummy1, const dim_t *dummy2, float *dummy3);
+void copy_bt(const dim_t *k, const dim_t *n, const float *b,
+        const dim_t *ldb, const float *alpha, float *dst,
+        const dim_t *dummy1, const dim_t *dummy2, float *dummy3);
+}
+#endif // #ifdef __ARM_ARCH
+
 }
 }
 }
@@ -0,0 +1,122 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef JIT_SVE_KERNEL_SGEMM_KERN_HPP
+#define JIT_SVE_KERNEL_SGEMM_KERN_HPP
+
+#include "jit_generator.hpp"
+
+#include "../gemm_info.hpp"
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+#define CGA64 CodeGeneratorAArch64
+namespace xa = Xbyak::Xbyak_aarch64;
+
+/* SGEMM micro-kernel for SVE (512-bit vector length).
+ *
+ * Computes C[m x n] (+)= A[m x k] * B[k x n] on packed buffers:
+ *   - A is packed by sve_f32_copy::copy_{an,at} in panels of unroll_m rows;
+ *     within a panel every k holds min(unroll_m, m_rem) contiguous elements
+ *     (alpha is already applied),
+ *   - B is packed by sve_f32_copy::copy_{bn,bt} in panels of unroll_n
+ *     columns; within a panel every k holds unroll_n contiguous elements,
+ *     the last panel is zero-padded.
+ * The register block is unroll_m x unroll_n = 32 x 8, i.e. 16 accumulators.
+ * Tails along m are handled with whilelt predicates, tails along n by
+ * skipping the stores of the padded columns.
+ *
+ * The kernel follows the AAPCS64 calling convention directly and only uses
+ * caller-saved general purpose, vector and predicate registers, so it does
+ * not need the translator preamble. */
+class jit_sve_kernel_sgemm_kern : public jit_generator {
+public:
+    DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_sve_kernel_sgemm_kern);
+
+    jit_sve_kernel_sgemm_kern(bool beta_zero);
+
+    static constexpr int simd_w_ = 16;
+    static constexpr int unroll_m_ = 2 * simd_w_;
+    static constexpr int unroll_n_ = 8;
+
+    typedef void (*ker_t)(const dim_t *m, const dim_t *n, const dim_t *k,
+            const float *alpha, const float *a, const float *b, float *c,
+            const dim_t ldc, const float *col_offset, const float *row_offset);
+
+    ker_t jit_ker_;
+
+private:
+    using reg64_t = const xa::XReg;
+
+    bool beta_zero_;
+
+    /* Arguments (AAPCS64) */
+    reg64_t reg_param_m = x0;
+    reg64_t reg_param_n = x1;
+    reg64_t reg_param_k = x2;
+    reg64_t reg_a = x4;
+    reg64_t reg_b = x5;
+    reg64_t reg_c = x6;
+    reg64_t reg_ldc = x7;
+
+    /* Loop counters and work pointers */
+    reg64_t reg_m = x0;
+    reg64_t reg_n = x1;
+    reg64_t reg_k = x2;
+    reg64_t reg_kk = x3;
+    reg64_t reg_aa = x8;
+    reg64_t reg_aa2 = x9;
+    reg64_t reg_bb = x10;
+    reg64_t reg_cc = x11;
+    reg64_t reg_a_stride = x12;
+    reg64_t reg_tmp = x13;
+    reg64_t reg_c_stride = x14; // unroll_n columns of C, in bytes
+    reg64_t reg_mm = x15;
+    reg64_t reg_c_m = x16;
+    reg64_t reg_b_stride = x17; // one packed B panel, in bytes
+
+    const xa::PReg reg_p_all_ones = p0;
+    const xa::PReg reg_p_m0 = p1;
+    const xa::PReg reg_p_m1 = p2;
+
+    /* Register map: z0-z1 hold A, z2-z7 hold broadcast B, z16-z31 hold the
+     * accumulators. v8-v15 are callee-saved and are left untouched. */
+    const int zreg_a_idx_ = 0;
+    const int zreg_b_idx_ = 2;
+    const int nb_zreg_b_ = 6;
+    const int zreg_acc_idx_ = 16;
+
+    xa::ZRegS zreg_a(int i) { return xa::ZRegS(zreg_a_idx_ + i); }
+    xa::ZRegS zreg_b(int j) {
+        return xa::ZRegS(zreg_b_idx_ + j % nb_zreg_b_);
+    }
+    xa::ZRegS zreg_acc(int i, int j) {
+        return xa::ZRegS(zreg_acc_idx_ + j * 2 + i);
+    }
+
+    void compute_m_panel();
+    void compute_k_loop();
+    void store_c();
+    void generate();
+};
+
+}
+}
+}
+
+#endif // JIT_SVE_KERNEL_SGEMM_KERN_HPP
@@ -0,0 +1,125 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "mkldnn_thread.hpp"
+#include "nstl.hpp"
+
+#include "common_f32.hpp"
+
+#ifdef __ARM_ARCH
+#include "jit_sve_kernel_sgemm_kern.hpp"
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+namespace sve_f32_copy {
+
+namespace {
+const dim_t unroll_m = jit_sve_kernel_sgemm_kern::unroll_m_;
+const dim_t unroll_n = jit_sve_kernel_sgemm_kern::unroll_n_;
+}
+
+/* A is column-major (m x k). Packed in panels of unroll_m rows, each panel
+ * holds k columns of mr = min(unroll_m, m - i0) contiguous elements:
+ * dst[i0 * k + kk * mr + ii] = alpha * A(i0 + ii, kk). */
+void copy_an(const dim_t *k, const dim_t *m, const float *a,
+        const dim_t *lda, const float *alpha, float *dst,
+        const dim_t *, const dim_t *, float *) {
+    const dim_t K = *k, M = *m, LDA = *lda;
+    const float al = *alpha;
+
+    for (dim_t i0 = 0; i0 < M; i0 += unroll_m) {
+        const dim_t mr = nstl::min(unroll_m, M - i0);
+        float *d = dst + i0 * K;
+        for (dim_t kk = 0; kk < K; kk++) {
+            const float *a_k = a + kk * LDA + i0;
+            float *d_k = d + kk * mr;
+            PRAGMA_OMP_SIMD()
+            for (dim_t ii = 0; ii < mr; ii++)
+                d_k[ii] = al * a_k[ii];
+        }
+    }
+}
+
+/* A is row-major (transposed): A(i, kk) = a[i * lda + kk]. */
+void copy_at(const dim_t *k, const dim_t *m, const float *a,
+        const dim_t *lda, const float *alpha, float *dst,
+        const dim_t *, const dim_t *, float *) {
+    const dim_t K = *k, M = *m, LDA = *lda;
+    const float al = *alpha;
+
+    for (dim_t i0 = 0; i0 < M; i0 += unroll_m) {
+        const dim_t mr = nstl::min(unroll_m, M - i0);
+        float *d = dst + i0 * K;
+        for (dim_t ii = 0; ii < mr; ii++) {
+            const float *a_i = a + (i0 + ii) * LDA;
+            for (dim_t kk = 0; kk < K; kk++)
+                d[kk * mr + ii] = al * a_i[kk];
+        }
+    }
+}
+
+/* B is column-major (k x n). Packed in panels of unroll_n columns, each
+ * panel holds k rows of unroll_n contiguous elements; the last panel is
+ * padded with zeros. */
+void copy_bn(const dim_t *k, const dim_t *n, const float *b,
+        const dim_t *ldb, const float *, float *dst,
+        const dim_t *, const dim_t *, float *) {
+    const dim_t K = *k, N = *n, LDB = *ldb;
+
+    for (dim_t j0 = 0; j0 < N; j0 += unroll_n) {
+        const dim_t nr = nstl::min(unroll_n, N - j0);
+        float *d = dst + j0 * K;
+        for (dim_t jj = 0; jj < nr; jj++) {
+            const float *b_j = b + (j0 + jj) * LDB;
+            for (dim_t kk = 0; kk < K; kk++)
+                d[kk * unroll_n + jj] = b_j[kk];
+        }
+        for (dim_t jj = nr; jj < unroll_n; jj++)
+            for (dim_t kk = 0; kk < K; kk++)
+                d[kk * unroll_n + jj] = 0.0f;
+    }
+}
+
+/* B is row-major (transposed): B(kk, j) = b[kk * ldb + j]. */
+void copy_bt(const dim_t *k, const dim_t *n, const float *b,
+        const dim_t *ldb, const float *, float *dst,
+        const dim_t *, const dim_t *, float *) {
+    const dim_t K = *k, N = *n, LDB = *ldb;
+
+    for (dim_t j0 = 0; j0 < N; j0 += unroll_n) {
+        const dim_t nr = nstl::min(unroll_n, N - j0);
+        float *d = dst + j0 * K;
+        for (dim_t kk = 0; kk < K; kk++) {
+            const float *b_k = b + kk * LDB + j0;
+            float *d_k = d + kk * unroll_n;
+            PRAGMA_OMP_SIMD()
+            for (dim_t jj = 0; jj < nr; jj++)
+                d_k[jj] = b_k[jj];
+            for (dim_t jj = nr; jj < unroll_n; jj++)
+                d_k[jj] = 0.0f;
+        }
+    }
+}
+
+}
+
+}
+}
+}
+
+#endif // #ifdef __ARM_ARCH
@@ -27,9 +27,11 @@
 #include "f32/jit_avx_gemm_f32.hpp"
 #include "f32/ref_gemm_f32.hpp"
 
+#include "bf16/sgemm_bf16bf16f32.hpp"
 #include "gemm_driver.hpp"
 #include "s8x8s32/ref_gemm_s8x8s32.hpp"
 #include "s8x8s32/simple_gemm_s8s8s32.hpp"
+#include "s8x8s32/sve_gemm_s8x8s32.hpp"
 
 #include "os_blas.hpp"
 
@@ -131,7 +133,27 @@ mkldnn_status_t extended_sgemm(const char *transa, const char *transb,
         return gemm_driver(transa, transb, bias ? "C" : NULL, M, N, K, alpha,
                 A, lda, dummy_ao, B, ldb, dummy_bo, beta, C, ldc, bias,
                 force_jit_nocopy_gemm);
-    } else 
+    } else
+#else
+    if (mayiuse(sve) && !force_jit_nocopy_gemm) {
+        float *dummy_ao = NULL;
+        float *dummy_bo = NULL;
+
+        // The SVE copy-based kernels have no fused bias, it is added after
+        // the product (beta is zero whenever bias is present).
+        mkldnn_status_t st = gemm_driver(transa, transb, (const char *)NULL,
+                M, N, K, alpha, A, lda, dummy_ao, B, ldb, dummy_bo, beta, C,
+                ldc, (const float *)NULL, false);
+        if (st == mkldnn_success && bias) {
+            parallel_nd(*N, [&](int n) {
+                float *c = C + (ptrdiff_t)n * (*ldc);
+                PRAGMA_OMP_SIMD()
+                for (int m = 0; m < *M; m++)
+                    c[m] += bias[m];
+            });
+        }
+        return st;
+    } else
 #endif // __ARM_ARCH
     {
         return ref_gemm<float>(transa, transb,
@@ -184,6 +206,15 @@ mkldnn_status_t gemm_s8x8s32(const char *transa, const char *transb,
     if (status == mkldnn_success)
         return status;
 
+#ifdef __ARM_ARCH
+    if (mayiuse(sve)) {
+        status = sve_gemm_s8x8s32(transa, transb, offsetc, M, N, K,
+                alpha, A, LDA, ao, B, LDB, bo, beta, C, LDC, co);
+        if (status != mkldnn_unimplemented)
+            return status;
+    }
+#endif
+
     if (mayiuse(avx512_core))
         status = gemm_driver(transa, transb, offsetc, M, N, K,
                 alpha, A, LDA, ao, B, LDB, bo, beta, C, LDC, co, false);
@@ -208,6 +239,15 @@ mkldnn_status_t gemm_s8x8s32(const char *transa, const char *transb,
     if (*M == 0 || *N == 0 || *K == 0)
         return mkldnn_success;
 
+#ifdef __ARM_ARCH
+    if (mayiuse(sve)) {
+        status = sve_gemm_s8x8s32(transa, transb, offsetc, M, N, K,
+                alpha, A, LDA, ao, B, LDB, bo, beta, C, LDC, co);
+        if (status != mkldnn_unimplemented)
+            return status;
+    }
+#endif
+
     bool use_jit = true
         && mayiuse(avx512_core)
         && ((*M) * (*N) > 1); // TODO: handle s8-case in gemv
@@ -278,6 +318,11 @@ mkldnn_status_t mkldnn_gemm_bf16bf16f32(const char *transa, const char *transb,
     mkldnn_bfloat16_t *dummy_bo = NULL;
     float *dummy_co = NULL;
 
+#ifdef __ARM_ARCH
+    return sgemm_bf16bf16f32(transa, transb, M, N, K, alpha, A, lda, B, ldb,
+            beta, C, ldc);
+#endif
+
     if (mayiuse(avx512_core)) {
         return gemm_driver(transa, transb, dummyOffsetC, M, N, K,
                 alpha, A, lda, dummy_ao, B, ldb, dummy_bo, beta, C, ldc,
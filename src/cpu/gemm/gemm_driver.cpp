@@ -48,6 +48,11 @@ template <typename T>
 int get_vector_length() {
     int v_bytes;
 
+#ifdef __ARM_ARCH
+    if (mayiuse(sve))
+        v_bytes = cpu_isa_traits<sve>::vlen;
+    else
+#endif
     if (mayiuse(avx512_core))
         v_bytes = cpu_isa_traits<avx512_core>::vlen;
     else if (mayiuse(avx))
@@ -663,6 +668,11 @@ static inline int nocopy_checker(const int nthr, const int transa,
         const int transb, const dim_t m, const dim_t n, const dim_t k,
         const dim_t lda, const dim_t ldb, const dim_t ldc) {
 
+#ifdef __ARM_ARCH
+    // There is no SVE no-copy sgemm, always pack.
+    if (mayiuse(sve))
+        return 0;
+#endif
     if (mayiuse(avx512_core)) {
         return nocopy_checker_avx512(nthr, transa, transb, m, n, k, lda, ldb,
                 ldc);
@@ -1549,6 +1559,11 @@ static inline void get_omp_thread_count(dim_t m, dim_t n, dim_t k, int *nthrs) {
     const double omp_slope_big_core = 5.0e+2;
 
     int veclen = 0;
+#ifdef __ARM_ARCH
+    if (mayiuse(sve)) {
+        veclen = cpu_isa_traits<sve>::vlen / (int) sizeof(T);
+    } else
+#endif
     if (mayiuse(avx512_core)) {
         veclen = cpu_isa_traits<avx512_core>::vlen / (int) sizeof(T);
     } else {
@@ -1788,9 +1803,14 @@ mkldnn_status_t gemm_driver(
     assert(IMPLICATION(data_traits<a_type>::data_type == data_type::s8,
                 mayiuse(avx512_core) && !force_nocopy));
 
-    // gemm_driver supports sgemm for Intel AVX.
+    // gemm_driver supports sgemm for Intel AVX and SVE.
+#ifdef __ARM_ARCH
+    assert(IMPLICATION(data_traits<a_type>::data_type == data_type::f32,
+            mayiuse(sve) && !force_nocopy));
+#else
     assert(IMPLICATION(data_traits<a_type>::data_type == data_type::f32,
             mayiuse(avx)));
+#endif
 
     gemm_info_t<a_type, b_type, c_type> args(transA, transB, offsetC, m, n, k,
             alpha, a, lda, oa, b, ldb, ob, beta, c, ldc, oc, force_nocopy);
@@ -16,6 +16,7 @@
 
 #include <cstdint>
 #include <mutex>
+#include <type_traits>
 
 #include "gemm_info.hpp"
 
@@ -27,6 +28,9 @@
 #include "bf16/jit_avx512_core_gemm_bf16bf16f32_kern.hpp"
 #include "f32/common_f32.hpp"
 #include "f32/jit_avx2_kernel_sgemm_kern.hpp"
+#ifdef __ARM_ARCH
+#include "f32/jit_sve_kernel_sgemm_kern.hpp"
+#endif
 #include "s8x8s32/common_u8.hpp"
 #include "s8x8s32/jit_avx512_core_gemm_s8u8s32_kern.hpp"
 #include "s8x8s32/jit_avx512_core_kernel_gemv_s8u8s32_kern.hpp"
@@ -95,8 +99,12 @@ gemm_info_t<a_type, b_type, c_type>::gemm_info_t(const char *transA,
     bool has_bias = (is_sgemm && this->co && this->offsetc == COL_OFFSET);
 
     // Use nocopy for sgemm if requested, if there is bias or if under avx ISA.
+#ifdef __ARM_ARCH
+    this->force_nocopy = is_sgemm && (force_nocopy || has_bias);
+#else
     this->force_nocopy = is_sgemm &&
         (force_nocopy || has_bias || (mayiuse(avx) && !mayiuse(avx2)));
+#endif
 
     if (!this->force_nocopy) {
         this->jit_init();
@@ -161,6 +169,33 @@ void gemm_info_t<a_type, b_type, c_type>::jit_init(void) {
         break;
 
     case data_type::f32:
+#ifdef __ARM_ARCH
+        if (mayiuse(sve)) {
+            // A um x bk panel of A and a bk x un panel of B fill 5/8 of the
+            // L1D, a bm x bk block of A stays in 3/4 of the L2 share of one
+            // core. On A64FX this gives bk = 256 and bm = 512.
+            this->um = jit_sve_kernel_sgemm_kern::unroll_m_;
+            this->un = jit_sve_kernel_sgemm_kern::unroll_n_;
+            this->uk = 1;
+
+            const dim_t l1 = get_data_cache_size(1, true);
+            const dim_t l2 = get_data_cache_size(2, true);
+            dim_t bk = l1 * 5 / 8 / ((this->um + this->un) * sizeof(float));
+            bk = nstl::min(nstl::max(utils::rnd_dn(bk, 16), (dim_t)64),
+                    (dim_t)512);
+            dim_t bm = l2 * 3 / 4 / (bk * sizeof(float));
+            bm = nstl::min(nstl::max(utils::rnd_dn(bm, this->um), this->um),
+                    (dim_t)2048);
+
+            this->bm = bm;
+            this->bn = 384;
+            this->bk = bk;
+
+            this->bk_traditional = 256;
+            this->blocking_small_k = 48;
+            this->bn_small_k = 24;
+        } else
+#endif
         if (mayiuse(avx512_core)) {
             this->um = 48;
             this->un = 8;
@@ -235,6 +270,12 @@ void gemm_info_t<a_type, b_type, c_type>::jit_init(void) {
             break;
 
         case data_type::f32:
+#ifdef __ARM_ARCH
+            // The SVE packing routines are plain functions, they are set
+            // directly in the function pointer tables below.
+            if (mayiuse(sve))
+                break;
+#endif
             if (mayiuse(avx512_core)) {
                 copy_a[no_trans][no_sum] =
                     new jit_avx512_core_f32_copy_an_kern();
@@ -279,6 +320,10 @@ void gemm_info_t<a_type, b_type, c_type>::jit_init(void) {
             break;
 
         case data_type::f32:
+#ifdef __ARM_ARCH
+            if (mayiuse(sve))
+                break;
+#endif
             if (mayiuse(avx2)) {
                 for (int isBeta0 : {no_beta0, do_beta0}) {
                     kernel[isBeta0][no_col_offset][no_row_offset] =
@@ -288,6 +333,30 @@ void gemm_info_t<a_type, b_type, c_type>::jit_init(void) {
             }
         }
 
+#ifdef __ARM_ARCH
+        static jit_sve_kernel_sgemm_kern *sve_kernel[2] = {NULL};
+        if (data_traits<a_type>::data_type == data_type::f32
+                && mayiuse(sve)) {
+            typedef typename std::remove_reference<
+                decltype(copyA[0][0])>::type copy_a_fptr_t;
+            typedef typename std::remove_reference<
+                decltype(copyB[0][0])>::type copy_b_fptr_t;
+            typedef typename std::remove_reference<
+                decltype(kern[0][0][0])>::type kern_fptr_t;
+
+            copyA[no_trans][no_sum] = (copy_a_fptr_t)sve_f32_copy::copy_an;
+            copyA[do_trans][no_sum] = (copy_a_fptr_t)sve_f32_copy::copy_at;
+            copyB[no_trans][no_sum] = (copy_b_fptr_t)sve_f32_copy::copy_bn;
+            copyB[do_trans][no_sum] = (copy_b_fptr_t)sve_f32_copy::copy_bt;
+
+            for (int isBeta0 : {no_beta0, do_beta0}) {
+                sve_kernel[isBeta0] = new jit_sve_kernel_sgemm_kern(isBeta0);
+                kern[isBeta0][no_col_offset][no_row_offset] =
+                    (kern_fptr_t)sve_kernel[isBeta0]->jit_ker_;
+            }
+        }
+#endif
+
         static jit_avx512_core_gemv_s8u8s32_kern *gemv_s8u8s32_kernel = NULL;
         static jit_avx512_core_gemv_s8u8s32_kern *gemv_u8s8s32_kernel = NULL;
         if (data_traits<a_type>::data_type == data_type::s8) {
@@ -365,7 +434,7 @@ void gemm_info_t<a_type, b_type, c_type>::jit_init(void) {
 // Copy algorithm supported for:
 //      s8   : avx512_core, avx512_core_vnni
 //      bf16 : avx512_core, avx512_core_bf16
-//      f32  : avx2, avx512_core
+//      f32  : avx2, avx512_core, sve
 template <typename a_type, typename b_type, typename c_type>
 bool gemm_info_t<a_type, b_type, c_type>::hasKernels(void) {
     switch (data_traits<a_type>::data_type) {
@@ -398,7 +467,11 @@ bool gemm_info_t<a_type, b_type, c_type>::hasKernels(void) {
         break;
 
     case data_type::f32:
+#ifdef __ARM_ARCH
+        if (mayiuse(sve) && !this->force_nocopy) {
+#else
         if (mayiuse(avx2) && !this->force_nocopy) {
+#endif
             for (int isBeta0 : {no_beta0, do_beta0})
                 if (!this->kernel[isBeta0][no_col_offset][no_row_offset])
                     return false;
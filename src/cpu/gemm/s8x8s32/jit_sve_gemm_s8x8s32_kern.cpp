@@ -0,0 +1,153 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "jit_sve_gemm_s8x8s32_kern.hpp"
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+void jit_sve_gemm_s8x8s32_kern::compute_k_loop() {
+    xa::LabelAArch64 k_loop;
+    xa::LabelAArch64 k_loop_end;
+
+    const int a_group = unroll_m_ * k_group_;
+    const int b_group = unroll_n_ * k_group_;
+
+    CGA64::mov(reg_kk, reg_k);
+
+    CGA64::cmp(reg_kk, 0);
+    CGA64::b(xa::LE, k_loop_end);
+
+    CGA64::L_aarch64(k_loop); {
+        /* one vector holds 16 rows of a group of 4 k */
+        CGA64::ld1w(zreg_tmp(0), reg_p_all_ones / xa::T_z, xa::ptr(reg_aa));
+        CGA64::ld1w(zreg_tmp(1), reg_p_all_ones / xa::T_z,
+                xa::ptr(reg_aa, 1, xa::MUL_VL));
+        CGA64::prfm(xa::PLDL1KEEP, xa::ptr(reg_bb,
+                static_cast<int32_t>(b_group * 8)));
+
+        for (int j = 0; j < unroll_n_; j++) {
+            CGA64::ld1rw(zreg_b_s(j), reg_p_all_ones, xa::ptr(reg_bb,
+                    static_cast<int32_t>(j * k_group_)));
+            CGA64::sdot(zreg_acc(0, j), zreg_a(0), zreg_b(j));
+            CGA64::sdot(zreg_acc(1, j), zreg_a(1), zreg_b(j));
+        }
+
+        CGA64::add(reg_aa, reg_aa, a_group);
+        CGA64::add(reg_bb, reg_bb, b_group);
+
+        CGA64::subs(reg_kk, reg_kk, 1);
+        CGA64::b(xa::GT, k_loop);
+    }
+    CGA64::L_aarch64(k_loop_end);
+}
+
+void jit_sve_gemm_s8x8s32_kern::store_c() {
+    xa::LabelAArch64 store_end;
+
+    CGA64::mov(reg_cc, reg_c_m);
+    for (int j = 0; j < unroll_n_; j++) {
+        /* Columns beyond n only exist in the zero-padded B panel. */
+        if (j > 0) {
+            CGA64::cmp(reg_n, j);
+            CGA64::b(xa::LE, store_end);
+        }
+
+        CGA64::add(reg_tmp, reg_cc, simd_w_ * sizeof(int32_t));
+        if (!beta_zero_) {
+            CGA64::ld1w(zreg_tmp(0), reg_p_m0 / xa::T_z, xa::ptr(reg_cc));
+            CGA64::ld1w(zreg_tmp(1), reg_p_m1 / xa::T_z, xa::ptr(reg_tmp));
+            CGA64::add(zreg_acc(0, j), zreg_acc(0, j), zreg_tmp(0));
+            CGA64::add(zreg_acc(1, j), zreg_acc(1, j), zreg_tmp(1));
+        }
+        CGA64::st1w(zreg_acc(0, j), reg_p_m0, xa::ptr(reg_cc));
+        CGA64::st1w(zreg_acc(1, j), reg_p_m1, xa::ptr(reg_tmp));
+
+        CGA64::add(reg_cc, reg_cc, reg_ldc);
+    }
+    CGA64::L_aarch64(store_end);
+}
+
+void jit_sve_gemm_s8x8s32_kern::compute_m_panel() {
+    /* Store predicates for min(unroll_m_, m_rem) rows. */
+    CGA64::mov(reg_tmp, 0);
+    CGA64::whilelt(reg_p_m0.s, reg_tmp, reg_mm);
+    CGA64::mov(reg_tmp, simd_w_);
+    CGA64::whilelt(reg_p_m1.s, reg_tmp, reg_mm);
+
+    /* +0.0f is all-zero bits */
+    for (int j = 0; j < unroll_n_; j++)
+        for (int i = 0; i < 2; i++)
+            CGA64::fmov(zreg_acc(i, j));
+
+    /* reg_aa is left pointing to the next A panel. */
+    CGA64::mov(reg_bb, reg_b);
+    compute_k_loop();
+    store_c();
+}
+
+void jit_sve_gemm_s8x8s32_kern::generate() {
+    xa::LabelAArch64 n_loop;
+    xa::LabelAArch64 n_loop_end;
+    xa::LabelAArch64 m_loop;
+    xa::LabelAArch64 m_loop_end;
+
+    CGA64::lsl(reg_ldc, reg_ldc, 2);
+    CGA64::lsl(reg_c_stride, reg_ldc, 3); // unroll_n_ columns
+    CGA64::lsl(reg_b_stride, reg_k, 5); // k_groups * unroll_n_ * k_group_
+
+    CGA64::ptrue(reg_p_all_ones.s);
+
+    CGA64::L_aarch64(n_loop); {
+        CGA64::cmp(reg_n, 0);
+        CGA64::b(xa::LE, n_loop_end);
+
+        CGA64::mov(reg_aa, reg_a);
+        CGA64::mov(reg_c_m, reg_c);
+        CGA64::mov(reg_mm, reg_m);
+
+        CGA64::L_aarch64(m_loop); {
+            CGA64::cmp(reg_mm, 0);
+            CGA64::b(xa::LE, m_loop_end);
+
+            compute_m_panel();
+
+            CGA64::add(reg_c_m, reg_c_m, unroll_m_ * sizeof(int32_t));
+            CGA64::sub(reg_mm, reg_mm, unroll_m_);
+            CGA64::b(m_loop);
+        }
+        CGA64::L_aarch64(m_loop_end);
+
+        CGA64::add(reg_b, reg_b, reg_b_stride);
+        CGA64::add(reg_c, reg_c, reg_c_stride);
+        CGA64::sub(reg_n, reg_n, unroll_n_);
+        CGA64::b(n_loop);
+    }
+    CGA64::L_aarch64(n_loop_end);
+
+    CGA64::ret();
+}
+
+jit_sve_gemm_s8x8s32_kern::jit_sve_gemm_s8x8s32_kern(bool beta_zero)
+    : jit_generator(nullptr, 65536), beta_zero_(beta_zero) {
+    generate();
+    jit_ker_ = (ker_t)this->getCode32();
+}
+
+}
+}
+}
@@ -0,0 +1,123 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef JIT_SVE_GEMM_S8X8S32_KERN_HPP
+#define JIT_SVE_GEMM_S8X8S32_KERN_HPP
+
+#include "jit_generator.hpp"
+
+#include "../gemm_info.hpp"
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+#define CGA64 CodeGeneratorAArch64
+namespace xa = Xbyak::Xbyak_aarch64;
+
+/* Int8 GEMM micro-kernel for SVE (512-bit vector length) based on SDOT.
+ *
+ * Computes C[m x n] (+)= A[m x k] * B[k x n] with s8 inputs and s32
+ * accumulation on packed buffers (see sve_gemm_s8x8s32.cpp), where k is
+ * given in groups of 4:
+ *   - A is packed in panels of unroll_m rows, zero-padded to the full
+ *     panel; every group of 4 k holds unroll_m x 4 bytes, the 4 bytes of a
+ *     row being contiguous, so that a vector holds 16 rows of one group,
+ *   - B is packed in panels of unroll_n columns, zero-padded to the full
+ *     panel; every group of 4 k holds unroll_n x 4 bytes.
+ * A 4-byte group of a B column is broadcast to all the 32-bit lanes and
+ * SDOT accumulates the 4 products of each row into its lane. The register
+ * block is unroll_m x unroll_n = 32 x 8, i.e. 16 accumulators. Tails along
+ * m are handled with whilelt predicates on the stores, tails along n by
+ * skipping the stores of the padded columns.
+ *
+ * Like jit_sve_kernel_sgemm_kern, the kernel follows the AAPCS64 calling
+ * convention directly and only uses caller-saved registers. */
+class jit_sve_gemm_s8x8s32_kern : public jit_generator {
+public:
+    DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_sve_gemm_s8x8s32_kern);
+
+    jit_sve_gemm_s8x8s32_kern(bool beta_zero);
+
+    static constexpr int simd_w_ = 16;
+    static constexpr int unroll_m_ = 2 * simd_w_;
+    static constexpr int unroll_n_ = 8;
+    static constexpr int k_group_ = 4;
+
+    typedef void (*ker_t)(dim_t m, dim_t n, dim_t k_groups, const int8_t *a,
+            const int8_t *b, int32_t *c, dim_t ldc);
+
+    ker_t jit_ker_;
+
+private:
+    using reg64_t = const xa::XReg;
+
+    bool beta_zero_;
+
+    /* Arguments (AAPCS64) */
+    reg64_t reg_m = x0;
+    reg64_t reg_n = x1;
+    reg64_t reg_k = x2;
+    reg64_t reg_a = x3;
+    reg64_t reg_b = x4;
+    reg64_t reg_c = x5;
+    reg64_t reg_ldc = x6;
+
+    /* Loop counters and work pointers */
+    reg64_t reg_kk = x7;
+    reg64_t reg_aa = x8;
+    reg64_t reg_bb = x9;
+    reg64_t reg_cc = x10;
+    reg64_t reg_c_m = x11;
+    reg64_t reg_mm = x12;
+    reg64_t reg_tmp = x13;
+    reg64_t reg_c_stride = x14; // unroll_n columns of C, in bytes
+    reg64_t reg_b_stride = x15; // one packed B panel, in bytes
+
+    const xa::PReg reg_p_all_ones = p0;
+    const xa::PReg reg_p_m0 = p1;
+    const xa::PReg reg_p_m1 = p2;
+
+    /* Register map: z0-z1 hold A, z2-z7 hold broadcast B, z16-z31 hold the
+     * accumulators. v8-v15 are callee-saved and are left untouched. */
+    const int zreg_a_idx_ = 0;
+    const int zreg_b_idx_ = 2;
+    const int nb_zreg_b_ = 6;
+    const int zreg_acc_idx_ = 16;
+
+    xa::ZRegB zreg_a(int i) { return xa::ZRegB(zreg_a_idx_ + i); }
+    xa::ZRegS zreg_b_s(int j) {
+        return xa::ZRegS(zreg_b_idx_ + j % nb_zreg_b_);
+    }
+    xa::ZRegB zreg_b(int j) {
+        return xa::ZRegB(zreg_b_idx_ + j % nb_zreg_b_);
+    }
+    xa::ZRegS zreg_acc(int i, int j) {
+        return xa::ZRegS(zreg_acc_idx_ + j * 2 + i);
+    }
+    xa::ZRegS zreg_tmp(int i) { return xa::ZRegS(zreg_a_idx_ + i); }
+
+    void compute_m_panel();
+    void compute_k_loop();
+    void store_c();
+    void generate();
+};
+
+}
+}
+}
+
+#endif // JIT_SVE_GEMM_S8X8S32_KERN_HPP
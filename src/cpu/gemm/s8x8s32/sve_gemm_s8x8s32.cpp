@@ -0,0 +1,252 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <cstdint>
+#include <mutex>
+
+#include "sve_gemm_s8x8s32.hpp"
+
+#include "jit_generator.hpp"
+#include "math_utils.hpp"
+#include "mkldnn_thread.hpp"
+#include "mkldnn_traits.hpp"
+#include "mkldnn_types.h"
+#include "nstl.hpp"
+#include "utils.hpp"
+
+#ifdef __ARM_ARCH
+#include "jit_sve_gemm_s8x8s32_kern.hpp"
+#endif
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+#ifdef __ARM_ARCH
+
+namespace {
+
+using kern_t = jit_sve_gemm_s8x8s32_kern;
+
+const dim_t unroll_m = kern_t::unroll_m_;
+const dim_t unroll_n = kern_t::unroll_n_;
+const dim_t k_group = kern_t::k_group_;
+
+/* Blocking: a packed A block (blk_m x blk_k) fits in L2, a packed B panel
+ * (blk_k x unroll_n) in L1. */
+const dim_t blk_m = 512;
+const dim_t blk_n = 256;
+const dim_t blk_k = 1024;
+
+const kern_t *get_kernel(bool beta_zero) {
+    static kern_t *kernels[2] = {NULL};
+    static std::once_flag initialized;
+    std::call_once(initialized, []{
+        kernels[0] = new kern_t(false);
+        kernels[1] = new kern_t(true);
+    });
+    return kernels[beta_zero];
+}
+
+/* Packs A[m0:m0+mb, k0:k0+kb] in panels of unroll_m rows (see
+ * jit_sve_gemm_s8x8s32_kern) and accumulates the row sums into rowsum. */
+void pack_a(bool transa, const int8_t *a, dim_t lda, dim_t m0, dim_t mb,
+        dim_t k0, dim_t kb, int8_t *ap, int32_t *rowsum) {
+    const dim_t k_groups = utils::div_up(kb, k_group);
+    const dim_t npanels = utils::div_up(mb, unroll_m);
+
+    for (dim_t p = 0; p < npanels; p++) {
+        int8_t *dst = ap + p * k_groups * unroll_m * k_group;
+        for (dim_t r = 0; r < unroll_m; r++) {
+            const dim_t i = p * unroll_m + r;
+            int32_t sum = 0;
+            for (dim_t g = 0; g < k_groups; g++)
+            for (dim_t q = 0; q < k_group; q++) {
+                const dim_t k = g * k_group + q;
+                int8_t v = 0;
+                if (i < mb && k < kb)
+                    v = transa ? a[(k0 + k) + (m0 + i) * lda]
+                        : a[(m0 + i) + (k0 + k) * lda];
+                dst[(g * unroll_m + r) * k_group + q] = v;
+                sum += v;
+            }
+            if (i < mb) rowsum[i] += sum;
+        }
+    }
+}
+
+/* Packs B[k0:k0+kb, n0:n0+nb] in panels of unroll_n columns; unsigned
+ * values are shifted by -128 to the signed range. */
+template <typename b_dt>
+void pack_b(bool transb, const b_dt *b, dim_t ldb, dim_t k0, dim_t kb,
+        dim_t n0, dim_t nb, int8_t *bp) {
+    const bool b_is_u8 = data_traits<b_dt>::data_type == data_type::u8;
+    const dim_t k_groups = utils::div_up(kb, k_group);
+    const dim_t npanels = utils::div_up(nb, unroll_n);
+
+    for (dim_t p = 0; p < npanels; p++) {
+        int8_t *dst = bp + p * k_groups * unroll_n * k_group;
+        for (dim_t g = 0; g < k_groups; g++)
+        for (dim_t c = 0; c < unroll_n; c++)
+        for (dim_t q = 0; q < k_group; q++) {
+            const dim_t j = p * unroll_n + c;
+            const dim_t k = g * k_group + q;
+            int8_t v = 0;
+            if (j < nb && k < kb) {
+                const b_dt x = transb ? b[(n0 + j) + (k0 + k) * ldb]
+                    : b[(k0 + k) + (n0 + j) * ldb];
+                v = b_is_u8 ? (int8_t)(x ^ 0x80) : (int8_t)x;
+            }
+            dst[(g * unroll_n + c) * k_group + q] = v;
+        }
+    }
+}
+
+}
+
+template <typename b_dt>
+mkldnn_status_t sve_gemm_s8x8s32(const char *transa, const char *transb,
+        const char *offsetc, const int *M, const int *N, const int *K,
+        const float *alpha, const int8_t *A, const int *LDA, const int8_t *ao,
+        const b_dt *B, const int *LDB, const int8_t *bo, const float *beta,
+        int32_t *C, const int *LDC, const int32_t *co) {
+    if (*ao != 0 || *bo != 0) return mkldnn_unimplemented;
+
+    const bool b_is_u8 = data_traits<b_dt>::data_type == data_type::u8;
+    const bool OCisR = (*offsetc == 'R' || *offsetc == 'r');
+    const bool OCisC = (*offsetc == 'C' || *offsetc == 'c');
+    const bool is_transa = (*transa == 'T' || *transa == 't');
+    const bool is_transb = (*transb == 'T' || *transb == 't');
+
+    const dim_t m = *M, n = *N, k = *K;
+    const dim_t lda = *LDA, ldb = *LDB, ldc = *LDC;
+    const float alpha_ = *alpha, beta_ = *beta;
+
+    const int nthr = mkldnn_get_max_threads();
+
+    const dim_t bm = nstl::min(blk_m, utils::rnd_up(m, unroll_m));
+    const dim_t bk = nstl::min(blk_k, utils::rnd_up(k, k_group));
+    const dim_t nmb = utils::div_up(m, bm);
+    /* Split along n further if the m blocks alone cannot feed the threads */
+    dim_t bn = nstl::min(blk_n, utils::rnd_up(n, unroll_n));
+    if (nmb * utils::div_up(n, bn) < nthr)
+        bn = nstl::max(unroll_n, utils::rnd_up(
+                    utils::div_up(n, utils::div_up((dim_t)nthr, nmb)),
+                    unroll_n));
+    const dim_t nnb = utils::div_up(n, bn);
+    const dim_t nkb = utils::div_up(k, bk);
+
+    const size_t a_size = utils::rnd_up(bm * bk, 64);
+    const size_t b_size = utils::rnd_up(bn * bk, 64);
+    const size_t acc_size = utils::rnd_up(bm * bn * sizeof(int32_t), 64);
+    const size_t rowsum_size = utils::rnd_up(bm * sizeof(int32_t), 64);
+    const size_t thr_size = a_size + b_size + acc_size + rowsum_size;
+
+    char *ws = (char *)malloc(thr_size * nthr, PAGE_4K);
+    if (ws == NULL) return mkldnn_out_of_memory;
+
+    const kern_t *ker_beta0 = get_kernel(true);
+    const kern_t *ker_beta1 = get_kernel(false);
+
+    const bool int_post = alpha_ == 1.0f
+        && utils::one_of(beta_, 0.0f, 1.0f);
+
+    parallel(nthr, [&](const int ithr, const int nthr) {
+        char *thr_ws = ws + thr_size * ithr;
+        int8_t *ap = (int8_t *)thr_ws;
+        int8_t *bp = (int8_t *)(thr_ws + a_size);
+        int32_t *acc = (int32_t *)(thr_ws + a_size + b_size);
+        int32_t *rowsum = (int32_t *)(thr_ws + a_size + b_size + acc_size);
+
+        dim_t start = 0, end = 0;
+        balance211(nmb * nnb, nthr, ithr, start, end);
+
+        for (dim_t iwork = start; iwork < end; iwork++) {
+            const dim_t ib = iwork % nmb, jb = iwork / nmb;
+            const dim_t m0 = ib * bm, mb = nstl::min(bm, m - m0);
+            const dim_t n0 = jb * bn, nb = nstl::min(bn, n - n0);
+
+            for (dim_t i = 0; i < mb; i++)
+                rowsum[i] = 0;
+
+            for (dim_t kbi = 0; kbi < nkb; kbi++) {
+                const dim_t k0 = kbi * bk, kb = nstl::min(bk, k - k0);
+                pack_a(is_transa, A, lda, m0, mb, k0, kb, ap, rowsum);
+                pack_b(is_transb, B, ldb, k0, kb, n0, nb, bp);
+                const kern_t *ker = kbi == 0 ? ker_beta0 : ker_beta1;
+                ker->jit_ker_(mb, nb, utils::div_up(kb, k_group), ap, bp,
+                        acc, bm);
+            }
+
+            /* C = alpha * (acc + comp) + beta * C + co */
+            for (dim_t j = 0; j < nb; j++) {
+                int32_t *c = C + (n0 + j) * ldc + m0;
+                const int32_t *pacc = acc + j * bm;
+                for (dim_t i = 0; i < mb; i++) {
+                    const int64_t comp = b_is_u8 ? 128 * (int64_t)rowsum[i] : 0;
+                    const int32_t coffset = OCisR ? co[n0 + j]
+                        : OCisC ? co[m0 + i] : co[0];
+                    if (int_post) {
+                        int64_t val = (int64_t)pacc[i] + comp + coffset;
+                        if (beta_ != 0.0f) val += c[i];
+                        c[i] = (int32_t)nstl::max((int64_t)INT32_MIN,
+                                nstl::min((int64_t)INT32_MAX, val));
+                    } else {
+                        double val = (double)alpha_ * (double)(pacc[i] + comp)
+                            + (double)coffset;
+                        if (beta_ != 0.0f) val += (double)beta_ * c[i];
+                        c[i] = math::out_round<int32_t>(
+                                math::saturate<int32_t>(val));
+                    }
+                }
+            }
+        }
+    });
+
+    free(ws);
+    return mkldnn_success;
+}
+
+#else
+
+template <typename b_dt>
+mkldnn_status_t sve_gemm_s8x8s32(const char *transa, const char *transb,
+        const char *offsetc, const int *M, const int *N, const int *K,
+        const float *alpha, const int8_t *A, const int *LDA, const int8_t *ao,
+        const b_dt *B, const int *LDB, const int8_t *bo, const float *beta,
+        int32_t *C, const int *LDC, const int32_t *co) {
+    return mkldnn_unimplemented;
+}
+
+#endif // #ifdef __ARM_ARCH
+
+template mkldnn_status_t sve_gemm_s8x8s32<uint8_t>(
+        const char *transa, const char *transb, const char *offsetc,
+        const int *M, const int *N, const int *K,
+        const float *alpha, const int8_t *A, const int *LDA, const int8_t *ao,
+        const uint8_t *B, const int *LDB, const int8_t *bo,
+        const float *beta, int32_t *C, const int *LDC, const int32_t *co);
+
+template mkldnn_status_t sve_gemm_s8x8s32<int8_t>(
+        const char *transa, const char *transb, const char *offsetc,
+        const int *M, const int *N, const int *K,
+        const float *alpha, const int8_t *A, const int *LDA, const int8_t *ao,
+        const int8_t *B, const int *LDB, const int8_t *bo,
+        const float *beta, int32_t *C, const int *LDC, const int32_t *co);
+
+}
+}
+}
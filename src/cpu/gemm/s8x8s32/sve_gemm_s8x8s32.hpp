@@ -0,0 +1,46 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef SVE_GEMM_S8X8S32_HPP
+#define SVE_GEMM_S8X8S32_HPP
+
+#include <cstdint>
+
+#include "mkldnn_types.h"
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+/* gemm_s8x8s32 on SVE with the SDOT-based micro-kernel.
+ *
+ * Only zero A and B offsets are supported, mkldnn_unimplemented is returned
+ * otherwise so that the caller can fall back to the reference version.
+ * Unsigned B is shifted to the signed range while it is packed:
+ *   A * B = A * (B - 128) + 128 * rowsum(A)
+ * and the second term is added back in the post-processing. */
+template <typename b_dt>
+mkldnn_status_t sve_gemm_s8x8s32(const char *transa, const char *transb,
+        const char *offsetc, const int *M, const int *N, const int *K,
+        const float *alpha, const int8_t *A, const int *LDA, const int8_t *ao,
+        const b_dt *B, const int *LDB, const int8_t *bo, const float *beta,
+        int32_t *C, const int *LDC, const int32_t *co);
+
+}
+}
+}
+
+#endif // SVE_GEMM_S8X8S32_HPP
@@ -22,6 +22,7 @@
 #include "type_helpers.hpp"
 #include "mkldnn_thread.hpp"
 #include "bfloat16_utils.hpp"
+#include "simple_q10n.hpp"
 
 namespace mkldnn {
 namespace impl {
@@ -33,6 +34,11 @@ using namespace mkldnn::impl::memory_tracking::names;
 using namespace mkldnn::impl::utils;
 using namespace mkldnn::impl::cpu::bf16_cvt_utils;
 
+namespace {
+inline float to_float(float v) { return v; }
+inline float to_float(mkldnn_bfloat16_t v) { return cvt_bfloat16_to_float(v); }
+}
+
 template <data_type_t dst_data_type>
 gemm_bf16_convolution_fwd_t<dst_data_type>::pp_ker_t::pp_ker_t(
     const pd_t *pd)
@@ -44,12 +50,12 @@ gemm_bf16_convolution_fwd_t<dst_data_type>::pp_ker_t::pp_ker_t(
     , do_sum_(false)
     , max_data_reg_idx_(31), max_unroll_(12), compute_reg_step_(1)
     , data_reg_base_idx_(0)
-    , bf16_emu_(nullptr), eltwise_injector_(nullptr)
+    , bf16_emu_(nullptr), eltwise_injector_(nullptr), ref_eltwise_(nullptr)
 {
     using namespace types;
     using namespace Xbyak;
 
-    if (!mayiuse(avx512_core))
+    if (!mayiuse_bf16_cvt())
         // bf16 is not supported
         return;
 
@@ -59,19 +65,28 @@ gemm_bf16_convolution_fwd_t<dst_data_type>::pp_ker_t::pp_ker_t(
     auto &post_ops = pd->attr()->post_ops_;
     const int eltwise_ind = post_ops.find(primitive_kind::eltwise);
     do_eltwise_ = eltwise_ind != -1;
+    do_sum_ = dst_data_type != data_type::f32
+        && post_ops.contain(primitive_kind::sum, 0);
+    do_bias_ = pd->with_bias();
+
+#ifdef __ARM_ARCH
+    // no kernel is generated, operator() uses the fallback code
+    if (do_eltwise_)
+        ref_eltwise_ = new ref_eltwise_scalar_fwd_t(
+                post_ops.entry_[eltwise_ind].eltwise);
+    return;
+#endif
+
     if (do_eltwise_)
         eltwise_injector_ = new jit_uni_eltwise_injector_f32<avx512_common>(
                 this, post_ops.entry_[eltwise_ind].eltwise, true,
                 reserved_eltwise_gpr, reserved_eltwise_maskr);
 
-    do_sum_ = dst_data_type != data_type::f32
-        && post_ops.contain(primitive_kind::sum, 0);
     if (do_sum_) {
         compute_reg_step_ = 2;
         vreg_sum_scale = Zmm(data_reg_base_idx_++);
     }
 
-    do_bias_ = pd->with_bias();
     if (do_bias_)
         vreg_bias = Zmm(data_reg_base_idx_++);
 
@@ -249,27 +264,45 @@ void gemm_bf16_convolution_fwd_t<dst_data_type>::pp_ker_t::operator ()
         float sum_scale, size_t dst_stride_in_elements,
         size_t acc_stride_in_elements, size_t len, bool do_parallel)
 {
-    assert(ker_);
     if (len == 0)
         return;
 
     parallel(do_parallel ? 0 : 1, [&](const int ithr, const int nthr) {
         size_t start_oc = 0, end_oc = 0;
         balance211(OC_, nthr, ithr, start_oc, end_oc);
-        if (end_oc > start_oc) {
-            ker_args args;
-            args.acc = acc + start_oc * acc_stride_in_elements;
-            args.dst = dst + start_oc * dst_stride_in_elements;
-            args.bias = bias + start_oc;
-            args.sum_scale = sum_scale;
-            args.dst_stride_in_bytes =
-                dst_stride_in_elements * sizeof(dst_data_t);
-            args.acc_stride_in_bytes =
-                acc_stride_in_elements * sizeof(acc_data_t);
-            args.spatial_length = len;
-            args.oc_work = end_oc - start_oc;
-            ker_(&args);
+        if (end_oc <= start_oc)
+            return;
+
+        if (!ker_) {
+            // Fallback
+            for (size_t oc = start_oc; oc < end_oc; oc++) {
+                const acc_data_t *acc_oc = acc + oc * acc_stride_in_elements;
+                dst_data_t *dst_oc = dst + oc * dst_stride_in_elements;
+                for (size_t i = 0; i < len; i++) {
+                    float d = acc_oc[i];
+                    if (do_bias_)
+                        d += bias[oc];
+                    if (do_sum_)
+                        d += sum_scale * to_float(dst_oc[i]);
+                    if (do_eltwise_)
+                        d = ref_eltwise_->compute_scalar(d);
+                    dst_oc[i] = qz_a1b0<float, dst_data_t>()(d,
+                            round_mode::nearest);
+                }
+            }
+            return;
         }
+
+        ker_args args;
+        args.acc = acc + start_oc * acc_stride_in_elements;
+        args.dst = dst + start_oc * dst_stride_in_elements;
+        args.bias = bias + start_oc;
+        args.sum_scale = sum_scale;
+        args.dst_stride_in_bytes = dst_stride_in_elements * sizeof(dst_data_t);
+        args.acc_stride_in_bytes = acc_stride_in_elements * sizeof(acc_data_t);
+        args.spatial_length = len;
+        args.oc_work = end_oc - start_oc;
+        ker_(&args);
     });
 }
 
@@ -26,6 +26,7 @@
 #include "gemm/gemm.hpp"
 #include "jit_avx512_core_bf16cvt.hpp"
 #include "jit_uni_eltwise.hpp"
+#include "ref_eltwise.hpp"
 #include "cpu_reducer.hpp"
 
 namespace mkldnn {
@@ -175,6 +176,7 @@ private:
         ~pp_ker_t() {
             delete bf16_emu_;
             delete eltwise_injector_;
+            delete ref_eltwise_;
         }
 
         void operator()(dst_data_t *dst, const acc_data_t *acc,
@@ -238,6 +240,7 @@ private:
         size_t vlen_;
         bf16_emulation_t *bf16_emu_;
         jit_uni_eltwise_injector_f32<avx512_common> *eltwise_injector_;
+        ref_eltwise_scalar_fwd_t *ref_eltwise_;
 
         void generate();
         int vreg_dst_idx(int iter) {
@@ -47,7 +47,7 @@ struct gemm_bf16_inner_product_fwd_t: public cpu_primitive_t {
             assert(engine()->kind() == engine_kind::cpu);
 
             bool ok = true
-                && mayiuse(avx512_core)
+                && mayiuse_bf16_cvt()
                 && this->set_default_params() == status::success
                 && one_of(desc()->prop_kind, prop_kind::forward_training,
                         prop_kind::forward_inference)
@@ -137,7 +137,7 @@ struct gemm_bf16_inner_product_bwd_data_t: public cpu_primitive_t {
             assert(engine()->kind() == engine_kind::cpu);
 
             bool ok = true
-                && mayiuse(avx512_core)
+                && mayiuse_bf16_cvt()
                 && this->set_default_params() == status::success
                 && desc()->prop_kind == prop_kind::backward_data
                 && !has_zero_dim_memory()
@@ -206,7 +206,7 @@ struct gemm_bf16_inner_product_bwd_weights_t: public cpu_primitive_t {
             using namespace utils;
             assert(engine()->kind() == engine_kind::cpu);
             bool ok = true
-                && mayiuse(avx512_core)
+                && mayiuse_bf16_cvt()
                 && this->set_default_params() == status::success
                 && desc()->prop_kind == prop_kind::backward_weights
                 && !has_zero_dim_memory()
@@ -615,7 +615,7 @@ status_t init_conf(jit_gemm_conv_conf_t &jcp,
                 dst_d.data_type(), weights_d.data_type()))
         || (is_bwd_w && utils::everyone_is(bf16,
                 src_d.data_type(), dst_d.data_type()));
-    if (is_bf16_conv && !mayiuse(avx512_core))
+    if (is_bf16_conv && !mayiuse_bf16_cvt())
         return status::unimplemented;
 
     bool is_bf16_to_bf16_conv = is_bf16_conv
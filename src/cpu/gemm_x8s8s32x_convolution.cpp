@@ -105,7 +105,11 @@ _gemm_x8s8s32x_convolution_fwd_t<src_type, dst_type>::pp_ker_t::pp_ker_t(
     const int eltwise_ind = post_ops.find(primitive_kind::eltwise);
     do_eltwise_ = eltwise_ind != -1;
 
+#ifdef __ARM_ARCH
+    if (!mayiuse(avx512_core) || mayiuse(sve)) {
+#else
     if (!mayiuse(avx512_core)) {
+#endif //#ifdef __ARM_ARCH
         if (do_eltwise_) {
             eltwise_ = new ref_eltwise_scalar_fwd_t(
                     post_ops.entry_[eltwise_ind].eltwise);
@@ -68,12 +68,13 @@ struct jit_avx512_core_x8s8s32x_1x1_deconvolution_fwd_t
                     dd->strides, dd->dilates, dd->padding[0], dd->padding[1],
                     dd->padding_kind);
 
+            const primitive_attr_t conv_attr = this->attr_.nested();
             if (status == status::success) {
                 status = mkldnn_primitive_desc::create<
                         typename mkldnn::impl::cpu::
                                 jit_avx512_core_x8s8s32x_1x1_convolution_fwd_t<src_type,
                                         dst_type>::pd_t>(&conv_pd_,
-                        (op_desc_t *)&cd, &(this->attr_), this->engine_,
+                        (op_desc_t *)&cd, &conv_attr, this->engine_,
                         nullptr);
             }
 
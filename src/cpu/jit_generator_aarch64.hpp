@@ -36,6 +36,7 @@
 #define XBYAK_CODE_PTR uint32
 
 #include "cpu_isa_traits.hpp"
+#include "cpu_topology.hpp"
 #include <limits.h>
 
 #include "mkldnn_thread.hpp"
@@ -133,30 +134,14 @@ static const Xbyak::Reg64 abi_param1(Xbyak::Operand::RDI),
 #endif // #ifdef _WIN32
 #endif // __ARM_ARCH
 
+// Cache sizes come from the runtime topology service, see cpu_topology.hpp.
+// With per_core the share of each of nthreads threads, otherwise the
+// capacity of the cache instances they span.
 inline unsigned int get_A64FX_cache_size(int level, bool per_core = true, int nthreads = 1) {
-    unsigned int l = level - 1;
-    // Currently, if XByak is not able to fetch the cache topology
-    // we default to 64KiB of L1 per core, 8MiB of L2 per 1CMG.
-    if (cpu.getDataCacheLevels() == 0) {
-        const int L1_cache_per_core = 65536;
-        const int L2_cache_per_CMG = 8388608;
-        int num_cores = per_core ? 1 : nthreads;
-        switch (l) {
-        case (0): return L1_cache_per_core * num_cores;
-        case (1):
-	  if (per_core) {
-	    return (L2_cache_per_CMG * utils::div_up(num_cores, 12)) / nthreads;
-	  } else {
-	    return L2_cache_per_CMG * utils::div_up(num_cores, 12);
-	  }
-        default: return 0;
-        }
-    }
-    if (l < cpu.getDataCacheLevels()) {
-        return cpu.getDataCacheSize(l)
-                / (per_core ? cpu.getCoresSharingDataCache(l) : 1);
-    } else
-        return 0;
+    if (per_core && level == 1)
+        return get_data_cache_size(level, true);
+    unsigned int size = get_data_cache_size(level, false, nthreads);
+    return per_core ? size / (nthreads > 1 ? nthreads : 1) : size;
 }
 
 } // namespace
@@ -1428,6 +1413,15 @@ public:
     virtual const char *name() const = 0;
     virtual const char *source_file() const = 0;
 
+    /** returns the size of the generated code in bytes */
+    size_t code_size() const {
+#ifdef DNNL_INDIRECT_JIT_AARCH64
+        return getSize() * 4;
+#else
+        return getSize();
+#endif
+    }
+
     // XXX: use normal_case name and update all callees (?)
 
     const uint32_t *getCode32() {
@@ -0,0 +1,54 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "mkldnn.h"
+
+#include "c_types_map.hpp"
+#include "utils.hpp"
+
+#include "jit_kernel_registry.hpp"
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+jit_kernel_registry_t &jit_kernel_registry() {
+    /* Never destroyed: kernels released during static destruction still
+     * unregister themselves. */
+    static jit_kernel_registry_t *registry = new jit_kernel_registry_t();
+    return *registry;
+}
+
+}
+}
+}
+
+using namespace mkldnn::impl;
+using namespace mkldnn::impl::status;
+
+status_t mkldnn_get_jit_kernel_registry_stats(size_t *generated,
+        size_t *deduplicated, size_t *bytes_saved) {
+    if (utils::everyone_is(nullptr, generated, deduplicated, bytes_saved))
+        return invalid_arguments;
+
+    auto stats = cpu::jit_kernel_registry().stats();
+    if (generated) *generated = stats.generated;
+    if (deduplicated) *deduplicated = stats.deduplicated;
+    if (bytes_saved) *bytes_saved = stats.bytes_saved;
+    return success;
+}
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
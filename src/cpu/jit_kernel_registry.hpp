@@ -0,0 +1,132 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef JIT_KERNEL_REGISTRY_HPP
+#define JIT_KERNEL_REGISTRY_HPP
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <typeinfo>
+#include <unordered_map>
+
+#include "c_types_map.hpp"
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+/** Registry of generated kernels shared between primitives.
+ *
+ * Primitives with the same kernel configuration generate byte-identical
+ * code, e.g. the repeated blocks of a ResNet. A kernel obtained with get()
+ * is generated once and shared, reference counted, by all the primitives
+ * that request it. It is destroyed together with its last user.
+ *
+ * A key is the kernel class and the bytes of its configuration, built with
+ * append(). Configurations are expected to be value-initialized so that
+ * padding bytes compare equal; a mismatch only results in a missed
+ * deduplication. Kernels must provide code_size(). */
+struct jit_kernel_registry_t {
+    typedef std::string key_t;
+
+    struct stats_t {
+        size_t generated; // kernels generated through the registry
+        size_t deduplicated; // requests served with an existing kernel
+        size_t bytes_saved; // code size of the deduplicated requests
+    };
+
+    template <typename T>
+    static void append(key_t &key, const T &v)
+    { key.append(reinterpret_cast<const char *>(&v), sizeof(T)); }
+
+    template <typename T>
+    static void append(key_t &key, const T *a, int n)
+    { key.append(reinterpret_cast<const char *>(a), sizeof(T) * n); }
+
+    /** Returns the kernel of class @p kernel_t registered for @p conf_key.
+     * If there is none, @p create is called to generate it. */
+    template <typename kernel_t, typename create_f>
+    std::shared_ptr<kernel_t> get(const key_t &conf_key, create_f create) {
+        key_t key(typeid(kernel_t).name());
+        key.push_back('\0');
+        key.append(conf_key);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto k = lookup<kernel_t>(key);
+            if (k) return k;
+        }
+
+        /* generate outside of the lock, other kernels may be requested
+         * concurrently */
+        kernel_t *raw = create();
+        if (raw == nullptr) return nullptr;
+        std::shared_ptr<kernel_t> k(raw,
+                [this, key](kernel_t *p) { delete p; release(key); });
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto existing = lookup<kernel_t>(key);
+        if (existing) return existing;
+        kernels_[key] = k;
+        stats_.generated++;
+        return k;
+    }
+
+    stats_t stats() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return stats_;
+    }
+
+    jit_kernel_registry_t(): stats_() {}
+
+private:
+    template <typename kernel_t>
+    std::shared_ptr<kernel_t> lookup(const key_t &key) {
+        auto it = kernels_.find(key);
+        if (it == kernels_.end()) return nullptr;
+        auto k = std::static_pointer_cast<kernel_t>(it->second.lock());
+        if (k) {
+            stats_.deduplicated++;
+            stats_.bytes_saved += k->code_size();
+        }
+        return k;
+    }
+
+    void release(const key_t &key) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = kernels_.find(key);
+        if (it != kernels_.end() && it->second.expired())
+            kernels_.erase(it);
+    }
+
+    std::unordered_map<key_t, std::weak_ptr<void>> kernels_;
+    stats_t stats_;
+    mutable std::mutex mutex_;
+
+    jit_kernel_registry_t(const jit_kernel_registry_t &) = delete;
+    jit_kernel_registry_t &operator=(const jit_kernel_registry_t &) = delete;
+};
+
+jit_kernel_registry_t &jit_kernel_registry();
+
+}
+}
+}
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
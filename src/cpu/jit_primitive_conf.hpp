@@ -270,6 +270,37 @@ struct jit_conv_winograd_conf_t : public jit_conv_conf_t {
     winograd_sched_t sched_policy;
 };
 
+/* Winograd F(m x m, 3 x 3) for SVE (jit_sve_convolution_winograd.hpp).
+ * Forward and backward-data share the same data flow: a 'inp' tensor is
+ * tiled, transformed and multiplied by the transformed weights, the result
+ * is transformed back into the 'out' tensor. For backward-data 'inp' is
+ * diff_dst and the weights are flipped. For backward-weights 'inp' is src
+ * and 'out' is diff_dst, both are transformed and reduced over the tiles. */
+struct jit_conv_conf_sve_wino_t {
+    int m;
+    int r;
+    int alpha;
+
+    int mb;
+    int ic, oc, ic_without_padding, oc_without_padding;
+    int ih, iw, oh, ow;
+    int t_pad, l_pad;
+    bool with_groups;
+
+    int inp_c, out_c;
+    int inp_h, inp_w, out_h, out_w;
+    int inp_t_pad, inp_l_pad;
+
+    int jtiles, itiles, ntiles;
+    int tile_block, nb_tile_blocks;
+    int nthr;
+
+    bool with_bias;
+    bool with_sum;
+    bool with_eltwise;
+    float sum_scale;
+};
+
 struct jit_conv_call_s {
     const void *src; /* hack, non-const for backward_data */
     const void *dst; /* hack, non-const for forward */
@@ -481,6 +512,10 @@ struct jit_pool_conf_t {
     int dt_size;
 
     cpu_isa_t isa;
+
+    /* jit_sve_pool_kernel: nhwc instead of nChw16c, and global pooling */
+    bool is_nhwc;
+    bool is_global;
 };
 
 struct jit_pool_call_s {
@@ -498,6 +533,7 @@ struct jit_pool_call_s {
     size_t kw_padding;
     const void *init_value;
     float ker_area_h;
+    size_t c_work;
 };
 
 
@@ -58,8 +58,11 @@ namespace xa = Xbyak::Xbyak_aarch64;
 struct jit_sve_1x1_conv_kernel : public jit_generator {
     jit_sve_1x1_conv_kernel(jit_1x1_conv_conf_t ajcp,
             const primitive_attr_t &attr)
-        : jcp(ajcp), attr_(attr), eltwise_injector_(nullptr)
+        : jcp(ajcp), eltwise_injector_(nullptr)
     {
+        /* the post-ops are in jcp: the kernel, shared through the registry,
+         * may outlive @p attr */
+        UNUSED(attr);
         if (jcp.with_eltwise)
             eltwise_injector_ = new jit_uni_eltwise_injector_f32<avx512_common>(
                     this, jcp.eltwise);
@@ -90,7 +93,6 @@ struct jit_sve_1x1_conv_kernel : public jit_generator {
             const jit_1x1_conv_conf_t &jcp);
 
     jit_1x1_conv_conf_t jcp;
-    const primitive_attr_t &attr_;
     void (*jit_ker)(jit_1x1_conv_call_s *);
 
   private:
@@ -42,6 +42,7 @@
 #include "cpu_engine.hpp"
 #include "cpu_reducer.hpp"
 
+#include "jit_kernel_registry.hpp"
 #include "jit_sve_1x1_conv_kernel.hpp"
 #include "jit_sve_1x1_conv_utils.hpp"
 #include "jit_transpose_src_utils.hpp"
@@ -149,15 +150,17 @@ struct jit_sve_1x1_convolution_fwd_t : public cpu_primitive_t {
     jit_sve_1x1_convolution_fwd_t(const pd_t *apd,
             const input_vector &inputs, const output_vector &outputs)
         : cpu_primitive_t(apd, inputs, outputs)
-        , kernel_(nullptr), rtus_driver_(nullptr)
+        , rtus_driver_(nullptr)
     {
-        kernel_ =
-            new jit_sve_1x1_conv_kernel(pd()->jcp_, *pd()->attr());
+        jit_kernel_registry_t::key_t key;
+        jit_kernel_registry_t::append(key, pd()->jcp_);
+        kernel_ = jit_kernel_registry().get<jit_sve_1x1_conv_kernel>(key,
+                [&]() { return new jit_sve_1x1_conv_kernel(pd()->jcp_,
+                            *pd()->attr()); });
         init_rtus_driver<sve>(this);
     }
 
     ~jit_sve_1x1_convolution_fwd_t() {
-        delete kernel_;
         delete rtus_driver_;
     }
 
@@ -178,7 +181,7 @@ struct jit_sve_1x1_convolution_fwd_t : public cpu_primitive_t {
             const memory_tracking::grantor_t &scratchpad) const;
     const pd_t *pd() const { return (const pd_t *)primitive_t::pd(); }
 
-    jit_sve_1x1_conv_kernel *kernel_;
+    std::shared_ptr<jit_sve_1x1_conv_kernel> kernel_;
     rtus_driver_t<sve> *rtus_driver_;
 };
 
@@ -279,15 +282,17 @@ struct jit_sve_1x1_convolution_bwd_data_t : public cpu_primitive_t {
     jit_sve_1x1_convolution_bwd_data_t(const pd_t *apd,
             const input_vector &inputs, const output_vector &outputs)
         : cpu_primitive_t(apd, inputs, outputs)
-        , kernel_(nullptr), rtus_driver_(nullptr)
+        , rtus_driver_(nullptr)
     {
-        kernel_ = new jit_sve_1x1_conv_kernel(pd()->jcp_,
-                    *pd()->attr());
+        jit_kernel_registry_t::key_t key;
+        jit_kernel_registry_t::append(key, pd()->jcp_);
+        kernel_ = jit_kernel_registry().get<jit_sve_1x1_conv_kernel>(key,
+                [&]() { return new jit_sve_1x1_conv_kernel(pd()->jcp_,
+                            *pd()->attr()); });
         init_rtus_driver<sve>(this);
     }
 
     ~jit_sve_1x1_convolution_bwd_data_t() {
-        delete kernel_;
         delete rtus_driver_;
     }
 
@@ -310,7 +315,7 @@ struct jit_sve_1x1_convolution_bwd_data_t : public cpu_primitive_t {
     void execute_backward_data() const;
     const pd_t *pd() const { return (const pd_t *)primitive_t::pd(); }
 
-    jit_sve_1x1_conv_kernel *kernel_;
+    std::shared_ptr<jit_sve_1x1_conv_kernel> kernel_;
     rtus_driver_t<sve> *rtus_driver_;
 };
 
@@ -0,0 +1,891 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <assert.h>
+#include <math.h>
+
+#include <vector>
+
+#include "c_types_map.hpp"
+#include "memory_tracking.hpp"
+#include "mkldnn_thread.hpp"
+#include "nstl.hpp"
+#include "type_helpers.hpp"
+#include "utils.hpp"
+
+#include "jit_generator.hpp"
+
+#include "jit_sve_batch_normalization.hpp"
+
+#define GET_OFF(field) \
+        static_cast<int32_t>(offsetof(jit_sve_bnorm_call_s, field))
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+namespace {
+
+using namespace memory_tracking::names;
+
+#define CGA64 CodeGeneratorAArch64
+namespace xa = Xbyak::Xbyak_aarch64;
+
+typedef float acc_data_t;
+
+constexpr int simd_w = cpu_isa_traits<sve>::vlen / sizeof(acc_data_t);
+
+struct sve_bnorm_conf_t {
+    bool is_nhwc;
+    int C, C_vecs; // the coefficients of a kind are C_vecs * simd_w apart
+    bool with_relu; // fwd: ReLU on the result, bwd: mask of diff_dst
+    bool with_ws; // fwd: store the ReLU mask, bwd: load it
+    bool use_global_stats;
+};
+
+struct jit_sve_bnorm_call_s {
+    const acc_data_t *src;
+    const acc_data_t *diff_dst;
+    acc_data_t *dst; // dst or diff_src
+    uint8_t *ws;
+    const acc_data_t *coeff;
+    acc_data_t *part;
+    size_t n_pix;
+    size_t c_work;
+    acc_data_t inv_n;
+};
+
+/* Processes one vector of channels over n_pix pixels: 16 channels of the
+ * blocked formats, or c_work channels of nspc under a WHILELT predicate.
+ *   fwd_stats: part = { mean, sum((x - mean)^2) } of the pixels, from sums
+ *              of x - x[0] so that the shift keeps the variance accurate,
+ *   fwd_norm:  dst = x * coeff[0] + coeff[1], then the optional ReLU,
+ *   bwd_stats: part = { sum(dd), sum(dd * (x - coeff[0])) },
+ *   bwd_norm:  diff_src = dd * coeff[0] + x * coeff[1] + coeff[2],
+ * where dd is diff_dst under the ReLU mask. coeff[i] is at coeff +
+ * i * C_vecs * simd_w. The pixel loop is unrolled by unroll_ with one set of
+ * accumulators per unrolled pixel.
+ *
+ * The kernel follows AAPCS64 directly and keeps to caller-saved registers,
+ * so it needs no preamble. */
+struct jit_sve_bnorm_kernel : public jit_generator {
+    enum kind_t { fwd_stats, fwd_norm, bwd_stats, bwd_norm };
+
+    DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_sve_bnorm_kernel)
+
+    jit_sve_bnorm_kernel(const sve_bnorm_conf_t &conf, kind_t kind)
+        : conf_(conf), kind_(kind) {
+        generate();
+        jit_ker = (void (*)(const jit_sve_bnorm_call_s *))getCode32();
+    }
+
+    void operator()(const jit_sve_bnorm_call_s *p) const { jit_ker(p); }
+
+private:
+    using reg64_t = const xa::XReg;
+    using zreg_t = xa::ZRegS;
+
+    static constexpr int unroll_ = 4;
+
+    const sve_bnorm_conf_t conf_;
+    const kind_t kind_;
+
+    reg64_t param = abi_param1_aarch64;
+    reg64_t reg_src = x1;
+    reg64_t reg_diff_dst = x2;
+    reg64_t reg_dst = x3;
+    reg64_t reg_ws = x5;
+    reg64_t reg_coeff = x6;
+    reg64_t reg_part = x7;
+    reg64_t reg_cnt = x8;
+    reg64_t reg_c_work = x9;
+    reg64_t reg_zero = x10;
+    reg64_t reg_tmp_addr = x16;
+    reg64_t reg_tmp_imm = x17;
+
+    const xa::PReg reg_p_c = p0;
+    const xa::PReg reg_p_mask = p1;
+
+    /* z0-z7 data; z8-z15 are callee-saved */
+    zreg_t z_data(int u) { return zreg_t(u); }
+    zreg_t z_data2(int u) { return zreg_t(unroll_ + u); }
+    zreg_t z_acc1(int u) { return zreg_t(16 + u); }
+    zreg_t z_acc2(int u) { return zreg_t(20 + u); }
+    zreg_t z_coeff(int i) { return zreg_t(24 + i); }
+    zreg_t z_pow2 = zreg_t(27);
+    zreg_t z_zero = zreg_t(28);
+    zreg_t z_one = zreg_t(29);
+    zreg_t z_tmp = zreg_t(30);
+    zreg_t z_tmp2 = zreg_t(31);
+
+    void (*jit_ker)(const jit_sve_bnorm_call_s *);
+
+    int pix_bytes() const {
+        return (conf_.is_nhwc ? conf_.C : simd_w) * (int)sizeof(acc_data_t);
+    }
+    /* one bit per element for the blocked formats, one byte for nspc */
+    int ws_pix_bytes() const {
+        return conf_.is_nhwc ? conf_.C : simd_w / 8;
+    }
+
+    void add_imm(reg64_t out, reg64_t in, long long int value) {
+        long long int val = (value >= 0) ? value : -1 * value;
+        if (val <= 4095) {
+            if (value >= 0) CGA64::add(out, in, val);
+            else CGA64::sub(out, in, val);
+        } else {
+            CGA64::mov(reg_tmp_imm, val & 0xffff);
+            for (int sh = 16; sh < 64; sh += 16)
+                if (val >> sh)
+                    CGA64::movk(reg_tmp_imm, (val >> sh) & 0xffff, sh);
+            if (value >= 0) CGA64::add(out, in, reg_tmp_imm);
+            else CGA64::sub(out, in, reg_tmp_imm);
+        }
+    }
+
+    void mov_vector(const zreg_t &dst, const zreg_t &src) {
+        CGA64::orr(xa::ZRegD(dst.getIdx()), xa::ZRegD(src.getIdx()),
+                xa::ZRegD(src.getIdx()));
+    }
+
+    /* blocked pixels are one vector apart and use LDR/STR with an offset in
+     * vector lengths, nspc pixels are predicated by the channel tail */
+    void load_data(const zreg_t &z, reg64_t base, long long int offset) {
+        if (!conf_.is_nhwc && offset >> 6 <= 255) {
+            CGA64::ldr(xa::ZReg(z.getIdx()),
+                    xa::ptr(base, static_cast<int32_t>(offset >> 6)));
+        } else if (offset == 0) {
+            CGA64::ld1w(z, reg_p_c / xa::T_z, xa::ptr(base));
+        } else {
+            add_imm(reg_tmp_addr, base, offset);
+            CGA64::ld1w(z, reg_p_c / xa::T_z, xa::ptr(reg_tmp_addr));
+        }
+    }
+
+    void store_data(const zreg_t &z, reg64_t base, long long int offset) {
+        if (!conf_.is_nhwc && offset >> 6 <= 255) {
+            CGA64::str(xa::ZReg(z.getIdx()),
+                    xa::ptr(base, static_cast<int32_t>(offset >> 6)));
+        } else if (offset == 0) {
+            CGA64::st1w(z, reg_p_c, xa::ptr(base));
+        } else {
+            add_imm(reg_tmp_addr, base, offset);
+            CGA64::st1w(z, reg_p_c, xa::ptr(reg_tmp_addr));
+        }
+    }
+
+    void load_coeff(const zreg_t &z, int i) {
+        const long long int offset = (long long int)i * conf_.C_vecs * simd_w
+            * sizeof(acc_data_t);
+        if (offset == 0) {
+            CGA64::ld1w(z, reg_p_c / xa::T_z, xa::ptr(reg_coeff));
+        } else {
+            add_imm(reg_tmp_addr, reg_coeff, offset);
+            CGA64::ld1w(z, reg_p_c / xa::T_z, xa::ptr(reg_tmp_addr));
+        }
+    }
+
+    /* The 16 mask bits of a blocked pixel are gathered as a halfword: lane
+     * i contributes 1 << i, the lanes are OR-ed together. */
+    void store_mask(long long int offset) {
+        reg64_t addr = offset == 0 ? reg_ws : reg_tmp_addr;
+        if (offset != 0) add_imm(reg_tmp_addr, reg_ws, offset);
+        if (conf_.is_nhwc) {
+            CGA64::sel(z_tmp, reg_p_mask, z_one, z_zero);
+            CGA64::st1b(z_tmp, reg_p_c, xa::ptr(addr));
+        } else {
+            CGA64::sel(z_tmp, reg_p_mask, z_pow2, z_zero);
+            CGA64::orv(xa::SReg(z_tmp.getIdx()), reg_p_c, z_tmp);
+            CGA64::str(xa::HReg(z_tmp.getIdx()), xa::ptr(addr));
+        }
+    }
+
+    void load_mask(long long int offset) {
+        reg64_t addr = offset == 0 ? reg_ws : reg_tmp_addr;
+        if (offset != 0) add_imm(reg_tmp_addr, reg_ws, offset);
+        if (conf_.is_nhwc) {
+            CGA64::ld1b(z_tmp, reg_p_c / xa::T_z, xa::ptr(addr));
+        } else {
+            CGA64::ld1rh(z_tmp, reg_p_c / xa::T_z, xa::ptr(addr));
+            CGA64::and_(xa::ZRegD(z_tmp.getIdx()), xa::ZRegD(z_tmp.getIdx()),
+                    xa::ZRegD(z_pow2.getIdx()));
+        }
+        CGA64::cmpne(reg_p_mask.s, reg_p_c / xa::T_z, z_tmp, 0);
+    }
+
+    /* dd under the ReLU mask */
+    void load_diff_dst(const zreg_t &z, int u) {
+        load_data(z, reg_diff_dst, (long long int)u * pix_bytes());
+        if (conf_.with_relu) {
+            load_mask((long long int)u * ws_pix_bytes());
+            CGA64::sel(z, reg_p_mask, z, z_zero);
+        }
+    }
+
+    void compute_pixel(int u) {
+        const long long int off = (long long int)u * pix_bytes();
+        const zreg_t z = z_data(u);
+        const zreg_t x = z_data2(u);
+
+        switch (kind_) {
+        case fwd_stats:
+            load_data(z, reg_src, off);
+            CGA64::fsub(z, z, z_coeff(0));
+            CGA64::fadd(z_acc1(u), z_acc1(u), z);
+            CGA64::fmla(z_acc2(u), reg_p_c / xa::T_m, z, z);
+            break;
+        case fwd_norm:
+            load_data(z, reg_src, off);
+            CGA64::fmad(z, reg_p_c / xa::T_m, z_coeff(0), z_coeff(1));
+            if (conf_.with_relu) {
+                if (conf_.with_ws) {
+                    CGA64::fcmgt(reg_p_mask.s, reg_p_c / xa::T_z, z, 0.0);
+                    store_mask((long long int)u * ws_pix_bytes());
+                }
+                CGA64::fmax(z, reg_p_c / xa::T_m, 0.0f);
+            }
+            store_data(z, reg_dst, off);
+            break;
+        case bwd_stats:
+            load_diff_dst(z, u);
+            load_data(x, reg_src, off);
+            CGA64::fsub(x, x, z_coeff(0));
+            CGA64::fadd(z_acc1(u), z_acc1(u), z);
+            CGA64::fmla(z_acc2(u), reg_p_c / xa::T_m, z, x);
+            break;
+        case bwd_norm:
+            load_diff_dst(z, u);
+            if (conf_.use_global_stats) {
+                CGA64::fmul(x, z, z_coeff(0));
+            } else {
+                load_data(x, reg_src, off);
+                CGA64::fmad(x, reg_p_c / xa::T_m, z_coeff(1), z_coeff(2));
+                CGA64::fmla(x, reg_p_c / xa::T_m, z, z_coeff(0));
+            }
+            store_data(x, reg_dst, off);
+            break;
+        }
+    }
+
+    void advance(int npix) {
+        const long long int off = (long long int)npix * pix_bytes();
+        if (!(kind_ == bwd_norm && conf_.use_global_stats))
+            add_imm(reg_src, reg_src, off);
+        if (utils::one_of(kind_, bwd_stats, bwd_norm))
+            add_imm(reg_diff_dst, reg_diff_dst, off);
+        if (utils::one_of(kind_, fwd_norm, bwd_norm))
+            add_imm(reg_dst, reg_dst, off);
+        if (conf_.with_ws)
+            add_imm(reg_ws, reg_ws, (long long int)npix * ws_pix_bytes());
+    }
+
+    void generate() {
+        const bool is_stats = utils::one_of(kind_, fwd_stats, bwd_stats);
+
+        CGA64::ldr(reg_src, xa::ptr(param, GET_OFF(src)));
+        if (utils::one_of(kind_, bwd_stats, bwd_norm))
+            CGA64::ldr(reg_diff_dst, xa::ptr(param, GET_OFF(diff_dst)));
+        if (utils::one_of(kind_, fwd_norm, bwd_norm))
+            CGA64::ldr(reg_dst, xa::ptr(param, GET_OFF(dst)));
+        if (conf_.with_ws)
+            CGA64::ldr(reg_ws, xa::ptr(param, GET_OFF(ws)));
+        if (kind_ != fwd_stats)
+            CGA64::ldr(reg_coeff, xa::ptr(param, GET_OFF(coeff)));
+        if (is_stats)
+            CGA64::ldr(reg_part, xa::ptr(param, GET_OFF(part)));
+        CGA64::ldr(reg_cnt, xa::ptr(param, GET_OFF(n_pix)));
+        CGA64::ldr(reg_c_work, xa::ptr(param, GET_OFF(c_work)));
+
+        CGA64::mov(reg_zero, 0);
+        CGA64::whilelt(reg_p_c.s, reg_zero, reg_c_work);
+
+        CGA64::fmov(z_zero);
+        if (conf_.with_ws) {
+            CGA64::dup(z_one, 1);
+            if (!conf_.is_nhwc) {
+                /* z_pow2 = { 1 << 0, 1 << 1, ..., 1 << 15 } */
+                CGA64::index(z_tmp, 0, 1);
+                mov_vector(z_pow2, z_one);
+                CGA64::lsl(z_pow2, reg_p_c / xa::T_m, z_tmp);
+            }
+        }
+
+        switch (kind_) {
+        case fwd_stats:
+            /* the shift: the first pixel */
+            load_data(z_coeff(0), reg_src, 0);
+            break;
+        case fwd_norm:
+            load_coeff(z_coeff(0), 0);
+            load_coeff(z_coeff(1), 1);
+            break;
+        case bwd_stats:
+            load_coeff(z_coeff(0), 0);
+            break;
+        case bwd_norm:
+            load_coeff(z_coeff(0), 0);
+            if (!conf_.use_global_stats) {
+                load_coeff(z_coeff(1), 1);
+                load_coeff(z_coeff(2), 2);
+            }
+            break;
+        }
+        if (is_stats) {
+            for (int u = 0; u < unroll_; u++) {
+                CGA64::fmov(z_acc1(u));
+                CGA64::fmov(z_acc2(u));
+            }
+        }
+
+        xa::LabelAArch64 unrolled_loop;
+        xa::LabelAArch64 tail_loop;
+        xa::LabelAArch64 exit_label;
+
+        CGA64::L_aarch64(unrolled_loop); {
+            CGA64::cmp(reg_cnt, unroll_);
+            CGA64::b(xa::LT, tail_loop);
+
+            for (int u = 0; u < unroll_; u++)
+                compute_pixel(u);
+            advance(unroll_);
+
+            CGA64::sub(reg_cnt, reg_cnt, unroll_);
+            CGA64::b(unrolled_loop);
+        }
+
+        CGA64::L_aarch64(tail_loop); {
+            CGA64::cmp(reg_cnt, 0);
+            CGA64::b(xa::LE, exit_label);
+
+            compute_pixel(0);
+            advance(1);
+
+            CGA64::sub(reg_cnt, reg_cnt, 1);
+            CGA64::b(tail_loop);
+        }
+
+        CGA64::L_aarch64(exit_label);
+
+        if (is_stats) {
+            for (int u = 1; u < unroll_; u++) {
+                CGA64::fadd(z_acc1(0), z_acc1(0), z_acc1(u));
+                CGA64::fadd(z_acc2(0), z_acc2(0), z_acc2(u));
+            }
+            if (kind_ == fwd_stats) {
+                /* mean = shift + s / n, m2 = q - s * s / n */
+                CGA64::ld1rw(z_tmp2, reg_p_c / xa::T_z,
+                        xa::ptr(param, GET_OFF(inv_n)));
+                CGA64::fmul(z_tmp, z_acc1(0), z_tmp2);
+                CGA64::fmls(z_acc2(0), reg_p_c / xa::T_m, z_acc1(0), z_tmp);
+                CGA64::fadd(z_acc1(0), z_coeff(0), z_tmp);
+            }
+            CGA64::str(xa::ZReg(z_acc1(0).getIdx()), xa::ptr(reg_part));
+            CGA64::str(xa::ZReg(z_acc2(0).getIdx()), xa::ptr(reg_part, 1));
+        }
+
+        CGA64::ret();
+    }
+};
+
+struct sve_bnorm_driver_t : public c_compatible {
+    sve_bnorm_driver_t(const batch_normalization_pd_t *bdesc, int nsp)
+        : bdesc_(bdesc), nsp_(nsp), ker_stats_(nullptr), ker_norm_(nullptr) {
+        conf_ = init_conf(bdesc_);
+        N_ = bdesc_->MB();
+        SP_ = bdesc_->D() * bdesc_->H() * bdesc_->W();
+
+        using kind_t = jit_sve_bnorm_kernel::kind_t;
+        if (bdesc_->is_fwd()) {
+            if (!bdesc_->stats_is_src())
+                ker_stats_ = new jit_sve_bnorm_kernel(conf_,
+                        kind_t::fwd_stats);
+            ker_norm_ = new jit_sve_bnorm_kernel(conf_, kind_t::fwd_norm);
+        } else {
+            if (need_bwd_stats(bdesc_))
+                ker_stats_ = new jit_sve_bnorm_kernel(conf_,
+                        kind_t::bwd_stats);
+            ker_norm_ = new jit_sve_bnorm_kernel(conf_, kind_t::bwd_norm);
+        }
+    }
+
+    ~sve_bnorm_driver_t() {
+        delete ker_stats_;
+        delete ker_norm_;
+    }
+
+    static sve_bnorm_conf_t init_conf(const batch_normalization_pd_t *bdesc) {
+        using namespace memory_format;
+        sve_bnorm_conf_t conf;
+        conf.is_nhwc = utils::one_of(bdesc->src_pd()->desc()->format,
+                nhwc, ndhwc);
+        conf.C = bdesc->C();
+        conf.C_vecs = utils::div_up(conf.C, simd_w);
+        conf.use_global_stats = bdesc->use_global_stats();
+        if (bdesc->is_fwd()) {
+            conf.with_relu = bdesc->with_relu_post_op()
+                || bdesc->fuse_bn_relu();
+            conf.with_ws = bdesc->fuse_bn_relu() && bdesc->is_training();
+        } else {
+            conf.with_relu = conf.with_ws = bdesc->fuse_bn_relu();
+        }
+        return conf;
+    }
+
+    /* Number of spatial chunks of an (n, c) vector: enough pieces to occupy
+     * all the threads, of 64 pixels at least. Computed once by the pd, which
+     * sizes the scratchpad for it. */
+    static int nthr_sp(const batch_normalization_pd_t *bdesc) {
+        const int min_pix = 64;
+        const int work = bdesc->MB() * utils::div_up(bdesc->C(), simd_w);
+        const int sp = bdesc->D() * bdesc->H() * bdesc->W();
+        const int nthr = mkldnn_get_max_threads();
+        if (work >= nthr) return 1;
+        return nstl::max(1, nstl::min(utils::div_up(nthr, work),
+                    sp / min_pix));
+    }
+
+    static bool need_bwd_stats(const batch_normalization_pd_t *bdesc) {
+        return !bdesc->use_global_stats()
+            || (bdesc->desc()->prop_kind == prop_kind::backward
+                    && bdesc->use_scaleshift());
+    }
+
+    static void init_scratchpad(memory_tracking::registrar_t &scratchpad,
+            const batch_normalization_pd_t *bdesc, int nsp) {
+        const size_t C_PADDED = utils::rnd_up(bdesc->C(), simd_w);
+        const size_t nparts = (size_t)bdesc->MB() * nsp
+            * utils::div_up(bdesc->C(), simd_w);
+
+        /* the coefficients, then the partial results of the pieces */
+        const size_t rbuf_sz = 3 * C_PADDED + 2 * simd_w * nparts;
+        const bool tmp_stats = bdesc->is_fwd() && !bdesc->stats_is_src()
+            && !bdesc->is_training();
+        const bool tmp_diff_ss = bdesc->is_bwd()
+            && (bdesc->desc()->prop_kind == prop_kind::backward_data
+                    || !bdesc->use_scaleshift());
+
+        scratchpad.book(key_bnorm_reduction, sizeof(acc_data_t) * rbuf_sz);
+        if (tmp_stats)
+            scratchpad.book(key_bnorm_tmp_stats,
+                    sizeof(acc_data_t) * 2 * C_PADDED);
+        if (tmp_diff_ss)
+            scratchpad.book(key_bnorm_tmp_diff_ss,
+                    sizeof(acc_data_t) * 2 * C_PADDED);
+    }
+
+    void exec_fwd(const acc_data_t *src, acc_data_t *dst,
+            const acc_data_t *scale_shift, acc_data_t *mean, acc_data_t *var,
+            uint8_t *ws, const memory_tracking::grantor_t &scratchpad) const;
+    void exec_bwd(const acc_data_t *src, const acc_data_t *diff_dst,
+            const acc_data_t *scale_shift, const acc_data_t *mean,
+            const acc_data_t *var, const uint8_t *ws, acc_data_t *diff_src,
+            acc_data_t *diff_scale_shift,
+            const memory_tracking::grantor_t &scratchpad) const;
+
+private:
+    /* offsets, in elements, of pixel sp of channel vector cb of image n */
+    size_t data_off(int n, int cb, int sp) const {
+        return conf_.is_nhwc
+            ? ((size_t)n * SP_ + sp) * conf_.C + (size_t)cb * simd_w
+            : (((size_t)n * conf_.C_vecs + cb) * SP_ + sp) * simd_w;
+    }
+    size_t ws_off(int n, int cb, int sp) const {
+        return conf_.is_nhwc ? data_off(n, cb, sp) : data_off(n, cb, sp) / 8;
+    }
+    size_t c_work(int cb) const {
+        return conf_.is_nhwc
+            ? nstl::min(simd_w, conf_.C - cb * simd_w) : simd_w;
+    }
+    size_t part_off(int cb, int n, int s) const {
+        return (((size_t)cb * N_ + n) * nsp_ + s) * 2 * simd_w;
+    }
+
+    /* Calls ker on every (cb, n, spatial chunk) piece: f(cb, n, s, sp_s,
+     * sp_e, p) completes the call arguments. */
+    template <typename F>
+    void for_pieces(const jit_sve_bnorm_kernel *ker, F f) const {
+        parallel_nd(conf_.C_vecs, N_, nsp_, [&](int cb, int n, int s) {
+            int sp_s{0}, sp_e{0};
+            balance211(SP_, nsp_, s, sp_s, sp_e);
+            if (sp_s == sp_e) return;
+
+            jit_sve_bnorm_call_s p = {};
+            p.n_pix = sp_e - sp_s;
+            p.c_work = c_work(cb);
+            f(cb, n, s, sp_s, sp_e, p);
+            (*ker)(&p);
+        });
+    }
+
+    const batch_normalization_pd_t *bdesc_;
+    sve_bnorm_conf_t conf_;
+    int N_, SP_;
+    const int nsp_;
+
+    jit_sve_bnorm_kernel *ker_stats_;
+    jit_sve_bnorm_kernel *ker_norm_;
+};
+
+void sve_bnorm_driver_t::exec_fwd(const acc_data_t *src, acc_data_t *dst,
+        const acc_data_t *scale_shift, acc_data_t *mean, acc_data_t *var,
+        uint8_t *ws, const memory_tracking::grantor_t &scratchpad) const {
+    const int C = conf_.C;
+    const int C_PADDED = conf_.C_vecs * simd_w;
+    const bool use_scaleshift = bdesc_->use_scaleshift();
+    const acc_data_t eps = bdesc_->desc()->batch_norm_epsilon;
+
+    auto rbuf = scratchpad.get<acc_data_t>(key_bnorm_reduction);
+    acc_data_t *coeff = rbuf;
+    acc_data_t *part = rbuf + 3 * C_PADDED;
+    if (!mean) {
+        mean = scratchpad.get<acc_data_t>(key_bnorm_tmp_stats);
+        var = mean + C_PADDED;
+    }
+
+    if (!bdesc_->stats_is_src()) {
+        for_pieces(ker_stats_, [&](int cb, int n, int s, int sp_s, int sp_e,
+                    jit_sve_bnorm_call_s &p) {
+            p.src = &src[data_off(n, cb, sp_s)];
+            p.part = &part[part_off(cb, n, s)];
+            p.inv_n = 1.f / (sp_e - sp_s);
+        });
+    }
+
+    /* the pixel counts of the pieces are the same for every vector:
+     * pieces [i, j) hold cnt[j] - cnt[i] pixels */
+    const int nparts = N_ * nsp_;
+    std::vector<acc_data_t> cnt(nparts + 1, 0);
+    if (!bdesc_->stats_is_src()) {
+        for (int i = 0; i < nparts; i++) {
+            int sp_s{0}, sp_e{0};
+            balance211(SP_, nsp_, i % nsp_, sp_s, sp_e);
+            cnt[i + 1] = cnt[i] + (acc_data_t)(sp_e - sp_s);
+        }
+    }
+
+    parallel_nd(conf_.C_vecs, [&](int cb) {
+        const int c_s = cb * simd_w;
+        const int c_e = nstl::min(C, c_s + simd_w);
+
+        if (!bdesc_->stats_is_src()) {
+            /* pairwise tree merge of the pieces of the vector:
+             * delta = mean_b - mean_a, n = n_a + n_b,
+             * mean = mean_a + delta * n_b / n,
+             * m2 = m2_a + m2_b + delta^2 * n_a * n_b / n */
+            acc_data_t *pcb = &part[part_off(cb, 0, 0)];
+            for (int step = 1; step < nparts; step *= 2)
+            for (int i = 0; i + step < nparts; i += 2 * step) {
+                const int j = nstl::min(i + 2 * step, nparts);
+                const acc_data_t na = cnt[i + step] - cnt[i];
+                const acc_data_t nb = cnt[j] - cnt[i + step];
+                if (nb == 0) continue;
+                acc_data_t *a = &pcb[(size_t)i * 2 * simd_w];
+                const acc_data_t *b = &pcb[(size_t)(i + step) * 2 * simd_w];
+                const acc_data_t n = na + nb;
+                PRAGMA_OMP_SIMD()
+                for (int l = 0; l < simd_w; l++) {
+                    const acc_data_t delta = b[l] - a[l];
+                    a[l] += delta * nb / n;
+                    a[simd_w + l] += b[simd_w + l] + delta * delta * na * nb
+                        / n;
+                }
+            }
+            for (int c = c_s; c < c_e; c++) {
+                mean[c] = pcb[c - c_s];
+                var[c] = pcb[simd_w + c - c_s] / (N_ * SP_);
+            }
+        }
+
+        for (int c = c_s; c < c_s + simd_w; c++) {
+            if (c >= c_e) {
+                coeff[c] = coeff[C_PADDED + c] = 0;
+                continue;
+            }
+            const acc_data_t gamma = use_scaleshift ? scale_shift[c] : 1;
+            const acc_data_t beta = use_scaleshift ? scale_shift[C + c] : 0;
+            const acc_data_t sm = gamma / sqrtf(var[c] + eps);
+            coeff[c] = sm;
+            coeff[C_PADDED + c] = beta - mean[c] * sm;
+        }
+    });
+
+    for_pieces(ker_norm_, [&](int cb, int n, int s, int sp_s, int sp_e,
+                jit_sve_bnorm_call_s &p) {
+        p.src = &src[data_off(n, cb, sp_s)];
+        p.dst = &dst[data_off(n, cb, sp_s)];
+        if (conf_.with_ws) p.ws = &ws[ws_off(n, cb, sp_s)];
+        p.coeff = &coeff[cb * simd_w];
+    });
+}
+
+void sve_bnorm_driver_t::exec_bwd(const acc_data_t *src,
+        const acc_data_t *diff_dst, const acc_data_t *scale_shift,
+        const acc_data_t *mean, const acc_data_t *var, const uint8_t *ws,
+        acc_data_t *diff_src, acc_data_t *diff_scale_shift,
+        const memory_tracking::grantor_t &scratchpad) const {
+    const int C = conf_.C;
+    const int C_PADDED = conf_.C_vecs * simd_w;
+    const bool use_scaleshift = bdesc_->use_scaleshift();
+    const bool calc_diff_ss = need_bwd_stats(bdesc_);
+    const acc_data_t eps = bdesc_->desc()->batch_norm_epsilon;
+
+    auto rbuf = scratchpad.get<acc_data_t>(key_bnorm_reduction);
+    acc_data_t *coeff = rbuf;
+    acc_data_t *part = rbuf + 3 * C_PADDED;
+    if (!diff_scale_shift)
+        diff_scale_shift = scratchpad.get<acc_data_t>(key_bnorm_tmp_diff_ss);
+
+    if (calc_diff_ss) {
+        /* the kernel reads whole vectors of the mean, so it is padded */
+        for (int c = 0; c < C_PADDED; c++)
+            coeff[c] = c < C ? mean[c] : 0;
+
+        for_pieces(ker_stats_, [&](int cb, int n, int s, int sp_s, int sp_e,
+                    jit_sve_bnorm_call_s &p) {
+            p.src = &src[data_off(n, cb, sp_s)];
+            p.diff_dst = &diff_dst[data_off(n, cb, sp_s)];
+            if (conf_.with_ws)
+                p.ws = const_cast<uint8_t *>(&ws[ws_off(n, cb, sp_s)]);
+            p.coeff = &coeff[cb * simd_w];
+            p.part = &part[part_off(cb, n, s)];
+        });
+    }
+
+    parallel_nd(conf_.C_vecs, [&](int cb) {
+        const int c_s = cb * simd_w;
+        const int c_e = nstl::min(C, c_s + simd_w);
+        acc_data_t *pcb = &part[part_off(cb, 0, 0)];
+
+        if (calc_diff_ss) {
+            /* pairwise tree sum of the pieces of the vector */
+            const int nparts = N_ * nsp_;
+            for (int step = 1; step < nparts; step *= 2)
+            for (int i = 0; i + step < nparts; i += 2 * step) {
+                acc_data_t *a = &pcb[(size_t)i * 2 * simd_w];
+                const acc_data_t *b = &pcb[(size_t)(i + step) * 2 * simd_w];
+                PRAGMA_OMP_SIMD()
+                for (int l = 0; l < 2 * simd_w; l++)
+                    a[l] += b[l];
+            }
+        }
+
+        for (int c = c_s; c < c_s + simd_w; c++) {
+            if (c >= c_e) {
+                coeff[c] = coeff[C_PADDED + c] = coeff[2 * C_PADDED + c] = 0;
+                continue;
+            }
+            const acc_data_t gamma = use_scaleshift ? scale_shift[c] : 1;
+            const acc_data_t inv_sqrt = 1.f / sqrtf(var[c] + eps);
+            const acc_data_t k = gamma * inv_sqrt;
+
+            acc_data_t diff_gamma = 0, diff_beta = 0;
+            if (calc_diff_ss) {
+                diff_beta = pcb[c - c_s];
+                diff_gamma = pcb[simd_w + c - c_s] * inv_sqrt;
+                diff_scale_shift[c] = diff_gamma;
+                diff_scale_shift[C + c] = diff_beta;
+            }
+
+            coeff[c] = k;
+            if (conf_.use_global_stats) {
+                coeff[C_PADDED + c] = coeff[2 * C_PADDED + c] = 0;
+            } else {
+                const acc_data_t inv_n = 1.f / (N_ * SP_);
+                const acc_data_t b = -k * inv_sqrt * diff_gamma * inv_n;
+                coeff[C_PADDED + c] = b;
+                coeff[2 * C_PADDED + c] = -k * diff_beta * inv_n
+                    - b * mean[c];
+            }
+        }
+    });
+
+    for_pieces(ker_norm_, [&](int cb, int n, int s, int sp_s, int sp_e,
+                jit_sve_bnorm_call_s &p) {
+        p.src = &src[data_off(n, cb, sp_s)];
+        p.diff_dst = &diff_dst[data_off(n, cb, sp_s)];
+        p.dst = &diff_src[data_off(n, cb, sp_s)];
+        if (conf_.with_ws)
+            p.ws = const_cast<uint8_t *>(&ws[ws_off(n, cb, sp_s)]);
+        p.coeff = &coeff[cb * simd_w];
+    });
+}
+
+}
+
+using namespace data_type;
+using namespace memory_format;
+using namespace utils;
+
+/* fwd */
+status_t jit_sve_batch_normalization_fwd_t::pd_t::init() {
+    assert(engine()->kind() == engine_kind::cpu);
+
+    bool ok = true
+        && mayiuse(sve)
+        && is_fwd()
+        && !has_zero_dim_memory()
+        && one_of(ndims(), 4, 5)
+        && desc()->data_desc.data_type == f32
+        && IMPLICATION(use_scaleshift(),
+                desc()->data_scaleshift_desc.data_type == f32)
+        && (ndims() == 4
+                ? one_of(desc()->data_desc.format, nChw16c, nhwc)
+                : one_of(desc()->data_desc.format, nCdhw16c, ndhwc))
+        && (attr()->has_default_values() || this->with_relu_post_op());
+    if (!ok) return status::unimplemented;
+
+    const bool is_nhwc = one_of(desc()->data_desc.format, nhwc, ndhwc);
+    if (is_training() && fuse_bn_relu())
+        bn_init_default_ws(this, this->workspace_pd_, is_nhwc ? 8 : 1);
+
+    if (stats_is_src() || is_training()) {
+        memory_desc_t stats_d;
+        dims_t stats_dims = { C() };
+        mkldnn_memory_desc_init(&stats_d, 1, stats_dims, f32, x);
+        mean_pd_ = cpu_memory_t::pd_t(engine_, &stats_d);
+        variance_pd_ = cpu_memory_t::pd_t(engine_, &stats_d);
+    }
+
+    nthr_sp_ = sve_bnorm_driver_t::nthr_sp(this);
+    auto scratchpad = scratchpad_registry().registrar();
+    sve_bnorm_driver_t::init_scratchpad(scratchpad, this, nthr_sp_);
+
+    return status::success;
+}
+
+jit_sve_batch_normalization_fwd_t::jit_sve_batch_normalization_fwd_t(
+        const pd_t *apd, const input_vector &inputs,
+        const output_vector &outputs)
+    : cpu_primitive_t(apd, inputs, outputs) {
+    bnorm_driver_ = new sve_bnorm_driver_t(pd(), pd()->nthr_sp_);
+}
+
+void jit_sve_batch_normalization_fwd_t::execute(event_t *e) const {
+    const memory_desc_wrapper data_d(pd()->src_pd());
+    const size_t offset = data_d.blocking_desc().offset_padding;
+
+    auto src = reinterpret_cast<const data_t *>(this->input_memory(0))
+        + offset;
+    auto dst = reinterpret_cast<data_t *>(this->memory(0)) + offset;
+    auto mean = reinterpret_cast<acc_data_t *>(pd()->stats_is_src()
+                    ? const_cast<char *>(this->input_memory(1))
+                    : this->memory(1));
+    auto var = reinterpret_cast<acc_data_t *>(pd()->stats_is_src()
+                    ? const_cast<char *>(this->input_memory(2))
+                    : this->memory(2));
+
+    auto idx_scale_shift = 1 + 2*pd()->stats_is_src();
+    auto scale_shift = reinterpret_cast<const acc_data_t *>(
+            this->input_memory(idx_scale_shift));
+    auto ws = reinterpret_cast<uint8_t *>(this->memory(pd()->ws_idx()));
+
+    /* inference without statistics keeps them in the scratchpad */
+    if (!pd()->stats_is_src() && !pd()->is_training())
+        mean = var = nullptr;
+
+    bnorm_driver_->exec_fwd(src, dst, scale_shift, mean, var, ws,
+            this->scratchpad());
+    e->set_state(event_t::ready);
+}
+
+jit_sve_batch_normalization_fwd_t::~jit_sve_batch_normalization_fwd_t() {
+    delete bnorm_driver_;
+}
+
+/* bwd */
+status_t jit_sve_batch_normalization_bwd_t::pd_t::init() {
+    assert(engine()->kind() == engine_kind::cpu);
+
+    bool ok = true
+        && mayiuse(sve)
+        && is_bwd()
+        && !has_zero_dim_memory()
+        && one_of(ndims(), 4, 5)
+        && everyone_is(f32, desc()->data_desc.data_type,
+                desc()->diff_data_desc.data_type)
+        && IMPLICATION(use_scaleshift(), utils::everyone_is(f32,
+                desc()->data_scaleshift_desc.data_type,
+                desc()->diff_data_scaleshift_desc.data_type))
+        && (ndims() == 4
+                ? one_of(desc()->data_desc.format, nChw16c, nhwc)
+                : one_of(desc()->data_desc.format, nCdhw16c, ndhwc))
+        && desc()->diff_data_desc.format == desc()->data_desc.format
+        && attr()->has_default_values();
+    if (!ok) return status::unimplemented;
+
+    if (fuse_bn_relu()) {
+        const bool is_nhwc = one_of(desc()->data_desc.format, nhwc, ndhwc);
+        bn_init_default_ws(this, this->workspace_pd_, is_nhwc ? 8 : 1);
+        size_t this_ws_sz = memory_desc_wrapper(this->workspace_pd()).size();
+
+        bool ws_ok = true
+            && hint_fwd_pd_->workspace_pd()
+            && memory_desc_wrapper(hint_fwd_pd_->workspace_pd()).size()
+            == this_ws_sz;
+        if (!ws_ok) return status::unimplemented;
+    }
+
+    nthr_sp_ = sve_bnorm_driver_t::nthr_sp(this);
+    auto scratchpad = scratchpad_registry().registrar();
+    sve_bnorm_driver_t::init_scratchpad(scratchpad, this, nthr_sp_);
+
+    return status::success;
+}
+
+jit_sve_batch_normalization_bwd_t::jit_sve_batch_normalization_bwd_t(
+        const pd_t *apd, const input_vector &inputs,
+        const output_vector &outputs)
+    : cpu_primitive_t(apd, inputs, outputs) {
+    bnorm_driver_ = new sve_bnorm_driver_t(pd(), pd()->nthr_sp_);
+}
+
+void jit_sve_batch_normalization_bwd_t::execute(event_t *e) const {
+    const memory_desc_wrapper data_d(pd()->src_pd());
+    const memory_desc_wrapper diff_data_d(pd()->diff_src_pd());
+
+    auto src = reinterpret_cast<const data_t *>(this->input_memory(0))
+        + data_d.blocking_desc().offset_padding;
+    auto mean = reinterpret_cast<const acc_data_t *>(this->input_memory(1));
+    auto var = reinterpret_cast<const acc_data_t *>(this->input_memory(2));
+    auto diff_dst = reinterpret_cast<const data_t *>(this->input_memory(3))
+        + memory_desc_wrapper(pd()->diff_dst_pd())
+                .blocking_desc().offset_padding;
+    auto scale_shift
+            = reinterpret_cast<const acc_data_t *>(this->input_memory(4));
+    auto diff_src = reinterpret_cast<data_t *>(this->memory(0))
+        + diff_data_d.blocking_desc().offset_padding;
+    auto diff_scale_shift = reinterpret_cast<acc_data_t *>(this->memory(1));
+    auto ws = reinterpret_cast<const uint8_t *>(
+            this->input_memory(pd()->ws_idx()));
+
+    if (pd()->desc()->prop_kind == prop_kind::backward_data
+            || !pd()->use_scaleshift())
+        diff_scale_shift = nullptr;
+
+    bnorm_driver_->exec_bwd(src, diff_dst, scale_shift, mean, var, ws,
+            diff_src, diff_scale_shift, this->scratchpad());
+    e->set_state(event_t::ready);
+}
+
+jit_sve_batch_normalization_bwd_t::~jit_sve_batch_normalization_bwd_t() {
+    delete bnorm_driver_;
+}
+
+}
+}
+}
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -0,0 +1,115 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_JIT_SVE_BATCH_NORMALIZATION_HPP
+#define CPU_JIT_SVE_BATCH_NORMALIZATION_HPP
+
+#include <assert.h>
+
+#include "c_types_map.hpp"
+#include "type_helpers.hpp"
+#include "utils.hpp"
+
+#include "cpu_batch_normalization_pd.hpp"
+#include "jit_generator.hpp"
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+namespace { struct sve_bnorm_driver_t; }
+
+/* f32 batch normalization on SVE for nChw16c, nCdhw16c, nhwc and ndhwc.
+ *
+ * The statistics are computed in a single read of src: every (n, c, chunk of
+ * spatial) piece yields its mean and sum of squared deviations, which are
+ * merged pairwise in a tree (Chan et al.). The pieces are independent, so the
+ * passes are separate parallel regions instead of passes joined by
+ * simple_barrier. ReLU is fused into the normalization, with the mask kept
+ * in the workspace in training: one bit per element for the blocked
+ * formats, as jit_uni, and one byte per element for the nspc ones, as
+ * nspc_batch_normalization. */
+struct jit_sve_batch_normalization_fwd_t : public cpu_primitive_t {
+    struct pd_t : public cpu_batch_normalization_fwd_pd_t {
+        pd_t(engine_t *engine, const batch_normalization_desc_t *adesc,
+                const primitive_attr_t *attr,
+                const batch_normalization_fwd_pd_t *hint_fwd_pd)
+            : cpu_batch_normalization_fwd_pd_t(engine, adesc, attr,
+                    hint_fwd_pd)
+            , nthr_sp_(1) {}
+
+        DECLARE_COMMON_PD_T(JIT_IMPL_NAME_HELPER("jit:", sve, ""),
+                jit_sve_batch_normalization_fwd_t);
+
+        virtual status_t init() override;
+
+        /* spatial chunks per (n, c) vector, the scratchpad is sized for */
+        int nthr_sp_;
+    };
+
+    typedef float data_t;
+
+    jit_sve_batch_normalization_fwd_t(const pd_t *apd,
+            const input_vector &inputs, const output_vector &outputs);
+    ~jit_sve_batch_normalization_fwd_t();
+
+    virtual void execute(event_t *e) const;
+
+private:
+    const pd_t *pd() const { return (const pd_t *)primitive_t::pd(); }
+
+    sve_bnorm_driver_t *bnorm_driver_;
+};
+
+struct jit_sve_batch_normalization_bwd_t : public cpu_primitive_t {
+    struct pd_t : public cpu_batch_normalization_bwd_pd_t {
+        pd_t(engine_t *engine, const batch_normalization_desc_t *adesc,
+                const primitive_attr_t *attr,
+                const batch_normalization_fwd_pd_t *hint_fwd_pd)
+            : cpu_batch_normalization_bwd_pd_t(engine, adesc, attr,
+                    hint_fwd_pd)
+            , nthr_sp_(1) {}
+
+        DECLARE_COMMON_PD_T(JIT_IMPL_NAME_HELPER("jit:", sve, ""),
+                jit_sve_batch_normalization_bwd_t);
+
+        virtual status_t init() override;
+
+        /* spatial chunks per (n, c) vector, the scratchpad is sized for */
+        int nthr_sp_;
+    };
+
+    typedef float data_t;
+
+    jit_sve_batch_normalization_bwd_t(const pd_t *apd,
+            const input_vector &inputs, const output_vector &outputs);
+    ~jit_sve_batch_normalization_bwd_t();
+
+    virtual void execute(event_t *e) const;
+
+private:
+    const pd_t *pd() const { return (const pd_t *)primitive_t::pd(); }
+
+    sve_bnorm_driver_t *bnorm_driver_;
+};
+
+}
+}
+}
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
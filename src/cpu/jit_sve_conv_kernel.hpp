@@ -61,8 +61,11 @@ struct _jit_sve_conv_fwd_kernel : public jit_generator {
 
     _jit_sve_conv_fwd_kernel(jit_conv_conf_t ajcp,
             const primitive_attr_t &attr)
-        : jcp(ajcp), attr_(attr), eltwise_injector_(nullptr)
+        : jcp(ajcp), eltwise_injector_(nullptr)
     {
+        /* the post-ops are in jcp: the kernel, shared through the registry,
+         * may outlive @p attr */
+        UNUSED(attr);
         if (jcp.with_eltwise)
             eltwise_injector_ = new jit_uni_eltwise_injector_f32<avx512_common>(
                     this, jcp.eltwise);
@@ -78,7 +81,6 @@ struct _jit_sve_conv_fwd_kernel : public jit_generator {
     DECLARE_CPU_JIT_AUX_FUNCTIONS(_jit_sve_conv_fwd_kernel)
 
     jit_conv_conf_t jcp;
-    const primitive_attr_t &attr_;
     void (*jit_ker_)(jit_conv_call_s *);
 
 private:
@@ -230,6 +232,11 @@ struct jit_sve_conv_fwd_kernel {
         delete zmm_kernel_;
     }
 
+    size_t code_size() const {
+        return zmm_kernel_ ? zmm_kernel_->code_size()
+            : xmm_kernel_ ? xmm_kernel_->code_size() : 0;
+    }
+
     enum {
         typesize = sizeof(float)
     };
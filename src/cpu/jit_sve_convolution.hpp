@@ -42,6 +42,7 @@
 #include "cpu_convolution_pd.hpp"
 #include "cpu_reducer.hpp"
 
+#include "jit_kernel_registry.hpp"
 #include "jit_transpose_src_utils.hpp"
 #include "jit_sve_conv_kernel.hpp"
 
@@ -108,10 +109,13 @@ struct jit_sve_convolution_fwd_t : public cpu_primitive_t {
             const input_vector &inputs, const output_vector &outputs)
         : cpu_primitive_t(apd, inputs, outputs)
     {
-        kernel_ = new jit_sve_conv_fwd_kernel(pd()->jcp_,
-                    *pd()->attr());
+        jit_kernel_registry_t::key_t key;
+        jit_kernel_registry_t::append(key, pd()->jcp_);
+        kernel_ = jit_kernel_registry().get<jit_sve_conv_fwd_kernel>(key,
+                [&]() { return new jit_sve_conv_fwd_kernel(pd()->jcp_,
+                            *pd()->attr()); });
     }
-    ~jit_sve_convolution_fwd_t() { delete kernel_; }
+    ~jit_sve_convolution_fwd_t() {}
 
     typedef typename prec_traits<src_type>::type src_data_t;
     typedef typename prec_traits<wei_type>::type wei_data_t;
@@ -141,7 +145,7 @@ private:
     void execute_forward_3d() const;
     const pd_t *pd() const { return (const pd_t *)primitive_t::pd(); }
 
-    jit_sve_conv_fwd_kernel *kernel_;
+    std::shared_ptr<jit_sve_conv_fwd_kernel> kernel_;
 };
 
 template <impl::data_type_t diff_dst_type,
@@ -231,8 +235,15 @@ struct jit_sve_convolution_bwd_data_t: public cpu_primitive_t {
     jit_sve_convolution_bwd_data_t(const pd_t *apd,
             const input_vector &inputs, const output_vector &outputs)
         : cpu_primitive_t(apd, inputs, outputs)
-    { kernel_ = new jit_sve_conv_bwd_data_kernel_f32(pd()->jcp_); }
-    ~jit_sve_convolution_bwd_data_t() { delete kernel_; };
+    {
+        jit_kernel_registry_t::key_t key;
+        jit_kernel_registry_t::append(key, pd()->jcp_);
+        kernel_ = jit_kernel_registry().get<jit_sve_conv_bwd_data_kernel_f32>(
+                key, [&]() {
+                    return new jit_sve_conv_bwd_data_kernel_f32(pd()->jcp_);
+                });
+    }
+    ~jit_sve_convolution_bwd_data_t() {};
 
     typedef typename prec_traits<diff_dst_type>::type diff_dst_data_t;
     typedef typename prec_traits<wei_type>::type wei_data_t;
@@ -262,7 +273,7 @@ private:
     void execute_backward_data_3d() const;
     const pd_t *pd() const { return (const pd_t *)primitive_t::pd(); }
 
-    jit_sve_conv_bwd_data_kernel_f32 *kernel_;
+    std::shared_ptr<jit_sve_conv_bwd_data_kernel_f32> kernel_;
 };
 
 template <impl::data_type_t src_type,
@@ -0,0 +1,715 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "mkldnn_types.h"
+
+#include "c_types_map.hpp"
+#include "mkldnn_thread.hpp"
+#include "type_helpers.hpp"
+#include "utils.hpp"
+
+#include "gemm/gemm.hpp"
+#include "jit_generator.hpp"
+#include "jit_sve_convolution_winograd.hpp"
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+using namespace mkldnn::impl::status;
+using namespace mkldnn::impl::memory_tracking::names;
+using namespace mkldnn::impl::utils;
+
+namespace sve_winograd {
+
+enum { simd_w = 16, r = 3 };
+
+/* Winograd matrices for the interpolation points 0, 1, -1 (m = 2) and
+ * 0, 1, -1, 2, -2 (m = 4), see Lavin & Gray, "Fast Algorithms for
+ * Convolutional Neural Networks". A and GT are the transposes of AT and G,
+ * they are used by backward-weights. */
+template <int m> struct wino_traits {};
+
+template <> struct wino_traits<2> {
+    static constexpr int alpha = 4;
+    static constexpr float BT[alpha][alpha] = {
+        { 1.f,  0.f, -1.f,  0.f },
+        { 0.f,  1.f,  1.f,  0.f },
+        { 0.f, -1.f,  1.f,  0.f },
+        { 0.f,  1.f,  0.f, -1.f },
+    };
+    static constexpr float G[alpha][r] = {
+        { 1.f,   0.f,  0.f  },
+        { 0.5f,  0.5f, 0.5f },
+        { 0.5f, -0.5f, 0.5f },
+        { 0.f,   0.f,  1.f  },
+    };
+    static constexpr float GT[r][alpha] = {
+        { 1.f, 0.5f,  0.5f, 0.f },
+        { 0.f, 0.5f, -0.5f, 0.f },
+        { 0.f, 0.5f,  0.5f, 1.f },
+    };
+    static constexpr float AT[2][alpha] = {
+        { 1.f, 1.f,  1.f,  0.f },
+        { 0.f, 1.f, -1.f, -1.f },
+    };
+    static constexpr float A[alpha][2] = {
+        { 1.f,  0.f },
+        { 1.f,  1.f },
+        { 1.f, -1.f },
+        { 0.f, -1.f },
+    };
+};
+
+template <> struct wino_traits<4> {
+    static constexpr int alpha = 6;
+    static constexpr float BT[alpha][alpha] = {
+        { 4.f,  0.f, -5.f,  0.f, 1.f, 0.f },
+        { 0.f, -4.f, -4.f,  1.f, 1.f, 0.f },
+        { 0.f,  4.f, -4.f, -1.f, 1.f, 0.f },
+        { 0.f, -2.f, -1.f,  2.f, 1.f, 0.f },
+        { 0.f,  2.f, -1.f, -2.f, 1.f, 0.f },
+        { 0.f,  4.f,  0.f, -5.f, 0.f, 1.f },
+    };
+    static constexpr float G[alpha][r] = {
+        {  1.f / 4,   0.f,       0.f     },
+        { -1.f / 6,  -1.f / 6,  -1.f / 6 },
+        { -1.f / 6,   1.f / 6,  -1.f / 6 },
+        {  1.f / 24,  1.f / 12,  1.f / 6 },
+        {  1.f / 24, -1.f / 12,  1.f / 6 },
+        {  0.f,       0.f,       1.f     },
+    };
+    static constexpr float GT[r][alpha] = {
+        { 1.f / 4, -1.f / 6, -1.f / 6, 1.f / 24,  1.f / 24, 0.f },
+        { 0.f,     -1.f / 6,  1.f / 6, 1.f / 12, -1.f / 12, 0.f },
+        { 0.f,     -1.f / 6, -1.f / 6, 1.f / 6,   1.f / 6,  1.f },
+    };
+    static constexpr float AT[4][alpha] = {
+        { 1.f, 1.f,  1.f, 1.f,  1.f, 0.f },
+        { 0.f, 1.f, -1.f, 2.f, -2.f, 0.f },
+        { 0.f, 1.f,  1.f, 4.f,  4.f, 0.f },
+        { 0.f, 1.f, -1.f, 8.f, -8.f, 1.f },
+    };
+    static constexpr float A[alpha][4] = {
+        { 1.f,  0.f, 0.f,  0.f },
+        { 1.f,  1.f, 1.f,  1.f },
+        { 1.f, -1.f, 1.f, -1.f },
+        { 1.f,  2.f, 4.f,  8.f },
+        { 1.f, -2.f, 4.f, -8.f },
+        { 0.f,  0.f, 0.f,  1.f },
+    };
+};
+
+constexpr float wino_traits<2>::BT[4][4];
+constexpr float wino_traits<2>::G[4][r];
+constexpr float wino_traits<2>::GT[r][4];
+constexpr float wino_traits<2>::AT[2][4];
+constexpr float wino_traits<2>::A[4][2];
+constexpr float wino_traits<4>::BT[6][6];
+constexpr float wino_traits<4>::G[6][r];
+constexpr float wino_traits<4>::GT[r][6];
+constexpr float wino_traits<4>::AT[4][6];
+constexpr float wino_traits<4>::A[6][4];
+
+/* out = L * in * L^T on tiles of simd_w channels, L is n x k. All the
+ * transforms have this form:
+ *   src:       BT * I * B     (alpha x alpha -> alpha x alpha)
+ *   weights:   G * g * GT     (r x r         -> alpha x alpha)
+ *   dst:       AT * M * A     (alpha x alpha -> m x m)
+ *   diff_dst:  A * dO * AT    (m x m         -> alpha x alpha)
+ *   diff_wei:  GT * dU * G    (alpha x alpha -> r x r)
+ * The matrices are compile time constants, so the zero entries are skipped
+ * once the loops are unrolled. */
+template <int n, int k>
+inline void trans_2d(float out[n][n][simd_w], const float in[k][k][simd_w],
+        const float L[n][k]) {
+    float T[n][k][simd_w];
+
+    for (int i = 0; i < n; i++)
+    for (int j = 0; j < k; j++) {
+        PRAGMA_OMP_SIMD()
+        for (int v = 0; v < simd_w; v++)
+            T[i][j][v] = 0.f;
+        for (int l = 0; l < k; l++) {
+            const float c = L[i][l];
+            if (c == 0.f) continue;
+            PRAGMA_OMP_SIMD()
+            for (int v = 0; v < simd_w; v++)
+                T[i][j][v] += c * in[l][j][v];
+        }
+    }
+
+    for (int i = 0; i < n; i++)
+    for (int j = 0; j < n; j++) {
+        PRAGMA_OMP_SIMD()
+        for (int v = 0; v < simd_w; v++)
+            out[i][j][v] = 0.f;
+        for (int l = 0; l < k; l++) {
+            const float c = L[j][l];
+            if (c == 0.f) continue;
+            PRAGMA_OMP_SIMD()
+            for (int v = 0; v < simd_w; v++)
+                out[i][j][v] += c * T[i][l][v];
+        }
+    }
+}
+
+/* offset of the (ocb, icb, kh, kw) 16i16o block, only a single group is
+ * supported */
+inline size_t wei_blk_off(const jit_conv_conf_sve_wino_t &jcp,
+        const memory_desc_wrapper &wei_d, int ocb, int icb, int kh, int kw) {
+    return jcp.with_groups
+        ? wei_d.blk_off(0, ocb, icb, kh, kw)
+        : wei_d.blk_off(ocb, icb, kh, kw);
+}
+
+inline void tile_coords(const jit_conv_conf_sve_wino_t &jcp, int tile,
+        int &n, int &tj, int &ti) {
+    nd_iterator_init(tile, n, jcp.mb, tj, jcp.jtiles, ti, jcp.itiles);
+}
+
+/* U[xi][inp_c][out_c] = G * g * GT. For backward-data the roles of ic and
+ * oc are swapped and the kernel is rotated by 180 degrees. */
+template <int m>
+void transform_weights(const jit_conv_conf_sve_wino_t &jcp, const float *wei,
+        const memory_desc_wrapper &wei_d, float *U, bool flip) {
+    typedef wino_traits<m> tr;
+    const int alpha = tr::alpha;
+    const int nb_inp_c = jcp.inp_c / simd_w;
+    const int nb_out_c = jcp.out_c / simd_w;
+
+    parallel_nd(nb_out_c, nb_inp_c, [&](int ocb, int icb) {
+        float g[r][r][simd_w];
+        float Uw[alpha][alpha][simd_w];
+
+        for (int ci = 0; ci < simd_w; ci++) {
+            for (int kh = 0; kh < r; kh++)
+            for (int kw = 0; kw < r; kw++) {
+                if (flip) {
+                    const float *w = &wei[wei_blk_off(jcp, wei_d, icb, ocb,
+                            r - 1 - kh, r - 1 - kw) + ci];
+                    for (int v = 0; v < simd_w; v++)
+                        g[kh][kw][v] = w[v * simd_w];
+                } else {
+                    const float *w = &wei[wei_blk_off(jcp, wei_d, ocb, icb, kh,
+                            kw) + ci * simd_w];
+                    PRAGMA_OMP_SIMD()
+                    for (int v = 0; v < simd_w; v++)
+                        g[kh][kw][v] = w[v];
+                }
+            }
+
+            trans_2d<alpha, r>(Uw, g, tr::G);
+
+            for (int a = 0; a < alpha; a++)
+            for (int b = 0; b < alpha; b++) {
+                float *u = &U[((size_t)(a * alpha + b) * jcp.inp_c
+                        + icb * simd_w + ci) * jcp.out_c + ocb * simd_w];
+                PRAGMA_OMP_SIMD()
+                for (int v = 0; v < simd_w; v++)
+                    u[v] = Uw[a][b][v];
+            }
+        }
+    });
+}
+
+/* V[xi][tile][c] = BT * I * B for one alpha x alpha tile of 'inp' */
+template <int m>
+void transform_inp_tile(const jit_conv_conf_sve_wino_t &jcp, const float *inp,
+        const memory_desc_wrapper &inp_d, int n, int cb, int tj, int ti,
+        float *V, size_t xi_stride) {
+    typedef wino_traits<m> tr;
+    const int alpha = tr::alpha;
+    float I[alpha][alpha][simd_w];
+    float Vw[alpha][alpha][simd_w];
+
+    const int y0 = tj * m - jcp.inp_t_pad;
+    const int x0 = ti * m - jcp.inp_l_pad;
+    for (int a = 0; a < alpha; a++)
+    for (int b = 0; b < alpha; b++) {
+        const int y = y0 + a, x = x0 + b;
+        if (y >= 0 && y < jcp.inp_h && x >= 0 && x < jcp.inp_w) {
+            const float *i = &inp[inp_d.blk_off(n, cb, y, x)];
+            PRAGMA_OMP_SIMD()
+            for (int v = 0; v < simd_w; v++)
+                I[a][b][v] = i[v];
+        } else {
+            PRAGMA_OMP_SIMD()
+            for (int v = 0; v < simd_w; v++)
+                I[a][b][v] = 0.f;
+        }
+    }
+
+    trans_2d<alpha, alpha>(Vw, I, tr::BT);
+
+    for (int a = 0; a < alpha; a++)
+    for (int b = 0; b < alpha; b++) {
+        float *o = &V[(a * alpha + b) * xi_stride];
+        PRAGMA_OMP_SIMD()
+        for (int v = 0; v < simd_w; v++)
+            o[v] = Vw[a][b][v];
+    }
+}
+
+/* out = AT * M * A (+ bias, post-ops) for one m x m tile of 'out' */
+template <int m>
+void transform_out_tile(const jit_conv_conf_sve_wino_t &jcp, const float *M,
+        size_t xi_stride, const float *bias, float *out,
+        const memory_desc_wrapper &out_d, int n, int cb, int tj, int ti,
+        ref_eltwise_scalar_fwd_t *eltwise) {
+    typedef wino_traits<m> tr;
+    const int alpha = tr::alpha;
+    float Mw[alpha][alpha][simd_w];
+    float O[m][m][simd_w];
+
+    for (int a = 0; a < alpha; a++)
+    for (int b = 0; b < alpha; b++) {
+        const float *i = &M[(a * alpha + b) * xi_stride];
+        PRAGMA_OMP_SIMD()
+        for (int v = 0; v < simd_w; v++)
+            Mw[a][b][v] = i[v];
+    }
+
+    trans_2d<m, alpha>(O, Mw, tr::AT);
+
+    float b_vec[simd_w];
+    for (int v = 0; v < simd_w; v++) {
+        const int c = cb * simd_w + v;
+        b_vec[v] = bias && c < jcp.oc_without_padding ? bias[c] : 0.f;
+    }
+
+    for (int i = 0; i < m; i++)
+    for (int j = 0; j < m; j++) {
+        const int y = tj * m + i, x = ti * m + j;
+        if (y >= jcp.out_h || x >= jcp.out_w) continue;
+        float *o = &out[out_d.blk_off(n, cb, y, x)];
+        if (jcp.with_sum) {
+            PRAGMA_OMP_SIMD()
+            for (int v = 0; v < simd_w; v++)
+                o[v] = O[i][j][v] + b_vec[v] + jcp.sum_scale * o[v];
+        } else {
+            PRAGMA_OMP_SIMD()
+            for (int v = 0; v < simd_w; v++)
+                o[v] = O[i][j][v] + b_vec[v];
+        }
+        if (eltwise)
+            for (int v = 0; v < simd_w; v++)
+                o[v] = eltwise->compute_scalar(o[v]);
+    }
+}
+
+/* Forward and backward-data: out = conv(inp, U) in blocks of tile_block
+ * tiles per thread, the transformed tiles of a block stay in L2 between
+ * the transforms and the GEMMs. */
+template <int m>
+void execute_data(const jit_conv_conf_sve_wino_t &jcp, const float *inp,
+        const memory_desc_wrapper &inp_d, const float *wei,
+        const memory_desc_wrapper &wei_d, bool flip_weights,
+        const float *bias, float *out, const memory_desc_wrapper &out_d,
+        ref_eltwise_scalar_fwd_t *eltwise,
+        const memory_tracking::grantor_t &scratchpad) {
+    const int alpha = wino_traits<m>::alpha;
+    const int nb_inp_c = jcp.inp_c / simd_w;
+    const int nb_out_c = jcp.out_c / simd_w;
+    const size_t U_xi_sz = (size_t)jcp.inp_c * jcp.out_c;
+    const size_t V_xi_sz = (size_t)jcp.tile_block * jcp.inp_c;
+    const size_t M_xi_sz = (size_t)jcp.tile_block * jcp.out_c;
+
+    float *U = scratchpad.get<float>(key_wino_U);
+    float *V = scratchpad.get<float>(key_wino_V);
+    float *M = scratchpad.get<float>(key_wino_M);
+
+    transform_weights<m>(jcp, wei, wei_d, U, flip_weights);
+
+    parallel(jcp.nthr, [&](const int ithr, const int nthr) {
+        int start{0}, end{0};
+        balance211(jcp.nb_tile_blocks, nthr, ithr, start, end);
+
+        float *V_thr = V + (size_t)ithr * alpha * alpha * V_xi_sz;
+        float *M_thr = M + (size_t)ithr * alpha * alpha * M_xi_sz;
+
+        for (int tb = start; tb < end; tb++) {
+            const int tile_start = tb * jcp.tile_block;
+            const int nb_tiles = nstl::min(jcp.tile_block,
+                    jcp.ntiles - tile_start);
+
+            for (int t = 0; t < nb_tiles; t++) {
+                int n{0}, tj{0}, ti{0};
+                tile_coords(jcp, tile_start + t, n, tj, ti);
+                for (int cb = 0; cb < nb_inp_c; cb++)
+                    transform_inp_tile<m>(jcp, inp, inp_d, n, cb, tj, ti,
+                            &V_thr[(size_t)t * jcp.inp_c + cb * simd_w],
+                            V_xi_sz);
+            }
+
+            const float one = 1.f, zero = 0.f;
+            for (int xi = 0; xi < alpha * alpha; xi++)
+                extended_sgemm("N", "N", &jcp.out_c, &nb_tiles, &jcp.inp_c,
+                        &one, &U[xi * U_xi_sz], &jcp.out_c,
+                        &V_thr[xi * V_xi_sz], &jcp.inp_c, &zero,
+                        &M_thr[xi * M_xi_sz], &jcp.out_c);
+
+            for (int t = 0; t < nb_tiles; t++) {
+                int n{0}, tj{0}, ti{0};
+                tile_coords(jcp, tile_start + t, n, tj, ti);
+                for (int cb = 0; cb < nb_out_c; cb++)
+                    transform_out_tile<m>(jcp,
+                            &M_thr[(size_t)t * jcp.out_c + cb * simd_w],
+                            M_xi_sz, bias, out, out_d, n, cb, tj, ti,
+                            eltwise);
+            }
+        }
+    });
+}
+
+/* Backward-weights: dU[xi][ic][oc] = sum_tiles V[xi][tile][ic] *
+ * dM[xi][tile][oc], with V the transformed src and dM the transformed
+ * diff_dst, then diff_weights = GT * dU * G. */
+template <int m>
+void execute_weights(const jit_conv_conf_sve_wino_t &jcp, const float *src,
+        const memory_desc_wrapper &src_d, const float *diff_dst,
+        const memory_desc_wrapper &diff_dst_d, float *diff_weights,
+        const memory_desc_wrapper &diff_weights_d, float *diff_bias,
+        const memory_tracking::grantor_t &scratchpad) {
+    typedef wino_traits<m> tr;
+    const int alpha = tr::alpha;
+    const int nb_ic = jcp.inp_c / simd_w;
+    const int nb_oc = jcp.out_c / simd_w;
+    const size_t U_xi_sz = (size_t)jcp.inp_c * jcp.out_c;
+    const size_t V_xi_sz = (size_t)jcp.ntiles * jcp.inp_c;
+    const size_t M_xi_sz = (size_t)jcp.ntiles * jcp.out_c;
+
+    float *dU = scratchpad.get<float>(key_wino_U);
+    float *V = scratchpad.get<float>(key_wino_V);
+    float *dM = scratchpad.get<float>(key_wino_M);
+
+    parallel_nd(jcp.ntiles, nb_ic, [&](int tile, int cb) {
+        int n{0}, tj{0}, ti{0};
+        tile_coords(jcp, tile, n, tj, ti);
+        transform_inp_tile<m>(jcp, src, src_d, n, cb, tj, ti,
+                &V[(size_t)tile * jcp.inp_c + cb * simd_w], V_xi_sz);
+    });
+
+    parallel_nd(jcp.ntiles, nb_oc, [&](int tile, int cb) {
+        int n{0}, tj{0}, ti{0};
+        tile_coords(jcp, tile, n, tj, ti);
+
+        float dO[m][m][simd_w];
+        float dMw[alpha][alpha][simd_w];
+        for (int i = 0; i < m; i++)
+        for (int j = 0; j < m; j++) {
+            const int y = tj * m + i, x = ti * m + j;
+            if (y < jcp.out_h && x < jcp.out_w) {
+                const float *d = &diff_dst[diff_dst_d.blk_off(n, cb, y, x)];
+                PRAGMA_OMP_SIMD()
+                for (int v = 0; v < simd_w; v++)
+                    dO[i][j][v] = d[v];
+            } else {
+                PRAGMA_OMP_SIMD()
+                for (int v = 0; v < simd_w; v++)
+                    dO[i][j][v] = 0.f;
+            }
+        }
+
+        trans_2d<alpha, m>(dMw, dO, tr::A);
+
+        for (int a = 0; a < alpha; a++)
+        for (int b = 0; b < alpha; b++) {
+            float *o = &dM[(a * alpha + b) * M_xi_sz
+                    + (size_t)tile * jcp.out_c + cb * simd_w];
+            PRAGMA_OMP_SIMD()
+            for (int v = 0; v < simd_w; v++)
+                o[v] = dMw[a][b][v];
+        }
+    });
+
+    /* split oc so that there is enough GEMMs for all the threads */
+    int oc_chunk = jcp.out_c;
+    while (oc_chunk > simd_w && oc_chunk % (2 * simd_w) == 0
+            && alpha * alpha * (jcp.out_c / oc_chunk) < jcp.nthr)
+        oc_chunk /= 2;
+    const int nb_oc_chunks = jcp.out_c / oc_chunk;
+
+    parallel_nd(alpha * alpha, nb_oc_chunks, [&](int xi, int occ) {
+        const float one = 1.f, zero = 0.f;
+        extended_sgemm("N", "T", &oc_chunk, &jcp.inp_c, &jcp.ntiles, &one,
+                &dM[xi * M_xi_sz + occ * oc_chunk], &jcp.out_c,
+                &V[xi * V_xi_sz], &jcp.inp_c, &zero,
+                &dU[xi * U_xi_sz + occ * oc_chunk], &jcp.out_c);
+    });
+
+    parallel_nd(nb_oc, nb_ic, [&](int ocb, int icb) {
+        float dUw[alpha][alpha][simd_w];
+        float dW[r][r][simd_w];
+
+        for (int ci = 0; ci < simd_w; ci++) {
+            for (int a = 0; a < alpha; a++)
+            for (int b = 0; b < alpha; b++) {
+                const float *u = &dU[(a * alpha + b) * U_xi_sz
+                        + (size_t)(icb * simd_w + ci) * jcp.out_c
+                        + ocb * simd_w];
+                PRAGMA_OMP_SIMD()
+                for (int v = 0; v < simd_w; v++)
+                    dUw[a][b][v] = u[v];
+            }
+
+            trans_2d<r, alpha>(dW, dUw, tr::GT);
+
+            for (int kh = 0; kh < r; kh++)
+            for (int kw = 0; kw < r; kw++) {
+                float *w = &diff_weights[wei_blk_off(jcp, diff_weights_d,
+                        ocb, icb, kh, kw) + ci * simd_w];
+                PRAGMA_OMP_SIMD()
+                for (int v = 0; v < simd_w; v++)
+                    w[v] = dW[kh][kw][v];
+            }
+        }
+    });
+
+    if (!jcp.with_bias) return;
+
+    parallel_nd(nb_oc, [&](int ocb) {
+        float db[simd_w] = {0};
+        for (int n = 0; n < jcp.mb; n++)
+        for (int y = 0; y < jcp.out_h; y++)
+        for (int x = 0; x < jcp.out_w; x++) {
+            const float *d = &diff_dst[diff_dst_d.blk_off(n, ocb, y, x)];
+            PRAGMA_OMP_SIMD()
+            for (int v = 0; v < simd_w; v++)
+                db[v] += d[v];
+        }
+        const int oc_tail = nstl::min((int)simd_w,
+                jcp.oc_without_padding - ocb * simd_w);
+        for (int v = 0; v < oc_tail; v++)
+            diff_bias[ocb * simd_w + v] = db[v];
+    });
+}
+
+namespace {
+bool is_winograd_faster_than_direct(const jit_conv_conf_sve_wino_t &jcp) {
+    /* The transforms are memory bound, the GEMMs have to be large enough
+     * to amortize them. */
+    return jcp.inp_c >= 64 && jcp.out_c >= 64 && jcp.ntiles >= 2 * jcp.nthr;
+}
+
+/* Multiplications per output pixel, including the tiles overlapping the
+ * right and bottom borders. */
+int wino_cost(int m, int oh, int ow) {
+    return (m + r - 1) * (m + r - 1) * div_up(oh, m) * div_up(ow, m);
+}
+}
+
+status_t init_conf(jit_conv_conf_sve_wino_t &jcp,
+        const convolution_desc_t &cd, const memory_desc_wrapper &src_d,
+        const memory_desc_wrapper &weights_d,
+        const memory_desc_wrapper &dst_d, const primitive_attr_t &attr,
+        prop_kind_t prop_kind) {
+    using namespace prop_kind;
+
+    const bool with_groups = weights_d.ndims() == src_d.ndims() + 1;
+    if (src_d.ndims() != 4 || (with_groups && weights_d.dims()[0] != 1))
+        return unimplemented;
+
+    jcp = zero<decltype(jcp)>();
+    jcp.with_groups = with_groups;
+    jcp.r = r;
+    jcp.mb = src_d.dims()[0];
+    jcp.ic_without_padding = src_d.dims()[1];
+    jcp.oc_without_padding = dst_d.dims()[1];
+    jcp.ic = rnd_up(jcp.ic_without_padding, simd_w);
+    jcp.oc = rnd_up(jcp.oc_without_padding, simd_w);
+    jcp.ih = src_d.dims()[2];
+    jcp.iw = src_d.dims()[3];
+    jcp.oh = dst_d.dims()[2];
+    jcp.ow = dst_d.dims()[3];
+    jcp.t_pad = cd.padding[0][0];
+    jcp.l_pad = cd.padding[0][1];
+
+    const int kh = weights_d.dims()[with_groups + 2];
+    const int kw = weights_d.dims()[with_groups + 3];
+    const int b_pad = (jcp.oh - 1) + kh - 1 - (jcp.ih + jcp.t_pad - 1);
+    const int r_pad = (jcp.ow - 1) + kw - 1 - (jcp.iw + jcp.l_pad - 1);
+    if (kh != r || kw != r)
+        return unimplemented;
+    if (cd.strides[0] != 1 || cd.strides[1] != 1)
+        return unimplemented;
+    if (cd.dilates[0] != 0 || cd.dilates[1] != 0)
+        return unimplemented;
+    if (!everyone_is(true, jcp.t_pad >= 0, jcp.l_pad >= 0, b_pad >= 0,
+                r_pad >= 0, jcp.t_pad < r, jcp.l_pad < r, b_pad < r,
+                r_pad < r))
+        return unimplemented;
+
+    if (prop_kind == forward_training) {
+        const auto &p = attr.post_ops_;
+        auto is_eltwise = [&](int idx) { return p.entry_[idx].is_eltwise(); };
+        auto is_sum = [&](int idx) { return p.entry_[idx].is_sum(); };
+        bool post_ops_ok = false;
+        switch (p.len_) {
+        case 0: post_ops_ok = true; break;
+        case 1: post_ops_ok = is_eltwise(0) || is_sum(0); break;
+        case 2: post_ops_ok = is_sum(0) && is_eltwise(1); break;
+        default: post_ops_ok = false;
+        }
+        if (!post_ops_ok)
+            return unimplemented;
+
+        const int sum_idx = p.find(primitive_kind::sum);
+        jcp.with_sum = sum_idx != -1;
+        jcp.sum_scale = jcp.with_sum ? p.entry_[sum_idx].sum.scale : 0.f;
+        jcp.with_eltwise = p.find(primitive_kind::eltwise) != -1;
+        jcp.with_bias = cd.bias_desc.format != memory_format::undef;
+    } else if (prop_kind == backward_weights) {
+        jcp.with_bias = cd.diff_bias_desc.format != memory_format::undef;
+    }
+
+    if (prop_kind == backward_data) {
+        jcp.inp_c = jcp.oc;
+        jcp.out_c = jcp.ic;
+        jcp.inp_h = jcp.oh;
+        jcp.inp_w = jcp.ow;
+        jcp.out_h = jcp.ih;
+        jcp.out_w = jcp.iw;
+        jcp.inp_t_pad = r - 1 - jcp.t_pad;
+        jcp.inp_l_pad = r - 1 - jcp.l_pad;
+    } else {
+        jcp.inp_c = jcp.ic;
+        jcp.out_c = jcp.oc;
+        jcp.inp_h = jcp.ih;
+        jcp.inp_w = jcp.iw;
+        jcp.out_h = jcp.oh;
+        jcp.out_w = jcp.ow;
+        jcp.inp_t_pad = jcp.t_pad;
+        jcp.inp_l_pad = jcp.l_pad;
+    }
+
+    /* F(4x4, 3x3) unless the output is so small that the 2x2 tiles waste
+     * fewer multiplications */
+    jcp.m = wino_cost(2, jcp.out_h, jcp.out_w)
+            <= wino_cost(4, jcp.out_h, jcp.out_w) ? 2 : 4;
+    jcp.alpha = jcp.m + r - 1;
+
+    jcp.jtiles = div_up(jcp.out_h, jcp.m);
+    jcp.itiles = div_up(jcp.out_w, jcp.m);
+    jcp.ntiles = jcp.mb * jcp.jtiles * jcp.itiles;
+    jcp.nthr = mkldnn_get_max_threads();
+
+    if (cd.alg_kind == alg_kind::convolution_auto
+            && !is_winograd_faster_than_direct(jcp))
+        return unimplemented;
+
+    if (prop_kind == backward_weights) {
+        jcp.tile_block = jcp.ntiles;
+        jcp.nb_tile_blocks = 1;
+    } else {
+        /* the transformed tiles of a block and their GEMM output stay in
+         * the L2 share of the thread */
+        const size_t L2_size = get_cache_size(2, true);
+        const size_t tile_sz = sizeof(float) * jcp.alpha * jcp.alpha
+                * (jcp.inp_c + jcp.out_c);
+        int tile_block = nstl::max(8, (int)(L2_size / tile_sz));
+        tile_block = nstl::min(tile_block, 128);
+        tile_block = nstl::min(tile_block, div_up(jcp.ntiles, jcp.nthr));
+        jcp.tile_block = nstl::max(1, tile_block);
+        jcp.nb_tile_blocks = div_up(jcp.ntiles, jcp.tile_block);
+    }
+
+    return success;
+}
+
+void init_scratchpad(memory_tracking::registrar_t &scratchpad,
+        const jit_conv_conf_sve_wino_t &jcp, prop_kind_t prop_kind) {
+    const size_t nxi = (size_t)jcp.alpha * jcp.alpha;
+    const size_t nbufs = prop_kind == prop_kind::backward_weights
+            ? 1 : jcp.nthr;
+
+    size_t U_sz = nxi * jcp.inp_c * jcp.out_c;
+    size_t V_sz = nbufs * nxi * jcp.tile_block * jcp.inp_c;
+    size_t M_sz = nbufs * nxi * jcp.tile_block * jcp.out_c;
+
+    scratchpad.book(key_wino_U, sizeof(float) * U_sz, PAGE_2M);
+    scratchpad.book(key_wino_V, sizeof(float) * V_sz, PAGE_2M);
+    scratchpad.book(key_wino_M, sizeof(float) * M_sz, PAGE_2M);
+}
+
+}
+
+void jit_sve_convolution_winograd_fwd_t::execute_forward() const {
+    auto src = reinterpret_cast<const data_t *>(this->input_memory(0));
+    auto weights = reinterpret_cast<const data_t *>(this->input_memory(1));
+    auto bias = reinterpret_cast<const data_t *>(this->input_memory(2));
+    auto dst = reinterpret_cast<data_t *>(this->memory());
+
+    const memory_desc_wrapper src_d(pd()->src_pd());
+    const memory_desc_wrapper weights_d(pd()->weights_pd(0));
+    const memory_desc_wrapper dst_d(pd()->dst_pd());
+    const auto &jcp = pd()->jcp_;
+
+    if (jcp.m == 4)
+        sve_winograd::execute_data<4>(jcp, src, src_d, weights, weights_d,
+                false, bias, dst, dst_d, eltwise_, this->scratchpad());
+    else
+        sve_winograd::execute_data<2>(jcp, src, src_d, weights, weights_d,
+                false, bias, dst, dst_d, eltwise_, this->scratchpad());
+}
+
+void jit_sve_convolution_winograd_bwd_data_t::execute_backward_data() const {
+    auto diff_dst = reinterpret_cast<const data_t *>(this->input_memory(0));
+    auto weights = reinterpret_cast<const data_t *>(this->input_memory(1));
+    auto diff_src = reinterpret_cast<data_t *>(this->memory());
+
+    const memory_desc_wrapper diff_dst_d(pd()->diff_dst_pd());
+    const memory_desc_wrapper weights_d(pd()->weights_pd(0));
+    const memory_desc_wrapper diff_src_d(pd()->diff_src_pd());
+    const auto &jcp = pd()->jcp_;
+
+    if (jcp.m == 4)
+        sve_winograd::execute_data<4>(jcp, diff_dst, diff_dst_d, weights,
+                weights_d, true, nullptr, diff_src, diff_src_d, nullptr,
+                this->scratchpad());
+    else
+        sve_winograd::execute_data<2>(jcp, diff_dst, diff_dst_d, weights,
+                weights_d, true, nullptr, diff_src, diff_src_d, nullptr,
+                this->scratchpad());
+}
+
+void jit_sve_convolution_winograd_bwd_weights_t::execute_backward_weights()
+        const {
+    auto src = reinterpret_cast<const data_t *>(this->input_memory(0));
+    auto diff_dst = reinterpret_cast<const data_t *>(this->input_memory(1));
+    auto diff_weights = reinterpret_cast<data_t *>(this->memory(0));
+    auto diff_bias = reinterpret_cast<data_t *>(this->memory(1));
+
+    const memory_desc_wrapper src_d(pd()->src_pd());
+    const memory_desc_wrapper diff_dst_d(pd()->diff_dst_pd());
+    const memory_desc_wrapper diff_weights_d(pd()->diff_weights_pd(0));
+    const auto &jcp = pd()->jcp_;
+
+    if (jcp.m == 4)
+        sve_winograd::execute_weights<4>(jcp, src, src_d, diff_dst,
+                diff_dst_d, diff_weights, diff_weights_d, diff_bias,
+                this->scratchpad());
+    else
+        sve_winograd::execute_weights<2>(jcp, src, src_d, diff_dst,
+                diff_dst_d, diff_weights, diff_weights_d, diff_bias,
+                this->scratchpad());
+}
+
+}
+}
+}
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -0,0 +1,340 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_JIT_SVE_CONVOLUTION_WINOGRAD_HPP
+#define CPU_JIT_SVE_CONVOLUTION_WINOGRAD_HPP
+
+#include "c_types_map.hpp"
+#include "memory_tracking.hpp"
+#include "mkldnn_thread.hpp"
+#include "type_helpers.hpp"
+#include "utils.hpp"
+
+#include "cpu_convolution_pd.hpp"
+#include "cpu_engine.hpp"
+#include "cpu_isa_traits.hpp"
+#include "jit_primitive_conf.hpp"
+#include "ref_eltwise.hpp"
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+/* Winograd F(4x4, 3x3) and F(2x2, 3x3) convolution for SVE.
+ *
+ * Activations are nChw16c and weights OIhw16i16o. The tiles are transformed
+ * 16 channels at a time, one channel block per vector, and for each of the
+ * alpha x alpha points of the Winograd domain the channel reduction is a
+ * plain GEMM run by the SVE sgemm. Forward and backward-data process the
+ * tiles in blocks that fit in L2, backward-weights transforms the whole
+ * minibatch first and then reduces over all the tiles at once. */
+namespace sve_winograd {
+
+status_t init_conf(jit_conv_conf_sve_wino_t &jcp,
+        const convolution_desc_t &cd, const memory_desc_wrapper &src_d,
+        const memory_desc_wrapper &weights_d,
+        const memory_desc_wrapper &dst_d, const primitive_attr_t &attr,
+        prop_kind_t prop_kind);
+
+void init_scratchpad(memory_tracking::registrar_t &scratchpad,
+        const jit_conv_conf_sve_wino_t &jcp, prop_kind_t prop_kind);
+
+}
+
+struct jit_sve_convolution_winograd_fwd_t : public cpu_primitive_t {
+    struct pd_t : public cpu_convolution_fwd_pd_t {
+        pd_t(engine_t *engine, const convolution_desc_t *adesc,
+                const primitive_attr_t *attr,
+                const typename pd_t::base_class *hint_fwd_pd)
+            : cpu_convolution_fwd_pd_t(engine, adesc, attr, hint_fwd_pd)
+            , jcp_() {}
+
+        DECLARE_COMMON_PD_T(
+                JIT_IMPL_NAME_HELPER("jit_wino:", sve, ""),
+                jit_sve_convolution_winograd_fwd_t);
+
+        virtual status_t init() override {
+            using namespace prop_kind;
+            using namespace memory_format;
+            assert(this->engine()->kind() == engine_kind::cpu);
+            bool ok = true && this->set_default_params() == status::success
+                    && mayiuse(sve)
+                    && utils::one_of(this->desc()->prop_kind,
+                               forward_training, forward_inference)
+                    && utils::one_of(this->desc()->alg_kind,
+                               alg_kind::convolution_auto,
+                               alg_kind::convolution_winograd)
+                    && !this->has_zero_dim_memory()
+                    && utils::everyone_is(data_type::f32,
+                               this->desc()->src_desc.data_type,
+                               this->desc()->weights_desc.data_type,
+                               this->desc()->dst_desc.data_type)
+                    && IMPLICATION(this->with_bias(), data_type::f32
+                               == this->desc()->bias_desc.data_type)
+                    && this->src_pd_.desc()->format == nChw16c
+                    && this->dst_pd_.desc()->format == nChw16c
+                    && this->weights_pd_.desc()->format
+                            == (this->with_groups() ? gOIhw16i16o
+                                    : OIhw16i16o);
+            if (!ok)
+                return status::unimplemented;
+
+            status_t status = sve_winograd::init_conf(jcp_, *this->desc(),
+                    *this->src_pd_.desc(), *this->weights_pd_.desc(),
+                    *this->dst_pd_.desc(), *this->attr(), forward_training);
+            if (status != status::success) return status;
+
+            auto scratchpad = this->scratchpad_registry().registrar();
+            sve_winograd::init_scratchpad(scratchpad, jcp_,
+                    forward_training);
+
+            if (this->desc()->alg_kind == alg_kind::convolution_auto)
+                CHECK(this->set_alg_kind(alg_kind::convolution_winograd));
+
+            return status::success;
+        }
+
+        jit_conv_conf_sve_wino_t jcp_;
+
+    protected:
+        virtual status_t set_default_params() override {
+            using namespace memory_format;
+            if (this->src_pd_.desc()->format == any)
+                CHECK(this->src_pd_.set_format(nChw16c));
+            if (this->dst_pd_.desc()->format == any)
+                CHECK(this->dst_pd_.set_format(nChw16c));
+            if (this->weights_pd_.desc()->format == any)
+                CHECK(this->weights_pd_.set_format(
+                        this->with_groups() ? gOIhw16i16o : OIhw16i16o));
+            if (this->bias_pd_.desc()->format == any)
+                CHECK(this->bias_pd_.set_format(x));
+            return status::success;
+        }
+    };
+
+    jit_sve_convolution_winograd_fwd_t(const pd_t *apd,
+            const input_vector &inputs, const output_vector &outputs)
+        : cpu_primitive_t(apd, inputs, outputs, true), eltwise_(nullptr)
+    {
+        const auto &post_ops = pd()->attr()->post_ops_;
+        const int entry_idx = post_ops.find(primitive_kind::eltwise);
+        if (entry_idx != -1) eltwise_ = new ref_eltwise_scalar_fwd_t(
+                post_ops.entry_[entry_idx].eltwise);
+    }
+
+    ~jit_sve_convolution_winograd_fwd_t() { delete eltwise_; }
+
+    typedef typename prec_traits<data_type::f32>::type data_t;
+
+    virtual void execute(event_t *e) const {
+        execute_forward();
+        if (pd()->wants_zero_pad_dst())
+            output_memory_primitive(0)->zero_pad();
+        e->set_state(event_t::ready);
+    }
+
+private:
+    void execute_forward() const;
+    const pd_t *pd() const { return (const pd_t *)primitive_t::pd(); }
+
+    ref_eltwise_scalar_fwd_t *eltwise_;
+};
+
+struct jit_sve_convolution_winograd_bwd_data_t : public cpu_primitive_t {
+    struct pd_t : public cpu_convolution_bwd_data_pd_t {
+        pd_t(engine_t *engine, const convolution_desc_t *adesc,
+                const primitive_attr_t *attr,
+                const convolution_fwd_pd_t *hint_fwd_pd)
+            : cpu_convolution_bwd_data_pd_t(engine, adesc, attr, hint_fwd_pd)
+            , jcp_() {}
+
+        DECLARE_COMMON_PD_T(
+                JIT_IMPL_NAME_HELPER("jit_wino:", sve, ""),
+                jit_sve_convolution_winograd_bwd_data_t);
+
+        virtual status_t init() override {
+            using namespace prop_kind;
+            using namespace memory_format;
+            assert(this->engine()->kind() == engine_kind::cpu);
+            bool ok = true && this->set_default_params() == status::success
+                    && mayiuse(sve)
+                    && utils::one_of(this->desc()->prop_kind, backward_data)
+                    && utils::one_of(this->desc()->alg_kind,
+                               alg_kind::convolution_auto,
+                               alg_kind::convolution_winograd)
+                    && !this->has_zero_dim_memory()
+                    && utils::everyone_is(data_type::f32,
+                               this->desc()->diff_src_desc.data_type,
+                               this->desc()->weights_desc.data_type,
+                               this->desc()->diff_dst_desc.data_type)
+                    && this->diff_src_pd_.desc()->format == nChw16c
+                    && this->diff_dst_pd_.desc()->format == nChw16c
+                    && this->weights_pd_.desc()->format
+                            == (this->with_groups() ? gOIhw16i16o
+                                    : OIhw16i16o);
+            if (!ok)
+                return status::unimplemented;
+
+            status_t status = sve_winograd::init_conf(jcp_, *this->desc(),
+                    *this->diff_src_pd_.desc(), *this->weights_pd_.desc(),
+                    *this->diff_dst_pd_.desc(), *this->attr(), backward_data);
+            if (status != status::success) return status;
+
+            auto scratchpad = this->scratchpad_registry().registrar();
+            sve_winograd::init_scratchpad(scratchpad, jcp_, backward_data);
+
+            if (this->desc()->alg_kind == alg_kind::convolution_auto)
+                CHECK(this->set_alg_kind(alg_kind::convolution_winograd));
+
+            return status::success;
+        }
+
+        jit_conv_conf_sve_wino_t jcp_;
+
+    protected:
+        virtual status_t set_default_params() override {
+            using namespace memory_format;
+            if (this->diff_src_pd_.desc()->format == any)
+                CHECK(this->diff_src_pd_.set_format(nChw16c));
+            if (this->diff_dst_pd_.desc()->format == any)
+                CHECK(this->diff_dst_pd_.set_format(nChw16c));
+            if (this->weights_pd_.desc()->format == any)
+                CHECK(this->weights_pd_.set_format(
+                        this->with_groups() ? gOIhw16i16o : OIhw16i16o));
+            return status::success;
+        }
+    };
+
+    jit_sve_convolution_winograd_bwd_data_t(const pd_t *apd,
+            const input_vector &inputs, const output_vector &outputs)
+        : cpu_primitive_t(apd, inputs, outputs, true) {}
+
+    ~jit_sve_convolution_winograd_bwd_data_t() {}
+
+    typedef typename prec_traits<data_type::f32>::type data_t;
+
+    virtual void execute(event_t *e) const {
+        assert(pd()->desc()->prop_kind == prop_kind::backward_data
+                && "invalid prop_kind");
+        execute_backward_data();
+        e->set_state(event_t::ready);
+    }
+
+private:
+    void execute_backward_data() const;
+    const pd_t *pd() const { return (const pd_t *)primitive_t::pd(); }
+};
+
+struct jit_sve_convolution_winograd_bwd_weights_t : public cpu_primitive_t {
+    struct pd_t : public cpu_convolution_bwd_weights_pd_t {
+        pd_t(engine_t *engine, const convolution_desc_t *adesc,
+                const primitive_attr_t *attr,
+                const convolution_fwd_pd_t *hint_fwd_pd)
+            : cpu_convolution_bwd_weights_pd_t(engine, adesc, attr,
+                    hint_fwd_pd)
+            , jcp_() {}
+
+        DECLARE_COMMON_PD_T(
+                JIT_IMPL_NAME_HELPER("jit_wino:", sve, ""),
+                jit_sve_convolution_winograd_bwd_weights_t);
+
+        virtual status_t init() override {
+            using namespace prop_kind;
+            using namespace memory_format;
+            assert(this->engine()->kind() == engine_kind::cpu);
+            bool ok = true && this->set_default_params() == status::success
+                    && mayiuse(sve)
+                    && utils::one_of(this->desc()->prop_kind,
+                               backward_weights)
+                    && utils::one_of(this->desc()->alg_kind,
+                               alg_kind::convolution_auto,
+                               alg_kind::convolution_winograd)
+                    && !this->has_zero_dim_memory()
+                    && utils::everyone_is(data_type::f32,
+                               this->desc()->src_desc.data_type,
+                               this->desc()->diff_dst_desc.data_type,
+                               this->desc()->diff_weights_desc.data_type)
+                    && IMPLICATION(this->with_bias(), data_type::f32
+                               == this->desc()->diff_bias_desc.data_type)
+                    && this->src_pd_.desc()->format == nChw16c
+                    && this->diff_dst_pd_.desc()->format == nChw16c
+                    && this->diff_weights_pd_.desc()->format
+                            == (this->with_groups() ? gOIhw16i16o
+                                    : OIhw16i16o);
+            if (!ok)
+                return status::unimplemented;
+
+            status_t status = sve_winograd::init_conf(jcp_, *this->desc(),
+                    *this->src_pd_.desc(), *this->diff_weights_pd_.desc(),
+                    *this->diff_dst_pd_.desc(), *this->attr(),
+                    backward_weights);
+            if (status != status::success) return status;
+
+            auto scratchpad = this->scratchpad_registry().registrar();
+            sve_winograd::init_scratchpad(scratchpad, jcp_,
+                    backward_weights);
+
+            if (this->desc()->alg_kind == alg_kind::convolution_auto)
+                CHECK(this->set_alg_kind(alg_kind::convolution_winograd));
+
+            return status::success;
+        }
+
+        jit_conv_conf_sve_wino_t jcp_;
+
+    protected:
+        virtual status_t set_default_params() override {
+            using namespace memory_format;
+            if (this->src_pd_.desc()->format == any)
+                CHECK(this->src_pd_.set_format(nChw16c));
+            if (this->diff_dst_pd_.desc()->format == any)
+                CHECK(this->diff_dst_pd_.set_format(nChw16c));
+            if (this->diff_weights_pd_.desc()->format == any)
+                CHECK(this->diff_weights_pd_.set_format(
+                        this->with_groups() ? gOIhw16i16o : OIhw16i16o));
+            if (this->diff_bias_pd_.desc()->format == any)
+                CHECK(this->diff_bias_pd_.set_format(x));
+            return status::success;
+        }
+    };
+
+    jit_sve_convolution_winograd_bwd_weights_t(const pd_t *apd,
+            const input_vector &inputs, const output_vector &outputs)
+        : cpu_primitive_t(apd, inputs, outputs, true) {}
+
+    ~jit_sve_convolution_winograd_bwd_weights_t() {}
+
+    typedef typename prec_traits<data_type::f32>::type data_t;
+
+    virtual void execute(event_t *e) const {
+        assert(pd()->desc()->prop_kind == prop_kind::backward_weights
+                && "invalid prop_kind");
+        execute_backward_weights();
+        e->set_state(event_t::ready);
+    }
+
+private:
+    void execute_backward_weights() const;
+    const pd_t *pd() const { return (const pd_t *)primitive_t::pd(); }
+};
+
+}
+}
+}
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -0,0 +1,264 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef JIT_SVE_DW_CONV_KERNEL_F32_HPP
+#define JIT_SVE_DW_CONV_KERNEL_F32_HPP
+
+#include "c_types_map.hpp"
+#include "memory_tracking.hpp"
+
+#include "jit_generator.hpp"
+#include "jit_primitive_conf.hpp"
+#include "jit_sve_eltwise.hpp"
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+#define CGA64 CodeGeneratorAArch64
+namespace xa = Xbyak::Xbyak_aarch64;
+
+/* Depthwise convolution kernels for SVE with a 512-bit vector length.
+ *
+ * They follow jit_uni_dw_conv_*_kernel_f32<avx512_common> register by
+ * register: activations are nChw16c, weights Goihw16g and a vector holds the
+ * 16 channels of one pixel. The drivers and the configuration are shared with
+ * the x86 kernels (see jit_uni_dw_conv_kernel_utils.hpp). */
+struct jit_sve_dw_conv_kernel_base_t : public jit_generator {
+protected:
+    using reg64_t = const xa::XReg;
+
+    /* x4 is the stack pointer of translated code and x22-x28 are its
+     * temporaries, so the kernels do not use them. */
+    reg64_t reg_tmp_addr = x16;
+    reg64_t reg_tmp_imm = x17;
+
+    const xa::PReg reg_p_all_ones = p1;
+
+    void add_imm(reg64_t out, reg64_t in, long long int value) {
+        long long int val = (value >= 0) ? value : -1 * value;
+        if (val <= 4095) {
+            if (value >= 0) CGA64::add(out, in, val);
+            else CGA64::sub(out, in, val);
+        } else {
+            CGA64::mov(reg_tmp_imm, val & 0xffff);
+            for (int sh = 16; sh < 64; sh += 16)
+                if (val >> sh)
+                    CGA64::movk(reg_tmp_imm, (val >> sh) & 0xffff, sh);
+            if (value >= 0) CGA64::add(out, in, reg_tmp_imm);
+            else CGA64::sub(out, in, reg_tmp_imm);
+        }
+    }
+
+    /* Full vector load / store at base + offset bytes. ldr/str take the
+     * offset in vector lengths in [-256, 255]. */
+    bool is_vl_offset(long long int offset) {
+        return (offset & 0x3f) == 0 && (offset >> 6) <= 255
+            && (offset >> 6) >= -256;
+    }
+    void load_vector(const xa::ZReg &z, reg64_t base, long long int offset) {
+        if (is_vl_offset(offset)) {
+            CGA64::ldr(z, xa::ptr(base, static_cast<int32_t>(offset >> 6)));
+        } else {
+            add_imm(reg_tmp_addr, base, offset);
+            CGA64::ldr(z, xa::ptr(reg_tmp_addr));
+        }
+    }
+    void store_vector(const xa::ZReg &z, reg64_t base, long long int offset) {
+        if (is_vl_offset(offset)) {
+            CGA64::str(z, xa::ptr(base, static_cast<int32_t>(offset >> 6)));
+        } else {
+            add_imm(reg_tmp_addr, base, offset);
+            CGA64::str(z, xa::ptr(reg_tmp_addr));
+        }
+    }
+};
+
+struct jit_sve_dw_conv_fwd_kernel_f32 : public jit_sve_dw_conv_kernel_base_t {
+    DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_sve_dw_conv_fwd_kernel_f32)
+
+    jit_sve_dw_conv_fwd_kernel_f32(jit_conv_conf_t ajcp)
+        : jcp(ajcp), eltwise_injector_(nullptr) {
+        if (jcp.with_eltwise)
+            eltwise_injector_ = new jit_sve_eltwise_injector_f32(this,
+                    jcp.eltwise, true, x0, reg_p_all_ones, p2, p3);
+
+        this->generate();
+        jit_ker = (void (*)(jit_conv_call_s *)) this->getCode32();
+    }
+
+    ~jit_sve_dw_conv_fwd_kernel_f32() { delete eltwise_injector_; }
+
+    jit_conv_conf_t jcp;
+    void (*jit_ker)(jit_conv_call_s *);
+
+private:
+    reg64_t param = abi_param1_aarch64;
+    reg64_t reg_input = x1;
+    reg64_t aux_reg_input = x2;
+    reg64_t aux1_reg_input = x3;
+    reg64_t reg_kernel = x5;
+    reg64_t aux_reg_kernel = x6;
+    reg64_t aux1_reg_kernel = x7;
+    reg64_t reg_output = x8;
+    reg64_t reg_bias = x9;
+    reg64_t reg_kh = x10;
+    reg64_t reg_kw = x11;
+    reg64_t iter_kh = x12;
+    reg64_t iter_kw = x13;
+    reg64_t reg_ur_w = x14;
+    reg64_t reg_ch_blocks = x15;
+
+    /* z0: weights, z1: src, z4-z27: accumulators */
+    xa::ZReg get_ker_reg(int idx) { return xa::ZReg(idx + 0); }
+    xa::ZReg get_src_reg(int idx) { return xa::ZReg(idx + 1); }
+    xa::ZReg get_acc_reg(int idx) { return xa::ZReg(idx + 4); }
+    xa::ZRegS get_acc_reg_s(int idx) { return xa::ZRegS(idx + 4); }
+
+    inline void load_src(int ur_ch_blocks, int ur_w);
+    inline void apply_filter(int ur_ch_blocks, int ur_w);
+    inline void apply_filter_unrolled(int ur_ch_blocks, int ur_w);
+    inline void apply_activation(int ur_ch_blocks, int ur_w);
+    inline void store_dst(int ur_ch_blocks, int ur_w);
+    inline void loop_body(int ur_ch_blocks);
+
+    jit_sve_eltwise_injector_f32 *eltwise_injector_;
+
+    void generate();
+};
+
+struct jit_sve_dw_conv_bwd_data_kernel_f32
+    : public jit_sve_dw_conv_kernel_base_t {
+    DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_sve_dw_conv_bwd_data_kernel_f32)
+
+    jit_sve_dw_conv_bwd_data_kernel_f32(jit_conv_conf_t ajcp) : jcp(ajcp) {
+        this->generate();
+        jit_ker = (void (*)(jit_conv_call_s *)) this->getCode32();
+    }
+
+    jit_conv_conf_t jcp;
+    void (*jit_ker)(jit_conv_call_s *);
+
+private:
+    xa::ZReg get_ker_reg(int idx) { return xa::ZReg(idx + 0); }
+    xa::ZReg get_src_reg(int idx) { return xa::ZReg(idx + 1); }
+    xa::ZReg get_acc_reg(int idx) { return xa::ZReg(idx + 4); }
+    xa::ZRegS get_acc_reg_s(int idx) { return xa::ZRegS(idx + 4); }
+
+    reg64_t param = abi_param1_aarch64;
+    reg64_t reg_ddst = x1;
+    reg64_t aux_reg_ddst = x2;
+    reg64_t aux1_reg_ddst = x3;
+    reg64_t reg_kernel = x5;
+    reg64_t aux_reg_kernel = x6;
+    reg64_t aux1_reg_kernel = x7;
+    reg64_t reg_dsrc = x8;
+
+    reg64_t reg_ur_str_w = x9;
+    reg64_t reg_ch_blocks = x10;
+
+    reg64_t iter_kh = x11;
+    reg64_t iter_kw = x12;
+    reg64_t reg_kh = x13;
+    reg64_t reg_kw = x14;
+
+    inline void loop_body(int ur_ch_blocks);
+    inline void load_ddst(int ur_ch_blocks, int ur_str_w);
+    inline void apply_filter(int ur_ch_blocks, int ur_str_w);
+    inline void store_dsrc(int ur_ch_blocks, int ur_str_w);
+
+    void generate();
+};
+
+struct jit_sve_dw_conv_bwd_weights_kernel_f32
+    : public jit_sve_dw_conv_kernel_base_t {
+    DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_sve_dw_conv_bwd_weights_kernel_f32)
+
+    jit_sve_dw_conv_bwd_weights_kernel_f32(jit_conv_conf_t ajcp) : jcp(ajcp) {
+        this->generate();
+        jit_ker = (void (*)(jit_dw_conv_call_s *)) this->getCode32();
+    }
+
+    jit_conv_conf_t jcp;
+    void (*jit_ker)(jit_dw_conv_call_s *);
+
+private:
+    const int simd_w = cpu_isa_traits<sve>::vlen / sizeof(float);
+
+    /* XXX: offset between input and accummulators is 3, therefore, assume 'kw'
+     * is no larger than 3*/
+    xa::ZReg get_bias_reg(int idx = 0) { return xa::ZReg(idx); }
+    xa::ZReg get_output_reg(int idx) { return xa::ZReg(idx + 1); }
+    xa::ZReg get_input_reg(int idx) { return xa::ZReg(idx + 4 + 1); }
+    xa::ZReg get_acc_reg(int idx) { return xa::ZReg(idx + 1 + 1); }
+
+    reg64_t param = abi_param1_aarch64;
+    reg64_t reg_tmp_input = x1;
+    reg64_t reg_tmp_output = x2;
+    reg64_t reg_tmp_filter = x3;
+    reg64_t reg_kh_offset = x5;
+
+    /* parameter passed by driver into kernel */
+    reg64_t reg_exec_flags = x6;
+
+    reg64_t reg_oh_worksize = x7;
+    reg64_t reg_oh = x8;
+
+    reg64_t iter_ow_blk = x9;
+
+    reg64_t reg_kh = x10;
+    reg64_t reg_kh_count = x11;
+
+    /* Base addresses for convolution parameters. */
+    reg64_t reg_input_baddr = x12;
+    reg64_t reg_output_baddr = x13;
+    reg64_t reg_filter_baddr = x14;
+    reg64_t reg_bias_baddr = x15;
+
+    /* Micro-kernel JIT'ing, fusing 'kw' and 'ow_block' loops into unrolled FMAs
+     */
+    inline void compute_ow_step_unroll(
+            int unroll_w, int l_pad, int pad_offset, int ow_block);
+
+    /* JIT'ing the outer loops for the micro-kernel -> {kh, oh_block} */
+    inline void compute_h_step(
+            int unroll_w, int l_pad, int pad_offset, int ow_block);
+    inline void compute_h_loop(
+            int unroll_w, int l_pad, int pad_offset, int ow_block);
+
+    /* Write 'width' micro-kernel JITs; depending on the padding and convolution
+     * size, write a micro-kernel for the left ow-block, middle ow-block(s), and
+     * right ow-block.*/
+    inline void compute_ow_block_unroll();
+
+    inline void compute_zero_filter();
+    inline void load_filter();
+    inline void zero_filter();
+    inline void load_bias();
+    inline void zero_bias();
+    inline void compute_bias_step_unroll(const int unroll_w);
+    inline void compute_bias_loop(const int block_size);
+    inline void store_filter();
+    inline void store_bias();
+
+    void generate();
+};
+
+}
+}
+}
+
+#endif
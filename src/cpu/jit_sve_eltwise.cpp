@@ -0,0 +1,624 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "c_types_map.hpp"
+#include "math_utils.hpp"
+#include "mkldnn_thread.hpp"
+#include "nstl.hpp"
+#include "utils.hpp"
+
+#include "jit_sve_eltwise.hpp"
+
+#define GET_OFF(field) \
+        static_cast<int32_t>(offsetof(jit_sve_eltwise_call_s, field))
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+void jit_sve_eltwise_injector_f32::init_table() {
+    const uint32_t cvals[table_size] = {
+        (uint32_t)float2int(alpha_), // alpha_val
+        (uint32_t)float2int(beta_), // beta_val
+        0x3f800000, // one_val: 1.0f
+        // exp(x)
+        0x3fb8aa3b, // exp_log2e: log2(e)
+        0x3f317200, // exp_ln2_hi: ln(2), high bits
+        0x35bfbe8e, // exp_ln2_lo: ln(2) - exp_ln2_hi
+        0x48401f80, // exp_shift: 0x1.8p17 + 126, rounds to 1/64
+        0x3e2aaaab, // exp_p3: 1/6
+        0xc2ad496b, // exp_min_arg: ln(2^-125), below FEXPA has no exponent
+        0x42b17217, // exp_max_arg: logf(FLT_MAX)
+        // tanh(x)
+        0x39ddb3d7, // tanh_linear_ubound: arg below which tanh(x) = x
+        0x3f0c9f54, // tanh_pol_ubound: arg below which pol approx is valid
+        0x41102cb4, // tanh_saturation_lbound: arg after which tanh(x) = 1
+        0x3f7fffff, // tanh_pol0
+        0xbeaaa9cf, // tanh_pol1
+        0x3e085f1f, // tanh_pol2
+        0xbd572bda, // tanh_pol3
+        0x3c84fd08, // tanh_pol4
+        // gelu(x)
+        0x3d372713, // gelu_a: 0.044715
+        0x3f4c4229, // gelu_b: sqrt(2/pi)
+        // log(x) for x = 2^n * m, m in [0.5, 1)
+        0x42fc0000, // log_exp_bias: 126
+        0x3f317218, // log_ln2: ln(2)
+        0xb2b4637d, // log_pol0 = 0.0000000244f
+        0x3f7fff8e, // log_pol1 = 0.9999976971f
+        0xbf001759, // log_pol2 = -0.5002478215f
+        0x3ea70608, // log_pol3 = 0.3272714505f
+        0xbea3d7bf, // log_pol4 = -0.3153830071f
+        0xbe361d04, // log_pol5 = -0.1701777461f
+        0xbfa8f1e6, // log_pol6 = -1.3254635147f
+        0xbfe1e812, // log_pol7 = -1.7971917960f
+        0xbfc4d30e, // log_pol8 = -1.5652673123f
+    };
+
+    for (int i = 0; i < table_size; ++i)
+        table_[i] = cvals[i];
+}
+
+void jit_sve_eltwise_injector_f32::load_table_addr() {
+    const uint64_t addr = reinterpret_cast<uint64_t>(table_);
+
+    h->CGA64::mov(p_table, addr & 0xffff);
+    for (int sh = 16; sh < 64; sh += 16)
+        if (addr >> sh)
+            h->CGA64::movk(p_table, (addr >> sh) & 0xffff, sh);
+}
+
+void jit_sve_eltwise_injector_f32::load_const(const zreg_t &z, int index) {
+    h->CGA64::ld1rw(z, p_all, xa::ptr(p_table,
+            static_cast<int32_t>(index * sizeof(float))));
+}
+
+void jit_sve_eltwise_injector_f32::mov_vector(const zreg_t &dst,
+        const zreg_t &src) {
+    h->CGA64::orr(xa::ZRegD(dst.getIdx()), xa::ZRegD(src.getIdx()),
+            xa::ZRegD(src.getIdx()));
+}
+
+/* dst = 1 / src: an 8-bit estimate and two Newton-Raphson steps, which is
+ * accurate to about 1 ulp and, unlike FDIV, pipelined. */
+void jit_sve_eltwise_injector_f32::reciprocal(const zreg_t &dst,
+        const zreg_t &src, const zreg_t &tmp) {
+    h->CGA64::frecpe(dst, src);
+    for (int i = 0; i < 2; i++) {
+        h->CGA64::frecps(tmp, src, dst);
+        h->CGA64::fmul(dst, dst, tmp);
+    }
+}
+
+void jit_sve_eltwise_injector_f32::injector_preamble(size_t start_idx,
+        size_t end_idx) {
+    preserved_vecs_count = 0;
+    vecs_to_preserve = (size_t)aux_vecs_count(alg_);
+    start_idx_tail = start_idx;
+
+    for (size_t idx = 0; idx < vecs_count; idx++) {
+        if (preserved_vecs_count >= vecs_to_preserve) break;
+        if (start_idx <= idx && idx < end_idx) continue;
+
+        preserved_vec_idxs[preserved_vecs_count++] = idx;
+    }
+
+    size_t preserved_vecs_count_tail = vecs_to_preserve - preserved_vecs_count;
+    for (size_t i = 0; i < preserved_vecs_count_tail; i++) {
+        preserved_vec_idxs[preserved_vecs_count++] = start_idx_tail++;
+    }
+
+    assert(preserved_vecs_count == vecs_to_preserve);
+
+    if (save_state_) {
+        h->CGA64::str(p_table, xa::pre_ptr(h->CGA64::sp, -16));
+
+        if (preserved_vecs_count)
+            h->CGA64::sub(h->CGA64::sp, h->CGA64::sp,
+                    preserved_vecs_count * vlen);
+
+        for (size_t i = 0; i < preserved_vecs_count; ++i)
+            h->CGA64::str(xa::ZReg(preserved_vec_idxs[i]),
+                    xa::ptr(h->CGA64::sp, static_cast<int32_t>(i)));
+
+        load_table_addr();
+    }
+
+    assign_regs();
+}
+
+void jit_sve_eltwise_injector_f32::injector_preamble_tail(size_t start_idx) {
+    size_t tail_vecs_to_preserve = start_idx_tail - start_idx;
+    if (tail_vecs_to_preserve == 0) return;
+
+    const int idx_off = vecs_to_preserve - tail_vecs_to_preserve;
+
+    if (save_state_) {
+        if (idx_off)
+            h->CGA64::add(h->CGA64::sp, h->CGA64::sp, idx_off * vlen);
+
+        for (size_t i = 0; i < tail_vecs_to_preserve; ++i)
+            h->CGA64::ldr(xa::ZReg(preserved_vec_idxs[idx_off + i]),
+                    xa::ptr(h->CGA64::sp, static_cast<int32_t>(i)));
+    }
+
+    for (size_t i = 0; i < tail_vecs_to_preserve; ++i)
+        preserved_vec_idxs[idx_off + i] += tail_vecs_to_preserve;
+
+    if (save_state_) {
+        for (size_t i = 0; i < tail_vecs_to_preserve; ++i)
+            h->CGA64::str(xa::ZReg(preserved_vec_idxs[idx_off + i]),
+                    xa::ptr(h->CGA64::sp, static_cast<int32_t>(i)));
+
+        if (idx_off)
+            h->CGA64::sub(h->CGA64::sp, h->CGA64::sp, idx_off * vlen);
+    }
+
+    assign_regs();
+}
+
+void jit_sve_eltwise_injector_f32::injector_postamble() {
+    if (!save_state_) return;
+
+    for (size_t i = 0; i < preserved_vecs_count; ++i)
+        h->CGA64::ldr(xa::ZReg(preserved_vec_idxs[i]),
+                xa::ptr(h->CGA64::sp, static_cast<int32_t>(i)));
+
+    if (preserved_vecs_count)
+        h->CGA64::add(h->CGA64::sp, h->CGA64::sp,
+                preserved_vecs_count * vlen);
+
+    h->CGA64::ldr(p_table, xa::post_ptr(h->CGA64::sp, 16));
+}
+
+void jit_sve_eltwise_injector_f32::assign_regs() {
+    z_aux0 = zreg_t(preserved_vec_idxs[0]);
+    z_aux1 = zreg_t(preserved_vec_idxs[1]);
+    z_aux2 = zreg_t(preserved_vec_idxs[2]);
+    z_aux3 = zreg_t(preserved_vec_idxs[3]);
+    z_aux4 = zreg_t(preserved_vec_idxs[4]);
+}
+
+void jit_sve_eltwise_injector_f32::exp_compute_vector(const zreg_t &z) {
+    const auto pm = p_all / xa::T_m;
+
+    // mask of the arguments for which exp(x) is not flushed to 0
+    load_const(z_aux0, exp_min_arg);
+    h->CGA64::fcmge(p_mask.s, p_all / xa::T_z, z, z_aux0);
+    h->CGA64::fmax(z, pm, z_aux0);
+    load_const(z_aux0, exp_max_arg);
+    h->CGA64::fmin(z, pm, z_aux0);
+
+    // aux0 = x * log2(e) + shift: the sum is rounded to a multiple of 1/64
+    // and its low bits are the FEXPA input for 2^(n + j/64 - 1)
+    load_const(z_aux0, exp_shift);
+    load_const(z_aux1, exp_log2e);
+    h->CGA64::fmla(z_aux0, pm, z, z_aux1);
+    // aux1 = n + j/64
+    load_const(z_aux1, exp_shift);
+    h->CGA64::fsub(z_aux1, z_aux0, z_aux1);
+    // r = x - (n + j/64) * ln2
+    load_const(z_aux2, exp_ln2_hi);
+    h->CGA64::fmls(z, pm, z_aux1, z_aux2);
+    load_const(z_aux2, exp_ln2_lo);
+    h->CGA64::fmls(z, pm, z_aux1, z_aux2);
+    h->CGA64::fexpa(z_aux0, z_aux0);
+
+    // exp(r) - 1 = r + r^2 * (1/2 + r/6)
+    load_const(z_aux1, exp_p3);
+    h->CGA64::fmul(z_aux1, z_aux1, z);
+    h->CGA64::fadd(z_aux1, pm, 0.5f);
+    h->CGA64::fmul(z_aux2, z, z);
+    h->CGA64::fmul(z_aux1, z_aux1, z_aux2);
+    h->CGA64::fadd(z, z, z_aux1);
+
+    // exp(x) = 2 * 2^(n + j/64 - 1) * exp(r)
+    h->CGA64::fmla(z_aux0, pm, z_aux0, z);
+    h->CGA64::fadd(z, z_aux0, z_aux0);
+
+    h->CGA64::fmov(z_aux1);
+    h->CGA64::sel(z, p_mask, z, z_aux1);
+}
+
+void jit_sve_eltwise_injector_f32::relu_compute_vector(const zreg_t &z) {
+    load_const(z_aux0, alpha_val);
+    h->CGA64::fmul(z_aux0, z_aux0, z);
+    h->CGA64::fcmle(p_mask.s, p_all / xa::T_z, z, 0.0);
+    h->CGA64::sel(z, p_mask, z_aux0, z);
+}
+
+void jit_sve_eltwise_injector_f32::relu_zero_ns_compute_vector(
+        const zreg_t &z) {
+    h->CGA64::fmax(z, p_all / xa::T_m, 0.0f);
+}
+
+void jit_sve_eltwise_injector_f32::elu_compute_vector(const zreg_t &z) {
+    const auto pm = p_all / xa::T_m;
+
+    mov_vector(z_aux3, z);
+
+    // alpha * (exp(x) - 1)
+    exp_compute_vector(z);
+    h->CGA64::fsub(z, pm, 1.0f);
+    load_const(z_aux0, alpha_val);
+    h->CGA64::fmul(z, z, z_aux0);
+
+    // x for x > 0
+    h->CGA64::fcmgt(p_mask.s, p_all / xa::T_z, z_aux3, 0.0);
+    h->CGA64::sel(z, p_mask, z_aux3, z);
+}
+
+void jit_sve_eltwise_injector_f32::tanh_compute_vector(const zreg_t &z) {
+    const auto pm = p_all / xa::T_m;
+
+    // tanh(x) = -tanh(-x): compute on |x| and restore the sign at the end
+    h->CGA64::fcmlt(p_tmp.s, p_all / xa::T_z, z, 0.0);
+    h->CGA64::fabs(z, pm, z);
+    mov_vector(z_aux3, z);
+
+    // 1 - 2 / (exp(2x) + 1)
+    h->CGA64::fadd(z, z, z);
+    exp_compute_vector(z);
+    h->CGA64::fadd(z, pm, 1.0f);
+    reciprocal(z_aux0, z, z_aux1);
+    h->CGA64::fadd(z, z_aux0, z_aux0);
+    h->CGA64::fsubr(z, pm, 1.0f);
+
+    // x * (p0 + x^2 * (p1 + x^2 * (p2 + x^2 * (p3 + x^2 * p4))))
+    h->CGA64::fmul(z_aux0, z_aux3, z_aux3);
+    load_const(z_aux1, tanh_pol4);
+    for (int i = tanh_pol3; i >= tanh_pol0; i--) {
+        load_const(z_aux2, i);
+        h->CGA64::fmad(z_aux1, pm, z_aux0, z_aux2);
+    }
+    h->CGA64::fmul(z_aux1, z_aux1, z_aux3);
+    load_const(z_aux2, tanh_pol_ubound);
+    h->CGA64::fcmgt(p_mask.s, p_all / xa::T_z, z_aux2, z_aux3);
+    h->CGA64::sel(z, p_mask, z_aux1, z);
+
+    // x for small x, 1 for large x
+    load_const(z_aux2, tanh_linear_ubound);
+    h->CGA64::fcmgt(p_mask.s, p_all / xa::T_z, z_aux2, z_aux3);
+    h->CGA64::sel(z, p_mask, z_aux3, z);
+    load_const(z_aux2, tanh_saturation_lbound);
+    h->CGA64::fcmge(p_mask.s, p_all / xa::T_z, z_aux3, z_aux2);
+    load_const(z_aux1, one_val);
+    h->CGA64::sel(z, p_mask, z_aux1, z);
+
+    h->CGA64::fneg(z, p_tmp / xa::T_m, z);
+}
+
+void jit_sve_eltwise_injector_f32::gelu_compute_vector(const zreg_t &z) {
+    const auto pm = p_all / xa::T_m;
+
+    mov_vector(z_aux4, z);
+
+    // sqrt(2/pi) * x * (1 + 0.044715 * x^2)
+    h->CGA64::fmul(z_aux0, z, z);
+    load_const(z_aux1, gelu_a);
+    h->CGA64::fmul(z_aux0, z_aux0, z_aux1);
+    h->CGA64::fadd(z_aux0, pm, 1.0f);
+    h->CGA64::fmul(z, z, z_aux0);
+    load_const(z_aux1, gelu_b);
+    h->CGA64::fmul(z, z, z_aux1);
+
+    // 0.5 * x * (1 + tanh(...))
+    tanh_compute_vector(z);
+    h->CGA64::fadd(z, pm, 1.0f);
+    h->CGA64::fmul(z, pm, 0.5f);
+    h->CGA64::fmul(z, z, z_aux4);
+}
+
+void jit_sve_eltwise_injector_f32::square_compute_vector(const zreg_t &z) {
+    h->CGA64::fmul(z, z, z);
+}
+
+void jit_sve_eltwise_injector_f32::abs_compute_vector(const zreg_t &z) {
+    h->CGA64::fabs(z, p_all / xa::T_m, z);
+}
+
+void jit_sve_eltwise_injector_f32::sqrt_compute_vector(const zreg_t &z) {
+    // sqrt(x) for x > 0, 0 otherwise
+    h->CGA64::fmax(z, p_all / xa::T_m, 0.0f);
+    h->CGA64::fsqrt(z, p_all / xa::T_m, z);
+}
+
+void jit_sve_eltwise_injector_f32::linear_compute_vector(const zreg_t &z) {
+    load_const(z_aux0, alpha_val);
+    h->CGA64::fmul(z, z, z_aux0);
+    load_const(z_aux0, beta_val);
+    h->CGA64::fadd(z, z, z_aux0);
+}
+
+void jit_sve_eltwise_injector_f32::bounded_relu_compute_vector(
+        const zreg_t &z) {
+    h->CGA64::fmax(z, p_all / xa::T_m, 0.0f);
+    load_const(z_aux0, alpha_val);
+    h->CGA64::fmin(z, p_all / xa::T_m, z_aux0);
+}
+
+void jit_sve_eltwise_injector_f32::soft_relu_compute_vector(
+        const zreg_t &z) {
+    const auto pm = p_all / xa::T_m;
+
+    // log(1 + exp(x)) = max(x, 0) + log(1 + exp(-|x|))
+    mov_vector(z_aux3, z);
+    h->CGA64::fabs(z, pm, z);
+    h->CGA64::fneg(z, pm, z);
+    exp_compute_vector(z);
+    h->CGA64::fadd(z, pm, 1.0f);
+
+    // y = 2^n * m, m in [0.5, 1)
+    h->CGA64::lsr(z_aux0, z, 23);
+    h->CGA64::scvtf(z_aux0, pm, z_aux0);
+    load_const(z_aux1, log_exp_bias);
+    h->CGA64::fsub(z_aux0, z_aux0, z_aux1);
+    h->CGA64::and_(z, 0x807fffff);
+    h->CGA64::orr(z, 0x3f000000);
+
+    // log(y) = n * ln2 + log(1 + (m - 1))
+    h->CGA64::fsub(z, pm, 1.0f);
+    load_const(z_aux1, log_pol8);
+    for (int i = log_pol7; i >= log_pol0; i--) {
+        load_const(z_aux2, i);
+        h->CGA64::fmad(z_aux1, pm, z, z_aux2);
+    }
+    load_const(z_aux2, log_ln2);
+    h->CGA64::fmla(z_aux1, pm, z_aux0, z_aux2);
+
+    h->CGA64::fmax(z_aux3, pm, 0.0f);
+    h->CGA64::fadd(z, z_aux1, z_aux3);
+}
+
+void jit_sve_eltwise_injector_f32::logistic_compute_vector(const zreg_t &z) {
+    const auto pm = p_all / xa::T_m;
+
+    // logistic(x) = 1 - logistic(-x): compute on -|x|, then fix positive x
+    h->CGA64::fcmgt(p_tmp.s, p_all / xa::T_z, z, 0.0);
+    h->CGA64::fabs(z, pm, z);
+    h->CGA64::fneg(z, pm, z);
+
+    // exp(x) / (exp(x) + 1)
+    exp_compute_vector(z);
+    mov_vector(z_aux2, z);
+    h->CGA64::fadd(z_aux2, pm, 1.0f);
+    reciprocal(z_aux0, z_aux2, z_aux1);
+    h->CGA64::fmul(z, z, z_aux0);
+
+    h->CGA64::fsubr(z, p_tmp / xa::T_m, 1.0f);
+}
+
+int jit_sve_eltwise_injector_f32::aux_vecs_count(alg_kind_t alg_) {
+    switch (alg_) {
+    case alg_kind::eltwise_relu: return (alpha_ == 0.f) ? 0 : 1;
+    case alg_kind::eltwise_elu: return 4;
+    case alg_kind::eltwise_tanh: return 4;
+    case alg_kind::eltwise_square: return 0;
+    case alg_kind::eltwise_abs: return 0;
+    case alg_kind::eltwise_sqrt: return 0;
+    case alg_kind::eltwise_linear: return 1;
+    case alg_kind::eltwise_bounded_relu: return 1;
+    case alg_kind::eltwise_soft_relu: return 4;
+    case alg_kind::eltwise_logistic: return 3;
+    case alg_kind::eltwise_exp: return 3;
+    case alg_kind::eltwise_gelu: return 5;
+    default: assert(!"unsupported eltwise algorithm");
+    }
+
+    return 0;
+}
+
+void jit_sve_eltwise_injector_f32::compute_body(size_t start_idx,
+        size_t end_idx) {
+    using namespace alg_kind;
+    for (size_t idx = start_idx; idx < end_idx; idx++) {
+        const zreg_t z(idx);
+        switch (alg_) {
+        case eltwise_relu:
+            if (alpha_ == 0.f) relu_zero_ns_compute_vector(z);
+            else relu_compute_vector(z);
+            break;
+        case eltwise_elu: elu_compute_vector(z); break;
+        case eltwise_tanh: tanh_compute_vector(z); break;
+        case eltwise_square: square_compute_vector(z); break;
+        case eltwise_abs: abs_compute_vector(z); break;
+        case eltwise_sqrt: sqrt_compute_vector(z); break;
+        case eltwise_linear: linear_compute_vector(z); break;
+        case eltwise_bounded_relu: bounded_relu_compute_vector(z); break;
+        case eltwise_soft_relu: soft_relu_compute_vector(z); break;
+        case eltwise_logistic: logistic_compute_vector(z); break;
+        case eltwise_exp: exp_compute_vector(z); break;
+        case eltwise_gelu: gelu_compute_vector(z); break;
+        default: assert(!"unsupported eltwise algorithm");
+        }
+    }
+}
+
+void jit_sve_eltwise_injector_f32::compute_vector_range(size_t start_idx,
+        size_t end_idx) {
+    assert(start_idx < end_idx && end_idx <= vecs_count);
+
+    injector_preamble(start_idx, end_idx);
+    compute_body(start_idx_tail, end_idx);
+    injector_preamble_tail(start_idx);
+    compute_body(start_idx, start_idx_tail);
+    injector_postamble();
+}
+
+struct jit_sve_eltwise_call_s {
+    const float *from;
+    float *to;
+    size_t work_amount;
+};
+
+/* Forward kernel: unroll_ full vectors per iteration, then the tail one
+ * vector at a time under a WHILELT predicate. It follows AAPCS64 directly
+ * and keeps to caller-saved registers (z0-z4 for the injector, z16 and up
+ * for the data), so it needs no preamble. */
+struct jit_sve_eltwise_kernel_f32 : public jit_generator {
+    DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_sve_eltwise_kernel_f32)
+
+    jit_sve_eltwise_kernel_f32(const eltwise_desc_t &desc)
+        : injector_(nullptr) {
+        injector_ = new jit_sve_eltwise_injector_f32(this, desc.alg_kind,
+                desc.alpha, desc.beta, false, reg_table, reg_p_all_ones,
+                reg_p_mask, reg_p_tmp);
+
+        generate();
+        jit_ker = (void (*)(const jit_sve_eltwise_call_s *))getCode32();
+    }
+
+    ~jit_sve_eltwise_kernel_f32() { delete injector_; }
+
+    void operator()(const jit_sve_eltwise_call_s *args) const
+    { assert(jit_ker); jit_ker(args); }
+
+private:
+    using reg64_t = const xa::XReg;
+
+    static constexpr int simd_w_ = cpu_isa_traits<sve>::vlen / sizeof(float);
+    static constexpr int unroll_ = 4;
+    static constexpr int vreg_idx_ = 16;
+
+    reg64_t param = abi_param1_aarch64;
+    reg64_t reg_from = x1;
+    reg64_t reg_to = x2;
+    reg64_t reg_work_amount = x3;
+    reg64_t reg_table = x4;
+    reg64_t reg_zero = x5;
+
+    const xa::PReg reg_p_all_ones = p0;
+    const xa::PReg reg_p_tail = p1;
+    const xa::PReg reg_p_mask = p2;
+    const xa::PReg reg_p_tmp = p3;
+
+    jit_sve_eltwise_injector_f32 *injector_;
+    void (*jit_ker)(const jit_sve_eltwise_call_s *);
+
+    void generate() {
+        const int vlen = cpu_isa_traits<sve>::vlen;
+
+        CGA64::ldr(reg_from, xa::ptr(param, GET_OFF(from)));
+        CGA64::ldr(reg_to, xa::ptr(param, GET_OFF(to)));
+        CGA64::ldr(reg_work_amount, xa::ptr(param, GET_OFF(work_amount)));
+
+        CGA64::ptrue(reg_p_all_ones.s);
+        CGA64::mov(reg_zero, 0);
+        injector_->load_table_addr();
+
+        xa::LabelAArch64 unrolled_loop;
+        xa::LabelAArch64 tail_loop;
+        xa::LabelAArch64 exit_label;
+
+        CGA64::L_aarch64(unrolled_loop); {
+            CGA64::cmp(reg_work_amount, unroll_ * simd_w_);
+            CGA64::b(xa::LT, tail_loop);
+
+            for (int i = 0; i < unroll_; i++)
+                CGA64::ldr(xa::ZReg(vreg_idx_ + i), xa::ptr(reg_from, i));
+            injector_->compute_vector_range(vreg_idx_, vreg_idx_ + unroll_);
+            for (int i = 0; i < unroll_; i++)
+                CGA64::str(xa::ZReg(vreg_idx_ + i), xa::ptr(reg_to, i));
+
+            CGA64::add(reg_from, reg_from, unroll_ * vlen);
+            CGA64::add(reg_to, reg_to, unroll_ * vlen);
+            CGA64::sub(reg_work_amount, reg_work_amount, unroll_ * simd_w_);
+            CGA64::b(unrolled_loop);
+        }
+
+        CGA64::L_aarch64(tail_loop); {
+            CGA64::cmp(reg_work_amount, 0);
+            CGA64::b(xa::LE, exit_label);
+
+            CGA64::whilelt(reg_p_tail.s, reg_zero, reg_work_amount);
+            CGA64::ld1w(xa::ZRegS(vreg_idx_), reg_p_tail / xa::T_z,
+                    xa::ptr(reg_from));
+            injector_->compute_vector(vreg_idx_);
+            CGA64::st1w(xa::ZRegS(vreg_idx_), reg_p_tail, xa::ptr(reg_to));
+
+            CGA64::add(reg_from, reg_from, vlen);
+            CGA64::add(reg_to, reg_to, vlen);
+            CGA64::sub(reg_work_amount, reg_work_amount, simd_w_);
+            CGA64::b(tail_loop);
+        }
+
+        CGA64::L_aarch64(exit_label);
+        CGA64::ret();
+    }
+};
+
+status_t jit_sve_eltwise_fwd_t::pd_t::init() {
+    using namespace alg_kind;
+
+    assert(engine()->kind() == engine_kind::cpu);
+    bool ok = true && mayiuse(sve)
+        && utils::one_of(desc()->prop_kind, prop_kind::forward_training,
+                prop_kind::forward_inference)
+        && desc()->data_desc.data_type == data_type::f32
+        && !has_zero_dim_memory()
+        && utils::one_of(desc()->alg_kind, eltwise_relu, eltwise_tanh,
+                eltwise_elu, eltwise_square, eltwise_abs, eltwise_sqrt,
+                eltwise_linear, eltwise_bounded_relu, eltwise_soft_relu,
+                eltwise_logistic, eltwise_exp, eltwise_gelu)
+        && memory_desc_wrapper(src_pd()).is_dense(true)
+        && IMPLICATION(!memory_desc_wrapper(src_pd()).is_dense(false),
+                math::eltwise_fwd_preserves_zero(desc()->alg_kind, true))
+        && attr()->has_default_values();
+
+    return ok ? status::success : status::unimplemented;
+}
+
+jit_sve_eltwise_fwd_t::jit_sve_eltwise_fwd_t(const pd_t *apd,
+        const input_vector &inputs, const output_vector &outputs)
+    : cpu_primitive_t(apd, inputs, outputs), kernel_(nullptr) {
+    kernel_ = new jit_sve_eltwise_kernel_f32(*pd()->desc());
+}
+
+jit_sve_eltwise_fwd_t::~jit_sve_eltwise_fwd_t() { delete kernel_; }
+
+void jit_sve_eltwise_fwd_t::execute_forward() const {
+    auto src = reinterpret_cast<const data_t *>(this->input_memory(0));
+    auto dst = reinterpret_cast<data_t *>(this->memory(0));
+
+    const memory_desc_wrapper data_d(pd()->src_pd());
+
+    const size_t nelems = data_d.nelems(true);
+
+    src += data_d.blocking_desc().offset_padding;
+    dst += data_d.blocking_desc().offset_padding;
+
+    const int cache_line = 16;
+    parallel(0, [&](const int ithr, const int nthr) {
+        size_t start{0}, end{0};
+
+        balance211(utils::div_up(nelems, cache_line), nthr, ithr, start, end);
+        start = nstl::min(nelems, start * cache_line);
+        end = nstl::min(nelems, end * cache_line);
+
+        jit_sve_eltwise_call_s arg;
+        arg.from = &src[start];
+        arg.to = &dst[start];
+        arg.work_amount = end - start;
+        if (arg.work_amount)
+            (*kernel_)(&arg);
+    });
+}
+
+}
+}
+}
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -0,0 +1,211 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_JIT_SVE_ELTWISE_HPP
+#define CPU_JIT_SVE_ELTWISE_HPP
+
+#include <assert.h>
+#include <stdint.h>
+
+#include "c_types_map.hpp"
+#include "cpu_eltwise_pd.hpp"
+#include "cpu_engine.hpp"
+#include "type_helpers.hpp"
+#include "utils.hpp"
+#include "jit_generator.hpp"
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+#define CGA64 CodeGeneratorAArch64
+namespace xa = Xbyak::Xbyak_aarch64;
+
+/* Eltwise injector for SVE with a 512-bit vector length, written directly in
+ * Xbyak_aarch64. It has the interface of jit_uni_eltwise_injector_f32 and
+ * computes the same algorithms, with:
+ *   - exp based on FEXPA: x = (n + j/64) * ln2 + r, 2^(n + j/64) comes from
+ *     FEXPA and exp(r), |r| <= ln2/128, from a degree-3 polynomial,
+ *   - reciprocals from FRECPE refined by two FRECPS steps instead of FDIV,
+ *   - blends and sign fixes done with predicates.
+ *
+ * The constants live in the injector object: load_table_addr() puts their
+ * address in p_table and they are broadcast with LD1RW, so prepare_table()
+ * emits no code. The injector overwrites p_mask and p_tmp, and expects
+ * p_all to be all true when the vectors are computed. */
+struct jit_sve_eltwise_injector_f32 {
+    jit_sve_eltwise_injector_f32(jit_generator *host, alg_kind_t alg,
+            float alpha, float beta, bool save_state = true,
+            xa::XReg p_table = xa::XReg(0), xa::PReg p_all = xa::PReg(1),
+            xa::PReg p_mask = xa::PReg(2), xa::PReg p_tmp = xa::PReg(3))
+        : alg_(alg), alpha_(alpha), beta_(beta), h(host)
+        , save_state_(save_state), p_table(p_table), p_all(p_all)
+        , p_mask(p_mask), p_tmp(p_tmp)
+    {
+        using namespace alg_kind;
+        assert(utils::one_of(alg_, eltwise_relu, eltwise_tanh, eltwise_elu,
+                    eltwise_square, eltwise_abs, eltwise_sqrt, eltwise_linear,
+                    eltwise_bounded_relu, eltwise_soft_relu, eltwise_logistic,
+                    eltwise_exp, eltwise_gelu));
+        init_table();
+    }
+
+    // note that eltwise.scale is ignored
+    jit_sve_eltwise_injector_f32(jit_generator *host,
+            const post_ops_t::entry_t::eltwise_t &eltwise,
+            bool save_state = true, xa::XReg p_table = xa::XReg(0),
+            xa::PReg p_all = xa::PReg(1), xa::PReg p_mask = xa::PReg(2),
+            xa::PReg p_tmp = xa::PReg(3))
+        : jit_sve_eltwise_injector_f32(host, eltwise.alg, eltwise.alpha,
+                eltwise.beta, save_state, p_table, p_all, p_mask, p_tmp) {}
+
+    void compute_vector_range(size_t start_idx, size_t end_idx);
+    void compute_vector(size_t idx) { compute_vector_range(idx, idx + 1); }
+    void prepare_table(bool gen_table = true) { UNUSED(gen_table); }
+    void load_table_addr();
+
+    const alg_kind_t alg_;
+    const float alpha_;
+    const float beta_;
+
+    jit_generator * const h;
+
+    const bool save_state_;
+    const xa::XReg p_table;
+    const xa::PReg p_all;
+    const xa::PReg p_mask;
+    const xa::PReg p_tmp;
+
+private:
+    using zreg_t = xa::ZRegS;
+
+    enum {
+        alpha_val = 0,
+        beta_val,
+        one_val,
+        exp_log2e,
+        exp_ln2_hi,
+        exp_ln2_lo,
+        exp_shift,
+        exp_p3,
+        exp_min_arg,
+        exp_max_arg,
+        tanh_linear_ubound,
+        tanh_pol_ubound,
+        tanh_saturation_lbound,
+        tanh_pol0,
+        tanh_pol1,
+        tanh_pol2,
+        tanh_pol3,
+        tanh_pol4,
+        gelu_a,
+        gelu_b,
+        log_exp_bias,
+        log_ln2,
+        log_pol0,
+        log_pol1,
+        log_pol2,
+        log_pol3,
+        log_pol4,
+        log_pol5,
+        log_pol6,
+        log_pol7,
+        log_pol8,
+        table_size,
+    };
+    uint32_t table_[table_size];
+
+    const static size_t vlen = cpu_isa_traits<sve>::vlen;
+    const static size_t vecs_count = 32;
+    const static size_t preserved_vecs_max = 5;
+
+    size_t vecs_to_preserve = 0;
+    size_t preserved_vecs_count = 0;
+    size_t preserved_vec_idxs[preserved_vecs_max] = {0};
+    size_t start_idx_tail = 0;
+
+    zreg_t z_aux0 = zreg_t(0), z_aux1 = zreg_t(0), z_aux2 = zreg_t(0),
+           z_aux3 = zreg_t(0), z_aux4 = zreg_t(0);
+
+    void init_table();
+    void load_const(const zreg_t &z, int index);
+    void mov_vector(const zreg_t &dst, const zreg_t &src);
+    void reciprocal(const zreg_t &dst, const zreg_t &src, const zreg_t &tmp);
+
+    int aux_vecs_count(alg_kind_t alg);
+
+    void compute_body(size_t start_idx, size_t end_idx);
+    void injector_preamble(size_t start_idx, size_t end_idx);
+    void injector_preamble_tail(size_t start_idx);
+    void injector_postamble();
+    void assign_regs();
+
+    void exp_compute_vector(const zreg_t &z);
+    void relu_compute_vector(const zreg_t &z);
+    void relu_zero_ns_compute_vector(const zreg_t &z);
+    void elu_compute_vector(const zreg_t &z);
+    void tanh_compute_vector(const zreg_t &z);
+    void square_compute_vector(const zreg_t &z);
+    void abs_compute_vector(const zreg_t &z);
+    void sqrt_compute_vector(const zreg_t &z);
+    void linear_compute_vector(const zreg_t &z);
+    void bounded_relu_compute_vector(const zreg_t &z);
+    void soft_relu_compute_vector(const zreg_t &z);
+    void logistic_compute_vector(const zreg_t &z);
+    void gelu_compute_vector(const zreg_t &z);
+};
+
+struct jit_sve_eltwise_kernel_f32;
+
+struct jit_sve_eltwise_fwd_t : public cpu_primitive_t {
+    struct pd_t : public cpu_eltwise_fwd_pd_t {
+        pd_t(engine_t *engine, const eltwise_desc_t *adesc,
+                const primitive_attr_t *attr,
+                const eltwise_fwd_pd_t *hint_fwd_pd)
+            : cpu_eltwise_fwd_pd_t(engine, adesc, attr, hint_fwd_pd) {}
+
+        DECLARE_COMMON_PD_T(
+                JIT_IMPL_NAME_HELPER("jit:", sve, ""),
+                jit_sve_eltwise_fwd_t);
+
+        virtual status_t init() override;
+    };
+
+    jit_sve_eltwise_fwd_t(const pd_t *apd, const input_vector &inputs,
+                       const output_vector &outputs);
+    ~jit_sve_eltwise_fwd_t();
+
+    typedef float data_t;
+
+    virtual void execute(event_t *e) const
+    {
+        execute_forward();
+        e->set_state(event_t::ready);
+    }
+
+private:
+    void execute_forward() const;
+    const pd_t *pd() const { return (const pd_t *)primitive_t::pd(); }
+    jit_sve_eltwise_kernel_f32 *kernel_;
+};
+
+}
+}
+}
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -0,0 +1,413 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "c_types_map.hpp"
+#include "nstl.hpp"
+#include "utils.hpp"
+
+#include "cpu_pooling_pd.hpp"
+#include "jit_sve_pool_kernel.hpp"
+
+#define GET_OFF(field) \
+        static_cast<int32_t>(offsetof(jit_pool_call_s, field))
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+using namespace mkldnn::impl::alg_kind;
+using namespace mkldnn::impl::memory_format;
+
+status_t jit_sve_pool_kernel::init_conf(jit_pool_conf_t &jpp,
+        const pooling_desc_t &pd, const memory_desc_wrapper &src_d,
+        const memory_desc_wrapper &dst_d) {
+    bool args_ok = true
+        && src_d.ndims() == 4
+        && utils::one_of(pd.alg_kind, pooling_max,
+                pooling_avg_include_padding, pooling_avg_exclude_padding)
+        && utils::one_of(src_d.format(), nChw16c, nhwc)
+        && src_d.format() == dst_d.format();
+    if (!args_ok) return status::unimplemented;
+
+    jpp.ndims = 4;
+    jpp.is_nhwc = src_d.format() == nhwc;
+    jpp.mb = src_d.dims()[0];
+
+    /* nhwc is processed in 16-channel chunks with a predicated tail, the
+     * padded channels of nChw16c are computed as the others */
+    jpp.c_block = simd_w_;
+    jpp.c = jpp.is_nhwc
+        ? src_d.dims()[1] : utils::rnd_up(src_d.dims()[1], simd_w_);
+    if (!jpp.is_nhwc && jpp.c > src_d.blocking_desc().padding_dims[1])
+        return status::unimplemented;
+    jpp.nb_c = utils::div_up(jpp.c, simd_w_);
+    jpp.c_tail = jpp.c % simd_w_;
+
+    jpp.id = jpp.od = jpp.kd = jpp.stride_d = 1;
+    jpp.f_pad = 0;
+    jpp.ih = src_d.dims()[2];
+    jpp.iw = src_d.dims()[3];
+    jpp.oh = dst_d.dims()[2];
+    jpp.ow = dst_d.dims()[3];
+
+    jpp.stride_h = pd.strides[0];
+    jpp.stride_w = pd.strides[1];
+    jpp.kh = pd.kernel[0];
+    jpp.kw = pd.kernel[1];
+
+    jpp.t_pad = pd.padding[0][0];
+    jpp.l_pad = pd.padding[0][1];
+
+    const int right_pad = (jpp.ow - 1) * jpp.stride_w + jpp.kw
+        - (jpp.iw + jpp.l_pad);
+    const int bottom_pad = (jpp.oh - 1) * jpp.stride_h + jpp.kh
+        - (jpp.ih + jpp.t_pad);
+    if (jpp.t_pad >= jpp.kh || jpp.l_pad >= jpp.kw
+            || bottom_pad >= jpp.kh || right_pad >= jpp.kw)
+        return status::unimplemented;
+
+    jpp.alg = pd.alg_kind;
+    jpp.is_training = pd.prop_kind == prop_kind::forward_training;
+    jpp.is_backward = utils::one_of(pd.prop_kind, prop_kind::backward,
+            prop_kind::backward_data);
+    jpp.ind_dt = pooling_index_data_type(&pd);
+
+    jpp.src_dt = jpp.dst_dt = data_type::f32;
+    jpp.is_bf16 = false;
+    jpp.dt_size = sizeof(float);
+    jpp.isa = sve;
+
+    /* the window covers the whole image: the driver may split the rows of
+     * a (n, c) vector across threads */
+    jpp.is_global = true
+        && jpp.oh == 1 && jpp.ow == 1
+        && jpp.kh == jpp.ih && jpp.kw == jpp.iw
+        && jpp.t_pad == 0 && jpp.l_pad == 0;
+
+    return status::success;
+}
+
+void jit_sve_pool_kernel::add_imm(reg64_t out, reg64_t in,
+        long long int value) {
+    long long int val = (value >= 0) ? value : -1 * value;
+    if (val <= 4095) {
+        if (value >= 0) CGA64::add(out, in, val);
+        else CGA64::sub(out, in, val);
+    } else {
+        CGA64::mov(reg_tmp_imm, val & 0xffff);
+        for (int sh = 16; sh < 64; sh += 16)
+            if (val >> sh)
+                CGA64::movk(reg_tmp_imm, (val >> sh) & 0xffff, sh);
+        if (value >= 0) CGA64::add(out, in, reg_tmp_imm);
+        else CGA64::sub(out, in, reg_tmp_imm);
+    }
+}
+
+void jit_sve_pool_kernel::mov_imm(const xa::WReg &out, uint32_t value) {
+    CGA64::mov(out, value & 0xffff);
+    if (value >> 16)
+        CGA64::movk(out, value >> 16, 16);
+}
+
+void jit_sve_pool_kernel::mov_vector(const zreg_t &dst, const zreg_t &src) {
+    CGA64::orr(xa::ZRegD(dst.getIdx()), xa::ZRegD(src.getIdx()),
+            xa::ZRegD(src.getIdx()));
+}
+
+/* nChw16c pixels are one vector apart and are accessed with LDR/STR and an
+ * offset in vector lengths; nhwc pixels are predicated by the channel tail */
+void jit_sve_pool_kernel::load_data(const zreg_t &z, reg64_t base,
+        long long int offset) {
+    const bool vl_offset = (offset & 0x3f) == 0 && (offset >> 6) <= 255;
+    if (!jpp.is_nhwc && vl_offset) {
+        CGA64::ldr(xa::ZReg(z.getIdx()),
+                xa::ptr(base, static_cast<int32_t>(offset >> 6)));
+    } else if (offset == 0) {
+        CGA64::ld1w(z, reg_p_c / xa::T_z, xa::ptr(base));
+    } else {
+        add_imm(reg_tmp_addr, base, offset);
+        CGA64::ld1w(z, reg_p_c / xa::T_z, xa::ptr(reg_tmp_addr));
+    }
+}
+
+void jit_sve_pool_kernel::store_data(const zreg_t &z, reg64_t base,
+        long long int offset) {
+    const bool vl_offset = (offset & 0x3f) == 0 && (offset >> 6) <= 255;
+    if (!jpp.is_nhwc && vl_offset) {
+        CGA64::str(xa::ZReg(z.getIdx()),
+                xa::ptr(base, static_cast<int32_t>(offset >> 6)));
+    } else if (offset == 0) {
+        CGA64::st1w(z, reg_p_c, xa::ptr(base));
+    } else {
+        add_imm(reg_tmp_addr, base, offset);
+        CGA64::st1w(z, reg_p_c, xa::ptr(reg_tmp_addr));
+    }
+}
+
+void jit_sve_pool_kernel::load_indices(const zreg_t &z, reg64_t base,
+        long long int offset) {
+    if (offset != 0) {
+        add_imm(reg_tmp_addr, base, offset);
+        base = reg_tmp_addr;
+    }
+    if (jpp.ind_dt == data_type::u8)
+        CGA64::ld1b(z, reg_p_c / xa::T_z, xa::ptr(base));
+    else
+        CGA64::ld1w(z, reg_p_c / xa::T_z, xa::ptr(base));
+}
+
+void jit_sve_pool_kernel::store_indices(const zreg_t &z, reg64_t base,
+        long long int offset) {
+    if (offset != 0) {
+        add_imm(reg_tmp_addr, base, offset);
+        base = reg_tmp_addr;
+    }
+    if (jpp.ind_dt == data_type::u8)
+        CGA64::st1b(z, reg_p_c, xa::ptr(base));
+    else
+        CGA64::st1w(z, reg_p_c, xa::ptr(base));
+}
+
+/* z = number of summands of an average over kw_len kernel columns */
+void jit_sve_pool_kernel::load_divisor(const zreg_t &z, int kw_len) {
+    const xa::WReg w_tmp(reg_tmp_imm.getIdx());
+    if (jpp.alg == pooling_avg_include_padding) {
+        mov_imm(w_tmp, float2int((float)(jpp.kh * jpp.kw)));
+        CGA64::dup(z, w_tmp);
+    } else {
+        mov_imm(w_tmp, float2int((float)kw_len));
+        CGA64::dup(z, w_tmp);
+        CGA64::fmul(z, z, z_area_h);
+    }
+}
+
+void jit_sve_pool_kernel::compute_fwd_pixel(int kw_s, int kw_e,
+        reg64_t src_base, long long int src_off, reg64_t dst_base,
+        long long int dst_off, reg64_t ind_base, long long int ind_off) {
+    const bool is_max = jpp.alg == pooling_max;
+    const bool with_ind = with_indices();
+    const int nkw = kw_e - kw_s;
+    const int pix = src_pix_bytes();
+
+    /* independent accumulators hide the latency of the reduction, the
+     * index of the maximum needs them in order */
+    const int nacc = with_ind ? 1 : nstl::min(max_acc_, nkw);
+
+    for (int i = 0; i < nacc; i++) {
+        if (is_max) mov_vector(z_acc(i), z_lowest);
+        else CGA64::fmov(z_acc(i));
+    }
+    if (with_ind) {
+        add_imm(reg_cur_idx, reg_kh_shift, kw_s);
+        CGA64::dup(z_idx, xa::WReg(reg_cur_idx.getIdx()));
+    }
+
+    add_imm(reg_aux_src, src_base, src_off);
+    CGA64::mov(reg_kh_cnt, reg_kh);
+
+    xa::LabelAArch64 kh_label;
+    CGA64::L_aarch64(kh_label); {
+        if (with_ind)
+            CGA64::dup(z_cur_idx, xa::WReg(reg_cur_idx.getIdx()));
+        for (int j = 0; j < nkw; j++) {
+            const zreg_t z = z_tap(j % max_acc_);
+            const zreg_t acc = z_acc(j % nacc);
+            load_data(z, reg_aux_src, (long long int)j * pix);
+            if (is_max && with_ind) {
+                CGA64::fcmgt(reg_p_tmp.s, reg_p_c / xa::T_z, z, acc);
+                CGA64::sel(acc, reg_p_tmp, z, acc);
+                CGA64::sel(z_idx, reg_p_tmp, z_cur_idx, z_idx);
+                if (j < nkw - 1) CGA64::add(z_cur_idx, 1);
+            } else if (is_max) {
+                CGA64::fmax(acc, reg_p_c / xa::T_m, z);
+            } else {
+                CGA64::fadd(acc, acc, z);
+            }
+        }
+        if (with_ind) add_imm(reg_cur_idx, reg_cur_idx, jpp.kw);
+        add_imm(reg_aux_src, reg_aux_src, (long long int)jpp.iw * pix);
+        CGA64::sub(reg_kh_cnt, reg_kh_cnt, 1);
+        CGA64::cmp(reg_kh_cnt, 0);
+        CGA64::b(xa::GT, kh_label);
+    }
+
+    for (int i = 1; i < nacc; i++) {
+        if (is_max) CGA64::fmax(z_acc(0), reg_p_c / xa::T_m, z_acc(i));
+        else CGA64::fadd(z_acc(0), z_acc(0), z_acc(i));
+    }
+
+    if (!is_max) {
+        if (jpp.alg == pooling_avg_include_padding || nkw == jpp.kw) {
+            CGA64::fdiv(z_acc(0), reg_p_c / xa::T_m, z_div);
+        } else {
+            load_divisor(z_tmp, nkw);
+            CGA64::fdiv(z_acc(0), reg_p_c / xa::T_m, z_tmp);
+        }
+    }
+
+    store_data(z_acc(0), dst_base, dst_off);
+    if (with_ind) store_indices(z_idx, ind_base, ind_off);
+}
+
+void jit_sve_pool_kernel::compute_bwd_pixel(int kw_s, int kw_e,
+        reg64_t src_base, long long int src_off, reg64_t dst_base,
+        long long int dst_off, reg64_t ind_base, long long int ind_off) {
+    const bool is_max = jpp.alg == pooling_max;
+    const int nkw = kw_e - kw_s;
+    const int pix = src_pix_bytes();
+
+    load_data(z_dd, dst_base, dst_off);
+    if (is_max) {
+        load_indices(z_idx, ind_base, ind_off);
+        add_imm(reg_cur_idx, reg_kh_shift, kw_s);
+    } else if (jpp.alg == pooling_avg_include_padding || nkw == jpp.kw) {
+        CGA64::fdiv(z_dd, reg_p_c / xa::T_m, z_div);
+    } else {
+        load_divisor(z_tmp, nkw);
+        CGA64::fdiv(z_dd, reg_p_c / xa::T_m, z_tmp);
+    }
+
+    add_imm(reg_aux_src, src_base, src_off);
+    CGA64::mov(reg_kh_cnt, reg_kh);
+
+    xa::LabelAArch64 kh_label;
+    CGA64::L_aarch64(kh_label); {
+        if (is_max)
+            CGA64::dup(z_cur_idx, xa::WReg(reg_cur_idx.getIdx()));
+        for (int j = 0; j < nkw; j++) {
+            const zreg_t z = z_tap(j % max_acc_);
+            load_data(z, reg_aux_src, (long long int)j * pix);
+            if (is_max) {
+                CGA64::cmpeq(reg_p_tmp.s, reg_p_c / xa::T_z, z_idx,
+                        z_cur_idx);
+                CGA64::fadd(z, reg_p_tmp / xa::T_m, z_dd);
+                if (j < nkw - 1) CGA64::add(z_cur_idx, 1);
+            } else {
+                CGA64::fadd(z, z, z_dd);
+            }
+            store_data(z, reg_aux_src, (long long int)j * pix);
+        }
+        if (is_max) add_imm(reg_cur_idx, reg_cur_idx, jpp.kw);
+        add_imm(reg_aux_src, reg_aux_src, (long long int)jpp.iw * pix);
+        CGA64::sub(reg_kh_cnt, reg_kh_cnt, 1);
+        CGA64::cmp(reg_kh_cnt, 0);
+        CGA64::b(xa::GT, kh_label);
+    }
+}
+
+/* Output pixel ow: either at a static offset from the row pointers, or at
+ * the moving pointers of the loop over the unpadded pixels. */
+void jit_sve_pool_kernel::compute_pixel(int ow, bool in_loop) {
+    const int iw_s = ow * jpp.stride_w - jpp.l_pad;
+    const int kw_s = nstl::max(0, -iw_s);
+    const int kw_e = nstl::min(jpp.kw, jpp.iw - iw_s);
+
+    const long long int src_off
+        = in_loop ? 0 : (long long int)(iw_s + kw_s) * src_pix_bytes();
+    const long long int dst_off
+        = in_loop ? 0 : (long long int)ow * src_pix_bytes();
+    const long long int ind_off
+        = in_loop ? 0 : (long long int)ow * ind_pix_bytes();
+
+    reg64_t src_base = in_loop ? reg_src_w : reg_src;
+    reg64_t dst_base = in_loop ? reg_dst_w : reg_dst;
+    reg64_t ind_base = in_loop ? reg_ind_w : reg_ind;
+
+    if (jpp.is_backward)
+        compute_bwd_pixel(kw_s, kw_e, src_base, src_off, dst_base, dst_off,
+                ind_base, ind_off);
+    else
+        compute_fwd_pixel(kw_s, kw_e, src_base, src_off, dst_base, dst_off,
+                ind_base, ind_off);
+}
+
+void jit_sve_pool_kernel::generate() {
+    const bool is_max = jpp.alg == pooling_max;
+
+    CGA64::ldr(reg_src, xa::ptr(param, GET_OFF(src)));
+    CGA64::ldr(reg_dst, xa::ptr(param, GET_OFF(dst)));
+    if (with_indices())
+        CGA64::ldr(reg_ind, xa::ptr(param, GET_OFF(indices)));
+    CGA64::ldr(reg_kh, xa::ptr(param, GET_OFF(kh_padding)));
+    CGA64::ldr(reg_kh_shift, xa::ptr(param, GET_OFF(kh_padding_shift)));
+    CGA64::ldr(reg_c_work, xa::ptr(param, GET_OFF(c_work)));
+
+    CGA64::mov(reg_zero, 0);
+    CGA64::whilelt(reg_p_c.s, reg_zero, reg_c_work);
+
+    if (is_max) {
+        if (!jpp.is_backward) {
+            mov_imm(xa::WReg(reg_tmp_imm.getIdx()),
+                    float2int(nstl::numeric_limits<float>::lowest()));
+            CGA64::dup(z_lowest, xa::WReg(reg_tmp_imm.getIdx()));
+        }
+    } else {
+        if (jpp.alg == pooling_avg_exclude_padding)
+            CGA64::ld1rw(z_area_h, reg_p_c / xa::T_z,
+                    xa::ptr(param, GET_OFF(ker_area_h)));
+        load_divisor(z_div, jpp.kw);
+    }
+
+    /* [0, ow_l) touch the left padding and [ow_r, ow) the right one */
+    int ow_l = 0;
+    while (ow_l < jpp.ow && ow_l * jpp.stride_w < jpp.l_pad)
+        ow_l++;
+    int ow_r = jpp.ow;
+    while (ow_r > ow_l
+            && (ow_r - 1) * jpp.stride_w - jpp.l_pad + jpp.kw > jpp.iw)
+        ow_r--;
+
+    for (int ow = 0; ow < ow_l; ow++)
+        compute_pixel(ow, false);
+
+    const int n_mid = ow_r - ow_l;
+    if (n_mid <= 2) {
+        for (int ow = ow_l; ow < ow_r; ow++)
+            compute_pixel(ow, false);
+    } else {
+        const int pix = src_pix_bytes();
+        add_imm(reg_src_w, reg_src,
+                (long long int)(ow_l * jpp.stride_w - jpp.l_pad) * pix);
+        add_imm(reg_dst_w, reg_dst, (long long int)ow_l * pix);
+        if (with_indices())
+            add_imm(reg_ind_w, reg_ind, (long long int)ow_l * ind_pix_bytes());
+        add_imm(reg_ow_cnt, reg_zero, n_mid);
+
+        xa::LabelAArch64 ow_label;
+        CGA64::L_aarch64(ow_label); {
+            compute_pixel(ow_l, true);
+            add_imm(reg_src_w, reg_src_w,
+                    (long long int)jpp.stride_w * pix);
+            add_imm(reg_dst_w, reg_dst_w, pix);
+            if (with_indices())
+                add_imm(reg_ind_w, reg_ind_w, ind_pix_bytes());
+            CGA64::sub(reg_ow_cnt, reg_ow_cnt, 1);
+            CGA64::cmp(reg_ow_cnt, 0);
+            CGA64::b(xa::GT, ow_label);
+        }
+    }
+
+    for (int ow = nstl::max(ow_l, ow_r); ow < jpp.ow; ow++)
+        compute_pixel(ow, false);
+
+    CGA64::ret();
+}
+
+}
+}
+}
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -0,0 +1,145 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef JIT_SVE_POOL_KERNEL_HPP
+#define JIT_SVE_POOL_KERNEL_HPP
+
+#include "c_types_map.hpp"
+#include "memory_tracking.hpp"
+#include "type_helpers.hpp"
+
+#include "jit_generator.hpp"
+#include "jit_primitive_conf.hpp"
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+#define CGA64 CodeGeneratorAArch64
+namespace xa = Xbyak::Xbyak_aarch64;
+
+/* f32 2D pooling kernel for SVE with a 512-bit vector length, written
+ * directly in Xbyak_aarch64.
+ *
+ * A call computes one output row for one vector of channels: 16 channels of
+ * nChw16c, or up to 16 channels (c_work) of nhwc under a WHILELT predicate.
+ * The kernel rows come from the driver as in jit_uni_pool_kernel
+ * (kh_padding, kh_padding_shift, ker_area_h), the kernel columns are
+ * resolved at generation time: the output pixels touching the left or right
+ * padding are generated one by one and the others run in a loop.
+ *
+ * Forward writes dst and, for max training, the index of the maximum in the
+ * kernel window (kh * KW + kw, as the other implementations). Backward
+ * accumulates into diff_src, which the driver zeroes beforehand.
+ *
+ * The kernel follows AAPCS64 directly and keeps to caller-saved registers,
+ * so it needs no preamble. */
+struct jit_sve_pool_kernel : public jit_generator {
+    DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_sve_pool_kernel)
+
+    jit_sve_pool_kernel(const jit_pool_conf_t &ajpp) : jpp(ajpp) {
+        generate();
+        jit_ker = (void (*)(jit_pool_call_s *))getCode32();
+    }
+
+    jit_pool_conf_t jpp;
+
+    void operator()(jit_pool_call_s *arg) const { jit_ker(arg); }
+
+    static status_t init_conf(jit_pool_conf_t &jpp, const pooling_desc_t &pd,
+            const memory_desc_wrapper &src_d,
+            const memory_desc_wrapper &dst_d);
+
+private:
+    using reg64_t = const xa::XReg;
+    using zreg_t = xa::ZRegS;
+
+    static constexpr int simd_w_ = cpu_isa_traits<sve>::vlen / sizeof(float);
+    static constexpr int max_acc_ = 4;
+
+    reg64_t param = abi_param1_aarch64;
+    reg64_t reg_src = x1;
+    reg64_t reg_dst = x2;
+    reg64_t reg_ind = x3;
+    reg64_t reg_kh = x5;
+    reg64_t reg_kh_shift = x6;
+    reg64_t reg_c_work = x7;
+    reg64_t reg_aux_src = x8;
+    reg64_t reg_kh_cnt = x9;
+    reg64_t reg_src_w = x10;
+    reg64_t reg_dst_w = x11;
+    reg64_t reg_ind_w = x12;
+    reg64_t reg_ow_cnt = x13;
+    reg64_t reg_cur_idx = x14;
+    reg64_t reg_zero = x15;
+    reg64_t reg_tmp_addr = x16;
+    reg64_t reg_tmp_imm = x17;
+
+    const xa::PReg reg_p_c = p0;
+    const xa::PReg reg_p_tmp = p1;
+
+    /* z0-z3 accumulators, z4-z7 loaded taps; z8-z15 are callee-saved */
+    zreg_t z_acc(int i) { return zreg_t(i); }
+    zreg_t z_tap(int i) { return zreg_t(max_acc_ + i); }
+    zreg_t z_idx = zreg_t(16);
+    zreg_t z_cur_idx = zreg_t(17);
+    zreg_t z_lowest = zreg_t(18);
+    zreg_t z_area_h = zreg_t(19);
+    zreg_t z_div = zreg_t(20);
+    zreg_t z_dd = zreg_t(21);
+    zreg_t z_tmp = zreg_t(22);
+
+    void (*jit_ker)(jit_pool_call_s *);
+
+    bool with_indices() const {
+        return jpp.alg == alg_kind::pooling_max
+            && (jpp.is_training || jpp.is_backward);
+    }
+    int src_pix_bytes() const {
+        return (jpp.is_nhwc ? jpp.c : simd_w_) * (int)sizeof(float);
+    }
+    int ind_pix_bytes() const {
+        return (jpp.is_nhwc ? jpp.c : simd_w_)
+            * (int)types::data_type_size(jpp.ind_dt);
+    }
+
+    void add_imm(reg64_t out, reg64_t in, long long int value);
+    void mov_imm(const xa::WReg &out, uint32_t value);
+    void mov_vector(const zreg_t &dst, const zreg_t &src);
+    void load_data(const zreg_t &z, reg64_t base, long long int offset);
+    void store_data(const zreg_t &z, reg64_t base, long long int offset);
+    void load_indices(const zreg_t &z, reg64_t base, long long int offset);
+    void store_indices(const zreg_t &z, reg64_t base, long long int offset);
+    void load_divisor(const zreg_t &z, int kw_len);
+
+    void compute_fwd_pixel(int kw_s, int kw_e, reg64_t src_base,
+            long long int src_off, reg64_t dst_base, long long int dst_off,
+            reg64_t ind_base, long long int ind_off);
+    void compute_bwd_pixel(int kw_s, int kw_e, reg64_t src_base,
+            long long int src_off, reg64_t dst_base, long long int dst_off,
+            reg64_t ind_base, long long int ind_off);
+    void compute_pixel(int ow, bool in_loop);
+
+    void generate();
+};
+
+}
+}
+}
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -0,0 +1,361 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "mkldnn_types.h"
+
+#include "c_types_map.hpp"
+#include "mkldnn_thread.hpp"
+#include "nstl.hpp"
+#include "type_helpers.hpp"
+
+#include "jit_sve_pooling.hpp"
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+using namespace mkldnn::impl::alg_kind;
+using namespace mkldnn::impl::prop_kind;
+using namespace mkldnn::impl::memory_tracking::names;
+
+namespace {
+
+/* Number of threads sharing the rows of one (n, c) vector of a global
+ * pooling: enough to occupy all the threads, at least one row each. */
+int global_pool_nthr_sp(const jit_pool_conf_t &jpp) {
+    if (!jpp.is_global) return 1;
+    const int work = jpp.mb * jpp.nb_c;
+    const int nthr = mkldnn_get_max_threads();
+    if (work >= nthr) return 1;
+    return nstl::max(1, nstl::min(nthr / work, jpp.ih));
+}
+
+/* blk_off() takes the block index for nChw16c and the channel for nhwc */
+inline int c_off(const jit_pool_conf_t &jpp, int b_c) {
+    return jpp.is_nhwc ? b_c * jpp.c_block : b_c;
+}
+
+inline size_t c_work(const jit_pool_conf_t &jpp, int b_c) {
+    return jpp.is_nhwc
+        ? nstl::min(jpp.c_block, jpp.c - b_c * jpp.c_block) : jpp.c_block;
+}
+
+inline int get_index(const void *ws, data_type_t dt, size_t off) {
+    return dt == data_type::u8
+        ? (int)((const uint8_t *)ws)[off] : ((const int32_t *)ws)[off];
+}
+
+inline void set_index(void *ws, data_type_t dt, size_t off, int value) {
+    if (dt == data_type::u8) ((uint8_t *)ws)[off] = (uint8_t)value;
+    else ((int32_t *)ws)[off] = value;
+}
+
+}
+
+status_t jit_sve_pooling_fwd_t::pd_t::init() {
+    using namespace memory_format;
+    assert(engine()->kind() == engine_kind::cpu);
+
+    bool ok = true
+        && mayiuse(sve)
+        && desc()->src_desc.ndims == 4
+        && set_default_params() == status::success
+        && utils::one_of(desc()->prop_kind, forward_training,
+                forward_inference)
+        && utils::one_of(desc()->alg_kind, pooling_max,
+                pooling_avg_include_padding, pooling_avg_exclude_padding)
+        && !has_zero_dim_memory()
+        && utils::everyone_is(data_type::f32, src_pd()->desc()->data_type,
+                dst_pd()->desc()->data_type)
+        && utils::one_of(src_pd()->desc()->format, nChw16c, nhwc)
+        && src_pd()->desc()->format == dst_pd()->desc()->format
+        && attr()->has_default_values();
+    if (!ok) return status::unimplemented;
+
+    if (desc()->alg_kind == pooling_max
+            && desc()->prop_kind == forward_training) {
+        auto indices_desc = *dst_pd()->desc();
+        indices_desc.data_type = pooling_index_data_type(desc());
+        ws_pd_ = cpu_memory_t::pd_t(engine_, &indices_desc);
+    }
+
+    status_t status = jit_sve_pool_kernel::init_conf(jpp_, desc_,
+            src_pd_.desc(), dst_pd_.desc());
+    if (status != status::success) return status;
+
+    nthr_sp_ = global_pool_nthr_sp(jpp_);
+    init_scratchpad();
+
+    return status::success;
+}
+
+void jit_sve_pooling_fwd_t::pd_t::init_scratchpad() {
+    if (nthr_sp_ == 1) return;
+
+    /* partial results of every (n, c) vector and chunk of rows, then their
+     * indices */
+    const size_t nparts = (size_t)jpp_.mb * jpp_.nb_c * nthr_sp_
+        * jpp_.c_block;
+    const size_t ind_size = workspace_pd()
+        ? types::data_type_size(jpp_.ind_dt) : 0;
+    auto scratchpad = scratchpad_registry().registrar();
+    scratchpad.book(key_pool_reduction,
+            nparts * (sizeof(float) + ind_size));
+}
+
+void jit_sve_pooling_fwd_t::execute_forward() const {
+    auto src = reinterpret_cast<const data_t *>(this->input_memory(0));
+    auto dst = reinterpret_cast<data_t *>(this->memory(0));
+    auto indices = pd()->workspace_pd()
+        ? reinterpret_cast<unsigned char *>(this->memory(1)) : nullptr;
+
+    const memory_desc_wrapper src_d(pd()->src_pd());
+    const memory_desc_wrapper dst_d(pd()->dst_pd());
+    const memory_desc_wrapper indices_d(pd()->workspace_pd());
+    const size_t ind_dt_size = indices
+        ? types::data_type_size(indices_d.data_type()) : 0;
+
+    const auto &jpp = pd()->jpp_;
+
+    auto ker = [&](int n, int b_c, int oh) {
+        auto arg = jit_pool_call_s();
+
+        const int ij = oh * jpp.stride_h;
+        const int i_t_overflow = nstl::max(0, jpp.t_pad-ij);
+        const int i_b_overflow = nstl::max(jpp.ih, ij+jpp.kh-jpp.t_pad)-jpp.ih;
+        const int ih = nstl::max(ij - jpp.t_pad, 0);
+        const int c = c_off(jpp, b_c);
+
+        arg.src = &src[src_d.blk_off(n, c, ih)];
+        arg.dst = &dst[dst_d.blk_off(n, c, oh)];
+        if (indices) {
+            const size_t ind_off = indices_d.blk_off(n, c, oh);
+            arg.indices = &indices[ind_off * ind_dt_size];
+        }
+        arg.kh_padding = jpp.kh - i_t_overflow - i_b_overflow;
+        arg.kh_padding_shift = i_t_overflow*jpp.kw;
+        arg.ker_area_h = (float)(jpp.kh - i_t_overflow - i_b_overflow);
+        arg.c_work = c_work(jpp, b_c);
+
+        (*kernel_)(&arg);
+    };
+
+    parallel_nd(jpp.mb, jpp.nb_c, jpp.oh,
+        [&](int n, int b_c, int oh) {
+        ker(n, b_c, oh);
+    });
+}
+
+void jit_sve_pooling_fwd_t::execute_forward_global() const {
+    auto src = reinterpret_cast<const data_t *>(this->input_memory(0));
+    auto dst = reinterpret_cast<data_t *>(this->memory(0));
+    auto indices = pd()->workspace_pd()
+        ? reinterpret_cast<unsigned char *>(this->memory(1)) : nullptr;
+
+    const memory_desc_wrapper src_d(pd()->src_pd());
+    const memory_desc_wrapper dst_d(pd()->dst_pd());
+    const memory_desc_wrapper indices_d(pd()->workspace_pd());
+    const size_t ind_dt_size = indices
+        ? types::data_type_size(indices_d.data_type()) : 0;
+
+    const auto &jpp = pd()->jpp_;
+    const int nthr_sp = pd()->nthr_sp_;
+    const int work = jpp.mb * jpp.nb_c;
+    const bool is_max = jpp.alg == pooling_max;
+
+    auto scratchpad = this->scratchpad();
+    float *part_dst = scratchpad.get<float>(key_pool_reduction);
+    unsigned char *part_ind = reinterpret_cast<unsigned char *>(
+            part_dst + (size_t)work * nthr_sp * jpp.c_block);
+
+    /* each chunk of rows is a kernel call with kh_padding rows starting at
+     * h_s; the averages are divided by the whole image so that the partial
+     * results only need to be added */
+    parallel_nd(work, nthr_sp, [&](int w, int sp) {
+        const int n = w / jpp.nb_c, b_c = w % jpp.nb_c;
+        int h_s{0}, h_e{0};
+        balance211(jpp.ih, nthr_sp, sp, h_s, h_e);
+
+        const size_t part = ((size_t)w * nthr_sp + sp) * jpp.c_block;
+        auto arg = jit_pool_call_s();
+        arg.src = &src[src_d.blk_off(n, c_off(jpp, b_c), h_s)];
+        arg.dst = &part_dst[part];
+        if (indices) arg.indices = &part_ind[part * ind_dt_size];
+        arg.kh_padding = h_e - h_s;
+        arg.kh_padding_shift = h_s * jpp.kw;
+        arg.ker_area_h = (float)jpp.ih;
+        arg.c_work = c_work(jpp, b_c);
+
+        (*kernel_)(&arg);
+    });
+
+    /* the chunks are combined in row order and a later maximum wins only if
+     * it is strictly greater, as in a single pass */
+    parallel_nd(work, [&](int w) {
+        const int n = w / jpp.nb_c, b_c = w % jpp.nb_c;
+        const int c = c_off(jpp, b_c);
+        const size_t part = (size_t)w * nthr_sp * jpp.c_block;
+        const data_type_t ind_dt = jpp.ind_dt;
+
+        data_t *d = &dst[dst_d.blk_off(n, c, 0)];
+        unsigned char *ws = indices
+            ? &indices[indices_d.blk_off(n, c, 0) * ind_dt_size] : nullptr;
+
+        for (size_t cc = 0; cc < c_work(jpp, b_c); cc++) {
+            float res = part_dst[part + cc];
+            int idx = ws ? get_index(part_ind, ind_dt, part + cc) : 0;
+            for (int sp = 1; sp < nthr_sp; sp++) {
+                const size_t off = part + sp * jpp.c_block + cc;
+                if (!is_max) {
+                    res += part_dst[off];
+                } else if (part_dst[off] > res) {
+                    res = part_dst[off];
+                    if (ws) idx = get_index(part_ind, ind_dt, off);
+                }
+            }
+            d[cc] = res;
+            if (ws) set_index(ws, ind_dt, cc, idx);
+        }
+    });
+}
+
+status_t jit_sve_pooling_bwd_t::pd_t::init() {
+    using namespace memory_format;
+    assert(engine()->kind() == engine_kind::cpu);
+
+    bool ok = true
+        && mayiuse(sve)
+        && desc()->diff_src_desc.ndims == 4
+        && set_default_params() == status::success
+        && utils::one_of(desc()->prop_kind, backward, backward_data)
+        && utils::one_of(desc()->alg_kind, pooling_max,
+                pooling_avg_include_padding, pooling_avg_exclude_padding)
+        && !has_zero_dim_memory()
+        && utils::everyone_is(data_type::f32,
+                diff_src_pd()->desc()->data_type,
+                diff_dst_pd()->desc()->data_type)
+        && utils::one_of(diff_dst_pd()->desc()->format, nChw16c, nhwc)
+        && diff_src_pd()->desc()->format == diff_dst_pd()->desc()->format
+        && IMPLICATION(desc()->alg_kind == pooling_max,
+                hint_fwd_pd_ && hint_fwd_pd_->workspace_pd()
+                && hint_fwd_pd_->workspace_pd()->desc()->format
+                        == diff_dst_pd()->desc()->format)
+        && attr()->has_default_values();
+    if (!ok) return status::unimplemented;
+
+    if (desc()->alg_kind == pooling_max)
+        ws_pd_ = *(cpu_memory_t::pd_t *)hint_fwd_pd_->workspace_pd();
+
+    status_t status = jit_sve_pool_kernel::init_conf(jpp_, desc_,
+            diff_src_pd_.desc(), diff_dst_pd_.desc());
+    if (status != status::success) return status;
+
+    nthr_sp_ = global_pool_nthr_sp(jpp_);
+
+    return status::success;
+}
+
+void jit_sve_pooling_bwd_t::execute_backward() const {
+    auto diff_dst = reinterpret_cast<const data_t *>(this->input_memory(0));
+    auto diff_src = reinterpret_cast<data_t *>(this->memory(0));
+    auto indices = pd()->desc()->alg_kind == pooling_max ?
+        reinterpret_cast<const char *>(this->input_memory(1)) : nullptr;
+
+    const memory_desc_wrapper diff_src_d(pd()->diff_src_pd());
+    const memory_desc_wrapper diff_dst_d(pd()->diff_dst_pd());
+    const memory_desc_wrapper indices_d(pd()->workspace_pd());
+    const size_t ind_dt_size = indices
+        ? types::data_type_size(indices_d.data_type()) : 0;
+
+    const auto &jpp = pd()->jpp_;
+    const int nthr_sp = pd()->nthr_sp_;
+
+    /* the kernel accumulates, rows [h_s, h_e) of the vector are zeroed
+     * first by the thread that owns them */
+    auto zero_rows = [&](int n, int b_c, int h_s, int h_e) {
+        const int c = c_off(jpp, b_c);
+        if (!jpp.is_nhwc) {
+            data_t *ds = &diff_src[diff_src_d.blk_off(n, c, h_s)];
+            const size_t len = (size_t)(h_e - h_s) * jpp.iw * jpp.c_block;
+            PRAGMA_OMP_SIMD()
+            for (size_t i = 0; i < len; i++)
+                ds[i] = 0;
+            return;
+        }
+        const size_t len = c_work(jpp, b_c);
+        for (int ih = h_s; ih < h_e; ih++)
+        for (int iw = 0; iw < jpp.iw; iw++) {
+            data_t *ds = &diff_src[diff_src_d.blk_off(n, c, ih, iw)];
+            PRAGMA_OMP_SIMD()
+            for (size_t i = 0; i < len; i++)
+                ds[i] = 0;
+        }
+    };
+
+    auto ker = [&](int n, int b_c, int oh, int h_s, int h_e) {
+        auto arg = jit_pool_call_s();
+
+        const int ij = oh * jpp.stride_h;
+        const int i_t_overflow = nstl::max(0, jpp.t_pad-ij);
+        const int i_b_overflow = nstl::max(jpp.ih, ij+jpp.kh-jpp.t_pad)-jpp.ih;
+        const int ih = nstl::max(ij - jpp.t_pad, 0);
+        const int c = c_off(jpp, b_c);
+
+        arg.dst = &diff_dst[diff_dst_d.blk_off(n, c, oh)];
+        if (indices) {
+            const size_t ind_off = indices_d.blk_off(n, c, oh);
+            arg.indices = &indices[ind_off * ind_dt_size];
+        }
+        if (h_e > h_s) {
+            /* a chunk of the rows of a global pooling */
+            arg.src = &diff_src[diff_src_d.blk_off(n, c, h_s)];
+            arg.kh_padding = h_e - h_s;
+            arg.kh_padding_shift = h_s * jpp.kw;
+            arg.ker_area_h = (float)jpp.ih;
+        } else {
+            arg.src = &diff_src[diff_src_d.blk_off(n, c, ih)];
+            arg.kh_padding = jpp.kh - i_t_overflow - i_b_overflow;
+            arg.kh_padding_shift = i_t_overflow*jpp.kw;
+            arg.ker_area_h = (float)(jpp.kh - i_t_overflow - i_b_overflow);
+        }
+        arg.c_work = c_work(jpp, b_c);
+
+        (*kernel_)(&arg);
+    };
+
+    if (nthr_sp > 1) {
+        parallel_nd(jpp.mb * jpp.nb_c, nthr_sp, [&](int w, int sp) {
+            const int n = w / jpp.nb_c, b_c = w % jpp.nb_c;
+            int h_s{0}, h_e{0};
+            balance211(jpp.ih, nthr_sp, sp, h_s, h_e);
+            zero_rows(n, b_c, h_s, h_e);
+            ker(n, b_c, 0, h_s, h_e);
+        });
+        return;
+    }
+
+    parallel_nd(jpp.mb, jpp.nb_c, [&](int n, int b_c) {
+        zero_rows(n, b_c, 0, jpp.ih);
+        for (int oh = 0; oh < jpp.oh; ++oh)
+            ker(n, b_c, oh, 0, 0);
+    });
+}
+
+}
+}
+}
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
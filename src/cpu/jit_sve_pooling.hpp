@@ -0,0 +1,146 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_JIT_SVE_POOLING_HPP
+#define CPU_JIT_SVE_POOLING_HPP
+
+#include <assert.h>
+
+#include "c_types_map.hpp"
+#include "cpu_pooling_pd.hpp"
+#include "cpu_engine.hpp"
+#include "jit_sve_pool_kernel.hpp"
+#include "type_helpers.hpp"
+#include "utils.hpp"
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+/* f32 2D pooling on SVE for nChw16c and nhwc.
+ *
+ * Global pooling (the window is the whole image) over fewer (n, c) vectors
+ * than threads splits the rows of each vector across nthr_sp_ threads: the
+ * forward pass reduces the rows into partial results in the scratchpad and
+ * combines them in row order, the backward pass scatters each chunk of rows
+ * independently. */
+struct jit_sve_pooling_fwd_t : public cpu_primitive_t {
+    struct pd_t : public cpu_pooling_fwd_pd_t {
+        pd_t(engine_t *engine, const pooling_desc_t *adesc,
+                const primitive_attr_t *attr,
+                const pooling_fwd_pd_t *hint_fwd_pd)
+            : cpu_pooling_fwd_pd_t(engine, adesc, attr, hint_fwd_pd)
+            , nthr_sp_(1) {}
+
+        DECLARE_COMMON_PD_T(
+                JIT_IMPL_NAME_HELPER("jit:", sve, ""),
+                jit_sve_pooling_fwd_t);
+
+        virtual status_t init() override;
+
+        jit_pool_conf_t jpp_;
+        int nthr_sp_;
+
+    protected:
+        virtual status_t set_default_params() override {
+            using namespace memory_format;
+            if (dst_pd_.desc()->format == any)
+                CHECK(dst_pd_.set_format(
+                            src_pd_.desc()->format == nhwc ? nhwc : nChw16c));
+            return status::success;
+        }
+
+    private:
+        void init_scratchpad();
+    };
+
+    jit_sve_pooling_fwd_t(const pd_t *apd, const input_vector &inputs,
+            const output_vector &outputs)
+        : cpu_primitive_t(apd, inputs, outputs)
+    { kernel_ = new jit_sve_pool_kernel(pd()->jpp_); }
+
+    ~jit_sve_pooling_fwd_t() { delete kernel_; }
+
+    typedef float data_t;
+
+    virtual void execute(event_t *e) const {
+        if (pd()->nthr_sp_ > 1) execute_forward_global();
+        else execute_forward();
+        e->set_state(event_t::ready);
+    }
+
+private:
+    void execute_forward() const;
+    void execute_forward_global() const;
+    const pd_t *pd() const { return (const pd_t *)primitive_t::pd(); }
+    jit_sve_pool_kernel *kernel_;
+};
+
+struct jit_sve_pooling_bwd_t : public cpu_primitive_t {
+    struct pd_t : public cpu_pooling_bwd_pd_t {
+        pd_t(engine_t *engine, const pooling_desc_t *adesc,
+                const primitive_attr_t *attr,
+                const pooling_fwd_pd_t *hint_fwd_pd)
+            : cpu_pooling_bwd_pd_t(engine, adesc, attr, hint_fwd_pd)
+            , nthr_sp_(1) {}
+
+        DECLARE_COMMON_PD_T(
+                JIT_IMPL_NAME_HELPER("jit:", sve, ""),
+                jit_sve_pooling_bwd_t);
+
+        virtual status_t init() override;
+
+        jit_pool_conf_t jpp_;
+        int nthr_sp_;
+
+    protected:
+        virtual status_t set_default_params() override {
+            using namespace memory_format;
+            if (diff_src_pd_.desc()->format == any)
+                CHECK(diff_src_pd_.set_format(
+                            diff_dst_pd_.desc()->format == nhwc
+                            ? nhwc : nChw16c));
+            return status::success;
+        }
+    };
+
+    jit_sve_pooling_bwd_t(const pd_t *apd, const input_vector &inputs,
+            const output_vector &outputs)
+        : cpu_primitive_t(apd, inputs, outputs)
+    { kernel_ = new jit_sve_pool_kernel(pd()->jpp_); }
+
+    ~jit_sve_pooling_bwd_t() { delete kernel_; }
+
+    typedef float data_t;
+
+    virtual void execute(event_t *e) const {
+        execute_backward();
+        e->set_state(event_t::ready);
+    }
+
+private:
+    void execute_backward() const;
+    const pd_t *pd() const { return (const pd_t *)primitive_t::pd(); }
+    jit_sve_pool_kernel *kernel_;
+};
+
+}
+}
+}
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
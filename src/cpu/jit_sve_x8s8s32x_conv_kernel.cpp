@@ -0,0 +1,615 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "c_types_map.hpp"
+#include "memory_tracking.hpp"
+#include "nstl.hpp"
+#include "type_helpers.hpp"
+#include "utils.hpp"
+
+#include "cpu_memory.hpp"
+
+#include "jit_sve_x8s8s32x_conv_kernel.hpp"
+
+#define GET_OFF(field) static_cast<int32_t>(offsetof(jit_conv_call_s, field))
+
+#define LDRMAX    255
+#define LDRWMAX   252
+#define ADDMAX   4095
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+using namespace mkldnn::impl::memory_format;
+using namespace mkldnn::impl::memory_tracking::names;
+using namespace mkldnn::impl::utils;
+
+void jit_sve_x8s8s32x_fwd_kernel::mov_imm(reg64_t out, uint64_t value) {
+    CGA64::mov(out, value & 0xffff);
+    for (int sh = 16; sh < 64; sh += 16)
+        if (value >> sh)
+            CGA64::movk(out, (value >> sh) & 0xffff, sh);
+}
+
+void jit_sve_x8s8s32x_fwd_kernel::add_imm(reg64_t out, reg64_t in,
+        long long int value) {
+    long long int val = (value >= 0) ? value : -1 * value;
+    if (val <= ADDMAX) {
+        if (value >= 0) CGA64::add(out, in, val);
+        else CGA64::sub(out, in, val);
+    } else {
+        mov_imm(reg_tmp_imm, val);
+        if (value >= 0) CGA64::add(out, in, reg_tmp_imm);
+        else CGA64::sub(out, in, reg_tmp_imm);
+    }
+}
+
+/* Loads a full vector from base + offset bytes */
+void jit_sve_x8s8s32x_fwd_kernel::load_vector(const xa::ZReg &z,
+        reg64_t base, long long int offset) {
+    const long long int vl = offset >> 6;
+    if ((offset & 0x3f) == 0 && vl <= LDRMAX && vl >= -LDRMAX) {
+        CGA64::ldr(z, xa::ptr(base, static_cast<int32_t>(vl)));
+    } else {
+        add_imm(reg_tmp_addr, base, offset);
+        CGA64::ldr(z, xa::ptr(reg_tmp_addr));
+    }
+}
+
+/* Loads 16 values of type_in from base + offset bytes and converts them to
+ * f32 */
+void jit_sve_x8s8s32x_fwd_kernel::cvt2ps(data_type_t type_in,
+        const xa::ZRegS &z, reg64_t base, long long int offset) {
+    switch (type_in) {
+    case data_type::f32:
+    case data_type::s32:
+        load_vector(xa::ZReg(z.getIdx()), base, offset);
+        break;
+    case data_type::s8:
+        add_imm(reg_tmp_addr, base, offset);
+        CGA64::ld1sb(z, reg_p_all_ones / xa::T_z, xa::ptr(reg_tmp_addr));
+        break;
+    case data_type::u8:
+        add_imm(reg_tmp_addr, base, offset);
+        CGA64::ld1b(z, reg_p_all_ones / xa::T_z, xa::ptr(reg_tmp_addr));
+        break;
+    default: assert(!"unsupported data type");
+    }
+    if (type_in != data_type::f32)
+        CGA64::scvtf(z, reg_p_all_ones / xa::T_m, z);
+}
+
+void jit_sve_x8s8s32x_fwd_kernel::prepare_output(int ur_w) {
+    for (int k = 0; k < jcp.nb_oc_blocking; k++)
+        for (int j = 0; j < ur_w; j++)
+            CGA64::fmov(zreg_out_s(j, k)); // +0.0f is all-zero bits
+}
+
+void jit_sve_x8s8s32x_fwd_kernel::compute_eltwise(int ur_w) {
+    if (ur_w == jcp.ur_w) {
+        eltwise_injector_->compute_vector_range(0,
+                jcp.nb_oc_blocking * jcp.ur_w);
+    } else {
+        for (int k = 0; k < jcp.nb_oc_blocking; k++)
+            eltwise_injector_->compute_vector_range(k * jcp.ur_w,
+                    k * jcp.ur_w + ur_w);
+    }
+    /* the translated injector code may use the predicate registers */
+    CGA64::ptrue(reg_p_all_ones.b);
+}
+
+void jit_sve_x8s8s32x_fwd_kernel::store_output(int ur_w) {
+    using namespace primitive_kind;
+    const auto &p = attr_.post_ops_;
+    const int sum_idx = p.find(sum);
+    const float *p_sum_scale = (sum_idx != -1)
+        ? &p.entry_[sum_idx].sum.scale : nullptr;
+    const bool eltwise_first = p.contain(eltwise, 0);
+    const bool eltwise_last = p.contain(sum, 0) && p.contain(eltwise, 1);
+
+    const int oc_block = jcp.oc_block;
+    auto out_offset = [&](int j, int k) {
+        return (long long int)jcp.typesize_out
+            * (j * out_pix_size() + k * oc_block);
+    };
+
+    if (jcp.with_bias)
+        CGA64::ldr(reg_bias, xa::ptr(param, GET_OFF(bias)));
+    CGA64::ldr(reg_scales, xa::ptr(param, GET_OFF(scales)));
+    if (!jcp.signed_input)
+        CGA64::ldr(reg_comp, xa::ptr(param, GET_OFF(compensation)));
+
+    /* common scale stays in zreg_tmp1 for all the oc blocks */
+    if (!jcp.is_oc_scale)
+        CGA64::ld1rw(zreg_tmp1_s(), reg_p_all_ones, xa::ptr(reg_scales));
+
+    for (int k = 0; k < jcp.nb_oc_blocking; k++) {
+        if (!jcp.signed_input) {
+            load_vector(zreg_tmp(), reg_comp,
+                    (long long int)sizeof(int32_t) * k * oc_block);
+            for (int j = 0; j < ur_w; j++)
+                CGA64::add(zreg_out_s(j, k), zreg_out_s(j, k), zreg_tmp_s());
+        }
+        for (int j = 0; j < ur_w; j++)
+            CGA64::scvtf(zreg_out_s(j, k), reg_p_all_ones / xa::T_m,
+                    zreg_out_s(j, k));
+
+        if (jcp.with_bias) {
+            cvt2ps(jcp.bia_dt, zreg_tmp_s(), reg_bias,
+                    (long long int)jcp.typesize_bia * k * oc_block);
+            for (int j = 0; j < ur_w; j++)
+                CGA64::fadd(zreg_out_s(j, k), zreg_out_s(j, k),
+                        zreg_tmp_s());
+        }
+
+        if (jcp.is_oc_scale)
+            load_vector(zreg_tmp1(), reg_scales,
+                    (long long int)sizeof(float) * k * oc_block);
+        for (int j = 0; j < ur_w; j++)
+            CGA64::fmul(zreg_out_s(j, k), zreg_out_s(j, k), zreg_tmp1_s());
+    }
+
+    if (eltwise_first) compute_eltwise(ur_w);
+    if (p_sum_scale) {
+        if (*p_sum_scale != 1.f) {
+            mov_imm(reg_tmp, (uint32_t)float2int(*p_sum_scale));
+            CGA64::dup(zreg_tmp1_s(), xa::WReg(reg_tmp.getIdx()));
+        }
+        for (int k = 0; k < jcp.nb_oc_blocking; k++)
+            for (int j = 0; j < ur_w; j++) {
+                cvt2ps(jcp.dst_dt, zreg_tmp_s(), reg_out, out_offset(j, k));
+                if (*p_sum_scale == 1.f)
+                    CGA64::fadd(zreg_out_s(j, k), zreg_out_s(j, k),
+                            zreg_tmp_s());
+                else
+                    CGA64::fmla(zreg_out_s(j, k), reg_p_all_ones,
+                            zreg_tmp_s(), zreg_tmp1_s());
+            }
+    }
+    if (eltwise_last) compute_eltwise(ur_w);
+
+    /* saturation bounds for the int8 destinations */
+    const bool is_int8_dst = utils::one_of(jcp.dst_dt, data_type::s8,
+            data_type::u8);
+    if (is_int8_dst) {
+        const bool is_u8 = jcp.dst_dt == data_type::u8;
+        mov_imm(reg_tmp, (uint32_t)float2int(is_u8 ? 255.f : 127.f));
+        CGA64::dup(zreg_tmp_s(), xa::WReg(reg_tmp.getIdx()));
+        mov_imm(reg_tmp, (uint32_t)float2int(is_u8 ? 0.f : -128.f));
+        CGA64::dup(zreg_tmp1_s(), xa::WReg(reg_tmp.getIdx()));
+    }
+
+    for (int k = 0; k < jcp.nb_oc_blocking; k++)
+        for (int j = 0; j < ur_w; j++) {
+            auto zs = zreg_out_s(j, k);
+            if (jcp.dst_dt != data_type::f32) {
+                if (is_int8_dst) {
+                    CGA64::fminnm(zs, reg_p_all_ones / xa::T_m, zreg_tmp_s());
+                    CGA64::fmaxnm(zs, reg_p_all_ones / xa::T_m,
+                            zreg_tmp1_s());
+                }
+                if (attr_.round_mode_ == round_mode::nearest)
+                    CGA64::frintn(zs, reg_p_all_ones / xa::T_m, zs);
+                else
+                    CGA64::frintm(zs, reg_p_all_ones / xa::T_m, zs);
+                CGA64::fcvtzs(zs, reg_p_all_ones / xa::T_m, zs);
+            }
+
+            const long long int ofs = out_offset(j, k);
+            if (is_int8_dst) {
+                add_imm(reg_tmp_addr, reg_out, ofs);
+                CGA64::st1b(zs, reg_p_all_ones, xa::ptr(reg_tmp_addr));
+            } else if ((ofs & 0x3f) == 0 && (ofs >> 6) <= LDRMAX) {
+                CGA64::str(zreg_out(j, k), xa::ptr(reg_out,
+                            static_cast<int32_t>(ofs >> 6)));
+            } else {
+                add_imm(reg_tmp_addr, reg_out, ofs);
+                CGA64::str(zreg_out(j, k), xa::ptr(reg_tmp_addr));
+            }
+        }
+}
+
+void jit_sve_x8s8s32x_fwd_kernel::compute_ic_block(int ur_w, int pad_l,
+        int pad_r, int ic4_groups, bool padded_row) {
+    const int ker_oc_stride = jcp.nb_ic * jcp.kh * jcp.kw * wei_block_size;
+    const int dilate_w = jcp.dilate_w + 1;
+    int bcast_idx = 0;
+
+    for (int ki = 0; ki < jcp.kw; ki++) {
+        const int jj_start = get_ow_start(ki, pad_l);
+        const int jj_end = get_ow_end(ur_w, ki, pad_r);
+        /* s8 src: the padded taps do not contribute */
+        if (jcp.signed_input && (padded_row || jj_start >= jj_end))
+            continue;
+
+        for (int ic4 = 0; ic4 < ic4_groups; ic4++) {
+            for (int k = 0; k < jcp.nb_oc_blocking; k++)
+                load_vector(xa::ZReg(zreg_wei_b(k).getIdx()), aux1_reg_ker,
+                        (long long int)k * ker_oc_stride
+                        + ki * wei_block_size + ic4 * 64);
+
+            for (int jj = 0; jj < ur_w; jj++) {
+                const bool is_pad = padded_row || jj < jj_start
+                    || jj >= jj_end;
+                if (is_pad && jcp.signed_input) continue;
+
+                /* padded taps of u8 src read the shifted zero point */
+                int src_idx = zreg_shift_b().getIdx();
+                if (!is_pad) {
+                    src_idx = zreg_bcast_b(bcast_idx++).getIdx();
+                    const xa::ZRegS zsrc_s(src_idx);
+                    const long long int ofs = (long long int)(jj
+                            * jcp.stride_w + ki * dilate_w - pad_l)
+                        * in_pix_size() + ic4 * 4;
+                    if (ofs <= LDRWMAX) {
+                        CGA64::ld1rw(zsrc_s, reg_p_all_ones, xa::ptr(
+                                    aux1_reg_inp, static_cast<int32_t>(ofs)));
+                    } else {
+                        add_imm(reg_tmp_addr, aux1_reg_inp, ofs);
+                        CGA64::ld1rw(zsrc_s, reg_p_all_ones,
+                                xa::ptr(reg_tmp_addr));
+                    }
+                    if (!jcp.signed_input)
+                        CGA64::eor(xa::ZRegD(src_idx), xa::ZRegD(src_idx),
+                                zreg_shift_d());
+                }
+
+                for (int k = 0; k < jcp.nb_oc_blocking; k++)
+                    CGA64::sdot(zreg_out_s(jj, k), zreg_wei_b(k),
+                            xa::ZRegB(src_idx));
+            }
+        }
+    }
+}
+
+void jit_sve_x8s8s32x_fwd_kernel::compute_row(int ur_w, int pad_l,
+        int pad_r, bool padded_row) {
+    const int ic_tail_groups
+        = (jcp.ic_without_padding % jcp.ic_block) / 4;
+    const int nb_ic_full = jcp.nb_ic - (ic_tail_groups > 0);
+
+    CGA64::mov(aux1_reg_inp, aux_reg_inp);
+    CGA64::mov(aux1_reg_ker, aux_reg_ker);
+
+    if (nb_ic_full > 0) {
+        xa::LabelAArch64 icb_loop;
+        mov_imm(reg_icb, nb_ic_full);
+        CGA64::L_aarch64(icb_loop); {
+            compute_ic_block(ur_w, pad_l, pad_r, jcp.ic_block / 4,
+                    padded_row);
+            add_imm(aux1_reg_inp, aux1_reg_inp, jcp.ic_block);
+            add_imm(aux1_reg_ker, aux1_reg_ker,
+                    (long long int)jcp.kh * jcp.kw * wei_block_size);
+            CGA64::subs(reg_icb, reg_icb, 1);
+            CGA64::b(xa::GT, icb_loop);
+        }
+    }
+    if (ic_tail_groups > 0)
+        compute_ic_block(ur_w, pad_l, pad_r, ic_tail_groups, padded_row);
+}
+
+/* u8 src only: rows of the filter that fall in the top or bottom padding,
+ * the number of them is read from the call parameters at count_offset */
+void jit_sve_x8s8s32x_fwd_kernel::compute_padded_rows(int ur_w, int pad_l,
+        int pad_r, size_t count_offset) {
+    xa::LabelAArch64 row_loop, row_loop_end;
+
+    CGA64::ldr(reg_kj, xa::ptr(param, static_cast<int32_t>(count_offset)));
+    CGA64::cmp(reg_kj, 0);
+    CGA64::b(xa::LE, row_loop_end);
+    CGA64::L_aarch64(row_loop); {
+        compute_row(ur_w, pad_l, pad_r, true);
+        add_imm(aux_reg_ker, aux_reg_ker,
+                (long long int)jcp.kw * wei_block_size);
+        CGA64::subs(reg_kj, reg_kj, 1);
+        CGA64::b(xa::GT, row_loop);
+    }
+    CGA64::L_aarch64(row_loop_end);
+}
+
+void jit_sve_x8s8s32x_fwd_kernel::compute_loop(int ur_w, int pad_l,
+        int pad_r) {
+    xa::LabelAArch64 kh_loop, kh_loop_end;
+
+    prepare_output(ur_w);
+
+    CGA64::mov(aux_reg_inp, reg_inp);
+    CGA64::mov(aux_reg_ker, reg_ker);
+
+    if (!jcp.signed_input)
+        compute_padded_rows(ur_w, pad_l, pad_r, GET_OFF(t_overflow));
+
+    CGA64::ldr(reg_kj, xa::ptr(param, GET_OFF(kh_padding)));
+    CGA64::cmp(reg_kj, 0);
+    CGA64::b(xa::LE, kh_loop_end);
+    CGA64::L_aarch64(kh_loop); {
+        compute_row(ur_w, pad_l, pad_r, false);
+        add_imm(aux_reg_ker, aux_reg_ker,
+                (long long int)jcp.kw * wei_block_size);
+        add_imm(aux_reg_inp, aux_reg_inp, (long long int)(jcp.dilate_h + 1)
+                * jcp.iw * in_pix_size());
+        CGA64::subs(reg_kj, reg_kj, 1);
+        CGA64::b(xa::GT, kh_loop);
+    }
+    CGA64::L_aarch64(kh_loop_end);
+
+    if (!jcp.signed_input)
+        compute_padded_rows(ur_w, pad_l, pad_r, GET_OFF(b_overflow));
+
+    store_output(ur_w);
+}
+
+void jit_sve_x8s8s32x_fwd_kernel::generate() {
+    const int iw = jcp.iw;
+    const int ow = jcp.ow;
+    const int kw = jcp.kw;
+    const int l_pad = jcp.l_pad;
+    const int ur_w = jcp.ur_w;
+    const int ur_w_tail = jcp.ur_w_tail;
+    const int dilate_w = jcp.dilate_w + 1;
+    const int stride_w = jcp.stride_w;
+
+    const long long int inp_shift_pad
+        = (long long int)(ur_w * stride_w - l_pad) * in_pix_size();
+    const long long int inp_shift
+        = (long long int)ur_w * stride_w * in_pix_size();
+    const long long int out_shift
+        = (long long int)jcp.typesize_out * ur_w * out_pix_size();
+
+    preamble();
+
+    CGA64::ptrue(reg_p_all_ones.b);
+    if (!jcp.signed_input)
+        CGA64::dup(zreg_shift_b(), -128); // 0x80
+
+    CGA64::ldr(reg_inp, xa::ptr(param, GET_OFF(src)));
+    CGA64::ldr(reg_out, xa::ptr(param, GET_OFF(dst)));
+    CGA64::ldr(reg_ker, xa::ptr(param, GET_OFF(filt)));
+
+    const int r_pad = nstl::max(
+            0, (ow - 1) * stride_w + (kw - 1) * dilate_w - (iw + l_pad - 1));
+    int n_oi = ow / ur_w;
+    const int r_pad1 = (ur_w * n_oi - 1) * stride_w + (kw - 1) * dilate_w
+            - (iw + l_pad - 1);
+    if (r_pad1 > 0) n_oi--;
+
+    if (ow == ur_w) {
+        compute_loop(ur_w, l_pad, r_pad);
+    } else if (n_oi == 0) {
+        compute_loop(ur_w, l_pad, r_pad1);
+        add_imm(reg_inp, reg_inp, inp_shift_pad);
+        add_imm(reg_out, reg_out, out_shift);
+        if (ur_w_tail != 0)
+            compute_loop(ur_w_tail, 0, r_pad);
+    } else {
+        CGA64::mov(reg_oi, 0);
+        if (l_pad > 0) {
+            compute_loop(ur_w, l_pad, 0);
+            add_imm(reg_inp, reg_inp, inp_shift_pad);
+            add_imm(reg_out, reg_out, out_shift);
+            CGA64::add(reg_oi, reg_oi, 1);
+        }
+        if ((l_pad <= 0 && n_oi > 0) || (l_pad > 0 && n_oi > 1)) {
+            xa::LabelAArch64 ow_loop;
+            CGA64::L_aarch64(ow_loop); {
+                compute_loop(ur_w, 0, 0);
+                add_imm(reg_inp, reg_inp, inp_shift);
+                add_imm(reg_out, reg_out, out_shift);
+                CGA64::add(reg_oi, reg_oi, 1);
+                CGA64::cmp(reg_oi, n_oi);
+                CGA64::b(xa::LT, ow_loop);
+            }
+        }
+        if (r_pad1 > 0) {
+            compute_loop(ur_w, 0, r_pad1);
+            add_imm(reg_inp, reg_inp, inp_shift);
+            add_imm(reg_out, reg_out, out_shift);
+        }
+        if (ur_w_tail != 0)
+            compute_loop(ur_w_tail, 0, r_pad);
+    }
+
+    postamble();
+
+    if (jcp.with_eltwise)
+        eltwise_injector_->prepare_table();
+}
+
+bool jit_sve_x8s8s32x_fwd_kernel::post_ops_ok(
+        jit_conv_conf_t &jcp, const primitive_attr_t &attr) {
+    using namespace primitive_kind;
+    const auto &p = attr.post_ops_;
+
+    auto is_eltwise = [&](int idx) { return p.entry_[idx].is_eltwise(); };
+
+    switch (p.len_) {
+    case 0: return true;
+    case 1: return is_eltwise(0) || p.contain(sum, 0);
+    case 2: return (p.contain(sum, 0) && is_eltwise(1))
+                || (p.contain(sum, 1) && is_eltwise(0));
+    default: return false;
+    }
+
+    return false;
+}
+
+status_t jit_sve_x8s8s32x_fwd_kernel::init_conf(jit_conv_conf_t &jcp,
+        const convolution_desc_t &cd, cpu_memory_t::pd_t &src_pd,
+        cpu_memory_t::pd_t &weights_pd, cpu_memory_t::pd_t &dst_pd,
+        cpu_memory_t::pd_t &bias_pd, const primitive_attr_t &attr,
+        int nthreads) {
+    const memory_desc_wrapper src_d(&src_pd);
+    const memory_desc_wrapper weights_d(&weights_pd);
+    const memory_desc_wrapper dst_d(&dst_pd);
+    const memory_desc_wrapper bias_d(&bias_pd);
+
+    const bool with_groups = weights_d.ndims() == src_d.ndims() + 1;
+    const int ndims = src_d.ndims();
+
+    if (!(mayiuse(sve)
+         && ndims == 4
+         && one_of(src_d.data_type(), data_type::u8, data_type::s8)
+         && weights_d.data_type() == data_type::s8
+         && one_of(dst_d.data_type(), data_type::f32, data_type::s32,
+            data_type::s8, data_type::u8)))
+        return status::unimplemented;
+
+    jcp = zero<decltype(jcp)>();
+    jcp.ndims = ndims;
+    jcp.prop_kind = cd.prop_kind;
+    jcp.ngroups = with_groups ? weights_d.dims()[0] : 1;
+    jcp.mb = src_d.dims()[0];
+    jcp.oc = dst_d.dims()[1] / jcp.ngroups;
+    jcp.oc_without_padding = jcp.oc;
+    jcp.ic = src_d.dims()[1] / jcp.ngroups;
+    jcp.ic_without_padding = jcp.ic;
+    jcp.ih = src_d.dims()[2];
+    jcp.iw = src_d.dims()[3];
+    jcp.oh = dst_d.dims()[2];
+    jcp.ow = dst_d.dims()[3];
+    jcp.kh = weights_d.dims()[with_groups + 2];
+    jcp.kw = weights_d.dims()[with_groups + 3];
+    jcp.t_pad = cd.padding[0][0];
+    jcp.l_pad = cd.padding[0][1];
+    jcp.stride_h = cd.strides[0];
+    jcp.stride_w = cd.strides[1];
+    jcp.dilate_h = cd.dilates[0];
+    jcp.dilate_w = cd.dilates[1];
+    jcp.src_fmt = src_d.format();
+    jcp.with_bias = cd.bias_desc.format != memory_format::undef;
+    jcp.ur_h = 1;
+
+    jcp.signed_input = src_d.data_type() == data_type::s8;
+    jcp.is_depthwise = with_groups && everyone_is(1, jcp.ic, jcp.oc);
+    if (jcp.is_depthwise)
+        return status::unimplemented;
+
+    jcp.ic_block = 16;
+    jcp.oc_block = 16;
+    jcp.ch_block = 1;
+    if (jcp.ngroups == 1) {
+        jcp.oc = rnd_up(jcp.oc, jcp.oc_block);
+        jcp.ic = rnd_up(jcp.ic, jcp.ic_block);
+    }
+
+    /* src is read in groups of 4 channels and dst is written by full
+     * vectors */
+    if (jcp.ic % jcp.ic_block != 0 || jcp.oc % jcp.oc_block != 0
+            || jcp.ic_without_padding % 4 != 0
+            || jcp.oc_without_padding % jcp.oc_block != 0)
+        return status::unimplemented;
+
+    jcp.b_pad = (jcp.oh - 1) * jcp.stride_h + (jcp.kh - 1) * (jcp.dilate_h + 1)
+            - (jcp.ih + jcp.t_pad - 1);
+
+    if (!post_ops_ok(jcp, attr))
+        return status::unimplemented;
+
+    const auto &p = attr.post_ops_;
+    const int eltwise_ind = p.find(primitive_kind::eltwise);
+    jcp.with_eltwise = eltwise_ind != -1;
+    if (jcp.with_eltwise)
+        jcp.eltwise = p.entry_[eltwise_ind].eltwise;
+
+    if (!one_of(attr.round_mode_, round_mode::nearest, round_mode::down))
+        return status::unimplemented;
+
+    const memory_format_t w_format = with_groups ? gOIhw4i16o4i : OIhw4i16o4i;
+    if (weights_d.format() == any)
+        CHECK(weights_pd.set_format(w_format));
+    if (weights_d.format() != w_format)
+        return status::unimplemented;
+    if (dst_d.format() == any)
+        CHECK(dst_pd.set_format(nhwc));
+    if (dst_d.format() != nhwc)
+        return status::unimplemented;
+    if (src_d.format() == any)
+        CHECK(src_pd.set_format(nhwc));
+    if (src_d.format() != nhwc)
+        return status::unimplemented;
+    if (jcp.with_bias) {
+        if (bias_d.format() == any)
+            CHECK(bias_pd.set_format(x));
+        if (bias_d.format() != x)
+            return status::unimplemented;
+    }
+
+    jcp.bia_dt = jcp.with_bias ? cd.bias_desc.data_type : data_type::undef;
+    jcp.dst_dt = cd.dst_desc.data_type;
+
+    jcp.typesize_in = types::data_type_size(src_d.data_type());
+    jcp.typesize_out = types::data_type_size(dst_d.data_type());
+    jcp.typesize_bia = jcp.with_bias
+        ? types::data_type_size(bias_d.data_type())
+        : 0;
+
+    jcp.nb_ch = jcp.ngroups;
+    jcp.nb_ic = jcp.ic / jcp.ic_block;
+    jcp.nb_oc = jcp.oc / jcp.oc_block;
+
+    /* Largest oc blocking that divides nb_oc and leaves an ur_w that covers
+     * the left padding; z0-z23 hold nb_oc_blocking x ur_w accumulators. */
+    jcp.nb_oc_blocking = 1;
+    for (int block = nstl::min(4, jcp.nb_oc); block > 1; block--) {
+        const int ur_w = nstl::min(jcp.ow, max_regs_ur / block);
+        if (jcp.nb_oc % block == 0 && jcp.l_pad <= ur_w) {
+            jcp.nb_oc_blocking = block;
+            break;
+        }
+    }
+    jcp.nb_oc_blocking_thr_chunk = jcp.nb_oc_blocking;
+
+    jcp.ur_w = nstl::min(jcp.ow, max_regs_ur / jcp.nb_oc_blocking);
+    jcp.ur_w_tail = jcp.ow % jcp.ur_w;
+    jcp.ow_block = jcp.ow;
+    jcp.nb_ow = 1;
+
+    if (jcp.l_pad > jcp.ur_w)
+        return status::unimplemented;
+
+    const int r_pad_no_tail = nstl::max(0, (jcp.ow - jcp.ur_w_tail - 1)
+            * jcp.stride_w + (jcp.kw - 1) * (jcp.dilate_w + 1)
+            - (jcp.iw + jcp.l_pad - 1));
+    if (r_pad_no_tail > jcp.ur_w)
+        return status::unimplemented;
+
+    jcp.loop_order = loop_ngcw;
+
+    const auto &oscales = attr.output_scales_;
+    jcp.is_oc_scale = oscales.mask_ == 1 << 1;
+    if (!jcp.is_oc_scale && oscales.mask_ != 0)
+        return status::unimplemented;
+
+    /* SDOT does not saturate the intermediate sums, so the weights are not
+     * scaled down as in the AVX512 (non-VNNI) kernels */
+    jcp.wei_adj_scale = 1.f;
+
+    return status::success;
+}
+
+void jit_sve_x8s8s32x_fwd_kernel::init_scratchpad(
+        memory_tracking::registrar_t &scratchpad, const jit_conv_conf_t &jcp) {
+    if (!jcp.signed_input)
+        scratchpad.book(key_conv_compensation,
+                sizeof(int32_t) * jcp.ngroups * jcp.oc);
+}
+
+}
+}
+}
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
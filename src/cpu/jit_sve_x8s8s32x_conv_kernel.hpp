@@ -0,0 +1,180 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef JIT_SVE_X8S8S32X_CONV_KERNEL_HPP
+#define JIT_SVE_X8S8S32X_CONV_KERNEL_HPP
+
+#include "c_types_map.hpp"
+#include "memory_tracking.hpp"
+
+#include "cpu_memory.hpp"
+#include "jit_generator.hpp"
+#include "jit_primitive_conf.hpp"
+#include "jit_uni_eltwise.hpp"
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+#define CGA64 CodeGeneratorAArch64
+namespace xa = Xbyak::Xbyak_aarch64;
+
+/* Int8 direct convolution (forward) for SVE with a 512-bit vector length.
+ *
+ * src and dst are nhwc, weights are (g)OIhw4i16o4i, i.e. a vector holds
+ * 16 output channels x 4 input channels. 4 input channels of a pixel are
+ * broadcast to all the 32-bit lanes and SDOT accumulates them into the s32
+ * lanes of the 16 output channels.
+ *
+ * SDOT multiplies signed bytes only, so u8 src is shifted to the signed
+ * range while it is loaded (src ^ 0x80 == src - 128) and the constant
+ *     compensation[oc] = 128 * sum_{kh,kw,ic} wei[oc][ic][kh][kw]
+ * is added back to the accumulators. To keep the compensation independent
+ * of the position, the taps that fall in the padding are not skipped for
+ * u8 src: they use the shifted zero point (-128) instead. For s8 src the
+ * padded taps are skipped as usual.
+ *
+ * The accumulators are then converted to f32 and the bias, the output
+ * scales and the sum / eltwise post-ops are applied in the order of
+ * jit_avx512_core_x8s8s32x_fwd_kernel. */
+struct jit_sve_x8s8s32x_fwd_kernel : public jit_generator {
+    DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_sve_x8s8s32x_fwd_kernel)
+
+    jit_sve_x8s8s32x_fwd_kernel(jit_conv_conf_t ajcp,
+            const primitive_attr_t &attr)
+        : jcp(ajcp), attr_(attr), eltwise_injector_(nullptr)
+    {
+        if (jcp.with_eltwise)
+            eltwise_injector_ = new jit_uni_eltwise_injector_f32<avx512_common>(
+                    this, jcp.eltwise);
+
+        generate();
+        jit_ker = (void (*)(jit_conv_call_s *))getCode32();
+    }
+
+    ~jit_sve_x8s8s32x_fwd_kernel() { delete eltwise_injector_; }
+
+    static bool post_ops_ok(jit_conv_conf_t &jcp,
+            const primitive_attr_t &attr);
+    static status_t init_conf(jit_conv_conf_t &jcp,
+            const convolution_desc_t &cd,
+            cpu_memory_t::pd_t &src_pd,
+            cpu_memory_t::pd_t &weights_pd,
+            cpu_memory_t::pd_t &dst_pd,
+            cpu_memory_t::pd_t &bias_pd,
+            const primitive_attr_t &attr,
+            int nthreads);
+    static void init_scratchpad(memory_tracking::registrar_t &scratchpad,
+            const jit_conv_conf_t &jcp);
+
+    jit_conv_conf_t jcp;
+    const primitive_attr_t &attr_;
+    void (*jit_ker)(jit_conv_call_s *);
+
+private:
+    using reg64_t = const xa::XReg;
+    enum {
+        ker_wei_reg_base_idx = 24,
+        max_regs_ur = 24,
+        wei_block_size = 16 * 16, /* 4i16o4i: one kh * kw position */
+    };
+
+    const xa::PReg reg_p_all_ones = p1;
+
+    /* x4 is the stack pointer of the translated eltwise injector code and
+     * x22-x28 are its temporaries, so they are not used here. */
+    reg64_t param = abi_param1_aarch64;
+    reg64_t reg_inp = x1;
+    reg64_t reg_ker = x2;
+    reg64_t reg_out = x3;
+    reg64_t reg_bias = x5;
+    reg64_t reg_scales = x6;
+    reg64_t reg_comp = x7;
+    reg64_t aux_reg_inp = x8;
+    reg64_t aux_reg_ker = x9;
+    reg64_t aux1_reg_inp = x10;
+    reg64_t aux1_reg_ker = x11;
+    reg64_t reg_kj = x12;
+    reg64_t reg_icb = x13;
+    reg64_t reg_tmp_addr = x14;
+    reg64_t reg_oi = x15;
+    reg64_t reg_tmp = x16;
+    reg64_t reg_tmp_imm = x17;
+
+    /* z0-z23: accumulators, z24-z27: weights, z28/z30/z31: broadcast src
+     * (z30/z31 are temporaries in store_output), z29: u8 shift (0x80) */
+    xa::ZRegS zreg_out_s(int i_ur, int i_oc) {
+        int idx = i_ur + i_oc * jcp.ur_w;
+        assert(idx < ker_wei_reg_base_idx);
+        return xa::ZRegS(idx);
+    }
+    xa::ZReg zreg_out(int i_ur, int i_oc) {
+        return xa::ZReg(zreg_out_s(i_ur, i_oc).getIdx());
+    }
+    xa::ZRegB zreg_wei_b(int i_oc) {
+        return xa::ZRegB(ker_wei_reg_base_idx + i_oc);
+    }
+    xa::ZRegB zreg_bcast_b(int i) {
+        static const int idx[] = {28, 30, 31};
+        return xa::ZRegB(idx[i % 3]);
+    }
+    xa::ZRegB zreg_shift_b() { return xa::ZRegB(29); }
+    xa::ZRegD zreg_shift_d() { return xa::ZRegD(29); }
+    xa::ZRegS zreg_tmp_s() { return xa::ZRegS(30); }
+    xa::ZReg zreg_tmp() { return xa::ZReg(30); }
+    xa::ZRegS zreg_tmp1_s() { return xa::ZRegS(31); }
+    xa::ZReg zreg_tmp1() { return xa::ZReg(31); }
+
+    void add_imm(reg64_t out, reg64_t in, long long int value);
+    void mov_imm(reg64_t out, uint64_t value);
+    void load_vector(const xa::ZReg &z, reg64_t base, long long int offset);
+    void cvt2ps(data_type_t type_in, const xa::ZRegS &z, reg64_t base,
+            long long int offset);
+
+    jit_uni_eltwise_injector_f32<avx512_common> *eltwise_injector_;
+
+    void prepare_output(int ur_w);
+    void store_output(int ur_w);
+    void compute_eltwise(int ur_w);
+    void compute_ic_block(int ur_w, int pad_l, int pad_r, int ic4_groups,
+            bool padded_row);
+    void compute_row(int ur_w, int pad_l, int pad_r, bool padded_row);
+    void compute_padded_rows(int ur_w, int pad_l, int pad_r,
+            size_t count_offset);
+    void compute_loop(int ur_w, int pad_l, int pad_r);
+    void generate();
+
+    int in_pix_size() const { return jcp.ngroups * jcp.ic_without_padding; }
+    int out_pix_size() const { return jcp.ngroups * jcp.oc_without_padding; }
+
+    int get_ow_start(int ki, int pad_l) {
+        return nstl::max(0,
+                utils::div_up(pad_l - ki * (jcp.dilate_w + 1), jcp.stride_w));
+    }
+
+    int get_ow_end(int ur_w, int ki, int pad_r) {
+        return ur_w - nstl::max(0, utils::div_up(pad_r
+                - (jcp.kw - 1 - ki) * (jcp.dilate_w + 1), jcp.stride_w));
+    }
+};
+
+}
+}
+}
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -0,0 +1,165 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "c_types_map.hpp"
+#include "mkldnn_thread.hpp"
+#include "type_helpers.hpp"
+#include "utils.hpp"
+
+#include "jit_sve_x8s8s32x_convolution.hpp"
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+using namespace mkldnn::impl::status;
+using namespace mkldnn::impl::memory_format;
+using namespace mkldnn::impl::memory_tracking::names;
+using namespace mkldnn::impl::utils;
+
+using namespace nstl;
+
+#define wht_blk_off(d, g, ...) \
+        (pd()->with_groups() \
+         ? (d).blk_off((g), __VA_ARGS__) \
+         : (d).blk_off(__VA_ARGS__))
+
+/* compensation[g][oc] = 128 * sum_{ic,kh,kw} wei[g][oc][ic][kh][kw], see
+ * jit_sve_x8s8s32x_fwd_kernel */
+template <data_type_t src_type, data_type_t dst_type>
+void jit_sve_x8s8s32x_convolution_fwd_t<src_type,
+        dst_type>::compute_compensation(int32_t *compensation) const {
+    auto weights = reinterpret_cast<const wei_data_t *>(this->input_memory(1));
+    const memory_desc_wrapper weights_d(pd()->weights_pd(0));
+    const auto &jcp = pd()->jcp_;
+
+    /* 4i16o4i blocks of all the ic blocks and kh * kw positions */
+    const size_t wei_size = (size_t)jcp.nb_ic * jcp.kh * jcp.kw
+        * jcp.ic_block * jcp.oc_block;
+
+    parallel_nd(jcp.ngroups, jcp.nb_oc, [&](int g, int ocb) {
+        const wei_data_t *w = weights + wht_blk_off(weights_d, g, ocb, 0);
+        int32_t acc[16] = {0};
+        for (size_t i = 0; i < wei_size; i++)
+            acc[(i % 64) / 4] += w[i];
+        int32_t *comp = compensation + (g * jcp.nb_oc + ocb) * jcp.oc_block;
+        for (int oc = 0; oc < jcp.oc_block; oc++)
+            comp[oc] = 128 * acc[oc];
+    });
+}
+
+template <data_type_t src_type, data_type_t dst_type>
+void jit_sve_x8s8s32x_convolution_fwd_t<src_type,
+        dst_type>::execute_forward() const {
+    auto src = reinterpret_cast<const src_data_t *>(this->input_memory(0));
+    auto weights = reinterpret_cast<const wei_data_t *>(this->input_memory(1));
+    auto bias = reinterpret_cast<const char *>(this->input_memory(2));
+    auto dst = reinterpret_cast<dst_data_t *>(this->memory());
+
+    const memory_desc_wrapper src_d(pd()->src_pd());
+    const memory_desc_wrapper dst_d(pd()->dst_pd());
+    const memory_desc_wrapper weights_d(pd()->weights_pd(0));
+    const memory_desc_wrapper bias_d(pd()->weights_pd(1));
+
+    const size_t bia_dt_size = pd()->with_bias()
+        ? types::data_type_size(pd()->desc()->bias_desc.data_type) : 0;
+
+    const auto &jcp = pd()->jcp_;
+    assert(jcp.nb_oc % jcp.nb_oc_blocking == 0);
+
+    const float *oscales = pd()->attr()->output_scales_.scales_;
+
+    int32_t *compensation = nullptr;
+    if (!jcp.signed_input) {
+        compensation = scratchpad().template get<int32_t>(
+                key_conv_compensation);
+        compute_compensation(compensation);
+    }
+
+    const int oc_chunks = jcp.nb_oc / jcp.nb_oc_blocking;
+    const int work_amount = jcp.mb * jcp.ngroups * oc_chunks * jcp.oh;
+
+    parallel(0, [&](const int ithr, const int nthr) {
+        int start{0}, end{0};
+        balance211(work_amount, nthr, ithr, start, end);
+
+        auto p = jit_conv_call_s();
+
+        const size_t wht_h_stride = wht_blk_off(weights_d, 0, 0, 0, 1);
+        const int dilate_h = jcp.dilate_h + 1;
+
+        int n{0}, g{0}, occ{0}, oh{0};
+        nd_iterator_init(start, n, jcp.mb, g, jcp.ngroups, occ, oc_chunks,
+                oh, jcp.oh);
+        for (int iwork = start; iwork < end; ++iwork) {
+            const int ocb = occ * jcp.nb_oc_blocking;
+            const int g_oc = (g * jcp.nb_oc + ocb) * jcp.oc_block;
+            const int g_ic = g * jcp.ic_without_padding;
+
+            const int ij = -jcp.t_pad + oh * jcp.stride_h;
+            const int i_t_overflow = nstl::min(jcp.kh,
+                    div_up(max(0, -ij), dilate_h));
+            const int i_b_overflow = nstl::min(jcp.kh, div_up(
+                    max(0, ij - jcp.ih + (jcp.kh - 1) * dilate_h + 1),
+                    dilate_h));
+            const int kh_padding = nstl::max(0,
+                    jcp.kh - i_t_overflow - i_b_overflow);
+
+            /* for u8 src the kernel walks the padded rows of the filter
+             * too, so it starts from the first row */
+            const size_t wei_stride = jcp.signed_input
+                ? i_t_overflow * wht_h_stride : 0;
+
+            p.src = src + src_d.blk_off(n, g_ic,
+                    ij + i_t_overflow * dilate_h, 0);
+            p.dst = dst + dst_d.blk_off(n, g_oc, oh, 0);
+            p.filt = weights + wht_blk_off(weights_d, g, ocb, 0) + wei_stride;
+            p.bias = bias ? bias + bias_d.blk_off(g_oc) * bia_dt_size : 0;
+            p.compensation = compensation ? compensation + g_oc : 0;
+            p.scales = &oscales[jcp.is_oc_scale * g_oc];
+            p.kh_padding = kh_padding;
+            p.t_overflow = i_t_overflow;
+            p.b_overflow = i_b_overflow;
+
+            kernel_->jit_ker(&p);
+
+            nd_iterator_step(n, jcp.mb, g, jcp.ngroups, occ, oc_chunks,
+                    oh, jcp.oh);
+        }
+    });
+}
+
+template struct jit_sve_x8s8s32x_convolution_fwd_t<
+                                                data_type::s8, data_type::u8>;
+template struct jit_sve_x8s8s32x_convolution_fwd_t<
+                                                data_type::u8, data_type::u8>;
+template struct jit_sve_x8s8s32x_convolution_fwd_t<
+                                                data_type::s8, data_type::s8>;
+template struct jit_sve_x8s8s32x_convolution_fwd_t<
+                                                data_type::u8, data_type::s8>;
+template struct jit_sve_x8s8s32x_convolution_fwd_t<
+                                                data_type::s8, data_type::s32>;
+template struct jit_sve_x8s8s32x_convolution_fwd_t<
+                                                data_type::u8, data_type::s32>;
+template struct jit_sve_x8s8s32x_convolution_fwd_t<
+                                                data_type::s8, data_type::f32>;
+template struct jit_sve_x8s8s32x_convolution_fwd_t<
+                                                data_type::u8, data_type::f32>;
+}
+}
+}
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -31,6 +31,9 @@
 
 #include "jit_avx512_core_bf16_dw_conv_kernel.hpp"
 #include "jit_uni_dw_conv_kernel_f32.hpp"
+#ifdef __ARM_ARCH
+#include "jit_sve_dw_conv_kernel_f32.hpp"
+#endif
 
 namespace mkldnn {
 namespace impl {
@@ -40,6 +43,22 @@ using namespace mkldnn::impl::memory_format;
 using namespace mkldnn::impl::memory_tracking::names;
 using namespace mkldnn::impl::utils;
 
+/* ISAs with 16 f32 lanes, i.e. nChw16c activations and Goihw16g weights */
+inline bool dw_conv_is_16ch_isa(cpu_isa_t isa) {
+#ifdef __ARM_ARCH
+    if (isa == sve) return true;
+#endif
+    return one_of(isa, avx512_common, avx512_core);
+}
+
+/* f32 kernels: the number of output pixels per unrolled iteration */
+inline int dw_conv_f32_ur_w(cpu_isa_t isa) {
+#ifdef __ARM_ARCH
+    if (isa == sve) return 6;
+#endif
+    return isa == avx512_common ? 6 : isa == avx2 ? 4 : 3;
+}
+
 template <cpu_isa_t isa, data_type_t kernel_dt>
 struct jit_uni_dw_conv_fwd_kernel {
 
@@ -63,10 +82,18 @@ struct jit_uni_dw_conv_fwd_kernel {
     void (*jit_ker)(jit_conv_call_s *);
 
 private:
+#ifdef __ARM_ARCH
+    using jit_kernel_t = typename utils::conditional3<isa == sve,
+            jit_sve_dw_conv_fwd_kernel_f32, isa == avx512_core
+                    && kernel_dt == data_type::bf16,
+            jit_avx512_dw_conv_fwd_kernel_bf16,
+            jit_uni_dw_conv_fwd_kernel_f32<isa>>::type;
+#else
     using jit_kernel_t = typename utils::conditional<isa == avx512_core
                     && kernel_dt == data_type::bf16,
             jit_avx512_dw_conv_fwd_kernel_bf16,
             jit_uni_dw_conv_fwd_kernel_f32<isa>>::type;
+#endif
     jit_kernel_t *ker_;
 };
 
@@ -102,7 +129,7 @@ status_t jit_uni_dw_conv_fwd_kernel<isa, kernel_dt>::init_conf(
     if (!mayiuse(isa) || (is_bf16 && !mayiuse(avx512_core)))
         return status::unimplemented;
 
-    const int simd_w = one_of(isa, avx512_common, avx512_core) ? 16 : 8;
+    const int simd_w = dw_conv_is_16ch_isa(isa) ? 16 : 8;
 
     jcp.prop_kind = cd.prop_kind;
 
@@ -151,17 +178,15 @@ status_t jit_uni_dw_conv_fwd_kernel<isa, kernel_dt>::init_conf(
     bool ok_to_pad_channels = true
         && jcp.oc == jcp.ngroups
         && jcp.ic == jcp.ngroups
-        && one_of(isa, avx512_common, avx512_core, avx2);
+        && (dw_conv_is_16ch_isa(isa) || isa == avx2);
     if (ok_to_pad_channels) {
         jcp.oc = rnd_up(jcp.oc, simd_w);
         jcp.ic = rnd_up(jcp.oc, simd_w);
         jcp.ngroups = rnd_up(jcp.ngroups, simd_w);
     }
 
-    auto desired_act_fmt
-            = one_of(isa, avx512_common, avx512_core) ? nChw16c : nChw8c;
-    auto desired_wei_fmt
-            = one_of(isa, avx512_common, avx512_core) ? Goihw16g : Goihw8g;
+    auto desired_act_fmt = dw_conv_is_16ch_isa(isa) ? nChw16c : nChw8c;
+    auto desired_wei_fmt = dw_conv_is_16ch_isa(isa) ? Goihw16g : Goihw8g;
 
     bool args_ok = true
         && jcp.oc == jcp.ngroups
@@ -183,12 +208,12 @@ status_t jit_uni_dw_conv_fwd_kernel<isa, kernel_dt>::init_conf(
             : sizeof(float);
 
     jcp.ur_w = is_bf16 ? (isa_has_bf16(jcp.isa) ? 6 : 4)
-                       : isa == avx512_common ? 6 : isa == avx2 ? 4 : 3;
+                       : dw_conv_f32_ur_w(isa);
 
     jcp.ch_block = simd_w;
     jcp.nb_ch = jcp.oc / jcp.ch_block;
     jcp.nb_ch_blocking
-            = one_of(isa, avx512_common, avx512_core) ? 4 : isa == avx2 ? 3 : 2;
+            = dw_conv_is_16ch_isa(isa) ? 4 : isa == avx2 ? 3 : 2;
     if (jcp.nb_ch < jcp.nb_ch_blocking)
         jcp.nb_ch_blocking = jcp.nb_ch;
 
@@ -210,6 +235,9 @@ template struct jit_uni_dw_conv_fwd_kernel<avx512_core, data_type::bf16>;
 template struct jit_uni_dw_conv_fwd_kernel<avx512_common, data_type::f32>;
 template struct jit_uni_dw_conv_fwd_kernel<avx2, data_type::f32>;
 template struct jit_uni_dw_conv_fwd_kernel<sse42, data_type::f32>;
+#ifdef __ARM_ARCH
+template struct jit_uni_dw_conv_fwd_kernel<sve, data_type::f32>;
+#endif
 
 template <cpu_isa_t isa, data_type_t kernel_dt>
 struct jit_uni_dw_conv_bwd_data_kernel {
@@ -234,10 +262,18 @@ struct jit_uni_dw_conv_bwd_data_kernel {
     void (*jit_ker)(jit_conv_call_s *);
 
 private:
+#ifdef __ARM_ARCH
+    using jit_kernel_t = typename utils::conditional3<isa == sve,
+            jit_sve_dw_conv_bwd_data_kernel_f32, isa == avx512_core
+                    && kernel_dt == data_type::bf16,
+            jit_avx512_dw_conv_bwd_data_kernel_bf16,
+            jit_uni_dw_conv_bwd_data_kernel_f32<isa>>::type;
+#else
     using jit_kernel_t = typename utils::conditional<isa == avx512_core
                     && kernel_dt == data_type::bf16,
             jit_avx512_dw_conv_bwd_data_kernel_bf16,
             jit_uni_dw_conv_bwd_data_kernel_f32<isa>>::type;
+#endif
     jit_kernel_t *ker_;
 };
 
@@ -256,7 +292,7 @@ status_t jit_uni_dw_conv_bwd_data_kernel<isa, kernel_dt>::init_conf(
     if (!mayiuse(isa) || (is_bf16 && !mayiuse(avx512_core)))
         return status::unimplemented;
 
-    const int simd_w = one_of(isa, avx512_common, avx512_core) ? 16 : 8;
+    const int simd_w = dw_conv_is_16ch_isa(isa) ? 16 : 8;
 
     const bool with_groups = weights_d.ndims() == diff_src_d.ndims() + 1;
     if (!with_groups) return status::unimplemented;
@@ -295,17 +331,15 @@ status_t jit_uni_dw_conv_bwd_data_kernel<isa, kernel_dt>::init_conf(
     bool ok_to_pad_channels = true
         && jcp.oc == jcp.ngroups
         && jcp.ic == jcp.ngroups
-        && one_of(isa, avx512_common, avx512_core, avx2);
+        && (dw_conv_is_16ch_isa(isa) || isa == avx2);
     if (ok_to_pad_channels) {
         jcp.oc = rnd_up(jcp.oc, simd_w);
         jcp.ic = rnd_up(jcp.oc, simd_w);
         jcp.ngroups = rnd_up(jcp.ngroups, simd_w);
     }
 
-    auto desired_act_fmt
-            = one_of(isa, avx512_common, avx512_core) ? nChw16c : nChw8c;
-    auto desired_wei_fmt
-            = one_of(isa, avx512_common, avx512_core) ? Goihw16g : Goihw8g;
+    auto desired_act_fmt = dw_conv_is_16ch_isa(isa) ? nChw16c : nChw8c;
+    auto desired_wei_fmt = dw_conv_is_16ch_isa(isa) ? Goihw16g : Goihw8g;
 
     bool args_ok = true
         && jcp.oc == jcp.ngroups
@@ -331,12 +365,12 @@ status_t jit_uni_dw_conv_bwd_data_kernel<isa, kernel_dt>::init_conf(
             : sizeof(float);
 
     jcp.ur_w = is_bf16 ? (isa_has_bf16(jcp.isa) ? 6 : 4)
-                       : isa == avx512_common ? 6 : isa == avx2 ? 4 : 3;
+                       : dw_conv_f32_ur_w(isa);
 
     jcp.ch_block = simd_w;
     jcp.nb_ch = jcp.ic / jcp.ch_block;
     jcp.nb_ch_blocking
-            = one_of(isa, avx512_common, avx512_core) ? 4 : isa == avx2 ? 3 : 2;
+            = dw_conv_is_16ch_isa(isa) ? 4 : isa == avx2 ? 3 : 2;
     if (jcp.nb_ch < jcp.nb_ch_blocking)
         jcp.nb_ch_blocking = jcp.nb_ch;
 
@@ -354,6 +388,9 @@ template struct jit_uni_dw_conv_bwd_data_kernel<avx512_core, data_type::bf16>;
 template struct jit_uni_dw_conv_bwd_data_kernel<avx512_common, data_type::f32>;
 template struct jit_uni_dw_conv_bwd_data_kernel<avx2, data_type::f32>;
 template struct jit_uni_dw_conv_bwd_data_kernel<sse42, data_type::f32>;
+#ifdef __ARM_ARCH
+template struct jit_uni_dw_conv_bwd_data_kernel<sve, data_type::f32>;
+#endif
 
 template <cpu_isa_t isa, data_type_t kernel_dt>
 struct jit_uni_dw_conv_bwd_weights_kernel {
@@ -379,10 +416,18 @@ struct jit_uni_dw_conv_bwd_weights_kernel {
     void (*jit_ker)(jit_dw_conv_call_s *);
 
 private:
+#ifdef __ARM_ARCH
+    using jit_kernel_t = typename utils::conditional3<isa == sve,
+            jit_sve_dw_conv_bwd_weights_kernel_f32, isa == avx512_core
+                    && kernel_dt == data_type::bf16,
+            jit_avx512_dw_conv_bwd_weights_kernel_bf16,
+            jit_uni_dw_conv_bwd_weights_kernel_f32<isa>>::type;
+#else
     using jit_kernel_t = typename utils::conditional<isa == avx512_core
                     && kernel_dt == data_type::bf16,
             jit_avx512_dw_conv_bwd_weights_kernel_bf16,
             jit_uni_dw_conv_bwd_weights_kernel_f32<isa>>::type;
+#endif
     jit_kernel_t *ker_;
 };
 
@@ -412,7 +457,7 @@ status_t jit_uni_dw_conv_bwd_weights_kernel<isa, kernel_dt>::init_conf(
     if (!jcp.is_depthwise)
         return status::unimplemented;
 
-    jcp.ch_block = one_of(isa, avx512_common, avx512_core) ? 16 : 8;
+    jcp.ch_block = dw_conv_is_16ch_isa(isa) ? 16 : 8;
 
     jcp.mb = src_d.dims()[0];
 
@@ -443,10 +488,8 @@ status_t jit_uni_dw_conv_bwd_weights_kernel<isa, kernel_dt>::init_conf(
 
     jcp.with_bias = cd.diff_bias_desc.format != memory_format::undef;
 
-    auto desired_act_fmt
-            = one_of(isa, avx512_common, avx512_core) ? nChw16c : nChw8c;
-    auto desired_wei_fmt
-            = one_of(isa, avx512_common, avx512_core) ? Goihw16g : Goihw8g;
+    auto desired_act_fmt = dw_conv_is_16ch_isa(isa) ? nChw16c : nChw8c;
+    auto desired_wei_fmt = dw_conv_is_16ch_isa(isa) ? Goihw16g : Goihw8g;
 
     bool args_ok = true && src_d.format() == desired_act_fmt
             && diff_weights_d.format() == desired_wei_fmt
@@ -547,6 +590,9 @@ template struct jit_uni_dw_conv_bwd_weights_kernel<avx512_common,
         data_type::f32>;
 template struct jit_uni_dw_conv_bwd_weights_kernel<avx2, data_type::f32>;
 template struct jit_uni_dw_conv_bwd_weights_kernel<sse42, data_type::f32>;
+#ifdef __ARM_ARCH
+template struct jit_uni_dw_conv_bwd_weights_kernel<sve, data_type::f32>;
+#endif
 }
 }
 }
@@ -60,6 +60,8 @@ const size_t ker_prb_size_min = 64;
 struct jit_uni_reorder_kernel_f32: public kernel_t, public jit_generator {
     DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_uni_reorder_kernel_f32)
 
+    size_t code_size() const override { return jit_generator::code_size(); }
+
     enum {
         len_unroll_max = 256,
         ndims_jit_loop_max = 3,
@@ -967,10 +969,10 @@ struct jit_uni_reorder_t : public cpu_primitive_t {
     jit_uni_reorder_t(const pd_t *apd, const input_vector &inputs,
             const output_vector &outputs)
         : cpu_primitive_t(apd, inputs, outputs) {
-        kernel_ = tr::kernel_t::create(pd()->ker_desc_);
+        kernel_ = tr::kernel_t::get(pd()->ker_desc_);
         assert(kernel_);
     }
-    ~jit_uni_reorder_t() { delete kernel_; }
+    ~jit_uni_reorder_t() {}
 
     void omp_driver_0d(int off, const char *in, char *out,
             const float *scale) const {
@@ -1081,7 +1083,7 @@ struct jit_uni_reorder_t : public cpu_primitive_t {
 
 private:
     const pd_t *pd() const { return (const pd_t *)primitive_t::pd(); }
-    tr::kernel_t *kernel_;
+    std::shared_ptr<tr::kernel_t> kernel_;
 };
 
 status_t jit_uni_reorder_create(reorder_pd_t **reorder_pd,
@@ -24,6 +24,7 @@
 
 #include "cpu_primitive.hpp"
 #include "cpu_reorder_pd.hpp"
+#include "jit_kernel_registry.hpp"
 
 namespace mkldnn {
 namespace impl {
@@ -104,6 +105,26 @@ struct kernel_t {
     /** creates kernel for the problem described in desc */
     static kernel_t *create(const desc_t &desc);
 
+    /** returns the kernel for desc, shared with the other reorders that
+     * have the same descriptor */
+    static std::shared_ptr<kernel_t> get(const desc_t &desc) {
+        const prb_t &p = desc.prb;
+        jit_kernel_registry_t::key_t key;
+        jit_kernel_registry_t::append(key, desc.id);
+        jit_kernel_registry_t::append(key, p.itype);
+        jit_kernel_registry_t::append(key, p.otype);
+        jit_kernel_registry_t::append(key, p.ndims);
+        jit_kernel_registry_t::append(key, p.nodes, p.ndims);
+        jit_kernel_registry_t::append(key, p.ioff);
+        jit_kernel_registry_t::append(key, p.ooff);
+        jit_kernel_registry_t::append(key, p.scale_type);
+        jit_kernel_registry_t::append(key, p.beta);
+        return jit_kernel_registry().get<kernel_t>(key,
+                [&]() { return create(desc); });
+    }
+
+    virtual size_t code_size() const { return 0; }
+
 protected:
     const desc_t desc_;
     const prb_t &prb_ = desc_.prb;
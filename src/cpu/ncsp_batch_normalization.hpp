@@ -59,7 +59,7 @@ struct ncsp_batch_normalization_fwd_t : public cpu_primitive_t {
                         desc()->variance_desc.data_type)
                 && utils::one_of(data_pd_.desc()->format, memory_format::nchw,
                         memory_format::ncdhw, memory_format::nc)
-                && IMPLICATION(data_type == bf16, mayiuse(avx512_core))
+                && IMPLICATION(data_type == bf16, mayiuse_bf16_cvt())
                 && (attr()->has_default_values() || this->with_relu_post_op());
             if (!ok) return status::unimplemented;
 
@@ -152,7 +152,7 @@ struct ncsp_batch_normalization_bwd_t : public cpu_primitive_t {
                 && IMPLICATION(use_scaleshift(),
                         desc()->diff_data_scaleshift_desc.data_type == f32
                         && desc()->data_scaleshift_desc.data_type == f32)
-                && IMPLICATION(data_type == bf16, mayiuse(avx512_core))
+                && IMPLICATION(data_type == bf16, mayiuse_bf16_cvt())
                 && utils::one_of(data_pd_.desc()->format, memory_format::nchw,
                         memory_format::ncdhw, memory_format::nc)
                 && attr()->has_default_values()
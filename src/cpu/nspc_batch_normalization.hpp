@@ -63,7 +63,7 @@ struct nspc_batch_normalization_fwd_t : public cpu_primitive_t {
                     // TODO: add ndhwc support?
                     && utils::one_of(
                                data_pd_.desc()->format, memory_format::nhwc)
-                    && IMPLICATION(data_type == bf16, mayiuse(avx512_core))
+                    && IMPLICATION(data_type == bf16, mayiuse_bf16_cvt())
                     && (attr()->has_default_values()
                                || this->with_relu_post_op());
             if (!ok)
@@ -159,7 +159,7 @@ struct nspc_batch_normalization_bwd_t : public cpu_primitive_t {
                                                == f32
                                        && desc()->data_scaleshift_desc.data_type
                                                == f32)
-                    && IMPLICATION(data_type == bf16, mayiuse(avx512_core))
+                    && IMPLICATION(data_type == bf16, mayiuse_bf16_cvt())
                     // TODO: add ndhwc support?
                     && utils::one_of(
                                data_pd_.desc()->format, memory_format::nhwc)
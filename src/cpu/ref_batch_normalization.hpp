@@ -56,7 +56,7 @@ struct ref_batch_normalization_fwd_t : public cpu_primitive_t {
                 && utils::everyone_is(f32,
                         desc()->mean_desc.data_type,
                         desc()->variance_desc.data_type)
-                && IMPLICATION(data_type == bf16, mayiuse(avx512_core))
+                && IMPLICATION(data_type == bf16, mayiuse_bf16_cvt())
                 && (attr()->has_default_values() || this->with_relu_post_op());
             if (!ok) return status::unimplemented;
 
@@ -122,7 +122,7 @@ struct ref_batch_normalization_bwd_t : public cpu_primitive_t {
                 && IMPLICATION(use_scaleshift(),
                         desc()->diff_data_scaleshift_desc.data_type == f32
                         && desc()->data_scaleshift_desc.data_type == f32)
-                && IMPLICATION(data_type == bf16, mayiuse(avx512_core))
+                && IMPLICATION(data_type == bf16, mayiuse_bf16_cvt())
                 && attr()->has_default_values()
                 && hint_fwd_pd_ != nullptr;
             if (!ok) return status::unimplemented;
@@ -142,8 +142,9 @@ struct ref_deconvolution_fwd_t: public cpu_primitive_t {
             status = conv_descr_create(this->desc(), &cd);
             if (status != status::success) return status;
 
+            const primitive_attr_t conv_attr = this->attr_.nested();
             mkldnn_primitive_desc_iterator it(this->engine_, (op_desc_t *)&cd,
-                &(this->attr_), nullptr);
+                &conv_attr, nullptr);
             while (++it != it.end()) {
                 conv_pd_ = *it;
                 conv_supports_bias_
@@ -317,8 +318,9 @@ struct ref_deconvolution_bwd_data_t: public cpu_primitive_t {
             status = conv_descr_create(this->desc(), &cd);
             if (status != status::success) return status;
 
+             const primitive_attr_t conv_attr = this->attr_.nested();
              mkldnn_primitive_desc_iterator it(this->engine_, (op_desc_t *)&cd,
-                &(this->attr_), nullptr);
+                &conv_attr, nullptr);
              while (++it != it.end()) {
                 conv_pd_ = *it;
                 if (format_normalize(conv_pd_->weights_pd()->desc()->format)
@@ -418,8 +420,9 @@ struct ref_deconvolution_bwd_weights_t: public cpu_primitive_t {
             status = conv_descr_create(this->desc(), &cd);
             if (status != status::success) return status;
 
+             const primitive_attr_t conv_attr = this->attr_.nested();
              mkldnn_primitive_desc_iterator it(this->engine_, (op_desc_t *)&cd,
-                &(this->attr_), nullptr);
+                &conv_attr, nullptr);
              while (++it != it.end()) {
                 conv_pd_ = *it;
                 auto wei_fmt = conv_pd_->diff_weights_pd()->desc()->format;
@@ -83,7 +83,7 @@ struct ref_eltwise_fwd_t: public cpu_primitive_t {
                 && everyone_is(data_type, desc()->data_desc.data_type)
                 && IMPLICATION(use_generic, one_of(src_d.ndims(), 4, 5))
                 && attr()->has_default_values()
-                && IMPLICATION(data_type == data_type::bf16, mayiuse(avx512_core));
+                && IMPLICATION(data_type == data_type::bf16, mayiuse_bf16_cvt());
             if (!ok) return status::unimplemented;
 
             return status::success;
@@ -137,7 +137,7 @@ struct ref_eltwise_bwd_t: public cpu_primitive_t {
                             desc()->diff_data_desc.data_type)
                     && attr()->has_default_values()
                     && IMPLICATION(data_type == data_type::bf16,
-                            mayiuse(avx512_core));
+                            mayiuse_bf16_cvt());
             if (!ok) return status::unimplemented;
 
             auto diff_dst_d = memory_desc_wrapper(diff_dst_pd());
@@ -49,7 +49,7 @@ struct ref_lrn_fwd_t: public cpu_primitive_t {
                 && utils::one_of(desc()->alg_kind, lrn_across_channels,
                         lrn_within_channel)
                 && utils::everyone_is(data_type, desc()->data_desc.data_type)
-                && IMPLICATION(data_type == bf16, mayiuse(avx512_core))
+                && IMPLICATION(data_type == bf16, mayiuse_bf16_cvt())
                 && attr()->has_default_values();
             if (!ok) return status::unimplemented;
 
@@ -103,7 +103,7 @@ struct ref_lrn_bwd_t: public cpu_primitive_t {
                         /*, lrn_within_channel */) // not supported yet
                 && utils::everyone_is(data_type, desc()->data_desc.data_type)
                 && IMPLICATION(data_type == bf16,
-                                    mayiuse(cpu_isa_t::avx512_core))
+                                    mayiuse_bf16_cvt())
                 && attr()->has_default_values();
             if (!ok) return status::unimplemented;
 
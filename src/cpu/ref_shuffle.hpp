@@ -49,10 +49,10 @@ struct ref_shuffle_t : public cpu_primitive_t {
                     && data_type_size
                             == types::data_type_size(
                                        this->desc()->data_desc.data_type)
-                    /*bf16<->f32 cvt operators don't work on non-avx512_core*/
+                    /*bf16<->f32 cvt operators need avx512_core on x86*/
                     && IMPLICATION(this->desc()->data_desc.data_type
                                        == data_type::bf16,
-                               mayiuse(avx512_core));
+                               mayiuse_bf16_cvt());
             if (!ok)
                 return status::unimplemented;
             return status::success;
@@ -34,6 +34,153 @@ namespace mkldnn {
 namespace impl {
 namespace cpu {
 
+namespace {
+/* Offsets of the (outer, channel, inner) index space of a softmax along
+ * 'axis'. In a blocked layout every dimension contributes to the offset
+ * independently, so the offset of an element is the sum of its outer,
+ * channel and inner parts. The inner part is a plain stride if the inner
+ * dimensions are neither blocked nor padded and are laid out one after
+ * another (nchw or nChw16c along C, say), otherwise it is computed from
+ * the strides of every inner dimension. */
+struct softmax_strides_t {
+    softmax_strides_t(const memory_desc_wrapper &md, int axis)
+        : md_(md), axis_(axis), inner_stride_(0) {
+        const auto &blk = md_.blocking_desc();
+        const int ndims = md_.ndims();
+        bool simple_inner = true;
+        for (int d = axis_ + 1; d < ndims; d++) {
+            simple_inner = simple_inner && blk.block_dims[d] == 1
+                && blk.offset_padding_to_data[d] == 0
+                && IMPLICATION(d + 1 < ndims, blk.strides[0][d]
+                        == blk.strides[0][d + 1] * md_.dims()[d + 1]);
+        }
+        if (simple_inner)
+            inner_stride_ = axis_ + 1 < ndims ? blk.strides[0][ndims - 1] : 1;
+    }
+
+    size_t dim_off(int d, int pos) const {
+        const auto &blk = md_.blocking_desc();
+        const int p = pos + blk.offset_padding_to_data[d];
+        const int block = blk.block_dims[d];
+        return (p / block) * blk.strides[0][d]
+            + (p % block) * blk.strides[1][d];
+    }
+
+    /* offset of the logical index 'idx' of dimensions [from, to) */
+    size_t dims_off(int from, int to, int idx) const {
+        size_t off = 0;
+        for (int d = to - 1; d >= from; d--) {
+            const int dim = md_.dims()[d];
+            off += dim_off(d, idx % dim);
+            idx /= dim;
+        }
+        return off;
+    }
+
+    size_t outer_off(int ou) const {
+        return md_.blocking_desc().offset_padding + dims_off(0, axis_, ou);
+    }
+    size_t channel_off(int c) const { return dim_off(axis_, c); }
+    size_t inner_off(int in) const {
+        return inner_stride_ ? in * inner_stride_
+            : dims_off(axis_ + 1, md_.ndims(), in);
+    }
+    bool inner_dense() const { return inner_stride_ == 1; }
+
+    const memory_desc_wrapper &md_;
+    const int axis_;
+    ptrdiff_t inner_stride_;
+};
+
+/* inner offsets of a block of the inner dimensions: contiguous, or read
+ * from a table */
+struct dense_inner_t {
+    dense_inner_t(size_t start): start_(start) {}
+    size_t operator()(int i) const { return start_ + i; }
+    size_t start_;
+};
+
+struct table_inner_t {
+    table_inner_t(const size_t *off): off_(off) {}
+    size_t operator()(int i) const { return off_[i]; }
+    const size_t *off_;
+};
+
+enum { inner_block = 64 };
+
+/* softmax over 'channels' for 'len' consecutive inner points, the loops
+ * over the inner points are the vectorized ones */
+template <typename data_t, typename inner_t>
+void softmax_fwd_block(const data_t *src, data_t *dst,
+        const softmax_strides_t &strides, size_t base, int channels, int len,
+        inner_t in_off) {
+    data_t max[inner_block], denom[inner_block];
+    for (int i = 0; i < len; i++) {
+        max[i] = -FLT_MAX;
+        denom[i] = 0;
+    }
+
+    for (int c = 0; c < channels; c++) {
+        const data_t *s = &src[base + strides.channel_off(c)];
+        PRAGMA_OMP_SIMD()
+        for (int i = 0; i < len; i++)
+            max[i] = nstl::max(max[i], s[in_off(i)]);
+    }
+
+    for (int c = 0; c < channels; c++) {
+        const size_t off = base + strides.channel_off(c);
+        const data_t *s = &src[off];
+        data_t *d = &dst[off];
+        PRAGMA_OMP_SIMD()
+        for (int i = 0; i < len; i++) {
+            const data_t e = expf(s[in_off(i)] - max[i]);
+            d[in_off(i)] = e;
+            denom[i] += e;
+        }
+    }
+
+    for (int i = 0; i < len; i++)
+        denom[i] = data_t(1) / denom[i];
+
+    for (int c = 0; c < channels; c++) {
+        data_t *d = &dst[base + strides.channel_off(c)];
+        PRAGMA_OMP_SIMD()
+        for (int i = 0; i < len; i++)
+            d[in_off(i)] *= denom[i];
+    }
+}
+
+template <typename data_t, typename inner_t>
+void softmax_bwd_block(const data_t *data, const data_t *diff_dst,
+        data_t *diff_src, const softmax_strides_t &data_strides,
+        const softmax_strides_t &diff_strides, size_t data_base,
+        size_t diff_base, int channels, int len, inner_t data_in_off,
+        inner_t diff_in_off) {
+    data_t sbr[inner_block];
+    for (int i = 0; i < len; i++)
+        sbr[i] = 0;
+
+    for (int c = 0; c < channels; c++) {
+        const data_t *s = &data[data_base + data_strides.channel_off(c)];
+        const data_t *dd = &diff_dst[diff_base + diff_strides.channel_off(c)];
+        PRAGMA_OMP_SIMD()
+        for (int i = 0; i < len; i++)
+            sbr[i] += dd[diff_in_off(i)] * s[data_in_off(i)];
+    }
+
+    for (int c = 0; c < channels; c++) {
+        const size_t diff_off = diff_base + diff_strides.channel_off(c);
+        const data_t *s = &data[data_base + data_strides.channel_off(c)];
+        const data_t *dd = &diff_dst[diff_off];
+        data_t *ds = &diff_src[diff_off];
+        PRAGMA_OMP_SIMD()
+        for (int i = 0; i < len; i++)
+            ds[diff_in_off(i)] = s[data_in_off(i)]
+                * (dd[diff_in_off(i)] - sbr[i]);
+    }
+}
+}
+
 template <impl::data_type_t data_type>
 void ref_softmax_fwd_t<data_type>::execute_forward_dense() const {
     auto src = reinterpret_cast<const data_t *>(this->input_memory(0));
@@ -62,42 +209,26 @@ void ref_softmax_fwd_t<data_type>::execute_forward_generic() const {
     auto src = reinterpret_cast<const data_t *>(this->input_memory(0));
     auto dst = reinterpret_cast<data_t *>(this->memory(0));
 
-    data_t space_max_val = 0, space_denom_val = 0;
-    data_t *space_max = &space_max_val, *space_denom = &space_denom_val;
-    if (inner_size_ > 1) {
-        using namespace memory_tracking::names;
-        space_max = scratchpad().template get<data_t>(key_softmax_reduction);
-        space_denom = space_max + inner_size_;
-    }
-
     const memory_desc_wrapper data_d(pd()->src_pd());
-    const size_t dim = channels_ * inner_size_;
-
-    for (int ou = 0; ou < outer_size_; ou++) {
-        utils::array_set(space_max, -FLT_MAX, inner_size_);
-        utils::array_set(space_denom, 0, inner_size_);
-
-        for (int c = 0; c < channels_; c++) {
-            for(int in = 0; in < inner_size_; in++) {
-                size_t off = data_d.off_l(ou * dim + c * inner_size_ + in);
-                space_max[in] = nstl::max(space_max[in], src[off]);
-            }
+    const softmax_strides_t strides(data_d, pd()->desc()->softmax_axis);
+    const int nb_inner = utils::div_up(inner_size_, (int)inner_block);
+
+    parallel_nd(outer_size_, nb_inner, [&](int ou, int inb) {
+        const int in_start = inb * inner_block;
+        const int len = nstl::min((int)inner_block, inner_size_ - in_start);
+        const size_t base = strides.outer_off(ou);
+
+        if (strides.inner_dense()) {
+            softmax_fwd_block(src, dst, strides, base, channels_, len,
+                    dense_inner_t(in_start));
+        } else {
+            size_t in_off[inner_block];
+            for (int i = 0; i < len; i++)
+                in_off[i] = strides.inner_off(in_start + i);
+            softmax_fwd_block(src, dst, strides, base, channels_, len,
+                    table_inner_t(in_off));
         }
-
-        for (int c = 0; c < channels_; c++) {
-            for(int in = 0; in < inner_size_; in++) {
-                size_t off = data_d.off_l(ou * dim + c * inner_size_ + in);
-                space_denom[in] += dst[off] = exp(src[off] - space_max[in]);
-            }
-        }
-
-        for (int c = 0; c < channels_; c++) {
-            for (int in = 0; in < inner_size_; in++) {
-                size_t off = data_d.off_l(ou * dim + c * inner_size_ + in);
-                dst[off] /= space_denom[in];
-            }
-        }
-    }
+    });
 }
 
 template <impl::data_type_t data_type>
@@ -241,27 +372,38 @@ void ref_softmax_bwd_t<data_type>::execute_backward_dense() const {
 
 template <impl::data_type_t data_type>
 void ref_softmax_bwd_t<data_type>::execute_backward_generic() const {
-    const size_t dim = channels_ * inner_size_;
     auto data = reinterpret_cast<const data_t *>(this->input_memory(0));
     auto diff_dst = reinterpret_cast<const data_t *>(this->input_memory(1));
     auto diff_src = reinterpret_cast<data_t *>(this->memory(0));
+
+    const int axis = pd()->desc()->softmax_axis;
     const memory_desc_wrapper diff_d(pd()->diff_src_pd());
     const memory_desc_wrapper data_d(pd()->dst_pd());
-
-    parallel_nd(outer_size_, [&](int ou) {
-        for (int in = 0; in < inner_size_; in++) {
-            data_t sbr = 0;
-            for (int c = 0; c < channels_; c++) {
-                size_t off_diff = diff_d.off_l(ou * dim + c * inner_size_ + in);
-                size_t off_data = diff_d.off_l(ou * dim + c * inner_size_ + in);
-                sbr += diff_dst[off_diff]*data[off_data];
-            }
-
-            for(int c=0; c < channels_ ; ++c) {
-              size_t off_diff = diff_d.off_l(ou * dim + c * inner_size_ + in);
-              size_t off_data = data_d.off_l(ou * dim + c * inner_size_ + in);
-              diff_src[off_diff] = data[off_data]*(diff_dst[off_diff] - sbr);
+    const softmax_strides_t diff_strides(diff_d, axis);
+    const softmax_strides_t data_strides(data_d, axis);
+    const bool inner_dense = diff_strides.inner_dense()
+        && data_strides.inner_dense();
+    const int nb_inner = utils::div_up(inner_size_, (int)inner_block);
+
+    parallel_nd(outer_size_, nb_inner, [&](int ou, int inb) {
+        const int in_start = inb * inner_block;
+        const int len = nstl::min((int)inner_block, inner_size_ - in_start);
+        const size_t data_base = data_strides.outer_off(ou);
+        const size_t diff_base = diff_strides.outer_off(ou);
+
+        if (inner_dense) {
+            softmax_bwd_block(data, diff_dst, diff_src, data_strides,
+                    diff_strides, data_base, diff_base, channels_, len,
+                    dense_inner_t(in_start), dense_inner_t(in_start));
+        } else {
+            size_t data_in_off[inner_block], diff_in_off[inner_block];
+            for (int i = 0; i < len; i++) {
+                data_in_off[i] = data_strides.inner_off(in_start + i);
+                diff_in_off[i] = diff_strides.inner_off(in_start + i);
             }
+            softmax_bwd_block(data, diff_dst, diff_src, data_strides,
+                    diff_strides, data_base, diff_base, channels_, len,
+                    table_inner_t(data_in_off), table_inner_t(diff_in_off));
         }
     });
 }
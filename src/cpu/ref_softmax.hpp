@@ -50,23 +50,8 @@ struct ref_softmax_fwd_t: public cpu_primitive_t {
                 && attr()->has_default_values();
             if (!ok) return status::unimplemented;
 
-            init_scratchpad();
-
             return status::success;
         }
-
-    private:
-        void init_scratchpad() {
-            const int inner_size = utils::array_product(
-                    desc()->data_desc.dims + desc()->softmax_axis + 1,
-                    desc()->data_desc.ndims - desc()->softmax_axis - 1);
-
-            if (inner_size > 1) {
-                auto scratchpad = scratchpad_registry().registrar();
-                scratchpad.book(memory_tracking::names::key_softmax_reduction,
-                        sizeof(data_t) * 2 * inner_size);
-            }
-        }
     };
 
     ref_softmax_fwd_t(const pd_t *apd, const input_vector &inputs,
@@ -40,7 +40,7 @@ rnn_cell_execution_sig(
     rnn_postgemm_->execute(rnn, ws_gates_, states_t_l_, c_states_t_l_,
             states_tm1_l_, c_states_tm1_l_, diff_states_t_l_,
             diff_states_t_lp1_, diff_states_tp1_l_, bias_[0], ws_grid_,
-            ws_cell_);
+            ws_cell_, diff_bias_);
 }
 template rnn_cell_execution_sig(ref_rnn_fwd_f32_t::cell_execution);
 template rnn_cell_execution_sig(ref_rnn_fwd_u8s8_t::cell_execution);
@@ -51,7 +51,7 @@ rnn_cell_execution_sig(ref_rnn_bwd_f32_t::cell_execution) {
     rnn_postgemm_->execute(rnn, ws_gates_, states_t_l_, c_states_t_l_,
             states_tm1_l_, c_states_tm1_l_, diff_states_t_l_,
             diff_states_t_lp1_, diff_states_tp1_l_, bias_[0], ws_grid_,
-            ws_cell_);
+            ws_cell_, diff_bias_);
 
     /// bwd by data on the cell
     (this->*gemm_iter_func)('N', 'N', rnn.sic, rnn.mb, rnn.n_gates * rnn.dic,
@@ -75,8 +75,10 @@ rnn_cell_execution_sig(ref_rnn_bwd_f32_t::cell_execution) {
                 rnn.gates_ws_ld, states_tm1_l_, rnn.states_ws_ld, 1.0,
                 diff_w_iter_, rnn.diff_weights_iter_ld);
 
-    /// bwd by bias we just accumulate diffs from the gates
-    gates_reduction(rnn, ws_gates_, diff_bias_);
+    /// bwd by bias we just accumulate diffs from the gates, unless the
+    /// postgemm kernel already did
+    if (!rnn_postgemm_->bias_reduction_fused())
+        gates_reduction(rnn, ws_gates_, diff_bias_);
 }
 
 }
@@ -47,7 +47,7 @@ rnn_cell_execution_sig(ref_rnn_fwd_f32_t::cell_execution_gru_lbr) {
     rnn_postgemm_->execute(rnn, ws_gates_,
                 states_t_l_, c_states_t_l_, states_tm1_l_, c_states_tm1_l_,
                 diff_states_t_l_, diff_states_t_lp1_, diff_states_tp1_l_,
-                bias_[0], ws_grid_, ws_cell_);
+                bias_[0], ws_grid_, ws_cell_, diff_bias_);
 }
 
 template <>
@@ -64,7 +64,7 @@ rnn_cell_execution_sig(ref_rnn_bwd_f32_t::cell_execution_gru_lbr) {
     rnn_postgemm_->execute(rnn, ws_gates_,
                 states_t_l_, c_states_t_l_, states_tm1_l_, c_states_tm1_l_,
                 diff_states_t_l_, diff_states_t_lp1_, diff_states_tp1_l_,
-                bias_[0], ws_grid_, ws_cell_);
+                bias_[0], ws_grid_, ws_cell_, diff_bias_);
 
     if (!rnn.merge_gemm_layer) {
         //  dx = dG * Wx^t
@@ -89,6 +89,10 @@ rnn_cell_execution_sig(ref_rnn_bwd_f32_t::cell_execution_gru_lbr) {
 
     // db1-3 += e * dG
     // db4 += e * (r * dG2)
+    // the postgemm kernel may have done it already
+    if (rnn_postgemm_->bias_reduction_fused())
+        return;
+
     gates_reduction(rnn, ws_gates_, diff_bias_);
 
     parallel_nd(rnn.dic, [&](int j) {
@@ -189,10 +189,91 @@ protected:
 
 };
 
+template <cpu_isa_t isa>
+struct jit_uni_gru_cell_postgemm_part1_bwd: public jit_uni_rnn_postgemm
+{
+    DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_uni_gru_cell_postgemm_part1_bwd)
+
+    jit_uni_gru_cell_postgemm_part1_bwd(const rnn_utils::rnn_conf_t &rnn, const rnn_pd_t *pd)
+    : jit_uni_rnn_postgemm(rnn, pd){}
+
+    void init() override {
+        generate();
+        bwd_kernel_ = (bwd_kernel_t) this->getCode();
+    }
+
+protected:
+    // register size in bytes
+    using Vmm = typename jit_uni_eltwise_injector_f32<isa>::Vmm;
+    size_t vlen = cpu_isa_traits<isa>::vlen;
+
+    void generate() {
+        using namespace Xbyak;
+
+        Label table_label;
+
+        // Register map, Vmm(1) and Vmm(2) accumulate the bias gradients of
+        // G0 and G2, G1 is done in part 2
+        Vmm dG0_acc(1), dG2_acc(2), one(3), G0(4), G2(5), h(6), dHt(7),
+                tmp1_vmm(8), tmp2_vmm(9), tmp3_vmm(10);
+
+        preamble();
+        load_bwd_params();
+        mov(rax, table_label);
+        uni_vmovups(one, ptr[rax]);
+
+        bwd_loops<Vmm>(vlen, {0, 2}, [&](bool vector) {
+            bwd_load(h, states_addr(reg_states_tm1), vector);
+            bwd_load(dHt, states_addr(reg_diff_tp1), vector);
+            bwd_load(tmp1_vmm, states_addr(reg_diff_t_lp1), vector);
+            uni_vaddps(dHt, dHt, tmp1_vmm);
+            bwd_load(G0, gates_addr(reg_ws_gates, 0), vector);
+            bwd_load(G2, gates_addr(reg_ws_gates, 2), vector);
+
+            // dG2 = (1 - G0) * dHt * (1 - G2^2)
+            uni_vmovups(tmp1_vmm, one);
+            uni_vsubps(tmp1_vmm, tmp1_vmm, G0);
+            uni_vmulps(tmp1_vmm, tmp1_vmm, dHt);
+            uni_vmovups(tmp2_vmm, G2);
+            uni_vmulps(tmp2_vmm, tmp2_vmm, G2);
+            uni_vmovups(tmp3_vmm, one);
+            uni_vsubps(tmp3_vmm, tmp3_vmm, tmp2_vmm);
+            uni_vmulps(tmp1_vmm, tmp1_vmm, tmp3_vmm);
+            bwd_store(gates_addr(reg_ws_gates, 2), tmp1_vmm, vector);
+            uni_vaddps(dG2_acc, dG2_acc, tmp1_vmm);
+
+            // dG0 = (h - G2) * dHt * G0 * (1 - G0)
+            uni_vsubps(h, h, G2);
+            uni_vmulps(h, h, dHt);
+            uni_vmovups(tmp1_vmm, one);
+            uni_vsubps(tmp1_vmm, tmp1_vmm, G0);
+            uni_vmulps(tmp1_vmm, tmp1_vmm, G0);
+            uni_vmulps(h, h, tmp1_vmm);
+            bwd_store(gates_addr(reg_ws_gates, 0), h, vector);
+            uni_vaddps(dG0_acc, dG0_acc, h);
+
+            // diff_states_t_l = dHt * G0
+            uni_vmulps(dHt, dHt, G0);
+            bwd_store(states_addr(reg_diff_t_l), dHt, vector);
+        });
+
+        postamble();
+
+        L(table_label);
+        {
+            for (size_t i = 0; i < vlen / sizeof(float); i++) dd(float2int(1.0f));
+        }
+    }
+};
+
 template struct jit_uni_gru_cell_postgemm_part1_fwd<sse42, data_type::f32>;
 template struct jit_uni_gru_cell_postgemm_part1_fwd<avx2, data_type::f32>;
 template struct jit_uni_gru_cell_postgemm_part1_fwd<avx512_core, data_type::f32>;
 
+template struct jit_uni_gru_cell_postgemm_part1_bwd<sse42>;
+template struct jit_uni_gru_cell_postgemm_part1_bwd<avx2>;
+template struct jit_uni_gru_cell_postgemm_part1_bwd<avx512_core>;
+
 }
 }
 }
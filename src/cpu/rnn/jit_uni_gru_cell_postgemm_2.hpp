@@ -188,10 +188,82 @@ protected:
 
 };
 
+template <cpu_isa_t isa>
+struct jit_uni_gru_cell_postgemm_part2_bwd: public jit_uni_rnn_postgemm
+{
+    DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_uni_gru_cell_postgemm_part2_bwd)
+
+    jit_uni_gru_cell_postgemm_part2_bwd(const rnn_utils::rnn_conf_t &rnn, const rnn_pd_t *pd)
+    : jit_uni_rnn_postgemm(rnn, pd){}
+
+    void init() override {
+        generate();
+        bwd_kernel_ = (bwd_kernel_t) this->getCode();
+    }
+
+protected:
+    // register size in bytes
+    using Vmm = typename jit_uni_eltwise_injector_f32<isa>::Vmm;
+    size_t vlen = cpu_isa_traits<isa>::vlen;
+
+    void generate() {
+        using namespace Xbyak;
+
+        Label table_label;
+
+        // Register map, Vmm(1) accumulates the bias gradient of G1.
+        // d(hG1) comes in diff_states_t_l_aux, which then receives hG1.
+        Vmm dG1_acc(1), one(2), G1(3), h(4), dhG1(5), tmp1_vmm(6),
+                tmp2_vmm(7);
+
+        preamble();
+        load_bwd_params();
+        mov(rax, table_label);
+        uni_vmovups(one, ptr[rax]);
+
+        bwd_loops<Vmm>(vlen, {1}, [&](bool vector) {
+            bwd_load(h, states_addr(reg_states_tm1), vector);
+            bwd_load(G1, gates_addr(reg_ws_gates, 1), vector);
+            bwd_load(dhG1, states_addr(reg_diff_t_l_aux), vector);
+
+            // diff_states_t_l += d(hG1) * G1
+            uni_vmovups(tmp1_vmm, dhG1);
+            uni_vmulps(tmp1_vmm, tmp1_vmm, G1);
+            bwd_load(tmp2_vmm, states_addr(reg_diff_t_l), vector);
+            uni_vaddps(tmp2_vmm, tmp2_vmm, tmp1_vmm);
+            bwd_store(states_addr(reg_diff_t_l), tmp2_vmm, vector);
+
+            // dG1 = d(hG1) * h * G1 * (1 - G1)
+            uni_vmovups(tmp1_vmm, one);
+            uni_vsubps(tmp1_vmm, tmp1_vmm, G1);
+            uni_vmulps(tmp1_vmm, tmp1_vmm, G1);
+            uni_vmulps(tmp1_vmm, tmp1_vmm, h);
+            uni_vmulps(tmp1_vmm, tmp1_vmm, dhG1);
+            bwd_store(gates_addr(reg_ws_gates, 1), tmp1_vmm, vector);
+            uni_vaddps(dG1_acc, dG1_acc, tmp1_vmm);
+
+            // hG1 = G1 * h, required for dWh
+            uni_vmulps(G1, G1, h);
+            bwd_store(states_addr(reg_diff_t_l_aux), G1, vector);
+        });
+
+        postamble();
+
+        L(table_label);
+        {
+            for (size_t i = 0; i < vlen / sizeof(float); i++) dd(float2int(1.0f));
+        }
+    }
+};
+
 template struct jit_uni_gru_cell_postgemm_part2_fwd<sse42, data_type::f32>;
 template struct jit_uni_gru_cell_postgemm_part2_fwd<avx2, data_type::f32>;
 template struct jit_uni_gru_cell_postgemm_part2_fwd<avx512_core, data_type::f32>;
 
+template struct jit_uni_gru_cell_postgemm_part2_bwd<sse42>;
+template struct jit_uni_gru_cell_postgemm_part2_bwd<avx2>;
+template struct jit_uni_gru_cell_postgemm_part2_bwd<avx512_core>;
+
 }
 }
 }
@@ -271,10 +271,114 @@ protected:
     }
 }; // namespace cpu
 
+template <cpu_isa_t isa>
+struct jit_uni_gru_lbr_cell_postgemm_bwd: public jit_uni_rnn_postgemm
+{
+    DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_uni_gru_lbr_cell_postgemm_bwd)
+
+    jit_uni_gru_lbr_cell_postgemm_bwd(const rnn_utils::rnn_conf_t &rnn, const rnn_pd_t *pd)
+    : jit_uni_rnn_postgemm(rnn, pd){}
+
+    void init() override {
+        generate();
+        bwd_kernel_ = (bwd_kernel_t) this->getCode();
+    }
+
+protected:
+    // register size in bytes
+    using Vmm = typename jit_uni_eltwise_injector_f32<isa>::Vmm;
+    size_t vlen = cpu_isa_traits<isa>::vlen;
+
+    void generate() {
+        using namespace Xbyak;
+
+        Label table_label;
+
+        // Register map, Vmm(1) to Vmm(4) accumulate the bias gradients: the
+        // three gates and the extra bias of Wh, which gets r * dG2.
+        // ws_cell (aux0) gets the gates for dWh, ws_grid (aux1) holds Wh*h+b.
+        Vmm one(5), G0(6), G1(7), G2(8), h(9), dHt(10), dG0(11), dG1(12),
+                dG2(13), tmp1_vmm(14);
+        auto dG_acc = [](int gate) { return Vmm(gate + 1); };
+
+        preamble();
+        load_bwd_params();
+        mov(rax, table_label);
+        uni_vmovups(one, ptr[rax]);
+
+        bwd_loops<Vmm>(vlen, {0, 1, 2, 3}, [&](bool vector) {
+            bwd_load(h, states_addr(reg_states_tm1), vector);
+            bwd_load(dHt, states_addr(reg_diff_tp1), vector);
+            bwd_load(tmp1_vmm, states_addr(reg_diff_t_lp1), vector);
+            uni_vaddps(dHt, dHt, tmp1_vmm);
+            bwd_load(G0, gates_addr(reg_ws_gates, 0), vector);
+            bwd_load(G1, gates_addr(reg_ws_gates, 1), vector);
+            bwd_load(G2, gates_addr(reg_ws_gates, 2), vector);
+
+            // dG0 = (h - G2) * dHt * G0 * (1 - G0)
+            uni_vmovups(dG0, h);
+            uni_vsubps(dG0, dG0, G2);
+            uni_vmulps(dG0, dG0, dHt);
+            uni_vmovups(tmp1_vmm, one);
+            uni_vsubps(tmp1_vmm, tmp1_vmm, G0);
+            uni_vmulps(tmp1_vmm, tmp1_vmm, G0);
+            uni_vmulps(dG0, dG0, tmp1_vmm);
+
+            // dG2 = (1 - G0) * (1 - G2^2) * dHt
+            uni_vmulps(G2, G2, G2);
+            uni_vmovups(tmp1_vmm, one);
+            uni_vsubps(tmp1_vmm, tmp1_vmm, G2);
+            uni_vmovups(dG2, one);
+            uni_vsubps(dG2, dG2, G0);
+            uni_vmulps(dG2, dG2, tmp1_vmm);
+            uni_vmulps(dG2, dG2, dHt);
+
+            // dG1 = Wh_b * dG2 * G1 * (1 - G1)
+            uni_vmovups(dG1, one);
+            uni_vsubps(dG1, dG1, G1);
+            uni_vmulps(dG1, dG1, G1);
+            uni_vmulps(dG1, dG1, dG2);
+            bwd_load(tmp1_vmm, grid_addr(reg_aux1), vector);
+            uni_vmulps(dG1, dG1, tmp1_vmm);
+
+            // diff_states_t_l = dHt * G0
+            uni_vmulps(dHt, dHt, G0);
+            bwd_store(states_addr(reg_diff_t_l), dHt, vector);
+
+            bwd_store(gates_addr(reg_ws_gates, 0), dG0, vector);
+            bwd_store(gates_addr(reg_aux0, 0), dG0, vector);
+            uni_vaddps(dG_acc(0), dG_acc(0), dG0);
+
+            bwd_store(gates_addr(reg_ws_gates, 1), dG1, vector);
+            bwd_store(gates_addr(reg_aux0, 1), dG1, vector);
+            uni_vaddps(dG_acc(1), dG_acc(1), dG1);
+
+            bwd_store(gates_addr(reg_ws_gates, 2), dG2, vector);
+            uni_vaddps(dG_acc(2), dG_acc(2), dG2);
+
+            // ws_cell gets r * dG2
+            uni_vmulps(G1, G1, dG2);
+            bwd_store(gates_addr(reg_aux0, 2), G1, vector);
+            uni_vaddps(dG_acc(3), dG_acc(3), G1);
+        });
+
+        postamble();
+
+        L(table_label);
+        {
+            for (size_t i = 0; i < vlen / sizeof(float); i++) dd(float2int(1.0f));
+        }
+    }
+};
+
 template struct jit_uni_gru_lbr_cell_postgemm_fwd<sse42, data_type::f32>;
 template struct jit_uni_gru_lbr_cell_postgemm_fwd<avx2, data_type::f32>;
 template struct jit_uni_gru_lbr_cell_postgemm_fwd<avx512_core, data_type::f32>;
 
+template struct jit_uni_gru_lbr_cell_postgemm_bwd<sse42>;
+template struct jit_uni_gru_lbr_cell_postgemm_bwd<avx2>;
+template struct jit_uni_gru_lbr_cell_postgemm_bwd<avx512_core>;
+
 }
 }
 }
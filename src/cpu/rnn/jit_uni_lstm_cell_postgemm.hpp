@@ -399,6 +399,137 @@ protected:
 
 };
 
+template <cpu_isa_t isa>
+struct jit_uni_lstm_cell_postgemm_bwd: public jit_uni_rnn_postgemm
+{
+    DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_uni_lstm_cell_postgemm_bwd)
+
+    typedef typename utils::conditional<isa == avx512_core,
+            jit_uni_eltwise_injector_f32<avx512_common>,
+            jit_uni_eltwise_injector_f32<isa>>::type injector_t;
+
+    jit_uni_lstm_cell_postgemm_bwd(const rnn_utils::rnn_conf_t &rnn, const rnn_pd_t *pd)
+    : jit_uni_rnn_postgemm(rnn, pd){}
+
+    ~jit_uni_lstm_cell_postgemm_bwd(){
+        delete tanh_injector_;
+    }
+
+    void init() override {
+        // rax is free once the parameters are loaded
+        tanh_injector_ = new injector_t(this,
+                alg_kind::eltwise_tanh, 0.0f, 0.0f, true, rax);
+        generate();
+        bwd_kernel_ = (bwd_kernel_t) this->getCode();
+    }
+
+protected:
+    injector_t *tanh_injector_;
+
+    // register size in bytes
+    using Vmm = typename jit_uni_eltwise_injector_f32<isa>::Vmm;
+    size_t vlen = cpu_isa_traits<isa>::vlen;
+
+    void generate() {
+        using namespace Xbyak;
+
+        Label table_label;
+
+        // Register map, Vmm(1) to Vmm(4) accumulate the bias gradients
+        Vmm one(5), G0(6), G1(7), G2(8), G3(9), tanhCt(10), dHt(11), dCt(12),
+                tmp1_vmm(13), tmp2_vmm(14);
+        auto dG_acc = [](int gate) { return Vmm(gate + 1); };
+
+        preamble();
+        load_bwd_params();
+        mov(rax, table_label);
+        uni_vmovups(one, ptr[rax]);
+        tanh_injector_->load_table_addr();
+
+        // v <- 1 - v
+        auto one_m = [&](Vmm v) {
+            uni_vmovups(tmp2_vmm, one);
+            uni_vsubps(tmp2_vmm, tmp2_vmm, v);
+            uni_vmovups(v, tmp2_vmm);
+        };
+        // dst <- x * (1 - x)
+        auto x_m_square = [&](Vmm dst, Vmm x) {
+            uni_vmovups(dst, one);
+            uni_vsubps(dst, dst, x);
+            uni_vmulps(dst, dst, x);
+        };
+
+        bwd_loops<Vmm>(vlen, {0, 1, 2, 3}, [&](bool vector) {
+            // tanh(Ct) is recomputed rather than saved in the workspace
+            bwd_load(tanhCt, states_addr(reg_aux0), vector);
+            tanh_injector_->compute_vector(tanhCt.getIdx());
+
+            // we have 2 incoming diffs on Ht
+            bwd_load(dHt, states_addr(reg_diff_tp1), vector);
+            bwd_load(tmp1_vmm, states_addr(reg_diff_t_lp1), vector);
+            uni_vaddps(dHt, dHt, tmp1_vmm);
+
+            bwd_load(G0, gates_addr(reg_ws_gates, 0), vector);
+            bwd_load(G1, gates_addr(reg_ws_gates, 1), vector);
+            bwd_load(G2, gates_addr(reg_ws_gates, 2), vector);
+            bwd_load(G3, gates_addr(reg_ws_gates, 3), vector);
+
+            // dCt = diff_states_tp1_l_c + (1 - tanhCt^2) * G3 * dHt
+            uni_vmovups(dCt, tanhCt);
+            uni_vmulps(dCt, dCt, tanhCt);
+            one_m(dCt);
+            uni_vmulps(dCt, dCt, G3);
+            uni_vmulps(dCt, dCt, dHt);
+            bwd_load(tmp1_vmm, states_addr(reg_diff_tp1_c), vector);
+            uni_vaddps(dCt, dCt, tmp1_vmm);
+
+            // diff_states_t_l_c = dCt * G1
+            uni_vmovups(tmp1_vmm, dCt);
+            uni_vmulps(tmp1_vmm, tmp1_vmm, G1);
+            bwd_store(states_addr(reg_diff_t_l_aux), tmp1_vmm, vector);
+
+            // dG1 = c_states_tm1_l * dCt * G1 * (1 - G1)
+            x_m_square(tmp1_vmm, G1);
+            bwd_load(tmp2_vmm, states_addr(reg_aux1), vector);
+            uni_vmulps(tmp1_vmm, tmp1_vmm, tmp2_vmm);
+            uni_vmulps(tmp1_vmm, tmp1_vmm, dCt);
+            bwd_store(gates_addr(reg_ws_gates, 1), tmp1_vmm, vector);
+            uni_vaddps(dG_acc(1), dG_acc(1), tmp1_vmm);
+
+            // dG0 = G2 * dCt * G0 * (1 - G0)
+            x_m_square(tmp1_vmm, G0);
+            uni_vmulps(tmp1_vmm, tmp1_vmm, G2);
+            uni_vmulps(tmp1_vmm, tmp1_vmm, dCt);
+            bwd_store(gates_addr(reg_ws_gates, 0), tmp1_vmm, vector);
+            uni_vaddps(dG_acc(0), dG_acc(0), tmp1_vmm);
+
+            // dG3 = tanhCt * dHt * G3 * (1 - G3)
+            x_m_square(tmp1_vmm, G3);
+            uni_vmulps(tmp1_vmm, tmp1_vmm, tanhCt);
+            uni_vmulps(tmp1_vmm, tmp1_vmm, dHt);
+            bwd_store(gates_addr(reg_ws_gates, 3), tmp1_vmm, vector);
+            uni_vaddps(dG_acc(3), dG_acc(3), tmp1_vmm);
+
+            // dG2 = G0 * dCt * (1 - G2^2)
+            uni_vmulps(G2, G2, G2);
+            one_m(G2);
+            uni_vmulps(G2, G2, G0);
+            uni_vmulps(G2, G2, dCt);
+            bwd_store(gates_addr(reg_ws_gates, 2), G2, vector);
+            uni_vaddps(dG_acc(2), dG_acc(2), G2);
+        });
+
+        postamble();
+
+        tanh_injector_->prepare_table();
+
+        L(table_label);
+        {
+            for (size_t i = 0; i < vlen / sizeof(float); i++) dd(float2int(1.0f));
+        }
+    }
+};
+
 template struct jit_uni_lstm_cell_postgemm_fwd<sse42, data_type::f32>;
 template struct jit_uni_lstm_cell_postgemm_fwd<avx2, data_type::f32>;
 template struct jit_uni_lstm_cell_postgemm_fwd<avx512_core, data_type::f32>;
@@ -407,6 +538,10 @@ template struct jit_uni_lstm_cell_postgemm_fwd<sse42, data_type::u8>;
 template struct jit_uni_lstm_cell_postgemm_fwd<avx2, data_type::u8>;
 template struct jit_uni_lstm_cell_postgemm_fwd<avx512_core, data_type::u8>;
 
+template struct jit_uni_lstm_cell_postgemm_bwd<sse42>;
+template struct jit_uni_lstm_cell_postgemm_bwd<avx2>;
+template struct jit_uni_lstm_cell_postgemm_bwd<avx512_core>;
+
 }
 }
 }
@@ -292,6 +292,74 @@ protected:
 
 };
 
+template <cpu_isa_t isa>
+struct jit_uni_rnn_cell_postgemm_bwd: public jit_uni_rnn_postgemm
+{
+    DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_uni_rnn_cell_postgemm_bwd)
+
+    jit_uni_rnn_cell_postgemm_bwd(const rnn_utils::rnn_conf_t &rnn, const rnn_pd_t *pd)
+    : jit_uni_rnn_postgemm(rnn, pd){}
+
+    void init() override {
+        generate();
+        bwd_kernel_ = (bwd_kernel_t) this->getCode();
+    }
+
+protected:
+    // register size in bytes
+    using Vmm = typename jit_uni_eltwise_injector_f32<isa>::Vmm;
+    size_t vlen = cpu_isa_traits<isa>::vlen;
+
+    void generate() {
+        using namespace Xbyak;
+
+        Label table_label;
+
+        // Register map, Vmm(1) accumulates the bias gradient
+        Vmm dG_acc(1), one(2), G(3), dH(4), tmp1_vmm(5);
+
+        // The derivative of the activation is computed from its output
+        // G; relu is left to the reference path
+        assert(utils::one_of(pd_->activation_kind(), alg_kind::eltwise_tanh,
+                alg_kind::eltwise_logistic));
+
+        preamble();
+        load_bwd_params();
+        mov(rax, table_label);
+        uni_vmovups(one, ptr[rax]);
+
+        bwd_loops<Vmm>(vlen, {0}, [&](bool vector) {
+            // dH = diff_states_t_lp1 + diff_states_tp1_l
+            bwd_load(dH, states_addr(reg_diff_t_lp1), vector);
+            bwd_load(tmp1_vmm, states_addr(reg_diff_tp1), vector);
+            uni_vaddps(dH, dH, tmp1_vmm);
+
+            bwd_load(G, gates_addr(reg_ws_gates, 0), vector);
+            uni_vmovups(tmp1_vmm, one);
+            if (pd_->activation_kind() == alg_kind::eltwise_tanh) {
+                // dG = dH * (1 - G^2)
+                uni_vmulps(G, G, G);
+                uni_vsubps(tmp1_vmm, tmp1_vmm, G);
+            } else {
+                // dG = dH * G * (1 - G)
+                uni_vsubps(tmp1_vmm, tmp1_vmm, G);
+                uni_vmulps(tmp1_vmm, tmp1_vmm, G);
+            }
+            uni_vmulps(dH, dH, tmp1_vmm);
+
+            bwd_store(gates_addr(reg_ws_gates, 0), dH, vector);
+            uni_vaddps(dG_acc, dG_acc, dH);
+        });
+
+        postamble();
+
+        L(table_label);
+        {
+            for (size_t i = 0; i < vlen / sizeof(float); i++) dd(float2int(1.0f));
+        }
+    }
+};
+
 template struct jit_uni_rnn_cell_postgemm_fwd<sse42, data_type::f32>;
 template struct jit_uni_rnn_cell_postgemm_fwd<avx2, data_type::f32>;
 template struct jit_uni_rnn_cell_postgemm_fwd<avx512_core, data_type::f32>;
@@ -300,6 +368,10 @@ template struct jit_uni_rnn_cell_postgemm_fwd<sse42, data_type::u8>;
 template struct jit_uni_rnn_cell_postgemm_fwd<avx2, data_type::u8>;
 template struct jit_uni_rnn_cell_postgemm_fwd<avx512_core, data_type::u8>;
 
+template struct jit_uni_rnn_cell_postgemm_bwd<sse42>;
+template struct jit_uni_rnn_cell_postgemm_bwd<avx2>;
+template struct jit_uni_rnn_cell_postgemm_bwd<avx512_core>;
+
 }
 }
 }
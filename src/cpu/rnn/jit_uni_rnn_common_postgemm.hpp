@@ -18,6 +18,9 @@
 #define CPU_JIT_RNN_POSTGEMM
 
 
+#include <stddef.h>
+#include <vector>
+
 #include "rnn_utils.hpp"
 #include "../jit_generator.hpp"
 #include "../jit_uni_eltwise.hpp"
@@ -35,6 +38,25 @@ struct jit_uni_rnn_postgemm : public jit_generator {
     typedef void (*kernel_t)(void *param1_, const void *param2_, void *param3_,
             void *param4_, void *param5_, void *param6_);
 
+    /* The backward kernels run over a block of columns of all the rows of
+     * the batch, so that the gradients of the gates are also reduced into
+     * diff_bias. The pointers are at the first column of the block, which
+     * is len bytes wide. */
+    struct bwd_call_params_t {
+        float *ws_gates;
+        float *states_tm1_l;
+        float *aux0; // c_states_t_l (LSTM), ws_cell (GRU LBR)
+        float *aux1; // c_states_tm1_l (LSTM), ws_grid (GRU LBR)
+        float *diff_states_t_l;
+        float *diff_states_t_l_aux; // c state (LSTM), d(hG1) (GRU part 2)
+        float *diff_states_tp1_l;
+        float *diff_states_tp1_l_c;
+        float *diff_states_t_lp1;
+        float *diff_bias;
+        size_t len;
+    };
+    typedef void (*bwd_kernel_t)(const bwd_call_params_t *params);
+
     jit_uni_rnn_postgemm(const rnn_utils::rnn_conf_t &rnn, const rnn_pd_t *pd): rnn_(rnn), pd_(pd){}
 
     virtual void init() = 0;
@@ -84,10 +106,201 @@ template <typename src_data_t, typename acc_data_t>
         });
     }
 
+template <typename src_data_t, typename acc_data_t>
+    rnn_postgemm_sig(execute_bwd) {
+        rnn_utils::ws_gates_aoc<acc_data_t> ws_gates(rnn, ws_gates_);
+        rnn_utils::ws_states_aoc<src_data_t> states_tm1_l(rnn, states_tm1_l_);
+        rnn_utils::ws_states_aoc_t c_states_t_l(rnn, c_states_t_l_);
+        rnn_utils::ws_states_aoc_t c_states_tm1_l(rnn, c_states_tm1_l_);
+        rnn_utils::ws_diff_states_aoc_t diff_states_t_l(rnn, diff_states_t_l_);
+        rnn_utils::ws_diff_states_aoc_t diff_states_tp1_l(
+                rnn, diff_states_tp1_l_);
+        rnn_utils::ws_diff_states_aoc_t diff_states_t_lp1(
+                rnn, diff_states_t_lp1_);
+        rnn_utils::ws_gates_aoc<acc_data_t> ws_gemm(rnn, ws_cell_);
+        utils::array_offset_calculator<float, 2> ws_Wh_b(
+                ws_grid_, rnn.mb, rnn.dic);
+
+        // Blocks are a multiple of the widest vector so that only the last
+        // one has a tail
+        const int block = 16;
+        const int nb = utils::div_up(rnn.dic, block);
+        parallel(0, [&](const int ithr, const int nthr) {
+            int start{0}, end{0};
+            balance211(nb, nthr, ithr, start, end);
+            const int j = start * block;
+            const int j_end = nstl::min(end * block, rnn.dic);
+            if (j >= j_end) return;
+
+            bwd_call_params_t p;
+            p.ws_gates = (float *)&ws_gates(0, 0, j);
+            p.states_tm1_l = (float *)&states_tm1_l(0, j);
+            p.aux0 = nullptr;
+            p.aux1 = nullptr;
+            p.diff_states_t_l = &diff_states_t_l(0, 0, j);
+            p.diff_states_t_l_aux = nullptr;
+            p.diff_states_tp1_l = &diff_states_tp1_l(0, 0, j);
+            p.diff_states_tp1_l_c = nullptr;
+            p.diff_states_t_lp1 = &diff_states_t_lp1(rnn.n_states, 0, j);
+            p.diff_bias = diff_bias_ + j;
+            p.len = (j_end - j) * sizeof(float);
+            switch (pd_->cell_kind()) {
+            case alg_kind::vanilla_lstm:
+                p.aux0 = &c_states_t_l(0, j);
+                p.aux1 = &c_states_tm1_l(0, j);
+                p.diff_states_t_l_aux = &diff_states_t_l(1, 0, j);
+                p.diff_states_tp1_l_c = &diff_states_tp1_l(1, 0, j);
+                break;
+            case alg_kind::gru_linear_before_reset:
+                p.aux0 = (float *)&ws_gemm(0, 0, j);
+                p.aux1 = &ws_Wh_b(0, j);
+                break;
+            case alg_kind::vanilla_gru:
+                p.diff_states_t_l_aux = &diff_states_t_l(rnn.n_states, 0, j);
+                break;
+            default: break;
+            }
+            bwd_kernel_(&p);
+        });
+    }
+
 protected:
     kernel_t kernel_;
+    bwd_kernel_t bwd_kernel_;
     const rnn_utils::rnn_conf_t &rnn_;
     const rnn_pd_t *pd_;
+
+    // Helpers for the backward kernels. The pointers move along the
+    // columns of the block and the offsets along the rows; rax is left for
+    // the constant tables.
+    Xbyak::Reg64 reg_ws_gates = r8;
+    Xbyak::Reg64 reg_states_tm1 = r9;
+    Xbyak::Reg64 reg_aux0 = r10;
+    Xbyak::Reg64 reg_aux1 = rbx;
+    Xbyak::Reg64 reg_diff_t_l = rdx;
+    Xbyak::Reg64 reg_diff_t_l_aux = rsi;
+    Xbyak::Reg64 reg_diff_tp1 = rcx;
+    Xbyak::Reg64 reg_diff_tp1_c = rbp;
+    Xbyak::Reg64 reg_diff_t_lp1 = rdi;
+    Xbyak::Reg64 reg_diff_bias = r11;
+    Xbyak::Reg64 reg_len = r12;
+    Xbyak::Reg64 reg_gates_off = r13; // ws_gates and ws_cell rows
+    Xbyak::Reg64 reg_states_off = r14; // states and diff states rows
+    Xbyak::Reg64 reg_grid_off = r15; // ws_grid rows
+
+    Xbyak::Address gates_addr(const Xbyak::Reg64 &base, int gate) {
+        return ptr[base + reg_gates_off + gate * rnn_.dic * sizeof(float)];
+    }
+    Xbyak::Address states_addr(const Xbyak::Reg64 &base) {
+        return ptr[base + reg_states_off];
+    }
+    Xbyak::Address grid_addr(const Xbyak::Reg64 &base) {
+        return ptr[base + reg_grid_off];
+    }
+
+    template <typename Vmm>
+    void bwd_load(const Vmm &v, const Xbyak::Address &addr, bool vector) {
+        if (vector)
+            uni_vmovups(v, addr);
+        else
+            uni_vmovss(v, addr);
+    }
+    template <typename Vmm>
+    void bwd_store(const Xbyak::Address &addr, const Vmm &v, bool vector) {
+        if (vector)
+            uni_vmovups(addr, v);
+        else
+            uni_vmovss(addr, v);
+    }
+
+    // Loads the pointers passed in bwd_call_params_t, clobbers rax
+    void load_bwd_params() {
+#define GET_OFF(field) offsetof(bwd_call_params_t, field)
+        mov(rax, abi_param1);
+        mov(reg_ws_gates, ptr[rax + GET_OFF(ws_gates)]);
+        mov(reg_states_tm1, ptr[rax + GET_OFF(states_tm1_l)]);
+        mov(reg_aux0, ptr[rax + GET_OFF(aux0)]);
+        mov(reg_aux1, ptr[rax + GET_OFF(aux1)]);
+        mov(reg_diff_t_l, ptr[rax + GET_OFF(diff_states_t_l)]);
+        mov(reg_diff_t_l_aux, ptr[rax + GET_OFF(diff_states_t_l_aux)]);
+        mov(reg_diff_tp1, ptr[rax + GET_OFF(diff_states_tp1_l)]);
+        mov(reg_diff_tp1_c, ptr[rax + GET_OFF(diff_states_tp1_l_c)]);
+        mov(reg_diff_t_lp1, ptr[rax + GET_OFF(diff_states_t_lp1)]);
+        mov(reg_diff_bias, ptr[rax + GET_OFF(diff_bias)]);
+        mov(reg_len, ptr[rax + GET_OFF(len)]);
+#undef GET_OFF
+    }
+
+    // Emits the loops over the block: by vectors of vlen bytes, then by
+    // single elements for the tail. compute(vector) is emitted for a row
+    // and accumulates the gradient of gate acc_gates[k] into Vmm(k + 1);
+    // the accumulators are added to diff_bias once all the rows are done,
+    // using Vmm(15) as temporary.
+    template <typename Vmm, typename F>
+    void bwd_loops(size_t vlen, const std::vector<int> &acc_gates,
+            F compute) {
+        using namespace Xbyak;
+
+        Label vector_loop_start_label, vector_loop_end_label;
+        Label rem_loop_start_label, rem_loop_end_label;
+        const int n_acc = (int)acc_gates.size();
+        const size_t dt_size = sizeof(float);
+
+        auto rows = [&](bool vector) {
+            Label row_loop_label;
+            for (int k = 0; k < n_acc; k++)
+                uni_vpxor(Vmm(k + 1), Vmm(k + 1), Vmm(k + 1));
+            xor_(reg_gates_off, reg_gates_off);
+            xor_(reg_states_off, reg_states_off);
+            xor_(reg_grid_off, reg_grid_off);
+            L(row_loop_label);
+            {
+                compute(vector);
+                add(reg_gates_off, rnn_.gates_ws_ld * dt_size);
+                add(reg_states_off, rnn_.states_ws_ld * dt_size);
+                add(reg_grid_off, rnn_.dic * dt_size);
+                cmp(reg_grid_off, rnn_.mb * rnn_.dic * dt_size);
+                jl(row_loop_label, T_NEAR);
+            }
+
+            Vmm tmp(15);
+            for (int k = 0; k < n_acc; k++) {
+                auto addr = ptr[reg_diff_bias
+                        + acc_gates[k] * rnn_.dic * dt_size];
+                bwd_load(tmp, addr, vector);
+                uni_vaddps(tmp, tmp, Vmm(k + 1));
+                bwd_store(addr, tmp, vector);
+            }
+
+            const size_t step = vector ? vlen : dt_size;
+            for (const auto &reg : {reg_ws_gates, reg_states_tm1, reg_aux0,
+                         reg_aux1, reg_diff_t_l, reg_diff_t_l_aux,
+                         reg_diff_tp1, reg_diff_tp1_c, reg_diff_t_lp1,
+                         reg_diff_bias})
+                add(reg, step);
+            sub(reg_len, step);
+        };
+
+        cmp(reg_len, vlen);
+        jl(vector_loop_end_label, T_NEAR);
+        L(vector_loop_start_label);
+        {
+            rows(true);
+            cmp(reg_len, vlen);
+            jge(vector_loop_start_label, T_NEAR);
+        }
+        L(vector_loop_end_label);
+
+        cmp(reg_len, 0);
+        je(rem_loop_end_label, T_NEAR);
+        L(rem_loop_start_label);
+        {
+            rows(false);
+            cmp(reg_len, 0);
+            jg(rem_loop_start_label, T_NEAR);
+        }
+        L(rem_loop_end_label);
+    }
 };
 
 
@@ -51,6 +51,9 @@ struct rnn_postgemm_dispatcher {
 
         bool jit_path = utils::one_of(pd->desc()->prop_kind,
                 prop_kind::forward_inference, prop_kind::forward_training);
+        // the backward kernels also reduce the gates into diff_bias
+        jit_bwd_path_ = pd->desc()->prop_kind == prop_kind::backward
+                && src_type == data_type::f32;
 
         switch (pd->cell_kind()) {
         case alg_kind::vanilla_lstm:
@@ -68,6 +71,16 @@ struct rnn_postgemm_dispatcher {
                     rnn_postgemm_ =
                         new jit_uni_lstm_cell_postgemm_fwd<sse42, src_type>(
                             rnn, pd);
+            } else if (jit_bwd_path_) {
+                if (mayiuse(avx512_core))
+                    rnn_postgemm_ =
+                        new jit_uni_lstm_cell_postgemm_bwd<avx512_core>(rnn, pd);
+                else if (mayiuse(avx2))
+                    rnn_postgemm_ =
+                        new jit_uni_lstm_cell_postgemm_bwd<avx2>(rnn, pd);
+                else if (mayiuse(sse42))
+                    rnn_postgemm_ =
+                        new jit_uni_lstm_cell_postgemm_bwd<sse42>(rnn, pd);
             }
             if (rnn_postgemm_)
                 rnn_postgemm_->init();
@@ -88,6 +101,20 @@ struct rnn_postgemm_dispatcher {
                 rnn_postgemm_
                         = new jit_uni_rnn_cell_postgemm_fwd<sse42, src_type>(
                                 rnn, pd);
+        } else if (jit_bwd_path_
+                && pd->activation_kind() != alg_kind::eltwise_relu) {
+            // relu backward needs the sign of the output and stays on the
+            // reference path
+            if (mayiuse(avx512_core))
+                rnn_postgemm_
+                        = new jit_uni_rnn_cell_postgemm_bwd<avx512_core>(
+                                rnn, pd);
+            else if (mayiuse(avx2))
+                rnn_postgemm_
+                        = new jit_uni_rnn_cell_postgemm_bwd<avx2>(rnn, pd);
+            else if (mayiuse(sse42))
+                rnn_postgemm_
+                        = new jit_uni_rnn_cell_postgemm_bwd<sse42>(rnn, pd);
         }
             if (rnn_postgemm_)
                 rnn_postgemm_->init();
@@ -131,6 +158,25 @@ struct rnn_postgemm_dispatcher {
                         = new jit_uni_gru_cell_postgemm_part2_fwd<sse42,
                                 src_type>(rnn, pd);
             }
+        } else if (jit_bwd_path_) {
+            if (mayiuse(avx512_core)) {
+                rnn_postgemm_
+                        = new jit_uni_gru_cell_postgemm_part1_bwd<avx512_core>(
+                                rnn, pd);
+                rnn_postgemm_part2_
+                        = new jit_uni_gru_cell_postgemm_part2_bwd<avx512_core>(
+                                rnn, pd);
+            } else if (mayiuse(avx2)) {
+                rnn_postgemm_
+                        = new jit_uni_gru_cell_postgemm_part1_bwd<avx2>(rnn, pd);
+                rnn_postgemm_part2_
+                        = new jit_uni_gru_cell_postgemm_part2_bwd<avx2>(rnn, pd);
+            } else if (mayiuse(sse42)) {
+                rnn_postgemm_
+                        = new jit_uni_gru_cell_postgemm_part1_bwd<sse42>(rnn, pd);
+                rnn_postgemm_part2_
+                        = new jit_uni_gru_cell_postgemm_part2_bwd<sse42>(rnn, pd);
+            }
         }
             if (rnn_postgemm_ && rnn_postgemm_part2_) {
                 rnn_postgemm_->init();
@@ -158,14 +204,32 @@ struct rnn_postgemm_dispatcher {
                             rnn, pd);
                 assert(rnn_postgemm_ != nullptr);
                 rnn_postgemm_->init();
+            } else if (jit_bwd_path_) {
+                if (mayiuse(avx512_core))
+                    rnn_postgemm_ =
+                        new jit_uni_gru_lbr_cell_postgemm_bwd<avx512_core>(
+                            rnn, pd);
+                else if (mayiuse(avx2))
+                    rnn_postgemm_ =
+                        new jit_uni_gru_lbr_cell_postgemm_bwd<avx2>(rnn, pd);
+                else if (mayiuse(sse42))
+                    rnn_postgemm_ =
+                        new jit_uni_gru_lbr_cell_postgemm_bwd<sse42>(rnn, pd);
+                if (rnn_postgemm_)
+                    rnn_postgemm_->init();
             }
             break;
         default:
             assert(!"Unsupported algorithm kind");
             break;
         }
+
+        if (rnn_postgemm_ == nullptr)
+            jit_bwd_path_ = false;
     }
 
+    bool bias_reduction_fused() const { return jit_bwd_path_; }
+
     ~rnn_postgemm_dispatcher(){
         delete rnn_postgemm_;
         delete rnn_postgemm_part2_;
@@ -173,30 +237,40 @@ struct rnn_postgemm_dispatcher {
 
 // template <typename src_data_t, typename acc_data_t>
     rnn_postgemm_sig(execute) {
-    if (rnn_postgemm_)
+    if (rnn_postgemm_ && jit_bwd_path_)
+        rnn_postgemm_->execute_bwd(rnn, ws_gates_, states_t_l_, c_states_t_l_,
+                states_tm1_l_, c_states_tm1_l_, diff_states_t_l_,
+                diff_states_t_lp1_, diff_states_tp1_l_, bias_, ws_grid_,
+                ws_cell_, diff_bias_);
+    else if (rnn_postgemm_)
         rnn_postgemm_->execute(rnn, ws_gates_, states_t_l_, c_states_t_l_,
                 states_tm1_l_, c_states_tm1_l_, diff_states_t_l_,
                 diff_states_t_lp1_, diff_states_tp1_l_, bias_, ws_grid_,
-                ws_cell_);
+                ws_cell_, diff_bias_);
     else
         (this->*postgemm_func)(rnn, ws_gates_, states_t_l_, c_states_t_l_,
                 states_tm1_l_, c_states_tm1_l_, diff_states_t_l_,
                 diff_states_t_lp1_, diff_states_tp1_l_, bias_, ws_grid_,
-                ws_cell_);
+                ws_cell_, diff_bias_);
 }
 
 // template <typename src_data_t, typename acc_data_t>
     rnn_postgemm_sig(execute_part2) {
-    if(rnn_postgemm_part2_)
+    if (rnn_postgemm_part2_ && jit_bwd_path_)
+        rnn_postgemm_part2_->execute_bwd(rnn, ws_gates_, states_t_l_,
+                c_states_t_l_, states_tm1_l_, c_states_tm1_l_,
+                diff_states_t_l_, diff_states_t_lp1_, diff_states_tp1_l_,
+                bias_, ws_grid_, ws_cell_, diff_bias_);
+    else if(rnn_postgemm_part2_)
         rnn_postgemm_part2_->execute(rnn, ws_gates_, states_t_l_, c_states_t_l_,
                 states_tm1_l_, c_states_tm1_l_, diff_states_t_l_,
                 diff_states_t_lp1_, diff_states_tp1_l_, bias_, ws_grid_,
-                ws_cell_);
+                ws_cell_, diff_bias_);
     else
         (this->*postgemm_part2_func)(rnn, ws_gates_, states_t_l_, c_states_t_l_,
                 states_tm1_l_, c_states_tm1_l_, diff_states_t_l_,
                 diff_states_t_lp1_, diff_states_tp1_l_, bias_, ws_grid_,
-                ws_cell_);
+                ws_cell_, diff_bias_);
 }
 
 
@@ -210,6 +284,7 @@ private:
     rnn_postgemm_sig(gru_lbr_postgemm);
 
     const rnn_pd_t *pd_;
+    bool jit_bwd_path_;
     jit_uni_rnn_postgemm *rnn_postgemm_;
     jit_uni_rnn_postgemm *rnn_postgemm_part2_;
     postgemm_f postgemm_func;
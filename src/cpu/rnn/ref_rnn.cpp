@@ -29,6 +29,10 @@
 
  */
 
+#include <atomic>
+#include <thread>
+#include <vector>
+
 #include "math_utils.hpp"
 #include "mkldnn_thread.hpp"
 
@@ -225,6 +229,107 @@ rnn_grid_execution_sig(
     }
 }
 
+//************* Grid computations strategy: wavefront **************//
+/* The cells of a (direction, layer) chain run in order, and cell i of a
+ * chain needs cell i of the chain of the previous layer. Every thread
+ * claims the next cell of any chain that is ready, so the cells of a
+ * diagonal of the grid and of both directions run concurrently, each with
+ * the sequential gemms of a nested parallel region. The state of a chain is
+ * an atomic counter: twice the number of cells done, plus one while a cell
+ * runs. A thread only waits for cells that are running, so the schedule
+ * does not depend on the threads of the team running concurrently. */
+template <prop_kind_t aprop, data_type_t src_type, data_type_t weights_type>
+rnn_grid_execution_sig((_ref_rnn_common_t<aprop, src_type,
+        weights_type>::wavefront_execution)) {
+    assert(!rnn.merge_gemm_layer && !rnn.merge_gemm_iter);
+
+    AOC<src_data_t, 4> ws_states(ws_states_, rnn.n_layer + 1, rnn.n_dir,
+            rnn.n_iter + 1, rnn.states_nld * rnn.states_ws_ld);
+    AOC<float, 4> ws_c_states(ws_c_states_, rnn.n_layer + 1, rnn.n_dir,
+            rnn.n_iter + 1, rnn.states_nld * rnn.states_ws_ld);
+    AOC<float, 5> ws_diff_states(ws_diff_states_, rnn.n_layer + 1, rnn.n_dir,
+            (rnn.n_states + 1), rnn.n_iter + 1,
+            rnn.states_nld * rnn.states_ws_ld);
+    AOC<acc_data_t, 4> ws_gates(ws_gates_, rnn.n_layer, rnn.n_dir, rnn.n_iter,
+            rnn.gates_nld * rnn.gates_ws_ld);
+    AOC<weights_data_t *, 3> weights_input(
+            weights_layer_, rnn.n_layer, rnn.n_dir, rnn.n_parts_weights_layer);
+    AOC<weights_data_t *, 3> weights_states(
+            weights_states_, rnn.n_layer, rnn.n_dir, rnn.n_parts_weights_iter);
+    AOC<float*, 3> bias(
+        bias_, rnn.n_layer, rnn.n_dir, rnn.n_parts_bias);
+    AOC<float, 3> diff_weights_layer(diff_weights_layer_, rnn.n_layer,
+            rnn.n_dir,
+            rnn.diff_weights_layer_nld * rnn.diff_weights_layer_ld);
+    AOC<float, 3> diff_weights_iter(diff_weights_iter_, rnn.n_layer, rnn.n_dir,
+            rnn.diff_weights_iter_nld * rnn.diff_weights_iter_ld);
+    AOC<float, 3> diff_bias(
+            diff_bias_, rnn.n_layer, rnn.n_dir, rnn.n_bias * rnn.dic);
+    AOC<float, 4> ws_grid(
+            ws_grid_, rnn.n_layer, rnn.n_dir, rnn.n_iter, (int)rnn.ws_per_cell);
+
+    auto cell = [&](int dir, int j, int i) {
+        int lay = (aprop == prop_kind::forward) ? j : rnn.n_layer - j - 1;
+        int iter = (aprop == prop_kind::forward) ? i : rnn.n_iter - i - 1;
+        // gru lbr cells have a buffer per chain, see set_conf()
+        acc_data_t *ws_cell = rnn.is_lbr
+            ? ws_cell_ + (size_t)(lay * rnn.n_dir + dir) * rnn.gates_nld
+                    * rnn.gates_ws_ld
+            : ws_cell_;
+        (this->*cell_func)(rnn,
+                &(ws_states(lay + 1, dir, iter + 1, 0)),
+                &(ws_c_states(lay + 1, dir, iter + 1, 0)),
+                &(ws_diff_states(lay, dir, 0, iter, 0)),
+                &(weights_input(lay, dir, 0)),
+                &(weights_states(lay, dir, 0)),
+                &(bias(lay, dir, 0)),
+                &(ws_states(lay, dir, iter + 1, 0)),
+                &(ws_states(lay + 1, dir, iter, 0)),
+                &(ws_c_states(lay + 1, dir, iter, 0)),
+                &(ws_diff_states(lay + 1, dir, 0, iter, 0)),
+                &(ws_diff_states(lay, dir, 0, iter + 1, 0)),
+                &(diff_weights_layer(lay, dir, 0)),
+                &(diff_weights_iter(lay, dir, 0)),
+                &(diff_bias(lay, dir, 0)),
+                &(ws_gates(lay, dir, iter, 0)),
+                &(ws_grid(lay, dir, iter, 0)),
+                ws_cell);
+    };
+
+    // chain c = dir * n_layer + j runs the j-th layer in execution order
+    const int n_chains = rnn.n_dir * rnn.n_layer;
+    std::vector<std::atomic<int>> state(n_chains);
+    for (auto &s: state)
+        s.store(0, std::memory_order_relaxed);
+    std::atomic<int> cells_left(n_chains * rnn.n_iter);
+
+    const int nthr = nstl::min(mkldnn_get_max_threads(), n_chains);
+    parallel(nthr, [&](const int ithr, const int) {
+        while (cells_left.load(std::memory_order_relaxed) > 0) {
+            bool ran = false;
+            // start from a chain of its own to keep the weights in cache
+            for (int k = 0; k < n_chains; k++) {
+                const int c = (ithr + k) % n_chains;
+                const int j = c % rnn.n_layer;
+                int s = state[c].load(std::memory_order_acquire);
+                const int i = s / 2;
+                if (s % 2 == 1 || i == rnn.n_iter) continue;
+                if (j > 0 && state[c - 1].load(std::memory_order_acquire) / 2
+                        <= i)
+                    continue;
+                if (!state[c].compare_exchange_strong(s, s + 1,
+                            std::memory_order_acquire))
+                    continue;
+                cell(c / rnn.n_layer, j, i);
+                state[c].store(2 * (i + 1), std::memory_order_release);
+                cells_left.fetch_sub(1, std::memory_order_relaxed);
+                ran = true;
+            }
+            if (!ran) std::this_thread::yield();
+        }
+    });
+}
+
 //********* GRID computations strategy: utility functions **********//
 
 template <prop_kind_t aprop, data_type_t src_type, data_type_t weights_type>
@@ -211,7 +211,9 @@ struct _ref_rnn_common_t : public cpu_primitive_t {
         default: break;
         }
 
-        grid_computation = &class_name::linear_execution;
+        grid_computation = pd()->rnn_.use_wavefront
+            ? &class_name::wavefront_execution
+            : &class_name::linear_execution;
 
         size_t scratchpad_size, workspace_size;
         rnn_utils::set_offsets(pd()->rnn_, ws_gates_offset_, ws_states_offset_,
@@ -234,6 +236,7 @@ struct _ref_rnn_common_t : public cpu_primitive_t {
 private:
     void execute_() const;
     rnn_grid_execution_sig(linear_execution);
+    rnn_grid_execution_sig(wavefront_execution);
     rnn_cell_execution_sig(cell_execution);
     rnn_cell_execution_sig(cell_execution_gru);
     rnn_cell_execution_sig(cell_execution_gru_lbr);
@@ -105,6 +105,28 @@ void rnn_utils::init_conf(rnn_conf_t &rnn, const rnn_desc_t &rd,
     bool is_gru = utils::one_of(rd.cell_desc.cell_kind, alg_kind::vanilla_gru,
             alg_kind::gru_linear_before_reset);
     rnn.merge_gemm_iter = !(rnn.is_fwd || is_gru) || is_int8;
+
+    /* Decide to run the grid as a wavefront: cell (l, t) only depends on
+     * cells (l - 1, t) and (l, t - 1), so the cells of a diagonal of the grid
+     * and the two directions can run concurrently, one per thread, each with
+     * sequential gemms. This pays off when a cell is too small to keep all
+     * the threads busy, and needs every cell to do its own gemms. The team
+     * is capped at n_chains, so a cell whose gemms give every thread of the
+     * team at least ~1 MFLOP keeps the parallel gemms instead */
+    const int n_chains = rnn.n_layer * rnn.n_dir;
+    const int nthr = mkldnn_get_max_threads();
+    const size_t cell_flops = (size_t)2 * rnn.n_gates * rnn.dic * rnn.mb
+            * (rnn.slc + rnn.sic);
+    const size_t min_thr_flops = (size_t)1 << 20;
+    rnn.use_wavefront = !is_int8 && rnn.mb <= 32 && n_chains > 1 && nthr > 1
+            && nthr <= 4 * n_chains
+            && cell_flops < (size_t)nthr * min_thr_flops;
+#if MKLDNN_THR == MKLDNN_THR_TBB
+    /* the nested parallel regions of a cell may steal a waiting thread */
+    rnn.use_wavefront = false;
+#endif
+    if (rnn.use_wavefront)
+        rnn.merge_gemm_layer = rnn.merge_gemm_iter = false;
     bool is_inference = !rnn.is_training;
 
     rnn.use_jit_gemm = !mayiuse(avx512_mic)
@@ -261,9 +283,15 @@ void rnn_utils::set_conf(rnn_conf_t &rnn, const rnn_desc_t &rd,
 
     /* set other sizes */
     rnn.ws_per_cell = (size_t)rnn.is_lbr * rnn.mb * rnn.dic * sizeof(float);
-    rnn.ws_cell_comp_size
-            = rnn.is_lbr || rnn.dt_conf != all_f32
-                ? (size_t) rnn.gates_nld * rnn.gates_ws_ld * sizeof(float)
+    /* the gru lbr cells of different layers and directions run
+     * concurrently in a wavefront, so each of them gets its own buffer; the
+     * size does not depend on use_wavefront to keep the workspace layout the
+     * same for forward and backward */
+    rnn.ws_cell_comp_size = rnn.is_lbr
+            ? (size_t)rnn.n_layer * rnn.n_dir * rnn.gates_nld
+                    * rnn.gates_ws_ld * sizeof(float)
+            : rnn.dt_conf != all_f32
+                ? (size_t)rnn.gates_nld * rnn.gates_ws_ld * sizeof(float)
                 : 0;
     rnn.ws_grid_comp_size = (size_t)rnn.is_lbr * rnn.is_training * rnn.n_layer
             * rnn.n_dir * rnn.n_iter * rnn.ws_per_cell * sizeof(float);
@@ -28,7 +28,7 @@
             src_data_t *states_tm1_l_, float *c_states_tm1_l_,        \
             float *diff_states_t_l_, float *diff_states_t_lp1_,       \
             float *diff_states_tp1_l_, float *bias_, float *ws_grid_, \
-            acc_data_t *ws_cell_) const
+            acc_data_t *ws_cell_, float *diff_bias_) const
 
 #define rnn_cell_execution_sig(f)                                             \
     void f(const rnn_utils::rnn_conf_t &rnn, src_data_t *states_t_l_,     \
@@ -125,6 +125,7 @@ struct rnn_conf_t {
             ws_cell_comp_size, ws_grid_comp_size, ws_per_cell, ws_bias_size;
     bool merge_gemm_iter, merge_gemm_layer, use_jit_gemm, use_layer_packed_gemm,
         use_iter_packed_gemm;
+    bool use_wavefront;
     memory_format_t weights_layer_fmt, weights_iter_fmt, diff_weights_layer_fmt,
             diff_weights_iter_fmt;
 };
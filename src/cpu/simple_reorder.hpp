@@ -1365,7 +1365,7 @@ struct simple_reorder_t: public cpu_primitive_t {
                 && input_pd->desc()->data_type == type_i
                 && output_pd->desc()->data_type == type_o
                 && IMPLICATION(utils::one_of(data_type::bf16, type_i, type_o),
-                        mayiuse(avx512_core))
+                        mayiuse_bf16_cvt())
                 && simple_reorder_impl<SIMPLE_REORDER_TEMPL_CALL, spec>::
                 is_applicable(input_pd->desc(), output_pd->desc(), attr);
             if (!args_ok)
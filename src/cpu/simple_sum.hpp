@@ -48,7 +48,9 @@ struct simple_sum_t: public cpu_primitive_t {
         virtual status_t init() override {
             bool ok = true
                 && cpu_sum_pd_t::init() == success
-                && src_pds_.size() <= max_num_arrs;
+                && src_pds_.size() <= max_num_arrs
+                && IMPLICATION(src_data_type == data_type::bf16,
+                        mayiuse_bf16_cvt());
             if (!ok) return unimplemented;
 
             const memory_desc_wrapper o_d(&dst_pd_);
@@ -34,6 +34,12 @@
 #include "reorder/reorder.hpp"
 #include "bnorm/bnorm.hpp"
 #include "rnn/rnn.hpp"
+#include "pool/pool.hpp"
+#include "eltwise/eltwise.hpp"
+#include "softmax/softmax.hpp"
+#include "lrn/lrn.hpp"
+#include "sum/sum.hpp"
+#include "concat/concat.hpp"
 
 int verbose {0};
 bench_mode_t bench_mode {CORR};
@@ -42,6 +48,7 @@ stat_t benchdnn_stat {0};
 double max_ms_per_prb {3e3};
 int min_times_per_prb {5};
 int fix_times_per_prb {0};
+std::vector<int> throughput_instances;
 
 int main(int argc, char **argv) {
     prim_t prim = DEF;
@@ -56,10 +63,26 @@ int main(int argc, char **argv) {
         else if (!strcmp("--reorder", argv[0])) prim = REORDER;
         else if (!strcmp("--bnorm", argv[0])) prim = BNORM;
         else if (!strcmp("--rnn", argv[0])) prim = RNN;
+        else if (!strcmp("--pool", argv[0])) prim = POOL;
+        else if (!strcmp("--eltwise", argv[0])) prim = ELTWISE;
+        else if (!strcmp("--softmax", argv[0])) prim = SOFTMAX;
+        else if (!strcmp("--lrn", argv[0])) prim = LRN;
+        else if (!strcmp("--sum", argv[0])) prim = SUM;
+        else if (!strcmp("--concat", argv[0])) prim = CONCAT;
         else if (!strncmp("--mode=", argv[0], 7))
             bench_mode = str2bench_mode(argv[0] + 7);
         else if (!strncmp("--max-ms-per-prb=", argv[0], 17))
             sscanf(argv[0] + 17, "%lf", &max_ms_per_prb);
+        else if (!strncmp("--instances=", argv[0], 12))
+            read_csv(argv[0] + 12, [&]() { throughput_instances.clear(); },
+                    [&](const char *s) {
+                        throughput_instances.push_back(atoi(s)); });
+        else if (!strncmp("--perf-counters=", argv[0], 16))
+            perf_counters::enabled = str2bool(argv[0] + 16);
+        else if (!strncmp("--peak-gflops=", argv[0], 14))
+            sscanf(argv[0] + 14, "%lf", &perf_counters::peak_gflops);
+        else if (!strncmp("--peak-gbps=", argv[0], 12))
+            sscanf(argv[0] + 12, "%lf", &perf_counters::peak_gbps);
         else if (!strncmp("-v", argv[0], 2))
             verbose = atoi(argv[0] + 2);
         else if (!strncmp("--verbose=", argv[0], 10))
@@ -75,6 +98,7 @@ int main(int argc, char **argv) {
 
     init_fp_mode();
     init();
+    perf_counters::init();
 
     switch (prim) {
     case SELF: self::bench(argc, argv); break;
@@ -85,9 +109,16 @@ int main(int argc, char **argv) {
     case REORDER: reorder::bench(argc, argv); break;
     case BNORM: bnorm::bench(argc, argv); break;
     case RNN: rnn::bench(argc, argv); break;
+    case POOL: pool::bench(argc, argv); break;
+    case ELTWISE: eltwise::bench(argc, argv); break;
+    case SOFTMAX: softmax::bench(argc, argv); break;
+    case LRN: lrn::bench(argc, argv); break;
+    case SUM: sum::bench(argc, argv); break;
+    case CONCAT: concat::bench(argc, argv); break;
     default: fprintf(stderr, "err: unknown driver\n");
     }
 
+    perf_counters::finalize();
     finalize();
 
     printf("tests:%d passed:%d "
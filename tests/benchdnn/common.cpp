@@ -70,11 +70,13 @@ void benchdnn_timer_t::reset() {
     ticks_start_ = 0;
     for (int i = 0; i < n_modes; ++i) ms_[i] = 0;
     ms_start_ = 0;
+    for (int e = 0; e < perf_counters::n_events; ++e) counters_[e] = 0;
 
     start();
 }
 
 void benchdnn_timer_t::start() {
+    if (perf_counters::enabled) perf_counters::read(counters_start_);
     ticks_start_ = ticks_now();
     ms_start_ = ms_now();
 }
@@ -99,6 +101,18 @@ void benchdnn_timer_t::stop() {
         ? MAX2(ticks_[benchdnn_timer_t::max], d_ticks) : d_ticks;
 
     times_++;
+
+    if (perf_counters::enabled) {
+        double counters_now[perf_counters::n_events];
+        perf_counters::read(counters_now);
+        for (int e = 0; e < perf_counters::n_events; ++e) {
+            counters_[e] += counters_now[e] - counters_start_[e];
+            counters_start_[e] = counters_now[e];
+        }
+        /* do not account the reading of the counters to the next run */
+        ticks_start_ = ticks_now();
+        ms_start_ = ms_now();
+    }
 }
 
 benchdnn_timer_t &benchdnn_timer_t::operator=(const benchdnn_timer_t &rhs) {
@@ -108,6 +122,10 @@ benchdnn_timer_t &benchdnn_timer_t::operator=(const benchdnn_timer_t &rhs) {
     ticks_start_ = rhs.ticks_start_;
     for (int i = 0; i < n_modes; ++i) ms_[i] = rhs.ms_[i];
     ms_start_ = rhs.ms_start_;
+    for (int e = 0; e < perf_counters::n_events; ++e) {
+        counters_[e] = rhs.counters_[e];
+        counters_start_[e] = rhs.counters_start_[e];
+    }
     return *this;
 }
 
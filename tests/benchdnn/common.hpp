@@ -25,6 +25,10 @@
 #include <float.h>
 #include <math.h>
 
+#include <vector>
+
+#include "perf_counters.hpp"
+
 #define ABS(a) ((a)>0?(a):(-(a)))
 
 #define MIN2(a,b) ((a)<(b)?(a):(b))
@@ -87,7 +91,8 @@ extern int verbose;
     } \
 } while (0)
 
-enum prim_t { SELF, CONV, DECONV, IP, SHUFFLE, REORDER, BNORM, RNN, DEF = CONV, };
+enum prim_t { SELF, CONV, DECONV, IP, SHUFFLE, REORDER, BNORM, RNN, POOL,
+    ELTWISE, SOFTMAX, LRN, SUM, CONCAT, DEF = CONV, };
 
 enum bench_mode_t { MODE_UNDEF = 0x0, CORR = 0x1, PERF = 0x2, };
 const char *bench_mode2str(bench_mode_t mode);
@@ -98,6 +103,8 @@ extern bench_mode_t bench_mode;
 extern double max_ms_per_prb; /** maximum time spends per prb in ms */
 extern int min_times_per_prb; /** minimal amount of runs per prb */
 extern int fix_times_per_prb; /** if non-zero run prb that many times */
+/** instance counts of the throughput mode, empty if disabled */
+extern std::vector<int> throughput_instances;
 
 struct benchdnn_timer_t {
     enum mode_t { min = 0, avg = 1, max = 2, n_modes };
@@ -126,6 +133,9 @@ struct benchdnn_timer_t {
     int times_;
     long long ticks_[n_modes], ticks_start_;
     double ms_[n_modes], ms_start_;
+    /* totals over all the runs, if perf_counters::enabled */
+    double counters_[perf_counters::n_events];
+    double counters_start_[perf_counters::n_events];
 };
 
 /* global stats */
@@ -0,0 +1,238 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <float.h>
+#include <math.h>
+
+#include "mkldnn.h"
+
+#include "mkldnn_common.hpp"
+#include "mkldnn_memory.hpp"
+#include "norm.hpp"
+
+#include "concat/concat.hpp"
+
+namespace concat {
+
+static bool is_integral(mkldnn_data_type_t dt) {
+    return dt == mkldnn_s32 || dt == mkldnn_s8 || dt == mkldnn_u8;
+}
+
+static float saturate_and_round(mkldnn_data_type_t dt, float value) {
+    float lo = INT_MIN, hi = INT_MAX;
+    switch (dt) {
+    case mkldnn_s8: lo = INT8_MIN; hi = INT8_MAX; break;
+    case mkldnn_u8: lo = 0; hi = UINT8_MAX; break;
+    default: break;
+    }
+    return MAX2(lo, MIN2(hi, nearbyintf(value)));
+}
+
+/* the values are small integers (multiples of 1/8 for floating point data
+ * types), so that they are exact in any data type */
+static int fill_src(const prb_t *p, int input_idx, dnn_mem_t &mem) {
+    const size_t nelems = mem.nelems();
+    for (size_t idx = 0; idx < nelems; ++idx) {
+        const int v = (int)((idx + 11 * input_idx) * 37 % 33) - 16;
+        float value;
+        switch (p->sdt) {
+        case mkldnn_u8: value = (float)(v + 16); break;
+        case mkldnn_s8:
+        case mkldnn_s32: value = (float)v; break;
+        default: value = v / 8.f; break;
+        }
+        mem.set_elem(idx, value);
+    }
+    return OK;
+}
+
+static int compare(const prb_t *p, const dnn_mem_t &fp_mem,
+        const dnn_mem_t &dt_mem, res_t *r) {
+    const float trh = p->ddt == mkldnn_bf16 || p->sdt == mkldnn_bf16
+        ? 1e-2
+        : is_integral(p->ddt) ? 0 : 1e-6;
+
+    const size_t nelems = fp_mem.nelems();
+    r->errors = 0;
+    r->total = nelems;
+
+    diff_norm_t diff_norm;
+    for (size_t i = 0; i < nelems; ++i) {
+        float fp = ((const float *)fp_mem)[i];
+        if (is_integral(p->ddt)) fp = saturate_and_round(p->ddt, fp);
+        const float dt = ((const float *)dt_mem)[i];
+        diff_norm.update(fp, dt);
+
+        const float diff = fabsf(fp - dt);
+        const float rel_diff = diff / (fabsf(fp) > FLT_MIN ? fabsf(fp) : 1);
+        const bool ok = (fabsf(fp) > 1e-5 ? rel_diff : diff) <= trh;
+
+        r->errors += !ok;
+
+        const bool dump = false
+            || (!ok && (r->errors < 10 || verbose >= 10))
+            || (verbose >= 50 && i < 30) || (verbose >= 99);
+        if (dump) {
+            print(0, "[%lu] fp:%8g dt:%8g diff:%8g rdiff:%8g\n",
+                    (unsigned long)i, fp, dt, diff, rel_diff);
+        }
+    }
+
+    diff_norm.done();
+
+    if (r->errors || verbose >= 5) {
+        const int vl = r->errors ? 0 : 2;
+        print(vl, "@@@ [DST] diff: l0(``%g``) "
+                "l1:(%g,%g,%g,``%g``) "
+                "l2:(%g,%g,%g,``%g``) "
+                "l8:(%g,%g,%g,``%g``)\n",
+                diff_norm.rel_diff(norm_t::L0),
+                diff_norm.a_[norm_t::L1], diff_norm.b_[norm_t::L1],
+                diff_norm.diff_[norm_t::L1], diff_norm.rel_diff(norm_t::L1),
+                diff_norm.a_[norm_t::L2], diff_norm.b_[norm_t::L2],
+                diff_norm.diff_[norm_t::L2], diff_norm.rel_diff(norm_t::L2),
+                diff_norm.a_[norm_t::L8], diff_norm.b_[norm_t::L8],
+                diff_norm.diff_[norm_t::L8], diff_norm.rel_diff(norm_t::L8));
+    }
+
+    if (r->errors)
+        r->state = FAILED;
+
+    if (r->state == UNTESTED)
+        r->state = PASSED; /* optimism */
+
+    return r->state == FAILED ? FAIL : OK;
+}
+
+static int init_pd(const prb_t *p, const std::vector<dnn_mem_t *> &src_dt,
+        mkldnn_primitive_desc_t &cpd, res_t *r) {
+    const int n = p->n_inputs();
+    std::vector<const_mkldnn_primitive_desc_t> src_pds(n);
+    for (int i = 0; i < n; ++i)
+        src_pds[i] = src_dt[i]->mpd_;
+
+    mkldnn_memory_desc_t dst_d;
+    mkldnn_dims_t dst_dims;
+    for (int i = 0; i < p->ndims(); ++i) dst_dims[i] = p->ddims[i];
+    const auto dtag = p->dtag == mkldnn_format_undef ? mkldnn_any : p->dtag;
+    DNN_SAFE(mkldnn_memory_desc_init(&dst_d, p->ndims(), dst_dims, p->ddt,
+                dtag), WARN);
+
+    mkldnn_status_t init_status = mkldnn_concat_primitive_desc_create(&cpd,
+            &dst_d, n, p->axis, &src_pds[0]);
+
+    if (init_status == mkldnn_unimplemented)
+        return r->state = UNIMPLEMENTED, OK;
+    else
+        SAFE(init_status, WARN);
+
+    const char *impl_str = query_impl_info(cpd);
+    if (maybe_skip(skip_impl, impl_str)) {
+        print(2, "SKIPPED: mkldnn implementation: %s\n", impl_str);
+        DNN_SAFE(mkldnn_primitive_desc_destroy(cpd), WARN);
+        return r->state = SKIPPED, OK;
+    } else {
+        print(5, "mkldnn implementation: %s\n", impl_str);
+    }
+
+    return OK;
+}
+
+int doit(const prb_t *p, res_t *r) {
+    res_t res_zero{};
+    *r = res_zero;
+
+    const int n = p->n_inputs();
+    const int ndims = p->ndims();
+    const auto fp = mkldnn_f32;
+    const auto plain_fmt = ndims == 1
+        ? mkldnn_x : get_default_format(ndims, DATA);
+
+    std::vector<dnn_mem_t *> src_fp(n), src_dt(n);
+    for (int i = 0; i < n; ++i) {
+        mkldnn_dims_t dims;
+        for (int d = 0; d < ndims; ++d) dims[d] = p->sdims[i][d];
+        src_fp[i] = new dnn_mem_t(ndims, dims, fp, plain_fmt);
+        src_dt[i] = new dnn_mem_t(ndims, dims, p->sdt, p->stag[i]);
+    }
+    auto cleanup = [&]() {
+        for (int i = 0; i < n; ++i) {
+            delete src_fp[i];
+            delete src_dt[i];
+        }
+    };
+
+    mkldnn_primitive_desc_t cpd;
+    mkldnn_primitive_t c{};
+
+    if (init_pd(p, src_dt, cpd, r) != OK) {
+        cleanup();
+        return FAIL;
+    }
+    if (r->state == SKIPPED || r->state == UNIMPLEMENTED) {
+        cleanup();
+        return OK;
+    }
+
+    mkldnn_dims_t ddims;
+    for (int d = 0; d < ndims; ++d) ddims[d] = p->ddims[d];
+    const auto dst_pd = mkldnn_primitive_desc_query_pd(cpd,
+            mkldnn_query_output_pd, 0);
+    dnn_mem_t dst_fp(ndims, ddims, fp, plain_fmt);
+    dnn_mem_t dst_dt(*mkldnn_primitive_desc_query_memory_d(dst_pd));
+
+    std::vector<mkldnn_primitive_at_t> inputs(n);
+    for (int i = 0; i < n; ++i) {
+        SAFE(fill_src(p, i, *src_fp[i]), WARN);
+        SAFE(src_dt[i]->reorder(*src_fp[i]), WARN);
+        inputs[i] = {src_dt[i]->p_, 0};
+    }
+    const_mkldnn_primitive_t outputs[1] = { dst_dt.p_ };
+
+    DNN_SAFE(mkldnn_primitive_create(&c, cpd, &inputs[0], outputs), WARN);
+    DNN_SAFE_V(mkldnn_primitive_desc_destroy(cpd));
+    SAFE(execute(c), WARN);
+
+    if (bench_mode & CORR) {
+        compute_ref(p, src_fp, dst_fp);
+        dnn_mem_t dst(dst_dt, fp, plain_fmt);
+        SAFE(compare(p, dst_fp, dst, r), WARN);
+    }
+
+    if (bench_mode & PERF) {
+        auto &t = r->timer;
+        t.reset();
+        while (true) {
+            SAFE(execute(c), WARN);
+            t.stamp();
+            const bool stop = false
+                || (fix_times_per_prb && t.times() >= fix_times_per_prb)
+                || (!fix_times_per_prb
+                        && t.total_ms() >= max_ms_per_prb
+                        && t.times() >= min_times_per_prb);
+            if (stop) break;
+        }
+    }
+
+    DNN_SAFE_V(mkldnn_primitive_destroy(c));
+    cleanup();
+    return OK;
+}
+
+}
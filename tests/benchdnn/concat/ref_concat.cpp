@@ -0,0 +1,48 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "src/common/mkldnn_thread.hpp"
+
+#include "concat/concat.hpp"
+
+namespace concat {
+
+void compute_ref(const prb_t *p, const std::vector<dnn_mem_t *> &src,
+        dnn_mem_t &dst) {
+    /* the data is viewed as outer_size x axis_size x inner_size */
+    size_t outer_size = 1, inner_size = 1;
+    for (int d = 0; d < p->axis; ++d)
+        outer_size *= (size_t)p->ddims[d];
+    for (int d = p->axis + 1; d < p->ndims(); ++d)
+        inner_size *= (size_t)p->ddims[d];
+    const size_t dst_axis_size = p->ddims[p->axis];
+
+    size_t axis_off = 0;
+    for (int i = 0; i < p->n_inputs(); ++i) {
+        const size_t src_axis_size = p->sdims[i][p->axis];
+        const float *s = (const float *)*src[i];
+        float *d = (float *)dst;
+        mkldnn::impl::parallel_nd((ptrdiff_t)outer_size,
+                (ptrdiff_t)(src_axis_size * inner_size),
+                [&](ptrdiff_t ou, ptrdiff_t in) {
+            d[(ou * dst_axis_size + axis_off) * inner_size + in]
+                = s[ou * src_axis_size * inner_size + in];
+        });
+        axis_off += src_axis_size;
+    }
+}
+
+}
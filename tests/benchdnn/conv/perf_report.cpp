@@ -48,6 +48,7 @@ table of modifiers below.
 | %@t           | time in ms
 | %@c           | time in clocks
 | %@p           | ops per second
+| %@H<x>        | hardware counters and roofline metrics, see README.md
 
 | modifier  | description
 |:--------  |:-----------
@@ -66,6 +67,13 @@ The definition of expanded problem descriptor is:
 
 void perf_report(const prb_t *p, const res_t *r, const char *pstr) {
     const auto &t = r->timer;
+    const double bytes = 0.
+        + (double)sizeof_dt(p->cfg[SRC].dt) * p->mb * p->ic * p->id * p->ih
+            * p->iw
+        + (double)sizeof_dt(p->cfg[WEI].dt) * p->oc * p->ic / p->g * p->kd
+            * p->kh * p->kw
+        + (double)sizeof_dt(p->cfg[DST].dt) * p->mb * p->oc * p->od * p->oh
+            * p->ow;
     const int max_len = 400;
     int rem_len = max_len - 1;
     char buffer[max_len], *buf = buffer;
@@ -129,6 +137,12 @@ void perf_report(const prb_t *p, const res_t *r, const char *pstr) {
             DPRINT("%g", t.ticks(mode) / unit);
         else if (c == 'p')
             DPRINT("%g", p->ops / t.ms(mode) / unit * 1e3);
+        else if (c == 'H') {
+            const int l = perf_counters::report(buf, rem_len, *pt, t, mode,
+                    unit, p->ops, bytes);
+            if (l < 0) []() { SAFE(FAIL, CRIT); return 0; }();
+            ++pt; buf += l; rem_len -= l;
+        }
         else
             []() { SAFE(FAIL, CRIT); return 0; }();
     }
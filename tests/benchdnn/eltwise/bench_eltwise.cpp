@@ -0,0 +1,124 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <float.h>
+#include <math.h>
+
+#include "mkldnn.h"
+
+#include "mkldnn_common.hpp"
+#include "mkldnn_memory.hpp"
+#include "mkldnn_debug.hpp"
+
+#include "eltwise/eltwise.hpp"
+
+namespace eltwise {
+
+/* global driver parameters */
+dir_t dir = FWD_D;
+mkldnn_data_type_t dt = mkldnn_f32;
+mkldnn_memory_format_t fmt = mkldnn_nchw;
+alg_t alg = RELU;
+float alpha = 0.f, beta = 0.f;
+dims_t dims;
+const char *pattern = NULL;
+const char *skip_impl = "";
+bool allow_unimpl = false;
+const char *perf_template = "perf,%z,%q,%f,%a,%D,%-t,%0t";
+
+void reset_parameters() {
+    dir = FWD_D;
+    dt = mkldnn_f32;
+    fmt = mkldnn_nchw;
+    alg = RELU;
+    alpha = 0.f;
+    beta = 0.f;
+    pattern = NULL;
+    skip_impl = "";
+    allow_unimpl = false;
+}
+
+void check_correctness() {
+    const prb_t p(dims, dir, dt, fmt, alg, alpha, beta);
+    char pstr[max_prb_len];
+    prb2str(&p, pstr);
+
+    if (pattern && !match_regex(pstr, pattern))
+        return;
+    print(1, "run: %s\n", pstr);
+
+    res_t res{};
+    const int status = eltwise::doit(&p, &res);
+
+    bool want_perf_report = false;
+    parse_result(res, want_perf_report, allow_unimpl, status, pstr);
+
+    if (want_perf_report && bench_mode & PERF)
+        perf_report(&p, &res, pstr);
+
+    benchdnn_stat.tests++;
+}
+
+int bench(int argc, char **argv, bool main_bench) {
+    for (int arg = 0; arg < argc; ++arg) {
+        if (!strncmp("--batch=", argv[arg], 8))
+            SAFE(batch(argv[arg] + 8, bench), CRIT);
+        else if (!strncmp("--dir=", argv[arg], 6))
+            dir = str2dir(argv[arg] + 6);
+        else if (!strncmp("--dt=", argv[arg], 5))
+            dt = str2dt(argv[arg] + 5);
+        else if (!strncmp("--fmt=", argv[arg], 6))
+            fmt = str2fmt(argv[arg] + 6);
+        else if (!strncmp("--alg=", argv[arg], 6))
+            alg = str2alg(argv[arg] + 6);
+        else if (!strncmp("--alpha=", argv[arg], 8))
+            alpha = atof(argv[arg] + 8);
+        else if (!strncmp("--beta=", argv[arg], 7))
+            beta = atof(argv[arg] + 7);
+        else if (!strncmp("--match=", argv[arg], 8))
+            pattern = argv[arg] + 8;
+        else if (!strncmp("--skip-impl=", argv[arg], 12))
+            skip_impl = argv[arg] + 12;
+        else if (!strncmp("--allow-unimpl=", argv[arg], 15))
+            allow_unimpl = str2bool(argv[arg] + 15);
+        else if (!strncmp("--perf-template=", argv[arg], 16))
+            perf_template = argv[arg] + 16;
+        else if (!strcmp("--reset", argv[arg]))
+            reset_parameters();
+        else if (!strncmp("--mode=", argv[arg], 7))
+            bench_mode = str2bench_mode(argv[arg] + 7);
+        else if (!strncmp("-v", argv[arg], 2))
+            verbose = atoi(argv[arg] + 2);
+        else if (!strncmp("--verbose=", argv[arg], 10))
+            verbose = atoi(argv[arg] + 10);
+        else {
+            if (!strncmp("--", argv[arg], 2)) {
+                fprintf(stderr, "driver: unknown option: `%s`, exiting...\n",
+                        argv[arg]);
+                exit(2);
+            }
+            dims = str2dims(argv[arg]);
+            check_correctness();
+        }
+    }
+
+    return OK;
+}
+
+}
@@ -0,0 +1,267 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <float.h>
+#include <math.h>
+
+#include "mkldnn.h"
+
+#include "mkldnn_common.hpp"
+#include "mkldnn_memory.hpp"
+#include "norm.hpp"
+
+#include "eltwise/eltwise.hpp"
+
+namespace eltwise {
+
+static bool is_integral(mkldnn_data_type_t dt) {
+    return dt == mkldnn_s32 || dt == mkldnn_s8 || dt == mkldnn_u8;
+}
+
+static float saturate_and_round(mkldnn_data_type_t dt, float value) {
+    float lo = INT_MIN, hi = INT_MAX;
+    switch (dt) {
+    case mkldnn_s8: lo = INT8_MIN; hi = INT8_MAX; break;
+    case mkldnn_u8: lo = 0; hi = UINT8_MAX; break;
+    default: break;
+    }
+    return MAX2(lo, MIN2(hi, nearbyintf(value)));
+}
+
+/* the values are multiples of 1/8 within [-10, 10], so that they are exact
+ * in bf16 as well */
+static int fill_src(const prb_t *p, dnn_mem_t &mem) {
+    const size_t nelems = mem.nelems();
+    for (size_t idx = 0; idx < nelems; ++idx) {
+        float value;
+        switch (p->dt) {
+        case mkldnn_s32:
+        case mkldnn_s8: value = (float)((int)(idx * 37 % 255) - 127); break;
+        case mkldnn_u8: value = (float)(idx * 37 % 256); break;
+        default: value = ((int)(idx * 37 % 161) - 80) / 8.f; break;
+        }
+        mem.set_elem(idx, value);
+    }
+    return OK;
+}
+
+static int fill_diff_dst(const prb_t *p, dnn_mem_t &mem) {
+    const size_t nelems = mem.nelems();
+    for (size_t idx = 0; idx < nelems; ++idx) {
+        float value = is_integral(p->dt)
+            ? (float)((int)(idx * 13 % 41) - 20)
+            : ((int)(idx * 13 % 41) - 20) / 8.f;
+        if (p->dt == mkldnn_u8) value = fabsf(value);
+        mem.set_elem(idx, value);
+    }
+    return OK;
+}
+
+static int compare(const prb_t *p, const dnn_mem_t &fp_mem,
+        const dnn_mem_t &dt_mem, res_t *r) {
+    const float trh = p->dt == mkldnn_bf16
+        ? 1e-2
+        : is_integral(p->dt) ? 0 : 2e-5;
+
+    const size_t nelems = fp_mem.nelems();
+    r->errors = 0;
+    r->total = nelems;
+
+    diff_norm_t diff_norm;
+    for (size_t i = 0; i < nelems; ++i) {
+        float fp = fp_mem.get_elem(i);
+        if (is_integral(p->dt)) fp = saturate_and_round(p->dt, fp);
+        const float dt = dt_mem.get_elem(i);
+        diff_norm.update(fp, dt);
+
+        const float diff = fabsf(fp - dt);
+        const float rel_diff = diff / (fabsf(fp) > FLT_MIN ? fabsf(fp) : 1);
+        const bool ok = (isinf(fp) && fp == dt)
+            || (fabsf(fp) > 1e-5 ? rel_diff : diff) <= trh;
+
+        r->errors += !ok;
+
+        const bool dump = false
+            || (!ok && (r->errors < 10 || verbose >= 10))
+            || (verbose >= 50 && i < 30) || (verbose >= 99);
+        if (dump) {
+            print(0, "[%lu][%s] fp:%8g dt:%8g diff:%8g rdiff:%8g\n",
+                    (unsigned long)i, p->dir & FLAG_BWD ? "D_SRC" : "DST",
+                    fp, dt, diff, rel_diff);
+        }
+    }
+
+    diff_norm.done();
+
+    if (r->errors || verbose >= 5) {
+        const int vl = r->errors ? 0 : 2;
+        print(vl, "@@@ [%s] diff: l0(``%g``) "
+                "l1:(%g,%g,%g,``%g``) "
+                "l2:(%g,%g,%g,``%g``) "
+                "l8:(%g,%g,%g,``%g``)\n",
+                p->dir & FLAG_BWD ? "D_SRC" : "DST",
+                diff_norm.rel_diff(norm_t::L0),
+                diff_norm.a_[norm_t::L1], diff_norm.b_[norm_t::L1],
+                diff_norm.diff_[norm_t::L1], diff_norm.rel_diff(norm_t::L1),
+                diff_norm.a_[norm_t::L2], diff_norm.b_[norm_t::L2],
+                diff_norm.diff_[norm_t::L2], diff_norm.rel_diff(norm_t::L2),
+                diff_norm.a_[norm_t::L8], diff_norm.b_[norm_t::L8],
+                diff_norm.diff_[norm_t::L8], diff_norm.rel_diff(norm_t::L8));
+    }
+
+    if (r->errors)
+        r->state = FAILED;
+
+    if (r->state == UNTESTED)
+        r->state = PASSED; /* optimism */
+
+    return r->state == FAILED ? FAIL : OK;
+}
+
+static int init_pd(const prb_t *p, mkldnn_eltwise_desc_t &ed,
+        mkldnn_primitive_desc_t &epd, res_t *r) {
+    mkldnn_memory_desc_t data_d;
+    mkldnn_dims_t data_dims;
+    const int ndims = (int)p->dims.size();
+
+    for (int i = 0; i < ndims; ++i) data_dims[i] = p->dims[i];
+    DNN_SAFE(mkldnn_memory_desc_init(&data_d, ndims, data_dims, p->dt, p->fmt),
+            WARN);
+
+    const auto alg = alg2alg_kind(p->alg);
+    mkldnn_primitive_desc_t hint_fwd_pd = NULL;
+    if (p->dir & FLAG_FWD) {
+        auto prop = p->dir & FLAG_INF
+            ? mkldnn_forward_inference : mkldnn_forward_training;
+        DNN_SAFE(mkldnn_eltwise_forward_desc_init(&ed, prop, alg, &data_d,
+                    p->alpha, p->beta), WARN);
+    } else {
+        DNN_SAFE(mkldnn_eltwise_backward_desc_init(&ed, alg, &data_d,
+                    &data_d, p->alpha, p->beta), WARN);
+        mkldnn_eltwise_desc_t ed_fwd;
+        DNN_SAFE(mkldnn_eltwise_forward_desc_init(&ed_fwd,
+                    mkldnn_forward_training, alg, &data_d, p->alpha, p->beta),
+                WARN);
+        mkldnn_status_t init_status = mkldnn_primitive_desc_create(
+                &hint_fwd_pd, &ed_fwd, engine, NULL);
+        // if fwd pass is unimplemented, bwd pass is useless
+        if (init_status == mkldnn_unimplemented)
+            return r->state = UNIMPLEMENTED, OK;
+        else
+            SAFE(init_status, WARN);
+    }
+
+    mkldnn_status_t init_status = mkldnn_primitive_desc_create(&epd, &ed,
+            engine, hint_fwd_pd);
+    mkldnn_primitive_desc_destroy(hint_fwd_pd);
+
+    if (init_status == mkldnn_unimplemented)
+        return r->state = UNIMPLEMENTED, OK;
+    else
+        SAFE(init_status, WARN);
+
+    const char *impl_str = query_impl_info(epd);
+    if (maybe_skip(skip_impl, impl_str)) {
+        print(2, "SKIPPED: mkldnn implementation: %s\n", impl_str);
+        DNN_SAFE(mkldnn_primitive_desc_destroy(epd), WARN);
+        return r->state = SKIPPED, OK;
+    } else {
+        print(5, "mkldnn implementation: %s\n", impl_str);
+    }
+
+    return OK;
+}
+
+int doit(const prb_t *p, res_t *r) {
+    res_t res_zero{};
+    *r = res_zero;
+
+    mkldnn_eltwise_desc_t ed;
+    mkldnn_primitive_desc_t epd;
+    mkldnn_primitive_t e{};
+
+    SAFE(init_pd(p, ed, epd, r), WARN);
+    if (r->state == SKIPPED || r->state == UNIMPLEMENTED)
+        return OK;
+
+    const auto fp = mkldnn_f32;
+    auto &data_dt_d = ed.data_desc;
+
+    const int ndims = (int)p->dims.size();
+    const auto data_format = (ndims == 1)
+           ? mkldnn_x
+           : (ndims == 2)
+           ? mkldnn_nc
+           : get_default_format(ndims, fmt2data_kind(p->fmt));
+
+    dnn_mem_t src_fp(data_dt_d, fp, data_format), src_dt(data_dt_d);
+    dnn_mem_t dst_fp(data_dt_d, fp, data_format), dst_dt(data_dt_d);
+    dnn_mem_t d_src_fp(data_dt_d, fp, data_format), d_src_dt(data_dt_d);
+
+    SAFE(fill_src(p, src_fp), WARN);
+    SAFE(src_dt.reorder(src_fp), WARN);
+
+    if (p->dir & FLAG_FWD) {
+        mkldnn_primitive_at_t inputs[1] = { {src_dt.p_, 0} };
+        const_mkldnn_primitive_t outputs[1] = { dst_dt.p_ };
+        DNN_SAFE(mkldnn_primitive_create(&e, epd, inputs, outputs), WARN);
+        SAFE(execute(e), WARN);
+        if (bench_mode & CORR) {
+            compute_ref_fwd(p, src_fp, dst_fp);
+            dnn_mem_t dst(dst_dt, fp, data_format);
+            SAFE(compare(p, dst_fp, dst, r), WARN);
+        }
+    } else {
+        /* dst_* hold the diff_dst */
+        SAFE(fill_diff_dst(p, dst_fp), WARN);
+        SAFE(dst_dt.reorder(dst_fp), WARN);
+
+        mkldnn_primitive_at_t inputs[2] = { {src_dt.p_, 0}, {dst_dt.p_, 0} };
+        const_mkldnn_primitive_t outputs[1] = { d_src_dt.p_ };
+        DNN_SAFE(mkldnn_primitive_create(&e, epd, inputs, outputs), WARN);
+        SAFE(execute(e), WARN);
+        if (bench_mode & CORR) {
+            compute_ref_bwd(p, src_fp, dst_fp, d_src_fp);
+            dnn_mem_t d_src(d_src_dt, fp, data_format);
+            SAFE(compare(p, d_src_fp, d_src, r), WARN);
+        }
+    }
+
+    DNN_SAFE_V(mkldnn_primitive_desc_destroy(epd));
+
+    if (bench_mode & PERF) {
+        auto &t = r->timer;
+        t.reset();
+        while (true) {
+            SAFE(execute(e), WARN);
+            t.stamp();
+            const bool stop = false
+                || (fix_times_per_prb && t.times() >= fix_times_per_prb)
+                || (!fix_times_per_prb
+                        && t.total_ms() >= max_ms_per_prb
+                        && t.times() >= min_times_per_prb);
+            if (stop) break;
+        }
+    }
+
+    DNN_SAFE_V(mkldnn_primitive_destroy(e));
+    return OK;
+}
+
+}
@@ -0,0 +1,86 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef _ELTWISE_HPP
+#define _ELTWISE_HPP
+
+#include <stdint.h>
+#include <limits.h>
+#include <assert.h>
+#include <vector>
+
+#include "common.hpp"
+#include "dnn_types.hpp"
+#include "mkldnn_common.hpp"
+#include "mkldnn_memory.hpp"
+#include "mkldnn_debug.hpp"
+
+namespace eltwise {
+
+using dims_t = std::vector<int>;
+
+enum alg_t { RELU, TANH, ELU, SQUARE, ABS, SQRT, LINEAR, BRELU, SRELU,
+    LOGISTIC, EXP, GELU, ALG_UNDEF };
+alg_t str2alg(const char *str);
+const char *alg2str(alg_t alg);
+mkldnn_alg_kind_t alg2alg_kind(alg_t alg);
+
+struct prb_t {
+    prb_t(const dims_t &dims, dir_t dir, mkldnn_data_type_t dt,
+            mkldnn_memory_format_t fmt, alg_t alg, float alpha, float beta)
+        : dims(dims), dir(dir), dt(dt), fmt(fmt), alg(alg), alpha(alpha)
+        , beta(beta) {}
+    ~prb_t() {}
+
+    dims_t dims;
+    dir_t dir;
+    mkldnn_data_type_t dt;
+    mkldnn_memory_format_t fmt;
+    alg_t alg;
+    float alpha, beta;
+};
+
+const size_t max_dims_len = 64;
+dims_t str2dims(const char *str);
+void dims2str(const dims_t &dims, char *buffer);
+const size_t max_prb_len = max_dims_len + 196;
+void prb2str(const prb_t *p, char *buffer, bool canonical = false);
+
+/* some extra control parameters which shouldn't be placed in prb_t */
+extern const char *skip_impl; /* NULL or "" means do not skip anything */
+
+extern const char *perf_template; /* performance output template */
+void perf_report(const prb_t *p, const res_t *r, const char *pstr);
+
+inline size_t nelems(const prb_t *p) {
+    size_t n = 1;
+    for (size_t d = 0; d < p->dims.size(); ++d) n *= (size_t)p->dims[d];
+    return n;
+}
+
+float compute_fwd(const prb_t *p, float s);
+float compute_bwd(const prb_t *p, float dd, float s);
+
+void compute_ref_fwd(const prb_t *p, const dnn_mem_t &src, dnn_mem_t &dst);
+void compute_ref_bwd(const prb_t *p, const dnn_mem_t &src,
+        const dnn_mem_t &diff_dst, dnn_mem_t &diff_src);
+
+int doit(const prb_t *p, res_t *res);
+int bench(int argc, char **argv, bool main_bench = true);
+
+}
+
+#endif
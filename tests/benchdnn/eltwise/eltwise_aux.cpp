@@ -0,0 +1,131 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <stdlib.h>
+#include <assert.h>
+#include "eltwise/eltwise.hpp"
+
+namespace eltwise {
+
+#define DPRINT(...) do { \
+    int l = snprintf(buffer, rem_len, __VA_ARGS__); \
+    buffer += l; rem_len -= l; \
+} while(0)
+
+alg_t str2alg(const char *str) {
+#define CASE(_alg) if (!strcasecmp(STRINGIFY(_alg), str)) return _alg
+    CASE(RELU);
+    CASE(TANH);
+    CASE(ELU);
+    CASE(SQUARE);
+    CASE(ABS);
+    CASE(SQRT);
+    CASE(LINEAR);
+    CASE(BRELU);
+    CASE(SRELU);
+    CASE(LOGISTIC);
+    CASE(EXP);
+    CASE(GELU);
+#undef CASE
+    assert(!"unknown algorithm");
+    return ALG_UNDEF;
+}
+
+const char *alg2str(alg_t alg) {
+#define CASE(_alg, str) if (alg == _alg) return str
+    CASE(RELU, "relu");
+    CASE(TANH, "tanh");
+    CASE(ELU, "elu");
+    CASE(SQUARE, "square");
+    CASE(ABS, "abs");
+    CASE(SQRT, "sqrt");
+    CASE(LINEAR, "linear");
+    CASE(BRELU, "brelu");
+    CASE(SRELU, "srelu");
+    CASE(LOGISTIC, "logistic");
+    CASE(EXP, "exp");
+    CASE(GELU, "gelu");
+#undef CASE
+    assert(!"unknown algorithm");
+    return "unknown algorithm";
+}
+
+mkldnn_alg_kind_t alg2alg_kind(alg_t alg) {
+#define CASE(_alg, _kind) if (alg == _alg) return _kind
+    CASE(RELU, mkldnn_eltwise_relu);
+    CASE(TANH, mkldnn_eltwise_tanh);
+    CASE(ELU, mkldnn_eltwise_elu);
+    CASE(SQUARE, mkldnn_eltwise_square);
+    CASE(ABS, mkldnn_eltwise_abs);
+    CASE(SQRT, mkldnn_eltwise_sqrt);
+    CASE(LINEAR, mkldnn_eltwise_linear);
+    CASE(BRELU, mkldnn_eltwise_bounded_relu);
+    CASE(SRELU, mkldnn_eltwise_soft_relu);
+    CASE(LOGISTIC, mkldnn_eltwise_logistic);
+    CASE(EXP, mkldnn_eltwise_exp);
+    CASE(GELU, mkldnn_eltwise_gelu);
+#undef CASE
+    assert(!"unknown algorithm");
+    return mkldnn_alg_kind_undef;
+}
+
+dims_t str2dims(const char *str) {
+    dims_t dims;
+    do {
+        int dim, len;
+        int scan = sscanf(str, "%d%n", &dim, &len);
+        SAFE_V(scan == 1 ? OK : FAIL);
+        dims.push_back(dim);
+        str += len;
+        SAFE_V(*str == 'x' || *str == '\0' ? OK : FAIL);
+    } while (*str++ != '\0');
+    return dims;
+}
+
+void dims2str(const dims_t &dims, char *buffer) {
+    int rem_len = max_dims_len;
+    for (size_t d = 0; d < dims.size() - 1; ++d)
+        DPRINT("%dx", dims[d]);
+    DPRINT("%d", dims[dims.size() - 1]);
+}
+
+void prb2str(const prb_t *p, char *buffer, bool canonical) {
+    char dims_buf[max_dims_len] = {0};
+    dims2str(p->dims, dims_buf);
+
+    char dir_str[32] = {0};
+    char dt_str[16] = {0};
+    char fmt_str[32] = {0};
+    char alg_str[32] = {0};
+    char alpha_str[32] = {0};
+    char beta_str[32] = {0};
+
+    snprintf(dir_str, sizeof(dir_str), "--dir=%s ", dir2str(p->dir));
+    snprintf(dt_str, sizeof(dt_str), "--dt=%s ", dt2str(p->dt));
+    snprintf(fmt_str, sizeof(fmt_str), "--fmt=%s ", fmt2str(p->fmt));
+    snprintf(alg_str, sizeof(alg_str), "--alg=%s ", alg2str(p->alg));
+    snprintf(alpha_str, sizeof(alpha_str), "--alpha=%g ", p->alpha);
+    snprintf(beta_str, sizeof(beta_str), "--beta=%g ", p->beta);
+    snprintf(buffer, max_prb_len, "%s%s%s%s%s%s%s",
+            canonical || p->dir != FWD_D ? dir_str : "",
+            canonical || p->dt != mkldnn_f32 ? dt_str : "",
+            fmt_str, alg_str,
+            canonical || p->alpha != 0.f ? alpha_str : "",
+            canonical || p->beta != 0.f ? beta_str : "",
+            dims_buf);
+}
+
+}
@@ -0,0 +1,86 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <math.h>
+
+#include "src/common/mkldnn_thread.hpp"
+#include "src/common/math_utils.hpp"
+
+#include "eltwise/eltwise.hpp"
+
+namespace eltwise {
+
+float compute_fwd(const prb_t *p, float s) {
+    using namespace mkldnn::impl::math;
+
+    const float a = p->alpha, b = p->beta;
+    switch (p->alg) {
+    case RELU: return relu_fwd(s, a);
+    case TANH: return tanh_fwd(s);
+    case ELU: return elu_fwd(s, a);
+    case SQUARE: return square_fwd(s);
+    case ABS: return abs_fwd(s);
+    case SQRT: return sqrt_fwd(s);
+    case LINEAR: return linear_fwd(s, a, b);
+    case BRELU: return bounded_relu_fwd(s, a);
+    case SRELU: return soft_relu_fwd(s);
+    case LOGISTIC: return logistic_fwd(s);
+    case EXP: return exp_fwd(s);
+    case GELU: return gelu_fwd(s);
+    default: assert(!"unknown algorithm");
+    }
+    return NAN;
+}
+
+float compute_bwd(const prb_t *p, float dd, float s) {
+    using namespace mkldnn::impl::math;
+
+    const float a = p->alpha, b = p->beta;
+    switch (p->alg) {
+    case RELU: return relu_bwd(dd, s, a);
+    case TANH: return tanh_bwd(dd, s);
+    case ELU: return elu_bwd(dd, s, a);
+    case SQUARE: return square_bwd(dd, s);
+    case ABS: return abs_bwd(dd, s);
+    case SQRT: return sqrt_bwd(dd, s);
+    case LINEAR: return linear_bwd(dd, s, a, b);
+    case BRELU: return bounded_relu_bwd(dd, s, a);
+    case SRELU: return soft_relu_bwd(dd, s);
+    case LOGISTIC: return logistic_bwd(dd, s);
+    case EXP: return exp_bwd(dd, s);
+    case GELU: return gelu_bwd(dd, s);
+    default: assert(!"unknown algorithm");
+    }
+    return NAN;
+}
+
+void compute_ref_fwd(const prb_t *p, const dnn_mem_t &src, dnn_mem_t &dst) {
+    const ptrdiff_t n = (ptrdiff_t)nelems(p);
+    mkldnn::impl::parallel_nd(n, [&](ptrdiff_t i) {
+        dst.set_elem(i, compute_fwd(p, src.get_elem(i)));
+    });
+}
+
+void compute_ref_bwd(const prb_t *p, const dnn_mem_t &src,
+        const dnn_mem_t &diff_dst, dnn_mem_t &diff_src) {
+    const ptrdiff_t n = (ptrdiff_t)nelems(p);
+    mkldnn::impl::parallel_nd(n, [&](ptrdiff_t i) {
+        diff_src.set_elem(i,
+                compute_bwd(p, diff_dst.get_elem(i), src.get_elem(i)));
+    });
+}
+
+}
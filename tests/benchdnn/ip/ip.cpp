@@ -309,6 +309,7 @@ int doit(const prb_t *p, res_t *r) {
                         && t.times() >= min_times_per_prb);
             if (stop) break;
         }
+        SAFE(measure_throughput(ip), WARN);
     }
 
     DNN_SAFE(mkldnn_primitive_desc_destroy(ippd), CRIT);
@@ -43,6 +43,7 @@ table of modifiers below.
 | %q            | data type (precision)
 | %@t           | time in ms
 | %@p           | elements per second
+| %@H<x>        | hardware counters and roofline metrics, see README.md
 
 | modifier  | description
 |:--------  |:-----------
@@ -59,6 +60,11 @@ table of modifiers below.
 
 void perf_report(const prb_t *p, const res_t *r, const char *pstr) {
     const auto &t = r->timer;
+    const double spatial = (double)p->id * p->ih * p->iw;
+    const double bytes = 0.
+        + (double)sizeof_dt(p->cfg[SRC].dt) * p->mb * p->ic * spatial
+        + (double)sizeof_dt(p->cfg[WEI].dt) * p->oc * p->ic * spatial
+        + (double)sizeof_dt(p->cfg[DST].dt) * p->mb * p->oc;
     const int max_len = 400;
     int rem_len = max_len - 1;
     char buffer[max_len], *buf = buffer;
@@ -122,6 +128,12 @@ void perf_report(const prb_t *p, const res_t *r, const char *pstr) {
             DPRINT("%g", ops / unit);
         else if (c == 'p')
             DPRINT("%g", ops / t.ms(mode) / unit * 1e3);
+        else if (c == 'H') {
+            const int l = perf_counters::report(buf, rem_len, *pt, t, mode,
+                    unit, ops, bytes);
+            if (l < 0) []() { SAFE(FAIL, CRIT); return 0; }();
+            ++pt; buf += l; rem_len -= l;
+        }
         else
             []() { SAFE(FAIL, CRIT); return 0; }();
     }
@@ -0,0 +1,253 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <float.h>
+#include <math.h>
+
+#include "mkldnn.h"
+
+#include "mkldnn_common.hpp"
+#include "mkldnn_memory.hpp"
+#include "norm.hpp"
+
+#include "lrn/lrn.hpp"
+
+namespace lrn {
+
+/* the values are multiples of 1/8 within [-4, 4], so that they are exact
+ * in bf16 as well */
+static int fill_data(dnn_mem_t &mem, int seed) {
+    const size_t nelems = mem.nelems();
+    for (size_t idx = 0; idx < nelems; ++idx) {
+        const float value = ((int)((idx + seed) * 37 % 65) - 32) / 8.f;
+        mem.set_elem(idx, value);
+    }
+    return OK;
+}
+
+static int compare(const prb_t *p, const dnn_mem_t &fp_mem,
+        const dnn_mem_t &dt_mem, res_t *r) {
+    const float trh = p->dt == mkldnn_bf16 ? 1e-2 : 1e-5;
+
+    const size_t nelems = fp_mem.nelems();
+    r->errors = 0;
+    r->total = nelems;
+
+    diff_norm_t diff_norm;
+    for (size_t i = 0; i < nelems; ++i) {
+        const float fp = ((const float *)fp_mem)[i];
+        const float dt = ((const float *)dt_mem)[i];
+        diff_norm.update(fp, dt);
+
+        const float diff = fabsf(fp - dt);
+        const float rel_diff = diff / (fabsf(fp) > FLT_MIN ? fabsf(fp) : 1);
+        const bool ok = (fabsf(fp) > 1e-5 ? rel_diff : diff) <= trh;
+
+        r->errors += !ok;
+
+        const bool dump = false
+            || (!ok && (r->errors < 10 || verbose >= 10))
+            || (verbose >= 50 && i < 30) || (verbose >= 99);
+        if (dump) {
+            int mb, c, h, w;
+            inv_data_off(p, i, mb, c, h, w);
+            print(0, "[%lu][%s][%d,%d,%d,%d] fp:%8g dt:%8g diff:%8g "
+                    "rdiff:%8g\n", (unsigned long)i,
+                    p->dir & FLAG_BWD ? "D_SRC" : "DST", mb, c, h, w,
+                    fp, dt, diff, rel_diff);
+        }
+    }
+
+    diff_norm.done();
+
+    if (r->errors || verbose >= 5) {
+        const int vl = r->errors ? 0 : 2;
+        print(vl, "@@@ [%s] diff: l0(``%g``) "
+                "l1:(%g,%g,%g,``%g``) "
+                "l2:(%g,%g,%g,``%g``) "
+                "l8:(%g,%g,%g,``%g``)\n",
+                p->dir & FLAG_BWD ? "D_SRC" : "DST",
+                diff_norm.rel_diff(norm_t::L0),
+                diff_norm.a_[norm_t::L1], diff_norm.b_[norm_t::L1],
+                diff_norm.diff_[norm_t::L1], diff_norm.rel_diff(norm_t::L1),
+                diff_norm.a_[norm_t::L2], diff_norm.b_[norm_t::L2],
+                diff_norm.diff_[norm_t::L2], diff_norm.rel_diff(norm_t::L2),
+                diff_norm.a_[norm_t::L8], diff_norm.b_[norm_t::L8],
+                diff_norm.diff_[norm_t::L8], diff_norm.rel_diff(norm_t::L8));
+    }
+
+    if (r->errors)
+        r->state = FAILED;
+
+    if (r->state == UNTESTED)
+        r->state = PASSED; /* optimism */
+
+    return r->state == FAILED ? FAIL : OK;
+}
+
+/* for the backward pass @p fpd is the forward training primitive descriptor,
+ * which is used to produce the workspace */
+static int init_pd(const prb_t *p, mkldnn_lrn_desc_t &ld,
+        mkldnn_primitive_desc_t &lpd, mkldnn_primitive_desc_t &fpd,
+        res_t *r) {
+    mkldnn_memory_desc_t data_d;
+    mkldnn_dims_t data_dims = {p->mb, p->ic, p->ih, p->iw};
+    DNN_SAFE(mkldnn_memory_desc_init(&data_d, 4, data_dims, p->dt, p->fmt),
+            WARN);
+
+    const auto alg = alg2alg_kind(p->alg);
+    fpd = NULL;
+    if (p->dir & FLAG_FWD) {
+        auto prop = p->dir & FLAG_INF
+            ? mkldnn_forward_inference : mkldnn_forward_training;
+        DNN_SAFE(mkldnn_lrn_forward_desc_init(&ld, prop, alg, &data_d, p->ls,
+                    p->alpha, p->beta, p->k), WARN);
+    } else {
+        DNN_SAFE(mkldnn_lrn_backward_desc_init(&ld, alg, &data_d, &data_d,
+                    p->ls, p->alpha, p->beta, p->k), WARN);
+        mkldnn_lrn_desc_t ld_fwd;
+        DNN_SAFE(mkldnn_lrn_forward_desc_init(&ld_fwd,
+                    mkldnn_forward_training, alg, &data_d, p->ls, p->alpha,
+                    p->beta, p->k), WARN);
+        mkldnn_status_t init_status = mkldnn_primitive_desc_create(&fpd,
+                &ld_fwd, engine, NULL);
+        // if fwd pass is unimplemented, bwd pass is useless
+        if (init_status == mkldnn_unimplemented)
+            return r->state = UNIMPLEMENTED, OK;
+        else
+            SAFE(init_status, WARN);
+    }
+
+    mkldnn_status_t init_status = mkldnn_primitive_desc_create(&lpd, &ld,
+            engine, fpd);
+
+    if (init_status == mkldnn_unimplemented) {
+        mkldnn_primitive_desc_destroy(fpd);
+        return r->state = UNIMPLEMENTED, OK;
+    } else
+        SAFE(init_status, WARN);
+
+    const char *impl_str = query_impl_info(lpd);
+    if (maybe_skip(skip_impl, impl_str)) {
+        print(2, "SKIPPED: mkldnn implementation: %s\n", impl_str);
+        DNN_SAFE(mkldnn_primitive_desc_destroy(lpd), WARN);
+        mkldnn_primitive_desc_destroy(fpd);
+        return r->state = SKIPPED, OK;
+    } else {
+        print(5, "mkldnn implementation: %s\n", impl_str);
+    }
+
+    return OK;
+}
+
+int doit(const prb_t *p, res_t *r) {
+    res_t res_zero{};
+    *r = res_zero;
+
+    mkldnn_lrn_desc_t ld;
+    mkldnn_primitive_desc_t lpd, fpd;
+    mkldnn_primitive_t l{};
+
+    SAFE(init_pd(p, ld, lpd, fpd, r), WARN);
+    if (r->state == SKIPPED || r->state == UNIMPLEMENTED)
+        return OK;
+
+    const auto fp = mkldnn_f32;
+    auto &data_dt_d = ld.data_desc;
+
+    dnn_mem_t src_fp(data_dt_d, fp, mkldnn_nchw), src_dt(data_dt_d);
+    dnn_mem_t dst_fp(data_dt_d, fp, mkldnn_nchw), dst_dt(data_dt_d);
+    dnn_mem_t d_src_fp(data_dt_d, fp, mkldnn_nchw), d_src_dt(data_dt_d);
+
+    const auto ws_pd = mkldnn_primitive_desc_query_pd(lpd,
+            mkldnn_query_workspace_pd, 0);
+    dnn_mem_t *p_ws_dt = ws_pd
+        ? new dnn_mem_t(*mkldnn_primitive_desc_query_memory_d(ws_pd))
+        : new dnn_mem_t();
+    dnn_mem_t &ws_dt = *p_ws_dt;
+
+    SAFE(fill_data(src_fp, 0), WARN);
+    SAFE(src_dt.reorder(src_fp), WARN);
+
+    if (p->dir & FLAG_FWD) {
+        mkldnn_primitive_at_t inputs[1] = { {src_dt.p_, 0} };
+        const_mkldnn_primitive_t outputs[2] = { dst_dt.p_, NULL };
+        if (ws_pd) outputs[1] = ws_dt.p_;
+
+        DNN_SAFE(mkldnn_primitive_create(&l, lpd, inputs, outputs), WARN);
+        SAFE(execute(l), WARN);
+        if (bench_mode & CORR) {
+            compute_ref_fwd(p, src_fp, dst_fp);
+            dnn_mem_t dst(dst_dt, fp, mkldnn_nchw);
+            SAFE(compare(p, dst_fp, dst, r), WARN);
+        }
+    } else {
+        /* dst_* hold the diff_dst */
+        SAFE(fill_data(dst_fp, 1), WARN);
+        SAFE(dst_dt.reorder(dst_fp), WARN);
+
+        if (ws_pd) {
+            /* the workspace is produced by the forward pass */
+            dnn_mem_t fwd_dst_dt(data_dt_d);
+            mkldnn_primitive_t f{};
+            mkldnn_primitive_at_t f_inputs[1] = { {src_dt.p_, 0} };
+            const_mkldnn_primitive_t f_outputs[2] = { fwd_dst_dt.p_,
+                ws_dt.p_ };
+            DNN_SAFE(mkldnn_primitive_create(&f, fpd, f_inputs, f_outputs),
+                    WARN);
+            SAFE(execute(f), WARN);
+            DNN_SAFE_V(mkldnn_primitive_destroy(f));
+        }
+
+        mkldnn_primitive_at_t inputs[3] = { {src_dt.p_, 0}, {dst_dt.p_, 0},
+            {NULL, 0} };
+        if (ws_pd) inputs[2] = {ws_dt.p_, 0};
+        const_mkldnn_primitive_t outputs[1] = { d_src_dt.p_ };
+        DNN_SAFE(mkldnn_primitive_create(&l, lpd, inputs, outputs), WARN);
+        SAFE(execute(l), WARN);
+        if (bench_mode & CORR) {
+            compute_ref_bwd(p, src_fp, dst_fp, d_src_fp);
+            dnn_mem_t d_src(d_src_dt, fp, mkldnn_nchw);
+            SAFE(compare(p, d_src_fp, d_src, r), WARN);
+        }
+    }
+
+    if (bench_mode & PERF) {
+        auto &t = r->timer;
+        t.reset();
+        while (true) {
+            SAFE(execute(l), WARN);
+            t.stamp();
+            const bool stop = false
+                || (fix_times_per_prb && t.times() >= fix_times_per_prb)
+                || (!fix_times_per_prb
+                        && t.total_ms() >= max_ms_per_prb
+                        && t.times() >= min_times_per_prb);
+            if (stop) break;
+        }
+    }
+
+    delete p_ws_dt;
+    DNN_SAFE_V(mkldnn_primitive_desc_destroy(lpd));
+    mkldnn_primitive_desc_destroy(fpd);
+    DNN_SAFE_V(mkldnn_primitive_destroy(l));
+    return OK;
+}
+
+}
@@ -0,0 +1,150 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <stdlib.h>
+#include <assert.h>
+#include "lrn/lrn.hpp"
+
+namespace lrn {
+
+alg_t str2alg(const char *str) {
+#define CASE(_alg) if (!strcasecmp(STRINGIFY(_alg), str)) return _alg
+    CASE(ACROSS);
+    CASE(WITHIN);
+#undef CASE
+    assert(!"unknown algorithm");
+    return ACROSS;
+}
+
+const char *alg2str(alg_t alg) {
+    if (alg == ACROSS) return "ACROSS";
+    if (alg == WITHIN) return "WITHIN";
+    assert(!"unknown algorithm");
+    return "unknown algorithm";
+}
+
+mkldnn_alg_kind_t alg2alg_kind(alg_t alg) {
+    if (alg == ACROSS) return mkldnn_lrn_across_channels;
+    if (alg == WITHIN) return mkldnn_lrn_within_channel;
+    assert(!"unknown algorithm");
+    return mkldnn_alg_kind_undef;
+}
+
+int str2desc(desc_t *desc, const char *str) {
+    /* canonical form:
+     * mbXicXihXiwXlsXalphaYbetaYkYnS
+     *
+     * where:
+     *  X is number (integer)
+     *  Y is real (float)
+     *  S - string
+     * note: symbol `_` is ignored
+     *
+     * implicit rules:
+     *  mb = 2
+     *  ls = 5, alpha = 1e-4, beta = 0.75, k = 1
+     *  S = "wip"
+     *  if iw is unset iw <-- ih
+     *  if ih is unset ih <-- iw
+     */
+
+    desc_t d{0};
+    d.mb = 2;
+    d.ls = 5;
+    d.alpha = 1e-4f;
+    d.beta = 0.75f;
+    d.k = 1.f;
+    d.name = "\"wip\"";
+
+    const char *s = str;
+    assert(s);
+
+    auto mstrtol = [](const char *nptr, char **endptr)
+    { return strtol(nptr, endptr, 10); };
+
+#   define CASE_NN(p, c, cvfunc) do { \
+        if (!strncmp(p, s, strlen(p))) { \
+            ok = 1; s += strlen(p); \
+            char *end_s; d. c = cvfunc(s, &end_s); s += (end_s - s); \
+        } \
+    } while (0)
+#   define CASE_N(c, cvfunc) CASE_NN(#c, c, cvfunc)
+    while (*s) {
+        int ok = 0;
+        CASE_N(mb, mstrtol);
+        CASE_N(ic, mstrtol);
+        CASE_N(ih, mstrtol);
+        CASE_N(iw, mstrtol);
+        CASE_N(ls, mstrtol);
+        CASE_N(alpha, strtof);
+        CASE_N(beta, strtof);
+        CASE_N(k, strtof);
+        if (*s == 'n') { d.name = s + 1; break; }
+        if (*s == '_') ++s;
+        if (!ok) return FAIL;
+    }
+#   undef CASE_NN
+#   undef CASE_N
+
+    if (d.ih == 0) d.ih = d.iw;
+    if (d.iw == 0) d.iw = d.ih;
+    if (d.ic == 0 || d.ih == 0 || d.iw == 0 || d.ls <= 0) return FAIL;
+
+    *desc = d;
+
+    return OK;
+}
+
+void desc2str(const desc_t *d, char *buffer, bool canonical) {
+    int rem_len = max_desc_len;
+#   define DPRINT(...) do { \
+        int l = snprintf(buffer, rem_len, __VA_ARGS__); \
+        buffer += l; rem_len -= l; \
+    } while(0)
+
+    if (canonical || d->mb != 2) DPRINT("mb%d", d->mb);
+    DPRINT("ic%d", d->ic);
+    DPRINT("ih%d", d->ih);
+    if (canonical || d->iw != d->ih) DPRINT("iw%d", d->iw);
+    if (canonical || d->ls != 5) DPRINT("ls%d", d->ls);
+    if (canonical || d->alpha != 1e-4f) DPRINT("alpha%g", d->alpha);
+    if (canonical || d->beta != 0.75f) DPRINT("beta%g", d->beta);
+    if (canonical || d->k != 1.f) DPRINT("k%g", d->k);
+    DPRINT("n%s", d->name);
+
+#   undef DPRINT
+}
+
+void prb2str(const prb_t *p, char *buffer, bool canonical) {
+    char desc_buf[max_desc_len];
+    char dir_str[32] = {0};
+    char dt_str[16] = {0};
+    char fmt_str[32] = {0};
+    char alg_str[32] = {0};
+    desc2str(p, desc_buf, canonical);
+    snprintf(dir_str, sizeof(dir_str), "--dir=%s ", dir2str(p->dir));
+    snprintf(dt_str, sizeof(dt_str), "--dt=%s ", dt2str(p->dt));
+    snprintf(fmt_str, sizeof(fmt_str), "--fmt=%s ", fmt2str(p->fmt));
+    snprintf(alg_str, sizeof(alg_str), "--alg=%s ", alg2str(p->alg));
+    snprintf(buffer, max_prb_len, "%s%s%s%s%s",
+            p->dir == FWD_D ? "" : dir_str,
+            p->dt == mkldnn_f32 ? "" : dt_str,
+            p->fmt == mkldnn_nchw ? "" : fmt_str,
+            p->alg == ACROSS ? "" : alg_str,
+            desc_buf);
+}
+
+}
@@ -0,0 +1,108 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <math.h>
+
+#include "src/common/mkldnn_thread.hpp"
+
+#include "lrn/lrn.hpp"
+
+namespace lrn {
+
+/* omega = k + alpha / summands * sum(src^2) over the window around the point,
+ * the window being the same for all the points it covers */
+static float omega(const prb_t *p, const dnn_mem_t &src, int mb, int c, int h,
+        int w) {
+    const int half = (p->ls - 1) / 2;
+    const int summands = p->alg == ACROSS ? p->ls : p->ls * p->ls;
+
+    float sum = 0;
+    if (p->alg == ACROSS) {
+        const int c_st = MAX2(c - half, 0);
+        const int c_en = MIN2(c + half + 1, p->ic);
+        for (int cs = c_st; cs < c_en; ++cs) {
+            const float s = ((const float *)src)[data_off(p, mb, cs, h, w)];
+            sum += s * s;
+        }
+    } else {
+        const int h_st = MAX2(h - half, 0);
+        const int h_en = MIN2(h + half + 1, p->ih);
+        const int w_st = MAX2(w - half, 0);
+        const int w_en = MIN2(w + half + 1, p->iw);
+        for (int hs = h_st; hs < h_en; ++hs)
+        for (int ws = w_st; ws < w_en; ++ws) {
+            const float s = ((const float *)src)[data_off(p, mb, c, hs, ws)];
+            sum += s * s;
+        }
+    }
+
+    return p->k + p->alpha * sum / summands;
+}
+
+void compute_ref_fwd(const prb_t *p, const dnn_mem_t &src, dnn_mem_t &dst) {
+    mkldnn::impl::parallel_nd(p->mb, p->ic, p->ih, p->iw,
+            [&](int mb, int c, int h, int w) {
+        const size_t off = data_off(p, mb, c, h, w);
+        const float s = ((const float *)src)[off];
+        ((float *)dst)[off] = s * powf(omega(p, src, mb, c, h, w), -p->beta);
+    });
+}
+
+/* with dst_i = src_i * omega_i^-beta:
+ * diff_src_m = diff_dst_m * omega_m^-beta
+ *            - 2 * alpha * beta / summands * src_m
+ *              * sum(diff_dst_i * src_i * omega_i^(-beta - 1))
+ * where the sum goes over the points i whose window covers m, i.e. over the
+ * window around m */
+void compute_ref_bwd(const prb_t *p, const dnn_mem_t &src,
+        const dnn_mem_t &diff_dst, dnn_mem_t &diff_src) {
+    const int half = (p->ls - 1) / 2;
+    const int summands = p->alg == ACROSS ? p->ls : p->ls * p->ls;
+
+    mkldnn::impl::parallel_nd(p->mb, p->ic, p->ih, p->iw,
+            [&](int mb, int c, int h, int w) {
+        auto term = [&](int ci, int hi, int wi) {
+            const size_t off = data_off(p, mb, ci, hi, wi);
+            const float om = omega(p, src, mb, ci, hi, wi);
+            return ((const float *)diff_dst)[off] * ((const float *)src)[off]
+                * powf(om, -p->beta - 1);
+        };
+
+        float B = 0;
+        if (p->alg == ACROSS) {
+            const int c_st = MAX2(c - half, 0);
+            const int c_en = MIN2(c + half + 1, p->ic);
+            for (int ci = c_st; ci < c_en; ++ci)
+                B += term(ci, h, w);
+        } else {
+            const int h_st = MAX2(h - half, 0);
+            const int h_en = MIN2(h + half + 1, p->ih);
+            const int w_st = MAX2(w - half, 0);
+            const int w_en = MIN2(w + half + 1, p->iw);
+            for (int hi = h_st; hi < h_en; ++hi)
+            for (int wi = w_st; wi < w_en; ++wi)
+                B += term(c, hi, wi);
+        }
+
+        const size_t off = data_off(p, mb, c, h, w);
+        const float A = ((const float *)diff_dst)[off]
+            * powf(omega(p, src, mb, c, h, w), -p->beta);
+        B *= 2.f * p->alpha * p->beta / summands * ((const float *)src)[off];
+        ((float *)diff_src)[off] = A - B;
+    });
+}
+
+}
@@ -15,8 +15,182 @@
 *******************************************************************************/
 
 #include <assert.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
 #include "mkldnn.h"
 
 #include "mkldnn_common.hpp"
 
 mkldnn_engine_t engine;
+
+namespace {
+
+/* A copy of a primitive for the instance the calling thread is attached to.
+ * The primitive descriptor is created again, so that the work is blocked for
+ * the threads of the instance, unless the new one expects other inputs. The
+ * inputs are shared with the original primitive, the outputs are private. */
+struct instance_copy_t {
+    mkldnn_primitive_desc_t pd = NULL;
+    mkldnn_primitive_t p = NULL;
+    std::vector<mkldnn_primitive_t> outputs;
+    std::vector<void *> buffers;
+
+    ~instance_copy_t() {
+        if (p) mkldnn_primitive_destroy(p);
+        for (auto o: outputs) mkldnn_primitive_destroy(o);
+        for (auto b: buffers) zfree(b);
+        if (pd) mkldnn_primitive_desc_destroy(pd);
+    }
+
+    int init(const_mkldnn_primitive_t orig) {
+        const_mkldnn_primitive_desc_t opd;
+        DNN_SAFE(mkldnn_primitive_get_primitive_desc(orig, &opd), WARN);
+
+        int n_inputs = 0, n_outputs = 0;
+        DNN_SAFE(mkldnn_primitive_desc_query(opd,
+                    mkldnn_query_num_of_inputs_s32, 0, &n_inputs), WARN);
+        DNN_SAFE(mkldnn_primitive_desc_query(opd,
+                    mkldnn_query_num_of_outputs_s32, 0, &n_outputs), WARN);
+
+        std::vector<mkldnn_primitive_at_t> inputs(n_inputs);
+        for (int i = 0; i < n_inputs; ++i)
+            DNN_SAFE(mkldnn_primitive_get_input_at(orig, i, &inputs[i]),
+                    WARN);
+
+        const_mkldnn_op_desc_t op_d;
+        const_mkldnn_primitive_attr_t attr;
+        if (mkldnn_primitive_desc_query(opd, mkldnn_query_op_d, 0, &op_d)
+                    == mkldnn_success
+                && mkldnn_primitive_desc_get_attr(opd, &attr)
+                    == mkldnn_success
+                && mkldnn_primitive_desc_create_v2(&pd, op_d, attr, engine,
+                    NULL) == mkldnn_success) {
+            bool same_inputs = true;
+            for (int i = 0; i < n_inputs; ++i) {
+                const_mkldnn_primitive_desc_t ipd;
+                DNN_SAFE(mkldnn_primitive_get_primitive_desc(
+                            inputs[i].primitive, &ipd), WARN);
+                same_inputs = same_inputs && mkldnn_memory_primitive_desc_equal(
+                        ipd, mkldnn_primitive_desc_query_pd(pd,
+                            mkldnn_query_input_pd, i));
+            }
+            if (!same_inputs) {
+                mkldnn_primitive_desc_destroy(pd);
+                pd = NULL;
+            }
+        }
+        if (pd == NULL)
+            DNN_SAFE(mkldnn_primitive_desc_clone(&pd, opd), WARN);
+
+        for (int i = 0; i < n_outputs; ++i) {
+            auto mpd = mkldnn_primitive_desc_query_pd(pd,
+                    mkldnn_query_output_pd, i);
+            void *buf = zmalloc(mkldnn_memory_primitive_desc_get_size(mpd),
+                    64);
+            if (buf == NULL) return FAIL;
+            buffers.push_back(buf);
+            mkldnn_primitive_t o;
+            DNN_SAFE(mkldnn_primitive_create(&o, mpd, NULL, NULL), WARN);
+            outputs.push_back(o);
+            DNN_SAFE(mkldnn_memory_set_data_handle(o, buf), WARN);
+        }
+
+        std::vector<const_mkldnn_primitive_t> c_outputs(outputs.begin(),
+                outputs.end());
+        DNN_SAFE(mkldnn_primitive_create(&p, pd, inputs.data(),
+                    c_outputs.data()), WARN);
+        return OK;
+    }
+};
+
+/* runs copies of @p p on @p ninst instances of @p nthr threads each, and
+ * returns the executions per second summed over the instances */
+int run_instances(const_mkldnn_primitive_t p, int ninst, int nthr,
+        double &execs_per_sec) {
+    std::vector<std::thread> threads;
+    std::vector<int> status(ninst, OK);
+    std::vector<double> eps(ninst, 0);
+    std::atomic<int> ready(0);
+
+    for (int i = 0; i < ninst; ++i)
+        threads.emplace_back([&, i]() {
+            mkldnn_instance_t inst = NULL;
+            instance_copy_t copy;
+            int st = FAIL;
+            if (mkldnn_instance_create(&inst, nthr, i * nthr)
+                    == mkldnn_success) {
+                /* the cpus may be out of the affinity mask of the process */
+                if (mkldnn_instance_attach(inst) != mkldnn_success) {
+                    mkldnn_instance_destroy(inst);
+                    inst = NULL;
+                    if (mkldnn_instance_create(&inst, nthr, -1)
+                            != mkldnn_success)
+                        inst = NULL;
+                    else if (mkldnn_instance_attach(inst) != mkldnn_success)
+                        mkldnn_instance_destroy(inst), inst = NULL;
+                }
+                if (inst) st = copy.init(p);
+                if (st == OK) st = execute(copy.p); /* warm up */
+            }
+            status[i] = st;
+
+            /* start the timed loops together */
+            ready++;
+            while (ready < ninst)
+                std::this_thread::yield();
+
+            if (st == OK) {
+                using clock = std::chrono::steady_clock;
+                const auto start = clock::now();
+                int times = 0;
+                double ms = 0;
+                while (status[i] == OK) {
+                    status[i] = execute(copy.p);
+                    ++times;
+                    ms = std::chrono::duration<double, std::milli>(
+                            clock::now() - start).count();
+                    const bool stop = false
+                        || (fix_times_per_prb && times >= fix_times_per_prb)
+                        || (!fix_times_per_prb && ms >= max_ms_per_prb
+                                && times >= min_times_per_prb);
+                    if (stop) break;
+                }
+                eps[i] = 1e3 * times / ms;
+            }
+
+            mkldnn_instance_detach();
+            if (inst) mkldnn_instance_destroy(inst);
+        });
+
+    for (auto &t: threads)
+        t.join();
+
+    execs_per_sec = 0;
+    for (int i = 0; i < ninst; ++i) {
+        if (status[i] != OK) return FAIL;
+        execs_per_sec += eps[i];
+    }
+    return OK;
+}
+
+}
+
+int measure_throughput(const_mkldnn_primitive_t p) {
+    const int ncpus = mkldnn_instance_get_max_threads();
+    for (int ninst: throughput_instances) {
+        const int nthr = ninst > 0 ? ncpus / ninst : 0;
+        if (nthr < 1) continue;
+        double execs_per_sec = 0;
+        if (run_instances(p, ninst, nthr, execs_per_sec) != OK) {
+            print(0, "throughput,instances:%d,nthr:%d,failed\n", ninst,
+                    nthr);
+            continue;
+        }
+        print(0, "throughput,instances:%d,nthr:%d,execs/s:%g\n", ninst,
+                nthr, execs_per_sec);
+    }
+    return OK;
+}
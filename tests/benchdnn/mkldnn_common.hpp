@@ -86,6 +86,11 @@ inline int execute(mkldnn_primitive_t p) {
     return OK;
 }
 
+/* throughput mode: for every N of throughput_instances runs a copy of @p p
+ * on each of N instances of (number of threads / N) threads at the same time, and
+ * prints the executions per second summed over the instances */
+int measure_throughput(const_mkldnn_primitive_t p);
+
 inline int init() {
     DNN_SAFE(mkldnn_engine_create(&engine, mkldnn_cpu, 0), CRIT);
     return OK;
@@ -0,0 +1,343 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <vector>
+
+#if defined(__linux__)
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#if defined(__aarch64__)
+#include <sys/prctl.h>
+#endif
+#endif
+
+#include "src/common/mkldnn_thread.hpp"
+
+#include "common.hpp"
+#include "perf_counters.hpp"
+
+namespace perf_counters {
+
+bool enabled = false;
+double peak_gflops = 0;
+double peak_gbps = 0;
+
+const char *event2str(event_t event) {
+    switch (event) {
+    case CYCLES: return "cycles";
+    case INSTRUCTIONS: return "instructions";
+    case L1D_MISSES: return "L1-dcache-load-misses";
+    case LLC_MISSES: return "cache-misses";
+    case STALLS_BACKEND: return "stalled-cycles-backend";
+    default: assert(!"unknown event");
+    }
+    return "unknown event";
+}
+
+#if defined(__linux__)
+
+namespace {
+
+struct event_attr_t { uint32_t type; uint64_t config; };
+
+const event_attr_t event_attrs[n_events] = {
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+    { PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D
+        | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+        | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16) },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_STALLED_CYCLES_BACKEND },
+};
+
+/* the counters of one thread: a group led by the first event that could be
+ * opened, so that all the events are scheduled together */
+struct thread_group_t {
+    pid_t tid;
+    int fd[n_events];
+};
+
+std::vector<thread_group_t> groups;
+bool event_ok[n_events];
+
+long perf_event_open(perf_event_attr *attr, pid_t pid, int cpu, int group_fd,
+        unsigned long flags) {
+    return syscall(__NR_perf_event_open, attr, pid, cpu, group_fd, flags);
+}
+
+void open_group(thread_group_t &g) {
+    g.tid = (pid_t)syscall(SYS_gettid);
+    int leader = -1;
+    for (int e = 0; e < n_events; ++e) {
+        perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = event_attrs[e].type;
+        attr.config = event_attrs[e].config;
+        attr.disabled = leader == -1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED
+            | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        g.fd[e] = (int)perf_event_open(&attr, 0, -1, leader, 0);
+        if (g.fd[e] >= 0 && leader == -1) leader = g.fd[e];
+    }
+    if (leader != -1) {
+        ioctl(leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+}
+
+double read_event(int fd) {
+    if (fd < 0) return 0;
+    uint64_t v[3]; /* value, time enabled, time running */
+    if (::read(fd, v, sizeof(v)) != (ssize_t)sizeof(v) || v[2] == 0)
+        return 0;
+    return v[2] < v[1] ? (double)v[0] * v[1] / v[2] : (double)v[0];
+}
+
+}
+
+void init() {
+    if (!enabled || !groups.empty()) return;
+
+    /* the counters count the calling thread only, hence the group is opened
+     * from every thread of the library. Tasks of the TBB and threadpool
+     * runtimes are not bound to threads, so some threads may be missed
+     * there, and a thread met twice is only counted once */
+    const int nthr = mkldnn_get_max_threads();
+    std::vector<thread_group_t> per_ithr(nthr);
+    for (auto &g : per_ithr) {
+        g.tid = 0;
+        for (int e = 0; e < n_events; ++e) g.fd[e] = -1;
+    }
+    mkldnn::impl::parallel(nthr, [&](int ithr, int) {
+        open_group(per_ithr[ithr]);
+    });
+
+    for (int e = 0; e < n_events; ++e) event_ok[e] = false;
+    for (auto &g : per_ithr) {
+        bool dup = false;
+        for (auto &h : groups) dup = dup || h.tid == g.tid;
+        if (dup || g.tid == 0) {
+            for (int e = 0; e < n_events; ++e)
+                if (g.fd[e] >= 0) close(g.fd[e]);
+            continue;
+        }
+        groups.push_back(g);
+        for (int e = 0; e < n_events; ++e)
+            event_ok[e] = event_ok[e] || g.fd[e] >= 0;
+    }
+
+    char missing[256] = {0};
+    for (int e = 0; e < n_events; ++e) {
+        if (event_ok[e]) continue;
+        const size_t len = strlen(missing);
+        snprintf(missing + len, sizeof(missing) - len, "%s%s",
+                len ? ", " : "", event2str((event_t)e));
+    }
+    if (missing[0])
+        print(0, "warning: perf counters not available: %s\n", missing);
+}
+
+void finalize() {
+    for (auto &g : groups)
+        for (int e = 0; e < n_events; ++e)
+            if (g.fd[e] >= 0) close(g.fd[e]);
+    groups.clear();
+    for (int e = 0; e < n_events; ++e) event_ok[e] = false;
+}
+
+bool available(event_t event) { return enabled && event_ok[event]; }
+
+void read(double values[n_events]) {
+    for (int e = 0; e < n_events; ++e) values[e] = 0;
+    for (auto &g : groups)
+        for (int e = 0; e < n_events; ++e)
+            values[e] += read_event(g.fd[e]);
+}
+
+#else
+
+void init() {
+    if (enabled)
+        print(0, "%s\n", "warning: perf counters are only supported on Linux");
+}
+void finalize() {}
+bool available(event_t event) { return false; }
+void read(double values[n_events]) {
+    for (int e = 0; e < n_events; ++e) values[e] = 0;
+}
+
+#endif
+
+namespace {
+
+/* the maximum frequency of the first cpu in GHz, 0 if unknown */
+double cpu_max_ghz() {
+    double ghz = 0;
+#if defined(__linux__)
+    FILE *f = fopen("/sys/devices/system/cpu/cpu0/cpufreq/cpuinfo_max_freq",
+            "r");
+    if (f) {
+        long khz = 0;
+        if (fscanf(f, "%ld", &khz) == 1) ghz = khz / 1e6;
+        fclose(f);
+    }
+#endif
+    return ghz;
+}
+
+/* f32 flops per cycle of a core: two FMA pipes of the widest vector length
+ * available, 0 if unknown */
+double flops_per_cycle() {
+#if defined(__aarch64__)
+    int vl_bytes = 16; /* ASIMD */
+#if defined(__linux__) && defined(PR_SVE_GET_VL)
+    const int vl = prctl(PR_SVE_GET_VL);
+    if (vl > 0) vl_bytes = vl & PR_SVE_VL_LEN_MASK;
+#endif
+    return 2. * 2. * (vl_bytes / 4);
+#else
+    return 0;
+#endif
+}
+
+/* the bandwidth of a parallel copy of buffers much larger than the caches,
+ * counting the bytes read and written */
+double measure_gbps() {
+    const size_t size = (size_t)128 << 20;
+    char *src = (char *)zmalloc(size, 64);
+    char *dst = (char *)zmalloc(size, 64);
+    if (!src || !dst) {
+        zfree(src);
+        zfree(dst);
+        return 0;
+    }
+
+    const int nthr = mkldnn_get_max_threads();
+    auto copy = [&]() {
+        mkldnn::impl::parallel(nthr, [&](int ithr, int nthr_) {
+            size_t start = 0, end = 0;
+            mkldnn::impl::balance211(size, nthr_, ithr, start, end);
+            memcpy(dst + start, src + start, end - start);
+        });
+    };
+    memset(src, 1, size);
+    copy(); /* first touch */
+
+    benchdnn_timer_t t;
+    for (int i = 0; i < 5; ++i) {
+        t.start();
+        copy();
+        t.stop();
+    }
+
+    zfree(src);
+    zfree(dst);
+    return 2. * size / (t.ms(benchdnn_timer_t::min) * 1e6);
+}
+
+}
+
+double get_peak_gflops() {
+    static double detected = -1;
+    if (peak_gflops > 0) return peak_gflops;
+    if (detected < 0)
+        detected = mkldnn_get_max_threads() * cpu_max_ghz()
+            * flops_per_cycle();
+    return detected;
+}
+
+double get_peak_gbps() {
+    static double detected = -1;
+    if (peak_gbps > 0) return peak_gbps;
+    if (detected < 0) detected = measure_gbps();
+    return detected;
+}
+
+int report(char *buf, int rem_len, char c, const benchdnn_timer_t &t,
+        int mode, double unit, double ops, double bytes) {
+    const auto m = (benchdnn_timer_t::mode_t)mode;
+    const double ms = t.ms(m);
+    auto per_run = [&](event_t e) { return t.counters_[e] / t.times(); };
+    auto na = [&]() { return snprintf(buf, rem_len, "n/a"); };
+    auto val = [&](double v) { return snprintf(buf, rem_len, "%g", v); };
+
+    switch (c) {
+    case 'c':
+        if (!available(CYCLES)) return na();
+        return val(per_run(CYCLES) / unit);
+    case 'i':
+        if (!available(INSTRUCTIONS)) return na();
+        return val(per_run(INSTRUCTIONS) / unit);
+    case 'I':
+        if (!available(CYCLES) || !available(INSTRUCTIONS)
+                || t.counters_[CYCLES] == 0) return na();
+        return val(t.counters_[INSTRUCTIONS] / t.counters_[CYCLES]);
+    case 'l':
+        if (!available(L1D_MISSES)) return na();
+        return val(per_run(L1D_MISSES) / unit);
+    case 'L':
+        if (!available(L1D_MISSES) || bytes == 0) return na();
+        return val(per_run(L1D_MISSES) / bytes);
+    case 'm':
+        if (!available(LLC_MISSES)) return na();
+        return val(per_run(LLC_MISSES) / unit);
+    case 'M':
+        if (!available(LLC_MISSES) || bytes == 0) return na();
+        return val(per_run(LLC_MISSES) / bytes);
+    case 's':
+        if (!available(STALLS_BACKEND)) return na();
+        return val(per_run(STALLS_BACKEND) / unit);
+    case 'S':
+        if (!available(CYCLES) || !available(STALLS_BACKEND)
+                || t.counters_[CYCLES] == 0) return na();
+        return val(t.counters_[STALLS_BACKEND] / t.counters_[CYCLES]);
+    case 'b':
+        if (bytes == 0 || ms == 0) return na();
+        return val(bytes / ms * 1e3 / unit);
+    case 'r': {
+        /* the fraction of the roofline bound: min(peak compute, peak
+         * bandwidth x arithmetic intensity), or of the peak bandwidth when
+         * there is no compute to speak of */
+        if (ms == 0) return na();
+        const double pbw = bytes > 0 ? get_peak_gbps() : 0;
+        if (ops > 0) {
+            const double pflops = get_peak_gflops();
+            double bound = pflops;
+            if (pbw > 0) {
+                const double bw_bound = pbw * ops / bytes;
+                bound = bound > 0 ? MIN2(bound, bw_bound) : bw_bound;
+            }
+            if (bound <= 0) return na();
+            return val(ops / ms * 1e-6 / bound);
+        }
+        if (pbw <= 0) return na();
+        return val(bytes / ms * 1e-6 / pbw);
+    }
+    default: break;
+    }
+    return -1;
+}
+
+}
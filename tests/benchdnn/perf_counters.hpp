@@ -0,0 +1,69 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef _PERF_COUNTERS_HPP
+#define _PERF_COUNTERS_HPP
+
+/* Optional hardware performance counters sampled around the timed loop of
+ * the drivers (see benchdnn_timer_t). The counters are read with
+ * perf_event_open(2) on Linux, one group per thread of the library; on other
+ * systems, or when the kernel refuses to open them, they are unavailable and
+ * the corresponding perf template tokens print `n/a`. */
+
+struct benchdnn_timer_t;
+
+namespace perf_counters {
+
+enum event_t {
+    CYCLES = 0,
+    INSTRUCTIONS,
+    L1D_MISSES, /* L1 data cache read misses */
+    LLC_MISSES, /* last level cache misses */
+    STALLS_BACKEND, /* cycles stalled in the back-end */
+    n_events,
+};
+const char *event2str(event_t event);
+
+extern bool enabled; /** --perf-counters, false by default */
+extern double peak_gflops; /** --peak-gflops, 0 means detect */
+extern double peak_gbps; /** --peak-gbps, 0 means detect */
+
+/** opens the counters if enabled, never fails: a missing counter is merely
+ * reported as unavailable */
+void init();
+void finalize();
+
+bool available(event_t event);
+
+/** reads the current values summed over the threads and scaled for
+ * multiplexing; unavailable events read as 0 */
+void read(double values[n_events]);
+
+/** the peak f32 performance and memory bandwidth of the machine, either
+ * given on the command line or detected (0 if unknown) */
+double get_peak_gflops();
+double get_peak_gbps();
+
+/** prints the value of the perf template token `%H<c>` into @p buf and
+ * returns the number of characters written, or -1 if @p c is not a valid
+ * token. @p ops and @p bytes are the amounts of operations and of memory
+ * traffic of one run of the problem (0 if not meaningful) */
+int report(char *buf, int rem_len, char c, const benchdnn_timer_t &t,
+        int mode, double unit, double ops, double bytes);
+
+}
+
+#endif
@@ -0,0 +1,336 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <float.h>
+#include <math.h>
+
+#include "mkldnn.h"
+
+#include "mkldnn_common.hpp"
+#include "mkldnn_memory.hpp"
+#include "norm.hpp"
+
+#include "pool/pool.hpp"
+
+namespace pool {
+
+static bool is_integral(mkldnn_data_type_t dt) {
+    return dt == mkldnn_s32 || dt == mkldnn_s8 || dt == mkldnn_u8;
+}
+
+static float saturate_and_round(mkldnn_data_type_t dt, float value) {
+    float lo = INT_MIN, hi = INT_MAX;
+    switch (dt) {
+    case mkldnn_s8: lo = INT8_MIN; hi = INT8_MAX; break;
+    case mkldnn_u8: lo = 0; hi = UINT8_MAX; break;
+    default: break;
+    }
+    return MAX2(lo, MIN2(hi, nearbyintf(value)));
+}
+
+/* 3D problems reuse the 2D format names given on the command line */
+static mkldnn_memory_format_t data_fmt(const prb_t *p) {
+    if (!is_3d(p)) return p->fmt;
+    switch (p->fmt) {
+    case mkldnn_nchw: return mkldnn_ncdhw;
+    case mkldnn_nhwc: return mkldnn_ndhwc;
+    case mkldnn_nChw8c: return mkldnn_nCdhw8c;
+    case mkldnn_nChw16c: return mkldnn_nCdhw16c;
+    default: return p->fmt;
+    }
+}
+
+/* the values within a spatial plane are pairwise distinct (for planes of up
+ * to 2^24 points), so that the max pooling backward pass does not depend on
+ * how the implementation breaks ties */
+static int fill_src(const prb_t *p, dnn_mem_t &mem) {
+    const size_t plane = (size_t)p->id * p->ih * p->iw;
+    int bits = 1;
+    while (bits < 24 && ((size_t)1 << bits) < plane) ++bits;
+    const uint32_t mask = ((uint32_t)1 << bits) - 1;
+
+    const size_t nelems = mem.nelems();
+    for (size_t idx = 0; idx < nelems; ++idx) {
+        const uint32_t v = ((uint32_t)idx * 2654435761u) & mask;
+        float value;
+        switch (p->dt) {
+        case mkldnn_s32: value = (float)v; break;
+        case mkldnn_u8: value = (float)(v % 256); break;
+        case mkldnn_s8:
+        case mkldnn_bf16: value = (float)((int)(v % 256) - 128); break;
+        default: value = ldexpf((float)v, 4 - bits) - 8.f; break;
+        }
+        mem.set_elem(idx, value);
+    }
+    return OK;
+}
+
+/* the values are multiples of 1/8 within [-4, 4], so that they are exact
+ * in bf16 as well */
+static int fill_diff_dst(const prb_t *p, dnn_mem_t &mem) {
+    const size_t nelems = mem.nelems();
+    for (size_t idx = 0; idx < nelems; ++idx) {
+        const float value = ((int)(idx * 13 % 65) - 32) / 8.f;
+        mem.set_elem(idx, value);
+    }
+    return OK;
+}
+
+static int compare(const prb_t *p, const dnn_mem_t &fp_mem,
+        const dnn_mem_t &dt_mem, res_t *r) {
+    const bool bwd = p->dir & FLAG_BWD;
+    const float trh = p->dt == mkldnn_bf16
+        ? 1e-2
+        : is_integral(p->dt) ? 0 : 1e-6;
+
+    const size_t nelems = fp_mem.nelems();
+    r->errors = 0;
+    r->total = nelems;
+
+    diff_norm_t diff_norm;
+    for (size_t i = 0; i < nelems; ++i) {
+        float fp = ((const float *)fp_mem)[i];
+        if (is_integral(p->dt)) fp = saturate_and_round(p->dt, fp);
+        const float dt = ((const float *)dt_mem)[i];
+        diff_norm.update(fp, dt);
+
+        const float diff = fabsf(fp - dt);
+        const float rel_diff = diff / (fabsf(fp) > FLT_MIN ? fabsf(fp) : 1);
+        const bool ok = (fabsf(fp) > 1e-5 ? rel_diff : diff) <= trh;
+
+        r->errors += !ok;
+
+        const bool dump = false
+            || (!ok && (r->errors < 10 || verbose >= 10))
+            || (verbose >= 50 && i < 30) || (verbose >= 99);
+        if (dump) {
+            print(0, "[%lu][%s] fp:%8g dt:%8g diff:%8g rdiff:%8g\n",
+                    (unsigned long)i, bwd ? "D_SRC" : "DST",
+                    fp, dt, diff, rel_diff);
+        }
+    }
+
+    diff_norm.done();
+
+    if (r->errors || verbose >= 5) {
+        const int vl = r->errors ? 0 : 2;
+        print(vl, "@@@ [%s] diff: l0(``%g``) "
+                "l1:(%g,%g,%g,``%g``) "
+                "l2:(%g,%g,%g,``%g``) "
+                "l8:(%g,%g,%g,``%g``)\n",
+                bwd ? "D_SRC" : "DST",
+                diff_norm.rel_diff(norm_t::L0),
+                diff_norm.a_[norm_t::L1], diff_norm.b_[norm_t::L1],
+                diff_norm.diff_[norm_t::L1], diff_norm.rel_diff(norm_t::L1),
+                diff_norm.a_[norm_t::L2], diff_norm.b_[norm_t::L2],
+                diff_norm.diff_[norm_t::L2], diff_norm.rel_diff(norm_t::L2),
+                diff_norm.a_[norm_t::L8], diff_norm.b_[norm_t::L8],
+                diff_norm.diff_[norm_t::L8], diff_norm.rel_diff(norm_t::L8));
+    }
+
+    if (r->errors)
+        r->state = FAILED;
+
+    if (r->state == UNTESTED)
+        r->state = PASSED; /* optimism */
+
+    return r->state == FAILED ? FAIL : OK;
+}
+
+/* for the backward pass @p fpd is the forward training primitive descriptor,
+ * which is used to produce the workspace */
+static int init_pd(const prb_t *p, mkldnn_pooling_desc_t &pd,
+        mkldnn_primitive_desc_t &ppd, mkldnn_primitive_desc_t &fpd,
+        res_t *r) {
+    const bool is3d = is_3d(p);
+    const int ndims = is3d ? 5 : 4;
+
+    mkldnn_memory_desc_t src_d, dst_d;
+    mkldnn_dims_t src_3d_dims = {p->mb, p->ic, p->id, p->ih, p->iw};
+    mkldnn_dims_t src_2d_dims = {p->mb, p->ic, p->ih, p->iw};
+    mkldnn_dims_t dst_3d_dims = {p->mb, p->ic, p->od, p->oh, p->ow};
+    mkldnn_dims_t dst_2d_dims = {p->mb, p->ic, p->oh, p->ow};
+    DNN_SAFE(mkldnn_memory_desc_init(&src_d, ndims,
+                is3d ? src_3d_dims : src_2d_dims, p->dt, data_fmt(p)), WARN);
+    DNN_SAFE(mkldnn_memory_desc_init(&dst_d, ndims,
+                is3d ? dst_3d_dims : dst_2d_dims, p->dt, data_fmt(p)), WARN);
+
+    auto pad_r = [](int i, int o, int k, int s, int pad_l) {
+        return (o - 1) * s - i + k - pad_l;
+    };
+    mkldnn_dims_t strides_3d = {p->sd, p->sh, p->sw};
+    mkldnn_dims_t strides_2d = {p->sh, p->sw};
+    mkldnn_dims_t kernel_3d = {p->kd, p->kh, p->kw};
+    mkldnn_dims_t kernel_2d = {p->kh, p->kw};
+    mkldnn_dims_t padding_l_3d = {p->pd, p->ph, p->pw};
+    mkldnn_dims_t padding_l_2d = {p->ph, p->pw};
+    mkldnn_dims_t padding_r_3d = {pad_r(p->id, p->od, p->kd, p->sd, p->pd),
+        pad_r(p->ih, p->oh, p->kh, p->sh, p->ph),
+        pad_r(p->iw, p->ow, p->kw, p->sw, p->pw)};
+    mkldnn_dims_t padding_r_2d = {padding_r_3d[1], padding_r_3d[2]};
+
+    const int *strides = is3d ? strides_3d : strides_2d;
+    const int *kernel = is3d ? kernel_3d : kernel_2d;
+    const int *padding_l = is3d ? padding_l_3d : padding_l_2d;
+    const int *padding_r = is3d ? padding_r_3d : padding_r_2d;
+
+    const auto alg = alg2alg_kind(p->alg);
+    fpd = NULL;
+    if (p->dir & FLAG_FWD) {
+        auto prop = p->dir & FLAG_INF
+            ? mkldnn_forward_inference : mkldnn_forward_training;
+        DNN_SAFE(mkldnn_pooling_forward_desc_init(&pd, prop, alg, &src_d,
+                    &dst_d, strides, kernel, padding_l, padding_r,
+                    mkldnn_padding_zero), WARN);
+    } else {
+        DNN_SAFE(mkldnn_pooling_backward_desc_init(&pd, alg, &src_d, &dst_d,
+                    strides, kernel, padding_l, padding_r,
+                    mkldnn_padding_zero), WARN);
+        mkldnn_pooling_desc_t pd_fwd;
+        DNN_SAFE(mkldnn_pooling_forward_desc_init(&pd_fwd,
+                    mkldnn_forward_training, alg, &src_d, &dst_d, strides,
+                    kernel, padding_l, padding_r, mkldnn_padding_zero), WARN);
+        mkldnn_status_t init_status = mkldnn_primitive_desc_create(&fpd,
+                &pd_fwd, engine, NULL);
+        // if fwd pass is unimplemented, bwd pass is useless
+        if (init_status == mkldnn_unimplemented)
+            return r->state = UNIMPLEMENTED, OK;
+        else
+            SAFE(init_status, WARN);
+    }
+
+    mkldnn_status_t init_status = mkldnn_primitive_desc_create(&ppd, &pd,
+            engine, fpd);
+
+    if (init_status == mkldnn_unimplemented) {
+        mkldnn_primitive_desc_destroy(fpd);
+        return r->state = UNIMPLEMENTED, OK;
+    } else
+        SAFE(init_status, WARN);
+
+    const char *impl_str = query_impl_info(ppd);
+    if (maybe_skip(skip_impl, impl_str)) {
+        print(2, "SKIPPED: mkldnn implementation: %s\n", impl_str);
+        DNN_SAFE(mkldnn_primitive_desc_destroy(ppd), WARN);
+        mkldnn_primitive_desc_destroy(fpd);
+        return r->state = SKIPPED, OK;
+    } else {
+        print(5, "mkldnn implementation: %s\n", impl_str);
+    }
+
+    return OK;
+}
+
+int doit(const prb_t *p, res_t *r) {
+    res_t res_zero{};
+    *r = res_zero;
+
+    mkldnn_pooling_desc_t pd;
+    mkldnn_primitive_desc_t ppd, fpd;
+    mkldnn_primitive_t pp{};
+
+    SAFE(init_pd(p, pd, ppd, fpd, r), WARN);
+    if (r->state == SKIPPED || r->state == UNIMPLEMENTED)
+        return OK;
+
+    const auto fp = mkldnn_f32;
+    const auto plain_fmt = is_3d(p) ? mkldnn_ncdhw : mkldnn_nchw;
+    const bool fwd = p->dir & FLAG_FWD;
+    auto &src_dt_d = fwd ? pd.src_desc : pd.diff_src_desc;
+    auto &dst_dt_d = fwd ? pd.dst_desc : pd.diff_dst_desc;
+
+    dnn_mem_t src_fp(src_dt_d, fp, plain_fmt), src_dt(src_dt_d);
+    dnn_mem_t dst_fp(dst_dt_d, fp, plain_fmt), dst_dt(dst_dt_d);
+    dnn_mem_t d_src_fp(src_dt_d, fp, plain_fmt), d_src_dt(src_dt_d);
+
+    const auto ws_pd = mkldnn_primitive_desc_query_pd(fwd ? ppd : fpd,
+            mkldnn_query_workspace_pd, 0);
+    dnn_mem_t *p_ws_dt = ws_pd
+        ? new dnn_mem_t(*mkldnn_primitive_desc_query_memory_d(ws_pd))
+        : new dnn_mem_t();
+    dnn_mem_t &ws_dt = *p_ws_dt;
+
+    SAFE(fill_src(p, src_fp), WARN);
+    SAFE(src_dt.reorder(src_fp), WARN);
+
+    if (fwd) {
+        mkldnn_primitive_at_t inputs[1] = { {src_dt.p_, 0} };
+        const_mkldnn_primitive_t outputs[2] = { dst_dt.p_, NULL };
+        if (ws_pd) outputs[1] = ws_dt.p_;
+
+        DNN_SAFE(mkldnn_primitive_create(&pp, ppd, inputs, outputs), WARN);
+        SAFE(execute(pp), WARN);
+        if (bench_mode & CORR) {
+            compute_ref_fwd(p, src_fp, dst_fp);
+            dnn_mem_t dst(dst_dt, fp, plain_fmt);
+            SAFE(compare(p, dst_fp, dst, r), WARN);
+        }
+    } else {
+        if (ws_pd) {
+            /* the workspace is produced by the forward pass */
+            dnn_mem_t fwd_dst_dt(dst_dt_d);
+            mkldnn_primitive_t f{};
+            mkldnn_primitive_at_t f_inputs[1] = { {src_dt.p_, 0} };
+            const_mkldnn_primitive_t f_outputs[2] = { fwd_dst_dt.p_,
+                ws_dt.p_ };
+            DNN_SAFE(mkldnn_primitive_create(&f, fpd, f_inputs, f_outputs),
+                    WARN);
+            SAFE(execute(f), WARN);
+            DNN_SAFE_V(mkldnn_primitive_destroy(f));
+        }
+
+        /* dst_* hold the diff_dst */
+        SAFE(fill_diff_dst(p, dst_fp), WARN);
+        SAFE(dst_dt.reorder(dst_fp), WARN);
+
+        mkldnn_primitive_at_t inputs[2] = { {dst_dt.p_, 0}, {NULL, 0} };
+        if (ws_pd) inputs[1] = {ws_dt.p_, 0};
+        const_mkldnn_primitive_t outputs[1] = { d_src_dt.p_ };
+        DNN_SAFE(mkldnn_primitive_create(&pp, ppd, inputs, outputs), WARN);
+        SAFE(execute(pp), WARN);
+        if (bench_mode & CORR) {
+            compute_ref_bwd(p, src_fp, dst_fp, d_src_fp);
+            dnn_mem_t d_src(d_src_dt, fp, plain_fmt);
+            SAFE(compare(p, d_src_fp, d_src, r), WARN);
+        }
+    }
+
+    if (bench_mode & PERF) {
+        auto &t = r->timer;
+        t.reset();
+        while (true) {
+            SAFE(execute(pp), WARN);
+            t.stamp();
+            const bool stop = false
+                || (fix_times_per_prb && t.times() >= fix_times_per_prb)
+                || (!fix_times_per_prb
+                        && t.total_ms() >= max_ms_per_prb
+                        && t.times() >= min_times_per_prb);
+            if (stop) break;
+        }
+    }
+
+    delete p_ws_dt;
+    DNN_SAFE_V(mkldnn_primitive_desc_destroy(ppd));
+    mkldnn_primitive_desc_destroy(fpd);
+    DNN_SAFE_V(mkldnn_primitive_destroy(pp));
+    return OK;
+}
+
+}
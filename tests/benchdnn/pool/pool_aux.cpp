@@ -0,0 +1,177 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <stdlib.h>
+#include <assert.h>
+#include "pool/pool.hpp"
+
+namespace pool {
+
+alg_t str2alg(const char *str) {
+    if (!strcasecmp("max", str)) return MAX;
+    if (!strcasecmp("avg_np", str)) return AVG_NP;
+    if (!strcasecmp("avg_p", str)) return AVG_P;
+    assert(!"unknown algorithm");
+    return MAX;
+}
+
+const char *alg2str(alg_t alg) {
+    if (alg == MAX) return "max";
+    if (alg == AVG_NP) return "avg_np";
+    if (alg == AVG_P) return "avg_p";
+    assert(!"unknown algorithm");
+    return "unknown algorithm";
+}
+
+mkldnn_alg_kind_t alg2alg_kind(alg_t alg) {
+    if (alg == MAX) return mkldnn_pooling_max;
+    if (alg == AVG_NP) return mkldnn_pooling_avg_exclude_padding;
+    if (alg == AVG_P) return mkldnn_pooling_avg_include_padding;
+    assert(!"unknown algorithm");
+    return mkldnn_alg_kind_undef;
+}
+
+int str2desc(desc_t *desc, const char *str) {
+    /* canonical form:
+     * mbXicXidXihXiwXodXohXowXkdXkhXkwXsdXshXswXpdXphXpwXnS
+     *
+     * where: X is number, S - string
+     * note: symbol `_` is ignored
+     *
+     * implicit rules:
+     *  - default values:
+     *      mb = 2, sd = sh = sw = 1, S="wip"
+     *  - if H is undefined => H = W
+     *  - if W is undefined => W = H
+     *  - if D is undefined => 2D pooling
+     *  - if `output` is undefined => compute output
+     *  - if padding is undefined => compute trivial padding
+     */
+
+    desc_t d{0};
+    d.mb = 2;
+    d.sd = d.sh = d.sw = 1;
+    d.pd = d.ph = d.pw = -1;
+    d.name = "\"wip\"";
+
+    const char *s = str;
+    assert(s);
+
+#   define CASE_NN(p, c) do { \
+        if (!strncmp(p, s, strlen(p))) { \
+            ok = 1; s += strlen(p); \
+            char *end_s; d. c = strtol(s, &end_s, 10); s += (end_s - s); \
+        } \
+    } while (0)
+#   define CASE_N(c) CASE_NN(#c, c)
+    while (*s) {
+        int ok = 0;
+        CASE_N(mb); CASE_N(ic);
+        CASE_N(id); CASE_N(ih); CASE_N(iw);
+        CASE_N(od); CASE_N(oh); CASE_N(ow);
+        CASE_N(kd); CASE_N(kh); CASE_N(kw);
+        CASE_N(sd); CASE_N(sh); CASE_N(sw);
+        CASE_N(pd); CASE_N(ph); CASE_N(pw);
+        if (*s == 'n') { d.name = s + 1; break; }
+        if (*s == '_') ++s;
+        if (!ok) return FAIL;
+    }
+#   undef CASE_NN
+#   undef CASE_N
+
+    if (d.ic == 0) return FAIL;
+
+    if (d.iw == 0) {
+        d.iw = d.ih; d.ow = d.oh; d.kw = d.kh; d.sw = d.sh; d.pw = d.ph;
+    } else if (d.ih == 0) {
+        d.ih = d.iw; d.oh = d.ow; d.kh = d.kw; d.sh = d.sw; d.ph = d.pw;
+    }
+    if (d.id == 0) {
+        d.id = d.od = d.kd = d.sd = 1; d.pd = 0;
+    }
+
+    auto complete = [](int i, int &o, int k, int s, int &p) {
+        if (i <= 0 || k <= 0 || s <= 0) return FAIL;
+        if (o == 0) {
+            if (p < 0) p = 0;
+            o = (i - k + 2 * p) / s + 1;
+        } else if (p < 0) {
+            p = ((o - 1) * s - i + k) / 2;
+        }
+        return o > 0 ? OK : FAIL;
+    };
+    SAFE(complete(d.id, d.od, d.kd, d.sd, d.pd), WARN);
+    SAFE(complete(d.ih, d.oh, d.kh, d.sh, d.ph), WARN);
+    SAFE(complete(d.iw, d.ow, d.kw, d.sw, d.pw), WARN);
+
+    *desc = d;
+
+    return OK;
+}
+
+void desc2str(const desc_t *d, char *buffer, bool canonical) {
+    int rem_len = max_desc_len;
+#   define DPRINT(...) do { \
+        int l = snprintf(buffer, rem_len, __VA_ARGS__); \
+        buffer += l; rem_len -= l; \
+    } while(0)
+
+    const bool print_d = canonical || d->id > 1 || d->kd > 1;
+    const bool print_w = canonical || d->iw != d->ih || d->ow != d->oh
+        || d->kw != d->kh || d->sw != d->sh || d->pw != d->ph;
+
+    if (canonical || d->mb != 2) DPRINT("mb%d", d->mb);
+    DPRINT("ic%d", d->ic);
+    if (print_d) DPRINT("id%d", d->id);
+    DPRINT("ih%d", d->ih);
+    if (print_w) DPRINT("iw%d", d->iw);
+    if (print_d) DPRINT("od%d", d->od);
+    DPRINT("oh%d", d->oh);
+    if (print_w) DPRINT("ow%d", d->ow);
+    if (print_d) DPRINT("kd%d", d->kd);
+    DPRINT("kh%d", d->kh);
+    if (print_w) DPRINT("kw%d", d->kw);
+    if (print_d) DPRINT("sd%d", d->sd);
+    DPRINT("sh%d", d->sh);
+    if (print_w) DPRINT("sw%d", d->sw);
+    if (print_d) DPRINT("pd%d", d->pd);
+    DPRINT("ph%d", d->ph);
+    if (print_w) DPRINT("pw%d", d->pw);
+    DPRINT("n%s", d->name);
+
+#   undef DPRINT
+}
+
+void prb2str(const prb_t *p, char *buffer, bool canonical) {
+    char desc_buf[max_desc_len];
+    char dir_str[32] = {0};
+    char dt_str[16] = {0};
+    char fmt_str[32] = {0};
+    char alg_str[32] = {0};
+    desc2str(p, desc_buf, canonical);
+    snprintf(dir_str, sizeof(dir_str), "--dir=%s ", dir2str(p->dir));
+    snprintf(dt_str, sizeof(dt_str), "--dt=%s ", dt2str(p->dt));
+    snprintf(fmt_str, sizeof(fmt_str), "--fmt=%s ", fmt2str(p->fmt));
+    snprintf(alg_str, sizeof(alg_str), "--alg=%s ", alg2str(p->alg));
+    snprintf(buffer, max_prb_len, "%s%s%s%s%s",
+            p->dir == FWD_D ? "" : dir_str,
+            p->dt == mkldnn_f32 ? "" : dt_str,
+            p->fmt == mkldnn_nchw ? "" : fmt_str,
+            p->alg == MAX ? "" : alg_str,
+            desc_buf);
+}
+
+}
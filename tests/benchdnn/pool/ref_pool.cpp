@@ -0,0 +1,133 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <float.h>
+#include <math.h>
+
+#include "src/common/mkldnn_thread.hpp"
+
+#include "pool/pool.hpp"
+
+namespace pool {
+
+/* returns the number of points in the window which lie inside the source,
+ * the window being clipped by the padding */
+static int window_size(const prb_t *p, int od, int oh, int ow) {
+    if (p->alg == AVG_P) return p->kd * p->kh * p->kw;
+
+    auto clip = [](int o, int s, int pad, int k, int i) {
+        const int start = o * s - pad;
+        const int end = start + k;
+        return (end < i ? end : i) - (start > 0 ? start : 0);
+    };
+    return clip(od, p->sd, p->pd, p->kd, p->id)
+        * clip(oh, p->sh, p->ph, p->kh, p->ih)
+        * clip(ow, p->sw, p->pw, p->kw, p->iw);
+}
+
+/* the maximum is the first one met in the window order, which is what the
+ * library stores in the workspace as well */
+static size_t argmax(const prb_t *p, const dnn_mem_t &src, int mb, int ic,
+        int od, int oh, int ow) {
+    float max_value = -FLT_MAX;
+    size_t max_off = src_off(p, mb, ic, 0, 0, 0);
+    bool found = false;
+    for (int kd = 0; kd < p->kd; ++kd)
+    for (int kh = 0; kh < p->kh; ++kh)
+    for (int kw = 0; kw < p->kw; ++kw) {
+        const int id = od * p->sd - p->pd + kd;
+        const int ih = oh * p->sh - p->ph + kh;
+        const int iw = ow * p->sw - p->pw + kw;
+        if (id < 0 || id >= p->id) continue;
+        if (ih < 0 || ih >= p->ih) continue;
+        if (iw < 0 || iw >= p->iw) continue;
+
+        const size_t off = src_off(p, mb, ic, id, ih, iw);
+        const float s = ((const float *)src)[off];
+        if (!found || s > max_value) {
+            max_value = s;
+            max_off = off;
+            found = true;
+        }
+    }
+    return max_off;
+}
+
+void compute_ref_fwd(const prb_t *p, const dnn_mem_t &src, dnn_mem_t &dst) {
+    mkldnn::impl::parallel_nd(p->mb, p->ic, p->od, p->oh, p->ow,
+            [&](int mb, int ic, int od, int oh, int ow) {
+        float &d = ((float *)dst)[dst_off(p, mb, ic, od, oh, ow)];
+
+        if (p->alg == MAX) {
+            d = ((const float *)src)[argmax(p, src, mb, ic, od, oh, ow)];
+            return;
+        }
+
+        float sum = 0;
+        for (int kd = 0; kd < p->kd; ++kd)
+        for (int kh = 0; kh < p->kh; ++kh)
+        for (int kw = 0; kw < p->kw; ++kw) {
+            const int id = od * p->sd - p->pd + kd;
+            const int ih = oh * p->sh - p->ph + kh;
+            const int iw = ow * p->sw - p->pw + kw;
+            if (id < 0 || id >= p->id) continue;
+            if (ih < 0 || ih >= p->ih) continue;
+            if (iw < 0 || iw >= p->iw) continue;
+            sum += ((const float *)src)[src_off(p, mb, ic, id, ih, iw)];
+        }
+        d = sum / window_size(p, od, oh, ow);
+    });
+}
+
+void compute_ref_bwd(const prb_t *p, const dnn_mem_t &src,
+        const dnn_mem_t &diff_dst, dnn_mem_t &diff_src) {
+    /* the windows may overlap, hence the parallelization over mb and ic only
+     * with the accumulation done sequentially inside */
+    mkldnn::impl::parallel_nd(p->mb, p->ic, [&](int mb, int ic) {
+        for (int id = 0; id < p->id; ++id)
+        for (int ih = 0; ih < p->ih; ++ih)
+        for (int iw = 0; iw < p->iw; ++iw)
+            ((float *)diff_src)[src_off(p, mb, ic, id, ih, iw)] = 0;
+
+        for (int od = 0; od < p->od; ++od)
+        for (int oh = 0; oh < p->oh; ++oh)
+        for (int ow = 0; ow < p->ow; ++ow) {
+            const float dd
+                = ((const float *)diff_dst)[dst_off(p, mb, ic, od, oh, ow)];
+
+            if (p->alg == MAX) {
+                const size_t off = argmax(p, src, mb, ic, od, oh, ow);
+                ((float *)diff_src)[off] += dd;
+                continue;
+            }
+
+            const float v = dd / window_size(p, od, oh, ow);
+            for (int kd = 0; kd < p->kd; ++kd)
+            for (int kh = 0; kh < p->kh; ++kh)
+            for (int kw = 0; kw < p->kw; ++kw) {
+                const int id = od * p->sd - p->pd + kd;
+                const int ih = oh * p->sh - p->ph + kh;
+                const int iw = ow * p->sw - p->pw + kw;
+                if (id < 0 || id >= p->id) continue;
+                if (ih < 0 || ih >= p->ih) continue;
+                if (iw < 0 || iw >= p->iw) continue;
+                ((float *)diff_src)[src_off(p, mb, ic, id, ih, iw)] += v;
+            }
+        }
+    });
+}
+
+}
@@ -43,6 +43,7 @@ table of modifiers below.
 | %@O           | number of elements being reordered
 | %@t           | time in ms
 | %@p           | elements per second
+| %@H<x>        | hardware counters and roofline metrics, see README.md
 
 | modifier  | description
 |:--------  |:-----------
@@ -68,6 +69,8 @@ void perf_report(const prb_t *p, const res_t *r, const char *pstr) {
     double ops = 1;
     for (size_t d = 0; d < p->reorder.dims.size(); ++d)
         ops *= p->reorder.dims[d];
+    const double bytes = ops * (sizeof_dt(cfg2dt(p->conf_in))
+            + sizeof_dt(cfg2dt(p->conf_out)));
 
 #   define DPRINT(...) do { \
         int l = snprintf(buf, rem_len, __VA_ARGS__); \
@@ -132,6 +135,12 @@ void perf_report(const prb_t *p, const res_t *r, const char *pstr) {
             DPRINT("%g", t.ms(mode) / unit);
         else if (c == 'p')
             DPRINT("%g", ops / t.ms(mode) / unit * 1e3);
+        else if (c == 'H') {
+            const int l = perf_counters::report(buf, rem_len, *pt, t, mode,
+                    unit, 0, bytes);
+            if (l < 0) []() { SAFE(FAIL, CRIT); return 0; }();
+            ++pt; buf += l; rem_len -= l;
+        }
         else
             SAFE_V(FAIL);
     }
@@ -29,6 +29,7 @@ namespace rnn {
 
 void perf_report(const rnn_prb_t *p, const res_t *r, const char *pstr) {
     const auto &t = r->timer;
+    const double bytes = 0; /* not estimated */
     const int max_len = 400;
     int rem_len = max_len - 1;
     char buffer[max_len], *buf = buffer;
@@ -92,6 +93,12 @@ void perf_report(const rnn_prb_t *p, const res_t *r, const char *pstr) {
             DPRINT("%g", p->ops / unit);
         else if (c == 'p')
             DPRINT("%g", p->ops / t.ms(mode) / unit * 1e3);
+        else if (c == 'H') {
+            const int l = perf_counters::report(buf, rem_len, *pt, t, mode,
+                    unit, p->ops, bytes);
+            if (l < 0) []() { SAFE(FAIL, CRIT); return 0; }();
+            ++pt; buf += l; rem_len -= l;
+        }
         else
             []() { SAFE(FAIL, CRIT); return 0; }();
     }
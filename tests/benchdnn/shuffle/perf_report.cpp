@@ -41,12 +41,15 @@ See modifiers at the same place.
 | %a            | axis
 | %g            | group size
 | %@t           | time in ms
+| %@H<x>        | hardware counters and roofline metrics, see README.md
 
 The definition of expanded problem descriptor is: `dxdxdxdxd`.
 #endif
 
 void perf_report(const prb_t *p, const res_t *r, const char *pstr) {
     const auto &t = r->timer;
+    double bytes = 2. * sizeof_dt(p->dt);
+    for (size_t d = 0; d < p->dims.size(); ++d) bytes *= p->dims[d];
     const int max_len = 400;
     int rem_len = max_len - 1;
     char buffer[max_len], *buf = buffer;
@@ -111,6 +114,12 @@ void perf_report(const prb_t *p, const res_t *r, const char *pstr) {
             DPRINT("%s", fmt2str(p->fmt));
         else if (c == 't')
             DPRINT("%g", t.ms(mode) / unit);
+        else if (c == 'H') {
+            const int l = perf_counters::report(buf, rem_len, *pt, t, mode,
+                    unit, 0, bytes);
+            if (l < 0) []() { SAFE(FAIL, CRIT); return 0; }();
+            ++pt; buf += l; rem_len -= l;
+        }
         else
             []() { SAFE_V(FAIL); return 0; }();
     }
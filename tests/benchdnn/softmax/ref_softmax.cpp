@@ -0,0 +1,79 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <float.h>
+#include <math.h>
+
+#include "src/common/mkldnn_thread.hpp"
+
+#include "softmax/softmax.hpp"
+
+namespace softmax {
+
+void compute_ref_fwd(const prb_t *p, const dnn_mem_t &src, dnn_mem_t &dst) {
+    size_t outer_size, inner_size;
+    int axis_size;
+    get_sizes(p, outer_size, axis_size, inner_size);
+    const size_t dim = axis_size * inner_size;
+
+    mkldnn::impl::parallel_nd(outer_size, inner_size,
+            [&](size_t ou, size_t in) {
+        const size_t off = ou * dim + in;
+
+        float max = -FLT_MAX;
+        for (int a = 0; a < axis_size; ++a)
+            max = MAX2(max, src.get_elem(off + a * inner_size));
+
+        double sum = 0;
+        for (int a = 0; a < axis_size; ++a) {
+            const float e = expf(src.get_elem(off + a * inner_size) - max);
+            dst.set_elem(off + a * inner_size, e);
+            sum += e;
+        }
+
+        for (int a = 0; a < axis_size; ++a) {
+            const size_t idx = off + a * inner_size;
+            dst.set_elem(idx, (float)(dst.get_elem(idx) / sum));
+        }
+    });
+}
+
+void compute_ref_bwd(const prb_t *p, const dnn_mem_t &dst,
+        const dnn_mem_t &diff_dst, dnn_mem_t &diff_src) {
+    size_t outer_size, inner_size;
+    int axis_size;
+    get_sizes(p, outer_size, axis_size, inner_size);
+    const size_t dim = axis_size * inner_size;
+
+    mkldnn::impl::parallel_nd(outer_size, inner_size,
+            [&](size_t ou, size_t in) {
+        const size_t off = ou * dim + in;
+
+        double sum = 0;
+        for (int a = 0; a < axis_size; ++a) {
+            const size_t idx = off + a * inner_size;
+            sum += (double)diff_dst.get_elem(idx) * dst.get_elem(idx);
+        }
+
+        for (int a = 0; a < axis_size; ++a) {
+            const size_t idx = off + a * inner_size;
+            const float d = dst.get_elem(idx);
+            diff_src.set_elem(idx, (float)(d * (diff_dst.get_elem(idx) - sum)));
+        }
+    });
+}
+
+}
@@ -0,0 +1,235 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <float.h>
+#include <math.h>
+
+#include "mkldnn.h"
+
+#include "mkldnn_common.hpp"
+#include "mkldnn_memory.hpp"
+#include "norm.hpp"
+
+#include "softmax/softmax.hpp"
+
+namespace softmax {
+
+/* the values are multiples of 1/8 within [-8, 8], so that they are exact
+ * in bf16 as well */
+static int fill_data(dnn_mem_t &mem, int seed) {
+    const size_t nelems = mem.nelems();
+    for (size_t idx = 0; idx < nelems; ++idx) {
+        const float value = ((int)((idx + seed) * 37 % 129) - 64) / 8.f;
+        mem.set_elem(idx, value);
+    }
+    return OK;
+}
+
+static int compare(const prb_t *p, const dnn_mem_t &fp_mem,
+        const dnn_mem_t &dt_mem, res_t *r) {
+    const float trh = p->dt == mkldnn_bf16
+        ? 1e-2
+        : p->dir & FLAG_BWD ? 1e-5 : 4e-6;
+
+    const size_t nelems = fp_mem.nelems();
+    r->errors = 0;
+    r->total = nelems;
+
+    diff_norm_t diff_norm;
+    for (size_t i = 0; i < nelems; ++i) {
+        const float fp = fp_mem.get_elem(i);
+        const float dt = dt_mem.get_elem(i);
+        diff_norm.update(fp, dt);
+
+        const float diff = fabsf(fp - dt);
+        const float rel_diff = diff / (fabsf(fp) > FLT_MIN ? fabsf(fp) : 1);
+        const bool ok = (fabsf(fp) > 1e-5 ? rel_diff : diff) <= trh;
+
+        r->errors += !ok;
+
+        const bool dump = false
+            || (!ok && (r->errors < 10 || verbose >= 10))
+            || (verbose >= 50 && i < 30) || (verbose >= 99);
+        if (dump) {
+            print(0, "[%lu][%s] fp:%8g dt:%8g diff:%8g rdiff:%8g\n",
+                    (unsigned long)i, p->dir & FLAG_BWD ? "D_SRC" : "DST",
+                    fp, dt, diff, rel_diff);
+        }
+    }
+
+    diff_norm.done();
+
+    if (r->errors || verbose >= 5) {
+        const int vl = r->errors ? 0 : 2;
+        print(vl, "@@@ [%s] diff: l0(``%g``) "
+                "l1:(%g,%g,%g,``%g``) "
+                "l2:(%g,%g,%g,``%g``) "
+                "l8:(%g,%g,%g,``%g``)\n",
+                p->dir & FLAG_BWD ? "D_SRC" : "DST",
+                diff_norm.rel_diff(norm_t::L0),
+                diff_norm.a_[norm_t::L1], diff_norm.b_[norm_t::L1],
+                diff_norm.diff_[norm_t::L1], diff_norm.rel_diff(norm_t::L1),
+                diff_norm.a_[norm_t::L2], diff_norm.b_[norm_t::L2],
+                diff_norm.diff_[norm_t::L2], diff_norm.rel_diff(norm_t::L2),
+                diff_norm.a_[norm_t::L8], diff_norm.b_[norm_t::L8],
+                diff_norm.diff_[norm_t::L8], diff_norm.rel_diff(norm_t::L8));
+    }
+
+    if (r->errors)
+        r->state = FAILED;
+
+    if (r->state == UNTESTED)
+        r->state = PASSED; /* optimism */
+
+    return r->state == FAILED ? FAIL : OK;
+}
+
+static int init_pd(const prb_t *p, mkldnn_softmax_desc_t &sd,
+        mkldnn_primitive_desc_t &spd, res_t *r) {
+    mkldnn_memory_desc_t data_d;
+    mkldnn_dims_t data_dims;
+    const int ndims = (int)p->dims.size();
+
+    for (int i = 0; i < ndims; ++i) data_dims[i] = p->dims[i];
+    DNN_SAFE(mkldnn_memory_desc_init(&data_d, ndims, data_dims, p->dt, p->fmt),
+            WARN);
+
+    mkldnn_primitive_desc_t hint_fwd_pd = NULL;
+    if (p->dir & FLAG_FWD) {
+        auto prop = p->dir & FLAG_INF
+            ? mkldnn_forward_inference : mkldnn_forward_training;
+        DNN_SAFE(mkldnn_softmax_forward_desc_init(&sd, prop, &data_d,
+                    p->axis), WARN);
+    } else {
+        DNN_SAFE(mkldnn_softmax_backward_desc_init(&sd, &data_d, &data_d,
+                    p->axis), WARN);
+        mkldnn_softmax_desc_t sd_fwd;
+        DNN_SAFE(mkldnn_softmax_forward_desc_init(&sd_fwd,
+                    mkldnn_forward_training, &data_d, p->axis), WARN);
+        mkldnn_status_t init_status = mkldnn_primitive_desc_create(
+                &hint_fwd_pd, &sd_fwd, engine, NULL);
+        // if fwd pass is unimplemented, bwd pass is useless
+        if (init_status == mkldnn_unimplemented)
+            return r->state = UNIMPLEMENTED, OK;
+        else
+            SAFE(init_status, WARN);
+    }
+
+    mkldnn_status_t init_status = mkldnn_primitive_desc_create(&spd, &sd,
+            engine, hint_fwd_pd);
+    mkldnn_primitive_desc_destroy(hint_fwd_pd);
+
+    if (init_status == mkldnn_unimplemented)
+        return r->state = UNIMPLEMENTED, OK;
+    else
+        SAFE(init_status, WARN);
+
+    const char *impl_str = query_impl_info(spd);
+    if (maybe_skip(skip_impl, impl_str)) {
+        print(2, "SKIPPED: mkldnn implementation: %s\n", impl_str);
+        DNN_SAFE(mkldnn_primitive_desc_destroy(spd), WARN);
+        return r->state = SKIPPED, OK;
+    } else {
+        print(5, "mkldnn implementation: %s\n", impl_str);
+    }
+
+    return OK;
+}
+
+int doit(const prb_t *p, res_t *r) {
+    res_t res_zero{};
+    *r = res_zero;
+
+    mkldnn_softmax_desc_t sd;
+    mkldnn_primitive_desc_t spd;
+    mkldnn_primitive_t s{};
+
+    SAFE(init_pd(p, sd, spd, r), WARN);
+    if (r->state == SKIPPED || r->state == UNIMPLEMENTED)
+        return OK;
+
+    const auto fp = mkldnn_f32;
+    auto &data_dt_d = sd.data_desc;
+
+    const int ndims = (int)p->dims.size();
+    const auto data_format = (ndims == 1)
+           ? mkldnn_x
+           : (ndims == 2)
+           ? mkldnn_nc
+           : get_default_format(ndims, fmt2data_kind(p->fmt));
+
+    dnn_mem_t src_fp(data_dt_d, fp, data_format), src_dt(data_dt_d);
+    dnn_mem_t dst_fp(data_dt_d, fp, data_format), dst_dt(data_dt_d);
+    dnn_mem_t d_src_fp(data_dt_d, fp, data_format), d_src_dt(data_dt_d);
+
+    SAFE(fill_data(src_fp, 0), WARN);
+
+    if (p->dir & FLAG_FWD) {
+        SAFE(src_dt.reorder(src_fp), WARN);
+        mkldnn_primitive_at_t inputs[1] = { {src_dt.p_, 0} };
+        const_mkldnn_primitive_t outputs[1] = { dst_dt.p_ };
+        DNN_SAFE(mkldnn_primitive_create(&s, spd, inputs, outputs), WARN);
+        SAFE(execute(s), WARN);
+        if (bench_mode & CORR) {
+            compute_ref_fwd(p, src_fp, dst_fp);
+            dnn_mem_t dst(dst_dt, fp, data_format);
+            SAFE(compare(p, dst_fp, dst, r), WARN);
+        }
+    } else {
+        /* the backward pass takes the forward dst, src_* hold the diff_dst */
+        compute_ref_fwd(p, src_fp, dst_fp);
+        SAFE(dst_dt.reorder(dst_fp), WARN);
+        SAFE(fill_data(src_fp, 1), WARN);
+        SAFE(src_dt.reorder(src_fp), WARN);
+
+        mkldnn_primitive_at_t inputs[2] = { {dst_dt.p_, 0}, {src_dt.p_, 0} };
+        const_mkldnn_primitive_t outputs[1] = { d_src_dt.p_ };
+        DNN_SAFE(mkldnn_primitive_create(&s, spd, inputs, outputs), WARN);
+        SAFE(execute(s), WARN);
+        if (bench_mode & CORR) {
+            /* use the dst as seen by the library */
+            dnn_mem_t dst(dst_dt, fp, data_format);
+            compute_ref_bwd(p, dst, src_fp, d_src_fp);
+            dnn_mem_t d_src(d_src_dt, fp, data_format);
+            SAFE(compare(p, d_src_fp, d_src, r), WARN);
+        }
+    }
+
+    DNN_SAFE_V(mkldnn_primitive_desc_destroy(spd));
+
+    if (bench_mode & PERF) {
+        auto &t = r->timer;
+        t.reset();
+        while (true) {
+            SAFE(execute(s), WARN);
+            t.stamp();
+            const bool stop = false
+                || (fix_times_per_prb && t.times() >= fix_times_per_prb)
+                || (!fix_times_per_prb
+                        && t.total_ms() >= max_ms_per_prb
+                        && t.times() >= min_times_per_prb);
+            if (stop) break;
+        }
+    }
+
+    DNN_SAFE_V(mkldnn_primitive_destroy(s));
+    return OK;
+}
+
+}
@@ -0,0 +1,80 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef _SOFTMAX_HPP
+#define _SOFTMAX_HPP
+
+#include <stdint.h>
+#include <limits.h>
+#include <assert.h>
+#include <vector>
+
+#include "common.hpp"
+#include "dnn_types.hpp"
+#include "mkldnn_common.hpp"
+#include "mkldnn_memory.hpp"
+#include "mkldnn_debug.hpp"
+
+namespace softmax {
+
+using dims_t = std::vector<int>;
+
+struct prb_t {
+    prb_t(const dims_t &dims, dir_t dir, mkldnn_data_type_t dt,
+            mkldnn_memory_format_t fmt, int axis)
+        : dims(dims), dir(dir), dt(dt), fmt(fmt), axis(axis) {}
+    ~prb_t() {}
+
+    dims_t dims;
+    dir_t dir;
+    mkldnn_data_type_t dt;
+    mkldnn_memory_format_t fmt;
+    int axis;
+};
+
+const size_t max_dims_len = 64;
+dims_t str2dims(const char *str);
+void dims2str(const dims_t &dims, char *buffer);
+const size_t max_prb_len = max_dims_len + 196;
+void prb2str(const prb_t *p, char *buffer, bool canonical = false);
+
+/* some extra control parameters which shouldn't be placed in prb_t */
+extern const char *skip_impl; /* NULL or "" means do not skip anything */
+
+extern const char *perf_template; /* performance output template */
+void perf_report(const prb_t *p, const res_t *r, const char *pstr);
+
+/* the data is viewed as outer_size x axis_size x inner_size */
+inline void get_sizes(const prb_t *p, size_t &outer_size, int &axis_size,
+        size_t &inner_size) {
+    outer_size = inner_size = 1;
+    axis_size = p->dims[p->axis];
+    for (int i = 0; i < p->axis; ++i)
+        outer_size *= (size_t)p->dims[i];
+    for (int i = p->axis + 1; i < (int)p->dims.size(); ++i)
+        inner_size *= (size_t)p->dims[i];
+}
+
+void compute_ref_fwd(const prb_t *p, const dnn_mem_t &src, dnn_mem_t &dst);
+void compute_ref_bwd(const prb_t *p, const dnn_mem_t &dst,
+        const dnn_mem_t &diff_dst, dnn_mem_t &diff_src);
+
+int doit(const prb_t *p, res_t *res);
+int bench(int argc, char **argv, bool main_bench = true);
+
+}
+
+#endif
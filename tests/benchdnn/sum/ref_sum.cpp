@@ -0,0 +1,34 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "src/common/mkldnn_thread.hpp"
+
+#include "sum/sum.hpp"
+
+namespace sum {
+
+void compute_ref(const prb_t *p, const std::vector<dnn_mem_t *> &src,
+        dnn_mem_t &dst) {
+    const ptrdiff_t n = (ptrdiff_t)nelems(p);
+    mkldnn::impl::parallel_nd(n, [&](ptrdiff_t i) {
+        float d = 0;
+        for (int k = 0; k < p->n_inputs(); ++k)
+            d += p->scales[k] * ((const float *)*src[k])[i];
+        ((float *)dst)[i] = d;
+    });
+}
+
+}
@@ -0,0 +1,84 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef _SUM_HPP
+#define _SUM_HPP
+
+#include <stdint.h>
+#include <limits.h>
+#include <assert.h>
+#include <vector>
+
+#include "common.hpp"
+#include "dnn_types.hpp"
+#include "mkldnn_common.hpp"
+#include "mkldnn_memory.hpp"
+#include "mkldnn_debug.hpp"
+
+namespace sum {
+
+using dims_t = std::vector<int>;
+using fmts_t = std::vector<mkldnn_memory_format_t>;
+using scales_t = std::vector<float>;
+
+struct prb_t {
+    prb_t(const dims_t &dims, mkldnn_data_type_t sdt, mkldnn_data_type_t ddt,
+            const fmts_t &stag, mkldnn_memory_format_t dtag,
+            const scales_t &scales)
+        : dims(dims), sdt(sdt), ddt(ddt), stag(stag), dtag(dtag)
+        , scales(scales) {}
+    ~prb_t() {}
+
+    int n_inputs() const { return (int)stag.size(); }
+
+    dims_t dims;
+    mkldnn_data_type_t sdt, ddt;
+    fmts_t stag;
+    mkldnn_memory_format_t dtag; /* mkldnn_format_undef means any */
+    scales_t scales; /* one per input */
+};
+
+const size_t max_dims_len = 64;
+dims_t str2dims(const char *str);
+void dims2str(const dims_t &dims, char *buffer);
+fmts_t str2fmts(const char *str);
+void fmts2str(const fmts_t &fmts, char *buffer);
+scales_t str2scales(const char *str);
+void scales2str(const scales_t &scales, char *buffer);
+const size_t max_prb_len = max_dims_len + 392;
+void prb2str(const prb_t *p, char *buffer, bool canonical = false);
+
+/* some extra control parameters which shouldn't be placed in prb_t */
+extern const char *skip_impl; /* NULL or "" means do not skip anything */
+
+extern const char *perf_template; /* performance output template */
+void perf_report(const prb_t *p, const res_t *r, const char *pstr);
+
+inline size_t nelems(const prb_t *p) {
+    size_t n = 1;
+    for (size_t d = 0; d < p->dims.size(); ++d) n *= (size_t)p->dims[d];
+    return n;
+}
+
+void compute_ref(const prb_t *p, const std::vector<dnn_mem_t *> &src,
+        dnn_mem_t &dst);
+
+int doit(const prb_t *p, res_t *res);
+int bench(int argc, char **argv, bool main_bench = true);
+
+}
+
+#endif
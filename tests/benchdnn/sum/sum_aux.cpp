@@ -0,0 +1,115 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <stdlib.h>
+#include <assert.h>
+#include "sum/sum.hpp"
+
+namespace sum {
+
+#define DPRINT(...) do { \
+    int l = snprintf(buffer, rem_len, __VA_ARGS__); \
+    buffer += l; rem_len -= l; \
+} while(0)
+
+dims_t str2dims(const char *str) {
+    dims_t dims;
+    do {
+        int dim, len;
+        int scan = sscanf(str, "%d%n", &dim, &len);
+        SAFE_V(scan == 1 ? OK : FAIL);
+        dims.push_back(dim);
+        str += len;
+        SAFE_V(*str == 'x' || *str == '\0' ? OK : FAIL);
+    } while (*str++ != '\0');
+    return dims;
+}
+
+void dims2str(const dims_t &dims, char *buffer) {
+    int rem_len = max_dims_len;
+    for (size_t d = 0; d < dims.size() - 1; ++d)
+        DPRINT("%dx", dims[d]);
+    DPRINT("%d", dims[dims.size() - 1]);
+}
+
+fmts_t str2fmts(const char *str) {
+    fmts_t fmts;
+    char buf[32];
+    do {
+        size_t len = strcspn(str, ":");
+        SAFE_V(len > 0 && len < sizeof(buf) ? OK : FAIL);
+        strncpy(buf, str, len);
+        buf[len] = '\0';
+        fmts.push_back(str2fmt(buf));
+        str += len;
+    } while (*str++ != '\0');
+    return fmts;
+}
+
+void fmts2str(const fmts_t &fmts, char *buffer) {
+    int rem_len = max_prb_len;
+    for (size_t i = 0; i < fmts.size(); ++i)
+        DPRINT("%s%s", i ? ":" : "", fmt2str(fmts[i]));
+}
+
+scales_t str2scales(const char *str) {
+    scales_t scales;
+    do {
+        float scale;
+        int len;
+        int scan = sscanf(str, "%f%n", &scale, &len);
+        SAFE_V(scan == 1 ? OK : FAIL);
+        scales.push_back(scale);
+        str += len;
+        SAFE_V(*str == ':' || *str == '\0' ? OK : FAIL);
+    } while (*str++ != '\0');
+    return scales;
+}
+
+void scales2str(const scales_t &scales, char *buffer) {
+    int rem_len = max_prb_len;
+    for (size_t i = 0; i < scales.size(); ++i)
+        DPRINT("%s%g", i ? ":" : "", scales[i]);
+}
+
+void prb2str(const prb_t *p, char *buffer, bool canonical) {
+    char dims_buf[max_dims_len] = {0};
+    dims2str(p->dims, dims_buf);
+
+    char stag_buf[max_prb_len] = {0};
+    fmts2str(p->stag, stag_buf);
+
+    char scales_buf[max_prb_len] = {0};
+    scales2str(p->scales, scales_buf);
+
+    bool trivial_scales = true;
+    for (size_t i = 0; i < p->scales.size(); ++i)
+        trivial_scales = trivial_scales && p->scales[i] == 1.f;
+
+    int rem_len = max_prb_len;
+    if (canonical || p->sdt != mkldnn_f32)
+        DPRINT("--sdt=%s ", dt2str(p->sdt));
+    if (canonical || p->ddt != mkldnn_f32)
+        DPRINT("--ddt=%s ", dt2str(p->ddt));
+    DPRINT("--stag=%s ", stag_buf);
+    if (canonical || p->dtag != mkldnn_format_undef)
+        DPRINT("--dtag=%s ", fmt2str(p->dtag));
+    if (canonical || !trivial_scales)
+        DPRINT("--scales=%s ", scales_buf);
+    DPRINT("%s", dims_buf);
+}
+
+}
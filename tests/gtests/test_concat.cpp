@@ -91,7 +91,7 @@ class concat_test: public ::testing::TestWithParam<concat_test_params> {
 protected:
     virtual void SetUp() {
         SKIP_IF(data_traits<data_t>::data_type == impl::data_type::bf16
-                && !impl::cpu::mayiuse(impl::cpu::avx512_core),
+                && !impl::cpu::mayiuse_bf16_cvt(),
                 "current ISA doesn't support bfloat16 data type");
         concat_test_params p
             = ::testing::TestWithParam<decltype(p)>::GetParam();
@@ -138,9 +138,9 @@ private:
     std::shared_ptr<memory::desc> diff_data_desc_f32;
 
     virtual void SetUp() {
-        /* Skip test for systems with don't support avx512_core*/
+        /* Skip test for systems that cannot convert bfloat16 */
         bool implementation_supports_bf16 =
-            impl::cpu::mayiuse(impl::cpu::avx512_core);
+            impl::cpu::mayiuse_bf16_cvt();
         if (!implementation_supports_bf16) return;
         p = ::testing::TestWithParam<decltype(p)>::GetParam();
         catch_expected_failures([=](){Test();}, p.expect_to_fail,
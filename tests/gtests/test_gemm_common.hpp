@@ -610,9 +610,9 @@ protected:
 
 template <>
 void gemm_test_common<mkldnn_bfloat16_t, mkldnn_bfloat16_t, float>::SetUp() {
-        /* Skip test for systems that do not support avx512_core*/
+        /* Skip test for systems that cannot convert bfloat16 */
         bool implementation_supports_bf16 =
-            impl::cpu::mayiuse(impl::cpu::avx512_core);
+            impl::cpu::mayiuse_bf16_cvt();
         if (!implementation_supports_bf16) return;
         const auto &p = ::testing::TestWithParam<test_params>::GetParam();
         catch_expected_failures([=](){Test();}, p.expect_to_fail,
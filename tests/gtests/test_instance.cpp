@@ -0,0 +1,156 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+
+#include <thread>
+#include <vector>
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+#include "mkldnn_test_common.hpp"
+#include "gtest/gtest.h"
+
+#include "mkldnn.hpp"
+
+namespace mkldnn {
+
+class instance_test: public ::testing::Test {
+protected:
+    /* runs a relu on a stream bound to @p inst and checks the result */
+    void run_relu(instance &inst) {
+        auto eng = engine(engine::kind::cpu, 0);
+        const int nelems = 2 * 16 * 8 * 8;
+        memory::desc md({2, 16, 8, 8}, memory::data_type::f32,
+                memory::format::nchw);
+        memory src({md, eng}), dst({md, eng});
+        float *s_ptr = (float *)src.get_data_handle();
+        for (int i = 0; i < nelems; i++)
+            s_ptr[i] = (float)(i % 5) - 2.f;
+
+        auto pd = eltwise_forward::primitive_desc(eltwise_forward::desc(
+                    prop_kind::forward_inference, algorithm::eltwise_relu,
+                    md, 0.f), eng);
+
+        for (auto kind: { stream::kind::eager, stream::kind::lazy }) {
+            std::vector<primitive> pipeline;
+            pipeline.push_back(eltwise_forward(pd, src, dst));
+            stream s(kind);
+            s.set_instance(inst);
+            s.submit(pipeline).wait();
+
+            const float *d = (const float *)dst.get_data_handle();
+            for (int i = 0; i < nelems; i++)
+                ASSERT_EQ(d[i], s_ptr[i] > 0 ? s_ptr[i] : 0.f);
+        }
+    }
+};
+
+TEST_F(instance_test, TestErrors) {
+    mkldnn_instance_t inst;
+    EXPECT_EQ(mkldnn_instance_create(&inst, 0, -1),
+            mkldnn_invalid_arguments);
+    EXPECT_EQ(mkldnn_instance_create(&inst, 1, -2),
+            mkldnn_invalid_arguments);
+    EXPECT_EQ(mkldnn_instance_create(nullptr, 1, -1),
+            mkldnn_invalid_arguments);
+    EXPECT_EQ(mkldnn_instance_attach(nullptr), mkldnn_invalid_arguments);
+}
+
+TEST_F(instance_test, TestStream) {
+    instance inst(1);
+    run_relu(inst);
+}
+
+#if MKLDNN_THR != MKLDNN_THR_TBB
+TEST_F(instance_test, TestAttach) {
+    const int nthr = mkldnn_get_max_threads();
+    {
+        instance inst(1);
+        inst.attach();
+        EXPECT_EQ(mkldnn_get_max_threads(), 1);
+        run_relu(inst);
+        instance::detach();
+        EXPECT_EQ(mkldnn_get_max_threads(), nthr);
+    }
+    EXPECT_EQ(mkldnn_instance_detach(), mkldnn_success);
+}
+
+#ifdef __linux__
+TEST_F(instance_test, TestPinnedDetach) {
+    cpu_set_t before;
+    ASSERT_EQ(sched_getaffinity(0, sizeof(before), &before), 0);
+    int first_cpu = 0;
+    while (!CPU_ISSET(first_cpu, &before)) first_cpu++;
+
+    /* detaching gives the calling thread its affinity back */
+    instance inst(1, first_cpu);
+    inst.attach();
+    run_relu(inst);
+    instance::detach();
+    cpu_set_t after;
+    ASSERT_EQ(sched_getaffinity(0, sizeof(after), &after), 0);
+    EXPECT_TRUE(CPU_EQUAL(&before, &after));
+
+    /* so does a stream executed on the instance */
+    run_relu(inst);
+    ASSERT_EQ(sched_getaffinity(0, sizeof(after), &after), 0);
+    EXPECT_TRUE(CPU_EQUAL(&before, &after));
+}
+
+TEST_F(instance_test, TestPinnedDetachTeam) {
+    const int nthr = mkldnn_get_max_threads();
+    std::vector<cpu_set_t> before(nthr), after(nthr);
+    impl::parallel(nthr, [&](const int ithr, const int) {
+        sched_getaffinity(0, sizeof(cpu_set_t), &before[ithr]);
+    });
+    int first_cpu = 0;
+    while (!CPU_ISSET(first_cpu, &before[0])) first_cpu++;
+
+    /* primitives created while attached, then detaching gives every
+     * thread of the team its affinity back */
+    instance inst(nthr, first_cpu);
+    if (mkldnn_instance_attach(inst.get()) != mkldnn_success) return;
+    run_relu(inst);
+    instance::detach();
+    impl::parallel(nthr, [&](const int ithr, const int) {
+        sched_getaffinity(0, sizeof(cpu_set_t), &after[ithr]);
+    });
+    for (int ithr = 0; ithr < nthr; ithr++)
+        EXPECT_TRUE(CPU_EQUAL(&before[ithr], &after[ithr])) << ithr;
+}
+#endif
+
+TEST_F(instance_test, TestConcurrent) {
+    const int ninst = 2;
+    std::vector<std::thread> threads;
+    std::vector<int> nthr(ninst, 0);
+    for (int i = 0; i < ninst; i++)
+        threads.emplace_back([&, i]() {
+            instance inst(1);
+            inst.attach();
+            nthr[i] = mkldnn_get_max_threads();
+            run_relu(inst);
+            instance::detach();
+        });
+    for (auto &t: threads)
+        t.join();
+    for (int i = 0; i < ninst; i++)
+        EXPECT_EQ(nthr[i], 1);
+}
+#endif
+
+}
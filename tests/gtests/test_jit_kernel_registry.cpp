@@ -0,0 +1,64 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "mkldnn_test_common.hpp"
+#include "gtest/gtest.h"
+
+#include "mkldnn.hpp"
+
+namespace mkldnn {
+
+class jit_kernel_registry_test: public ::testing::Test {
+protected:
+    virtual void SetUp() {}
+
+    void stats(size_t &generated, size_t &deduplicated, size_t &saved) {
+        ASSERT_EQ(mkldnn_get_jit_kernel_registry_stats(&generated,
+                    &deduplicated, &saved), mkldnn_success);
+    }
+};
+
+TEST_F(jit_kernel_registry_test, TestInvalidArguments) {
+    EXPECT_EQ(mkldnn_get_jit_kernel_registry_stats(nullptr, nullptr, nullptr),
+            mkldnn_invalid_arguments);
+}
+
+TEST_F(jit_kernel_registry_test, TestReorderSharing) {
+    auto eng = engine(engine::kind::cpu, 0);
+    memory::dims dims = {2, 32, 7, 7};
+    memory::desc md_i(dims, memory::data_type::f32, memory::format::nchw);
+    memory::desc md_o(dims, memory::data_type::f32, memory::format::nChw16c);
+
+    memory src0({md_i, eng}), dst0({md_o, eng});
+    memory src1({md_i, eng}), dst1({md_o, eng});
+
+    size_t g0, d0, s0, g1, d1, s1, g2, d2, s2;
+    stats(g0, d0, s0);
+    auto r0 = reorder(src0, dst0);
+    stats(g1, d1, s1);
+    auto r1 = reorder(src1, dst1);
+    stats(g2, d2, s2);
+
+    // nchw -> nChw16c goes to jit_uni_reorder, which uses the registry
+    ASSERT_GT(g1, g0);
+    EXPECT_EQ(d1, d0);
+
+    EXPECT_EQ(g2, g1);
+    EXPECT_EQ(d2, d1 + 1);
+    EXPECT_GT(s2, s1);
+}
+
+}
@@ -343,7 +343,7 @@ private:
 
 protected:
     virtual void SetUp() {
-        SKIP_IF(!impl::cpu::mayiuse(impl::cpu::avx512_core),
+        SKIP_IF(!impl::cpu::mayiuse_bf16_cvt(),
                 "current ISA doesn't support bfloat16 data type");
         p = ::testing::TestWithParam<decltype(p)>::GetParam();
         catch_expected_failures(
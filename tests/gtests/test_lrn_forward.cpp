@@ -192,7 +192,7 @@ protected:
 class lrn_forward_test_bfloat16 : public lrn_forward_test<mkldnn_bfloat16_t>
 {
     void SetUp() {
-        SKIP_IF(!impl::cpu::mayiuse(impl::cpu::avx512_core),
+        SKIP_IF(!impl::cpu::mayiuse_bf16_cvt(),
                 "current ISA doesn't support bfloat16 data type");
         p = ::testing::TestWithParam<decltype(p)>::GetParam();
         catch_expected_failures(
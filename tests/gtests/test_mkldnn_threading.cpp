@@ -18,6 +18,7 @@
 
 #include "gtest/gtest.h"
 #include "mkldnn_test_common.hpp"
+#include "mkldnn_threadpool_iface.hpp"
 
 namespace mkldnn {
 
@@ -29,6 +30,60 @@ TEST(test_parallel, Test) {
     });
 }
 
+/* a sequential threadpool that counts the regions submitted to it */
+struct counting_threadpool_t: public threadpool_iface {
+    counting_threadpool_t(): calls(0) {}
+    virtual int get_num_threads() const override { return 4; }
+    virtual bool get_in_parallel() const override { return false; }
+    virtual void parallel_for(int n,
+            const std::function<void(int, int)> &fn) override {
+        ++calls;
+        for (int i = 0; i < n; ++i) fn(i, n);
+    }
+    int calls;
+};
+
+TEST(test_threadpool, UserThreadpool) {
+    counting_threadpool_t tp;
+    if (set_threadpool(&tp) == mkldnn_unimplemented) {
+        EXPECT_EQ(get_threadpool(), nullptr);
+        return;
+    }
+    EXPECT_EQ(get_threadpool(), &tp);
+    EXPECT_EQ(mkldnn_get_max_threads(), 4);
+
+    std::vector<int> visited(4, 0);
+    impl::parallel(0, [&](int ithr, int nthr) {
+        EXPECT_EQ(nthr, 4);
+        EXPECT_EQ(mkldnn_get_thread_num(), ithr);
+        EXPECT_TRUE(mkldnn_in_parallel());
+        // nested regions run on the calling thread
+        impl::parallel(0, [&](int, int nested_nthr) {
+            EXPECT_EQ(nested_nthr, 1);
+        });
+        visited[ithr]++;
+    });
+    EXPECT_EQ(tp.calls, 1);
+    for (int v: visited) EXPECT_EQ(v, 1);
+
+    EXPECT_EQ(set_threadpool(nullptr), mkldnn_success);
+    EXPECT_NE(get_threadpool(), &tp);
+}
+
+TEST(test_threadpool, DefaultThreadpool) {
+    threadpool_iface *tp = get_threadpool();
+    if (tp == nullptr) return;
+    EXPECT_GE(tp->get_num_threads(), 1);
+
+    const int n = 1000;
+    std::vector<int> visited(n, 0);
+    tp->parallel_for(n, [&](int i, int nn) {
+        EXPECT_EQ(nn, n);
+        visited[i]++;
+    });
+    for (int v: visited) EXPECT_EQ(v, 1);
+}
+
 typedef ptrdiff_t data_t;
 
 struct nd_params_t {
@@ -0,0 +1,81 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+#include "mkldnn_test_common.hpp"
+#include "gtest/gtest.h"
+
+#include "mkldnn.hpp"
+
+namespace mkldnn {
+
+TEST(numa_test, TestStreamNode) {
+    int nnodes = 0;
+    ASSERT_EQ(mkldnn_get_numa_node_count(&nnodes), mkldnn_success);
+    ASSERT_GE(nnodes, 1);
+
+#ifdef __linux__
+    cpu_set_t before;
+    ASSERT_EQ(sched_getaffinity(0, sizeof(before), &before), 0);
+#endif
+
+    stream s(stream::kind::eager);
+    EXPECT_EQ(mkldnn_stream_set_numa_node(s.get(), nnodes),
+            mkldnn_invalid_arguments);
+    EXPECT_EQ(mkldnn_stream_set_numa_node(s.get(), -2),
+            mkldnn_invalid_arguments);
+    s.set_numa_node(-1);
+
+    auto eng = engine(engine::kind::cpu, 0);
+    const int nelems = 2 * 16 * 8 * 8;
+    memory::desc md({2, 16, 8, 8}, memory::data_type::f32,
+            memory::format::nchw);
+    memory src({md, eng}), dst({md, eng});
+    float *s_ptr = (float *)src.get_data_handle();
+    for (int i = 0; i < nelems; i++)
+        s_ptr[i] = (float)(i % 5) - 2.f;
+
+    auto pd = eltwise_forward::primitive_desc(eltwise_forward::desc(
+                prop_kind::forward_inference, algorithm::eltwise_relu, md,
+                0.f), eng);
+
+    for (int node = 0; node < nnodes; node++) {
+        std::vector<primitive> pipeline;
+        pipeline.push_back(eltwise_forward(pd, src, dst));
+        stream sn(stream::kind::eager);
+        sn.set_numa_node(node);
+        sn.submit(pipeline).wait();
+
+        const float *d = (const float *)dst.get_data_handle();
+        for (int i = 0; i < nelems; i++)
+            ASSERT_EQ(d[i], s_ptr[i] > 0 ? s_ptr[i] : 0.f);
+    }
+
+#ifdef __linux__
+    /* a stream without a node restores the affinity of the process */
+    std::vector<primitive> pipeline;
+    pipeline.push_back(eltwise_forward(pd, src, dst));
+    stream(stream::kind::eager).submit(pipeline).wait();
+    cpu_set_t after;
+    ASSERT_EQ(sched_getaffinity(0, sizeof(after), &after), 0);
+    EXPECT_TRUE(CPU_EQUAL(&before, &after));
+#endif
+}
+
+}
@@ -0,0 +1,172 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <stdio.h>
+
+#include "mkldnn_test_common.hpp"
+#include "gtest/gtest.h"
+
+#include "mkldnn.hpp"
+
+namespace mkldnn {
+
+class packed_weights_test: public ::testing::Test {
+protected:
+    virtual void SetUp() { init(16, 32); }
+
+    void init(int ic, int oc) {
+        mkldnn_clear_packed_weights_cache();
+
+        src_md.reset(new memory::desc({2, ic, 7, 7}, memory::data_type::f32,
+                    memory::format::nchw));
+        wei_md.reset(new memory::desc({oc, ic, 3, 3}, memory::data_type::f32,
+                    memory::format::oihw));
+        auto any_wei_md = memory::desc({oc, ic, 3, 3}, memory::data_type::f32,
+                memory::format::any);
+        auto dst_md = memory::desc({2, oc, 7, 7}, memory::data_type::f32,
+                memory::format::nchw);
+        auto desc = convolution_forward::desc(prop_kind::forward_inference,
+                algorithm::convolution_direct, *src_md, any_wei_md, dst_md,
+                {1, 1}, {1, 1}, {1, 1}, padding_kind::zero);
+        conv_pd.reset(new convolution_forward::primitive_desc(desc, eng));
+
+        src.reset(new memory({*src_md, eng}));
+        wei.reset(new memory({*wei_md, eng}));
+        fill_data<float>(src->get_primitive_desc().get_size() / sizeof(float),
+                (float *)src->get_data_handle());
+        fill_data<float>(wei->get_primitive_desc().get_size() / sizeof(float),
+                (float *)wei->get_data_handle());
+    }
+
+    virtual void TearDown() { mkldnn_clear_packed_weights_cache(); }
+
+    memory run_conv(const memory &weights) {
+        memory dst(conv_pd->dst_primitive_desc());
+        std::vector<primitive> pipeline;
+        pipeline.push_back(convolution_forward(*conv_pd, *src, weights, dst));
+        stream(stream::kind::eager).submit(pipeline).wait();
+        return dst;
+    }
+
+    memory run_conv_reorder() {
+        memory weights(conv_pd->weights_primitive_desc());
+        std::vector<primitive> pipeline;
+        pipeline.push_back(reorder(*wei, weights));
+        stream(stream::kind::eager).submit(pipeline).wait();
+        return run_conv(weights);
+    }
+
+    void check_same(const memory &a, const memory &b) {
+        const size_t n = a.get_primitive_desc().get_size() / sizeof(float);
+        const float *pa = (const float *)a.get_data_handle();
+        const float *pb = (const float *)b.get_data_handle();
+        for (size_t i = 0; i < n; i++)
+            ASSERT_EQ(pa[i], pb[i]);
+    }
+
+    engine eng = engine(engine::kind::cpu, 0);
+    std::shared_ptr<memory::desc> src_md, wei_md;
+    std::shared_ptr<convolution_forward::primitive_desc> conv_pd;
+    std::shared_ptr<memory> src, wei;
+};
+
+TEST_F(packed_weights_test, TestPack) {
+    packed_weights pw(*conv_pd, 0, *wei);
+    EXPECT_TRUE(pw.get_primitive_desc()
+            == conv_pd->weights_primitive_desc());
+    check_same(run_conv(pw.create_memory()), run_conv_reorder());
+
+    mkldnn_packed_weights_t c_pw;
+    EXPECT_EQ(mkldnn_packed_weights_create(&c_pw, conv_pd->get(), 1,
+                wei->get(), nullptr), mkldnn_invalid_arguments);
+}
+
+TEST_F(packed_weights_test, TestCache) {
+    size_t h0, m0, b0;
+    mkldnn_get_packed_weights_cache_stats(&h0, &m0, &b0);
+    EXPECT_EQ(b0, 0u);
+
+    packed_weights pw0(*conv_pd, 0, *wei, "conv1");
+    packed_weights pw1(*conv_pd, 0, *wei, "conv1");
+    packed_weights pw2(*conv_pd, 0, *wei, "conv2");
+    packed_weights pw3(*conv_pd, 0, *wei);
+
+    size_t h, m, b;
+    mkldnn_get_packed_weights_cache_stats(&h, &m, &b);
+    EXPECT_EQ(h, h0 + 1);
+    EXPECT_EQ(m, m0 + 2);
+    EXPECT_EQ(b, 2 * conv_pd->weights_primitive_desc().get_size());
+
+    EXPECT_EQ(pw0.get_data_handle(), pw1.get_data_handle());
+    EXPECT_NE(pw0.get_data_handle(), pw2.get_data_handle());
+    EXPECT_NE(pw0.get_data_handle(), pw3.get_data_handle());
+
+    // the handles keep the data alive after the cache is cleared
+    mkldnn_clear_packed_weights_cache();
+    mkldnn_get_packed_weights_cache_stats(nullptr, nullptr, &b);
+    EXPECT_EQ(b, 0u);
+    check_same(run_conv(pw1.create_memory()), run_conv_reorder());
+}
+
+/* the channels are padded in the blocked weights formats, the padded data
+ * is shared and must not be written to when it is bound */
+class packed_weights_padded_test: public packed_weights_test {
+protected:
+    virtual void SetUp() { init(3, 3); }
+};
+
+TEST_F(packed_weights_padded_test, TestPack) {
+    packed_weights pw(*conv_pd, 0, *wei, "conv1");
+    packed_weights pw1(*conv_pd, 0, *wei, "conv1");
+    EXPECT_EQ(pw.get_data_handle(), pw1.get_data_handle());
+    check_same(run_conv(pw.create_memory()), run_conv_reorder());
+    check_same(run_conv(pw1.create_memory()), run_conv_reorder());
+}
+
+#ifndef _WIN32
+TEST_F(packed_weights_test, TestSaveLoad) {
+    const char *path = "test_packed_weights.bin";
+    packed_weights pw(*conv_pd, 0, *wei);
+    pw.save(path);
+
+    packed_weights loaded(eng, path, "conv1");
+    EXPECT_TRUE(loaded.get_primitive_desc()
+            == conv_pd->weights_primitive_desc());
+    check_same(run_conv(loaded.create_memory()), run_conv_reorder());
+
+    packed_weights reloaded(eng, path, "conv1");
+    EXPECT_EQ(loaded.get_data_handle(), reloaded.get_data_handle());
+
+    remove(path);
+
+    mkldnn_packed_weights_t c_pw;
+    EXPECT_EQ(mkldnn_packed_weights_load(&c_pw, eng.get(), path, nullptr),
+            mkldnn_invalid_arguments);
+}
+
+TEST_F(packed_weights_padded_test, TestSaveLoad) {
+    const char *path = "test_packed_weights_padded.bin";
+    packed_weights pw(*conv_pd, 0, *wei);
+    pw.save(path);
+
+    packed_weights loaded(eng, path, "conv1");
+    check_same(run_conv(loaded.create_memory()), run_conv_reorder());
+
+    remove(path);
+}
+#endif
+
+}
@@ -391,8 +391,8 @@ class pooling_bwd_test_bfloat16 : public pooling_bwd_test<mkldnn_bfloat16_t> {
     memory::data_type f32_data_type = data_traits<float>::data_type;
 
     virtual void SetUp() {
-        SKIP_IF(!impl::cpu::mayiuse(impl::cpu::avx512_core),
-                "avx512_core ISA needed to support bfloat16 data type");
+        SKIP_IF(!impl::cpu::mayiuse_bf16_cvt(),
+                "bfloat16 data type is not supported");
         p = ::testing::TestWithParam<decltype(p)>::GetParam();
         catch_expected_failures([=](){Test();}, p.expect_to_fail,
                     p.expected_status);
@@ -1362,4 +1362,22 @@ INSTANTIATE_TEST_SUITE_P(
             memory::format::nChw16c, memory::format::nChw16c,
             EXPAND_SIZES_2D(1, 96, 300, 500, 151, 251, 3, 3, 1, 1, 2, 2) }
             ));
+
+/* mb * nb_c below the thread count: the rows of each vector of a global
+ * pooling are split across threads */
+INSTANTIATE_TEST_SUITE_P(
+        TestPoolingBackwardGlobalSplit, pooling_bwd_test_float, ::testing::Values(
+            pool_bwd_test_params{
+            engine::kind::cpu, algorithm::pooling_max,
+            memory::format::nChw16c, memory::format::nChw16c,
+            EXPAND_SIZES_2D(1, 16, 64, 64, 1, 1, 64, 64, 0, 0, 1, 1) },
+            pool_bwd_test_params{
+            engine::kind::cpu, algorithm::pooling_max,
+            memory::format::nhwc, memory::format::nhwc,
+            EXPAND_SIZES_2D(1, 16, 64, 64, 1, 1, 64, 64, 0, 0, 1, 1) },
+            pool_bwd_test_params{
+            engine::kind::cpu, algorithm::pooling_avg_exclude_padding,
+            memory::format::nChw16c, memory::format::nChw16c,
+            EXPAND_SIZES_2D(1, 16, 64, 64, 1, 1, 64, 64, 0, 0, 1, 1) }
+            ));
 }
@@ -169,6 +169,11 @@ protected:
                     p.expected_status);
     }
 
+    virtual void FillSrc() {
+        fill_data<data_t>(src_size,
+                (data_t *)p_src->get_data_handle(), 1., true);
+    }
+
     virtual void CheckForward() {
         float eps = p.aalgorithm == pooling_max
             ?  0.0
@@ -200,8 +205,7 @@ protected:
         dst_size = p_dst->get_primitive_desc().get_size()/ sizeof(data_t);
         src_size = p_src->get_primitive_desc().get_size()/ sizeof(data_t);
 
-        fill_data<data_t>(src_size,
-                (data_t *)p_src->get_data_handle(), 1., true);
+        FillSrc();
         fill_data<data_t>(dst_size,
                 (data_t *)p_dst->get_data_handle(), 1., true);
 
@@ -253,6 +257,17 @@ protected:
 };
 
 using pooling_test_float = pooling_test<float>;
+
+/* Few distinct values, so that every window holds several equal maxima and
+ * the workspace must point to the first one. */
+class pooling_test_float_ties : public pooling_test<float> {
+protected:
+    virtual void FillSrc() {
+        float *src = (float *)p_src->get_data_handle();
+        for (size_t i = 0; i < src_size; i++)
+            src[i] = (float)(i % 5);
+    }
+};
 using pooling_test_s8 = pooling_test<int8_t>;
 using pooling_test_u8 = pooling_test<uint8_t>;
 using pooling_test_s32 = pooling_test<int32_t>;
@@ -262,8 +277,8 @@ class pooling_test_bfloat16: public pooling_test<mkldnn_bfloat16_t> {
     std::shared_ptr<memory> p_src_f32, p_dst_f32;
 
     void SetUp() {
-        SKIP_IF(!impl::cpu::mayiuse(impl::cpu::avx512_core),
-                "avx512_core ISA needed to support bfloat16 data type");
+        SKIP_IF(!impl::cpu::mayiuse_bf16_cvt(),
+                "bfloat16 data type is not supported");
         p = ::testing::TestWithParam<decltype(p)>::GetParam();
         catch_expected_failures([=](){Test();}, p.expect_to_fail,
                     p.expected_status);
@@ -2024,4 +2039,24 @@ INSTANTIATE_TEST_SUITE_P(
             memory::format::nChw16c, memory::format::nChw16c,
             EXPAND_SIZES_2D(1, 96, 300, 500, 151, 251, 3, 3, 1, 1, 2, 2) }
             ));
+
+TEST_P(pooling_test_float_ties, TestsPooling) {}
+
+/* mb * nb_c below the thread count: a global pooling splits the rows of each
+ * vector across threads and merges the partial maxima */
+INSTANTIATE_TEST_SUITE_P(
+        TestPoolingForwardMaxGlobalSplit, pooling_test_float_ties, ::testing::Values(
+            pool_test_params{ prop_kind::forward_training,
+            engine::kind::cpu, algorithm::pooling_max,
+            memory::format::nChw16c, memory::format::nChw16c,
+            EXPAND_SIZES_2D(1, 16, 64, 64, 1, 1, 64, 64, 0, 0, 1, 1) },
+            pool_test_params{ prop_kind::forward_training,
+            engine::kind::cpu, algorithm::pooling_max,
+            memory::format::nhwc, memory::format::nhwc,
+            EXPAND_SIZES_2D(1, 16, 64, 64, 1, 1, 64, 64, 0, 0, 1, 1) },
+            pool_test_params{ prop_kind::forward_training,
+            engine::kind::cpu, algorithm::pooling_avg_exclude_padding,
+            memory::format::nChw16c, memory::format::nChw16c,
+            EXPAND_SIZES_2D(1, 16, 64, 64, 1, 1, 64, 64, 0, 0, 1, 1) }
+            ));
 }
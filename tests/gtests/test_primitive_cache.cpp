@@ -0,0 +1,139 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "mkldnn_test_common.hpp"
+#include "gtest/gtest.h"
+
+#include "mkldnn.hpp"
+
+namespace mkldnn {
+
+class primitive_cache_test: public ::testing::Test {
+protected:
+    virtual void SetUp() {
+        mkldnn_get_primitive_cache_capacity(&saved_capacity);
+    }
+    virtual void TearDown() {
+        mkldnn_set_primitive_cache_capacity(saved_capacity);
+    }
+
+    size_t hits() {
+        size_t h = 0;
+        mkldnn_get_primitive_cache_stats(&h, nullptr, nullptr);
+        return h;
+    }
+    size_t misses() {
+        size_t m = 0;
+        mkldnn_get_primitive_cache_stats(nullptr, &m, nullptr);
+        return m;
+    }
+    int size() {
+        int s = 0;
+        mkldnn_get_primitive_cache_stats(nullptr, nullptr, &s);
+        return s;
+    }
+
+    /* Runs relu(x) = max(x, alpha * x) on a fresh pair of memories and
+     * checks the result. */
+    void run_relu(const engine &eng, float alpha) {
+        const int nelems = 2 * 16 * 4 * 4;
+        memory::desc md({2, 16, 4, 4}, memory::data_type::f32,
+                memory::format::nchw);
+        memory src({md, eng}), dst({md, eng});
+
+        float *s = (float *)src.get_data_handle();
+        float *d = (float *)dst.get_data_handle();
+        for (int i = 0; i < nelems; i++) {
+            s[i] = (float)(i % 7) - 3.f;
+            d[i] = 0.f;
+        }
+
+        auto desc = eltwise_forward::desc(prop_kind::forward_inference,
+                algorithm::eltwise_relu, md, alpha);
+        auto pd = eltwise_forward::primitive_desc(desc, eng);
+        std::vector<primitive> pipeline;
+        pipeline.push_back(eltwise_forward(pd, src, dst));
+        stream(stream::kind::eager).submit(pipeline).wait();
+
+        for (int i = 0; i < nelems; i++) {
+            const float ref = s[i] > 0 ? s[i] : alpha * s[i];
+            ASSERT_EQ(ref, d[i]);
+        }
+    }
+
+    int saved_capacity;
+};
+
+TEST_F(primitive_cache_test, TestCapacity) {
+    EXPECT_EQ(mkldnn_set_primitive_cache_capacity(-1),
+            mkldnn_invalid_arguments);
+    EXPECT_EQ(mkldnn_get_primitive_cache_capacity(nullptr),
+            mkldnn_invalid_arguments);
+
+    int capacity = -1;
+    EXPECT_EQ(mkldnn_set_primitive_cache_capacity(3), mkldnn_success);
+    EXPECT_EQ(mkldnn_get_primitive_cache_capacity(&capacity), mkldnn_success);
+    EXPECT_EQ(capacity, 3);
+}
+
+TEST_F(primitive_cache_test, TestReuse) {
+    auto eng = engine(engine::kind::cpu, 0);
+    mkldnn_set_primitive_cache_capacity(0);
+    mkldnn_set_primitive_cache_capacity(4);
+
+    const size_t h0 = hits(), m0 = misses();
+
+    run_relu(eng, 0.f);
+    EXPECT_EQ(misses(), m0 + 1);
+    EXPECT_EQ(size(), 1);
+
+    // same descriptor, new inputs and outputs: the primitive is reused
+    run_relu(eng, 0.f);
+    EXPECT_EQ(hits(), h0 + 1);
+    EXPECT_EQ(size(), 1);
+
+    // different attributes of the op descriptor
+    run_relu(eng, 0.5f);
+    EXPECT_EQ(misses(), m0 + 2);
+    EXPECT_EQ(size(), 2);
+
+    // disabling the cache drops the cached primitives
+    mkldnn_set_primitive_cache_capacity(0);
+    EXPECT_EQ(size(), 0);
+    run_relu(eng, 0.f);
+    EXPECT_EQ(hits(), h0 + 1);
+    EXPECT_EQ(size(), 0);
+}
+
+TEST_F(primitive_cache_test, TestEviction) {
+    auto eng = engine(engine::kind::cpu, 0);
+    mkldnn_set_primitive_cache_capacity(0);
+    mkldnn_set_primitive_cache_capacity(1);
+
+    const size_t h0 = hits();
+
+    run_relu(eng, 0.f);
+    run_relu(eng, 0.5f);
+    EXPECT_EQ(size(), 1);
+
+    // the alpha = 0 primitive was the least recently used one
+    run_relu(eng, 0.f);
+    EXPECT_EQ(hits(), h0);
+    run_relu(eng, 0.f);
+    EXPECT_EQ(hits(), h0 + 1);
+}
+
+}
@@ -0,0 +1,148 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "mkldnn_test_common.hpp"
+#include "gtest/gtest.h"
+
+#include "mkldnn.hpp"
+
+namespace mkldnn {
+
+class profiling_test: public ::testing::Test {
+protected:
+    virtual void SetUp() {
+        mkldnn_get_profiling_capacity(&saved_capacity);
+    }
+    virtual void TearDown() {
+        mkldnn_set_profiling_capacity(saved_capacity);
+    }
+
+    std::vector<mkldnn_profiling_record_t> records() {
+        int n = 0;
+        mkldnn_get_profiling_records(nullptr, &n);
+        std::vector<mkldnn_profiling_record_t> recs(n);
+        if (n > 0) mkldnn_get_profiling_records(&recs[0], &n);
+        recs.resize(n);
+        return recs;
+    }
+
+    void run_relu(const engine &eng, int times) {
+        memory::desc md({2, 16, 4, 4}, memory::data_type::f32,
+                memory::format::nchw);
+        memory src({md, eng}), dst({md, eng});
+        auto desc = eltwise_forward::desc(prop_kind::forward_inference,
+                algorithm::eltwise_relu, md, 0.f);
+        auto pd = eltwise_forward::primitive_desc(desc, eng);
+        std::vector<primitive> pipeline;
+        pipeline.push_back(eltwise_forward(pd, src, dst));
+        for (int i = 0; i < times; i++)
+            stream(stream::kind::eager).submit(pipeline).wait();
+    }
+
+    int saved_capacity;
+};
+
+TEST_F(profiling_test, TestCapacity) {
+    EXPECT_EQ(mkldnn_set_profiling_capacity(-1), mkldnn_invalid_arguments);
+    EXPECT_EQ(mkldnn_get_profiling_capacity(nullptr),
+            mkldnn_invalid_arguments);
+    EXPECT_EQ(mkldnn_get_profiling_records(nullptr, nullptr),
+            mkldnn_invalid_arguments);
+
+    int capacity = -1;
+    EXPECT_EQ(mkldnn_set_profiling_capacity(16), mkldnn_success);
+    EXPECT_EQ(mkldnn_get_profiling_capacity(&capacity), mkldnn_success);
+    EXPECT_EQ(capacity, 16);
+
+    // disabled profiler records nothing
+    mkldnn_set_profiling_capacity(0);
+    run_relu(engine(engine::kind::cpu, 0), 1);
+    EXPECT_EQ(records().size(), 0U);
+}
+
+TEST_F(profiling_test, TestRecords) {
+    auto eng = engine(engine::kind::cpu, 0);
+    mkldnn_set_profiling_capacity(64);
+
+    run_relu(eng, 3);
+    auto recs = records();
+    ASSERT_EQ(recs.size(), 4U);
+
+    EXPECT_EQ(recs[0].event, mkldnn_profiling_create);
+    for (size_t i = 0; i < recs.size(); i++) {
+        const auto &r = recs[i];
+        if (i > 0) {
+            EXPECT_EQ(r.event, mkldnn_profiling_execute);
+            EXPECT_GE(r.start_us, recs[i - 1].start_us);
+        }
+        EXPECT_EQ(r.primitive_kind, mkldnn_eltwise);
+        EXPECT_GT(strlen(r.impl_name), 0U);
+        EXPECT_GE(r.duration_us, 0.);
+        EXPECT_GT(r.nthr, 0);
+    }
+
+    mkldnn_reset_profiling();
+    EXPECT_EQ(records().size(), 0U);
+}
+
+TEST_F(profiling_test, TestRingBuffer) {
+    auto eng = engine(engine::kind::cpu, 0);
+    mkldnn_set_profiling_capacity(4);
+
+    run_relu(eng, 10);
+    auto recs = records();
+    ASSERT_EQ(recs.size(), 4U);
+    for (auto &r: recs)
+        EXPECT_EQ(r.event, mkldnn_profiling_execute);
+
+    // a short buffer receives the most recent records
+    mkldnn_profiling_record_t last[2];
+    int n = 2;
+    EXPECT_EQ(mkldnn_get_profiling_records(last, &n), mkldnn_success);
+    EXPECT_EQ(n, 2);
+    EXPECT_EQ(last[1].start_us, recs[3].start_us);
+}
+
+TEST_F(profiling_test, TestTrace) {
+    auto eng = engine(engine::kind::cpu, 0);
+    mkldnn_set_profiling_capacity(16);
+    run_relu(eng, 2);
+
+    EXPECT_EQ(mkldnn_dump_profiling_trace(nullptr), mkldnn_invalid_arguments);
+
+    const char *path = "test_profiling_trace.json";
+    ASSERT_EQ(mkldnn_dump_profiling_trace(path), mkldnn_success);
+
+    FILE *f = fopen(path, "r");
+    ASSERT_NE(f, nullptr);
+    std::string trace;
+    char buf[256];
+    size_t l;
+    while ((l = fread(buf, 1, sizeof(buf), f)) > 0)
+        trace.append(buf, l);
+    fclose(f);
+    remove(path);
+
+    EXPECT_EQ(trace.find("{\"traceEvents\":["), 0U);
+    EXPECT_NE(trace.find("\"cat\":\"create\""), std::string::npos);
+    EXPECT_NE(trace.find("\"cat\":\"execute\""), std::string::npos);
+    EXPECT_NE(trace.find("\"kind\":\"eltwise\""), std::string::npos);
+}
+
+}
@@ -0,0 +1,83 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+
+#include "mkldnn_test_common.hpp"
+#include "gtest/gtest.h"
+
+#include "mkldnn.hpp"
+
+namespace mkldnn {
+
+class scratchpad_arena_test: public ::testing::Test {
+protected:
+    mkldnn_arena_stats_t stats() {
+        mkldnn_arena_stats_t s;
+        EXPECT_EQ(mkldnn_get_scratchpad_arena_stats(&s), mkldnn_success);
+        EXPECT_LE(s.in_use, s.mapped);
+        EXPECT_LE(s.requested, s.in_use);
+        EXPECT_LE(s.in_use, s.peak_in_use);
+        EXPECT_LE(s.hugepage_mapped, s.mapped);
+        EXPECT_LE(s.reuses, s.allocations);
+        return s;
+    }
+
+    /* a convolution computed with im2col needs a large scratchpad */
+    void run_conv(const engine &eng) {
+        memory::dims src_dims = {1, 64, 56, 56}, wei_dims = {64, 64, 3, 3};
+        memory::desc src_md(src_dims, memory::data_type::f32,
+                memory::format::nchw);
+        memory::desc wei_md(wei_dims, memory::data_type::f32,
+                memory::format::oihw);
+        auto desc = convolution_forward::desc(prop_kind::forward_inference,
+                algorithm::convolution_direct, src_md, wei_md, src_md,
+                {1, 1}, {1, 1}, {1, 1}, padding_kind::zero);
+        auto pd = convolution_forward::primitive_desc(desc, eng);
+
+        memory src({src_md, eng}), wei({wei_md, eng}), dst({src_md, eng});
+        fill_data<float>(64 * 56 * 56, (float *)src.get_data_handle());
+        fill_data<float>(64 * 64 * 9, (float *)wei.get_data_handle());
+        std::vector<primitive> pipeline;
+        pipeline.push_back(convolution_forward(pd, src, wei, dst));
+        stream(stream::kind::eager).submit(pipeline).wait();
+    }
+};
+
+TEST_F(scratchpad_arena_test, TestReuse) {
+    EXPECT_EQ(mkldnn_get_scratchpad_arena_stats(nullptr),
+            mkldnn_invalid_arguments);
+
+    auto eng = engine(engine::kind::cpu, 0);
+    const auto s0 = stats();
+
+    run_conv(eng);
+    const auto s1 = stats();
+    EXPECT_EQ(s1.in_use, s0.in_use);
+
+    // a second primitive with the same scratchpad size reuses the block
+    run_conv(eng);
+    const auto s2 = stats();
+    EXPECT_EQ(s2.in_use, s0.in_use);
+    EXPECT_EQ(s2.mapped, s1.mapped);
+    EXPECT_EQ(s2.allocations - s1.allocations, s1.allocations - s0.allocations);
+    EXPECT_GE(s2.reuses - s1.reuses, s1.allocations - s0.allocations);
+
+    ASSERT_EQ(mkldnn_trim_scratchpad_arena(), mkldnn_success);
+    const auto s3 = stats();
+    EXPECT_EQ(s3.mapped, s3.in_use);
+}
+
+}
@@ -0,0 +1,164 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <vector>
+
+#include "mkldnn_test_common.hpp"
+#include "gtest/gtest.h"
+
+#include "mkldnn.hpp"
+
+namespace mkldnn {
+
+class scratchpad_mode_test: public ::testing::Test {
+protected:
+    virtual void SetUp() {
+        eng = engine(engine::kind::cpu, 0);
+        src_md.reset(new memory::desc({2, 16, 13, 13},
+                    memory::data_type::f32, memory::format::nchw));
+        wei_md.reset(new memory::desc({32, 16, 3, 3},
+                    memory::data_type::f32, memory::format::oihw));
+        dst_md.reset(new memory::desc({2, 32, 11, 11},
+                    memory::data_type::f32, memory::format::nchw));
+
+        src.reset(new memory({*src_md, eng}));
+        wei.reset(new memory({*wei_md, eng}));
+        fill_data<float>(src->get_primitive_desc().get_size() / sizeof(float),
+                (float *)src->get_data_handle());
+        fill_data<float>(wei->get_primitive_desc().get_size() / sizeof(float),
+                (float *)wei->get_data_handle());
+    }
+
+    convolution_forward::primitive_desc conv_pd(scratchpad_mode mode) {
+        auto d = convolution_forward::desc(prop_kind::forward_inference,
+                convolution_direct, *src_md, *wei_md, *dst_md, {1, 1},
+                {0, 0}, {0, 0}, padding_kind::zero);
+        primitive_attr attr;
+        attr.set_scratchpad_mode(mode);
+        EXPECT_EQ(attr.get_scratchpad_mode(), mode);
+        return convolution_forward::primitive_desc(d, attr, eng);
+    }
+
+    static size_t scratchpad_size(const convolution_forward::primitive_desc
+            &pd) {
+        ptrdiff_t size = 0;
+        EXPECT_EQ(mkldnn_primitive_desc_query(pd.get(),
+                    mkldnn_query_memory_consumption_s64, 0, &size),
+                mkldnn_success);
+        return (size_t)size;
+    }
+
+    engine eng;
+    std::shared_ptr<memory::desc> src_md, wei_md, dst_md;
+    std::shared_ptr<memory> src, wei;
+};
+
+TEST_F(scratchpad_mode_test, TestUserScratchpad) {
+    auto lib_pd = conv_pd(scratchpad_mode::library);
+    memory dst_lib({*dst_md, eng});
+    auto conv_lib = convolution_forward(lib_pd, *src, *wei, dst_lib);
+    stream(stream::kind::eager).submit({conv_lib}).wait();
+
+    auto user_pd = conv_pd(scratchpad_mode::user);
+    const size_t size = scratchpad_size(user_pd);
+    memory dst_user({*dst_md, eng});
+    auto conv_user = convolution_forward(user_pd, *src, *wei, dst_user);
+
+    /* the stream sizes the scratchpad once all the primitives are known */
+    auto s = stream(stream::kind::lazy);
+    s.submit({conv_user});
+    EXPECT_EQ(s.get_scratchpad_size(), size);
+
+    std::vector<char> buf(size + 1);
+    s.set_scratchpad(buf.data(), buf.size());
+    s.wait();
+    compare_data<float>(dst_lib, dst_user);
+
+    /* the stream allocates the scratchpad if none is given */
+    memory dst_owned({*dst_md, eng});
+    auto conv_owned = convolution_forward(user_pd, *src, *wei, dst_owned);
+    stream(stream::kind::eager).submit({conv_owned}).wait();
+    compare_data<float>(dst_lib, dst_owned);
+}
+
+/* the deconvolution nests a convolution, which must keep its own
+ * scratchpad: only the outer primitive is executed by the stream */
+TEST_F(scratchpad_mode_test, TestDeconvolution) {
+    memory::desc deconv_wei_md({16, 32, 3, 3}, memory::data_type::f32,
+            memory::format::oihw);
+    memory deconv_wei({deconv_wei_md, eng});
+    fill_data<float>(deconv_wei.get_primitive_desc().get_size()
+            / sizeof(float), (float *)deconv_wei.get_data_handle());
+    memory deconv_src({*dst_md, eng});
+    fill_data<float>(deconv_src.get_primitive_desc().get_size()
+            / sizeof(float), (float *)deconv_src.get_data_handle());
+
+    auto d = deconvolution_forward::desc(prop_kind::forward_inference,
+            deconvolution_direct, *dst_md, deconv_wei_md, *src_md, {1, 1},
+            {0, 0}, {0, 0}, padding_kind::zero);
+    auto deconv = [&](scratchpad_mode mode, const memory &dst) {
+        primitive_attr attr;
+        attr.set_scratchpad_mode(mode);
+        auto pd = deconvolution_forward::primitive_desc(d, attr, eng);
+        return deconvolution_forward(pd, deconv_src, deconv_wei, dst);
+    };
+
+    memory dst_lib({*src_md, eng});
+    stream(stream::kind::eager).submit(
+            {deconv(scratchpad_mode::library, dst_lib)}).wait();
+
+    memory dst_eager({*src_md, eng});
+    stream(stream::kind::eager).submit(
+            {deconv(scratchpad_mode::user, dst_eager)}).wait();
+    compare_data<float>(dst_lib, dst_eager);
+
+    memory dst_lazy({*src_md, eng});
+    stream(stream::kind::lazy).submit(
+            {deconv(scratchpad_mode::user, dst_lazy)}).wait();
+    compare_data<float>(dst_lib, dst_lazy);
+}
+
+TEST_F(scratchpad_mode_test, TestTooSmallScratchpad) {
+    auto user_pd = conv_pd(scratchpad_mode::user);
+    const size_t size = scratchpad_size(user_pd);
+    if (size == 0) return;
+
+    memory dst({*dst_md, eng});
+    auto conv = convolution_forward(user_pd, *src, *wei, dst);
+    std::vector<char> buf(size - 1);
+    auto s = stream(stream::kind::eager);
+    s.set_scratchpad(buf.data(), buf.size());
+    EXPECT_THROW(s.submit({conv}), error);
+}
+
+TEST_F(scratchpad_mode_test, TestInvalidArguments) {
+    mkldnn_stream_t s;
+    ASSERT_EQ(mkldnn_stream_create(&s, mkldnn_eager), mkldnn_success);
+    EXPECT_EQ(mkldnn_stream_set_scratchpad(s, nullptr, 16),
+            mkldnn_invalid_arguments);
+    EXPECT_EQ(mkldnn_stream_get_scratchpad_size(s, nullptr),
+            mkldnn_invalid_arguments);
+    EXPECT_EQ(mkldnn_stream_set_scratchpad(s, nullptr, 0), mkldnn_success);
+    mkldnn_stream_destroy(s);
+
+    mkldnn_primitive_attr_t attr;
+    ASSERT_EQ(mkldnn_primitive_attr_create(&attr), mkldnn_success);
+    EXPECT_EQ(mkldnn_primitive_attr_set_scratchpad_mode(attr,
+                (mkldnn_scratchpad_mode_t)2), mkldnn_invalid_arguments);
+    mkldnn_primitive_attr_destroy(attr);
+}
+
+}
@@ -166,6 +166,9 @@ INSTANTIATE_TEST_SUITE_P(TestSoftmaxBackward, softmax_backward_test_float,
             softmax_bwd_test_params_float{ engine::kind::cpu, memory::format::nc, memory::format::nc, {16, 30000}, 1},
             softmax_bwd_test_params_float{ engine::kind::cpu, memory::format::nc, memory::format::nc, {2, 1000}, 1},
             softmax_bwd_test_params_float{ engine::kind::cpu, memory::format::nChw8c, memory::format::nChw8c, {64, 1011, 1, 1}, 1},
-            softmax_bwd_test_params_float{ engine::kind::cpu, memory::format::nChw8c, memory::format::nChw8c, {2, 1011, 32, 1}, 2}
+            softmax_bwd_test_params_float{ engine::kind::cpu, memory::format::nChw8c, memory::format::nChw8c, {2, 1011, 32, 1}, 2},
+            softmax_bwd_test_params_float{ engine::kind::cpu, memory::format::nChw16c, memory::format::nChw16c, {2, 35, 7, 9}, 0},
+            softmax_bwd_test_params_float{ engine::kind::cpu, memory::format::nChw16c, memory::format::nChw16c, {2, 35, 7, 9}, 1},
+            softmax_bwd_test_params_float{ engine::kind::cpu, memory::format::nchw, memory::format::nchw, {2, 35, 7, 9}, 1}
 ));
 }
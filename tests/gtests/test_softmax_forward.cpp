@@ -233,5 +233,13 @@ INSTANTIATE_TEST_SUITE_P(TestSoftmaxForward, softmax_forward_test_float,
             softmax_fwd_test_params_float{prop_kind::forward_scoring,
             engine::kind::cpu, memory::format::nChw8c, {64, 1011, 1, 1}, 1},
             softmax_fwd_test_params_float{prop_kind::forward_scoring,
-            engine::kind::cpu, memory::format::nChw8c, {2, 1000, 32, 1}, 2}));
+            engine::kind::cpu, memory::format::nChw8c, {2, 1000, 32, 1}, 2},
+            softmax_fwd_test_params_float{prop_kind::forward_scoring,
+            engine::kind::cpu, memory::format::nChw16c, {2, 35, 7, 9}, 0},
+            softmax_fwd_test_params_float{prop_kind::forward_scoring,
+            engine::kind::cpu, memory::format::nChw16c, {2, 35, 7, 9}, 1},
+            softmax_fwd_test_params_float{prop_kind::forward_scoring,
+            engine::kind::cpu, memory::format::nChw16c, {2, 35, 7, 9}, 2},
+            softmax_fwd_test_params_float{prop_kind::forward_scoring,
+            engine::kind::cpu, memory::format::nhwc, {2, 35, 7, 9}, 1}));
 }
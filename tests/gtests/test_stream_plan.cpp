@@ -0,0 +1,177 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <vector>
+
+#include "mkldnn_test_common.hpp"
+#include "gtest/gtest.h"
+
+#include "mkldnn.hpp"
+
+namespace mkldnn {
+
+class stream_plan_test: public ::testing::Test {
+protected:
+    virtual void SetUp() {
+        eng = engine(engine::kind::cpu, 0);
+        src_md.reset(new memory::desc({2, 16, 13, 13},
+                    memory::data_type::f32, memory::format::nchw));
+        wei_md.reset(new memory::desc({32, 16, 3, 3},
+                    memory::data_type::f32, memory::format::oihw));
+        dst_md.reset(new memory::desc({2, 32, 11, 11},
+                    memory::data_type::f32, memory::format::nchw));
+
+        src.reset(new memory({*src_md, eng}));
+        wei.reset(new memory({*wei_md, eng}));
+        fill_data<float>(src->get_primitive_desc().get_size() / sizeof(float),
+                (float *)src->get_data_handle());
+        fill_data<float>(wei->get_primitive_desc().get_size() / sizeof(float),
+                (float *)wei->get_data_handle());
+    }
+
+    /* conv -> in-place relu, the relu may be folded into the conv for
+     * inference */
+    std::vector<primitive> conv_relu(const memory &dst,
+            prop_kind pk = prop_kind::forward_inference) {
+        auto conv_d = convolution_forward::desc(pk,
+                convolution_direct, *src_md, *wei_md, *dst_md, {1, 1},
+                {0, 0}, {0, 0}, padding_kind::zero);
+        auto conv_pd = convolution_forward::primitive_desc(conv_d, eng);
+        auto relu_d = eltwise_forward::desc(pk,
+                algorithm::eltwise_relu, *dst_md, 0.f, 0.f);
+        auto relu_pd = eltwise_forward::primitive_desc(relu_d, eng);
+        return { convolution_forward(conv_pd, *src, *wei, dst),
+            eltwise_forward(relu_pd, dst, dst) };
+    }
+
+    engine eng;
+    std::shared_ptr<memory::desc> src_md, wei_md, dst_md;
+    std::shared_ptr<memory> src, wei;
+};
+
+TEST_F(stream_plan_test, TestConvRelu) {
+    memory dst_eager({*dst_md, eng}), dst_lazy({*dst_md, eng});
+    stream(stream::kind::eager).submit(conv_relu(dst_eager)).wait();
+
+    auto s = stream(stream::kind::lazy);
+    s.submit(conv_relu(dst_lazy)).wait();
+    compare_data<float>(dst_eager, dst_lazy);
+
+    int fused, levels;
+    s.get_plan_stats(fused, levels);
+    EXPECT_EQ(fused, 1);
+    EXPECT_EQ(levels, 1);
+
+    /* rerun() replays the plan */
+    const size_t nelems = dst_lazy.get_primitive_desc().get_size()
+        / sizeof(float);
+    fill_data<float>(nelems, (float *)dst_lazy.get_data_handle());
+    s.rerun().wait();
+    compare_data<float>(dst_eager, dst_lazy);
+}
+
+TEST_F(stream_plan_test, TestReorderChain) {
+    auto blk_md = memory::desc(src_md->data.dims, memory::data_type::f32,
+            memory::format::nChw8c);
+    memory tmp({blk_md, eng});
+    memory dst_eager({*src_md, eng}), dst_lazy({*src_md, eng});
+
+    std::vector<primitive> eager = { reorder(*src, tmp),
+        reorder(tmp, dst_eager) };
+    stream(stream::kind::eager).submit(eager).wait();
+    compare_data<float>(*src, dst_eager);
+
+    /* tmp is only used by the chain and may be skipped */
+    std::vector<primitive> lazy = { reorder(*src, tmp),
+        reorder(tmp, dst_lazy) };
+    auto s = stream(stream::kind::lazy);
+    s.submit(lazy).wait();
+    compare_data<float>(*src, dst_lazy);
+
+    int fused, levels;
+    s.get_plan_stats(fused, levels);
+    EXPECT_EQ(fused, 1);
+    EXPECT_EQ(levels, 1);
+}
+
+TEST_F(stream_plan_test, TestTrainingNotFolded) {
+    memory dst_eager({*dst_md, eng}), dst_lazy({*dst_md, eng});
+    stream(stream::kind::eager).submit(
+            conv_relu(dst_eager, prop_kind::forward_training)).wait();
+
+    /* the backward pass needs the convolution output */
+    auto s = stream(stream::kind::lazy);
+    s.submit(conv_relu(dst_lazy, prop_kind::forward_training)).wait();
+    compare_data<float>(dst_eager, dst_lazy);
+
+    int fused, levels;
+    s.get_plan_stats(fused, levels);
+    EXPECT_EQ(fused, 0);
+    EXPECT_EQ(levels, 2);
+}
+
+TEST_F(stream_plan_test, TestReaderBeforeInPlaceRelu) {
+    memory copy_eager({*dst_md, eng}), copy_lazy({*dst_md, eng});
+    memory dst_eager({*dst_md, eng}), dst_lazy({*dst_md, eng});
+
+    std::vector<primitive> eager = conv_relu(dst_eager);
+    eager.insert(eager.begin() + 1, reorder(dst_eager, copy_eager));
+    stream(stream::kind::eager).submit(eager).wait();
+
+    /* the copy needs the convolution output before the relu overwrites it */
+    std::vector<primitive> lazy = conv_relu(dst_lazy);
+    lazy.insert(lazy.begin() + 1, reorder(dst_lazy, copy_lazy));
+    auto s = stream(stream::kind::lazy);
+    s.submit(lazy).wait();
+
+    compare_data<float>(copy_eager, copy_lazy);
+    compare_data<float>(dst_eager, dst_lazy);
+
+    int fused, levels;
+    s.get_plan_stats(fused, levels);
+    EXPECT_EQ(fused, 0);
+    EXPECT_EQ(levels, 3);
+}
+
+TEST_F(stream_plan_test, TestIndependentBranches) {
+    memory dst0_eager({*dst_md, eng}), dst1_eager({*dst_md, eng});
+    memory dst0_lazy({*dst_md, eng}), dst1_lazy({*dst_md, eng});
+
+    std::vector<primitive> eager = conv_relu(dst0_eager);
+    for (auto &p: conv_relu(dst1_eager)) eager.push_back(p);
+    stream(stream::kind::eager).submit(eager).wait();
+
+    /* the two conv -> relu branches do not depend on each other */
+    std::vector<primitive> lazy = conv_relu(dst0_lazy);
+    for (auto &p: conv_relu(dst1_lazy)) lazy.push_back(p);
+    auto s = stream(stream::kind::lazy);
+    s.submit(lazy).wait();
+
+    compare_data<float>(dst0_eager, dst0_lazy);
+    compare_data<float>(dst1_eager, dst1_lazy);
+
+    int fused, levels;
+    s.get_plan_stats(fused, levels);
+    EXPECT_EQ(fused, 2);
+    EXPECT_EQ(levels, 1);
+
+    int eager_fused, eager_levels;
+    stream(stream::kind::eager).get_plan_stats(eager_fused, eager_levels);
+    EXPECT_EQ(eager_fused, 0);
+    EXPECT_EQ(eager_levels, 0);
+}
+
+}
@@ -159,8 +159,8 @@ template <typename dst_data_t>
 class sum_test_bf16: public ::testing::TestWithParam<sum_test_params> {
 protected:
     void SetUp() {
-        /* Skip test for systems with don't support avx512_core*/
-        SKIP_IF(!impl::cpu::mayiuse(impl::cpu::avx512_core),
+        /* Skip test for systems that cannot convert bfloat16 */
+        SKIP_IF(!impl::cpu::mayiuse_bf16_cvt(),
                 "current ISA doesn't support bfloat16 data type");
         sum_test_params p
             = ::testing::TestWithParam<sum_test_params>::GetParam();
@@ -0,0 +1,154 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+
+#include <stdio.h>
+
+#include "mkldnn_test_common.hpp"
+#include "gtest/gtest.h"
+
+#include "mkldnn.hpp"
+
+namespace mkldnn {
+
+class weights_file_test_base: public ::testing::Test {
+protected:
+    virtual void SetUp() { init(16, 32); }
+
+    void init(int ic, int oc) {
+        auto src_md = memory::desc({2, ic, 7, 7}, memory::data_type::f32,
+                memory::format::nchw);
+        auto wei_md = memory::desc({oc, ic, 3, 3}, memory::data_type::f32,
+                memory::format::oihw);
+        auto any_wei_md = memory::desc({oc, ic, 3, 3}, memory::data_type::f32,
+                memory::format::any);
+        auto bia_md = memory::desc({oc}, memory::data_type::f32,
+                memory::format::x);
+        auto dst_md = memory::desc({2, oc, 7, 7}, memory::data_type::f32,
+                memory::format::nchw);
+        auto desc = convolution_forward::desc(prop_kind::forward_inference,
+                algorithm::convolution_direct, src_md, any_wei_md, bia_md,
+                dst_md, {1, 1}, {1, 1}, {1, 1}, padding_kind::zero);
+        conv_pd.reset(new convolution_forward::primitive_desc(desc, eng));
+
+        src.reset(new memory({src_md, eng}));
+        wei.reset(new memory({wei_md, eng}));
+        bia.reset(new memory({bia_md, eng}));
+        for (auto m: {src, wei, bia})
+            fill_data<float>(m->get_primitive_desc().get_size()
+                    / sizeof(float), (float *)m->get_data_handle());
+    }
+
+    memory run_conv(const memory &weights, const memory &bias) {
+        memory dst(conv_pd->dst_primitive_desc());
+        std::vector<primitive> pipeline;
+        pipeline.push_back(convolution_forward(*conv_pd, *src, weights, bias,
+                    dst));
+        stream(stream::kind::eager).submit(pipeline).wait();
+        return dst;
+    }
+
+    void check_convolution(const char *path, unsigned flags) {
+        {
+            packed_weights pw(*conv_pd, 0, *wei);
+            weights_file::write(path, {"conv1.weights", "conv1.bias"},
+                    {pw.create_memory(), *bia});
+        }
+
+        weights_file wf(eng, path, flags);
+        ASSERT_EQ(wf.get_count(), 2);
+        EXPECT_STREQ(wf.get_name(0), "conv1.weights");
+        EXPECT_EQ(wf.find("conv1.bias"), 1);
+        EXPECT_TRUE(wf.get_primitive_desc(0)
+                == conv_pd->weights_primitive_desc());
+
+        memory wf_wei = wf.create_memory("conv1.weights");
+        memory wf_bia = wf.create_memory("conv1.bias");
+        EXPECT_EQ((size_t)wf_wei.get_data_handle() % 4096, 0u);
+
+        memory ref_wei(conv_pd->weights_primitive_desc());
+        std::vector<primitive> pipeline;
+        pipeline.push_back(reorder(*wei, ref_wei));
+        stream(stream::kind::eager).submit(pipeline).wait();
+
+        auto dst = run_conv(wf_wei, wf_bia);
+        auto ref_dst = run_conv(ref_wei, *bia);
+        const size_t n = dst.get_primitive_desc().get_size() / sizeof(float);
+        const float *d = (const float *)dst.get_data_handle();
+        const float *r = (const float *)ref_dst.get_data_handle();
+        for (size_t i = 0; i < n; i++)
+            ASSERT_EQ(d[i], r[i]);
+
+        remove(path);
+    }
+
+    engine eng = engine(engine::kind::cpu, 0);
+    std::shared_ptr<convolution_forward::primitive_desc> conv_pd;
+    std::shared_ptr<memory> src, wei, bia;
+};
+
+class weights_file_test: public weights_file_test_base,
+    public ::testing::WithParamInterface<unsigned> {};
+
+TEST_P(weights_file_test, TestConvolution) {
+    check_convolution("test_weights_file.bin", GetParam());
+}
+
+/* the channels are padded in the blocked weights format, the read-only
+ * mapping must not be written to when it is bound */
+class weights_file_padded_test: public weights_file_test {
+protected:
+    virtual void SetUp() { init(3, 3); }
+};
+
+TEST_P(weights_file_padded_test, TestConvolution) {
+    check_convolution("test_weights_file_padded.bin", GetParam());
+}
+
+TEST_F(weights_file_test_base, TestErrors) {
+    const char *path = "test_weights_file_errors.bin";
+    const char *names[] = { "a", "a" };
+    const_mkldnn_primitive_t memories[] = { wei->get(), bia->get() };
+    EXPECT_EQ(mkldnn_weights_file_write(path, 2, names, memories),
+            mkldnn_invalid_arguments);
+
+    ASSERT_EQ(mkldnn_weights_file_write(path, 1, names, memories),
+            mkldnn_success);
+    mkldnn_weights_file_t wf;
+    EXPECT_EQ(mkldnn_weights_file_open(&wf, eng.get(), path, 0x8U),
+            mkldnn_invalid_arguments);
+    ASSERT_EQ(mkldnn_weights_file_open(&wf, eng.get(), path, 0),
+            mkldnn_success);
+    int index;
+    EXPECT_EQ(mkldnn_weights_file_find(wf, "b", &index),
+            mkldnn_invalid_arguments);
+    mkldnn_weights_file_close(wf);
+    remove(path);
+
+    EXPECT_EQ(mkldnn_weights_file_open(&wf, eng.get(), path, 0),
+            mkldnn_invalid_arguments);
+}
+
+INSTANTIATE_TEST_SUITE_P(TestWeightsFile, weights_file_test,
+        ::testing::Values(mkldnn_weights_file_default,
+            mkldnn_weights_file_populate, mkldnn_weights_file_hugepages,
+            mkldnn_weights_file_numa_interleave));
+
+INSTANTIATE_TEST_SUITE_P(TestWeightsFilePadded, weights_file_padded_test,
+        ::testing::Values(mkldnn_weights_file_default,
+            mkldnn_weights_file_populate));
+
+}